@@ -1381,6 +1381,7 @@ private:
   }
 
   void mfence();
+  void sfence();
 
   // Moves
 
@@ -1475,6 +1476,9 @@ private:
   void movq(Register dst, Register src);
   void movq(Register dst, Address src);
   void movq(Address  dst, Register src);
+
+  // Non-temporal store, weakly ordered with respect to other stores
+  void movntiq(Address dst, Register src);
 #endif
 
   void movq(Address     dst, MMXRegister src );
@@ -1670,6 +1674,7 @@ private:
 
   // Multiply add
   void pmaddwd(XMMRegister dst, XMMRegister src);
+  void pmaddubsw(XMMRegister dst, XMMRegister src);
   void vpmaddwd(XMMRegister dst, XMMRegister nds, XMMRegister src, int vector_len);
   // Multiply add accumulate
   void evpdpwssd(XMMRegister dst, XMMRegister nds, XMMRegister src, int vector_len);
@@ -1706,6 +1711,9 @@ private:
   void pshufb(XMMRegister dst, Address src);
   void vpshufb(XMMRegister dst, XMMRegister nds, XMMRegister src, int vector_len);
 
+  // Sum of absolute differences of packed unsigned bytes
+  void psadbw(XMMRegister dst, XMMRegister src);
+
   // Shuffle Packed Doublewords
   void pshufd(XMMRegister dst, XMMRegister src, int mode);
   void pshufd(XMMRegister dst, Address src,     int mode);
@@ -3713,6 +3713,25 @@ void LIR_Assembler::emit_profile_type(LIR_OpProfileType* op) {
   }
 }
 
+void LIR_Assembler::emit_profile_sample(LIR_OpProfileSample* op) {
+  Register thread = op->thread()->as_pointer_register();
+  Register tmp = op->tmp()->as_register();
+  Address counter_addr = as_Address(op->counter()->as_address_ptr());
+  Address seed_addr(thread, JavaThread::profile_sample_seed_offset());
+  Label skip;
+
+  // Advance the thread's linear congruential generator. Its high bits are
+  // the random ones, so the mask selects from the top.
+  __ movl(tmp, seed_addr);
+  __ imull(tmp, tmp, 1103515245);
+  __ addl(tmp, 12345);
+  __ movl(seed_addr, tmp);
+  __ testl(tmp, op->mask());
+  __ jccb(Assembler::notZero, skip);
+  __ addptr(counter_addr, op->increment());
+  __ bind(skip);
+}
+
 void LIR_Assembler::emit_delay(LIR_OpDelay*) {
   Unimplemented();
 }
@@ -1443,8 +1443,12 @@ void LIRGenerator::do_If(If* x) {
   }
 
   __ cmp(lir_cond(cond), left, right);
-  // Generate branch profiling. Profiling code doesn't kill flags.
-  profile_branch(x, cond);
+  // Generate branch profiling. Profiling code doesn't kill flags unless it
+  // is sampled; then the condition is recomputed. Long compares may destroy
+  // their left operand, so they are never sampled.
+  if (profile_branch(x, cond, tag != longTag)) {
+    __ cmp(lir_cond(cond), left, right);
+  }
   move_to_phi(x->state());
   if (x->x()->type()->is_float_kind()) {
     __ branch(lir_cond(cond), right->type(), x->tsux(), x->usux());
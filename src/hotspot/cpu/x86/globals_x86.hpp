@@ -148,6 +148,12 @@ define_pd_global(bool, ThreadLocalHandshakes, false);
   product(bool, UseUnalignedLoadStores, false,                              \
           "Use SSE2 MOVDQU instruction for Arraycopy")                      \
                                                                             \
+  product(intx, ArrayCopyNonTemporalThreshold, 8*M,                        \
+          "Forward arraycopy stubs use non-temporal stores for copies of "  \
+          "at least this many bytes, so that copying large arrays does "    \
+          "not evict the cached working set. 0 disables them")             \
+          range(0, max_jint)                                                \
+                                                                            \
   product(bool, UseXMMForObjInit, false,                                    \
           "Use XMM/YMM MOVDQU instruction for Object Initialization")       \
                                                                             \
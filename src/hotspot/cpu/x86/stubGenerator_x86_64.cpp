@@ -1252,6 +1252,38 @@ class StubGenerator: public StubCodeGenerator {
                              Label& L_copy_bytes, Label& L_copy_8_bytes) {
     DEBUG_ONLY(__ stop("enter at entry label, not here"));
     Label L_loop;
+    Label L_copy_cached;
+    intx nt_qwords = ArrayCopyNonTemporalThreshold / BytesPerLong;
+    if (nt_qwords > 0) {
+      // Large copies bypass the caches with non-temporal stores, the
+      // destination is unlikely to be read again before it is evicted.
+      Label L_nt_loop, L_nt_entry;
+      __ BIND(L_copy_bytes);
+      __ cmpptr(qword_count, -(int32_t)nt_qwords);
+      __ jcc(Assembler::greater, L_copy_cached);
+      __ jmpb(L_nt_entry);
+      // Copy 32-bytes per iteration
+      __ BIND(L_nt_loop);
+      __ movq(to, Address(end_from, qword_count, Address::times_8, -24));
+      __ movntiq(Address(end_to, qword_count, Address::times_8, -24), to);
+      __ movq(to, Address(end_from, qword_count, Address::times_8, -16));
+      __ movntiq(Address(end_to, qword_count, Address::times_8, -16), to);
+      __ movq(to, Address(end_from, qword_count, Address::times_8, - 8));
+      __ movntiq(Address(end_to, qword_count, Address::times_8, - 8), to);
+      __ movq(to, Address(end_from, qword_count, Address::times_8, - 0));
+      __ movntiq(Address(end_to, qword_count, Address::times_8, - 0), to);
+      __ BIND(L_nt_entry);
+      __ addptr(qword_count, 4);
+      __ jcc(Assembler::lessEqual, L_nt_loop);
+      __ subptr(qword_count, 4);
+      // Order the non-temporal stores before the stores that follow the
+      // copy, which may publish the array.
+      __ sfence();
+      // Copy the remaining less than 4 qwords below.
+      __ jmp(L_copy_cached);
+    }
+    // Entry of the copy through the caches
+    Label& L_copy_cached_entry = (nt_qwords > 0) ? L_copy_cached : L_copy_bytes;
     __ align(OptoLoopAlignment);
     if (UseUnalignedLoadStores) {
       Label L_end;
@@ -1275,7 +1307,7 @@ class StubGenerator: public StubCodeGenerator {
         __ movdqu(xmm3, Address(end_from, qword_count, Address::times_8, - 8));
         __ movdqu(Address(end_to, qword_count, Address::times_8, - 8), xmm3);
       }
-      __ BIND(L_copy_bytes);
+      __ BIND(L_copy_cached_entry);
       __ addptr(qword_count, 8);
       __ jcc(Assembler::lessEqual, L_loop);
       __ subptr(qword_count, 4);  // sub(8) and add(4)
@@ -1309,7 +1341,7 @@ class StubGenerator: public StubCodeGenerator {
       __ movq(to, Address(end_from, qword_count, Address::times_8, - 0));
       __ movq(Address(end_to, qword_count, Address::times_8, - 0), to);
 
-      __ BIND(L_copy_bytes);
+      __ BIND(L_copy_cached_entry);
       __ addptr(qword_count, 4);
       __ jcc(Assembler::lessEqual, L_loop);
     }
@@ -5073,6 +5105,166 @@ address generate_avx_ghash_processBlocks() {
       return start;
   }
 
+  // x = x % 65521 for a 32 bit unsigned x, using multiplication by the
+  // reciprocal: x / 65521 == (x * 0x80078071) >> 47.
+  void adler32_mod(Register x, Register tmp1, Register tmp2) {
+    assert_different_registers(x, tmp1, tmp2);
+    __ movl(tmp1, x);
+    __ mov64(tmp2, 0x80078071);
+    __ imulq(tmp1, tmp2);
+    __ shrq(tmp1, 47);
+    __ imull(tmp1, tmp1, 65521);
+    __ subl(x, tmp1);
+  }
+
+  /**
+   *  Arguments:
+   *
+   *  Inputs:
+   *   c_rarg0   - int adler
+   *   c_rarg1   - byte* buff
+   *   c_rarg2   - int length
+   *
+   * Output:
+   *       rax   - int adler result
+   *
+   * Blocks of 16 bytes are summed with SSSE3: psadbw adds up the bytes
+   * for s1, and pmaddubsw/pmaddwd by the weights 16..1 give the block's
+   * contribution to s2; the running s1 of the previous blocks is added
+   * to s2 16 times per block. At most 347 blocks (zlib's NMAX of 5552
+   * bytes) are summed before reducing modulo 65521 so that no 32 bit
+   * lane can overflow. The tail is done one byte at a time.
+   */
+  address generate_updateBytesAdler32() {
+    assert(UseAdler32Intrinsics, "need SSSE3");
+    __ align(CodeEntryAlignment);
+    StubCodeMark mark(this, "StubRoutines", "updateBytesAdler32");
+
+    // Byte weights 16..1 of a block, and words of one for pmaddwd.
+    address taps = __ pc();
+    __ emit_data64(0x090a0b0c0d0e0f10, relocInfo::none);
+    __ emit_data64(0x0102030405060708, relocInfo::none);
+    address ones = __ pc();
+    __ emit_data64(0x0001000100010001, relocInfo::none);
+    __ emit_data64(0x0001000100010001, relocInfo::none);
+
+    address start = __ pc();
+
+    const Register adler = c_rarg0;
+    const Register buf   = c_rarg1;
+    const Register len   = c_rarg2;
+    const Register s1    = r10;
+    const Register s2    = r11;
+    const Register cnt   = r9;
+    const Register tmp   = rax;
+    assert_different_registers(adler, buf, len, s1, s2, cnt, tmp);
+
+    const XMMRegister xtaps = xmm0;
+    const XMMRegister xones = xmm1;
+    const XMMRegister xzero = xmm2;
+    const XMMRegister xs1   = xmm3;
+    const XMMRegister xs2   = xmm4;
+    const XMMRegister xps   = xmm5;
+    const XMMRegister xdata = xmm6;
+    const XMMRegister xtmp  = xmm7;
+
+    Label L_chunk, L_chunk_size_ok, L_block, L_tail, L_tail_loop, L_done;
+
+    BLOCK_COMMENT("Entry:");
+    __ enter(); // required for proper stackwalking of RuntimeStub frame
+#ifdef _WIN64
+    // xmm6 and xmm7 are callee saved on win64
+    __ subptr(rsp, 4 * wordSize);
+    __ movdqu(Address(rsp, 0), xmm6);
+    __ movdqu(Address(rsp, 2 * wordSize), xmm7);
+#endif
+
+    __ movdqu(xtaps, ExternalAddress(taps));
+    __ movdqu(xones, ExternalAddress(ones));
+    __ pxor(xzero, xzero);
+
+    __ movl(s1, adler);
+    __ andl(s1, 0xffff);
+    __ movl(s2, adler);
+    __ shrl(s2, 16);
+
+    __ BIND(L_chunk);
+    __ cmpl(len, 16);
+    __ jcc(Assembler::below, L_tail);
+    __ movl(cnt, len);
+    __ shrl(cnt, 4);
+    __ cmpl(cnt, 347);
+    __ jccb(Assembler::belowEqual, L_chunk_size_ok);
+    __ movl(cnt, 347);
+    __ BIND(L_chunk_size_ok);
+    __ movl(tmp, cnt);
+    __ shll(tmp, 4);
+    __ subl(len, tmp);
+
+    __ movl(tmp, s1);
+    __ imull(tmp, cnt);
+    __ movdl(xps, tmp);      // s1 of the chunk start, counted once per block
+    __ movdl(xs2, s2);
+    __ pxor(xs1, xs1);
+
+    __ align(OptoLoopAlignment);
+    __ BIND(L_block);
+    __ movdqu(xdata, Address(buf, 0));
+    __ paddd(xps, xs1);
+    __ movdqa(xtmp, xdata);
+    __ psadbw(xtmp, xzero);
+    __ paddd(xs1, xtmp);
+    __ pmaddubsw(xdata, xtaps);
+    __ pmaddwd(xdata, xones);
+    __ paddd(xs2, xdata);
+    __ addptr(buf, 16);
+    __ decrementl(cnt);
+    __ jcc(Assembler::notZero, L_block);
+
+    __ pslld(xps, 4);
+    __ paddd(xs2, xps);
+    // Horizontal sums; psadbw left its sums in dwords 0 and 2.
+    __ pshufd(xtmp, xs1, 0x4E);
+    __ paddd(xs1, xtmp);
+    __ movdl(tmp, xs1);
+    __ addl(s1, tmp);
+    __ pshufd(xtmp, xs2, 0xB1);
+    __ paddd(xs2, xtmp);
+    __ pshufd(xtmp, xs2, 0x4E);
+    __ paddd(xs2, xtmp);
+    __ movdl(s2, xs2);
+    adler32_mod(s1, tmp, cnt);
+    adler32_mod(s2, tmp, cnt);
+    __ jmp(L_chunk);
+
+    __ BIND(L_tail);
+    __ testl(len, len);
+    __ jccb(Assembler::zero, L_done);
+    __ BIND(L_tail_loop);
+    __ movzbl(tmp, Address(buf, 0));
+    __ addl(s1, tmp);
+    __ addl(s2, s1);
+    __ incrementq(buf);
+    __ decrementl(len);
+    __ jccb(Assembler::notZero, L_tail_loop);
+    adler32_mod(s1, tmp, cnt);
+    adler32_mod(s2, tmp, cnt);
+
+    __ BIND(L_done);
+    __ shll(s2, 16);
+    __ orl(s2, s1);
+    __ movl(rax, s2);
+#ifdef _WIN64
+    __ movdqu(xmm6, Address(rsp, 0));
+    __ movdqu(xmm7, Address(rsp, 2 * wordSize));
+    __ addptr(rsp, 4 * wordSize);
+#endif
+    __ leave(); // required for proper stackwalking of RuntimeStub frame
+    __ ret(0);
+
+    return start;
+  }
+
   /**
    *  Arguments:
    *
@@ -5794,6 +5986,9 @@ address generate_avx_ghash_processBlocks() {
       StubRoutines::_crc32c_table_addr = (address)StubRoutines::x86::_crc32c_table;
       StubRoutines::_updateBytesCRC32C = generate_updateBytesCRC32C(supports_clmul);
     }
+    if (UseAdler32Intrinsics) {
+      StubRoutines::_updateBytesAdler32 = generate_updateBytesAdler32();
+    }
     if (VM_Version::supports_sse2() && UseLibmIntrinsic && InlineIntrinsics) {
       if (vmIntrinsics::is_intrinsic_available(vmIntrinsics::_dsin) ||
           vmIntrinsics::is_intrinsic_available(vmIntrinsics::_dcos) ||
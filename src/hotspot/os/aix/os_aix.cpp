@@ -2303,6 +2303,10 @@ bool os::pd_uncommit_memory(char* addr, size_t size) {
   }
 }
 
+bool os::pd_pretouch_memory(void* start, void* end, size_t page_size) {
+  return false;
+}
+
 bool os::pd_create_stack_guard_pages(char* addr, size_t size) {
   // Do not call this; no need to commit stack pages on AIX.
   ShouldNotReachHere();
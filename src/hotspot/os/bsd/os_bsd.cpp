@@ -2007,6 +2007,10 @@ bool os::pd_uncommit_memory(char* addr, size_t size) {
 #endif
 }
 
+bool os::pd_pretouch_memory(void* start, void* end, size_t page_size) {
+  return false;
+}
+
 bool os::pd_create_stack_guard_pages(char* addr, size_t size) {
   return os::commit_memory(addr, size, !ExecMem);
 }
@@ -67,6 +67,11 @@
           " of quotas (if set), when true. Otherwise, use the CPU"    \
           " shares value, provided it is less than quota.")             \
                                                                         \
+  product(bool, BindGCTaskThreadsPacked, false,                         \
+          "With BindGCTaskThreadsToCPUs, fill the cores of one last "   \
+          "level cache domain before using the next one, instead of "   \
+          "spreading the threads over all domains")                     \
+                                                                        \
   diagnostic(bool, DumpPrivateMappingsInCore, true,                     \
           "If true, sets bit 2 of /proc/PID/coredump_filter, thus "     \
           "resulting in file-backed private mappings of the process to "\
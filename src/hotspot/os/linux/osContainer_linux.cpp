@@ -51,8 +51,19 @@
  */
 #define PER_CPU_SHARES 1024
 
+/*
+ * Time for which OSContainer keeps the memory limit and the active
+ * processor count before looking at the cgroup files again.
+ */
+#define OSCONTAINER_CACHE_TIMEOUT (NANOSECS_PER_SEC/50)
+
 bool  OSContainer::_is_initialized   = false;
 bool  OSContainer::_is_containerized = false;
+bool  OSContainer::_is_cgroup_v2     = false;
+jlong OSContainer::_memory_limit = 0;
+jlong OSContainer::_memory_limit_next_check = 0;
+int   OSContainer::_active_processor_count = 0;
+jlong OSContainer::_active_processor_count_next_check = 0;
 julong _unlimited_memory;
 
 class CgroupSubsystem: CHeapObj<mtInternal> {
@@ -126,6 +137,8 @@ CgroupSubsystem* memory = NULL;
 CgroupSubsystem* cpuset = NULL;
 CgroupSubsystem* cpu = NULL;
 CgroupSubsystem* cpuacct = NULL;
+/* cgroup v2 has a single hierarchy for all controllers */
+CgroupSubsystem* unified = NULL;
 
 typedef char * cptr;
 
@@ -211,6 +224,33 @@ PRAGMA_DIAG_POP
   log_trace(os, container)(logstring, variable);                          \
 }
 
+/* read_v2_limit
+ *
+ * Read a cgroup v2 limit, which is a number or "max" for no limit.
+ * Only the first value of the file is read, for cpu.max that is
+ * the quota.
+ *
+ * return:
+ *    limit or
+ *    -1 for unlimited
+ *    OSCONTAINER_ERROR for not supported
+ */
+static jlong read_v2_limit(CgroupSubsystem* c, const char* filename) {
+  char limit_str[1024];
+  if (subsystem_file_contents(c, filename, "%1023s", limit_str) != 0) {
+    return OSCONTAINER_ERROR;
+  }
+  log_trace(os, container)("%s is: %s", filename + 1, limit_str);
+  if (strcmp(limit_str, "max") == 0) {
+    return (jlong)-1;
+  }
+  julong limit;
+  if (sscanf(limit_str, JULONG_FORMAT, &limit) != 1) {
+    return OSCONTAINER_ERROR;
+  }
+  return (limit >= _unlimited_memory) ? (jlong)-1 : (jlong)limit;
+}
+
 /* init
  *
  * Initialize the container support and determine if
@@ -252,6 +292,9 @@ void OSContainer::init() {
    *
    * Example for host:
    * 34 28 0:29 / /sys/fs/cgroup/memory rw,nosuid,nodev,noexec,relatime shared:16 - cgroup cgroup rw,memory
+   *
+   * Example for cgroup v2:
+   * 30 23 0:26 / /sys/fs/cgroup rw,nosuid,nodev,noexec,relatime shared:4 - cgroup2 cgroup2 rw
    */
   mntinfo = fopen("/proc/self/mountinfo", "r");
   if (mntinfo == NULL) {
@@ -267,6 +310,20 @@ void OSContainer::init() {
     char *s =  strstr(p, " - ");
     if (s != NULL &&
         sscanf(s, " - %s", fstype) == 1 &&
+        strcmp(fstype, "cgroup2") == 0) {
+      int matched = sscanf(p, "%d %d %d:%d %s %s",
+                           &mountid,
+                           &parentid,
+                           &major,
+                           &minor,
+                           tmproot,
+                           tmpmount);
+      if (matched == 6) {
+        unified = new CgroupSubsystem(tmproot, tmpmount);
+      } else {
+        log_debug(os, container)("Incompatible str containing cgroup2: %s", p);
+      }
+    } else if (s != NULL &&
         strcmp(fstype, "cgroup") == 0) {
 
       if (strstr(p, "memory") != NULL) {
@@ -345,6 +402,14 @@ void OSContainer::init() {
 
   fclose(mntinfo);
 
+  // Use cgroup v2 only if the controllers are not mounted as cgroup v1.
+  // On hybrid systems the v2 hierarchy has no controllers.
+  if (memory == NULL && unified != NULL) {
+    log_debug(os, container)("Using cgroup v2 unified hierarchy");
+    _is_cgroup_v2 = true;
+    memory = cpuset = cpu = cpuacct = unified;
+  }
+
   if (memory == NULL) {
     log_debug(os, container)("Required cgroup memory subsystem not found");
     return;
@@ -384,6 +449,8 @@ void OSContainer::init() {
    *
    * /sys/fs/cgroup/memory/user.slice
    *
+   * With cgroup v2 there is a single line for all controllers, e.g.
+   * 0::/user.slice/user-1000.slice/session-2.scope
    */
   cgroup = fopen("/proc/self/cgroup", "r");
   if (cgroup == NULL) {
@@ -404,7 +471,11 @@ void OSContainer::init() {
     controller = strsep(&p, ":");
     base = strsep(&p, "\n");
 
-    if (controller != NULL) {
+    if (_is_cgroup_v2) {
+      if (controller != NULL && controller[0] == '\0') {
+        unified->set_subsystem_path(base);
+      }
+    } else if (controller != NULL) {
       if (strstr(controller, "memory") != NULL) {
         memory->set_subsystem_path(base);
       } else if (strstr(controller, "cpuset") != NULL) {
@@ -424,17 +495,25 @@ void OSContainer::init() {
 
   // We need to update the amount of physical memory now that
   // command line arguments have been processed.
-  if ((mem_limit = memory_limit_in_bytes()) > 0) {
+  if ((mem_limit = read_memory_limit_in_bytes()) > 0) {
     os::Linux::set_physical_memory(mem_limit);
   }
 
+  // Fill the caches while still single threaded, so that concurrent
+  // callers never see them unset.
+  jlong now = os::javaTimeNanos();
+  _memory_limit = mem_limit;
+  _memory_limit_next_check = now + OSCONTAINER_CACHE_TIMEOUT;
+  _active_processor_count = read_active_processor_count();
+  _active_processor_count_next_check = now + OSCONTAINER_CACHE_TIMEOUT;
+
   _is_containerized = true;
 
 }
 
 const char * OSContainer::container_type() {
   if (is_containerized()) {
-    return "cgroupv1";
+    return _is_cgroup_v2 ? "cgroupv2" : "cgroupv1";
   } else {
     return NULL;
   }
@@ -451,6 +530,20 @@ const char * OSContainer::container_type() {
  *    OSCONTAINER_ERROR for not supported
  */
 jlong OSContainer::memory_limit_in_bytes() {
+  // Racy, but init() filled the cache, so a concurrent caller at worst
+  // reads the files again or sees the previous limit.
+  jlong now = os::javaTimeNanos();
+  if (now > _memory_limit_next_check) {
+    _memory_limit = read_memory_limit_in_bytes();
+    _memory_limit_next_check = now + OSCONTAINER_CACHE_TIMEOUT;
+  }
+  return _memory_limit;
+}
+
+jlong OSContainer::read_memory_limit_in_bytes() {
+  if (_is_cgroup_v2) {
+    return read_v2_limit(memory, "/memory.max");
+  }
   GET_CONTAINER_INFO(julong, memory, "/memory.limit_in_bytes",
                      "Memory Limit is: " JULONG_FORMAT, JULONG_FORMAT, memlimit);
 
@@ -464,6 +557,18 @@ jlong OSContainer::memory_limit_in_bytes() {
 }
 
 jlong OSContainer::memory_and_swap_limit_in_bytes() {
+  if (_is_cgroup_v2) {
+    // memory.swap.max is the swap on top of memory.max
+    jlong memlimit = read_v2_limit(memory, "/memory.max");
+    jlong swaplimit = read_v2_limit(memory, "/memory.swap.max");
+    if (memlimit == OSCONTAINER_ERROR || swaplimit == OSCONTAINER_ERROR) {
+      return OSCONTAINER_ERROR;
+    }
+    if (memlimit == -1 || swaplimit == -1) {
+      return (jlong)-1;
+    }
+    return memlimit + swaplimit;
+  }
   GET_CONTAINER_INFO(julong, memory, "/memory.memsw.limit_in_bytes",
                      "Memory and Swap Limit is: " JULONG_FORMAT, JULONG_FORMAT, memswlimit);
   if (memswlimit >= _unlimited_memory) {
@@ -475,6 +580,10 @@ jlong OSContainer::memory_and_swap_limit_in_bytes() {
 }
 
 jlong OSContainer::memory_soft_limit_in_bytes() {
+  if (_is_cgroup_v2) {
+    // Usage above memory.high is throttled and reclaimed
+    return read_v2_limit(memory, "/memory.high");
+  }
   GET_CONTAINER_INFO(julong, memory, "/memory.soft_limit_in_bytes",
                      "Memory Soft Limit is: " JULONG_FORMAT, JULONG_FORMAT, memsoftlimit);
   if (memsoftlimit >= _unlimited_memory) {
@@ -495,6 +604,11 @@ jlong OSContainer::memory_soft_limit_in_bytes() {
  *    OSCONTAINER_ERROR for not supported
  */
 jlong OSContainer::memory_usage_in_bytes() {
+  if (_is_cgroup_v2) {
+    GET_CONTAINER_INFO(jlong, memory, "/memory.current",
+                       "Memory Usage is: " JLONG_FORMAT, JLONG_FORMAT, memcurrent);
+    return memcurrent;
+  }
   GET_CONTAINER_INFO(jlong, memory, "/memory.usage_in_bytes",
                      "Memory Usage is: " JLONG_FORMAT, JLONG_FORMAT, memusage);
   return memusage;
@@ -509,6 +623,12 @@ jlong OSContainer::memory_usage_in_bytes() {
  *    OSCONTAINER_ERROR for not supported
  */
 jlong OSContainer::memory_max_usage_in_bytes() {
+  if (_is_cgroup_v2) {
+    // Only recent kernels have memory.peak
+    GET_CONTAINER_INFO(jlong, memory, "/memory.peak",
+                       "Maximum Memory Usage is: " JLONG_FORMAT, JLONG_FORMAT, mempeak);
+    return mempeak;
+  }
   GET_CONTAINER_INFO(jlong, memory, "/memory.max_usage_in_bytes",
                      "Maximum Memory Usage is: " JLONG_FORMAT, JLONG_FORMAT, memmaxusage);
   return memmaxusage;
@@ -551,6 +671,15 @@ jlong OSContainer::memory_max_usage_in_bytes() {
  *    number of CPUs
  */
 int OSContainer::active_processor_count() {
+  jlong now = os::javaTimeNanos();
+  if (now > _active_processor_count_next_check) {
+    _active_processor_count = read_active_processor_count();
+    _active_processor_count_next_check = now + OSCONTAINER_CACHE_TIMEOUT;
+  }
+  return _active_processor_count;
+}
+
+int OSContainer::read_active_processor_count() {
   int quota_count = 0, share_count = 0;
   int cpu_count, limit_count;
   int result;
@@ -591,12 +720,22 @@ int OSContainer::active_processor_count() {
 }
 
 char * OSContainer::cpu_cpuset_cpus() {
+  if (_is_cgroup_v2) {
+    GET_CONTAINER_INFO_CPTR(cptr, cpuset, "/cpuset.cpus.effective",
+                       "cpuset.cpus.effective is: %s", "%1023s", cpus, 1024);
+    return os::strdup(cpus);
+  }
   GET_CONTAINER_INFO_CPTR(cptr, cpuset, "/cpuset.cpus",
                      "cpuset.cpus is: %s", "%1023s", cpus, 1024);
   return os::strdup(cpus);
 }
 
 char * OSContainer::cpu_cpuset_memory_nodes() {
+  if (_is_cgroup_v2) {
+    GET_CONTAINER_INFO_CPTR(cptr, cpuset, "/cpuset.mems.effective",
+                       "cpuset.mems.effective is: %s", "%1023s", mems, 1024);
+    return os::strdup(mems);
+  }
   GET_CONTAINER_INFO_CPTR(cptr, cpuset, "/cpuset.mems",
                      "cpuset.mems is: %s", "%1023s", mems, 1024);
   return os::strdup(mems);
@@ -613,12 +752,21 @@ char * OSContainer::cpu_cpuset_memory_nodes() {
  *    OSCONTAINER_ERROR for not supported
  */
 int OSContainer::cpu_quota() {
+  if (_is_cgroup_v2) {
+    // cpu.max is "<quota> <period>", the quota is "max" for no quota
+    return (int)read_v2_limit(cpu, "/cpu.max");
+  }
   GET_CONTAINER_INFO(int, cpu, "/cpu.cfs_quota_us",
                      "CPU Quota is: %d", "%d", quota);
   return quota;
 }
 
 int OSContainer::cpu_period() {
+  if (_is_cgroup_v2) {
+    GET_CONTAINER_INFO(int, cpu, "/cpu.max",
+                       "CPU Period is: %d", "%*s %d", period);
+    return period;
+  }
   GET_CONTAINER_INFO(int, cpu, "/cpu.cfs_period_us",
                      "CPU Period is: %d", "%d", period);
   return period;
@@ -635,6 +783,15 @@ int OSContainer::cpu_period() {
  *    OSCONTAINER_ERROR for not supported
  */
 int OSContainer::cpu_shares() {
+  if (_is_cgroup_v2) {
+    GET_CONTAINER_INFO(int, cpu, "/cpu.weight",
+                       "CPU Weight is: %d", "%d", weight);
+    // Convert the default weight to no shares setup
+    if (weight == 100) return -1;
+    // Inverse of the shares to weight mapping of the container
+    // runtimes, weight = 1 + ((shares - 2) * 9999) / 262142
+    return (int)(2 + ((jlong)(weight - 1) * 262142) / 9999);
+  }
   GET_CONTAINER_INFO(int, cpu, "/cpu.shares",
                      "CPU Shares is: %d", "%d", shares);
   // Convert 1024 to no shares setup
@@ -36,6 +36,18 @@ class OSContainer: AllStatic {
  private:
   static bool   _is_initialized;
   static bool   _is_containerized;
+  static bool   _is_cgroup_v2;
+
+  // The limits can change while the VM runs. Callers like the GC worker
+  // policy ask often, so the last values are kept for a short time
+  // instead of reading the cgroup files on every call.
+  static jlong  _memory_limit;
+  static jlong  _memory_limit_next_check;
+  static int    _active_processor_count;
+  static jlong  _active_processor_count_next_check;
+
+  static jlong read_memory_limit_in_bytes();
+  static int read_active_processor_count();
 
  public:
   static void init();
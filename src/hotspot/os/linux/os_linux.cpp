@@ -74,6 +74,7 @@
 #include "utilities/elfFile.hpp"
 #include "utilities/growableArray.hpp"
 #include "utilities/macros.hpp"
+#include "utilities/quickSort.hpp"
 #include "utilities/vmError.hpp"
 
 // put OS-includes here
@@ -2711,6 +2712,11 @@ void os::pd_commit_memory_or_exit(char* addr, size_t size, bool exec,
   #define MAP_HUGETLB 0x40000
 #endif
 
+// Define MAP_HUGE_SHIFT here so we can build HotSpot on old systems.
+#ifndef MAP_HUGE_SHIFT
+  #define MAP_HUGE_SHIFT 26
+#endif
+
 // Define MADV_HUGEPAGE here so we can build HotSpot on old systems.
 #ifndef MADV_HUGEPAGE
   #define MADV_HUGEPAGE 14
@@ -3075,6 +3081,32 @@ bool os::pd_uncommit_memory(char* addr, size_t size) {
   return res  != (uintptr_t) MAP_FAILED;
 }
 
+// Define MADV_POPULATE_WRITE here so we can build HotSpot on old systems.
+#ifndef MADV_POPULATE_WRITE
+  #define MADV_POPULATE_WRITE 23
+#endif
+
+// Cleared once the kernel rejected MADV_POPULATE_WRITE (before 5.14)
+static volatile bool populate_write_supported = true;
+
+bool os::pd_pretouch_memory(void* start, void* end, size_t page_size) {
+  if (!populate_write_supported) {
+    return false;
+  }
+  // Let the kernel fault in the whole range with a single call instead of
+  // taking one page fault per touched page. Unlike touching, this does not
+  // modify the memory contents.
+  char* first = align_down((char*)start, os::vm_page_size());
+  char* last = align_up((char*)end, os::vm_page_size());
+  if (::madvise(first, pointer_delta(last, first, sizeof(char)), MADV_POPULATE_WRITE) == 0) {
+    return true;
+  }
+  if (errno == EINVAL) {
+    populate_write_supported = false;
+  }
+  return false;
+}
+
 static address get_stack_commited_bottom(address bottom, size_t size) {
   address nbot = bottom;
   address ntop = bottom + size;
@@ -3376,8 +3408,42 @@ bool os::unguard_memory(char* addr, size_t size) {
   return linux_mprotect(addr, size, PROT_READ|PROT_WRITE);
 }
 
+// Returns the system wide transparent huge page mode, "always", "madvise"
+// or "never", or NULL if it can't be determined.
+const char* os::Linux::transparent_huge_pages_mode() {
+  static const char* const modes[] = { "always", "madvise", "never" };
+  const char* result = NULL;
+  FILE* f = fopen("/sys/kernel/mm/transparent_hugepage/enabled", "r");
+  if (f != NULL) {
+    // The selected mode is in brackets, e.g. "always [madvise] never"
+    char buf[64];
+    char* selected = NULL;
+    if (fgets(buf, sizeof(buf), f) != NULL) {
+      selected = strchr(buf, '[');
+    }
+    for (size_t i = 0; selected != NULL && i < ARRAY_SIZE(modes); i++) {
+      size_t len = strlen(modes[i]);
+      if (strncmp(selected + 1, modes[i], len) == 0 && selected[len + 1] == ']') {
+        result = modes[i];
+      }
+    }
+    fclose(f);
+  }
+  return result;
+}
+
 bool os::Linux::transparent_huge_pages_sanity_check(bool warn,
                                                     size_t page_size) {
+  // madvise(MADV_HUGEPAGE) succeeds even if the system setting is "never",
+  // but then no memory gets huge pages.
+  const char* mode = transparent_huge_pages_mode();
+  if (mode != NULL && strcmp(mode, "never") == 0) {
+    if (warn) {
+      warning("TransparentHugePages is disabled in the operating system.");
+    }
+    return false;
+  }
+
   bool result = false;
   void *p = mmap(NULL, page_size * 2, PROT_READ|PROT_WRITE,
                  MAP_ANONYMOUS|MAP_PRIVATE,
@@ -3601,9 +3667,44 @@ void os::large_page_init() {
   size_t large_page_size = Linux::setup_large_page_size();
   UseLargePages          = Linux::setup_large_page_type(large_page_size);
 
+  if (UseTransparentHugePages) {
+    // Memory committed with a large page alignment hint is madvised, with
+    // the "always" mode the kernel may back the other memory as well.
+    const char* mode = Linux::transparent_huge_pages_mode();
+    log_info(pagesize)("Transparent huge pages: mode=%s page_size=" SIZE_FORMAT "K",
+                       mode != NULL ? mode : "unknown", large_page_size / K);
+  }
+
+  if (CodeCacheLargePageSize != 0 && CodeCacheLargePageSize != large_page_size) {
+    // Any size with a hugetlbfs pool can be requested with MAP_HUGE_*.
+    char path[64];
+    jio_snprintf(path, sizeof(path), "/sys/kernel/mm/hugepages/hugepages-" SIZE_FORMAT "kB",
+                 CodeCacheLargePageSize / K);
+    if (!UseLargePages || !UseHugeTLBFS || !is_power_of_2(CodeCacheLargePageSize) ||
+        !file_exists(path)) {
+      warning("CodeCacheLargePageSize " SIZE_FORMAT "K is not supported, using the default page size for code",
+              CodeCacheLargePageSize / K);
+      FLAG_SET_DEFAULT(CodeCacheLargePageSize, 0);
+    }
+  }
+
   set_coredump_filter(LARGEPAGES_BIT);
 }
 
+size_t os::Linux::huge_tlbfs_page_size(bool exec) {
+  return (exec && CodeCacheLargePageSize != 0) ? CodeCacheLargePageSize : os::large_page_size();
+}
+
+// MAP_HUGETLB selects the default huge page size; any other size has to be
+// encoded in the mmap flags.
+static int huge_tlbfs_mmap_flags(size_t page_size) {
+  int flags = MAP_HUGETLB;
+  if (page_size != os::large_page_size()) {
+    flags |= exact_log2(page_size) << MAP_HUGE_SHIFT;
+  }
+  return flags;
+}
+
 #ifndef SHM_HUGETLB
   #define SHM_HUGETLB 04000
 #endif
@@ -3766,13 +3867,14 @@ static void warn_on_large_pages_failure(char* req_addr, size_t bytes,
 char* os::Linux::reserve_memory_special_huge_tlbfs_only(size_t bytes,
                                                         char* req_addr,
                                                         bool exec) {
+  size_t page_size = huge_tlbfs_page_size(exec);
   assert(UseLargePages && UseHugeTLBFS, "only for Huge TLBFS large pages");
-  assert(is_aligned(bytes, os::large_page_size()), "Unaligned size");
-  assert(is_aligned(req_addr, os::large_page_size()), "Unaligned address");
+  assert(is_aligned(bytes, page_size), "Unaligned size");
+  assert(is_aligned(req_addr, page_size), "Unaligned address");
 
   int prot = exec ? PROT_READ|PROT_WRITE|PROT_EXEC : PROT_READ|PROT_WRITE;
   char* addr = (char*)::mmap(req_addr, bytes, prot,
-                             MAP_PRIVATE|MAP_ANONYMOUS|MAP_HUGETLB,
+                             MAP_PRIVATE|MAP_ANONYMOUS|huge_tlbfs_mmap_flags(page_size),
                              -1, 0);
 
   if (addr == MAP_FAILED) {
@@ -3780,7 +3882,7 @@ char* os::Linux::reserve_memory_special_huge_tlbfs_only(size_t bytes,
     return NULL;
   }
 
-  assert(is_aligned(addr, os::large_page_size()), "Must be");
+  assert(is_aligned(addr, page_size), "Must be");
 
   return addr;
 }
@@ -3796,7 +3898,7 @@ char* os::Linux::reserve_memory_special_huge_tlbfs_mixed(size_t bytes,
                                                          size_t alignment,
                                                          char* req_addr,
                                                          bool exec) {
-  size_t large_page_size = os::large_page_size();
+  size_t large_page_size = huge_tlbfs_page_size(exec);
   assert(bytes >= large_page_size, "Shouldn't allocate large pages for small sizes");
 
   assert(is_aligned(req_addr, alignment), "Must be");
@@ -3845,7 +3947,7 @@ char* os::Linux::reserve_memory_special_huge_tlbfs_mixed(size_t bytes,
 
   // Commit large-paged area.
   result = ::mmap(lp_start, lp_bytes, prot,
-                  MAP_PRIVATE|MAP_ANONYMOUS|MAP_FIXED|MAP_HUGETLB,
+                  MAP_PRIVATE|MAP_ANONYMOUS|MAP_FIXED|huge_tlbfs_mmap_flags(large_page_size),
                   -1, 0);
   if (result == MAP_FAILED) {
     warn_on_large_pages_failure(lp_start, lp_bytes, errno);
@@ -3879,13 +3981,14 @@ char* os::Linux::reserve_memory_special_huge_tlbfs(size_t bytes,
                                                    size_t alignment,
                                                    char* req_addr,
                                                    bool exec) {
+  size_t page_size = huge_tlbfs_page_size(exec);
   assert(UseLargePages && UseHugeTLBFS, "only for Huge TLBFS large pages");
   assert(is_aligned(req_addr, alignment), "Must be");
   assert(is_aligned(alignment, os::vm_allocation_granularity()), "Must be");
-  assert(is_power_of_2(os::large_page_size()), "Must be");
-  assert(bytes >= os::large_page_size(), "Shouldn't allocate large pages for small sizes");
+  assert(is_power_of_2(page_size), "Must be");
+  assert(bytes >= page_size, "Shouldn't allocate large pages for small sizes");
 
-  if (is_aligned(bytes, os::large_page_size()) && alignment <= os::large_page_size()) {
+  if (is_aligned(bytes, page_size) && alignment <= page_size) {
     return reserve_memory_special_huge_tlbfs_only(bytes, req_addr, exec);
   } else {
     return reserve_memory_special_huge_tlbfs_mixed(bytes, alignment, req_addr, exec);
@@ -5084,6 +5187,10 @@ jint os::init_2(void) {
     Linux::numa_init();
   }
 
+  if (BindGCTaskThreadsToCPUs) {
+    Linux::processor_placement_init();
+  }
+
   if (MaxFDLimit) {
     // set the number of file descriptors to max. print out error
     // if getrlimit/setrlimit fails but continue regardless.
@@ -5303,14 +5410,140 @@ void os::set_native_thread_name(const char *name) {
   }
 }
 
+// The processors of the process affinity mask, in the order in which
+// os::distribute_processes() hands them out.
+static uint* _processor_placement = NULL;
+static uint  _processor_placement_length = 0;
+
+struct ProcessorPlacement {
+  uint _cpu;
+  int  _domain;       // Last level cache domain, or package if unknown
+  int  _core_rank;    // Index of the core within its domain
+  int  _thread_rank;  // Index of the hardware thread within its core
+};
+
+// Reads an integer topology attribute of a processor from sysfs.
+// Returns -1 if it is not available.
+static int processor_attribute(uint cpu, const char* attribute) {
+  char path[128];
+  jio_snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%u/%s", cpu, attribute);
+  int value = -1;
+  FILE* fp = fopen(path, "r");
+  if (fp != NULL) {
+    if (fscanf(fp, "%d", &value) != 1) {
+      value = -1;
+    }
+    fclose(fp);
+  }
+  return value;
+}
+
+// Spread: one thread per cache domain in turn, then per core, and the
+// SMT siblings of the cores last.
+static int compare_placement_spread(const ProcessorPlacement& a, const ProcessorPlacement& b) {
+  if (a._thread_rank != b._thread_rank) return a._thread_rank - b._thread_rank;
+  if (a._core_rank != b._core_rank)     return a._core_rank - b._core_rank;
+  if (a._domain != b._domain)           return a._domain - b._domain;
+  return (int)a._cpu - (int)b._cpu;
+}
+
+// Pack: fill the cores and then the SMT siblings of one cache domain
+// before using the next, so the threads share a last level cache.
+static int compare_placement_pack(const ProcessorPlacement& a, const ProcessorPlacement& b) {
+  if (a._domain != b._domain)           return a._domain - b._domain;
+  if (a._thread_rank != b._thread_rank) return a._thread_rank - b._thread_rank;
+  if (a._core_rank != b._core_rank)     return a._core_rank - b._core_rank;
+  return (int)a._cpu - (int)b._cpu;
+}
+
+// Build the placement order from the CPU topology in sysfs. Only the
+// static cpu_set_t is supported, larger machines don't get a placement.
+void os::Linux::processor_placement_init() {
+  cpu_set_t cpus;
+  if (sched_getaffinity(0, sizeof(cpus), &cpus) != 0) {
+    log_info(os, thread)("Processor placement: sched_getaffinity failed (%s)", os::strerror(errno));
+    return;
+  }
+  uint count = (uint)CPU_COUNT(&cpus);
+  if (count == 0) {
+    return;
+  }
+  ProcessorPlacement* placement = NEW_C_HEAP_ARRAY(ProcessorPlacement, count, mtInternal);
+  int* packages = NEW_C_HEAP_ARRAY(int, count, mtInternal);
+  int* cores = NEW_C_HEAP_ARRAY(int, count, mtInternal);
+  uint n = 0;
+  for (uint cpu = 0; cpu < CPU_SETSIZE && n < count; cpu++) {
+    if (!CPU_ISSET(cpu, &cpus)) {
+      continue;
+    }
+    int package = processor_attribute(cpu, "topology/physical_package_id");
+    int core = processor_attribute(cpu, "topology/core_id");
+    int llc = processor_attribute(cpu, "cache/index3/id");
+    placement[n]._cpu = cpu;
+    placement[n]._domain = (llc >= 0) ? llc : MAX2(package, 0);
+    // Without topology information every processor is a core of its own
+    packages[n] = package;
+    cores[n] = (core >= 0) ? core : (int)cpu;
+    placement[n]._thread_rank = 0;
+    placement[n]._core_rank = 0;
+    for (uint i = 0; i < n; i++) {
+      if (packages[i] == packages[n] && cores[i] == cores[n]) {
+        placement[n]._thread_rank++;
+        placement[n]._core_rank = placement[i]._core_rank;
+      } else if (placement[i]._domain == placement[n]._domain &&
+                 placement[i]._thread_rank == 0 && placement[n]._thread_rank == 0) {
+        placement[n]._core_rank++;
+      }
+    }
+    n++;
+  }
+  FREE_C_HEAP_ARRAY(int, packages);
+  FREE_C_HEAP_ARRAY(int, cores);
+
+  if (BindGCTaskThreadsPacked) {
+    QuickSort::sort(placement, n, compare_placement_pack, false);
+  } else {
+    QuickSort::sort(placement, n, compare_placement_spread, false);
+  }
+
+  _processor_placement = NEW_C_HEAP_ARRAY(uint, n, mtInternal);
+  for (uint i = 0; i < n; i++) {
+    _processor_placement[i] = placement[i]._cpu;
+  }
+  _processor_placement_length = n;
+
+  LogTarget(Debug, os, thread) lt;
+  if (lt.is_enabled()) {
+    LogStream ls(lt);
+    ls.print("Processor placement (%s):", BindGCTaskThreadsPacked ? "packed" : "spread");
+    for (uint i = 0; i < n; i++) {
+      ls.print(" %u", _processor_placement[i]);
+    }
+    ls.cr();
+  }
+  FREE_C_HEAP_ARRAY(ProcessorPlacement, placement);
+}
+
 bool os::distribute_processes(uint length, uint* distribution) {
-  // Not yet implemented.
-  return false;
+  if (_processor_placement_length == 0) {
+    return false;
+  }
+  // More threads than processors wrap around
+  for (uint i = 0; i < length; i++) {
+    distribution[i] = _processor_placement[i % _processor_placement_length];
+  }
+  return true;
 }
 
 bool os::bind_to_processor(uint processor_id) {
-  // Not yet implemented.
-  return false;
+  if (processor_id >= CPU_SETSIZE) {
+    return false;
+  }
+  cpu_set_t cpus;
+  CPU_ZERO(&cpus);
+  CPU_SET(processor_id, &cpus);
+  // pid 0 is the calling thread
+  return sched_setaffinity(0, sizeof(cpus), &cpus) == 0;
 }
 
 ///
@@ -92,15 +92,21 @@ class Linux {
   static GrowableArray<int>* cpu_to_node()    { return _cpu_to_node; }
   static GrowableArray<int>* nindex_to_node()  { return _nindex_to_node; }
 
+  static void processor_placement_init();
+
   static size_t find_large_page_size();
   static size_t setup_large_page_size();
 
   static bool setup_large_page_type(size_t page_size);
   static bool transparent_huge_pages_sanity_check(bool warn, size_t pages_size);
+  static const char* transparent_huge_pages_mode();
   static bool hugetlbfs_sanity_check(bool warn, size_t page_size);
 
   static char* reserve_memory_special_shm(size_t bytes, size_t alignment, char* req_addr, bool exec);
   static char* reserve_memory_special_huge_tlbfs(size_t bytes, size_t alignment, char* req_addr, bool exec);
+  // Page size used for MAP_HUGETLB mappings; executable memory may ask for
+  // a different size with CodeCacheLargePageSize.
+  static size_t huge_tlbfs_page_size(bool exec);
   static char* reserve_memory_special_huge_tlbfs_only(size_t bytes, char* req_addr, bool exec);
   static char* reserve_memory_special_huge_tlbfs_mixed(size_t bytes, size_t alignment, char* req_addr, bool exec);
 
@@ -46,6 +46,10 @@
 #include <sys/utsname.h>
 #include <time.h>
 #include <unistd.h>
+#ifdef LINUX
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#endif
 
 // Todo: provide a os::get_max_process_id() or similar. Number of processes
 // may have been configured, can be read more accurately from proc fs etc.
@@ -1906,11 +1910,242 @@ void os::Posix::to_RTC_abstime(timespec* abstime, int64_t millis) {
              true  /* use real-time clock */);
 }
 
-// Shared pthread_mutex/cond based PlatformEvent implementation.
+// Shared PlatformEvent and Parker implementation: futex based on Linux,
+// pthread_mutex/cond based elsewhere.
 // Not currently usable by Solaris.
 
 #ifndef SOLARIS
 
+#ifdef LINUX
+
+// Futex based PlatformEvent and Parker implementation.
+//
+// The states are the same as for the pthread based implementation below,
+// but the waiting thread blocks on the state word itself. An unpark that
+// finds no waiter is a single atomic exchange, and a wakeup is a single
+// FUTEX_WAKE without any mutex handoff.
+
+// Number of SpinPause() iterations before a park blocks in the kernel.
+// Handoffs between busy threads often complete within this window.
+static const int futex_park_spins = 64;
+
+// Blocks while *addr == expected, until the absolute time abstime on
+// CLOCK_MONOTONIC, or CLOCK_REALTIME if realtime is set. A NULL abstime
+// waits without a timeout. Returns 0 if woken, or -1 with errno set.
+static int futex_wait(volatile int* addr, int expected, const timespec* abstime, bool realtime) {
+  int op = FUTEX_WAIT_BITSET_PRIVATE | (realtime ? FUTEX_CLOCK_REALTIME : 0);
+  return syscall(SYS_futex, addr, op, expected, abstime, NULL, FUTEX_BITSET_MATCH_ANY);
+}
+
+static void futex_wake_one(volatile int* addr) {
+  int status = syscall(SYS_futex, addr, FUTEX_WAKE_PRIVATE, 1, NULL, NULL, 0);
+  assert_status(status >= 0, errno, "futex_wake");
+}
+
+// Create an absolute time 'timeout' nanoseconds in the future on CLOCK_MONOTONIC.
+static void to_monotonic_abstime(timespec* abstime, jlong timeout) {
+  struct timespec now;
+  int status = os::Posix::clock_gettime(CLOCK_MONOTONIC, &now);
+  assert_status(status == 0, status, "clock_gettime");
+  calc_rel_time(abstime, timeout, now.tv_sec, now.tv_nsec, NANOUNITS);
+}
+
+os::PlatformEvent::PlatformEvent() {
+  _event   = 0;
+  _nParked = 0;
+}
+
+void os::PlatformEvent::park() {       // AKA "down()"
+  // Transitions for _event:
+  //   -1 => -1 : illegal
+  //    1 =>  0 : pass - return immediately
+  //    0 => -1 : block; then set _event to 0 before returning
+
+  // Invariant: Only the thread associated with the PlatformEvent
+  // may call park().
+  assert(_nParked == 0, "invariant");
+
+  int v;
+
+  // atomically decrement _event
+  for (;;) {
+    v = _event;
+    if (Atomic::cmpxchg(v - 1, &_event, v) == v) break;
+  }
+  guarantee(v >= 0, "invariant");
+
+  if (v == 0) { // Do this the hard way by blocking ...
+    for (int i = 0; i < futex_park_spins && _event < 0; i++) {
+      SpinPause();
+    }
+    _nParked = 1;
+    while (_event < 0) {
+      // Returns at once if _event has changed.
+      // OS-level "spurious wakeups" are ignored.
+      futex_wait(&_event, -1, NULL, false);
+    }
+    _nParked = 0;
+
+    _event = 0;
+    // Paranoia to ensure our locked and lock-free paths interact
+    // correctly with each other.
+    OrderAccess::fence();
+  }
+  guarantee(_event >= 0, "invariant");
+}
+
+int os::PlatformEvent::park(jlong millis) {
+  // Transitions for _event:
+  //   -1 => -1 : illegal
+  //    1 =>  0 : pass - return immediately
+  //    0 => -1 : block; then set _event to 0 before returning
+
+  // Invariant: Only the thread associated with the Event/PlatformEvent
+  // may call park().
+  assert(_nParked == 0, "invariant");
+
+  int v;
+  // atomically decrement _event
+  for (;;) {
+    v = _event;
+    if (Atomic::cmpxchg(v - 1, &_event, v) == v) break;
+  }
+  guarantee(v >= 0, "invariant");
+
+  if (v == 0) { // Do this the hard way by blocking ...
+    struct timespec abst;
+    to_monotonic_abstime(&abst, millis_to_nanos(millis));
+
+    for (int i = 0; i < futex_park_spins && _event < 0; i++) {
+      SpinPause();
+    }
+
+    int ret = OS_TIMEOUT;
+    _nParked = 1;
+    while (_event < 0) {
+      int status = futex_wait(&_event, -1, &abst, false);
+      // OS-level "spurious wakeups" are ignored unless the archaic
+      // FilterSpuriousWakeups is set false. That flag should be obsoleted.
+      if (!FilterSpuriousWakeups) break;
+      if (status != 0 && errno == ETIMEDOUT) break;
+    }
+    _nParked = 0;
+
+    if (_event >= 0) {
+      ret = OS_OK;
+    }
+
+    _event = 0;
+    // Paranoia to ensure our locked and lock-free paths interact
+    // correctly with each other.
+    OrderAccess::fence();
+    return ret;
+  }
+  return OS_OK;
+}
+
+void os::PlatformEvent::unpark() {
+  // Transitions for _event:
+  //    0 => 1 : just return
+  //    1 => 1 : just return
+  //   -1 => 1 : wake the target thread
+  // See the pthread based implementation for the rationale.
+
+  if (Atomic::xchg(1, &_event) >= 0) return;
+
+  futex_wake_one(&_event);
+}
+
+// JSR166 support
+
+os::PlatformParker::PlatformParker() {
+}
+
+// Parker::park consumes the permit in _counter if there is one. Otherwise
+// it sets _counter from 0 to -1 and blocks on it. Parker::unpark sets
+// _counter to 1 and wakes the thread if it was -1. Only the owning thread
+// ever waits, and spurious returns are fine, so it waits at most once.
+
+void Parker::park(bool isAbsolute, jlong time) {
+
+  // Optional fast-path check:
+  // Return immediately if a permit is available.
+  // We depend on Atomic::xchg() having full barrier semantics
+  // since we are doing a lock-free update to _counter.
+  if (Atomic::xchg(0, &_counter) > 0) return;
+
+  Thread* thread = Thread::current();
+  assert(thread->is_Java_thread(), "Must be JavaThread");
+  JavaThread *jt = (JavaThread *)thread;
+
+  // Optional optimization -- avoid state transitions if there's
+  // an interrupt pending.
+  if (Thread::is_interrupted(thread, false)) {
+    return;
+  }
+
+  // Next, demultiplex/decode time arguments
+  struct timespec absTime;
+  if (time < 0 || (isAbsolute && time == 0)) { // don't wait at all
+    return;
+  }
+  if (time > 0) {
+    if (isAbsolute) {
+      to_abstime(&absTime, time, true, true);
+    } else {
+      to_monotonic_abstime(&absTime, time);
+    }
+  }
+
+  // A permit handed over shortly after the check above saves the thread
+  // state transitions and the system calls.
+  for (int i = 0; i < futex_park_spins; i++) {
+    if (_counter > 0 && Atomic::xchg(0, &_counter) > 0) return;
+    SpinPause();
+  }
+
+  // Enter safepoint region
+  ThreadBlockInVM tbivm(jt);
+
+  // Re-check interrupt before trying wait.
+  if (Thread::is_interrupted(thread, false)) {
+    return;
+  }
+
+  // Announce that we are about to block. This fails if a permit
+  // arrived in the meantime, which we consume instead.
+  if (Atomic::cmpxchg(-1, &_counter, 0) != 0) {
+    Atomic::xchg(0, &_counter);
+    return;
+  }
+
+  OSThreadWaitState osts(thread->osthread(), false /* not Object.wait() */);
+  jt->set_suspend_equivalent();
+  // cleared by handle_special_suspend_equivalent_condition() or java_suspend_self()
+
+  int status = futex_wait(&_counter, -1, time == 0 ? NULL : &absTime, isAbsolute);
+  assert_status(status == 0 || errno == EAGAIN || errno == EINTR || errno == ETIMEDOUT,
+                errno, "futex_wait");
+
+  // Leave the parked state and consume the permit, if any. Atomic::xchg()
+  // orders our accesses with the unparker and Java-level accesses.
+  Atomic::xchg(0, &_counter);
+
+  // If externally suspended while waiting, re-suspend
+  if (jt->handle_special_suspend_equivalent_condition()) {
+    jt->java_suspend_self();
+  }
+}
+
+void Parker::unpark() {
+  if (Atomic::xchg(1, &_counter) < 0) {
+    // thread is definitely parked
+    futex_wake_one(&_counter);
+  }
+}
+
+#else // !LINUX
+
 // PlatformEvent
 //
 // Assumption:
@@ -2199,6 +2434,8 @@ void Parker::unpark() {
   }
 }
 
+#endif // LINUX
+
 // Platform Monitor implementation
 
 os::PlatformMonitor::PlatformMonitor() {
@@ -182,8 +182,10 @@ class PlatformEvent : public CHeapObj<mtSynchronizer> {
   double cachePad[4];        // Increase odds that _mutex is sole occupant of cache line
   volatile int _event;       // Event count/permit: -1, 0 or 1
   volatile int _nParked;     // Indicates if associated thread is blocked: 0 or 1
+#ifndef LINUX
   pthread_mutex_t _mutex[1]; // Native mutex for locking
   pthread_cond_t  _cond[1];  // Native condition variable for blocking
+#endif                       // Linux blocks on a futex on _event
   double postPad[2];
 
  protected:       // TODO-FIXME: make dtor private
@@ -213,6 +215,9 @@ class PlatformEvent : public CHeapObj<mtSynchronizer> {
 // level of encapsulation - so combining the two remains a future project.
 
 class PlatformParker : public CHeapObj<mtSynchronizer> {
+#ifndef LINUX
+  // Linux needs no data structures, the Parker blocks on a futex on its
+  // permit counter.
  protected:
   enum {
     REL_INDEX = 0,
@@ -221,6 +226,7 @@ class PlatformParker : public CHeapObj<mtSynchronizer> {
   int _cur_index;  // which cond is in use: -1, 0, 1
   pthread_mutex_t _mutex[1];
   pthread_cond_t  _cond[2]; // one for relative times and one for absolute
+#endif
 
  public:       // TODO-FIXME: make dtor private
   ~PlatformParker() { guarantee(false, "invariant"); }
@@ -2476,6 +2476,10 @@ bool os::pd_uncommit_memory(char* addr, size_t bytes) {
                                 PROT_NONE);
 }
 
+bool os::pd_pretouch_memory(void* start, void* end, size_t page_size) {
+  return false;
+}
+
 char* os::Solaris::mmap_chunk(char *addr, size_t size, int flags, int prot) {
   char *b = (char *)mmap(addr, size, prot, flags, os::Solaris::_dev_zero_fd, 0);
 
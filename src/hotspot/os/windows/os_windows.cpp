@@ -3303,6 +3303,10 @@ bool os::pd_uncommit_memory(char* addr, size_t bytes) {
   return (VirtualFree(addr, bytes, MEM_DECOMMIT) != 0);
 }
 
+bool os::pd_pretouch_memory(void* start, void* end, size_t page_size) {
+  return false;
+}
+
 bool os::pd_release_memory(char* addr, size_t bytes) {
   return VirtualFree(addr, 0, MEM_RELEASE) != 0;
 }
@@ -424,3 +424,19 @@ size_t ZBackingFile::try_expand(size_t offset, size_t length, size_t alignment)
     }
   }
 }
+
+bool ZBackingFile::try_shrink(size_t size) const {
+  log_debug(gc)("Shrinking heap to " SIZE_FORMAT "M", size / M);
+
+  // Truncating the file releases the memory backing
+  // the truncated part on both tmpfs and hugetlbfs.
+  while (ftruncate(_fd, size) == -1) {
+    ZErrno err;
+    if (err != EINTR) {
+      log_error(gc)("Failed to truncate backing file (%s)", err.to_string());
+      return false;
+    }
+  }
+
+  return true;
+}
@@ -58,6 +58,7 @@ public:
   size_t available() const;
 
   size_t try_expand(size_t offset, size_t length, size_t alignment) const;
+  bool try_shrink(size_t size) const;
 };
 
 #endif // OS_CPU_LINUX_X86_GC_Z_ZBACKINGFILE_LINUX_X86_HPP
@@ -144,6 +144,34 @@ size_t ZPhysicalMemoryBacking::try_expand(size_t old_capacity, size_t new_capaci
   return capacity;
 }
 
+size_t ZPhysicalMemoryBacking::try_shrink(size_t old_capacity, size_t new_capacity) {
+  assert(old_capacity > new_capacity, "Invalid old/new capacity");
+
+  // Remove the free memory at the end of the backing file from the free list
+  size_t allocated = 0;
+  const uintptr_t start = _manager.alloc_from_back_at_most(old_capacity - new_capacity, &allocated);
+  if (allocated == 0) {
+    // No free memory
+    return old_capacity;
+  }
+
+  if (start + allocated != old_capacity) {
+    // The end of the backing file is in use
+    _manager.free(start, allocated);
+    return old_capacity;
+  }
+
+  assert(is_aligned(start, _granule_size), "Invalid start");
+
+  if (!_file.try_shrink(start)) {
+    // Failed, add the memory back to the free list
+    _manager.free(start, allocated);
+    return old_capacity;
+  }
+
+  return start;
+}
+
 ZPhysicalMemory ZPhysicalMemoryBacking::alloc(size_t size) {
   assert(is_aligned(size, _granule_size), "Invalid size");
 
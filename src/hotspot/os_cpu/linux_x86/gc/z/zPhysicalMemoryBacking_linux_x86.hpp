@@ -51,6 +51,7 @@ public:
   bool is_initialized() const;
 
   size_t try_expand(size_t old_capacity, size_t new_capacity);
+  size_t try_shrink(size_t old_capacity, size_t new_capacity);
 
   ZPhysicalMemory alloc(size_t size);
   void free(ZPhysicalMemory pmem);
@@ -916,6 +916,19 @@ void LIR_OpVisitState::visit(LIR_Op* op) {
       do_temp(opProfileType->_tmp);
       break;
     }
+
+#ifdef X86
+// LIR_OpProfileSample:
+    case lir_profile_sample: {
+      assert(op->as_OpProfileSample() != NULL, "must be");
+      LIR_OpProfileSample* opProfileSample = (LIR_OpProfileSample*)op;
+
+      do_input(opProfileSample->_counter);
+      do_input(opProfileSample->_thread);
+      do_temp(opProfileSample->_tmp);
+      break;
+    }
+#endif
   default:
     op->visit(this);
   }
@@ -1073,6 +1086,12 @@ void LIR_OpProfileType::emit_code(LIR_Assembler* masm) {
   masm->emit_profile_type(this);
 }
 
+#ifdef X86
+void LIR_OpProfileSample::emit_code(LIR_Assembler* masm) {
+  masm->emit_profile_sample(this);
+}
+#endif
+
 // LIR_List
 LIR_List::LIR_List(Compilation* compilation, BlockBegin* block)
   : _operations(8)
@@ -1732,6 +1751,10 @@ const char * LIR_Op::name() const {
      case lir_profile_call:          s = "profile_call";  break;
      // LIR_OpProfileType
      case lir_profile_type:          s = "profile_type";  break;
+#ifdef X86
+     // LIR_OpProfileSample
+     case lir_profile_sample:        s = "profile_sample"; break;
+#endif
      // LIR_OpAssert
 #ifdef ASSERT
      case lir_assert:                s = "assert";        break;
@@ -2030,6 +2053,16 @@ void LIR_OpProfileType::print_instr(outputStream* out) const {
   tmp()->print(out);          out->print(" ");
 }
 
+#ifdef X86
+// LIR_OpProfileSample
+void LIR_OpProfileSample::print_instr(outputStream* out) const {
+  counter()->print(out);      out->print(" ");
+  thread()->print(out);       out->print(" ");
+  tmp()->print(out);          out->print(" ");
+  out->print("incr = %d mask = 0x%x", increment(), mask());
+}
+#endif
+
 #endif // PRODUCT
 
 // Implementation of LIR_InsertionBuffer
@@ -872,6 +872,9 @@ class    LIR_OpTypeCheck;
 class    LIR_OpCompareAndSwap;
 class    LIR_OpProfileCall;
 class    LIR_OpProfileType;
+#ifdef X86
+class    LIR_OpProfileSample;
+#endif
 #ifdef ASSERT
 class    LIR_OpAssert;
 #endif
@@ -991,6 +994,9 @@ enum LIR_Code {
   , begin_opMDOProfile
     , lir_profile_call
     , lir_profile_type
+#ifdef X86
+    , lir_profile_sample
+#endif
   , end_opMDOProfile
   , begin_opAssert
     , lir_assert
@@ -1136,6 +1142,9 @@ class LIR_Op: public CompilationResourceObj {
   virtual LIR_OpCompareAndSwap* as_OpCompareAndSwap() { return NULL; }
   virtual LIR_OpProfileCall* as_OpProfileCall() { return NULL; }
   virtual LIR_OpProfileType* as_OpProfileType() { return NULL; }
+#ifdef X86
+  virtual LIR_OpProfileSample* as_OpProfileSample() { return NULL; }
+#endif
 #ifdef ASSERT
   virtual LIR_OpAssert* as_OpAssert() { return NULL; }
 #endif
@@ -1962,6 +1971,42 @@ class LIR_OpProfileType : public LIR_Op {
   virtual void print_instr(outputStream* out) const PRODUCT_RETURN;
 };
 
+#ifdef X86
+// LIR_OpProfileSample
+// Adds _increment to the MDO counter at _counter if the next value of the
+// per-thread random number generator has none of the bits in _mask set.
+// Kills the condition codes.
+class LIR_OpProfileSample : public LIR_Op {
+ friend class LIR_OpVisitState;
+
+ private:
+  LIR_Opr      _counter;
+  LIR_Opr      _thread;
+  LIR_Opr      _tmp;
+  int          _increment;
+  jint         _mask;
+
+ public:
+  LIR_OpProfileSample(LIR_Opr counter, LIR_Opr thread, LIR_Opr tmp, int increment, jint mask)
+    : LIR_Op(lir_profile_sample, LIR_OprFact::illegalOpr, NULL)  // no result, no info
+    , _counter(counter)
+    , _thread(thread)
+    , _tmp(tmp)
+    , _increment(increment)
+    , _mask(mask) { }
+
+  LIR_Opr      counter()          const             { return _counter;          }
+  LIR_Opr      thread()           const             { return _thread;           }
+  LIR_Opr      tmp()              const             { return _tmp;              }
+  int          increment()        const             { return _increment;        }
+  jint         mask()             const             { return _mask;             }
+
+  virtual void emit_code(LIR_Assembler* masm);
+  virtual LIR_OpProfileSample* as_OpProfileSample() { return this; }
+  virtual void print_instr(outputStream* out) const PRODUCT_RETURN;
+};
+#endif // X86
+
 class LIR_InsertionBuffer;
 
 //--------------------------------LIR_List---------------------------------------------------
@@ -2256,6 +2301,11 @@ class LIR_List: public CompilationResourceObj {
   void profile_type(LIR_Address* mdp, LIR_Opr obj, ciKlass* exact_klass, intptr_t current_klass, LIR_Opr tmp, bool not_null, bool no_conflict) {
     append(new LIR_OpProfileType(LIR_OprFact::address(mdp), obj, exact_klass, current_klass, tmp, not_null, no_conflict));
   }
+#ifdef X86
+  void profile_sample(LIR_Address* counter, LIR_Opr thread, LIR_Opr tmp, int increment, jint mask) {
+    append(new LIR_OpProfileSample(LIR_OprFact::address(counter), thread, tmp, increment, mask));
+  }
+#endif
 
   void xadd(LIR_Opr src, LIR_Opr add, LIR_Opr res, LIR_Opr tmp) { append(new LIR_Op2(lir_xadd, src, add, res, tmp)); }
   void xchg(LIR_Opr src, LIR_Opr set, LIR_Opr res, LIR_Opr tmp) { append(new LIR_Op2(lir_xchg, src, set, res, tmp)); }
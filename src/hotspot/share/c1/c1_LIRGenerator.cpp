@@ -934,7 +934,22 @@ LIR_Opr LIRGenerator::force_to_spill(LIR_Opr value, BasicType t) {
   return tmp;
 }
 
-void LIRGenerator::profile_branch(If* if_instr, If::Condition cond) {
+// With C1ProfileSampleLog = n, only one in 2^n updates (on average) is
+// performed, each adding 2^n * step, so the expected count is unchanged
+// and the policy thresholds still apply.
+void LIRGenerator::increment_profile_counter(LIR_Address* addr, int step) {
+#ifdef X86
+  if (profile_sampling()) {
+    int log = (int)C1ProfileSampleLog;
+    jint mask = (jint)(right_n_bits(log) << (BitsPerInt - log));
+    __ profile_sample(addr, getThreadPointer(), new_register(T_INT), step << log, mask);
+    return;
+  }
+#endif
+  increment_counter(addr, step);
+}
+
+bool LIRGenerator::profile_branch(If* if_instr, If::Condition cond, bool can_kill_flags) {
   if (if_instr->should_profile()) {
     ciMethod* method = if_instr->profiled_method();
     assert(method != NULL, "method should be set if branch is profiled");
@@ -960,6 +975,12 @@ void LIRGenerator::profile_branch(If* if_instr, If::Condition cond) {
              LIR_OprFact::intptrConst(not_taken_count_offset),
              data_offset_reg, as_BasicType(if_instr->x()->type()));
 
+    if (can_kill_flags && profile_sampling()) {
+      increment_profile_counter(new LIR_Address(md_reg, data_offset_reg, NOT_LP64(T_INT) LP64_ONLY(T_LONG)),
+                                DataLayout::counter_increment);
+      return true;
+    }
+
     // MDO cells are intptr_t, so the data_reg width is arch-dependent.
     LIR_Opr data_reg = new_pointer_register();
     LIR_Address* data_addr = new LIR_Address(md_reg, data_offset_reg, data_reg->type());
@@ -969,6 +990,7 @@ void LIRGenerator::profile_branch(If* if_instr, If::Condition cond) {
     __ leal(LIR_OprFact::address(fake_incr_value), data_reg);
     __ move(data_reg, data_addr);
   }
+  return false;
 }
 
 // Phi technique:
@@ -2479,8 +2501,8 @@ void LIRGenerator::do_Goto(Goto* x) {
     LIR_Opr md_reg = new_register(T_METADATA);
     __ metadata2reg(md->constant_encoding(), md_reg);
 
-    increment_counter(new LIR_Address(md_reg, offset,
-                                      NOT_LP64(T_INT) LP64_ONLY(T_LONG)), DataLayout::counter_increment);
+    increment_profile_counter(new LIR_Address(md_reg, offset,
+                                              NOT_LP64(T_INT) LP64_ONLY(T_LONG)), DataLayout::counter_increment);
   }
 
   // emit phi-instruction move after safepoint since this simplifies
@@ -337,6 +337,9 @@ class LIRGenerator: public InstructionVisitor, public BlockClosure {
 
   void increment_counter(address counter, BasicType type, int step = 1);
   void increment_counter(LIR_Address* addr, int step = 1);
+  // Sampled MDO counter updates (see C1ProfileSampleLog). Kills flags.
+  bool profile_sampling() const { return X86_ONLY(C1ProfileSampleLog > 0) NOT_X86(false); }
+  void increment_profile_counter(LIR_Address* addr, int step);
 
   // is_strictfp is only needed for mul and div (and only generates different code on i486)
   void arithmetic_op(Bytecodes::Code code, LIR_Opr result, LIR_Opr left, LIR_Opr right, bool is_strictfp, LIR_Opr tmp, CodeEmitInfo* info = NULL);
@@ -394,7 +397,9 @@ class LIRGenerator: public InstructionVisitor, public BlockClosure {
 
   LIR_Opr safepoint_poll_register();
 
-  void profile_branch(If* if_instr, If::Condition cond);
+  // Returns true if the condition codes were killed, which only happens
+  // with sampled profiling and only if the caller allows it.
+  bool profile_branch(If* if_instr, If::Condition cond, bool can_kill_flags = false);
   void increment_event_counter_impl(CodeEmitInfo* info,
                                     ciMethod *method, LIR_Opr step, int frequency,
                                     int bci, bool backedge, bool notify);
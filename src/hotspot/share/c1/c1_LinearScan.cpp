@@ -84,6 +84,7 @@ LinearScan::LinearScan(IR* ir, LIRGenerator* gen, FrameMap* frame_map)
  , _new_intervals_from_allocation(new IntervalList())
  , _sorted_intervals(NULL)
  , _needs_full_resort(false)
+ , _fast_mode(false)
  , _lir_ops(0)     // initialized later with correct length
  , _block_of_op(0) // initialized later with correct length
  , _has_info(0)
@@ -3088,6 +3089,8 @@ void LinearScan::do_linear_scan() {
 
   build_intervals();
   CHECK_BAILOUT();
+  _fast_mode = LinearScanFastModeIntervals > 0 && interval_count() > LinearScanFastModeIntervals;
+  TRACE_LINEAR_SCAN(1, if (_fast_mode) tty->print_cr("using fast mode for %d intervals", interval_count()));
   sort_intervals_before_allocation();
 
   NOT_PRODUCT(print_intervals("Before Register Allocation"));
@@ -5091,6 +5094,12 @@ int LinearScanWalker::find_optimal_split_pos(Interval* it, int min_split_pos, in
     TRACE_LINEAR_SCAN(4, tty->print_cr("      min-pos and max-pos are equal, no optimization possible"));
     optimal_split_pos = min_split_pos;
 
+  } else if (allocator()->fast_mode()) {
+    // searching the blocks between min_split_pos and max_split_pos for every
+    // split makes allocation quadratic in huge methods, so split as late as possible
+    TRACE_LINEAR_SCAN(4, tty->print_cr("      fast mode, splitting at max_split_pos"));
+    optimal_split_pos = max_split_pos;
+
   } else {
     assert(min_split_pos < max_split_pos, "must be true then");
     assert(min_split_pos > 0, "cannot access min_split_pos - 1 otherwise");
@@ -139,6 +139,7 @@ class LinearScan : public CompilationResourceObj {
   IntervalList*             _new_intervals_from_allocation; // list with all intervals created during allocation when an existing interval is split
   IntervalArray*            _sorted_intervals;  // intervals sorted by Interval::from()
   bool                      _needs_full_resort; // set to true if an Interval::from() is changed and _sorted_intervals must be resorted
+  bool                      _fast_mode;         // true if the method has too many intervals for the split position search (see LinearScanFastModeIntervals)
 
   LIR_OpArray               _lir_ops;           // mapping from LIR_Op id to LIR_Op node
   BlockBeginArray           _block_of_op;       // mapping from LIR_Op id to the BlockBegin containing this instruction
@@ -188,6 +189,7 @@ class LinearScan : public CompilationResourceObj {
 
   // access to interval list
   int           interval_count() const           { return _intervals.length(); }
+  bool          fast_mode() const                { return _fast_mode; }
   Interval*     interval_at(int reg_num) const   { return _intervals.at(reg_num); }
 
   IntervalList* new_intervals_from_allocation() const { return _new_intervals_from_allocation; }
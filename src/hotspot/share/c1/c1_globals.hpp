@@ -218,6 +218,12 @@
   develop(bool, CountLinearScan, false,                                     \
           "collect statistic counters during LinearScan")                   \
                                                                             \
+  product(intx, LinearScanFastModeIntervals, 10000,                         \
+          "Number of intervals above which LinearScan splits intervals "    \
+          "as late as possible instead of searching for the best block "    \
+          "boundary (0 = never)")                                           \
+          range(0, max_jint)                                                \
+                                                                            \
   /* C1 variable */                                                         \
                                                                             \
   develop(bool, C1Breakpoint, false,                                        \
@@ -312,6 +318,11 @@
   product(bool, C1ProfileBranches, true,                                    \
           "Profile branches when generating code for updating MDOs")        \
                                                                             \
+  product(intx, C1ProfileSampleLog, 0,                                      \
+          "Update branch profiles only once every 2^n times on average, "   \
+          "adding 2^n to the counter (0 = always update, x86 only)")        \
+          range(0, 16)                                                      \
+                                                                            \
   product(bool, C1ProfileCheckcasts, true,                                  \
           "Profile checkcasts when generating code for updating MDOs")      \
                                                                             \
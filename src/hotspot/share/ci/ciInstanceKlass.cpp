@@ -219,6 +219,10 @@ ciInstanceKlass* ciInstanceKlass::get_canonical_holder(int offset) {
     if (super == NULL || super->nof_nonstatic_fields() == 0 ||
         !super->contains_field_offset(offset)) {
       return self;
+    } else if (super->get_field_by_offset(offset, false) == NULL &&
+               self->get_field_by_offset(offset, false) != NULL) {
+      // A field of mine filling the gap at the end of my super's fields.
+      return self;
     } else {
       self = super;  // return super->get_canonical_holder(offset)
     }
@@ -451,21 +455,14 @@ int ciInstanceKlass::compute_nonstatic_fields() {
   }
   assert(!is_java_lang_Object(), "bootstrap OK");
 
-  // Size in bytes of my fields, including inherited fields.
-  int fsize = nonstatic_field_size() * heapOopSize;
-
   ciInstanceKlass* super = this->super();
   GrowableArray<ciField*>* super_fields = NULL;
   if (super != NULL && super->has_nonstatic_fields()) {
-    int super_fsize  = super->nonstatic_field_size() * heapOopSize;
     int super_flen   = super->nof_nonstatic_fields();
     super_fields = super->_nonstatic_fields;
     assert(super_flen == 0 || super_fields != NULL, "first get nof_fields");
-    // See if I am no larger than my super; if so, I can use his fields.
-    if (fsize == super_fsize) {
-      _nonstatic_fields = super_fields;
-      return super_fields->length();
-    }
+    // Do not shortcut on equal field sizes: with CompactFields my fields
+    // may all live in the gap at the end of my super's fields.
   }
 
   GrowableArray<ciField*>* fields = NULL;
@@ -78,6 +78,7 @@
 #include "utilities/ostream.hpp"
 #include "utilities/resourceHash.hpp"
 #if INCLUDE_CDS
+#include "classfile/classListWriter.hpp"
 #include "classfile/systemDictionaryShared.hpp"
 #endif
 #if INCLUDE_JFR
@@ -1727,10 +1728,14 @@ void ClassFileParser::parse_fields(const ClassFileStream* const cfs,
 
   assert(NULL == _fields, "invariant");
 
-  _fields =
-    MetadataFactory::new_array<u2>(_loader_data,
-                                   index * FieldInfo::field_slots + num_generic_signature,
-                                   CHECK);
+  const int fields_length = index * FieldInfo::field_slots + num_generic_signature;
+  if (fields_length == 0) {
+    // Share the empty array between all classes without fields, which
+    // includes most lambda proxy and other generated classes.
+    _fields = Universe::the_empty_short_array();
+  } else {
+    _fields = MetadataFactory::new_array<u2>(_loader_data, fields_length, CHECK);
+  }
   // Sometimes injected fields already exist in the Java source so
   // the fields array could be too long.  In that case the
   // fields array is trimed. Also unused slots that were reserved
@@ -3150,6 +3155,11 @@ u2 ClassFileParser::parse_classfile_inner_classes_attribute(const ClassFileStrea
   //    enclosing_method_class_index,
   //    enclosing_method_method_index]
   const int size = length * 4 + (parsed_enclosingmethod_attribute ? 2 : 0);
+  if (size == 0) {
+    _inner_classes = Universe::the_empty_short_array();
+    cfs->set_current(current_mark);
+    return 0;
+  }
   Array<u2>* const inner_classes = MetadataFactory::new_array<u2>(_loader_data, size, CHECK_0);
   _inner_classes = inner_classes;
 
@@ -3765,6 +3775,33 @@ const InstanceKlass* ClassFileParser::parse_super_class(ConstantPool* const cp,
   return super_klass;
 }
 
+// Returns the end offset of the last nonstatic field of the closest
+// superclass that declares nonstatic fields, or -1 if there is none or
+// if the space after it must not be used. The fields of a subclass start
+// at a heapOopSize aligned offset, so up to heapOopSize - 1 bytes can be
+// left unused between the two.
+static int super_nonstatic_fields_end(const InstanceKlass* super) {
+  for (const InstanceKlass* k = super; k != NULL; k = k->java_super()) {
+    if (!k->has_nonstatic_fields() || k->is_contended()) {
+      return -1;
+    }
+    int fields_end = -1;
+    for (AllFieldStream fs(const_cast<InstanceKlass*>(k)); !fs.done(); fs.next()) {
+      if (fs.access_flags().is_static()) continue;
+      if (fs.is_contended()) {
+        // The padding after contended fields has to stay free
+        return -1;
+      }
+      const BasicType type = FieldType::basic_type(fs.signature());
+      fields_end = MAX2(fields_end, fs.offset() + type2aelembytes(type));
+    }
+    if (fields_end >= 0) {
+      return fields_end;
+    }
+  }
+  return -1;
+}
+
 static unsigned int compute_oop_map_count(const InstanceKlass* super,
                                           unsigned int nonstatic_oop_map_count,
                                           int first_nonstatic_oop_offset) {
@@ -4012,6 +4049,42 @@ void ClassFileParser::layout_fields(ConstantPool* cp,
     ShouldNotReachHere();
   }
 
+  // Try to squeeze some of the fields into the unused tail of the
+  // superclass fields. The gap ends at a heapOopSize aligned offset, so
+  // filling it downwards with ints, shorts and bytes keeps them aligned.
+  int super_gap_word_count   = 0;
+  int super_gap_short_count  = 0;
+  int super_gap_byte_count   = 0;
+  int super_gap_word_offset  = 0;
+  int super_gap_short_offset = 0;
+  int super_gap_byte_offset  = 0;
+  if (compact_fields && !is_contended_class && _super_klass != NULL) {
+    const int super_end = super_nonstatic_fields_end(_super_klass);
+    assert(super_end <= nonstatic_fields_start, "superclass fields overlap");
+    if (super_end >= 0 && nonstatic_fields_start - super_end < heapOopSize) {
+      assert(is_aligned(nonstatic_fields_start, BytesPerInt), "gap end must be aligned");
+      int offset = nonstatic_fields_start;
+      while (offset - BytesPerInt >= super_end && nonstatic_word_count > 0) {
+        nonstatic_word_count -= 1;
+        super_gap_word_count += 1;
+        offset -= BytesPerInt;
+      }
+      super_gap_word_offset = offset;
+      while (offset - BytesPerShort >= super_end && nonstatic_short_count > 0) {
+        nonstatic_short_count -= 1;
+        super_gap_short_count += 1;
+        offset -= BytesPerShort;
+      }
+      super_gap_short_offset = offset;
+      while (offset - 1 >= super_end && nonstatic_byte_count > 0) {
+        nonstatic_byte_count -= 1;
+        super_gap_byte_count += 1;
+        offset -= 1;
+      }
+      super_gap_byte_offset = offset;
+    }
+  }
+
   int nonstatic_oop_space_count   = 0;
   int nonstatic_word_space_count  = 0;
   int nonstatic_short_space_count = 0;
@@ -4147,7 +4220,11 @@ void ClassFileParser::layout_fields(ConstantPool* cp,
         }
         break;
       case NONSTATIC_BYTE:
-        if( nonstatic_byte_space_count > 0 ) {
+        if (super_gap_byte_count > 0) {
+          real_offset = super_gap_byte_offset;
+          super_gap_byte_offset += 1;
+          super_gap_byte_count  -= 1;
+        } else if( nonstatic_byte_space_count > 0 ) {
           real_offset = nonstatic_byte_space_offset;
           nonstatic_byte_space_offset += 1;
           nonstatic_byte_space_count  -= 1;
@@ -4157,7 +4234,11 @@ void ClassFileParser::layout_fields(ConstantPool* cp,
         }
         break;
       case NONSTATIC_SHORT:
-        if( nonstatic_short_space_count > 0 ) {
+        if (super_gap_short_count > 0) {
+          real_offset = super_gap_short_offset;
+          super_gap_short_offset += BytesPerShort;
+          super_gap_short_count  -= 1;
+        } else if( nonstatic_short_space_count > 0 ) {
           real_offset = nonstatic_short_space_offset;
           nonstatic_short_space_offset += BytesPerShort;
           nonstatic_short_space_count  -= 1;
@@ -4167,7 +4248,11 @@ void ClassFileParser::layout_fields(ConstantPool* cp,
         }
         break;
       case NONSTATIC_WORD:
-        if( nonstatic_word_space_count > 0 ) {
+        if (super_gap_word_count > 0) {
+          real_offset = super_gap_word_offset;
+          super_gap_word_offset += BytesPerInt;
+          super_gap_word_count  -= 1;
+        } else if( nonstatic_word_space_count > 0 ) {
           real_offset = nonstatic_word_space_offset;
           nonstatic_word_space_offset += BytesPerInt;
           nonstatic_word_space_count  -= 1;
@@ -5671,6 +5756,44 @@ void ClassFileParser::fill_instance_klass(InstanceKlass* ik, bool changed_by_loa
 
   ClassLoadingService::notify_class_loaded(ik, false /* not shared class */);
 
+#if INCLUDE_CDS
+  if (!is_internal() && DumpLoadedClassList != NULL && _stream->source() != NULL &&
+      classlist_file->is_open()) {
+    if (!ClassLoader::has_jrt_entry()) {
+      warning("DumpLoadedClassList and CDS are not supported in exploded build");
+      DumpLoadedClassList = NULL;
+    } else if (_unsafe_anonymous_host == NULL) {
+      // Only dump the classes that can be stored into CDS archive; ClassListWriter
+      // decides for classes of custom loaders.
+      // Unsafe anonymous classes such as generated LambdaForm classes are also not included.
+      oop class_loader = _loader_data->class_loader();
+      ResourceMark rm(THREAD);
+      bool skip = false;
+      if (class_loader == NULL || SystemDictionary::is_platform_class_loader(class_loader)) {
+        // For the boot and platform class loaders, skip classes that are not found in the
+        // java runtime image, such as those found in the --patch-module entries.
+        // These classes can't be loaded from the archive during runtime.
+        if (!ClassLoader::is_modules_image(_stream->source()) && strncmp(_stream->source(), "jrt:", 4) != 0) {
+          skip = true;
+        }
+
+        if (class_loader == NULL && ClassLoader::contains_append_entry(_stream->source())) {
+          // .. but don't skip the boot classes that are loaded from -Xbootclasspath/a
+          // as they can be loaded from the archive during runtime.
+          skip = false;
+        }
+      }
+      if (skip) {
+        tty->print_cr("skip writing class %s from source %s to classlist file",
+          _class_name->as_C_string(), _stream->source());
+        ClassListWriter::forget(ik);
+      } else {
+        ClassListWriter::write(ik, _stream->source());
+      }
+    }
+  }
+#endif
+
   if (!is_internal()) {
     if (log_is_enabled(Info, class, load)) {
       ResourceMark rm;
@@ -5939,7 +6062,7 @@ ClassFileParser::~ClassFileParser() {
   if (_cp != NULL) {
     MetadataFactory::free_metadata(_loader_data, _cp);
   }
-  if (_fields != NULL) {
+  if (_fields != NULL && _fields != Universe::the_empty_short_array()) {
     MetadataFactory::free_array<u2>(_loader_data, _fields);
   }
 
@@ -6136,43 +6259,6 @@ void ClassFileParser::parse_stream(const ClassFileStream* const stream,
       }
       ls.cr();
     }
-
-#if INCLUDE_CDS
-    if (DumpLoadedClassList != NULL && stream->source() != NULL && classlist_file->is_open()) {
-      if (!ClassLoader::has_jrt_entry()) {
-        warning("DumpLoadedClassList and CDS are not supported in exploded build");
-        DumpLoadedClassList = NULL;
-      } else if (SystemDictionaryShared::is_sharing_possible(_loader_data) &&
-                 _unsafe_anonymous_host == NULL) {
-        // Only dump the classes that can be stored into CDS archive.
-        // Unsafe anonymous classes such as generated LambdaForm classes are also not included.
-        oop class_loader = _loader_data->class_loader();
-        ResourceMark rm(THREAD);
-        bool skip = false;
-        if (class_loader == NULL || SystemDictionary::is_platform_class_loader(class_loader)) {
-          // For the boot and platform class loaders, skip classes that are not found in the
-          // java runtime image, such as those found in the --patch-module entries.
-          // These classes can't be loaded from the archive during runtime.
-          if (!ClassLoader::is_modules_image(stream->source()) && strncmp(stream->source(), "jrt:", 4) != 0) {
-            skip = true;
-          }
-
-          if (class_loader == NULL && ClassLoader::contains_append_entry(stream->source())) {
-            // .. but don't skip the boot classes that are loaded from -Xbootclasspath/a
-            // as they can be loaded from the archive during runtime.
-            skip = false;
-          }
-        }
-        if (skip) {
-          tty->print_cr("skip writing class %s from source %s to classlist file",
-            _class_name->as_C_string(), stream->source());
-        } else {
-          classlist_file->print_cr("%s", _class_name->as_C_string());
-          classlist_file->flush();
-        }
-      }
-    }
-#endif
   }
 
   // SUPERKLASS
@@ -0,0 +1,131 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#include "precompiled.hpp"
+#include "classfile/classListWriter.hpp"
+#include "classfile/systemDictionaryShared.hpp"
+#include "memory/resourceArea.hpp"
+#include "oops/instanceKlass.hpp"
+#include "runtime/mutexLocker.hpp"
+#include "utilities/ostream.hpp"
+#include "utilities/resourceHash.hpp"
+
+int ClassListWriter::_next_id = 0;
+
+// Keyed by the klass; InstanceKlass::unload_class() drops the entry of an
+// unloaded class so that a klass reusing its address gets a fresh id.
+static ResourceHashtable<
+  const InstanceKlass*, int,
+  primitive_hash<const InstanceKlass*>,
+  primitive_equals<const InstanceKlass*>,
+  15889,                            // prime number
+  ResourceObj::C_HEAP> _class_ids;
+
+// ClassListParser allows a single class of each name from custom loaders.
+static ResourceHashtable<
+  Symbol*, bool,
+  primitive_hash<Symbol*>,
+  primitive_equals<Symbol*>,
+  6661,                             // prime number
+  ResourceObj::C_HEAP> _written_unregistered_classes;
+
+bool ClassListWriter::id_of(const InstanceKlass* k, int* id) {
+  int* p = _class_ids.get(k);
+  if (p == NULL) {
+    return false;
+  }
+  *id = *p;
+  return true;
+}
+
+// ClassListParser loads classes of custom loaders from jar files only.
+const char* ClassListWriter::jar_path(const char* source) {
+  if (source == NULL || strncmp(source, "file:", 5) != 0) {
+    return NULL;
+  }
+  const char* path = source + 5;
+  size_t len = strlen(path);
+  if (len < 4 || strcmp(path + len - 4, ".jar") != 0 ||
+      strchr(path, '%') != NULL || strchr(path, ' ') != NULL) {
+    return NULL;
+  }
+#ifdef _WINDOWS
+  // file:/C:/dir/app.jar
+  if (path[0] == '/' && path[1] != '\0' && path[2] == ':') {
+    path++;
+  }
+#endif
+  return path;
+}
+
+void ClassListWriter::write(const InstanceKlass* k, const char* source) {
+  MutexLockerEx ml(ClassListFile_lock, Mutex::_no_safepoint_check_flag);
+  ResourceMark rm;
+
+  bool builtin = SystemDictionaryShared::is_sharing_possible(k->class_loader_data());
+  const char* path = NULL;
+  int super_id = -1;
+  Array<InstanceKlass*>* interfaces = k->local_interfaces();
+  if (!builtin) {
+    path = jar_path(source);
+    if (path == NULL || k->super() == NULL ||
+        !id_of(InstanceKlass::cast(k->super()), &super_id) ||
+        _written_unregistered_classes.get(k->name()) != NULL) {
+      _class_ids.remove(k);
+      return;
+    }
+    for (int i = 0; i < interfaces->length(); i++) {
+      int interface_id;
+      if (!id_of(interfaces->at(i), &interface_id)) {
+        _class_ids.remove(k);
+        return;
+      }
+    }
+    k->name()->increment_refcount();
+    _written_unregistered_classes.put(k->name(), true);
+  }
+
+  int id = _next_id++;
+  _class_ids.put(k, id);
+  classlist_file->print("%s id: %d", k->name()->as_C_string(), id);
+  if (!builtin) {
+    classlist_file->print(" super: %d", super_id);
+    if (interfaces->length() > 0) {
+      classlist_file->print(" interfaces:");
+      for (int i = 0; i < interfaces->length(); i++) {
+        int interface_id;
+        id_of(interfaces->at(i), &interface_id);
+        classlist_file->print(" %d", interface_id);
+      }
+    }
+    classlist_file->print(" source: %s", path);
+  }
+  classlist_file->cr();
+  classlist_file->flush();
+}
+
+void ClassListWriter::forget(const InstanceKlass* k) {
+  MutexLockerEx ml(ClassListFile_lock, Mutex::_no_safepoint_check_flag);
+  _class_ids.remove(k);
+}
@@ -0,0 +1,51 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#ifndef SHARE_CLASSFILE_CLASSLISTWRITER_HPP
+#define SHARE_CLASSFILE_CLASSLISTWRITER_HPP
+
+#include "memory/allocation.hpp"
+
+class InstanceKlass;
+
+// Writes the -XX:DumpLoadedClassList file in the format read by
+// ClassListParser. Every class gets an id so that classes loaded by
+// custom class loaders can name their super class and interfaces;
+// those are written with a "source:" jar file so that -Xshare:dump
+// can load them again.
+class ClassListWriter : AllStatic {
+  static int _next_id;
+
+  static bool id_of(const InstanceKlass* k, int* id);
+  static const char* jar_path(const char* source);
+public:
+  // Writes k, which was loaded from source. The source may be NULL for
+  // classes of the boot, platform and app class loaders.
+  static void write(const InstanceKlass* k, const char* source);
+  // Drops any id recorded for k when k is not written to the list or
+  // when k is unloaded.
+  static void forget(const InstanceKlass* k);
+};
+
+#endif // SHARE_CLASSFILE_CLASSLISTWRITER_HPP
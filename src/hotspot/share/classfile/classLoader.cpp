@@ -83,6 +83,7 @@ typedef jboolean (*ReadEntry_t)(jzfile *zip, jzentry *entry, unsigned char *buf,
 typedef jzentry* (*GetNextEntry_t)(jzfile *zip, jint n);
 typedef jboolean (*ZipInflateFully_t)(void *inBuf, jlong inLen, void *outBuf, jlong outLen, char **pmsg);
 typedef jint     (*Crc32_t)(jint crc, const jbyte *buf, jint len);
+typedef jlong    (*ZipGZipFully_t)(void *inBuf, jlong inLen, void *outBuf, jlong outLen, jint level, char **pmsg);
 
 static ZipOpen_t         ZipOpen            = NULL;
 static ZipClose_t        ZipClose           = NULL;
@@ -92,6 +93,7 @@ static GetNextEntry_t    GetNextEntry       = NULL;
 static canonicalize_fn_t CanonicalizeEntry  = NULL;
 static ZipInflateFully_t ZipInflateFully    = NULL;
 static Crc32_t           Crc32              = NULL;
+static ZipGZipFully_t    ZipGZipFully       = NULL;
 
 // Entry points for jimage.dll for loading jimage file entries
 
@@ -1050,6 +1052,8 @@ void ClassLoader::load_zip_library() {
   GetNextEntry = CAST_TO_FN_PTR(GetNextEntry_t, os::dll_lookup(handle, "ZIP_GetNextEntry"));
   ZipInflateFully = CAST_TO_FN_PTR(ZipInflateFully_t, os::dll_lookup(handle, "ZIP_InflateFully"));
   Crc32        = CAST_TO_FN_PTR(Crc32_t, os::dll_lookup(handle, "ZIP_CRC32"));
+  // Only needed for compressed heap dumps, do not check for non-null here
+  ZipGZipFully = CAST_TO_FN_PTR(ZipGZipFully_t, os::dll_lookup(handle, "ZIP_GZip_Fully"));
 
   // ZIP_Close is not exported on Windows in JDK5.0 so don't abort if ZIP_Close is NULL
   if (ZipOpen == NULL || FindEntry == NULL || ReadEntry == NULL ||
@@ -1100,6 +1104,15 @@ jboolean ClassLoader::decompress(void *in, u8 inSize, void *out, u8 outSize, cha
   return (*ZipInflateFully)(in, inSize, out, outSize, pmsg);
 }
 
+bool ClassLoader::can_gzip() {
+  return ZipGZipFully != NULL;
+}
+
+size_t ClassLoader::gzip(void *in, size_t inSize, void *out, size_t outSize, int level, char **pmsg) {
+  assert(ZipGZipFully != NULL, "ZIP_GZip_Fully is not found");
+  return (size_t)(*ZipGZipFully)(in, (jlong)inSize, out, (jlong)outSize, level, pmsg);
+}
+
 int ClassLoader::crc32(int crc, const char* buf, int len) {
   assert(Crc32 != NULL, "ZIP_CRC32 is not found");
   return (*Crc32)(crc, (const jbyte*)buf, len);
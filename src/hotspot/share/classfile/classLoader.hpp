@@ -272,6 +272,10 @@ class ClassLoader: AllStatic {
  public:
   static jboolean decompress(void *in, u8 inSize, void *out, u8 outSize, char **pmsg);
   static int crc32(int crc, const char* buf, int len);
+  static bool can_gzip();
+  // compresses in into out as one gzip member, returns the compressed
+  // size or 0 on failure
+  static size_t gzip(void *in, size_t inSize, void *out, size_t outSize, int level, char **pmsg);
   static bool update_class_path_entry_list(const char *path,
                                            bool check_for_duplicates,
                                            bool is_boot_append,
@@ -595,12 +595,14 @@ void ClassLoaderDataGraph::purge() {
   DependencyContext::purge_dependency_contexts();
 }
 
-int ClassLoaderDataGraph::resize_if_needed() {
-  assert(SafepointSynchronize::is_at_safepoint(), "must be at safepoint!");
+int ClassLoaderDataGraph::resize_dictionaries(JavaThread* jt) {
+  assert(jt == Thread::current(), "must be current thread");
   int resized = 0;
   if (Dictionary::does_any_dictionary_needs_resizing()) {
+    Dictionary::clear_some_dictionary_needs_resizing();
+    MutexLocker ml(ClassLoaderDataGraph_lock, jt);
     FOR_ALL_DICTIONARY(cld) {
-      if (cld->dictionary()->resize_if_needed()) {
+      if (cld->dictionary()->resize_if_needed(jt)) {
         resized++;
       }
     }
@@ -128,7 +128,8 @@ class ClassLoaderDataGraph : public AllStatic {
     }
   }
 
-  static int resize_if_needed();
+  // Grows the dictionaries that have become too loaded, called by the ServiceThread.
+  static int resize_dictionaries(JavaThread* jt);
 
   static bool has_metaspace_oom()           { return _metaspace_oom; }
   static void set_metaspace_oom(bool value) { _metaspace_oom = value; }
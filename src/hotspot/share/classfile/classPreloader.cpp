@@ -0,0 +1,182 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#include "precompiled.hpp"
+#include "jvm.h"
+#include "classfile/classPreloader.hpp"
+#include "classfile/javaClasses.hpp"
+#include "classfile/symbolTable.hpp"
+#include "classfile/systemDictionary.hpp"
+#include "logging/log.hpp"
+#include "memory/resourceArea.hpp"
+#include "memory/universe.hpp"
+#include "oops/instanceKlass.hpp"
+#include "runtime/atomic.hpp"
+#include "runtime/handles.inline.hpp"
+#include "runtime/javaCalls.hpp"
+#include "runtime/os.hpp"
+#include "runtime/thread.hpp"
+#include "utilities/growableArray.hpp"
+
+GrowableArray<char*>* ClassPreloader::_class_names = NULL;
+volatile int ClassPreloader::_next_index = 0;
+volatile int ClassPreloader::_loaded_count = 0;
+volatile int ClassPreloader::_failed_count = 0;
+volatile int ClassPreloader::_running_threads = 0;
+
+bool ClassPreloader::read_class_list(const char* path) {
+  // Use os::open() because neither fopen() nor os::fopen()
+  // can handle long path name on Windows.
+  int fd = os::open(path, O_RDONLY, S_IREAD);
+  FILE* file = (fd != -1) ? os::open(fd, "r") : NULL;
+  if (file == NULL) {
+    char errmsg[JVM_MAXPATHLEN];
+    os::lasterror(errmsg, JVM_MAXPATHLEN);
+    log_warning(class, preload)("Cannot open class list %s: %s", path, errmsg);
+    return false;
+  }
+
+  _class_names = new (ResourceObj::C_HEAP, mtClass) GrowableArray<char*>(1024, true);
+  char line[1024];
+  while (fgets(line, sizeof(line), file) != NULL) {
+    if (line[0] == '#') {
+      continue;
+    }
+    // Classes of custom loaders ("source:") cannot be found by the
+    // system class loader.
+    if (strstr(line, " source:") != NULL) {
+      continue;
+    }
+    size_t len = strcspn(line, " \t\r\n");
+    if (len == 0) {
+      continue;
+    }
+    char* name = NEW_C_HEAP_ARRAY(char, len + 1, mtClass);
+    strncpy(name, line, len);
+    name[len] = '\0';
+    _class_names->append(name);
+  }
+  fclose(file);
+  return true;
+}
+
+void ClassPreloader::free_class_list() {
+  for (int i = 0; i < _class_names->length(); i++) {
+    FREE_C_HEAP_ARRAY(char, _class_names->at(i));
+  }
+  delete _class_names;
+  _class_names = NULL;
+}
+
+void ClassPreloader::start(TRAPS) {
+  assert(PreloadClassList != NULL, "sanity");
+  if (!read_class_list(PreloadClassList)) {
+    return;
+  }
+  if (_class_names->is_empty()) {
+    free_class_list();
+    return;
+  }
+  log_info(class, preload)("Preloading %d classes from %s on " UINTX_FORMAT " threads",
+                           _class_names->length(), PreloadClassList, PreloadClassListThreads);
+
+  // Count the starting thread so that the summary is not logged before
+  // all preloader threads are started.
+  Atomic::inc(&_running_threads);
+  for (uintx i = 0; i < PreloadClassListThreads; i++) {
+    char name[32];
+    jio_snprintf(name, sizeof(name), "Class Preloader %d", (int)i);
+    Handle string = java_lang_String::create_from_str(name, CHECK);
+    Handle thread_group(THREAD, Universe::system_thread_group());
+    Handle thread_oop = JavaCalls::construct_new_instance(
+                            SystemDictionary::Thread_klass(),
+                            vmSymbols::threadgroup_string_void_signature(),
+                            thread_group,
+                            string,
+                            CHECK);
+
+    JavaThread* thread = NULL;
+    {
+      MutexLocker mu(Threads_lock);
+      thread = new JavaThread(&preload_entry);
+      if (thread != NULL && thread->osthread() != NULL) {
+        java_lang_Thread::set_thread(thread_oop(), thread);
+        java_lang_Thread::set_priority(thread_oop(), NormPriority);
+        java_lang_Thread::set_daemon(thread_oop());
+        thread->set_threadObj(thread_oop());
+        Atomic::inc(&_running_threads);
+        Threads::add(thread);
+        Thread::start(thread);
+        continue;
+      }
+    }
+    // Preloading is only an optimization; run with fewer threads
+    log_warning(class, preload)("Cannot create class preloader thread");
+    if (thread != NULL) {
+      thread->smr_delete();
+    }
+    break;
+  }
+  thread_done();
+}
+
+void ClassPreloader::thread_done() {
+  if (Atomic::sub(1, &_running_threads) == 0) {
+    log_info(class, preload)("Preloaded %d classes, %d failed", _loaded_count, _failed_count);
+    free_class_list();
+  }
+}
+
+void ClassPreloader::preload_one(const char* class_name, TRAPS) {
+  TempNewSymbol name = SymbolTable::new_symbol(class_name, CHECK);
+  Handle loader(THREAD, SystemDictionary::java_system_loader());
+  Klass* k = SystemDictionary::resolve_or_null(name, loader, Handle(), CHECK);
+  if (k == NULL || !k->is_instance_klass()) {
+    Atomic::inc(&_failed_count);
+    return;
+  }
+  InstanceKlass::cast(k)->link_class(CHECK);
+  Atomic::inc(&_loaded_count);
+}
+
+void ClassPreloader::preload_entry(JavaThread* thread, TRAPS) {
+  int length = _class_names->length();
+  while (true) {
+    int index = Atomic::add(1, &_next_index) - 1;
+    if (index >= length) {
+      break;
+    }
+    ResourceMark rm(THREAD);
+    HandleMark hm(THREAD);
+    preload_one(_class_names->at(index), THREAD);
+    if (HAS_PENDING_EXCEPTION) {
+      // The application gets the same error when it uses the class
+      log_debug(class, preload)("Failed to preload %s", _class_names->at(index));
+      CLEAR_PENDING_EXCEPTION;
+      Atomic::inc(&_failed_count);
+    }
+  }
+
+  thread_done();
+}
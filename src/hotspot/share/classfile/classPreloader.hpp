@@ -0,0 +1,60 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#ifndef SHARE_CLASSFILE_CLASSPRELOADER_HPP
+#define SHARE_CLASSFILE_CLASSPRELOADER_HPP
+
+#include "memory/allocation.hpp"
+#include "utilities/exceptions.hpp"
+
+template <class T> class GrowableArray;
+class JavaThread;
+
+// Support for -XX:PreloadClassList. The classes named in a class list
+// (in the format written by -XX:DumpLoadedClassList) are loaded by the
+// system class loader and linked on a few daemon threads, so that the
+// application threads find them already verified and rewritten.
+//
+// The classes are loaded through the regular SystemDictionary paths, so
+// loader constraints are checked as usual. They are not initialized;
+// class initialization still happens in program order on first use.
+// Classes that fail to load or link are skipped; the error is raised
+// again when the application uses them.
+class ClassPreloader : AllStatic {
+  static GrowableArray<char*>* _class_names;
+  static volatile int _next_index;
+  static volatile int _loaded_count;
+  static volatile int _failed_count;
+  static volatile int _running_threads;
+
+  static bool read_class_list(const char* path);
+  static void free_class_list();
+  static void preload_entry(JavaThread* thread, TRAPS);
+  static void preload_one(const char* class_name, TRAPS);
+  static void thread_done();
+public:
+  static void start(TRAPS);
+};
+
+#endif // SHARE_CLASSFILE_CLASSPRELOADER_HPP
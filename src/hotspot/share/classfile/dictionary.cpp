@@ -34,115 +34,151 @@
 #include "memory/resourceArea.hpp"
 #include "oops/oop.inline.hpp"
 #include "runtime/atomic.hpp"
+#include "runtime/mutexLocker.hpp"
 #include "runtime/orderAccess.hpp"
+#include "runtime/safepoint.hpp"
 #include "runtime/safepointVerifiers.hpp"
+#include "utilities/concurrentHashTable.inline.hpp"
+#include "utilities/growableArray.hpp"
 #include "utilities/hashtable.inline.hpp"
 
 // Optimization: if any dictionary needs resizing, we set this flag,
-// so that we dont't have to walk all dictionaries to check if any actually
-// needs resizing, which is costly to do at Safepoint.
-bool Dictionary::_some_dictionary_needs_resizing = false;
+// so that the ServiceThread doesn't have to walk all dictionaries to
+// check if any actually needs resizing.
+volatile bool Dictionary::_some_dictionary_needs_resizing = false;
+
+class DictionaryConfig : public DictionaryHash::BaseConfig {
+ public:
+  static uintx get_hash(DictionaryEntry* const& value, bool* is_dead) {
+    *is_dead = false;
+    return (unsigned int) value->instance_klass()->name()->identity_hash();
+  }
+  // Entries are only freed when the whole table is deleted.
+  static void free_node(void* memory, DictionaryEntry* const& value) {
+    delete value;
+    DictionaryHash::BaseConfig::free_node(memory, value);
+  }
+};
 
-Dictionary::Dictionary(ClassLoaderData* loader_data, int table_size, bool resizable)
-  : Hashtable<InstanceKlass*, mtClass>(table_size, (int)sizeof(DictionaryEntry)),
-    _resizable(resizable), _needs_resizing(false), _loader_data(loader_data) {
+class DictionaryLookup : StackObj {
+ private:
+  Symbol* _name;
+  uintx _hash;
+ public:
+  DictionaryLookup(Symbol* name, unsigned int hash) : _name(name), _hash(hash) {}
+  uintx get_hash() const {
+    return _hash;
+  }
+  bool equals(DictionaryEntry** value, bool* is_dead) {
+    *is_dead = false;
+    return (*value)->instance_klass()->name() == _name;
+  }
 };
 
+class DictionaryGet : StackObj {
+  DictionaryEntry* _result;
+ public:
+  DictionaryGet() : _result(NULL) {}
+  void operator()(DictionaryEntry** value) {
+    _result = *value;
+  }
+  DictionaryEntry* result() const { return _result; }
+};
+
+const int _resize_load_trigger = 5;       // load factor that will trigger the resize
+const size_t _resize_max_size_log2 = 16;  // the max dictionary size allowed
+
+static size_t ceil_log2(size_t value) {
+  size_t ret;
+  for (ret = 1; ((size_t)1 << ret) < value; ++ret);
+  return ret;
+}
 
-Dictionary::Dictionary(ClassLoaderData* loader_data,
-                       int table_size, HashtableBucket<mtClass>* t,
-                       int number_of_entries, bool resizable)
-  : Hashtable<InstanceKlass*, mtClass>(table_size, (int)sizeof(DictionaryEntry), t, number_of_entries),
-    _resizable(resizable), _needs_resizing(false), _loader_data(loader_data) {
+Dictionary::Dictionary(ClassLoaderData* loader_data, int table_size, bool resizable)
+  : _resizable(resizable), _needs_resizing(false), _number_of_entries(0),
+    _loader_data(loader_data) {
+  size_t start_size_log2 = MAX2(ceil_log2(table_size), (size_t)5);  // the smallest table allowed
+  _table = new DictionaryHash(start_size_log2,
+                              MAX2(start_size_log2, _resize_max_size_log2));
 };
 
 Dictionary::~Dictionary() {
-  DictionaryEntry* probe = NULL;
-  for (int index = 0; index < table_size(); index++) {
-    for (DictionaryEntry** p = bucket_addr(index); *p != NULL; ) {
-      probe = *p;
-      *p = probe->next();
-      free_entry(probe);
-    }
-  }
-  assert(number_of_entries() == 0, "should have removed all entries");
-  assert(new_entry_free_list() == NULL, "entry present on Dictionary's free list");
+  // DictionaryConfig::free_node() deletes the entries
+  delete _table;
 }
 
-DictionaryEntry* Dictionary::new_entry(unsigned int hash, InstanceKlass* klass) {
-  DictionaryEntry* entry = (DictionaryEntry*)Hashtable<InstanceKlass*, mtClass>::allocate_new_entry(hash, klass);
-  entry->set_pd_set(NULL);
+DictionaryEntry::DictionaryEntry(InstanceKlass* klass) : _instance_klass(klass), _pd_set(NULL) {
   assert(klass->is_instance_klass(), "Must be");
-  return entry;
 }
 
-
-void Dictionary::free_entry(DictionaryEntry* entry) {
+DictionaryEntry::~DictionaryEntry() {
   // avoid recursion when deleting linked list
   // pd_set is accessed during a safepoint.
-  while (entry->pd_set() != NULL) {
-    ProtectionDomainEntry* to_delete = entry->pd_set();
-    entry->set_pd_set(to_delete->next());
+  while (pd_set() != NULL) {
+    ProtectionDomainEntry* to_delete = pd_set();
+    set_pd_set(to_delete->next());
     delete to_delete;
   }
-  // Unlink from the Hashtable prior to freeing
-  unlink_entry(entry);
-  FREE_C_HEAP_ARRAY(char, entry);
 }
 
-const int _resize_load_trigger = 5;       // load factor that will trigger the resize
-const double _resize_factor    = 2.0;     // by how much we will resize using current number of entries
-const int _resize_max_size     = 40423;   // the max dictionary size allowed
-const int _primelist[] = {107, 1009, 2017, 4049, 5051, 10103, 20201, _resize_max_size};
-const int _prime_array_size = sizeof(_primelist)/sizeof(int);
-
-// Calculate next "good" dictionary size based on requested count
-static int calculate_dictionary_size(int requested) {
-  int newsize = _primelist[0];
-  int index = 0;
-  for (newsize = _primelist[index]; index < (_prime_array_size - 1);
-       newsize = _primelist[++index]) {
-    if (requested <= newsize) {
-      break;
-    }
-  }
-  return newsize;
+int Dictionary::table_size() {
+  return (int)((size_t)1 << _table->get_size_log2(Thread::current()));
 }
 
 bool Dictionary::does_any_dictionary_needs_resizing() {
   return Dictionary::_some_dictionary_needs_resizing;
 }
 
+// Called by the ServiceThread before it walks the dictionaries. A dictionary
+// that asks for resizing after it has been visited sets the flag again.
+void Dictionary::clear_some_dictionary_needs_resizing() {
+  Dictionary::_some_dictionary_needs_resizing = false;
+  OrderAccess::fence();
+}
+
 void Dictionary::check_if_needs_resize() {
-  if (_resizable == true) {
+  if (_resizable && !_needs_resizing) {
     if (number_of_entries() > (_resize_load_trigger*table_size())) {
       _needs_resizing = true;
+      MutexLockerEx ml(Service_lock, Mutex::_no_safepoint_check_flag);
       Dictionary::_some_dictionary_needs_resizing = true;
+      Service_lock->notify_all();
     }
   }
 }
 
-bool Dictionary::resize_if_needed() {
-  int desired_size = 0;
-  if (_needs_resizing == true) {
-    desired_size = calculate_dictionary_size((int)(_resize_factor*number_of_entries()));
-    if (desired_size >= _resize_max_size) {
-      desired_size = _resize_max_size;
-      // We have reached the limit, turn resizing off
-      _resizable = false;
-    }
-    if ((desired_size != 0) && (desired_size != table_size())) {
-      if (!resize(desired_size)) {
-        // Something went wrong, turn resizing off
-        _resizable = false;
-      }
-    }
+bool Dictionary::resize_if_needed(JavaThread* jt) {
+  if (!_needs_resizing) {
+    return false;
   }
-
   _needs_resizing = false;
-  Dictionary::_some_dictionary_needs_resizing = false;
 
-  return (desired_size != 0);
+  bool resized = _table->grow(jt);
+  if (_table->is_max_size_reached()) {
+    // We have reached the limit, turn resizing off
+    _resizable = false;
+  }
+  if (resized) {
+    LogTarget(Debug, class, loader, data) lt;
+    if (lt.is_enabled()) {
+      LogStream ls(lt);
+      ls.print("Dictionary resized to %d buckets, %d classes, for ", table_size(), number_of_entries());
+      loader_data()->print_value_on(&ls);
+      ls.cr();
+    }
+  }
+  return resized;
+}
+
+// Readers don't hold a lock while the table is scanned at a safepoint; outside
+// of a safepoint the scan holds off concurrent resizing of the table.
+template <typename SCAN_FUNC>
+void Dictionary::scan(SCAN_FUNC& scan_f) {
+  if (SafepointSynchronize::is_at_safepoint()) {
+    _table->do_safepoint_scan(scan_f);
+  } else {
+    _table->do_scan(Thread::current(), scan_f);
+  }
 }
 
 bool DictionaryEntry::contains_protection_domain(oop protection_domain) const {
@@ -198,99 +234,127 @@ void DictionaryEntry::add_protection_domain(Dictionary* dict, Handle protection_
   }
 }
 
+class DictionaryDefiningClassesDo : StackObj {
+  ClassLoaderData* _loader_data;
+  void (*_f)(InstanceKlass*);
+ public:
+  DictionaryDefiningClassesDo(ClassLoaderData* loader_data, void f(InstanceKlass*)) :
+    _loader_data(loader_data), _f(f) {}
+  bool operator()(DictionaryEntry** value) {
+    InstanceKlass* k = (*value)->instance_klass();
+    if (_loader_data == k->class_loader_data()) {
+      _f(k);
+    }
+    return true;
+  }
+};
+
 //   Just the classes from defining class loaders
 void Dictionary::classes_do(void f(InstanceKlass*)) {
-  for (int index = 0; index < table_size(); index++) {
-    for (DictionaryEntry* probe = bucket(index);
-                          probe != NULL;
-                          probe = probe->next()) {
-      InstanceKlass* k = probe->instance_klass();
-      if (loader_data() == k->class_loader_data()) {
-        f(k);
-      }
+  DictionaryDefiningClassesDo doit(loader_data(), f);
+  scan(doit);
+}
+
+class DictionaryCollectDefiningClasses : StackObj {
+  ClassLoaderData* _loader_data;
+  GrowableArray<InstanceKlass*>* _classes;
+ public:
+  DictionaryCollectDefiningClasses(ClassLoaderData* loader_data, GrowableArray<InstanceKlass*>* classes) :
+    _loader_data(loader_data), _classes(classes) {}
+  bool operator()(DictionaryEntry** value) {
+    InstanceKlass* k = (*value)->instance_klass();
+    if (_loader_data == k->class_loader_data()) {
+      _classes->append(k);
     }
+    return true;
   }
-}
+};
 
 // Added for initialize_itable_for_klass to handle exceptions
 //   Just the classes from defining class loaders
 void Dictionary::classes_do(void f(InstanceKlass*, TRAPS), TRAPS) {
-  for (int index = 0; index < table_size(); index++) {
-    for (DictionaryEntry* probe = bucket(index);
-                          probe != NULL;
-                          probe = probe->next()) {
-      InstanceKlass* k = probe->instance_klass();
-      if (loader_data() == k->class_loader_data()) {
-        f(k, CHECK);
-      }
-    }
+  // f may take locks and safepoint, so it is applied after the scan.
+  ResourceMark rm(THREAD);
+  GrowableArray<InstanceKlass*> classes(number_of_entries());
+  DictionaryCollectDefiningClasses collect(loader_data(), &classes);
+  scan(collect);
+  for (int i = 0; i < classes.length(); i++) {
+    f(classes.at(i), CHECK);
   }
 }
 
+class DictionaryAllEntriesDo : StackObj {
+  KlassClosure* _closure;
+ public:
+  DictionaryAllEntriesDo(KlassClosure* closure) : _closure(closure) {}
+  bool operator()(DictionaryEntry** value) {
+    _closure->do_klass((*value)->instance_klass());
+    return true;
+  }
+};
+
 // All classes, and their class loaders, including initiating class loaders
 void Dictionary::all_entries_do(KlassClosure* closure) {
-  for (int index = 0; index < table_size(); index++) {
-    for (DictionaryEntry* probe = bucket(index);
-                          probe != NULL;
-                          probe = probe->next()) {
-      InstanceKlass* k = probe->instance_klass();
-      closure->do_klass(k);
-    }
-  }
+  DictionaryAllEntriesDo doit(closure);
+  scan(doit);
 }
 
+class DictionaryPushKlasses : StackObj {
+  MetaspaceClosure* _it;
+ public:
+  DictionaryPushKlasses(MetaspaceClosure* it) : _it(it) {}
+  bool operator()(DictionaryEntry** value) {
+    _it->push((*value)->klass_addr());
+    return true;
+  }
+};
+
 // Used to scan and relocate the classes during CDS archive dump.
 void Dictionary::classes_do(MetaspaceClosure* it) {
   assert(DumpSharedSpaces, "dump-time only");
-  for (int index = 0; index < table_size(); index++) {
-    for (DictionaryEntry* probe = bucket(index);
-                          probe != NULL;
-                          probe = probe->next()) {
-      it->push(probe->klass_addr());
-    }
-  }
+  DictionaryPushKlasses push(it);
+  scan(push);
 }
 
 
 
 // Add a loaded class to the dictionary.
-// Readers of the SystemDictionary aren't always locked, so _buckets
-// is volatile. The store of the next field in the constructor is
-// also cast to volatile;  we do this to ensure store order is maintained
-// by the compilers.
+// Readers of the SystemDictionary aren't locked, the entry is published
+// by the ConcurrentHashTable once it is completely initialized.
 
 void Dictionary::add_klass(unsigned int hash, Symbol* class_name,
                            InstanceKlass* obj) {
   assert_locked_or_safepoint(SystemDictionary_lock);
   assert(obj != NULL, "adding NULL obj");
   assert(obj->name() == class_name, "sanity check on name");
-
-  DictionaryEntry* entry = new_entry(hash, obj);
-  int index = hash_to_index(hash);
-  add_entry(index, entry);
+  assert(hash == compute_hash(class_name), "incorrect hash?");
+
+  DictionaryEntry* entry = new DictionaryEntry(obj);
+  DictionaryLookup lookup(class_name, hash);
+  bool created = _table->insert(Thread::current(), lookup, entry);
+  assert(created, "adders hold the SystemDictionary_lock, so there is no duplicate");
+  if (!created) {
+    delete entry;
+    return;
+  }
+  _number_of_entries++;
   check_if_needs_resize();
 }
 
 
 // This routine does not lock the dictionary.
 //
-// Since readers don't hold a lock, we must make sure that system
-// dictionary entries are only removed at a safepoint (when only one
-// thread is running), and are added to in a safe way (all links must
-// be updated in an MT-safe manner).
+// Entries are only removed together with the whole dictionary, and are
+// published safely by the ConcurrentHashTable, which readers walk inside
+// a critical section.
 //
 // Callers should be aware that an entry could be added just after
-// _buckets[index] is read here, so the caller will not see the new entry.
-DictionaryEntry* Dictionary::get_entry(int index, unsigned int hash,
-                                       Symbol* class_name) {
-  for (DictionaryEntry* entry = bucket(index);
-                        entry != NULL;
-                        entry = entry->next()) {
-    if (entry->hash() == hash && entry->equals(class_name)) {
-      return entry;
-    }
-  }
-  return NULL;
+// the lookup, so the caller will not see the new entry.
+DictionaryEntry* Dictionary::get_entry(unsigned int hash, Symbol* class_name) {
+  DictionaryLookup lookup(class_name, hash);
+  DictionaryGet get;
+  _table->get(Thread::current(), lookup, get);
+  return get.result();
 }
 
 
@@ -298,8 +362,7 @@ InstanceKlass* Dictionary::find(unsigned int hash, Symbol* name,
                                 Handle protection_domain) {
   NoSafepointVerifier nsv;
 
-  int index = hash_to_index(hash);
-  DictionaryEntry* entry = get_entry(index, hash, name);
+  DictionaryEntry* entry = get_entry(hash, name);
   if (entry != NULL && entry->is_valid_protection_domain(protection_domain)) {
     return entry->instance_klass();
   } else {
@@ -308,22 +371,21 @@ InstanceKlass* Dictionary::find(unsigned int hash, Symbol* name,
 }
 
 
-InstanceKlass* Dictionary::find_class(int index, unsigned int hash,
+InstanceKlass* Dictionary::find_class(unsigned int hash,
                                       Symbol* name) {
-  assert_locked_or_safepoint(SystemDictionary_lock);
-  assert (index == index_for(name), "incorrect index?");
+  assert (hash == compute_hash(name), "incorrect hash?");
 
-  DictionaryEntry* entry = get_entry(index, hash, name);
+  DictionaryEntry* entry = get_entry(hash, name);
   return (entry != NULL) ? entry->instance_klass() : NULL;
 }
 
 
-void Dictionary::add_protection_domain(int index, unsigned int hash,
+void Dictionary::add_protection_domain(unsigned int hash,
                                        InstanceKlass* klass,
                                        Handle protection_domain,
                                        TRAPS) {
   Symbol*  klass_name = klass->name();
-  DictionaryEntry* entry = get_entry(index, hash, klass_name);
+  DictionaryEntry* entry = get_entry(hash, klass_name);
 
   assert(entry != NULL,"entry must be present, we just created it");
   assert(protection_domain() != NULL,
@@ -343,8 +405,7 @@ void Dictionary::add_protection_domain(int index, unsigned int hash,
 bool Dictionary::is_valid_protection_domain(unsigned int hash,
                                             Symbol* name,
                                             Handle protection_domain) {
-  int index = hash_to_index(hash);
-  DictionaryEntry* entry = get_entry(index, hash, name);
+  DictionaryEntry* entry = get_entry(hash, name);
   return entry->is_valid_protection_domain(protection_domain);
 }
 
@@ -407,7 +468,31 @@ void SymbolPropertyTable::methods_do(void f(Method*)) {
 
 // ----------------------------------------------------------------------------
 
-void Dictionary::print_on(outputStream* st) const {
+class DictionaryPrintEntry : StackObj {
+  ClassLoaderData* _loader_data;
+  outputStream* _st;
+  int _index;
+ public:
+  DictionaryPrintEntry(ClassLoaderData* loader_data, outputStream* st) :
+    _loader_data(loader_data), _st(st), _index(0) {}
+  bool operator()(DictionaryEntry** value) {
+    Klass* e = (*value)->instance_klass();
+    bool is_defining_class =
+       (_loader_data == e->class_loader_data());
+    _st->print("%4d: %s%s", _index++, is_defining_class ? " " : "^", e->external_name());
+    ClassLoaderData* cld = e->class_loader_data();
+    if (!_loader_data->is_the_null_class_loader_data()) {
+      // Class loader output for the dictionary for the null class loader data is
+      // redundant and obvious.
+      _st->print(", ");
+      cld->print_value_on(_st);
+    }
+    _st->cr();
+    return true;
+  }
+};
+
+void Dictionary::print_on(outputStream* st) {
   ResourceMark rm;
 
   assert(loader_data() != NULL, "loader data should not be null");
@@ -415,27 +500,23 @@ void Dictionary::print_on(outputStream* st) const {
                table_size(), number_of_entries(), BOOL_TO_STR(_resizable));
   st->print_cr("^ indicates that initiating loader is different from defining loader");
 
-  for (int index = 0; index < table_size(); index++) {
-    for (DictionaryEntry* probe = bucket(index);
-                          probe != NULL;
-                          probe = probe->next()) {
-      Klass* e = probe->instance_klass();
-      bool is_defining_class =
-         (loader_data() == e->class_loader_data());
-      st->print("%4d: %s%s", index, is_defining_class ? " " : "^", e->external_name());
-      ClassLoaderData* cld = e->class_loader_data();
-      if (!loader_data()->is_the_null_class_loader_data()) {
-        // Class loader output for the dictionary for the null class loader data is
-        // redundant and obvious.
-        st->print(", ");
-        cld->print_value_on(st);
-      }
-      st->cr();
-    }
-  }
+  DictionaryPrintEntry printer(loader_data(), st);
+  scan(printer);
   tty->cr();
 }
 
+class DictionarySizeFunc : StackObj {
+ public:
+  size_t operator()(DictionaryEntry** value) {
+    return sizeof(DictionaryEntry);
+  }
+};
+
+void Dictionary::print_table_statistics(outputStream* st, const char* table_name) {
+  DictionarySizeFunc sz;
+  _table->statistics_to(Thread::current(), sz, st, table_name);
+}
+
 void DictionaryEntry::verify() {
   Klass* e = instance_klass();
   guarantee(e->is_instance_klass(),
@@ -444,6 +525,18 @@ void DictionaryEntry::verify() {
   verify_protection_domain_set();
 }
 
+class DictionaryVerifyEntry : StackObj {
+  int _count;
+ public:
+  DictionaryVerifyEntry() : _count(0) {}
+  bool operator()(DictionaryEntry** value) {
+    (*value)->verify();
+    _count++;
+    return true;
+  }
+  int count() const { return _count; }
+};
+
 void Dictionary::verify() {
   guarantee(number_of_entries() >= 0, "Verify of dictionary failed");
 
@@ -455,8 +548,10 @@ void Dictionary::verify() {
             cld->class_loader()->is_instance(),
             "checking type of class_loader");
 
-  ResourceMark rm;
-  stringStream tempst;
-  tempst.print("System Dictionary for %s class loader", cld->loader_name_and_id());
-  verify_table<DictionaryEntry>(tempst.as_string());
+  DictionaryVerifyEntry verifier;
+  scan(verifier);
+  if (SafepointSynchronize::is_at_safepoint()) {
+    // Classes can only be added concurrently outside of a safepoint
+    guarantee(verifier.count() == number_of_entries(), "Verify of dictionary failed");
+  }
 }
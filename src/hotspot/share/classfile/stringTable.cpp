@@ -174,8 +174,9 @@ class StringTableLookupOop : public StackObj {
   bool equals(WeakHandle<vm_string_table_data>* value, bool* is_dead) {
     oop val_oop = value->peek();
     if (val_oop == NULL) {
-      // dead oop, mark this hash dead for cleaning
-      *is_dead = true;
+      // Dead oop. Do not report it: cleaning it here would make the
+      // interning thread wait for a global write_synchronize. Dead
+      // entries are counted by the GC and removed by the ServiceThread.
       return false;
     }
     bool equals = java_lang_String::equals(_find(), val_oop);
@@ -367,16 +368,18 @@ oop StringTable::do_intern(Handle string_or_null_h, const jchar* name,
 
   bool rehash_warning;
   do {
-    if (_local_table->get(THREAD, lookup, stg, &rehash_warning)) {
-      update_needs_rehash(rehash_warning);
-      return stg.get_res_oop();
-    }
+    // The caller has just failed to look the string up, so try to insert
+    // first. The insert fails if another thread added the string meanwhile.
     WeakHandle<vm_string_table_data> wh = WeakHandle<vm_string_table_data>::create(string_h);
     // The hash table takes ownership of the WeakHandle, even if it's not inserted.
     if (_local_table->insert(THREAD, lookup, wh, &rehash_warning)) {
       update_needs_rehash(rehash_warning);
       return wh.resolve();
     }
+    if (_local_table->get(THREAD, lookup, stg, &rehash_warning)) {
+      update_needs_rehash(rehash_warning);
+      return stg.get_res_oop();
+    }
   } while(true);
 }
 
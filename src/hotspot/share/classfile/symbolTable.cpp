@@ -202,6 +202,7 @@ Symbol* SymbolTable::allocate_symbol(const char* name, int len, bool c_heap, TRA
     c_heap = false;
   }
   if (c_heap) {
+    // Shared by all loaders, so not in a per-loader arena
     // refcount starts as 1
     sym = new (len, THREAD) Symbol((const u1*)name, len, 1);
     assert(sym != NULL, "new should call vm_exit_out_of_memory if C_HEAP is exhausted");
@@ -85,6 +85,7 @@
 #include "services/threadService.hpp"
 #include "utilities/macros.hpp"
 #if INCLUDE_CDS
+#include "classfile/classListWriter.hpp"
 #include "classfile/systemDictionaryShared.hpp"
 #endif
 #if INCLUDE_JVMCI
@@ -511,8 +512,7 @@ void SystemDictionary::validate_protection_domain(InstanceKlass* klass,
     unsigned int d_hash = dictionary->compute_hash(kn);
 
     MutexLocker mu(SystemDictionary_lock, THREAD);
-    int d_index = dictionary->hash_to_index(d_hash);
-    dictionary->add_protection_domain(d_index, d_hash, klass,
+    dictionary->add_protection_domain(d_hash, klass,
                                       protection_domain, THREAD);
   }
 }
@@ -597,8 +597,8 @@ InstanceKlass* SystemDictionary::handle_parallel_super_load(
   // parallelCapable class loaders do NOT wait for parallel superclass loads to complete
   // Serial class loaders and bootstrap classloader do wait for superclass loads
  if (!class_loader.is_null() && is_parallelCapable(class_loader)) {
-    MutexLocker mu(SystemDictionary_lock, THREAD);
     // Check if classloading completed while we were loading superclass or waiting
+    // The dictionary can be read without the SystemDictionary_lock
     return find_class(d_hash, name, dictionary);
   }
 
@@ -1365,9 +1365,7 @@ InstanceKlass* SystemDictionary::load_shared_class(InstanceKlass* ik,
     if (DumpLoadedClassList != NULL && classlist_file->is_open()) {
       // Only dump the classes that can be stored into CDS archive
       if (SystemDictionaryShared::is_sharing_possible(loader_data)) {
-        ResourceMark rm(THREAD);
-        classlist_file->print_cr("%s", ik->name()->as_C_string());
-        classlist_file->flush();
+        ClassListWriter::write(ik, NULL);
       }
     }
 
@@ -1752,9 +1750,7 @@ void SystemDictionary::check_loader_lock_contention(Handle loader_lock, TRAPS) {
 InstanceKlass* SystemDictionary::find_class(unsigned int hash,
                                             Symbol* class_name,
                                             Dictionary* dictionary) {
-  assert_locked_or_safepoint(SystemDictionary_lock);
-  int index = dictionary->hash_to_index(hash);
-  return dictionary->find_class(index, hash, class_name);
+  return dictionary->find_class(hash, class_name);
 }
 
 
@@ -2865,10 +2861,13 @@ ProtectionDomainCacheEntry* SystemDictionary::cache_get(Handle protection_domain
 
 void SystemDictionary::print_on(outputStream *st) {
   CDS_ONLY(SystemDictionaryShared::print_on(st));
-  GCMutexLocker mu(SystemDictionary_lock);
 
+  // The dictionaries are not printed under the SD_lock, since scanning
+  // them takes the lock that holds off resizing of each table.
   ClassLoaderDataGraph::print_dictionary(st);
 
+  GCMutexLocker mu(SystemDictionary_lock);
+
   // Placeholders
   placeholders()->print_on(st);
   st->cr();
@@ -2887,11 +2886,11 @@ void SystemDictionary::verify() {
   guarantee(placeholders()->number_of_entries() >= 0,
             "Verify of placeholders failed");
 
-  GCMutexLocker mu(SystemDictionary_lock);
-
   // Verify dictionary
   ClassLoaderDataGraph::verify_dictionary();
 
+  GCMutexLocker mu(SystemDictionary_lock);
+
   placeholders()->verify();
 
   // Verify constraint table
@@ -774,12 +774,9 @@ InstanceKlass* SystemDictionaryShared::find_or_load_shared_class(
       check_loader_lock_contention(lockObject, THREAD);
       ObjectLocker ol(lockObject, THREAD, DoObjectLock);
 
-      {
-        MutexLocker mu(SystemDictionary_lock, THREAD);
-        InstanceKlass* check = find_class(d_hash, name, dictionary);
-        if (check != NULL) {
-          return check;
-        }
+      InstanceKlass* check = find_class(d_hash, name, dictionary);
+      if (check != NULL) {
+        return check;
       }
 
       k = load_shared_class_for_builtin_loader(name, class_loader, THREAD);
@@ -151,6 +151,8 @@ bool Verifier::verify(InstanceKlass* klass, bool should_verify_class, TRAPS) {
     return true;
   }
 
+  // Results are not cached across runs, AppCDS keeps the constraints instead
+
   // Timer includes any side effects of class verification (resolution,
   // etc), but not recursive calls to Verifier::verify().
   JavaThread* jt = (JavaThread*)THREAD;
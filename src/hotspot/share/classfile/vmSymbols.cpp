@@ -371,6 +371,11 @@ bool vmIntrinsics::preserves_state(vmIntrinsics::ID id) {
   case vmIntrinsics::_dlog10:
   case vmIntrinsics::_dexp:
   case vmIntrinsics::_dpow:
+  case vmIntrinsics::_dsin_strict:
+  case vmIntrinsics::_dcos_strict:
+  case vmIntrinsics::_dtan_strict:
+  case vmIntrinsics::_dlog_strict:
+  case vmIntrinsics::_dlog10_strict:
   case vmIntrinsics::_checkIndex:
   case vmIntrinsics::_Reference_get:
   case vmIntrinsics::_updateCRC32:
@@ -412,6 +417,11 @@ bool vmIntrinsics::can_trap(vmIntrinsics::ID id) {
   case vmIntrinsics::_dlog10:
   case vmIntrinsics::_dexp:
   case vmIntrinsics::_dpow:
+  case vmIntrinsics::_dsin_strict:
+  case vmIntrinsics::_dcos_strict:
+  case vmIntrinsics::_dtan_strict:
+  case vmIntrinsics::_dlog_strict:
+  case vmIntrinsics::_dlog10_strict:
   case vmIntrinsics::_updateCRC32:
   case vmIntrinsics::_updateBytesCRC32:
   case vmIntrinsics::_updateByteBufferCRC32:
@@ -576,6 +586,11 @@ bool vmIntrinsics::is_disabled_by_flags(vmIntrinsics::ID id) {
   case vmIntrinsics::_dpow:
   case vmIntrinsics::_dlog10:
   case vmIntrinsics::_datan2:
+  case vmIntrinsics::_dsin_strict:
+  case vmIntrinsics::_dcos_strict:
+  case vmIntrinsics::_dtan_strict:
+  case vmIntrinsics::_dlog_strict:
+  case vmIntrinsics::_dlog10_strict:
   case vmIntrinsics::_min:
   case vmIntrinsics::_max:
   case vmIntrinsics::_floatToIntBits:
@@ -778,6 +778,11 @@
   do_intrinsic(_dlog10,                   java_lang_Math,         log10_name, double_double_signature,           F_S)   \
   do_intrinsic(_dpow,                     java_lang_Math,         pow_name,   double2_double_signature,          F_S)   \
   do_intrinsic(_dexp,                     java_lang_Math,         exp_name,   double_double_signature,           F_S)   \
+  do_intrinsic(_dsin_strict,              java_lang_StrictMath,   sin_name,   double_double_signature,           F_SN)  \
+  do_intrinsic(_dcos_strict,              java_lang_StrictMath,   cos_name,   double_double_signature,           F_SN)  \
+  do_intrinsic(_dtan_strict,              java_lang_StrictMath,   tan_name,   double_double_signature,           F_SN)  \
+  do_intrinsic(_dlog_strict,              java_lang_StrictMath,   log_name,   double_double_signature,           F_SN)  \
+  do_intrinsic(_dlog10_strict,            java_lang_StrictMath,   log10_name, double_double_signature,           F_SN)  \
   do_intrinsic(_min,                      java_lang_Math,         min_name,   int2_int_signature,                F_S)   \
   do_intrinsic(_max,                      java_lang_Math,         max_name,   int2_int_signature,                F_S)   \
   do_intrinsic(_addExactI,                java_lang_Math,         addExact_name, int2_int_signature,             F_S)   \
@@ -316,6 +316,10 @@ void CodeCache::initialize_heaps() {
 
 size_t CodeCache::page_size(bool aligned, size_t min_pages) {
   if (os::can_execute_large_page_memory()) {
+    if (CodeCacheLargePageSize != 0) {
+      // Explicitly requested, and checked by the OS layer and initialize()
+      return CodeCacheLargePageSize;
+    }
     if (InitialCodeCacheSize < ReservedCodeCacheSize) {
       // Make sure that the page size allows for an incremental commit of the reserved space
       min_pages = MAX2(min_pages, (size_t)8);
@@ -1102,6 +1106,20 @@ void CodeCache::initialize() {
   // default page size.
   CodeCacheExpansionSize = align_up(CodeCacheExpansionSize, os::vm_page_size());
 
+  if (CodeCacheLargePageSize != 0) {
+    // The whole code cache, and each code heap, must be covered by such pages.
+    size_t lp_size = CodeCacheLargePageSize;
+    size_t cache_size = align_up(MAX2((size_t)ReservedCodeCacheSize, lp_size * (SegmentedCodeCache ? 3 : 1)), lp_size);
+    if (NOT_LINUX(true ||) !UseLargePages || !os::can_execute_large_page_memory() || cache_size > CODE_CACHE_SIZE_LIMIT) {
+      warning("CodeCacheLargePageSize (" SIZE_FORMAT "K) cannot be used for the code cache, ignoring", lp_size / K);
+      FLAG_SET_ERGO(size_t, CodeCacheLargePageSize, 0);
+    } else if (cache_size != ReservedCodeCacheSize) {
+      log_info(codecache)("Increasing ReservedCodeCacheSize to " SIZE_FORMAT "K to fit " SIZE_FORMAT "K pages",
+                          cache_size / K, lp_size / K);
+      FLAG_SET_ERGO(uintx, ReservedCodeCacheSize, cache_size);
+    }
+  }
+
   if (SegmentedCodeCache) {
     // Use multiple code heaps
     initialize_heaps();
@@ -1299,8 +1317,7 @@ void CodeCache::flush_dependents_on(InstanceKlass* dependee) {
   // Compute the dependent nmethods
   if (mark_for_deoptimization(changes) > 0) {
     // At least one nmethod has been marked for deoptimization
-    VM_Deoptimize op;
-    VMThread::execute(&op);
+    Deoptimization::deoptimize_all_marked();
   }
 }
 
@@ -1654,6 +1671,9 @@ void CodeCache::print_summary(outputStream* st, bool detailed) {
                    p2i(heap->low_boundary()),
                    p2i(heap->high()),
                    p2i(heap->high_boundary()));
+      st->print_cr(" freelist: blocks=%d free=" SIZE_FORMAT "Kb largest=" SIZE_FORMAT "Kb",
+                   heap->freelist_length(), heap->allocated_in_freelist()/K,
+                   heap->largest_free_block()/K);
 
       full_count += get_codemem_full_count(heap->code_blob_type());
     }
@@ -1671,6 +1691,7 @@ void CodeCache::print_summary(outputStream* st, bool detailed) {
                  CompileBroker::get_total_compiler_stopped_count(),
                  CompileBroker::get_total_compiler_restarted_count());
     st->print_cr(" full_count=%d", full_count);
+    CompiledIC::print_statistics(st);
   }
 }
 
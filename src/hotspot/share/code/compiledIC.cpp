@@ -38,6 +38,7 @@
 #include "oops/method.inline.hpp"
 #include "oops/oop.inline.hpp"
 #include "oops/symbol.hpp"
+#include "runtime/atomic.hpp"
 #include "runtime/handles.inline.hpp"
 #include "runtime/icache.hpp"
 #include "runtime/sharedRuntime.hpp"
@@ -45,6 +46,12 @@
 #include "utilities/events.hpp"
 
 
+volatile size_t CompiledIC::_to_clean_count                   = 0;
+volatile size_t CompiledIC::_to_monomorphic_compiled_count    = 0;
+volatile size_t CompiledIC::_to_monomorphic_interpreted_count = 0;
+volatile size_t CompiledIC::_to_megamorphic_vtable_count      = 0;
+volatile size_t CompiledIC::_to_megamorphic_itable_count      = 0;
+
 // Every time a compiled IC is changed or its type is being accessed,
 // either the CompiledIC_lock must be set or we must be at a safe point.
 
@@ -270,6 +277,7 @@ bool CompiledIC::set_to_megamorphic(CallInfo* call_info, Bytecodes::Code bytecod
       needs_ic_stub_refill = true;
       return false;
     }
+    Atomic::inc(&_to_megamorphic_itable_count);
   } else {
     assert(call_info->call_kind() == CallInfo::vtable_call, "either itable or vtable");
     // Can be different than selected_method->vtable_index(), due to package-private etc.
@@ -283,6 +291,7 @@ bool CompiledIC::set_to_megamorphic(CallInfo* call_info, Bytecodes::Code bytecod
       needs_ic_stub_refill = true;
       return false;
     }
+    Atomic::inc(&_to_megamorphic_vtable_count);
   }
 
   if (TraceICs) {
@@ -390,6 +399,7 @@ bool CompiledIC::set_to_clean(bool in_use) {
       return false;
     }
   }
+  Atomic::inc(&_to_clean_count);
   // We can't check this anymore. With lazy deopt we could have already
   // cleaned this IC entry before we even return. This is possible if
   // we ran out of space in the inline cache buffer trying to do the
@@ -455,6 +465,7 @@ bool CompiledIC::set_to_monomorphic(CompiledICInfo& info) {
          tty->print_cr ("IC@" INTPTR_FORMAT ": monomorphic to interpreter via icholder ", p2i(instruction_address()));
       }
     }
+    Atomic::inc(&_to_monomorphic_interpreted_count);
   } else {
     // Call to compiled code
     bool static_bound = info.is_optimized() || (info.cached_metadata() == NULL);
@@ -488,6 +499,7 @@ bool CompiledIC::set_to_monomorphic(CompiledICInfo& info) {
         (info.cached_metadata() != NULL) ? ((Klass*)info.cached_metadata())->print_value_string() : "NULL",
         (safe) ? "" : " via stub");
     }
+    Atomic::inc(&_to_monomorphic_compiled_count);
   }
   // We can't check this anymore. With lazy deopt we could have already
   // cleaned this IC entry before we even return. This is possible if
@@ -564,6 +576,16 @@ void CompiledIC::compute_monomorphic_entry(const methodHandle& method,
 }
 
 
+void CompiledIC::print_statistics(outputStream* st) {
+  st->print_cr(" inline cache transitions: clean=" SIZE_FORMAT " monomorphic=" SIZE_FORMAT
+               " (interpreted=" SIZE_FORMAT ") megamorphic=" SIZE_FORMAT " (itable=" SIZE_FORMAT ")",
+               _to_clean_count,
+               _to_monomorphic_compiled_count + _to_monomorphic_interpreted_count,
+               _to_monomorphic_interpreted_count,
+               _to_megamorphic_vtable_count + _to_megamorphic_itable_count,
+               _to_megamorphic_itable_count);
+}
+
 bool CompiledIC::is_icholder_entry(address entry) {
   CodeBlob* cb = CodeCache::find_blob_unsafe(entry);
   if (cb != NULL && cb->is_adapter_blob()) {
@@ -187,6 +187,13 @@ class CompiledIC: public ResourceObj {
   bool          _is_optimized;  // an optimized virtual call (i.e., no compiled IC)
   CompiledMethod* _method;
 
+  // Counts of inline cache state transitions
+  static volatile size_t _to_clean_count;
+  static volatile size_t _to_monomorphic_compiled_count;
+  static volatile size_t _to_monomorphic_interpreted_count;
+  static volatile size_t _to_megamorphic_vtable_count;
+  static volatile size_t _to_megamorphic_itable_count;
+
   CompiledIC(CompiledMethod* cm, NativeCall* ic_call);
   CompiledIC(RelocIterator* iter);
 
@@ -289,6 +296,8 @@ class CompiledIC: public ResourceObj {
   void print()             PRODUCT_RETURN;
   void print_compiled_ic() PRODUCT_RETURN;
   void verify()            PRODUCT_RETURN;
+
+  static void print_statistics(outputStream* st);
 };
 
 inline CompiledIC* CompiledIC_before(CompiledMethod* nm, address return_addr) {
@@ -0,0 +1,138 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#include "precompiled.hpp"
+#include "classfile/symbolTable.hpp"
+#include "code/codeCache.hpp"
+#include "compiler/compilationWarmup.hpp"
+#include "logging/log.hpp"
+#include "memory/resourceArea.hpp"
+#include "oops/method.hpp"
+#include "oops/symbol.hpp"
+#include "runtime/globals.hpp"
+#include "runtime/mutexLocker.hpp"
+#include "runtime/thread.hpp"
+#include "utilities/resourceHash.hpp"
+
+struct WarmupKey {
+  Symbol* _klass;
+  Symbol* _name;
+  Symbol* _signature;
+
+  static unsigned hash(const WarmupKey& k) {
+    return k._klass->identity_hash() ^ (k._name->identity_hash() * 31) ^ (k._signature->identity_hash() * 17);
+  }
+  static bool equals(const WarmupKey& a, const WarmupKey& b) {
+    return a._klass == b._klass && a._name == b._name && a._signature == b._signature;
+  }
+};
+
+typedef ResourceHashtable<WarmupKey, bool,
+                          WarmupKey::hash, WarmupKey::equals,
+                          1024, ResourceObj::C_HEAP, mtCompiler> WarmupTable;
+
+// Filled once during startup before any compilation is requested and
+// read-only afterwards, so lookups need no lock.
+static WarmupTable* _hot_methods = NULL;
+
+bool CompilationWarmup::_enabled = false;
+
+void CompilationWarmup::load() {
+  if (CompilationWarmupFile == NULL) {
+    return;
+  }
+  FILE* stream = fopen(CompilationWarmupFile, "rt");
+  if (stream == NULL) {
+    // Nothing recorded yet; the file is written at exit.
+    return;
+  }
+  Thread* THREAD = Thread::current();
+  _hot_methods = new (ResourceObj::C_HEAP, mtCompiler) WarmupTable();
+
+  char line[1024];
+  char klass[256];
+  char name[256];
+  char signature[512];
+  int count = 0;
+  while (fgets(line, sizeof(line), stream) != NULL) {
+    if (line[0] == '#' ||
+        sscanf(line, "%255s %255s %511s", klass, name, signature) != 3) {
+      continue;
+    }
+    // The symbols are never released; the table lives as long as the VM.
+    WarmupKey key;
+    key._klass     = SymbolTable::new_symbol(klass, THREAD);
+    key._name      = HAS_PENDING_EXCEPTION ? NULL : SymbolTable::new_symbol(name, THREAD);
+    key._signature = HAS_PENDING_EXCEPTION ? NULL : SymbolTable::new_symbol(signature, THREAD);
+    if (HAS_PENDING_EXCEPTION) {
+      CLEAR_PENDING_EXCEPTION;
+      break;
+    }
+    if (_hot_methods->put(key, true)) {
+      count++;
+    }
+  }
+  fclose(stream);
+  _enabled = count > 0;
+  log_info(jit, compilation)("Loaded %d warm methods from %s", count, CompilationWarmupFile);
+}
+
+bool CompilationWarmup::is_hot(const Method* method) {
+  assert(_enabled, "only when a history was loaded");
+  WarmupKey key;
+  key._klass     = method->klass_name();
+  key._name      = method->name();
+  key._signature = method->signature();
+  return _hot_methods->get(key) != NULL;
+}
+
+void CompilationWarmup::print_hot_methods(outputStream* out) {
+  MutexLockerEx mu(CodeCache_lock, Mutex::_no_safepoint_check_flag);
+
+  out->print_cr("# klass method signature");
+  CompiledMethodIterator iter(CompiledMethodIterator::only_alive_and_not_unloading);
+  while (iter.next()) {
+    CompiledMethod* cm = iter.method();
+    if (cm->comp_level() != CompLevel_full_optimization || cm->is_osr_method() ||
+        !cm->is_in_use()) {
+      continue;
+    }
+    Method* m = cm->method();
+    ResourceMark rm;
+    out->print_cr("%s %s %s", m->klass_name()->as_C_string(),
+                  m->name()->as_C_string(), m->signature()->as_C_string());
+  }
+}
+
+void CompilationWarmup::dump_at_exit() {
+  if (CompilationWarmupFile == NULL) {
+    return;
+  }
+  fileStream out(CompilationWarmupFile, "wt");
+  if (!out.is_open()) {
+    log_warning(jit, compilation)("Cannot write compilation history to %s", CompilationWarmupFile);
+    return;
+  }
+  print_hot_methods(&out);
+}
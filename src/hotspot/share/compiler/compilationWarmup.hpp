@@ -0,0 +1,57 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#ifndef SHARE_COMPILER_COMPILATIONWARMUP_HPP
+#define SHARE_COMPILER_COMPILATIONWARMUP_HPP
+
+#include "memory/allocation.hpp"
+#include "utilities/ostream.hpp"
+
+class Method;
+
+// CompilationWarmup remembers which methods reached full optimization in
+// an earlier run of the VM so that the compilation policy can start
+// profiling them right away instead of waiting for the interpreter
+// thresholds. The history is kept in CompilationWarmupFile as one
+// "klass method signature" line per method; only names are recorded, so
+// a stale entry just fails to match and compilation still goes through
+// the usual dependency checks.
+
+class CompilationWarmup : AllStatic {
+ private:
+  static bool _enabled;
+
+ public:
+  // Read the history from CompilationWarmupFile, if it exists.
+  static void load();
+
+  // Write the methods that currently have alive C2 code.
+  static void print_hot_methods(outputStream* out);
+  static void dump_at_exit();
+
+  static bool is_enabled() { return _enabled; }
+  static bool is_hot(const Method* method);
+};
+
+#endif // SHARE_COMPILER_COMPILATIONWARMUP_HPP
@@ -30,6 +30,7 @@
 #include "code/codeCache.hpp"
 #include "code/codeHeapState.hpp"
 #include "code/dependencyContext.hpp"
+#include "compiler/compilationWarmup.hpp"
 #include "compiler/compileBroker.hpp"
 #include "compiler/compileLog.hpp"
 #include "compiler/compilerOracle.hpp"
@@ -39,6 +40,7 @@
 #include "logging/log.hpp"
 #include "logging/logStream.hpp"
 #include "memory/allocation.inline.hpp"
+#include "memory/arena.hpp"
 #include "memory/resourceArea.hpp"
 #include "oops/methodData.hpp"
 #include "oops/method.inline.hpp"
@@ -124,6 +126,10 @@ AbstractCompiler* CompileBroker::_compilers[2];
 int CompileBroker::_c1_count = 0;
 int CompileBroker::_c2_count = 0;
 
+int CompileBroker::_initial_processor_count = 0;
+volatile int CompileBroker::_processor_count = 0;
+volatile jlong CompileBroker::_processor_count_time = 0;
+
 // An array of compiler names as Java String objects
 jobject* CompileBroker::_compiler1_objects = NULL;
 jobject* CompileBroker::_compiler2_objects = NULL;
@@ -239,6 +245,10 @@ bool compileBroker_init() {
   // init directives stack, adding default directive
   DirectivesStack::init();
 
+  if (TieredCompilation) {
+    CompilationWarmup::load();
+  }
+
   if (DirectivesParser::has_file()) {
     return DirectivesParser::parse_from_flag();
   } else if (CompilerDirectivesPrint) {
@@ -316,8 +326,10 @@ static bool can_remove(CompilerThread *ct, bool do_it) {
   // Keep at least 1 compiler thread of each type.
   if (compiler_count < 2) return false;
 
-  // Keep thread alive for at least some time.
-  if (ct->idle_time_millis() < (c1 ? 500 : 100)) return false;
+  // Keep thread alive for at least some time, unless there are more
+  // threads than the current processor count supports.
+  bool over_limit = compiler_count > CompileBroker::active_compiler_limit(c1);
+  if (!over_limit && ct->idle_time_millis() < (c1 ? 500 : 100)) return false;
 
   // We only allow the last compiler thread of each type to get removed.
   jobject last_compiler = c1 ? CompileBroker::compiler1_object(compiler_count - 1)
@@ -393,6 +405,9 @@ void CompileQueue::free_all() {
     CompileTask::free(current);
   }
   _first = NULL;
+  if (_heap != NULL) {
+    _heap->clear();
+  }
 
   // Wake up all threads that block on the queue.
   MethodCompileQueue_lock->notify_all();
@@ -500,6 +515,78 @@ void CompileQueue::remove(CompileTask* task) {
     _last = task->prev();
   }
   --_size;
+
+  if (task->queue_index() >= 0) {
+    heap_remove(task);
+  }
+}
+
+void CompileQueue::heap_sift_up(int i) {
+  CompileTask* task = _heap->at(i);
+  while (i > 0) {
+    int parent = (i - 1) / 2;
+    CompileTask* p = _heap->at(parent);
+    if (!task->has_higher_priority(p)) {
+      break;
+    }
+    heap_set(i, p);
+    i = parent;
+  }
+  heap_set(i, task);
+}
+
+void CompileQueue::heap_sift_down(int i) {
+  int len = _heap->length();
+  CompileTask* task = _heap->at(i);
+  for (;;) {
+    int child = 2 * i + 1;
+    if (child >= len) {
+      break;
+    }
+    if (child + 1 < len && _heap->at(child + 1)->has_higher_priority(_heap->at(child))) {
+      child++;
+    }
+    if (!_heap->at(child)->has_higher_priority(task)) {
+      break;
+    }
+    heap_set(i, _heap->at(child));
+    i = child;
+  }
+  heap_set(i, task);
+}
+
+void CompileQueue::heap_insert(CompileTask* task) {
+  assert(MethodCompileQueue_lock->owned_by_self(), "must own lock");
+  assert(task->queue_index() == -1, "already in the heap");
+  _heap->append(task);
+  heap_sift_up(_heap->length() - 1);
+}
+
+void CompileQueue::heap_remove(CompileTask* task) {
+  int i = task->queue_index();
+  assert(_heap->at(i) == task, "heap index out of sync");
+  task->set_queue_index(-1);
+  CompileTask* last = _heap->pop();
+  if (last != task) {
+    heap_set(i, last);
+    // The moved task may belong either above or below its new slot.
+    heap_sift_up(i);
+    heap_sift_down(last->queue_index());
+  }
+}
+
+// Re-establish the heap order after the policy changed the keys of the
+// queued tasks. Every task in the list is (re)inserted.
+void CompileQueue::heap_rebuild() {
+  assert(MethodCompileQueue_lock->owned_by_self(), "must own lock");
+  _heap->clear();
+  for (CompileTask* task = _first; task != NULL; task = task->next()) {
+    task->set_queue_index(_heap->length());
+    _heap->append(task);
+  }
+  for (int i = _heap->length() / 2 - 1; i >= 0; i--) {
+    heap_sift_down(i);
+  }
 }
 
 void CompileQueue::remove_and_mark_stale(CompileTask* task) {
@@ -585,6 +672,10 @@ void CompileBroker::compilation_init_phase1(TRAPS) {
   _c1_count = CompilationPolicy::policy()->compiler_count(CompLevel_simple);
   _c2_count = CompilationPolicy::policy()->compiler_count(CompLevel_full_optimization);
 
+  _initial_processor_count = os::active_processor_count();
+  _processor_count = _initial_processor_count;
+  _processor_count_time = os::javaTimeMillis();
+
 #if INCLUDE_JVMCI
   if (EnableJVMCI) {
     // This is creating a JVMCICompiler singleton.
@@ -893,6 +984,22 @@ void CompileBroker::init_compiler_sweeper_threads() {
   }
 }
 
+int CompileBroker::active_compiler_limit(bool c1) {
+  int max_count = c1 ? _c1_count : _c2_count;
+  if (!UseDynamicNumberOfCompilerThreads || _initial_processor_count == 0) {
+    return max_count;
+  }
+  jlong now = os::javaTimeMillis();
+  if (now - _processor_count_time >= 1000) {
+    // os::active_processor_count() may have to read the container
+    // limits, so only resample it once a second.
+    _processor_count = os::active_processor_count();
+    _processor_count_time = now;
+  }
+  int limit = (int)((jlong)max_count * _processor_count / _initial_processor_count);
+  return MAX2(1, MIN2(max_count, limit));
+}
+
 void CompileBroker::possibly_add_compiler_threads() {
   EXCEPTION_MARK;
 
@@ -906,7 +1013,7 @@ void CompileBroker::possibly_add_compiler_threads() {
 
   if (_c2_compile_queue != NULL) {
     int old_c2_count = _compilers[1]->num_compiler_threads();
-    int new_c2_count = MIN4(_c2_count,
+    int new_c2_count = MIN4(active_compiler_limit(false),
         _c2_compile_queue->size() / 2,
         (int)(available_memory / (200*M)),
         (int)(available_cc_np / (128*K)));
@@ -926,7 +1033,7 @@ void CompileBroker::possibly_add_compiler_threads() {
 
   if (_c1_compile_queue != NULL) {
     int old_c1_count = _compilers[0]->num_compiler_threads();
-    int new_c1_count = MIN4(_c1_count,
+    int new_c1_count = MIN4(active_compiler_limit(true),
         _c1_compile_queue->size() / 4,
         (int)(available_memory / (100*M)),
         (int)(available_cc_p / (128*K)));
@@ -948,6 +1055,28 @@ void CompileBroker::possibly_add_compiler_threads() {
 }
 
 
+/**
+ * Stop the given compiler thread if it is no longer needed. Returns true if
+ * the caller should exit the compiler thread loop.
+ */
+bool CompileBroker::possibly_remove_compiler_thread(CompilerThread* thread) {
+  // Access compiler_count under lock to enforce consistency.
+  MutexLocker only_one(CompileThread_lock);
+  if (!can_remove(thread, true)) {
+    return false;
+  }
+  if (TraceCompilerThreads) {
+    tty->print_cr("Removing compiler thread %s after " JLONG_FORMAT " ms idle time",
+                  thread->name(), thread->idle_time_millis());
+  }
+  // Free buffer blob, if allocated
+  if (thread->get_buffer_blob() != NULL) {
+    MutexLockerEx mu(CodeCache_lock, Mutex::_no_safepoint_check_flag);
+    CodeCache::free(thread->get_buffer_blob());
+  }
+  return true;
+}
+
 /**
  * Set the methods on the stack as on_stack so that redefine classes doesn't
  * reclaim them. This method is executed at a safepoint.
@@ -1775,21 +1904,8 @@ void CompileBroker::compiler_thread_loop() {
 
     CompileTask* task = queue->get();
     if (task == NULL) {
-      if (UseDynamicNumberOfCompilerThreads) {
-        // Access compiler_count under lock to enforce consistency.
-        MutexLocker only_one(CompileThread_lock);
-        if (can_remove(thread, true)) {
-          if (TraceCompilerThreads) {
-            tty->print_cr("Removing compiler thread %s after " JLONG_FORMAT " ms idle time",
-                          thread->name(), thread->idle_time_millis());
-          }
-          // Free buffer blob, if allocated
-          if (thread->get_buffer_blob() != NULL) {
-            MutexLockerEx mu(CodeCache_lock, Mutex::_no_safepoint_check_flag);
-            CodeCache::free(thread->get_buffer_blob());
-          }
-          return; // Stop this thread.
-        }
+      if (UseDynamicNumberOfCompilerThreads && possibly_remove_compiler_thread(thread)) {
+        return; // Stop this thread.
       }
     } else {
       // Assign the task to the current thread.  Mark this compilation
@@ -1813,10 +1929,16 @@ void CompileBroker::compiler_thread_loop() {
           task->set_failure_reason("compilation is disabled");
         }
       }
+    }
 
-      if (UseDynamicNumberOfCompilerThreads) {
-        possibly_add_compiler_threads();
+    if (UseDynamicNumberOfCompilerThreads && task != NULL) {
+      // Shrink right away if the CPU quota went down while we were busy.
+      AbstractCompiler* comp = thread->compiler();
+      if (comp->num_compiler_threads() > active_compiler_limit(comp->is_c1()) &&
+          possibly_remove_compiler_thread(thread)) {
+        return; // Stop this thread.
       }
+      possibly_add_compiler_threads();
     }
   }
 
@@ -2005,6 +2127,10 @@ void CompileBroker::invoke_compiler_on_method(CompileTask* task) {
   CompilerThread* thread = CompilerThread::current();
   ResourceMark rm(thread);
 
+  if (thread->chunk_cache() != NULL) {
+    thread->chunk_cache()->reset_peak();
+  }
+
   if (LogEvents) {
     _compilation_log->log_compile(thread, task);
   }
@@ -2183,6 +2309,11 @@ void CompileBroker::invoke_compiler_on_method(CompileTask* task) {
     tty->print_cr("time: %d inlined: %d bytes", (int)time.milliseconds(), task->num_inlined_bytecodes());
   }
 
+  if (thread->chunk_cache() != NULL) {
+    log_debug(jit, compilation)("%d   arena peak " SIZE_FORMAT "K", compile_id,
+                                thread->chunk_cache()->peak() / K);
+  }
+
   Log(compilation, codecache) log;
   if (log.is_debug()) {
     LogStream ls(log.debug());
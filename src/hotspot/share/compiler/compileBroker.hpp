@@ -30,6 +30,7 @@
 #include "compiler/compileTask.hpp"
 #include "compiler/compilerDirectives.hpp"
 #include "runtime/perfData.hpp"
+#include "utilities/growableArray.hpp"
 #include "utilities/stack.hpp"
 #if INCLUDE_JVMCI
 #include "jvmci/jvmciCompiler.hpp"
@@ -88,7 +89,20 @@ class CompileQueue : public CHeapObj<mtCompiler> {
 
   int _size;
 
+  // Max-heap of the queued tasks ordered by the key the compilation
+  // policy assigned to them, so that selection does not have to walk
+  // the whole list. Tasks queued since the policy last looked at the
+  // queue are not in the heap yet (queue_index() == -1); they are
+  // always at the tail of the list. NULL if the policy scans the list.
+  GrowableArray<CompileTask*>* _heap;
+  jlong _last_rescan;
+
   void purge_stale_tasks();
+
+  void heap_set(int i, CompileTask* task) { _heap->at_put(i, task); task->set_queue_index(i); }
+  void heap_sift_up(int i);
+  void heap_sift_down(int i);
+  void heap_remove(CompileTask* task);
  public:
   CompileQueue(const char* name) {
     _name = name;
@@ -96,6 +110,11 @@ class CompileQueue : public CHeapObj<mtCompiler> {
     _last = NULL;
     _size = 0;
     _first_stale = NULL;
+    _heap = NULL;
+    _last_rescan = 0;
+    if (TieredCompilation && TieredCompileQueueRescanInterval > 0) {
+      _heap = new (ResourceObj::C_HEAP, mtCompiler) GrowableArray<CompileTask*>(64, true, mtCompiler);
+    }
   }
 
   const char*  name() const                      { return _name; }
@@ -111,6 +130,13 @@ class CompileQueue : public CHeapObj<mtCompiler> {
   bool         is_empty() const                  { return _first == NULL; }
   int          size()     const                  { return _size;          }
 
+  // Priority heap support, used by TieredThresholdPolicy::select_task().
+  bool         uses_heap() const                 { return _heap != NULL; }
+  jlong        last_rescan() const               { return _last_rescan; }
+  void         set_last_rescan(jlong t)          { _last_rescan = t; }
+  void         heap_insert(CompileTask* task);
+  void         heap_rebuild();
+  CompileTask* heap_top() const                  { return _heap->is_empty() ? NULL : _heap->at(0); }
 
   // Redefine Classes support
   void mark_on_stack();
@@ -163,6 +189,12 @@ class CompileBroker: AllStatic {
   // The maximum numbers of compiler threads to be determined during startup.
   static int _c1_count, _c2_count;
 
+  // Processor count at startup and its latest sample, used to scale the
+  // number of active compiler threads with the CPU quota.
+  static int _initial_processor_count;
+  static volatile int _processor_count;
+  static volatile jlong _processor_count_time;
+
   // An array of compiler thread Java objects
   static jobject *_compiler1_objects, *_compiler2_objects;
 
@@ -233,6 +265,7 @@ class CompileBroker: AllStatic {
   static JavaThread* make_thread(jobject thread_oop, CompileQueue* queue, AbstractCompiler* comp, TRAPS);
   static void init_compiler_sweeper_threads();
   static void possibly_add_compiler_threads();
+  static bool possibly_remove_compiler_thread(CompilerThread* thread);
   static bool compilation_is_complete  (const methodHandle& method, int osr_bci, int comp_level);
   static bool compilation_is_prohibited(const methodHandle& method, int osr_bci, int comp_level, bool excluded);
   static void preload_classes          (const methodHandle& method, TRAPS);
@@ -291,6 +324,11 @@ public:
   static bool compilation_is_in_queue(const methodHandle& method);
   static void print_compile_queues(outputStream* st);
   static void print_directives(outputStream* st);
+  // Number of C1 or C2 threads the current processor count supports. The
+  // thread objects are allocated for the startup maximum, so this never
+  // exceeds it.
+  static int active_compiler_limit(bool c1);
+
   static int queue_size(int comp_level) {
     CompileQueue *q = compile_queue(comp_level);
     return q != NULL ? q->size() : 0;
@@ -105,6 +105,9 @@ void CompileTask::initialize(int compile_id,
   JVMCI_ONLY(_jvmci_compiler_thread = NULL;)
   _comp_level = comp_level;
   _num_inlined_bytecodes = 0;
+  _queue_index = -1;
+  _queue_class = 0;
+  _queue_weight = 0;
 
   _is_complete = false;
   _is_success = false;
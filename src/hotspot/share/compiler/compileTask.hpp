@@ -97,6 +97,10 @@ class CompileTask : public CHeapObj<mtCompiler> {
   nmethodLocker* _code_handle;  // holder of eventual result
   CompileTask* _next, *_prev;
   bool         _is_free;
+  // Slot and ordering key in the compile queue's priority heap.
+  int          _queue_index;
+  int          _queue_class;
+  double       _queue_weight;
   // Fields used for logging why the compilation was initiated:
   jlong        _time_queued;  // in units of os::elapsed_counter()
   Method*      _hot_method;   // which method actually triggered this task
@@ -172,6 +176,17 @@ class CompileTask : public CHeapObj<mtCompiler> {
   bool         is_free() const                   { return _is_free; }
   void         set_is_free(bool val)             { _is_free = val; }
 
+  int          queue_index() const               { return _queue_index; }
+  void         set_queue_index(int i)            { _queue_index = i; }
+  int          queue_class() const               { return _queue_class; }
+  double       queue_weight() const              { return _queue_weight; }
+  void         set_queue_key(int cls, double w)  { _queue_class = cls; _queue_weight = w; }
+  // True if this task should be selected before the other one.
+  bool         has_higher_priority(const CompileTask* other) const {
+    return _queue_class > other->_queue_class ||
+           (_queue_class == other->_queue_class && _queue_weight > other->_queue_weight);
+  }
+
   // RedefineClasses support
   void         metadata_do(void f(Metadata*));
   void         mark_on_stack();
@@ -104,6 +104,12 @@
           "from 0 to 4")                                                    \
           range(0, 4)                                                       \
                                                                             \
+  product(double, CMSFragmentationCoalesceThreshold, 1.0,                   \
+          "CMS: when the fragmentation of the free lists at the start of "  \
+          "a sweep exceeds this value, the sweep coalesces all adjacent "   \
+          "free and dead blocks regardless of FLSCoalescePolicy")           \
+          range(0.0, 1.0)                                                   \
+                                                                            \
   product(bool, FLSAlwaysCoalesceLarge, false,                              \
           "CMS: larger free blocks are always available for coalescing")    \
                                                                             \
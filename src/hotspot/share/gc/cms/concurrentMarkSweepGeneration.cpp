@@ -5470,8 +5470,16 @@ void CMSCollector::sweepWork(ConcurrentMarkSweepGeneration* old_gen) {
                                           _intra_sweep_estimate.padded_average());
   old_gen->setNearLargestChunk();
 
+  // If allocation has chopped the free space into many small blocks,
+  // rebuild large blocks in this sweep, before promotion fails for lack
+  // of a contiguous block and we fall back to a compacting collection.
+  const double frag = old_gen->cmsSpace()->flsFrag();
+  const bool coalesce_all = frag > CMSFragmentationCoalesceThreshold;
+  log_debug(gc, freelist)("CMS: fragmentation %1.4f at start of sweep%s",
+                          frag, coalesce_all ? ", coalescing all free blocks" : "");
+
   {
-    SweepClosure sweepClosure(this, old_gen, &_markBitMap, CMSYield);
+    SweepClosure sweepClosure(this, old_gen, &_markBitMap, CMSYield, coalesce_all);
     old_gen->cmsSpace()->blk_iterate_careful(&sweepClosure);
     // We need to free-up/coalesce garbage/blocks from a
     // co-terminal free run. This is done in the SweepClosure
@@ -6998,7 +7006,8 @@ void MarkFromDirtyCardsClosure::do_MemRegion(MemRegion mr) {
 
 SweepClosure::SweepClosure(CMSCollector* collector,
                            ConcurrentMarkSweepGeneration* g,
-                           CMSBitMap* bitMap, bool should_yield) :
+                           CMSBitMap* bitMap, bool should_yield,
+                           bool coalesce_all) :
   _collector(collector),
   _g(g),
   _sp(g->cmsSpace()),
@@ -7008,6 +7017,7 @@ SweepClosure::SweepClosure(CMSCollector* collector,
   _inFreeRange(false),           // No free range at beginning of sweep
   _freeRangeInFreeLists(false),  // No free range at beginning of sweep
   _lastFreeRangeCoalesced(false),
+  _coalesceAll(coalesce_all),
   _yield(should_yield),
   _freeFinger(g->used_region().start())
 {
@@ -7367,7 +7377,9 @@ void SweepClosure::do_post_free_or_garbage_chunk(FreeChunk* fc,
   bool coalesce = false;
   const size_t left  = pointer_delta(fc_addr, freeFinger());
   const size_t right = chunkSize;
-  switch (FLSCoalescePolicy) {
+  // A badly fragmented space coalesces as if the policy was "always".
+  const uintx policy = _coalesceAll ? 4 : FLSCoalescePolicy;
+  switch (policy) {
     // numeric value forms a coalition aggressiveness metric
     case 0:  { // never coalesce
       coalesce = false;
@@ -1614,6 +1614,10 @@ class SweepClosure: public BlkClosureCareful {
   bool                           _lastFreeRangeCoalesced;
                                         // free range contains chunks
                                         // coalesced
+  bool                           _coalesceAll;
+                                        // Coalesce every free range with
+                                        // its neighbours to reduce
+                                        // fragmentation
   bool                           _yield;
                                         // Whether sweeping should be
                                         // done with yields. For instance
@@ -1676,7 +1680,7 @@ class SweepClosure: public BlkClosureCareful {
 
  public:
   SweepClosure(CMSCollector* collector, ConcurrentMarkSweepGeneration* g,
-               CMSBitMap* bitMap, bool should_yield);
+               CMSBitMap* bitMap, bool should_yield, bool coalesce_all);
   ~SweepClosure() PRODUCT_RETURN;
 
   size_t       do_blk_careful(HeapWord* addr);
@@ -22,12 +22,43 @@
  */
 
 #include "precompiled.hpp"
+#include "aot/aotLoader.hpp"
+#include "classfile/classLoaderDataGraph.hpp"
+#include "classfile/systemDictionary.hpp"
+#include "code/codeCache.hpp"
 #include "gc/epsilon/epsilonHeap.hpp"
 #include "gc/epsilon/epsilonMemoryPool.hpp"
 #include "gc/epsilon/epsilonThreadLocalData.hpp"
+#include "gc/shared/gcId.hpp"
+#include "gc/shared/gcLocker.hpp"
+#include "gc/shared/gcTraceTime.inline.hpp"
+#include "gc/shared/isGCActiveMark.hpp"
+#include "gc/shared/markBitMap.inline.hpp"
+#include "gc/shared/preservedMarks.inline.hpp"
+#include "gc/shared/strongRootsScope.hpp"
+#include "gc/shared/weakProcessor.hpp"
 #include "memory/allocation.hpp"
 #include "memory/allocation.inline.hpp"
+#include "memory/iterator.inline.hpp"
 #include "memory/resourceArea.hpp"
+#include "memory/universe.hpp"
+#include "oops/access.inline.hpp"
+#include "oops/compressedOops.inline.hpp"
+#include "oops/oop.inline.hpp"
+#include "prims/jvmtiExport.hpp"
+#include "runtime/biasedLocking.hpp"
+#include "runtime/jniHandles.hpp"
+#include "runtime/synchronizer.hpp"
+#include "runtime/thread.hpp"
+#include "runtime/vmOperations.hpp"
+#include "runtime/vmThread.hpp"
+#include "services/management.hpp"
+#include "services/memTracker.hpp"
+#include "utilities/copy.hpp"
+#include "utilities/stack.inline.hpp"
+#if COMPILER2_OR_JVMCI
+#include "compiler/oopMap.hpp"
+#endif
 
 jint EpsilonHeap::initialize() {
   size_t align = _policy->heap_alignment();
@@ -46,6 +77,21 @@ jint EpsilonHeap::initialize() {
   _space = new ContiguousSpace();
   _space->initialize(committed_region, /* clear_space = */ true, /* mangle_space = */ true);
 
+  if (EpsilonSlidingGC) {
+    // Reserve the marking bitmap for the whole heap. It is only committed
+    // while a collection runs, to keep the footprint of the common case.
+    size_t bitmap_page_size = os::vm_page_size();
+    size_t bitmap_size = align_up(MarkBitMap::compute_size(heap_rs.size()), bitmap_page_size);
+    ReservedSpace bitmap_rs(bitmap_size, bitmap_page_size);
+    if (!bitmap_rs.is_reserved()) {
+      vm_shutdown_during_initialization("Could not reserve space for the marking bitmap");
+      return JNI_ENOMEM;
+    }
+    MemTracker::record_virtual_memory_type((address)bitmap_rs.base(), mtGC);
+    _bitmap_region = MemRegion((HeapWord*)bitmap_rs.base(), bitmap_rs.size() / HeapWordSize);
+    _bitmap.initialize(reserved_region, _bitmap_region);
+  }
+
   // Precompute hot fields
   _max_tlab_size = MIN2(CollectedHeap::max_tlab_size(), align_object_size(EpsilonMaxTLABSize / HeapWordSize));
   _step_counter_update = MIN2<size_t>(max_byte_size / 16, EpsilonUpdateCountersStep);
@@ -80,6 +126,10 @@ jint EpsilonHeap::initialize() {
     log_info(gc)("Not using TLAB allocation");
   }
 
+  if (EpsilonSlidingGC) {
+    log_info(gc)("Sliding mark-compact on heap exhaustion enabled");
+  }
+
   return JNI_OK;
 }
 
@@ -236,7 +286,7 @@ HeapWord* EpsilonHeap::allocate_new_tlab(size_t min_size,
   }
 
   // All prepared, let's do it!
-  HeapWord* res = allocate_work(size);
+  HeapWord* res = allocate_or_collect_work(size);
 
   if (res != NULL) {
     // Allocation successful
@@ -260,7 +310,21 @@ HeapWord* EpsilonHeap::allocate_new_tlab(size_t min_size,
 
 HeapWord* EpsilonHeap::mem_allocate(size_t size, bool *gc_overhead_limit_was_exceeded) {
   *gc_overhead_limit_was_exceeded = false;
-  return allocate_work(size);
+  return allocate_or_collect_work(size);
+}
+
+HeapWord* EpsilonHeap::allocate_or_collect_work(size_t size) {
+  HeapWord* res = allocate_work(size);
+  if (res == NULL && EpsilonSlidingGC && Thread::current()->is_Java_thread()) {
+    uint gc_count_before;
+    {
+      MutexLockerEx ml(Heap_lock);
+      gc_count_before = total_collections();
+    }
+    vmentry_collect(GCCause::_allocation_failure, gc_count_before);
+    res = allocate_work(size);
+  }
+  return res;
 }
 
 void EpsilonHeap::collect(GCCause::Cause cause) {
@@ -277,7 +341,20 @@ void EpsilonHeap::collect(GCCause::Cause cause) {
       print_metaspace_info();
       break;
     default:
-      log_info(gc)("GC request for \"%s\" is ignored", GCCause::to_string(cause));
+      if (EpsilonSlidingGC) {
+        if (SafepointSynchronize::is_at_safepoint()) {
+          entry_collect(cause);
+        } else {
+          uint gc_count_before;
+          {
+            MutexLockerEx ml(Heap_lock);
+            gc_count_before = total_collections();
+          }
+          vmentry_collect(cause, gc_count_before);
+        }
+      } else {
+        log_info(gc)("GC request for \"%s\" is ignored", GCCause::to_string(cause));
+      }
   }
   _monitoring_support->update_counters();
 }
@@ -341,3 +418,288 @@ void EpsilonHeap::print_metaspace_info() const {
     log_info(gc, metaspace)("Metaspace: no reliable data");
   }
 }
+
+// ------------------------------- Sliding mark-compact -------------------------------
+//
+// With EpsilonSlidingGC, running out of heap triggers a single-threaded,
+// stop-the-world Lisp2-style mark-compact instead of an OutOfMemoryError:
+//  1. Mark everything reachable from the roots in a side bitmap.
+//  2. Walk the marked objects in address order, and forward each one to the
+//     next free address at the bottom of the heap.
+//  3. Adjust all references in the roots and in the live objects.
+//  4. Slide the objects down to their new locations.
+// There is no reference processing and no class unloading: the collector
+// only has to keep the occasional overrun alive, not reclaim everything.
+
+typedef Stack<oop, mtGC> EpsilonMarkStack;
+
+class VM_EpsilonCollect: public VM_Operation {
+private:
+  const GCCause::Cause _cause;
+  const uint _gc_count_before;
+  EpsilonHeap* const _heap;
+
+public:
+  VM_EpsilonCollect(GCCause::Cause cause, uint gc_count_before) :
+    VM_Operation(),
+    _cause(cause),
+    _gc_count_before(gc_count_before),
+    _heap(EpsilonHeap::heap()) {}
+
+  VM_Operation::VMOp_Type type() const { return VMOp_EpsilonCollect; }
+  const char* name()             const { return "Epsilon Collection"; }
+
+  virtual bool doit_prologue() {
+    // Serializes with heap expansion. If another thread collected since
+    // this request was made, retry the allocation instead.
+    Heap_lock->lock();
+    if (_heap->total_collections() != _gc_count_before) {
+      Heap_lock->unlock();
+      return false;
+    }
+    return true;
+  }
+
+  virtual void doit() {
+    _heap->entry_collect(_cause);
+  }
+
+  virtual void doit_epilogue() {
+    Heap_lock->unlock();
+  }
+};
+
+void EpsilonHeap::vmentry_collect(GCCause::Cause cause, uint gc_count_before) {
+  VM_EpsilonCollect vmop(cause, gc_count_before);
+  VMThread::execute(&vmop);
+}
+
+class EpsilonScanOopClosure : public BasicOopIterateClosure {
+private:
+  EpsilonMarkStack* const _stack;
+  MarkBitMap* const _bitmap;
+
+  template <class T>
+  void do_oop_work(T* p) {
+    T o = RawAccess<>::oop_load(p);
+    if (!CompressedOops::is_null(o)) {
+      oop obj = CompressedOops::decode_not_null(o);
+      if (!_bitmap->is_marked(obj)) {
+        _bitmap->mark((HeapWord*)obj);
+        _stack->push(obj);
+      }
+    }
+  }
+
+public:
+  EpsilonScanOopClosure(EpsilonMarkStack* stack, MarkBitMap* bitmap) :
+    _stack(stack), _bitmap(bitmap) {}
+  virtual void do_oop(oop* p)       { do_oop_work(p); }
+  virtual void do_oop(narrowOop* p) { do_oop_work(p); }
+};
+
+class EpsilonCalcNewLocationObjectClosure : public ObjectClosure {
+private:
+  HeapWord* _compact_point;
+  PreservedMarks* const _preserved_marks;
+
+public:
+  EpsilonCalcNewLocationObjectClosure(HeapWord* start, PreservedMarks* pm) :
+    _compact_point(start), _preserved_marks(pm) {}
+
+  void do_object(oop obj) {
+    // Objects that stay in place are not forwarded, the later
+    // phases skip them.
+    if ((HeapWord*)obj != _compact_point) {
+      _preserved_marks->push_if_necessary(obj, obj->mark_raw());
+      obj->forward_to(oop(_compact_point));
+    }
+    _compact_point += obj->size();
+  }
+
+  HeapWord* compact_point() const { return _compact_point; }
+};
+
+class EpsilonAdjustPointersOopClosure : public BasicOopIterateClosure {
+private:
+  template <class T>
+  void do_oop_work(T* p) {
+    T o = RawAccess<>::oop_load(p);
+    if (!CompressedOops::is_null(o)) {
+      oop obj = CompressedOops::decode_not_null(o);
+      if (obj->is_forwarded()) {
+        RawAccess<IS_NOT_NULL>::oop_store(p, obj->forwardee());
+      }
+    }
+  }
+
+public:
+  virtual void do_oop(oop* p)       { do_oop_work(p); }
+  virtual void do_oop(narrowOop* p) { do_oop_work(p); }
+};
+
+class EpsilonAdjustPointersObjectClosure : public ObjectClosure {
+private:
+  EpsilonAdjustPointersOopClosure _cl;
+
+public:
+  void do_object(oop obj) {
+    obj->oop_iterate(&_cl);
+  }
+};
+
+class EpsilonMoveObjectsObjectClosure : public ObjectClosure {
+private:
+  size_t _moved;
+
+public:
+  EpsilonMoveObjectsObjectClosure() : _moved(0) {}
+
+  void do_object(oop obj) {
+    // Objects are visited in address order and only ever slide down, so the
+    // copy can only overwrite objects that have already moved.
+    if (obj->is_forwarded()) {
+      oop fwd = obj->forwardee();
+      Copy::aligned_conjoint_words((HeapWord*)obj, (HeapWord*)fwd, obj->size());
+      fwd->init_mark_raw();
+      _moved++;
+    }
+  }
+
+  size_t moved() const { return _moved; }
+};
+
+void EpsilonHeap::process_roots(OopClosure* cl) {
+  // Tell the runtime the roots are walked by a single thread
+  StrongRootsScope scope(1);
+
+  CLDToOopClosure clds(cl, ClassLoaderData::_claim_none);
+  CodeBlobToOopClosure blobs(cl, CodeBlobToOopClosure::FixRelocations);
+
+  // The whole code cache is a root, so the thread stacks do not have to
+  // report the nmethods they run. Visiting them twice would adjust their
+  // oops twice.
+  CodeCache::blobs_do(&blobs);
+  ClassLoaderDataGraph::cld_do(&clds);
+  Universe::oops_do(cl);
+  JNIHandles::oops_do(cl);
+  ObjectSynchronizer::oops_do(cl);
+  Management::oops_do(cl);
+  JvmtiExport::oops_do(cl);
+  if (UseAOT) {
+    AOTLoader::oops_do(cl);
+  }
+  SystemDictionary::oops_do(cl);
+  WeakProcessor::oops_do(cl);
+  Threads::possibly_parallel_oops_do(false, cl, NULL);
+}
+
+void EpsilonHeap::walk_bitmap(ObjectClosure* cl) {
+  HeapWord* limit = _space->top();
+  HeapWord* addr = _bitmap.get_next_marked_addr(_space->bottom(), limit);
+  while (addr < limit) {
+    oop obj = oop(addr);
+    assert(_bitmap.is_marked(obj), "sanity");
+    cl->do_object(obj);
+    addr += 1;
+    if (addr < limit) {
+      addr = _bitmap.get_next_marked_addr(addr, limit);
+    }
+  }
+}
+
+void EpsilonHeap::entry_collect(GCCause::Cause cause) {
+  assert(SafepointSynchronize::is_at_safepoint(), "Expected at safepoint");
+  assert(EpsilonSlidingGC, "Only with the sliding collection");
+
+  if (GCLocker::check_active_before_gc()) {
+    log_info(gc)("GC request for \"%s\" is skipped: JNI critical region is active", GCCause::to_string(cause));
+    return;
+  }
+
+  GCIdMark mark;
+  GCCauseSetter cause_setter(this, cause);
+  IsGCActiveMark gc_active_mark;
+  GCTraceTime(Info, gc) time("Pause Full", NULL, cause, true);
+
+  increment_total_collections(true);
+
+  // Make the heap parsable, retires the TLABs
+  ensure_parsability(true);
+
+  CodeCache::gc_prologue();
+  BiasedLocking::preserve_marks();
+#if COMPILER2_OR_JVMCI
+  DerivedPointerTable::clear();
+#endif
+
+  os::commit_memory_or_exit((char*)_bitmap_region.start(), _bitmap_region.byte_size(),
+                            false, "Could not commit the marking bitmap");
+
+  {
+    GCTraceTime(Info, gc, phases) time("Mark", NULL);
+
+    EpsilonMarkStack stack;
+    EpsilonScanOopClosure cl(&stack, &_bitmap);
+
+    ClassLoaderDataGraph::clear_claimed_marks();
+    process_roots(&cl);
+
+    while (!stack.is_empty()) {
+      oop obj = stack.pop();
+      obj->oop_iterate(&cl);
+    }
+  }
+
+#if COMPILER2_OR_JVMCI
+  // No more derived pointers are added after marking
+  DerivedPointerTable::set_active(false);
+#endif
+
+  PreservedMarks preserved_marks;
+  HeapWord* new_top;
+  {
+    GCTraceTime(Info, gc, phases) time("Calculate New Locations", NULL);
+    EpsilonCalcNewLocationObjectClosure cl(_space->bottom(), &preserved_marks);
+    walk_bitmap(&cl);
+    new_top = cl.compact_point();
+  }
+
+  {
+    GCTraceTime(Info, gc, phases) time("Adjust Pointers", NULL);
+    EpsilonAdjustPointersObjectClosure cl;
+    walk_bitmap(&cl);
+
+    EpsilonAdjustPointersOopClosure root_cl;
+    process_roots(&root_cl);
+
+    preserved_marks.adjust_during_full_gc();
+  }
+
+  {
+    GCTraceTime(Info, gc, phases) time("Move Objects", NULL);
+    EpsilonMoveObjectsObjectClosure cl;
+    walk_bitmap(&cl);
+    log_debug(gc)("Moved " SIZE_FORMAT " objects", cl.moved());
+  }
+
+  _space->set_top(new_top);
+  preserved_marks.restore();
+
+  // Freshly committed memory is zeroed, the next collection starts with a clear bitmap
+  os::uncommit_memory((char*)_bitmap_region.start(), _bitmap_region.byte_size());
+
+#if COMPILER2_OR_JVMCI
+  DerivedPointerTable::update_pointers();
+#endif
+  BiasedLocking::restore_marks();
+  CodeCache::gc_epilogue();
+  JvmtiExport::gc_epilogue();
+
+  // Restart the allocation-driven counters and printing from the new occupancy
+  size_t used = _space->used();
+  _last_counter_update = used;
+  _last_heap_print = used;
+  _monitoring_support->update_counters();
+  print_heap_info(used);
+}
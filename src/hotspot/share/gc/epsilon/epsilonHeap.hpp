@@ -25,6 +25,7 @@
 #define SHARE_GC_EPSILON_EPSILONHEAP_HPP
 
 #include "gc/shared/collectedHeap.hpp"
+#include "gc/shared/markBitMap.hpp"
 #include "gc/shared/softRefPolicy.hpp"
 #include "gc/shared/space.hpp"
 #include "services/memoryManager.hpp"
@@ -49,6 +50,8 @@ private:
   int64_t _decay_time_ns;
   volatile size_t _last_counter_update;
   volatile size_t _last_heap_print;
+  MarkBitMap _bitmap;
+  MemRegion _bitmap_region;
 
 public:
   static EpsilonHeap* heap();
@@ -89,7 +92,8 @@ public:
   }
 
   virtual bool is_scavengable(oop obj) {
-    // No GC is going to happen, therefore no objects ever move.
+    // Objects only move in the sliding collection, which visits
+    // the whole code cache anyway.
     return false;
   }
 
@@ -100,6 +104,7 @@ public:
 
   // Allocation
   HeapWord* allocate_work(size_t size);
+  HeapWord* allocate_or_collect_work(size_t size);
   virtual HeapWord* mem_allocate(size_t size, bool* gc_overhead_limit_was_exceeded);
   virtual HeapWord* allocate_new_tlab(size_t min_size,
                                       size_t requested_size,
@@ -115,14 +120,19 @@ public:
   virtual void collect(GCCause::Cause cause);
   virtual void do_full_collection(bool clear_all_soft_refs);
 
+  // Sliding mark-compact, see EpsilonSlidingGC
+  void vmentry_collect(GCCause::Cause cause, uint gc_count_before);
+  void entry_collect(GCCause::Cause cause);
+
   // Heap walking support
   virtual void safe_object_iterate(ObjectClosure* cl);
   virtual void object_iterate(ObjectClosure* cl) {
     safe_object_iterate(cl);
   }
 
-  // Object pinning support: every object is implicitly pinned
-  virtual bool supports_object_pinning() const           { return true; }
+  // Object pinning support: every object is implicitly pinned, unless the
+  // sliding collection can move them. Then JNI critical regions use GCLocker.
+  virtual bool supports_object_pinning() const           { return !EpsilonSlidingGC; }
   virtual oop pin_object(JavaThread* thread, oop obj)    { return obj; }
   virtual void unpin_object(JavaThread* thread, oop obj) { }
 
@@ -151,6 +161,9 @@ private:
   void print_heap_info(size_t used) const;
   void print_metaspace_info() const;
 
+  void process_roots(OopClosure* cl);
+  void walk_bitmap(ObjectClosure* cl);
+
 };
 
 #endif // SHARE_GC_EPSILON_EPSILONHEAP_HPP
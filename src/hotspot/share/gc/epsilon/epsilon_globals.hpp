@@ -91,6 +91,12 @@
   experimental(size_t, EpsilonMinHeapExpand, 128 * M,                       \
           "Min expansion step for heap. Larger value improves performance " \
           "at the potential expense of memory waste.")                      \
-          range(1, max_intx)
+          range(1, max_intx)                                                \
+                                                                            \
+  experimental(bool, EpsilonSlidingGC, false,                               \
+          "Run a stop-the-world sliding mark-compact of the whole heap "    \
+          "when allocation fails or a GC is requested, instead of failing " \
+          "with OutOfMemoryError. All references, including weak ones, "    \
+          "are treated as strong, and classes are never unloaded.")
 
 #endif // SHARE_GC_EPSILON_EPSILON_GLOBALS_HPP
@@ -23,6 +23,7 @@
  */
 
 #include "precompiled.hpp"
+#include "compiler/compileLog.hpp"
 #include "gc/g1/c2/g1BarrierSetC2.hpp"
 #include "gc/g1/g1BarrierSet.hpp"
 #include "gc/g1/g1BarrierSetRuntime.hpp"
@@ -321,17 +322,22 @@ bool G1BarrierSetC2::g1_can_remove_post_barrier(GraphKit* kit,
      return false; // No allocation found
   }
 
-  // Start search from Store node
-  Node* mem = store->in(MemNode::Control);
-  if (mem->is_Proj() && mem->in(0)->is_Initialize()) {
-
-    InitializeNode* st_init = mem->in(0)->as_Initialize();
-    AllocateNode*  st_alloc = st_init->allocation();
-
-    // Make sure we are looking at the same allocation
-    if (alloc == st_alloc) {
-      return true;
+  // Start search from Store node and walk up the control edges through
+  // branches and memory barriers, neither of which contains a safepoint.
+  Node* ctl = store->in(MemNode::Control);
+  while (ctl != NULL && ctl->is_Proj()) {
+    Node* n = ctl->in(0);
+    if (n->is_Initialize()) {
+      InitializeNode* st_init = n->as_Initialize();
+      AllocateNode*  st_alloc = st_init->allocation();
+
+      // Make sure we are looking at the same allocation
+      return alloc == st_alloc;
+    }
+    if (!ctl->is_IfProj() && !n->is_MemBar()) {
+      break;
     }
+    ctl = n->in(0);
   }
 
   return false;
@@ -381,13 +387,15 @@ void G1BarrierSetC2::post_barrier(GraphKit* kit,
                                   Node* val,
                                   BasicType bt,
                                   bool use_precise) const {
+  CompileLog* log = kit->C->log();
+
   // If we are writing a NULL then we need no post barrier
 
-  if (val != NULL && val->is_Con() && val->bottom_type() == TypePtr::NULL_PTR) {
-    // Must be NULL
-    const Type* t = val->bottom_type();
-    assert(t == Type::TOP || t == TypePtr::NULL_PTR, "must be NULL");
+  if (val != NULL && kit->gvn().type(val) == TypePtr::NULL_PTR) {
     // No post barrier if writing NULLx
+    if (log != NULL) {
+      log->elem("g1_post_barrier_elided reason='null_store'");
+    }
     return;
   }
 
@@ -397,14 +405,24 @@ void G1BarrierSetC2::post_barrier(GraphKit* kit,
     // That routine informs GC to take appropriate compensating steps,
     // upon a slow-path allocation, so as to make this card-mark
     // elision safe.
+    if (log != NULL) {
+      log->elem("g1_post_barrier_elided reason='just_allocated'");
+    }
     return;
   }
 
   if (use_ReduceInitialCardMarks()
       && g1_can_remove_post_barrier(kit, &kit->gvn(), oop_store, adr)) {
+    if (log != NULL) {
+      log->elem("g1_post_barrier_elided reason='initializing_store'");
+    }
     return;
   }
 
+  if (log != NULL) {
+    log->elem("g1_post_barrier");
+  }
+
   if (!use_precise) {
     // All card marks for a (non-array) instance are in one place:
     adr = obj;
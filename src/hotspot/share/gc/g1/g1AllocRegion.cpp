@@ -224,7 +224,11 @@ void G1AllocRegion::trace(const char* str, size_t min_word_size, size_t desired_
     LogStream ls_debug(log.debug());
     outputStream* out = detailed_info ? &ls_trace : &ls_debug;
 
-    out->print("%s: %u ", _name, _count);
+    if (G1NUMA::numa()->is_enabled() && _node_index != G1NUMA::AnyNodeIndex) {
+      out->print("%s[%u]: %u ", _name, _node_index, _count);
+    } else {
+      out->print("%s: %u ", _name, _count);
+    }
 
     if (_alloc_region == NULL) {
       out->print("NULL");
@@ -250,17 +254,19 @@ void G1AllocRegion::trace(const char* str, size_t min_word_size, size_t desired_
 #endif // PRODUCT
 
 G1AllocRegion::G1AllocRegion(const char* name,
-                             bool bot_updates)
+                             bool bot_updates,
+                             uint node_index)
   : _alloc_region(NULL),
     _count(0),
     _used_bytes_before(0),
     _bot_updates(bot_updates),
-    _name(name)
+    _name(name),
+    _node_index(node_index)
  { }
 
 HeapRegion* MutatorAllocRegion::allocate_new_region(size_t word_size,
                                                     bool force) {
-  return _g1h->new_mutator_alloc_region(word_size, force);
+  return _g1h->new_mutator_alloc_region(word_size, force, node_index());
 }
 
 void MutatorAllocRegion::retire_region(HeapRegion* alloc_region,
@@ -347,7 +353,7 @@ HeapRegion* MutatorAllocRegion::release() {
 HeapRegion* G1GCAllocRegion::allocate_new_region(size_t word_size,
                                                  bool force) {
   assert(!force, "not supported for GC alloc regions");
-  return _g1h->new_gc_alloc_region(word_size, _purpose);
+  return _g1h->new_gc_alloc_region(word_size, _purpose, node_index());
 }
 
 void G1GCAllocRegion::retire_region(HeapRegion* alloc_region,
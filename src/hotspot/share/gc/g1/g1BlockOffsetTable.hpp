@@ -100,6 +100,9 @@ public:
   inline size_t index_for(const void* p) const;
   inline size_t index_for_raw(const void* p) const;
 
+  // Prefetch the entry for "p" in "_offset_array".
+  inline void prefetch(const void* p) const;
+
   // Return the address indicating the start of the region corresponding to
   // "index" in "_offset_array".
   inline HeapWord* address_for_index(size_t index) const;
@@ -114,6 +114,19 @@ void G1CardCounts::clear_region(HeapRegion* hr) {
   clear_range(mr);
 }
 
+size_t G1CardCounts::sum_card_counts(HeapRegion* hr) {
+  if (!has_count_table()) {
+    return 0;
+  }
+  size_t from_card_num = ptr_2_card_num(_ct->byte_for_const(hr->bottom()));
+  size_t to_card_num = ptr_2_card_num(_ct->byte_for_const(hr->end() - 1)) + 1;
+  size_t result = 0;
+  for (size_t i = from_card_num; i < to_card_num; i++) {
+    result += _card_counts[i];
+  }
+  return result;
+}
+
 void G1CardCounts::clear_range(MemRegion mr) {
   if (has_count_table()) {
     const jbyte* from_card_ptr = _ct->byte_for_const(mr.start());
@@ -121,6 +121,10 @@ class G1CardCounts: public CHeapObj<mtGC> {
   // Clears the card counts for the cards spanned by the region
   void clear_region(HeapRegion* hr);
 
+  // Returns the sum of the refinement counts of the cards spanned by the
+  // region. The counts are not changed.
+  size_t sum_card_counts(HeapRegion* hr);
+
   // Clears the card counts for the cards spanned by the MemRegion
   void clear_range(MemRegion mr);
 
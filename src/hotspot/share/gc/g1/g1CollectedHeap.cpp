@@ -162,12 +162,15 @@ HeapRegion* G1CollectedHeap::new_heap_region(uint hrs_index,
 
 // Private methods.
 
-HeapRegion* G1CollectedHeap::new_region(size_t word_size, HeapRegionType type, bool do_expand) {
+HeapRegion* G1CollectedHeap::new_region(size_t word_size,
+                                         HeapRegionType type,
+                                         bool do_expand,
+                                         uint node_index) {
   assert(!is_humongous(word_size) || word_size <= HeapRegion::GrainWords,
          "the only time we use this to allocate a humongous region is "
          "when we are allocating a single humongous region");
 
-  HeapRegion* res = _hrm->allocate_free_region(type);
+  HeapRegion* res = _hrm->allocate_free_region(type, node_index);
 
   if (res == NULL && do_expand && _expand_heap_after_alloc_failure) {
     // Currently, only attempts to allocate GC alloc regions set
@@ -184,7 +187,7 @@ HeapRegion* G1CollectedHeap::new_region(size_t word_size, HeapRegionType type, b
       // always expand the heap by an amount aligned to the heap
       // region size, the free list should in theory not be empty.
       // In either case allocate_free_region() will check for NULL.
-      res = _hrm->allocate_free_region(type);
+      res = _hrm->allocate_free_region(type, node_index);
     } else {
       _expand_heap_after_alloc_failure = false;
     }
@@ -1398,6 +1401,43 @@ void G1CollectedHeap::shrink_helper(size_t shrink_bytes) {
   }
 }
 
+uint G1CollectedHeap::uncommit_excess_free_regions(uint max_regions) {
+  assert_heap_locked_and_not_at_safepoint();
+  assert(!_free_regions_may_have_stale_cards, "must not uncommit regions with stale cards");
+
+  const size_t capacity_bytes = capacity();
+  const size_t used_bytes = used();
+  const size_t min_heap_size = collector_policy()->min_heap_byte_size();
+  const size_t max_heap_size = collector_policy()->max_heap_byte_size();
+
+  // Same bound as used by resize_heap_if_necessary() for shrinking, based on
+  // the current occupancy.
+  const double minimum_used_percentage = 1.0 - (double) MaxHeapFreeRatio / 100.0;
+  double maximum_desired_capacity_d = (double) max_heap_size;
+  if (minimum_used_percentage > 0.0) {
+    maximum_desired_capacity_d = MIN2((double) used_bytes / minimum_used_percentage,
+                                      maximum_desired_capacity_d);
+  }
+  size_t maximum_desired_capacity = MAX2((size_t) maximum_desired_capacity_d, min_heap_size);
+
+  if (capacity_bytes <= maximum_desired_capacity) {
+    return 0;
+  }
+
+  uint num_excess_regions = (uint)((capacity_bytes - maximum_desired_capacity) / HeapRegion::GrainBytes);
+  uint num_regions_removed = _hrm->uncommit_free_regions(MIN2(num_excess_regions, max_regions));
+
+  if (num_regions_removed > 0) {
+    log_debug(gc, ergo, heap)("Uncommitted free regions. Capacity: " SIZE_FORMAT "B occupancy: " SIZE_FORMAT "B "
+                              "maximum_desired_capacity: " SIZE_FORMAT "B (" UINTX_FORMAT " %%) uncommitted: " SIZE_FORMAT "B",
+                              capacity_bytes, used_bytes, maximum_desired_capacity, MaxHeapFreeRatio,
+                              (size_t)num_regions_removed * HeapRegion::GrainBytes);
+    g1_policy()->record_new_heap_size(num_regions());
+    g1mm()->update_sizes();
+  }
+  return num_regions_removed;
+}
+
 void G1CollectedHeap::shrink(size_t shrink_bytes) {
   _verifier->verify_region_sets_optional();
 
@@ -1493,12 +1533,14 @@ G1CollectedHeap::G1CollectedHeap(G1CollectorPolicy* collector_policy) :
   _listener(),
   _hrm(NULL),
   _allocator(NULL),
+  _numa(G1NUMA::create()),
   _verifier(NULL),
   _summary_bytes_used(0),
   _archive_allocator(NULL),
   _survivor_evac_stats("Young", YoungPLABSize, PLABWeight),
   _old_evac_stats("Old", OldPLABSize, PLABWeight),
   _expand_heap_after_alloc_failure(true),
+  _free_regions_may_have_stale_cards(false),
   _g1mm(NULL),
   _humongous_reclaim_candidates(),
   _has_humongous_reclaim_candidates(false),
@@ -1696,6 +1738,7 @@ jint G1CollectedHeap::initialize() {
   // Carve out the G1 part of the heap.
   ReservedSpace g1_rs = heap_rs.first_part(max_byte_size);
   size_t page_size = actual_reserved_page_size(heap_rs);
+  _numa->set_region_info(HeapRegion::GrainBytes, page_size);
   G1RegionToSpaceMapper* heap_storage =
     G1RegionToSpaceMapper::create_heap_mapper(g1_rs,
                                               g1_rs.size(),
@@ -2223,6 +2266,28 @@ void G1CollectedHeap::object_iterate(ObjectClosure* cl) {
   heap_region_iterate(&blk);
 }
 
+// Hands out the heap regions to the workers through a HeapRegionClaimer.
+class G1ParallelObjectIterator : public ParallelObjectIterator {
+ private:
+  G1CollectedHeap*  _heap;
+  HeapRegionClaimer _claimer;
+
+ public:
+  G1ParallelObjectIterator(uint thread_num) :
+    _heap(G1CollectedHeap::heap()),
+    _claimer(thread_num) {}
+
+  virtual void object_iterate(ObjectClosure* cl, uint worker_id) {
+    IterateObjectClosureRegionClosure blk(cl);
+    _heap->heap_region_par_iterate_from_worker_offset(&blk, &_claimer, worker_id);
+  }
+};
+
+ParallelObjectIterator* G1CollectedHeap::parallel_object_iterator(uint thread_num) {
+  assert_at_safepoint();
+  return new G1ParallelObjectIterator(thread_num);
+}
+
 void G1CollectedHeap::heap_region_iterate(HeapRegionClosure* cl) const {
   _hrm->iterate(cl);
 }
@@ -2546,6 +2611,9 @@ void G1CollectedHeap::gc_prologue(bool full) {
 }
 
 void G1CollectedHeap::gc_epilogue(bool full) {
+  // All pending cards have been processed or discarded by now.
+  _free_regions_may_have_stale_cards = false;
+
   // Update common counters.
   if (full) {
     // Update the number of full collections that have been completed.
@@ -2670,12 +2738,14 @@ class RegisterHumongousWithInCSetFastTestClosure : public HeapRegionClosure {
     // structures don't support efficiently performing the needed
     // additional tests or scrubbing of the mark stack.
     //
-    // However, we presently only nominate is_typeArray() objects.
-    // A humongous object containing references induces remembered
-    // set entries on other regions.  In order to reclaim such an
-    // object, those remembered sets would need to be cleaned up.
+    // A humongous object array induces remembered set entries on other
+    // regions. After reclamation these entries are stale, which is
+    // tolerated as remembered set scanning and refinement ignore cards
+    // in free regions and in regions allocated into after the start of
+    // the collection. The card table of the reclaimed regions is cleared
+    // to drop any cards logged during this pause.
     //
-    // We also treat is_typeArray() objects specially, allowing them
+    // We treat is_typeArray() objects specially, allowing them
     // to be reclaimed even if allocated before the start of
     // concurrent mark.  For this we rely on mark stack insertion to
     // exclude is_typeArray() objects, preventing reclaiming an object
@@ -2685,8 +2755,15 @@ class RegisterHumongousWithInCSetFastTestClosure : public HeapRegionClosure {
     // important use case for eager reclaim, and this special handling
     // may reduce needed headroom.
 
-    return obj->is_typeArray() &&
-           g1h->is_potential_eager_reclaim_candidate(region);
+    if (obj->is_typeArray()) {
+      return g1h->is_potential_eager_reclaim_candidate(region);
+    }
+    if (obj->is_objArray() && G1EagerReclaimHumongousObjArrays) {
+      return (!g1h->collector_state()->mark_or_rebuild_in_progress() ||
+              region->next_top_at_mark_start() == region->bottom()) &&
+             g1h->is_potential_eager_reclaim_candidate(region);
+    }
+    return false;
   }
 
  public:
@@ -2706,6 +2783,7 @@ class RegisterHumongousWithInCSetFastTestClosure : public HeapRegionClosure {
     uint rindex = r->hrm_index();
     g1h->set_humongous_reclaim_candidate(rindex, is_candidate);
     if (is_candidate) {
+      g1h->verifier()->verify_humongous_reclaim_candidate(r);
       _candidate_humongous++;
       g1h->register_humongous_region_with_cset(rindex);
       // Is_candidate already filters out humongous object with large remembered sets.
@@ -2757,25 +2835,52 @@ class RegisterHumongousWithInCSetFastTestClosure : public HeapRegionClosure {
   void flush_rem_set_entries() { _dcq.flush(); }
 };
 
+class G1RegisterHumongousWithInCSetTask : public AbstractGangTask {
+  G1CollectedHeap* _g1h;
+  HeapRegionClaimer _claimer;
+  volatile size_t _total_humongous;
+  volatile size_t _candidate_humongous;
+
+public:
+  G1RegisterHumongousWithInCSetTask(G1CollectedHeap* g1h, uint num_workers) :
+    AbstractGangTask("G1 Register Humongous Candidates"),
+    _g1h(g1h),
+    _claimer(num_workers),
+    _total_humongous(0),
+    _candidate_humongous(0) { }
+
+  virtual void work(uint worker_id) {
+    RegisterHumongousWithInCSetFastTestClosure cl;
+    _g1h->heap_region_par_iterate_from_worker_offset(&cl, &_claimer, worker_id);
+    // Flush all remembered set entries to re-check into the global DCQS.
+    cl.flush_rem_set_entries();
+
+    Atomic::add(cl.total_humongous(), &_total_humongous);
+    Atomic::add(cl.candidate_humongous(), &_candidate_humongous);
+  }
+
+  size_t total_humongous() const { return _total_humongous; }
+  size_t candidate_humongous() const { return _candidate_humongous; }
+};
+
 void G1CollectedHeap::register_humongous_regions_with_cset() {
-  if (!G1EagerReclaimHumongousObjects) {
+  if (!G1EagerReclaimHumongousObjects || _humongous_set.is_empty()) {
     g1_policy()->phase_times()->record_fast_reclaim_humongous_stats(0.0, 0, 0);
+    _has_humongous_reclaim_candidates = false;
     return;
   }
   double time = os::elapsed_counter();
 
   // Collect reclaim candidate information and register candidates with cset.
-  RegisterHumongousWithInCSetFastTestClosure cl;
-  heap_region_iterate(&cl);
+  uint num_workers = workers()->active_workers();
+  G1RegisterHumongousWithInCSetTask task(this, num_workers);
+  workers()->run_task(&task, num_workers);
 
   time = ((double)(os::elapsed_counter() - time) / os::elapsed_frequency()) * 1000.0;
   g1_policy()->phase_times()->record_fast_reclaim_humongous_stats(time,
-                                                                  cl.total_humongous(),
-                                                                  cl.candidate_humongous());
-  _has_humongous_reclaim_candidates = cl.candidate_humongous() > 0;
-
-  // Finally flush all remembered set entries to re-check into the global DCQS.
-  cl.flush_rem_set_entries();
+                                                                  task.total_humongous(),
+                                                                  task.candidate_humongous());
+  _has_humongous_reclaim_candidates = task.candidate_humongous() > 0;
 }
 
 class VerifyRegionRemSetClosure : public HeapRegionClosure {
@@ -3879,8 +3984,17 @@ void G1CollectedHeap::evacuate_optional_collection_set(G1ParScanThreadStateSet*
       break;
     }
 
+    double increment_start_sec = os::elapsedTime();
+    uint increment_regions = optional_cset.prepared_regions();
+
     evacuate_optional_regions(per_thread_states, &optional_cset);
 
+    double increment_ms = (os::elapsedTime() - increment_start_sec) * 1000.0;
+    phase_times->record_optional_evacuation_increment(optional_cset.predicted_time_ms(), increment_ms);
+    log_debug(gc, ergo, cset)("Optional increment %u: evacuated %u regions in %.3fms (predicted %.3fms)",
+                              phase_times->optional_evacuation_increments(), increment_regions,
+                              increment_ms, optional_cset.predicted_time_ms());
+
     optional_cset.complete_evacuation();
     if (optional_cset.evacuation_failed()) {
       break;
@@ -4340,10 +4454,11 @@ class G1FreeHumongousRegionClosure : public HeapRegionClosure {
     // are completely up-to-date wrt to references to the humongous object.
     //
     // Other implementation considerations:
-    // - never consider object arrays at this time because they would pose
-    // considerable effort for cleaning up the the remembered sets. This is
-    // required because stale remembered sets might reference locations that
-    // are currently allocated into.
+    // - object arrays leave stale remembered set entries in other regions
+    // behind. Remembered set scanning and refinement ignore cards in free
+    // regions and in regions allocated into after the start of a collection,
+    // but the card table of the region must be cleaned of cards that were
+    // logged during this pause.
     uint region_idx = r->hrm_index();
     if (!g1h->is_humongous_reclaim_candidate(region_idx) ||
         !r->rem_set()->is_empty()) {
@@ -4360,8 +4475,8 @@ class G1FreeHumongousRegionClosure : public HeapRegionClosure {
       return false;
     }
 
-    guarantee(obj->is_typeArray(),
-              "Only eagerly reclaiming type arrays is supported, but the object "
+    guarantee(obj->is_typeArray() || (G1EagerReclaimHumongousObjArrays && obj->is_objArray()),
+              "Only eagerly reclaiming type arrays and object arrays is supported, but the object "
               PTR_FORMAT " is not.", p2i(r->bottom()));
 
     log_debug(gc, humongous)("Dead humongous region %u object size " SIZE_FORMAT " start " PTR_FORMAT " with remset " SIZE_FORMAT " code roots " SIZE_FORMAT " is marked %d reclaim candidate %d type array %d",
@@ -4388,7 +4503,10 @@ class G1FreeHumongousRegionClosure : public HeapRegionClosure {
       _freed_bytes += r->used();
       r->set_containing_set(NULL);
       _humongous_regions_reclaimed++;
+      // Drop cards of object arrays that were logged during this pause.
+      r->clear_cardtable();
       g1h->free_humongous_region(r, _free_region_list);
+      g1h->verifier()->verify_eagerly_reclaimed_region(r);
       r = next;
     } while (r != NULL);
 
@@ -4631,16 +4749,22 @@ bool G1CollectedHeap::is_in_closed_subset(const void* p) const {
   return hr->is_in(p);
 }
 
+bool G1CollectedHeap::is_object_non_movable(oop obj) const {
+  return heap_region_containing(obj)->is_pinned();
+}
+
 // Methods for the mutator alloc region
 
 HeapRegion* G1CollectedHeap::new_mutator_alloc_region(size_t word_size,
-                                                      bool force) {
+                                                      bool force,
+                                                      uint node_index) {
   assert_heap_locked_or_at_safepoint(true /* should_be_vm_thread */);
   bool should_allocate = g1_policy()->should_allocate_mutator_region();
   if (force || should_allocate) {
     HeapRegion* new_alloc_region = new_region(word_size,
                                               HeapRegionType::Eden,
-                                              false /* do_expand */);
+                                              false /* do_expand */,
+                                              node_index);
     if (new_alloc_region != NULL) {
       set_region_short_lived_locked(new_alloc_region);
       _hr_printer.alloc(new_alloc_region, !should_allocate);
@@ -4676,7 +4800,7 @@ bool G1CollectedHeap::has_more_regions(InCSetState dest) {
   }
 }
 
-HeapRegion* G1CollectedHeap::new_gc_alloc_region(size_t word_size, InCSetState dest) {
+HeapRegion* G1CollectedHeap::new_gc_alloc_region(size_t word_size, InCSetState dest, uint node_index) {
   assert(FreeList_lock->owned_by_self(), "pre-condition");
 
   if (!has_more_regions(dest)) {
@@ -4692,7 +4816,8 @@ HeapRegion* G1CollectedHeap::new_gc_alloc_region(size_t word_size, InCSetState d
 
   HeapRegion* new_alloc_region = new_region(word_size,
                                             type,
-                                            true /* do_expand */);
+                                            true /* do_expand */,
+                                            node_index);
 
   if (new_alloc_region != NULL) {
     if (type.is_survivor()) {
@@ -42,6 +42,7 @@
 #include "gc/g1/g1HRPrinter.hpp"
 #include "gc/g1/g1InCSetState.hpp"
 #include "gc/g1/g1MonitoringSupport.hpp"
+#include "gc/g1/g1NUMA.hpp"
 #include "gc/g1/g1SurvivorRegions.hpp"
 #include "gc/g1/g1YCTypes.hpp"
 #include "gc/g1/heapRegionManager.hpp"
@@ -201,6 +202,9 @@ private:
   // Manages all allocations with regions except humongous object allocations.
   G1Allocator* _allocator;
 
+  // Information about the NUMA nodes regions are placed on.
+  G1NUMA* _numa;
+
   // Manages all heap verification.
   G1HeapVerifier* _verifier;
 
@@ -230,6 +234,13 @@ private:
   // start of each GC.
   bool _expand_heap_after_alloc_failure;
 
+  // Set when regions have been freed outside of an evacuation pause (at
+  // Cleanup), so there may still be stale cards into free regions pending
+  // refinement. Such regions must not be uncommitted concurrently. Reset at
+  // the end of every young or full collection, which dispose of all pending
+  // cards.
+  bool _free_regions_may_have_stale_cards;
+
   // Helper for monitoring and management support.
   G1MonitoringSupport* _g1mm;
 
@@ -376,7 +387,12 @@ private:
   // attempt to expand the heap if necessary to satisfy the allocation
   // request. 'type' takes the type of region to be allocated. (Use constants
   // Old, Eden, Humongous, Survivor defined in HeapRegionType.)
-  HeapRegion* new_region(size_t word_size, HeapRegionType type, bool do_expand);
+  // If 'node_index' is not G1NUMA::AnyNodeIndex, regions located on that
+  // NUMA node are preferred.
+  HeapRegion* new_region(size_t word_size,
+                         HeapRegionType type,
+                         bool do_expand,
+                         uint node_index = G1NUMA::AnyNodeIndex);
 
   // Initialize a contiguous set of free regions of length num_regions
   // and starting at index first so that they appear as a single
@@ -451,13 +467,13 @@ private:
   // These methods are the "callbacks" from the G1AllocRegion class.
 
   // For mutator alloc regions.
-  HeapRegion* new_mutator_alloc_region(size_t word_size, bool force);
+  HeapRegion* new_mutator_alloc_region(size_t word_size, bool force, uint node_index);
   void retire_mutator_alloc_region(HeapRegion* alloc_region,
                                    size_t allocated_bytes);
 
   // For GC alloc regions.
   bool has_more_regions(InCSetState dest);
-  HeapRegion* new_gc_alloc_region(size_t word_size, InCSetState dest);
+  HeapRegion* new_gc_alloc_region(size_t word_size, InCSetState dest, uint node_index);
   void retire_gc_alloc_region(HeapRegion* alloc_region,
                               size_t allocated_bytes, InCSetState dest);
 
@@ -702,6 +718,19 @@ private:
   void shrink(size_t expand_bytes);
   void shrink_helper(size_t expand_bytes);
 
+public:
+  // Concurrently uncommit free regions at the top of the heap while the
+  // capacity exceeds the maximum desired capacity given by MaxHeapFreeRatio,
+  // but at most max_regions regions. Must be called with the Heap_lock held
+  // and while joined to the suspendible thread set, outside of a concurrent
+  // cycle. Returns the number of regions uncommitted.
+  uint uncommit_excess_free_regions(uint max_regions);
+
+  void set_free_regions_may_have_stale_cards() { _free_regions_may_have_stale_cards = true; }
+  bool free_regions_may_have_stale_cards() const { return _free_regions_may_have_stale_cards; }
+
+private:
+
   #if TASKQUEUE_STATS
   static void print_taskqueue_stats_hdr(outputStream* const st);
   void print_taskqueue_stats() const;
@@ -954,6 +983,8 @@ public:
 
   HeapRegionManager* hrm() const { return _hrm; }
 
+  G1NUMA* numa() const { return _numa; }
+
   const G1CollectionSet* collection_set() const { return &_collection_set; }
   G1CollectionSet* collection_set() { return &_collection_set; }
 
@@ -1107,6 +1138,9 @@ public:
 
   virtual bool is_in_closed_subset(const void* p) const;
 
+  // Humongous and archive regions are never evacuated or compacted.
+  virtual bool is_object_non_movable(oop obj) const;
+
   G1HotCardCache* g1_hot_card_cache() const { return _hot_card_cache; }
 
   G1CardTable* card_table() const {
@@ -1122,6 +1156,8 @@ public:
     object_iterate(cl);
   }
 
+  virtual ParallelObjectIterator* parallel_object_iterator(uint thread_num);
+
   // Iterate over heap regions, in address order, terminating the
   // iteration early if the "do_heap_region" method returns "true".
   void heap_region_iterate(HeapRegionClosure* blk) const;
@@ -64,6 +64,7 @@ G1CollectionSet::G1CollectionSet(G1CollectedHeap* g1h, G1Policy* policy) :
   _optional_region_max_length(0),
   _bytes_used_before(0),
   _recorded_rs_lengths(0),
+  _predicted_pause_time_ms(0.0),
   _inc_build_state(Inactive),
   _inc_bytes_used_before(0),
   _inc_recorded_rs_lengths(0),
@@ -426,6 +427,7 @@ double G1CollectionSet::finalize_young_part(double target_pause_time_ms, G1Survi
 
   _bytes_used_before = _inc_bytes_used_before;
   time_remaining_ms = MAX2(time_remaining_ms - _inc_predicted_elapsed_time_ms, 0.0);
+  _predicted_pause_time_ms = base_time_ms + _inc_predicted_elapsed_time_ms;
 
   log_trace(gc, ergo, cset)("Add young regions to CSet. eden: %u regions, survivors: %u regions, predicted young region time: %1.2fms, target pause time: %1.2fms",
                             eden_region_length, survivor_region_length, _inc_predicted_elapsed_time_ms, target_pause_time_ms);
@@ -563,6 +565,7 @@ void G1CollectionSet::finalize_old_part(double time_remaining_ms) {
   }
 
   stop_incremental_building();
+  _predicted_pause_time_ms += predicted_old_time_ms;
 
   log_debug(gc, ergo, cset)("Finish choosing CSet regions old: %u, optional: %u, "
                             "predicted old time: %1.2fms, predicted optional time: %1.2fms, time remaining: %1.2f",
@@ -590,13 +593,16 @@ void G1OptionalCSet::prepare_evacuation(double time_limit) {
   double prediction_ms = 0;
 
   _prepare_failed = true;
+  _predicted_time_ms = 0.0;
   for (uint i = _current_index; i < _cset->optional_region_length(); i++) {
     HeapRegion* hr = region_at(i);
-    prediction_ms += _cset->predict_region_elapsed_time_ms(hr);
-    if (prediction_ms > time_limit) {
+    double region_prediction_ms = _cset->predict_region_elapsed_time_ms(hr);
+    if (prediction_ms + region_prediction_ms > time_limit) {
       log_debug(gc, cset)("Prepared %u regions for optional evacuation. Predicted time: %.3fms", prepared_regions, prediction_ms);
+      _predicted_time_ms = prediction_ms;
       return;
     }
+    prediction_ms += region_prediction_ms;
 
     // This region will be included in the next optional evacuation.
     prepare_to_evacuate_optional_region(hr);
@@ -607,6 +613,7 @@ void G1OptionalCSet::prepare_evacuation(double time_limit) {
 
   log_debug(gc, cset)("Prepared all %u regions for optional evacuation. Predicted time: %.3fms",
                       prepared_regions, prediction_ms);
+  _predicted_time_ms = prediction_ms;
 }
 
 bool G1OptionalCSet::prepare_failed() {
@@ -74,6 +74,10 @@ class G1CollectionSet {
 
   size_t _recorded_rs_lengths;
 
+  // The predicted time of the pause collecting the young and old regions
+  // of the collection set, excluding optional regions.
+  double _predicted_pause_time_ms;
+
   // The associated information that is maintained while the incremental
   // collection set is being built with young regions. Used to populate
   // the recorded info for the evacuation pause.
@@ -180,6 +184,8 @@ public:
 
   size_t recorded_rs_lengths() { return _recorded_rs_lengths; }
 
+  double predicted_pause_time_ms() const { return _predicted_pause_time_ms; }
+
   size_t bytes_used_before() const {
     return _bytes_used_before;
   }
@@ -246,6 +252,8 @@ private:
   G1ParScanThreadStateSet* _pset;
   uint _current_index;
   uint _current_limit;
+  // Predicted evacuation time of the regions prepared last.
+  double _predicted_time_ms;
   bool _prepare_failed;
   bool _evacuation_failed;
 
@@ -259,6 +267,7 @@ public:
     _pset(pset),
     _current_index(0),
     _current_limit(0),
+    _predicted_time_ms(0.0),
     _prepare_failed(false),
     _evacuation_failed(false) { }
   // The destructor returns regions to the collection set candidates set and
@@ -276,6 +285,8 @@ public:
   // Prepare a set of regions for optional evacuation.
   void prepare_evacuation(double time_left_ms);
   bool prepare_failed();
+  uint prepared_regions() const { return _current_limit - _current_index; }
+  double predicted_time_ms() const { return _predicted_time_ms; }
 
   // Complete the evacuation of the previously prepared
   // regions by updating their state and check for failures.
@@ -1313,7 +1313,9 @@ void G1ConcurrentMark::reclaim_empty_regions() {
         hrp->cleanup(hr);
       }
     }
-    // And actually make them available.
+    // And actually make them available. There may still be stale cards into
+    // these regions until the next young collection.
+    _g1h->set_free_regions_may_have_stale_cards();
     _g1h->prepend_to_freelist(&empty_regions_list);
   }
 }
@@ -37,6 +37,7 @@
 #include "runtime/safepoint.hpp"
 #include "runtime/thread.inline.hpp"
 #include "runtime/threadSMR.hpp"
+#include "utilities/quickSort.hpp"
 
 // Closure used for updating remembered sets and recording references that
 // point into the collection set while the mutator is running.
@@ -141,12 +142,50 @@ bool G1DirtyCardQueueSet::apply_closure_to_buffer(G1CardTableEntryClosure* cl,
   } while (0)
 #endif // ASSERT
 
+static int compare_card_ptrs(void* card1, void* card2) {
+  if (card1 < card2) {
+    return -1;
+  } else if (card1 > card2) {
+    return 1;
+  }
+  return 0;
+}
+
+// Sort the cards in buf from index to size by address and remove duplicates.
+// The remaining cards are moved to the end of buf. Returns their start index.
+static size_t sort_and_dedup_cards(void** buf, size_t index, size_t size) {
+  QuickSort::sort(buf + index, size - index, compare_card_ptrs, false);
+  size_t dst = size;
+  for (size_t i = size; i > index; i--) {
+    void* card_ptr = buf[i - 1];
+    if (dst == size || buf[dst] != card_ptr) {
+      buf[--dst] = card_ptr;
+    }
+  }
+  return dst;
+}
+
+bool G1DirtyCardQueueSet::refine_buffer_concurrently(BufferNode* node, uint worker_i) {
+  if (!G1BatchedConcRefinement) {
+    G1RefineCardConcurrentlyClosure cl;
+    return apply_closure_to_buffer(&cl, node, true, worker_i);
+  }
+  void** buf = BufferNode::make_buffer_from_node(node);
+  size_t size = buffer_size();
+  size_t index = sort_and_dedup_cards(buf, node->index(), size);
+  size_t processed =
+    G1CollectedHeap::heap()->g1_rem_set()->refine_cards_concurrently(reinterpret_cast<jbyte**>(buf + index),
+                                                                      size - index,
+                                                                      worker_i);
+  node->set_index(index + processed);
+  return index + processed == size;
+}
+
 bool G1DirtyCardQueueSet::mut_process_buffer(BufferNode* node) {
   guarantee(_free_ids != NULL, "must be");
 
   uint worker_i = _free_ids->claim_par_id(); // temporarily claim an id
-  G1RefineCardConcurrentlyClosure cl;
-  bool result = apply_closure_to_buffer(&cl, node, true, worker_i);
+  bool result = refine_buffer_concurrently(node, worker_i);
   _free_ids->release_par_id(worker_i); // release the id
 
   if (result) {
@@ -157,8 +196,20 @@ bool G1DirtyCardQueueSet::mut_process_buffer(BufferNode* node) {
 }
 
 bool G1DirtyCardQueueSet::refine_completed_buffer_concurrently(uint worker_i, size_t stop_at) {
-  G1RefineCardConcurrentlyClosure cl;
-  return apply_closure_to_completed_buffer(&cl, worker_i, stop_at, false);
+  BufferNode* nd = get_completed_buffer(stop_at);
+  if (nd == NULL) {
+    return false;
+  }
+  if (refine_buffer_concurrently(nd, worker_i)) {
+    assert_fully_consumed(nd, buffer_size());
+    // Done with fully processed buffer.
+    deallocate_buffer(nd);
+    Atomic::inc(&_processed_buffers_rs_thread);
+  } else {
+    // Return partially processed buffer to the queue.
+    enqueue_completed_buffer(nd);
+  }
+  return true;
 }
 
 bool G1DirtyCardQueueSet::apply_closure_during_gc(G1CardTableEntryClosure* cl, uint worker_i) {
@@ -101,6 +101,12 @@ class G1DirtyCardQueueSet: public PtrQueueSet {
                                          size_t stop_at,
                                          bool during_pause);
 
+  // Refine the cards of "node" from its index to buffer_size. The cards
+  // are sorted and deduplicated first if G1BatchedConcRefinement is set.
+  // Returns true if all cards were processed; otherwise updates the index
+  // to exclude the processed cards and returns false.
+  bool refine_buffer_concurrently(BufferNode* node, uint worker_i);
+
   bool mut_process_buffer(BufferNode* node);
 
   G1FreeIdSet* _free_ids;
@@ -130,8 +136,8 @@ public:
 
   static void handle_zero_index_for_thread(JavaThread* t);
 
-  // Apply G1RefineCardConcurrentlyClosure to completed buffers until there are stop_at
-  // completed buffers remaining.
+  // If there are more than stop_at completed buffers, pop one and refine its
+  // cards concurrently, returning true. Otherwise return false.
   bool refine_completed_buffer_concurrently(uint worker_i, size_t stop_at);
 
   // Apply the given closure to all completed buffers. The given closure's do_card_ptr
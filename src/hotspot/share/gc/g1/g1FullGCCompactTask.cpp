@@ -32,6 +32,7 @@
 #include "gc/shared/gcTraceTime.inline.hpp"
 #include "logging/log.hpp"
 #include "oops/oop.inline.hpp"
+#include "runtime/atomic.hpp"
 #include "utilities/ticks.hpp"
 
 class G1ResetHumongousClosure : public HeapRegionClosure {
@@ -87,13 +88,55 @@ void G1FullGCCompactTask::compact_region(HeapRegion* hr) {
   hr->complete_compaction();
 }
 
+G1FullGCCompactTask::G1FullGCCompactTask(G1FullCollector* collector) :
+    G1FullGCTask("G1 Compact Task", collector),
+    _claimer(collector->workers()),
+    _claimed_chains(NEW_C_HEAP_ARRAY(volatile uint, collector->workers(), mtGC)) {
+  for (uint i = 0; i < collector->workers(); i++) {
+    _claimed_chains[i] = 0;
+  }
+}
+
+G1FullGCCompactTask::~G1FullGCCompactTask() {
+  FREE_C_HEAP_ARRAY(volatile uint, _claimed_chains);
+}
+
+bool G1FullGCCompactTask::claim_chain(uint cp_index, uint* chain) {
+  uint num_chains = collector()->compaction_point(cp_index)->num_chains();
+  // Check first to avoid needless contention on exhausted compaction points.
+  if (_claimed_chains[cp_index] >= num_chains) {
+    return false;
+  }
+  uint claimed = Atomic::add(1u, &_claimed_chains[cp_index]) - 1;
+  if (claimed >= num_chains) {
+    return false;
+  }
+  *chain = claimed;
+  return true;
+}
+
+void G1FullGCCompactTask::compact_chain(G1FullGCCompactionPoint* cp, uint chain) {
+  int start;
+  int end;
+  cp->chain_bounds(chain, &start, &end);
+  // Regions within a chain must be compacted in order.
+  GrowableArray<HeapRegion*>* compaction_queue = cp->regions();
+  for (int i = start; i < end; i++) {
+    compact_region(compaction_queue->at(i));
+  }
+}
+
 void G1FullGCCompactTask::work(uint worker_id) {
   Ticks start = Ticks::now();
-  GrowableArray<HeapRegion*>* compaction_queue = collector()->compaction_point(worker_id)->regions();
-  for (GrowableArrayIterator<HeapRegion*> it = compaction_queue->begin();
-       it != compaction_queue->end();
-       ++it) {
-    compact_region(*it);
+  // Compact the chains of the own compaction queue first, then steal chains
+  // from the queues of the other workers.
+  uint num_workers = collector()->workers();
+  for (uint i = 0; i < num_workers; i++) {
+    uint cp_index = (worker_id + i) % num_workers;
+    uint chain;
+    while (claim_chain(cp_index, &chain)) {
+      compact_chain(collector()->compaction_point(cp_index), chain);
+    }
   }
 
   G1ResetHumongousClosure hc(collector()->mark_bitmap());
@@ -40,12 +40,16 @@ protected:
   HeapRegionClaimer _claimer;
 
 private:
+  // Number of claimed chains of each compaction point.
+  volatile uint* _claimed_chains;
+
   void compact_region(HeapRegion* hr);
+  void compact_chain(G1FullGCCompactionPoint* cp, uint chain);
+  bool claim_chain(uint cp_index, uint* chain);
 
 public:
-  G1FullGCCompactTask(G1FullCollector* collector) :
-    G1FullGCTask("G1 Compact Task", collector),
-    _claimer(collector->workers()) { }
+  G1FullGCCompactTask(G1FullCollector* collector);
+  ~G1FullGCCompactTask();
   void work(uint worker_id);
   void serial_compaction();
 
@@ -31,13 +31,16 @@
 G1FullGCCompactionPoint::G1FullGCCompactionPoint() :
     _current_region(NULL),
     _threshold(NULL),
-    _compaction_top(NULL) {
+    _compaction_top(NULL),
+    _chain_live_words(0) {
   _compaction_regions = new (ResourceObj::C_HEAP, mtGC) GrowableArray<HeapRegion*>(32, true, mtGC);
   _compaction_region_iterator = _compaction_regions->begin();
+  _chain_starts = new (ResourceObj::C_HEAP, mtGC) GrowableArray<int>(4, true, mtGC);
 }
 
 G1FullGCCompactionPoint::~G1FullGCCompactionPoint() {
   delete _compaction_regions;
+  delete _chain_starts;
 }
 
 void G1FullGCCompactionPoint::update() {
@@ -126,6 +129,7 @@ void G1FullGCCompactionPoint::forward(oop object, size_t size) {
   }
 
   // Update compaction values.
+  _chain_live_words += size;
   _compaction_top += size;
   if (_compaction_top > _threshold) {
     _threshold = _current_region->cross_threshold(_compaction_top - size, _compaction_top);
@@ -143,3 +147,38 @@ void G1FullGCCompactionPoint::merge(G1FullGCCompactionPoint* other) {
 HeapRegion* G1FullGCCompactionPoint::remove_last() {
   return _compaction_regions->pop();
 }
+
+uint G1FullGCCompactionPoint::start_new_chain(HeapRegion* hr) {
+  assert(is_initialized(), "Must have been initialized");
+  assert(hr == _compaction_regions->last(), "Must be the region added last");
+
+  uint skipped = 0;
+  if (_current_region != hr) {
+    // Save compaction top and advance to hr. The tail of the current region
+    // is left unused.
+    _current_region->set_compaction_top(_compaction_top);
+    while (*(++_compaction_region_iterator) != hr) {
+      skipped++;
+    }
+    _current_region = hr;
+    hr->set_compaction_top(hr->bottom());
+    initialize_values(true);
+  }
+  _chain_starts->append(_compaction_regions->length() - 1);
+  _chain_live_words = 0;
+  return skipped;
+}
+
+uint G1FullGCCompactionPoint::num_chains() {
+  return has_regions() ? (uint)_chain_starts->length() + 1 : 0;
+}
+
+void G1FullGCCompactionPoint::chain_bounds(uint chain, int* start, int* end) {
+  assert(chain < num_chains(), "Chain %u out of bounds", chain);
+  int length = _compaction_regions->length();
+  *start = chain == 0 ? 0 : _chain_starts->at(chain - 1);
+  *end = chain + 1 < num_chains() ? _chain_starts->at(chain) : length;
+  // The last region may have been moved to the serial compaction point.
+  *start = MIN2(*start, length);
+  *end = MIN2(*end, length);
+}
@@ -38,6 +38,14 @@ class G1FullGCCompactionPoint : public CHeapObj<mtGC> {
   GrowableArray<HeapRegion*>* _compaction_regions;
   GrowableArrayIterator<HeapRegion*> _compaction_region_iterator;
 
+  // The compaction regions are split into chains: no object is forwarded from
+  // one chain into another, so chains can be compacted independently. These
+  // are the indices into _compaction_regions where the second and later
+  // chains start.
+  GrowableArray<int>* _chain_starts;
+  // Words forwarded since the current chain was started.
+  size_t _chain_live_words;
+
   bool object_will_fit(size_t size);
   void initialize_values(bool init_threshold);
   void switch_region();
@@ -58,6 +66,17 @@ public:
   HeapRegion* remove_last();
   HeapRegion* current_region();
 
+  // Start a new chain with hr, which must be the region added last, by
+  // forwarding the following objects into hr instead of the current region.
+  // Returns the number of regions skipped over, which will be empty after
+  // compaction.
+  uint start_new_chain(HeapRegion* hr);
+  size_t chain_live_words() const { return _chain_live_words; }
+
+  uint num_chains();
+  // Returns the range [start, end) of compaction region indices of the chain.
+  void chain_bounds(uint chain, int* start, int* end);
+
   GrowableArray<HeapRegion*>* regions();
 };
 
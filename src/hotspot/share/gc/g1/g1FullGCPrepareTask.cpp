@@ -97,7 +97,8 @@ G1FullGCPrepareTask::G1CalculatePointersClosure::G1CalculatePointersClosure(G1CM
     _g1h(G1CollectedHeap::heap()),
     _bitmap(bitmap),
     _cp(cp),
-    _humongous_regions_removed(0) { }
+    _humongous_regions_removed(0),
+    _chain_freed_regions(false) { }
 
 void G1FullGCPrepareTask::G1CalculatePointersClosure::free_humongous_region(HeapRegion* hr) {
   FreeRegionList dummy_free_list("Dummy Free List for G1MarkSweep");
@@ -150,6 +151,14 @@ void G1FullGCPrepareTask::G1CalculatePointersClosure::prepare_for_compaction_wor
   hr->apply_to_marked_objects(_bitmap, &prepare_compact);
 }
 
+// Objects are never forwarded from one chain of compaction regions into
+// another, so the compaction phase distributes work by chains. Starting a new
+// chain wastes on average half a region; chains of this amount of live data
+// keep that waste at about half of G1HeapWastePercent.
+static size_t compaction_chain_target_words() {
+  return HeapRegion::GrainWords * (100 / MAX2(G1HeapWastePercent, (uintx)1));
+}
+
 void G1FullGCPrepareTask::G1CalculatePointersClosure::prepare_for_compaction(HeapRegion* hr) {
   if (!_cp->is_initialized()) {
     hr->set_compaction_top(hr->bottom());
@@ -157,6 +166,11 @@ void G1FullGCPrepareTask::G1CalculatePointersClosure::prepare_for_compaction(Hea
   }
   // Add region to the compaction queue and prepare it.
   _cp->add(hr);
+  if (_cp->chain_live_words() >= compaction_chain_target_words()) {
+    if (_cp->start_new_chain(hr) > 0) {
+      _chain_freed_regions = true;
+    }
+  }
   prepare_for_compaction_work(_cp, hr);
 }
 
@@ -204,6 +218,11 @@ bool G1FullGCPrepareTask::G1CalculatePointersClosure::freed_regions() {
     return true;
   }
 
+  if (_chain_freed_regions) {
+    // Regions skipped when starting a new compaction chain are free.
+    return true;
+  }
+
   if (!_cp->has_regions()) {
     // No regions in queue, so no free ones either.
     return false;
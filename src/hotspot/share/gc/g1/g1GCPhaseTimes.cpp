@@ -136,6 +136,9 @@ G1GCPhaseTimes::G1GCPhaseTimes(STWGCTimer* gc_timer, uint max_gc_threads) :
 void G1GCPhaseTimes::reset() {
   _cur_collection_par_time_ms = 0.0;
   _cur_optional_evac_ms = 0.0;
+  _cur_optional_evac_increments = 0;
+  _cur_optional_evac_predicted_ms = 0.0;
+  _cur_optional_evac_increments_ms = 0.0;
   _cur_collection_code_root_fixup_time_ms = 0.0;
   _cur_strong_code_root_purge_time_ms = 0.0;
   _cur_evac_fail_recalc_used = 0.0;
@@ -372,6 +375,9 @@ double G1GCPhaseTimes::print_evacuate_optional_collection_set() const {
   const double sum_ms = _cur_optional_evac_ms;
   if (sum_ms > 0) {
     info_time("Evacuate Optional Collection Set", sum_ms);
+    trace_count("Increments", _cur_optional_evac_increments);
+    trace_time("Predicted Increments Time", _cur_optional_evac_predicted_ms);
+    trace_time("Actual Increments Time", _cur_optional_evac_increments_ms);
     debug_phase(_gc_par_phases[OptScanRS]);
     debug_phase(_gc_par_phases[OptObjCopy]);
   }
@@ -133,6 +133,11 @@ class G1GCPhaseTimes : public CHeapObj<mtGC> {
 
   double _cur_collection_par_time_ms;
   double _cur_optional_evac_ms;
+  // Number of optional evacuation increments in this pause, and their
+  // total predicted and actual time.
+  uint _cur_optional_evac_increments;
+  double _cur_optional_evac_predicted_ms;
+  double _cur_optional_evac_increments_ms;
   double _cur_collection_code_root_fixup_time_ms;
   double _cur_strong_code_root_purge_time_ms;
 
@@ -261,6 +266,14 @@ class G1GCPhaseTimes : public CHeapObj<mtGC> {
     _cur_optional_evac_ms = ms;
   }
 
+  void record_optional_evacuation_increment(double predicted_ms, double ms) {
+    _cur_optional_evac_increments++;
+    _cur_optional_evac_predicted_ms += predicted_ms;
+    _cur_optional_evac_increments_ms += ms;
+  }
+
+  uint optional_evacuation_increments() const { return _cur_optional_evac_increments; }
+
   void record_code_root_fixup_time(double ms) {
     _cur_collection_code_root_fixup_time_ms = ms;
   }
@@ -26,6 +26,7 @@
 #include "gc/g1/g1CollectedHeap.hpp"
 #include "gc/g1/g1HeapTransition.hpp"
 #include "gc/g1/g1Policy.hpp"
+#include "gc/g1/heterogeneousHeapRegionManager.hpp"
 #include "logging/log.hpp"
 #include "memory/metaspace.hpp"
 
@@ -36,6 +37,14 @@ G1HeapTransition::Data::Data(G1CollectedHeap* g1_heap) {
   _archive_length = g1_heap->archive_regions_count();
   _humongous_length = g1_heap->humongous_regions_count();
   _metaspace_used_bytes = MetaspaceUtils::used_bytes();
+  if (g1_heap->g1_collector_policy()->is_hetero_heap()) {
+    HeterogeneousHeapRegionManager* manager = HeterogeneousHeapRegionManager::manager();
+    _regions_migrated_to_dram = manager->num_regions_migrated_to_dram();
+    _regions_migrated_to_nvdimm = manager->num_regions_migrated_to_nvdimm();
+  } else {
+    _regions_migrated_to_dram = 0;
+    _regions_migrated_to_nvdimm = 0;
+  }
 }
 
 G1HeapTransition::G1HeapTransition(G1CollectedHeap* g1_heap) : _g1_heap(g1_heap), _before(g1_heap) { }
@@ -121,6 +130,12 @@ void G1HeapTransition::print() {
   log_trace(gc, heap)(" Used: " SIZE_FORMAT "K, Waste: " SIZE_FORMAT "K",
       usage._old_used / K, ((after._old_length * HeapRegion::GrainBytes) - usage._old_used) / K);
 
+  if (_g1_heap->g1_collector_policy()->is_hetero_heap()) {
+    log_info(gc, heap)("Old regions migrated: " SIZE_FORMAT " to dram, " SIZE_FORMAT " to nv-dimm",
+                       after._regions_migrated_to_dram - _before._regions_migrated_to_dram,
+                       after._regions_migrated_to_nvdimm - _before._regions_migrated_to_nvdimm);
+  }
+
   log_info(gc, heap)("Archive regions: " SIZE_FORMAT "->" SIZE_FORMAT,
                      _before._archive_length, after._archive_length);
   log_trace(gc, heap)(" Used: " SIZE_FORMAT "K, Waste: " SIZE_FORMAT "K",
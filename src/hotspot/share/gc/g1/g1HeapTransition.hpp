@@ -37,6 +37,9 @@ class G1HeapTransition {
     size_t _archive_length;
     size_t _humongous_length;
     size_t _metaspace_used_bytes;
+    // Number of old regions migrated between dram and nv-dimm on heterogeneous heaps.
+    size_t _regions_migrated_to_dram;
+    size_t _regions_migrated_to_nvdimm;
 
     Data(G1CollectedHeap* g1_heap);
   };
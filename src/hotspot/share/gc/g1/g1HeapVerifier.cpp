@@ -705,6 +705,38 @@ void G1HeapVerifier::verify_dirty_young_regions() {
   _g1h->collection_set()->iterate(&cl);
 }
 
+void G1HeapVerifier::verify_humongous_reclaim_candidate(HeapRegion* hr) {
+  guarantee(hr->is_starts_humongous(),
+            "Humongous reclaim candidate region %u must start a humongous object but is %s",
+            hr->hrm_index(), hr->get_type_str());
+  guarantee(hr->rem_set()->is_complete(),
+            "Humongous reclaim candidate region %u must have a complete remembered set but is %s",
+            hr->hrm_index(), hr->rem_set()->get_state_str());
+  oop obj = oop(hr->bottom());
+  if (obj->is_objArray()) {
+    // An object array allocated before the start of marking might still need to
+    // have its references scanned, or be on the mark stack.
+    guarantee(!_g1h->collector_state()->mark_or_rebuild_in_progress() ||
+              hr->next_top_at_mark_start() == hr->bottom(),
+              "Humongous reclaim candidate region %u contains an object array allocated before "
+              "the start of marking (ntams " PTR_FORMAT ")",
+              hr->hrm_index(), p2i(hr->next_top_at_mark_start()));
+  } else {
+    guarantee(obj->is_typeArray(),
+              "Humongous reclaim candidate region %u must contain an array", hr->hrm_index());
+  }
+}
+
+void G1HeapVerifier::verify_eagerly_reclaimed_region(HeapRegion* hr) {
+  guarantee(hr->is_free(), "Eagerly reclaimed region %u must be free but is %s",
+            hr->hrm_index(), hr->get_type_str());
+  guarantee(hr->rem_set()->is_empty(), "Eagerly reclaimed region %u must have an empty remembered set",
+            hr->hrm_index());
+  if (G1VerifyCTCleanup || VerifyAfterGC) {
+    verify_not_dirty_region(hr);
+  }
+}
+
 bool G1HeapVerifier::verify_no_bits_over_tams(const char* bitmap_name, const G1CMBitMap* const bitmap,
                                                HeapWord* tams, HeapWord* end) {
   guarantee(tams <= end,
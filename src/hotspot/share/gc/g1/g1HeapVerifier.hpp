@@ -115,6 +115,11 @@ public:
   void verify_dirty_region(HeapRegion* hr) PRODUCT_RETURN;
   void verify_dirty_young_regions() PRODUCT_RETURN;
 
+  // Verify that the given region may be nominated for eager reclaim.
+  void verify_humongous_reclaim_candidate(HeapRegion* hr) PRODUCT_RETURN;
+  // Verify that no stale state is left over in an eagerly reclaimed region.
+  void verify_eagerly_reclaimed_region(HeapRegion* hr) PRODUCT_RETURN;
+
   static void verify_ready_for_archiving();
   static void verify_archive_regions();
 };
@@ -24,9 +24,12 @@
 
 #include "precompiled.hpp"
 #include "gc/g1/g1CollectedHeap.hpp"
+#include "gc/g1/g1CollectionSet.hpp"
 #include "gc/g1/g1HeterogeneousHeapPolicy.hpp"
 #include "gc/g1/g1Policy.hpp"
+#include "gc/g1/heapRegion.inline.hpp"
 #include "gc/g1/heterogeneousHeapRegionManager.hpp"
+#include "logging/log.hpp"
 
 G1HeterogeneousHeapPolicy::G1HeterogeneousHeapPolicy(G1CollectorPolicy* policy, STWGCTimer* gc_timer) :
   G1Policy(policy, gc_timer), _manager(NULL) {}
@@ -41,6 +44,7 @@ void G1HeterogeneousHeapPolicy::init(G1CollectedHeap* g1h, G1CollectionSet* coll
 // After a collection pause, young list target length is updated. So we need to make sure we have enough regions in dram for young gen.
 void G1HeterogeneousHeapPolicy::record_collection_pause_end(double pause_time_ms, size_t cards_scanned, size_t heap_used_bytes_before_gc) {
   G1Policy::record_collection_pause_end(pause_time_ms, cards_scanned, heap_used_bytes_before_gc);
+  _manager->set_allocate_old_in_dram(false, 0);
   _manager->adjust_dram_regions((uint)young_list_target_length(), G1CollectedHeap::heap()->workers());
 }
 
@@ -50,6 +54,66 @@ void G1HeterogeneousHeapPolicy::record_full_collection_end() {
   _manager->adjust_dram_regions((uint)young_list_target_length(), G1CollectedHeap::heap()->workers());
 }
 
+// Sample the region temperatures before the collection set candidates for the following mixed gcs are determined.
+void G1HeterogeneousHeapPolicy::record_concurrent_mark_cleanup_end() {
+  if (G1HeterogeneousHotOldPlacement) {
+    _manager->sample_region_temperatures(G1CollectedHeap::heap()->workers());
+  }
+  G1Policy::record_concurrent_mark_cleanup_end();
+}
+
+void G1HeterogeneousHeapPolicy::finalize_collection_set(double target_pause_time_ms, G1SurvivorRegions* survivor) {
+  G1Policy::finalize_collection_set(target_pause_time_ms, survivor);
+  if (G1HeterogeneousHotOldPlacement && G1CollectedHeap::heap()->collection_set()->old_region_length() > 0) {
+    select_old_region_placement();
+  }
+}
+
+class G1OldRegionTemperatureClosure : public HeapRegionClosure {
+  HeterogeneousHeapRegionManager* _manager;
+public:
+  size_t _hot_live_bytes;
+  size_t _cold_live_bytes;
+  uint _num_in_dram;
+  uint _num_in_nvdimm;
+
+  G1OldRegionTemperatureClosure(HeterogeneousHeapRegionManager* manager) :
+    _manager(manager), _hot_live_bytes(0), _cold_live_bytes(0), _num_in_dram(0), _num_in_nvdimm(0) { }
+
+  bool do_heap_region(HeapRegion* hr) {
+    if (!hr->is_old()) {
+      return false;
+    }
+    if (_manager->is_hot(hr->hrm_index())) {
+      _hot_live_bytes += hr->live_bytes();
+    } else {
+      _cold_live_bytes += hr->live_bytes();
+    }
+    if (_manager->is_in_dram(hr)) {
+      _num_in_dram++;
+    } else {
+      _num_in_nvdimm++;
+    }
+    return false;
+  }
+};
+
+// Old regions in the collection set are evacuated into the same kind of memory, so place them where
+// the majority of their live data should go. Regions in the collection set coming from the other
+// kind of memory are migrated.
+void G1HeterogeneousHeapPolicy::select_old_region_placement() {
+  G1OldRegionTemperatureClosure cl(_manager);
+  G1CollectedHeap::heap()->collection_set()->iterate(&cl);
+
+  bool in_dram = cl._hot_live_bytes > cl._cold_live_bytes;
+  _manager->set_allocate_old_in_dram(in_dram, max_survivor_regions());
+  in_dram = _manager->allocate_old_in_dram();
+  _manager->record_migrations(in_dram ? cl._num_in_nvdimm : 0, in_dram ? 0 : cl._num_in_dram);
+
+  log_debug(gc, ergo, heap)("Place old regions in %s (hot live: " SIZE_FORMAT "B cold live: " SIZE_FORMAT "B)",
+                            in_dram ? "dram" : "nv-dimm", cl._hot_live_bytes, cl._cold_live_bytes);
+}
+
 bool G1HeterogeneousHeapPolicy::force_upgrade_to_full() {
   if (_manager->has_borrowed_regions()) {
     return true;
@@ -33,6 +33,10 @@ class G1HeterogeneousHeapPolicy : public G1Policy {
   // Stash a pointer to the hrm.
   HeterogeneousHeapRegionManager* _manager;
 
+  // Decide whether old regions allocated during this pause are placed in dram,
+  // depending on the temperature of the old regions in the collection set.
+  void select_old_region_placement();
+
 public:
   G1HeterogeneousHeapPolicy(G1CollectorPolicy* policy, STWGCTimer* gc_timer);
 
@@ -42,6 +46,10 @@ public:
   virtual void record_collection_pause_end(double pause_time_ms, size_t cards_scanned, size_t heap_used_bytes_before_gc);
   // Record the end of full collection.
   virtual void record_full_collection_end();
+  // Record the end of the marking cycle.
+  virtual void record_concurrent_mark_cleanup_end();
+
+  virtual void finalize_collection_set(double target_pause_time_ms, G1SurvivorRegions* survivor);
 
   virtual bool force_upgrade_to_full();
 };
@@ -113,3 +113,7 @@ void G1HotCardCache::drain(G1CardTableEntryClosure* cl, uint worker_i) {
 void G1HotCardCache::reset_card_counts(HeapRegion* hr) {
   _card_counts.clear_region(hr);
 }
+
+size_t G1HotCardCache::sum_card_counts(HeapRegion* hr) {
+  return _card_counts.sum_card_counts(hr);
+}
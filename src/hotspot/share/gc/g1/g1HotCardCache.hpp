@@ -130,6 +130,10 @@ class G1HotCardCache: public CHeapObj<mtGC> {
   // Zeros the values in the card counts table for the given region
   void reset_card_counts(HeapRegion* hr);
 
+  // Returns the sum of the values in the card counts table for the given
+  // region, leaving them as they are for the hot card cache
+  size_t sum_card_counts(HeapRegion* hr);
+
  private:
   void reset_hot_cache_internal() {
     assert(_hot_cache != NULL, "Logic");
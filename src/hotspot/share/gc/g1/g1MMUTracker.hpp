@@ -62,6 +62,10 @@ public:
     return _max_gc_time;
   }
 
+  double time_slice() const {
+    return _time_slice;
+  }
+
   inline bool now_max_gc(double current_time) {
     return when_sec(current_time, max_gc_time()) < 0.00001;
   }
@@ -29,6 +29,8 @@
 #include "gc/g1/g1MemoryPool.hpp"
 #include "gc/shared/hSpaceCounters.hpp"
 #include "memory/metaspaceCounters.hpp"
+#include "memory/resourceArea.hpp"
+#include "runtime/perfData.hpp"
 #include "services/memoryPool.hpp"
 
 class G1GenerationCounters : public GenerationCounters {
@@ -100,6 +102,8 @@ G1MonitoringSupport::G1MonitoringSupport(G1CollectedHeap* g1h) :
   _eden_space_counters(NULL),
   _from_space_counters(NULL),
   _to_space_counters(NULL),
+  _rebuild_remset_regions_counter(NULL),
+  _rebuild_remset_bytes_counter(NULL),
 
   _overall_committed(0),
   _overall_used(0),
@@ -129,6 +133,20 @@ G1MonitoringSupport::G1MonitoringSupport(G1CollectedHeap* g1h) :
   _conc_collection_counters =
     new CollectorCounters("G1 concurrent cycle pauses", 2);
 
+  if (UsePerfData) {
+    EXCEPTION_MARK;
+    ResourceMark rm;
+    const char* name_space = _conc_collection_counters->name_space();
+    //  name "collector.2.rebuildRemSetRegions"
+    const char* cname = PerfDataManager::counter_name(name_space, "rebuildRemSetRegions");
+    _rebuild_remset_regions_counter =
+      PerfDataManager::create_variable(SUN_GC, cname, PerfData::U_Events, CHECK);
+    //  name "collector.2.rebuildRemSetScannedBytes"
+    cname = PerfDataManager::counter_name(name_space, "rebuildRemSetScannedBytes");
+    _rebuild_remset_bytes_counter =
+      PerfDataManager::create_variable(SUN_GC, cname, PerfData::U_Bytes, CHECK);
+  }
+
   // "Generation" and "Space" counters.
   //
   //  name "generation.1" This is logically the old generation in
@@ -310,6 +328,13 @@ void G1MonitoringSupport::update_eden_size() {
   }
 }
 
+void G1MonitoringSupport::update_rebuild_remset_progress(uint regions, size_t scanned_bytes) {
+  if (UsePerfData) {
+    _rebuild_remset_regions_counter->set_value(regions);
+    _rebuild_remset_bytes_counter->set_value(scanned_bytes);
+  }
+}
+
 MemoryUsage G1MonitoringSupport::eden_space_memory_usage(size_t initial_size, size_t max_size) {
   MutexLockerEx x(MonitoringSupport_lock, Mutex::_no_safepoint_check_flag);
 
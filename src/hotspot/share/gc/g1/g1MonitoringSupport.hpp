@@ -155,6 +155,9 @@ class G1MonitoringSupport : public CHeapObj<mtGC> {
   //   the survivor collection (only one, _to_counters, is actively used)
   HSpaceCounters*      _from_space_counters;
   HSpaceCounters*      _to_space_counters;
+  // Progress of the current or last remembered set rebuild phase
+  PerfVariable*        _rebuild_remset_regions_counter;
+  PerfVariable*        _rebuild_remset_bytes_counter;
 
   // When it's appropriate to recalculate the various sizes (at the
   // end of a GC, when a new eden region is allocated, etc.) we store
@@ -225,6 +228,9 @@ public:
 
   void update_eden_size();
 
+  // Update the jstat counters for the progress of remembered set rebuild.
+  void update_rebuild_remset_progress(uint regions, size_t scanned_bytes);
+
   CollectorCounters* conc_collection_counters() {
     return _conc_collection_counters;
   }
@@ -41,6 +41,7 @@
 #include "gc/g1/heapRegion.inline.hpp"
 #include "gc/g1/heapRegionRemSet.hpp"
 #include "gc/shared/gcPolicyCounters.hpp"
+#include "gc/shared/gcTrace.hpp"
 #include "logging/logStream.hpp"
 #include "runtime/arguments.hpp"
 #include "runtime/java.hpp"
@@ -50,7 +51,7 @@
 #include "utilities/pair.hpp"
 
 G1Policy::G1Policy(G1CollectorPolicy* policy, STWGCTimer* gc_timer) :
-  _predictor(G1ConfidencePercent / 100.0),
+  _predictor(G1ConfidencePercent / 100.0, G1Predictor::create()),
   _analytics(new G1Analytics(&_predictor)),
   _remset_tracker(),
   _mmu_tracker(new G1MMUTrackerQueue(GCPauseIntervalMillis / 1000.0, MaxGCPauseMillis / 1000.0)),
@@ -650,6 +651,16 @@ void G1Policy::record_collection_pause_end(double pause_time_ms, size_t cards_sc
   double scan_hcc_time_ms = G1HotCardCache::default_use_cache() ? average_time_ms(G1GCPhaseTimes::ScanHCC) : 0.0;
 
   if (update_stats) {
+    size_t freed_bytes = heap_used_bytes_before_gc - cur_used_bytes;
+    size_t copied_bytes = _collection_set->bytes_used_before() - freed_bytes;
+
+    // Predict the phase times for the actual amount of work done before the
+    // analytics learn from this pause.
+    double predicted_update_rs_time_ms = _analytics->predict_rs_update_time_ms(_pending_cards);
+    double predicted_scan_rs_time_ms = _analytics->predict_rs_scan_time_ms(cards_scanned, this_pause_was_young_only);
+    double predicted_object_copy_time_ms =
+      _analytics->predict_object_copy_time_ms(copied_bytes, collector_state()->mark_or_rebuild_in_progress());
+
     double cost_per_card_ms = 0.0;
     if (_pending_cards > 0) {
       cost_per_card_ms = (average_time_ms(G1GCPhaseTimes::UpdateRS)) / (double) _pending_cards;
@@ -689,8 +700,6 @@ void G1Policy::record_collection_pause_end(double pause_time_ms, size_t cards_sc
     }
     _analytics->report_rs_length_diff((double) rs_length_diff);
 
-    size_t freed_bytes = heap_used_bytes_before_gc - cur_used_bytes;
-    size_t copied_bytes = _collection_set->bytes_used_before() - freed_bytes;
     double cost_per_byte_ms = 0.0;
 
     if (copied_bytes > 0) {
@@ -718,6 +727,16 @@ void G1Policy::record_collection_pause_end(double pause_time_ms, size_t cards_sc
       _analytics->report_pending_cards((double) _pending_cards);
       _analytics->report_rs_lengths((double) _max_rs_lengths);
     }
+
+    _g1h->gc_tracer_stw()->report_pause_prediction(_predictor.predictor()->name(),
+                                                   _collection_set->predicted_pause_time_ms(),
+                                                   pause_time_ms,
+                                                   predicted_update_rs_time_ms,
+                                                   average_time_ms(G1GCPhaseTimes::UpdateRS),
+                                                   predicted_scan_rs_time_ms,
+                                                   average_time_ms(G1GCPhaseTimes::ScanRS),
+                                                   predicted_object_copy_time_ms,
+                                                   average_time_ms(G1GCPhaseTimes::ObjCopy));
   }
 
   assert(!(this_pause_included_initial_mark && collector_state()->mark_or_rebuild_in_progress()),
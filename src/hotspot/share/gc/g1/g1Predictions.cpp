@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#include "precompiled.hpp"
+#include "gc/g1/g1Predictions.hpp"
+#include "runtime/globals.hpp"
+#include "runtime/java.hpp"
+#include "utilities/globalDefinitions.hpp"
+
+// A change is detected if the average of the recent samples differs from the
+// average of the older samples by more than this many standard deviations of
+// the older samples.
+static const double ChangeThresholdStddevs = 3.0;
+// Lower bound for the standard deviation used for detection, relative to the
+// average of the older samples, to ignore small changes of very stable sequences.
+static const double MinRelativeStddev = 0.05;
+
+static void avg_and_stddev(TruncatedSeq const* seq, int from, int to, double* avg, double* stddev) {
+  double sum = 0.0;
+  for (int i = from; i < to; i++) {
+    sum += seq->recent(i);
+  }
+  *avg = sum / (to - from);
+
+  double sum_of_squares = 0.0;
+  for (int i = from; i < to; i++) {
+    double diff = seq->recent(i) - *avg;
+    sum_of_squares += diff * diff;
+  }
+  *stddev = sqrt(sum_of_squares / (to - from));
+}
+
+void G1ChangePointPredictor::predict(TruncatedSeq const* seq, double* avg, double* stddev) const {
+  int const samples = seq->num_recent();
+  if (samples < RecentSamples + MinOlderSamples) {
+    G1DecayingAveragePredictor::predict(seq, avg, stddev);
+    return;
+  }
+
+  double recent_avg;
+  double recent_stddev;
+  avg_and_stddev(seq, 0, RecentSamples, &recent_avg, &recent_stddev);
+  double older_avg;
+  double older_stddev;
+  avg_and_stddev(seq, RecentSamples, samples, &older_avg, &older_stddev);
+
+  double threshold = ChangeThresholdStddevs * MAX2(older_stddev, MinRelativeStddev * fabs(older_avg));
+  if (fabs(recent_avg - older_avg) > threshold) {
+    // The sequence changed its level; the recent samples are not enough to
+    // judge its variability yet, so keep at least the old one.
+    *avg = recent_avg;
+    *stddev = MAX2(recent_stddev, older_stddev);
+  } else {
+    G1DecayingAveragePredictor::predict(seq, avg, stddev);
+  }
+}
+
+G1Predictor* G1Predictor::create() {
+  if (strcmp(G1PredictionModel, "decaying-average") == 0) {
+    return new G1DecayingAveragePredictor();
+  } else if (strcmp(G1PredictionModel, "change-point") == 0) {
+    return new G1ChangePointPredictor();
+  }
+  vm_exit_during_initialization("Unknown -XX:G1PredictionModel option", G1PredictionModel);
+  return NULL;
+}
+
+G1Predictions::G1Predictions(double sigma, G1Predictor* predictor) :
+  _sigma(sigma),
+  _predictor(predictor != NULL ? predictor : new G1DecayingAveragePredictor()) {
+  assert(sigma >= 0.0, "Confidence must be larger than or equal to zero");
+}
+
+G1Predictions::~G1Predictions() {
+  delete _predictor;
+}
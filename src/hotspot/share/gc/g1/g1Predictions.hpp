@@ -25,20 +25,34 @@
 #ifndef SHARE_GC_G1_G1PREDICTIONS_HPP
 #define SHARE_GC_G1_G1PREDICTIONS_HPP
 
+#include "memory/allocation.hpp"
 #include "utilities/numberSeq.hpp"
 
-// Utility class containing various helper methods for prediction.
-class G1Predictions {
- private:
-  double _sigma;
+// Interface for models predicting the next value of a sequence of samples.
+class G1Predictor : public CHeapObj<mtGC> {
+ public:
+  virtual ~G1Predictor() { }
+
+  virtual const char* name() const = 0;
 
+  // Estimate the average and standard deviation of the next value of the
+  // given sequence.
+  virtual void predict(TruncatedSeq const* seq, double* avg, double* stddev) const = 0;
+
+  // Create the predictor selected by G1PredictionModel.
+  static G1Predictor* create();
+};
+
+// Predicts the decaying average and decaying standard deviation of the
+// sequence.
+class G1DecayingAveragePredictor : public G1Predictor {
   // This function is used to estimate the stddev of sample sets. There is some
   // special consideration of small sample sets: the actual stddev for them is
   // not very useful, so we calculate some value based on the sample average.
   // Five or more samples yields zero (at that point we use the stddev); fewer
   // scale the sample set average linearly from two times the average to 0.5 times
   // it.
-  double stddev_estimate(TruncatedSeq const* seq) const {
+  static double stddev_estimate(TruncatedSeq const* seq) {
     double estimate = seq->dsd();
     int const samples = seq->num();
     if (samples < 5) {
@@ -47,15 +61,54 @@ class G1Predictions {
     return estimate;
   }
  public:
-  G1Predictions(double sigma) : _sigma(sigma) {
-    assert(sigma >= 0.0, "Confidence must be larger than or equal to zero");
+  virtual const char* name() const { return "decaying-average"; }
+
+  virtual void predict(TruncatedSeq const* seq, double* avg, double* stddev) const {
+    *avg = seq->davg();
+    *stddev = stddev_estimate(seq);
   }
+};
+
+// Like G1DecayingAveragePredictor, but detects sudden shifts of the level of
+// the sequence. If the most recent samples deviate significantly from the
+// older ones, only the most recent samples are used for prediction instead of
+// waiting for the decaying average to catch up.
+class G1ChangePointPredictor : public G1DecayingAveragePredictor {
+ public:
+  // Number of most recent samples compared against the older samples.
+  static const int RecentSamples = 3;
+  // Minimum number of older samples required to detect a change.
+  static const int MinOlderSamples = 3;
+
+  virtual const char* name() const { return "change-point"; }
+
+  virtual void predict(TruncatedSeq const* seq, double* avg, double* stddev) const;
+};
+
+// Utility class containing various helper methods for prediction.
+class G1Predictions {
+ private:
+  double _sigma;
+  G1Predictor* _predictor;
+
+  // Not copyable, owns _predictor.
+  G1Predictions(const G1Predictions&);
+  G1Predictions& operator=(const G1Predictions&);
+ public:
+  // Takes ownership of predictor; uses a G1DecayingAveragePredictor if NULL.
+  G1Predictions(double sigma, G1Predictor* predictor = NULL);
+  ~G1Predictions();
 
   // Confidence factor.
   double sigma() const { return _sigma; }
 
+  const G1Predictor* predictor() const { return _predictor; }
+
   double get_new_prediction(TruncatedSeq const* seq) const {
-    return seq->davg() + _sigma * stddev_estimate(seq);
+    double avg;
+    double stddev;
+    _predictor->predict(seq, &avg, &stddev);
+    return avg + _sigma * stddev;
   }
 };
 
@@ -32,12 +32,16 @@
 #include "gc/g1/g1FromCardCache.hpp"
 #include "gc/g1/g1GCPhaseTimes.hpp"
 #include "gc/g1/g1HotCardCache.hpp"
+#include "gc/g1/g1MMUTracker.hpp"
+#include "gc/g1/g1MonitoringSupport.hpp"
 #include "gc/g1/g1OopClosures.inline.hpp"
+#include "gc/g1/g1Policy.hpp"
 #include "gc/g1/g1RootClosures.hpp"
 #include "gc/g1/g1RemSet.hpp"
 #include "gc/g1/heapRegion.inline.hpp"
 #include "gc/g1/heapRegionManager.inline.hpp"
 #include "gc/g1/heapRegionRemSet.hpp"
+#include "gc/shared/gcId.hpp"
 #include "gc/shared/gcTraceTime.inline.hpp"
 #include "gc/shared/suspendibleThreadSet.hpp"
 #include "jfr/jfrEvents.hpp"
@@ -46,6 +50,7 @@
 #include "oops/access.inline.hpp"
 #include "oops/oop.inline.hpp"
 #include "runtime/os.hpp"
+#include "runtime/prefetch.inline.hpp"
 #include "utilities/align.hpp"
 #include "utilities/globalDefinitions.hpp"
 #include "utilities/intHisto.hpp"
@@ -551,10 +556,7 @@ inline void check_card_ptr(jbyte* card_ptr, G1CardTable* ct) {
 #endif
 }
 
-void G1RemSet::refine_card_concurrently(jbyte* card_ptr,
-                                        uint worker_i) {
-  assert(!_g1h->is_gc_active(), "Only call concurrently");
-
+HeapRegion* G1RemSet::region_for_refinement(jbyte* card_ptr) {
   // Construct the region representing the card.
   HeapWord* start = _ct->addr_for(card_ptr);
   // And find the region containing it.
@@ -562,14 +564,14 @@ void G1RemSet::refine_card_concurrently(jbyte* card_ptr,
 
   // If this is a (stale) card into an uncommitted region, exit.
   if (r == NULL) {
-    return;
+    return NULL;
   }
 
   check_card_ptr(card_ptr, _ct);
 
   // If the card is no longer dirty, nothing to do.
   if (*card_ptr != G1CardTable::dirty_card_val()) {
-    return;
+    return NULL;
   }
 
   // This check is needed for some uncommon cases where we should
@@ -592,6 +594,17 @@ void G1RemSet::refine_card_concurrently(jbyte* card_ptr,
   // enqueueing of the card and processing it here will have ensured
   // we see the up-to-date region type here.
   if (!r->is_old_or_humongous_or_archive()) {
+    return NULL;
+  }
+  return r;
+}
+
+void G1RemSet::refine_card_concurrently(jbyte* card_ptr,
+                                        uint worker_i) {
+  assert(!_g1h->is_gc_active(), "Only call concurrently");
+
+  HeapRegion* r = region_for_refinement(card_ptr);
+  if (r == NULL) {
     return;
   }
 
@@ -614,8 +627,7 @@ void G1RemSet::refine_card_concurrently(jbyte* card_ptr,
       return;
     } else if (card_ptr != orig_card_ptr) {
       // Original card was inserted and an old card was evicted.
-      start = _ct->addr_for(card_ptr);
-      r = _g1h->heap_region_containing(start);
+      r = _g1h->heap_region_containing(_ct->addr_for(card_ptr));
 
       // Check whether the region formerly in the cache should be
       // ignored, as discussed earlier for the original card.  The
@@ -626,8 +638,80 @@ void G1RemSet::refine_card_concurrently(jbyte* card_ptr,
     } // Else we still have the original card.
   }
 
-  // Trim the region designated by the card to what's been allocated
-  // in the region.  The card could be stale, or the card could cover
+  refine_cards_in_region(r, card_ptr, card_ptr, worker_i);
+}
+
+size_t G1RemSet::refine_cards_concurrently(jbyte** card_ptrs,
+                                           size_t num_cards,
+                                           uint worker_i) {
+  assert(!_g1h->is_gc_active(), "Only call concurrently");
+
+  // The current run of adjacent cards within a single region.
+  HeapRegion* run_region = NULL;
+  jbyte* run_first = NULL;
+  jbyte* run_last = NULL;
+
+  size_t i = 0;
+  for (; i < num_cards; i++) {
+    if (SuspendibleThreadSet::should_yield()) {
+      // Caller will actually yield.
+      break;
+    }
+    if (i + RefinementPrefetchDistance < num_cards) {
+      jbyte* prefetch_card = card_ptrs[i + RefinementPrefetchDistance];
+      Prefetch::read(prefetch_card, 0);
+      _g1h->bot()->prefetch(_ct->addr_for(prefetch_card));
+    }
+
+    jbyte* card_ptr = card_ptrs[i];
+    assert(i == 0 || card_ptrs[i - 1] < card_ptr, "Cards must be sorted and unique");
+    HeapRegion* r = region_for_refinement(card_ptr);
+    if (r == NULL) {
+      continue;
+    }
+
+    // See refine_card_concurrently() for a description of the hot card cache
+    // results. Evicted cards are refined on their own.
+    if (_hot_card_cache->use_cache()) {
+      jbyte* orig_card_ptr = card_ptr;
+      card_ptr = _hot_card_cache->insert(card_ptr);
+      if (card_ptr == NULL) {
+        continue;
+      } else if (card_ptr != orig_card_ptr) {
+        HeapRegion* evicted_r = _g1h->heap_region_containing(_ct->addr_for(card_ptr));
+        if (evicted_r->is_old_or_humongous_or_archive()) {
+          refine_cards_in_region(evicted_r, card_ptr, card_ptr, worker_i);
+        }
+        continue;
+      }
+    }
+
+    if (r == run_region && card_ptr == run_last + 1) {
+      run_last = card_ptr;
+      continue;
+    }
+    if (run_region != NULL) {
+      refine_cards_in_region(run_region, run_first, run_last, worker_i);
+    }
+    run_region = r;
+    run_first = card_ptr;
+    run_last = card_ptr;
+  }
+  if (run_region != NULL) {
+    refine_cards_in_region(run_region, run_first, run_last, worker_i);
+  }
+  return i;
+}
+
+void G1RemSet::refine_cards_in_region(HeapRegion* r,
+                                      jbyte* first_card_ptr,
+                                      jbyte* last_card_ptr,
+                                      uint worker_i) {
+  assert(first_card_ptr <= last_card_ptr, "Invalid card range");
+  HeapWord* start = _ct->addr_for(first_card_ptr);
+
+  // Trim the region designated by the cards to what's been allocated
+  // in the region.  The cards could be stale, or the cards could cover
   // (part of) an object at the end of the allocated space and extend
   // beyond the end of allocation.
 
@@ -644,11 +728,15 @@ void G1RemSet::refine_card_concurrently(jbyte* card_ptr,
     // If the trimmed region is empty, the card must be stale.
     return;
   }
+  // Cards of the range beyond scan_limit must be stale too; leave them alone.
+  last_card_ptr = MIN2(last_card_ptr, _ct->byte_for(scan_limit - 1));
 
-  // Okay to clean and process the card now.  There are still some
+  // Okay to clean and process the cards now.  There are still some
   // stale card cases that may be detected by iteration and dealt with
   // as iteration failure.
-  *const_cast<volatile jbyte*>(card_ptr) = G1CardTable::clean_card_val();
+  for (jbyte* card_ptr = first_card_ptr; card_ptr <= last_card_ptr; card_ptr++) {
+    *const_cast<volatile jbyte*>(card_ptr) = G1CardTable::clean_card_val();
+  }
 
   // This fence serves two purposes.  First, the card must be cleaned
   // before processing the contents.  Second, we can't proceed with
@@ -658,9 +746,9 @@ void G1RemSet::refine_card_concurrently(jbyte* card_ptr,
   // both set, in any order, to proceed.
   OrderAccess::fence();
 
-  // Don't use addr_for(card_ptr + 1) which can ask for
+  // Don't use addr_for(last_card_ptr + 1) which can ask for
   // a card beyond the heap.
-  HeapWord* end = start + G1CardTable::card_size_in_words;
+  HeapWord* end = _ct->addr_for(last_card_ptr) + G1CardTable::card_size_in_words;
   MemRegion dirty_region(start, MIN2(scan_limit, end));
   assert(!dirty_region.is_empty(), "sanity");
 
@@ -669,24 +757,27 @@ void G1RemSet::refine_card_concurrently(jbyte* card_ptr,
   bool card_processed =
     r->oops_on_card_seq_iterate_careful<false>(dirty_region, &conc_refine_cl);
 
-  // If unable to process the card then we encountered an unparsable
+  // If unable to process the cards then we encountered an unparsable
   // part of the heap (e.g. a partially allocated object) while
-  // processing a stale card.  Despite the card being stale, redirty
-  // and re-enqueue, because we've already cleaned the card.  Without
+  // processing a stale card.  Despite the cards being stale, redirty
+  // and re-enqueue, because we've already cleaned the cards.  Without
   // this we could incorrectly discard a non-stale card.
   if (!card_processed) {
-    // The card might have gotten re-dirtied and re-enqueued while we
-    // worked.  (In fact, it's pretty likely.)
-    if (*card_ptr != G1CardTable::dirty_card_val()) {
-      *card_ptr = G1CardTable::dirty_card_val();
-      MutexLockerEx x(Shared_DirtyCardQ_lock,
-                      Mutex::_no_safepoint_check_flag);
-      G1DirtyCardQueue* sdcq =
-        G1BarrierSet::dirty_card_queue_set().shared_dirty_card_queue();
-      sdcq->enqueue(card_ptr);
+    MutexLockerEx x(Shared_DirtyCardQ_lock,
+                    Mutex::_no_safepoint_check_flag);
+    G1DirtyCardQueue* sdcq =
+      G1BarrierSet::dirty_card_queue_set().shared_dirty_card_queue();
+    for (jbyte* card_ptr = first_card_ptr; card_ptr <= last_card_ptr; card_ptr++) {
+      // The card might have gotten re-dirtied and re-enqueued while we
+      // worked.  (In fact, it's pretty likely.)
+      if (*card_ptr != G1CardTable::dirty_card_val()) {
+        *card_ptr = G1CardTable::dirty_card_val();
+        sdcq->enqueue(card_ptr);
+      }
     }
   } else {
-    _num_conc_refined_cards++; // Unsynchronized update, only used for logging.
+    // Unsynchronized update, only used for logging.
+    _num_conc_refined_cards += pointer_delta(last_card_ptr, first_card_ptr, sizeof(jbyte)) + 1;
   }
 }
 
@@ -771,6 +862,11 @@ class G1RebuildRemSetTask: public AbstractGangTask {
   class G1RebuildRemSetHeapRegionClosure : public HeapRegionClosure {
     G1ConcurrentMark* _cm;
     G1RebuildRemSetClosure _update_cl;
+    G1RebuildRemSetTask* _task;
+
+    // Pacing state, see throttle().
+    double _start_time_s;
+    double _busy_time_s;
 
     // Applies _update_cl to the references of the given object, limiting objArrays
     // to the given MemRegion. Returns the amount of words actually scanned.
@@ -906,13 +1002,34 @@ class G1RebuildRemSetTask: public AbstractGangTask {
 
       return marked_words * HeapWordSize;
     }
+    // Sleep as long as needed to keep the share of time this thread spends
+    // rebuilding below the duty cycle.
+    void throttle(double busy_time_s) {
+      _busy_time_s += busy_time_s;
+      double duty_cycle = _task->duty_cycle();
+      if (duty_cycle >= 1.0) {
+        return;
+      }
+      double sleep_time_s = _busy_time_s / duty_cycle - (os::elapsedTime() - _start_time_s);
+      jlong sleep_time_ms = (jlong)(sleep_time_s * MILLIUNITS);
+      if (sleep_time_ms > 0) {
+        // Do not hold up safepoints while sleeping.
+        SuspendibleThreadSetLeaver sts_leave;
+        os::sleep(Thread::current(), sleep_time_ms, false);
+        _task->add_throttled_time_ms(sleep_time_ms);
+      }
+    }
 public:
   G1RebuildRemSetHeapRegionClosure(G1CollectedHeap* g1h,
                                    G1ConcurrentMark* cm,
+                                   G1RebuildRemSetTask* task,
                                    uint worker_id) :
     HeapRegionClosure(),
     _cm(cm),
-    _update_cl(g1h, worker_id) { }
+    _update_cl(g1h, worker_id),
+    _task(task),
+    _start_time_s(os::elapsedTime()),
+    _busy_time_s(0.0) { }
 
     bool do_heap_region(HeapRegion* hr) {
       if (_cm->has_aborted()) {
@@ -927,6 +1044,7 @@ public:
              p2i(top_at_rebuild_start_check), p2i(hr->bottom()),  region_idx, hr->get_type_str());
 
       size_t total_marked_bytes = 0;
+      size_t total_scanned_bytes = 0;
       size_t const chunk_size_in_words = G1RebuildRemSetChunkSize / HeapWordSize;
 
       HeapWord* const top_at_mark_start = hr->prev_top_at_mark_start();
@@ -937,7 +1055,7 @@ public:
         // TARS changed due to e.g. eager reclaim.
         HeapWord* const top_at_rebuild_start = _cm->top_at_rebuild_start(region_idx);
         if (top_at_rebuild_start == NULL) {
-          return false;
+          break;
         }
 
         MemRegion next_chunk = MemRegion(hr->bottom(), top_at_rebuild_start).intersection(MemRegion(cur, chunk_size_in_words));
@@ -971,13 +1089,18 @@ public:
         if (marked_bytes > 0) {
           total_marked_bytes += marked_bytes;
         }
+        total_scanned_bytes += next_chunk.byte_size();
         cur += chunk_size_in_words;
 
+        throttle(time.seconds());
         _cm->do_yield_check();
         if (_cm->has_aborted()) {
           return true;
         }
       }
+      if (total_scanned_bytes > 0) {
+        _task->add_rebuilt_region(total_scanned_bytes);
+      }
       // In the final iteration of the loop the region might have been eagerly reclaimed.
       // Simply filter out those regions. We can not just use region type because there
       // might have already been new allocations into these regions.
@@ -997,6 +1120,26 @@ public:
   G1ConcurrentMark* _cm;
 
   uint _worker_id_offset;
+
+  // Maximum share of time each worker may spend rebuilding.
+  double _duty_cycle;
+
+  // Progress information.
+  volatile uint _regions_rebuilt;
+  volatile size_t _scanned_bytes;
+  volatile size_t _throttled_time_ms;
+
+  static double compute_duty_cycle() {
+    if (G1RebuildRemSetDutyCyclePercent != 0) {
+      return G1RebuildRemSetDutyCyclePercent / 100.0;
+    }
+    // Allow the rebuild to use the share of time the MMU goal allows for gc.
+    // A strict goal would let the rebuild drag on for the whole marking
+    // interval, and keep old regions uncollectable meanwhile, so bound it.
+    const double min_duty_cycle = 0.25;
+    const G1MMUTracker* mmu_tracker = G1CollectedHeap::heap()->g1_policy()->mmu_tracker();
+    return MAX2(mmu_tracker->max_gc_time() / mmu_tracker->time_slice(), min_duty_cycle);
+  }
 public:
   G1RebuildRemSetTask(G1ConcurrentMark* cm,
                       uint n_workers,
@@ -1004,7 +1147,11 @@ public:
       AbstractGangTask("G1 Rebuild Remembered Set"),
       _hr_claimer(n_workers),
       _cm(cm),
-      _worker_id_offset(worker_id_offset) {
+      _worker_id_offset(worker_id_offset),
+      _duty_cycle(compute_duty_cycle()),
+      _regions_rebuilt(0),
+      _scanned_bytes(0),
+      _throttled_time_ms(0) {
   }
 
   void work(uint worker_id) {
@@ -1012,9 +1159,25 @@ public:
 
     G1CollectedHeap* g1h = G1CollectedHeap::heap();
 
-    G1RebuildRemSetHeapRegionClosure cl(g1h, _cm, _worker_id_offset + worker_id);
+    G1RebuildRemSetHeapRegionClosure cl(g1h, _cm, this, _worker_id_offset + worker_id);
     g1h->heap_region_par_iterate_from_worker_offset(&cl, &_hr_claimer, worker_id);
   }
+
+  double duty_cycle() const { return _duty_cycle; }
+
+  void add_rebuilt_region(size_t scanned_bytes) {
+    uint regions = Atomic::add(1u, &_regions_rebuilt);
+    size_t bytes = Atomic::add(scanned_bytes, &_scanned_bytes);
+    G1CollectedHeap::heap()->g1mm()->update_rebuild_remset_progress(regions, bytes);
+  }
+
+  void add_throttled_time_ms(size_t time_ms) {
+    Atomic::add(time_ms, &_throttled_time_ms);
+  }
+
+  uint regions_rebuilt() const { return _regions_rebuilt; }
+  size_t scanned_bytes() const { return _scanned_bytes; }
+  size_t throttled_time_ms() const { return _throttled_time_ms; }
 };
 
 void G1RemSet::rebuild_rem_set(G1ConcurrentMark* cm,
@@ -1022,8 +1185,28 @@ void G1RemSet::rebuild_rem_set(G1ConcurrentMark* cm,
                                uint worker_id_offset) {
   uint num_workers = workers->active_workers();
 
+  EventG1RemSetRebuild event;
+  _g1h->g1mm()->update_rebuild_remset_progress(0, 0);
+
   G1RebuildRemSetTask cl(cm,
                          num_workers,
                          worker_id_offset);
   workers->run_task(&cl, num_workers);
+
+  log_debug(gc, remset, tracking)("Rebuilt remembered sets of %u regions, scanned " SIZE_FORMAT "%s, "
+                                  "duty cycle %1.2f%%, throttled " SIZE_FORMAT "ms",
+                                  cl.regions_rebuilt(),
+                                  byte_size_in_proper_unit(cl.scanned_bytes()),
+                                  proper_unit_for_byte_size(cl.scanned_bytes()),
+                                  cl.duty_cycle() * 100.0,
+                                  cl.throttled_time_ms());
+
+  if (event.should_commit()) {
+    event.set_gcId(GCId::current());
+    event.set_regions(cl.regions_rebuilt());
+    event.set_scannedBytes(cl.scanned_bytes());
+    event.set_dutyCycle(cl.duty_cycle());
+    event.set_throttledTime(cl.throttled_time_ms());
+    event.commit();
+  }
 }
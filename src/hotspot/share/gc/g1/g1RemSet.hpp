@@ -75,6 +75,16 @@ private:
   G1Policy*              _g1p;
   G1HotCardCache*        _hot_card_cache;
 
+  // Number of cards ahead of the current one to prefetch the card table and
+  // block offset table entries for during batched refinement.
+  static const size_t RefinementPrefetchDistance = 8;
+
+  // Returns the region of the given card if it needs to be refined, NULL otherwise.
+  HeapRegion* region_for_refinement(jbyte* card_ptr);
+
+  // Clean and scan the given range of adjacent cards in region r in one go.
+  void refine_cards_in_region(HeapRegion* r, jbyte* first_card_ptr, jbyte* last_card_ptr, uint worker_i);
+
 public:
   // Gives an approximation on how many threads can be expected to add records to
   // a remembered set in parallel. This can be used for sizing data structures to
@@ -111,6 +121,14 @@ public:
   void refine_card_concurrently(jbyte* card_ptr,
                                 uint worker_i);
 
+  // Refine the given cards, which must be sorted by address and unique. Runs of
+  // adjacent cards within a region are scanned together. Stops early if the
+  // caller should yield. Returns the number of cards processed. Safe to be
+  // called concurrently to the mutator.
+  size_t refine_cards_concurrently(jbyte** card_ptrs,
+                                   size_t num_cards,
+                                   uint worker_i);
+
   // Refine the card corresponding to "card_ptr", applying the given closure to
   // all references found. Must only be called during gc.
   // Returns whether the card has been scanned.
@@ -89,18 +89,58 @@ void G1YoungRemSetSamplingThread::check_for_periodic_gc(){
   if ((os::elapsedTime() - _last_periodic_gc_attempt_s) > (G1PeriodicGCInterval / 1000.0)) {
     log_debug(gc, periodic)("Checking for periodic GC.");
     if (should_start_periodic_gc()) {
-      Universe::heap()->collect(GCCause::_g1_periodic_collection);
+      if (G1PeriodicGCUncommitOnly) {
+        periodic_uncommit();
+      } else {
+        Universe::heap()->collect(GCCause::_g1_periodic_collection);
+      }
     }
     _last_periodic_gc_attempt_s = os::elapsedTime();
   }
 }
 
+void G1YoungRemSetSamplingThread::periodic_uncommit() {
+  G1CollectedHeap* g1h = G1CollectedHeap::heap();
+  uint total_uncommitted = 0;
+
+  while (!should_terminate()) {
+    uint uncommitted = 0;
+    {
+      // Take the Heap_lock before joining the suspendible thread set: a thread
+      // requesting a GC holds the Heap_lock while the safepoint synchronizes.
+      MutexLockerEx ml(Heap_lock);
+      SuspendibleThreadSetJoiner sts;
+
+      if (g1h->concurrent_mark()->cm_thread()->during_cycle()) {
+        log_debug(gc, periodic)("Concurrent cycle in progress. Stopping uncommit.");
+        break;
+      }
+      if (g1h->free_regions_may_have_stale_cards()) {
+        log_debug(gc, periodic)("Regions freed since last GC may have stale cards. Stopping uncommit.");
+        break;
+      }
+      uncommitted = g1h->uncommit_excess_free_regions(G1PeriodicUncommitStepRegions);
+    }
+    if (uncommitted == 0) {
+      break;
+    }
+    total_uncommitted += uncommitted;
+  }
+
+  if (total_uncommitted > 0) {
+    log_info(gc, periodic)("Periodic uncommit: " SIZE_FORMAT "M, capacity now " SIZE_FORMAT "M",
+                           (size_t)total_uncommitted * HeapRegion::GrainBytes / M,
+                           g1h->capacity() / M);
+  }
+}
+
 void G1YoungRemSetSamplingThread::run_service() {
   double vtime_start = os::elapsedVTime();
 
   // Print a message about periodic GC configuration.
   if (G1PeriodicGCInterval != 0) {
-    log_info(gc)("Periodic GC enabled with interval " UINTX_FORMAT "ms", G1PeriodicGCInterval);
+    log_info(gc)("Periodic GC enabled with interval " UINTX_FORMAT "ms%s", G1PeriodicGCInterval,
+                 G1PeriodicGCUncommitOnly ? " (uncommit only)" : "");
   } else {
     log_info(gc)("Periodic GC disabled");
   }
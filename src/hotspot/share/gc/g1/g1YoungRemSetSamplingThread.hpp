@@ -39,6 +39,9 @@
 // reevaluates the prediction for the remembered set scanning costs, and potentially
 // G1Policy resizes the young gen. This may do a premature GC or even
 // increase the young gen size to keep pause time length goal.
+//
+// It also triggers periodic GCs, or with G1PeriodicGCUncommitOnly uncommits
+// excess free regions concurrently, if the application has been idle.
 class G1YoungRemSetSamplingThread: public ConcurrentGCThread {
 private:
   Monitor _monitor;
@@ -51,6 +54,8 @@ private:
 
   void run_service();
   void check_for_periodic_gc();
+  // Uncommit excess free regions in small steps instead of doing a periodic GC.
+  void periodic_uncommit();
 
   void stop_service();
 
@@ -61,6 +61,12 @@
           "Confidence level for MMU/pause predictions")                     \
           range(0, 100)                                                     \
                                                                             \
+  experimental(ccstr, G1PredictionModel, "decaying-average",                \
+          "Model used to predict pause time components and survival "       \
+          "rates. Possible values: decaying-average, change-point. "        \
+          "change-point adapts quickly to sudden changes of the "           \
+          "sampled values.")                                                \
+                                                                            \
   diagnostic(intx, G1SummarizeRSetStatsPeriod, 0,                           \
           "The period (in number of GCs) at which we will generate "        \
           "update buffer processing info "                                  \
@@ -159,6 +165,10 @@
           "The threshold that defines (>=) a hot card.")                    \
           range(0, max_jubyte)                                              \
                                                                             \
+  experimental(bool, G1BatchedConcRefinement, false,                        \
+          "Sort and deduplicate the cards of a buffer before concurrent "   \
+          "refinement, and scan runs of adjacent cards together.")          \
+                                                                            \
   develop(intx, G1RSetRegionEntriesBase, 256,                               \
           "Max number of regions in a fine-grain table per MB.")            \
           range(1, max_jint/wordSize)                                       \
@@ -254,6 +264,22 @@
           "Try to reclaim dead large objects that have a few stale "        \
           "references at every young GC.")                                  \
                                                                             \
+  experimental(bool, G1EagerReclaimHumongousObjArrays, false,               \
+          "Try to reclaim dead large object arrays at every young GC. "     \
+          "During concurrent marking only object arrays allocated after "   \
+          "the start of marking are considered.")                           \
+                                                                            \
+  experimental(bool, G1HeterogeneousHotOldPlacement, false,                 \
+          "With AllocateOldGenAt, evacuate old regions that are frequently "\
+          "written to into dram instead of nv-dimm. Region temperature is " \
+          "sampled from the card refinement counts at the end of marking.") \
+                                                                            \
+  experimental(uintx, G1HeterogeneousHotRegionPercent, 10,                  \
+          "Refinements of the cards of an old region between samples, in "  \
+          "percent of its number of cards, for the region to be "           \
+          "considered hot.")                                                \
+          range(1, 100)                                                     \
+                                                                            \
   experimental(size_t, G1RebuildRemSetChunkSize, 256 * K,                   \
           "Chunk size used for rebuilding the remembered set.")             \
           range(4 * K, 32 * M)                                              \
@@ -318,6 +344,24 @@
           "disables this check.")                                           \
           range(0.0, (double)max_uintx)                                     \
                                                                             \
+  manageable(bool, G1PeriodicGCUncommitOnly, false,                         \
+          "Instead of triggering a periodic gc, concurrently uncommit free "\
+          "regions exceeding the capacity given by MaxHeapFreeRatio once "  \
+          "G1PeriodicGCInterval milliseconds passed since the last gc.")    \
+                                                                            \
+  product(uint, G1PeriodicUncommitStepRegions, 8,                           \
+          "Maximum number of regions uncommitted at once by periodic "      \
+          "uncommit. Safepoints are allowed between steps.")                \
+          range(1, max_jint)                                                \
+                                                                            \
+  manageable(uintx, G1RebuildRemSetDutyCyclePercent, 100,                   \
+          "Maximum percentage of time each thread rebuilding remembered "   \
+          "sets is busy; the threads sleep otherwise. The default of 100 "  \
+          "does not throttle. A value of zero derives the duty cycle from " \
+          "the MMU goal given by MaxGCPauseMillis and "                     \
+          "GCPauseIntervalMillis, but never below 25 percent.")             \
+          range(0, 100)                                                     \
+                                                                            \
   experimental(uintx, G1YoungExpansionBufferPercent, 10,                    \
                "When heterogenous heap is enabled by AllocateOldGenAt "     \
                "option, after every GC, young gen is re-sized which "       \
@@ -287,6 +287,10 @@ class HeapRegion: public G1ContiguousSpace {
   // for the collection set.
   double _predicted_elapsed_time_ms;
 
+  // The node index of the NUMA node this region's memory is preferably
+  // located on.
+  uint _node_index;
+
   // Iterate over the references in a humongous objects and apply the given closure
   // to them.
   // Humongous objects are allocated directly in the old-gen. So we need special
@@ -549,6 +553,9 @@ class HeapRegion: public G1ContiguousSpace {
   void calc_gc_efficiency(void);
   double gc_efficiency() const { return _gc_efficiency;}
 
+  uint node_index() const { return _node_index; }
+  void set_node_index(uint node_index) { _node_index = node_index; }
+
   uint index_in_opt_cset() const { return _index_in_opt_cset; }
   void set_index_in_opt_cset(uint index) { _index_in_opt_cset = index; }
 
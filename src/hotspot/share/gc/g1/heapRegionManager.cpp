@@ -25,6 +25,7 @@
 #include "precompiled.hpp"
 #include "gc/g1/g1CollectedHeap.inline.hpp"
 #include "gc/g1/g1ConcurrentRefine.hpp"
+#include "gc/g1/g1NUMA.hpp"
 #include "gc/g1/heapRegion.hpp"
 #include "gc/g1/heapRegionManager.inline.hpp"
 #include "gc/g1/heapRegionSet.inline.hpp"
@@ -186,10 +187,35 @@ void HeapRegionManager::make_regions_available(uint start, uint num_regions, Wor
     MemRegion mr(bottom, bottom + HeapRegion::GrainWords);
 
     hr->initialize(mr);
+    hr->set_node_index(G1NUMA::numa()->preferred_node_index_for_index(i));
     insert_into_free_list(at(i));
   }
 }
 
+HeapRegion* HeapRegionManager::allocate_free_region(HeapRegionType type, uint requested_node_index) {
+  HeapRegion* hr = NULL;
+  bool from_head = !type.is_young();
+  G1NUMA* numa = G1NUMA::numa();
+
+  if (requested_node_index != G1NUMA::AnyNodeIndex && numa->is_enabled()) {
+    // Try to allocate with requested node index.
+    hr = _free_list.remove_region_with_node_index(from_head, requested_node_index);
+  }
+
+  if (hr == NULL) {
+    // If there's a single active node or we did not get a region from our requested node,
+    // try without requested node index.
+    hr = _free_list.remove_region(from_head);
+  }
+
+  if (hr != NULL) {
+    assert(hr->next() == NULL, "Single region should not have next");
+    assert(is_available(hr->hrm_index()), "Must be committed");
+  }
+
+  return hr;
+}
+
 MemoryUsage HeapRegionManager::get_auxiliary_data_memory_usage() const {
   size_t used_sz =
     _prev_bitmap_mapper->committed_size() +
@@ -435,6 +461,40 @@ uint HeapRegionManager::shrink_by(uint num_regions_to_remove) {
   return removed;
 }
 
+uint HeapRegionManager::uncommit_free_regions(uint num_regions_to_remove) {
+  assert(num_regions_to_remove < length(), "We should never remove all regions");
+
+  uint removed = 0;
+  uint end = _allocated_heapregions_length;
+
+  while (removed < num_regions_to_remove) {
+    // Skip regions that are uncommitted or in use. Regions that are empty but
+    // not free, e.g. the current mutator alloc region, must not be uncommitted.
+    while (end > 0 && !(is_available(end - 1) && at(end - 1)->is_free())) {
+      end--;
+    }
+    uint start = end;
+    while (start > 0 &&
+           (end - start) < (num_regions_to_remove - removed) &&
+           is_available(start - 1) && at(start - 1)->is_free()) {
+      start--;
+    }
+    if (start == end) {
+      break;
+    }
+
+    uint num_regions = end - start;
+    // The free list is sorted by index, so this range is contiguous in it.
+    _free_list.remove_starting_at(at(start), num_regions);
+    shrink_at(start, num_regions);
+
+    removed += num_regions;
+    end = start;
+  }
+
+  return removed;
+}
+
 void HeapRegionManager::shrink_at(uint index, size_t num_regions) {
 #ifdef ASSERT
   for (uint i = index; i < (index + num_regions); i++) {
@@ -176,15 +176,8 @@ public:
     _free_list.add_ordered(list);
   }
 
-  virtual HeapRegion* allocate_free_region(HeapRegionType type) {
-    HeapRegion* hr = _free_list.remove_region(!type.is_young());
-
-    if (hr != NULL) {
-      assert(hr->next() == NULL, "Single region should not have next");
-      assert(is_available(hr->hrm_index()), "Must be committed");
-    }
-    return hr;
-  }
+  // Allocate a free region with specific node index. If fails allocate with next node index.
+  virtual HeapRegion* allocate_free_region(HeapRegionType type, uint requested_node_index);
 
   inline void allocate_free_regions_starting_at(uint first, uint num_regions);
 
@@ -258,6 +251,12 @@ public:
   // Return the actual number of uncommitted regions.
   virtual uint shrink_by(uint num_regions_to_remove);
 
+  // Uncommit up to num_regions_to_remove free regions, starting from the top of
+  // the heap. Unlike shrink_by() the regions are removed from the free list
+  // individually, so this may be called concurrently with the application
+  // while holding the Heap_lock. Return the actual number of uncommitted regions.
+  virtual uint uncommit_free_regions(uint num_regions_to_remove);
+
   // Uncommit a number of regions starting at the specified index, which must be available,
   // empty, and free.
   void shrink_at(uint index, size_t num_regions);
@@ -181,6 +181,12 @@ public:
   // Removes from head or tail based on the given argument.
   HeapRegion* remove_region(bool from_head);
 
+  // Removes the first region with the given node index, searching from head
+  // or tail based on the given argument. The search depth is limited by
+  // G1NUMA::max_search_depth(). Returns NULL if no such region was found.
+  HeapRegion* remove_region_with_node_index(bool from_head,
+                                            uint requested_node_index);
+
   // Merge two ordered lists. The result is also ordered. The order is
   // determined by hrm_index.
   void add_ordered(FreeRegionList* from_list);
@@ -25,11 +25,16 @@
 #include "precompiled.hpp"
 #include "gc/g1/g1CollectedHeap.inline.hpp"
 #include "gc/g1/g1ConcurrentRefine.hpp"
+#include "gc/g1/g1HotCardCache.hpp"
 #include "gc/g1/heapRegion.hpp"
 #include "gc/g1/heapRegionManager.inline.hpp"
 #include "gc/g1/heapRegionSet.inline.hpp"
 #include "gc/g1/heterogeneousHeapRegionManager.hpp"
+#include "gc/shared/workgroup.hpp"
+#include "logging/log.hpp"
 #include "memory/allocation.hpp"
+#include "runtime/atomic.hpp"
+#include "runtime/safepoint.hpp"
 
 
 HeterogeneousHeapRegionManager* HeterogeneousHeapRegionManager::manager() {
@@ -53,6 +58,11 @@ void HeterogeneousHeapRegionManager::initialize(G1RegionToSpaceMapper* heap_stor
   // This allows regions to be un-committed while concurrent-marking threads are accessing the bitmap concurrently.
   _prev_bitmap_mapper->commit_and_set_special();
   _next_bitmap_mapper->commit_and_set_special();
+
+  _region_temperature = NEW_C_HEAP_ARRAY(jubyte, max_length(), mtGC);
+  memset(_region_temperature, 0, max_length() * sizeof(jubyte));
+  _region_card_counts = NEW_C_HEAP_ARRAY(uint, max_length(), mtGC);
+  memset(_region_card_counts, 0, max_length() * sizeof(uint));
 }
 
 // expand_by() is called to grow the heap. We grow into nvdimm now.
@@ -263,7 +273,7 @@ uint HeterogeneousHeapRegionManager::find_empty_in_range_reverse(uint start_idx,
   return num_regions_found;
 }
 
-HeapRegion* HeterogeneousHeapRegionManager::allocate_free_region(HeapRegionType type) {
+HeapRegion* HeterogeneousHeapRegionManager::allocate_free_region(HeapRegionType type, uint node_index) {
 
   // We want to prevent mutators from proceeding when we have borrowed regions from the last collection. This
   // will force a full collection to remedy the situation.
@@ -275,8 +285,37 @@ HeapRegion* HeterogeneousHeapRegionManager::allocate_free_region(HeapRegionType
   }
 
   // old and humongous regions are allocated from nv-dimm; eden and survivor regions are allocated from dram
-  // assumption: dram regions take higher indexes
   bool from_nvdimm = (type.is_old() || type.is_humongous()) ? true : false;
+  HeapRegion* hr = NULL;
+  if (type.is_old() && _old_dram_budget > 0) {
+    // Hot old regions are being evacuated, try to move their objects into the free dram regions.
+    hr = _free_list.remove_region(false /* from_head */);
+    if (hr != NULL && !is_in_dram(hr->hrm_index())) {
+      _free_list.add_ordered(hr);
+      hr = NULL;
+    }
+    _old_dram_budget = (hr != NULL) ? _old_dram_budget - 1 : 0;
+  }
+  if (hr == NULL) {
+    hr = allocate_free_region_in(from_nvdimm);
+  }
+
+  // When an old region is requested (which happens during collection pause) and we can't find any empty region
+  // in the set of available regions (which is an evacuation failure scenario), we borrow (or pre-allocate) an unavailable region
+  // from nv-dimm. This region is used to evacuate surviving objects from eden, survivor or old.
+  if(hr == NULL && type.is_old()) {
+    hr = borrow_old_region_for_gc();
+  }
+
+  if (hr != NULL) {
+    assert(hr->next() == NULL, "Single region should not have next");
+    assert(is_available(hr->hrm_index()), "Must be committed");
+  }
+  return hr;
+}
+
+HeapRegion* HeterogeneousHeapRegionManager::allocate_free_region_in(bool from_nvdimm) {
+  // assumption: dram regions take higher indexes
   bool from_head = from_nvdimm;
   HeapRegion* hr = _free_list.remove_region(from_head);
 
@@ -310,18 +349,6 @@ HeapRegion* HeterogeneousHeapRegionManager::allocate_free_region(HeapRegionType
 #ifdef ASSERT
   assert(total_committed_before == total_regions_committed(), "invariant not met");
 #endif
-
-  // When an old region is requested (which happens during collection pause) and we can't find any empty region
-  // in the set of available regions (which is an evacuation failure scenario), we borrow (or pre-allocate) an unavailable region
-  // from nv-dimm. This region is used to evacuate surviving objects from eden, survivor or old.
-  if(hr == NULL && type.is_old()) {
-    hr = borrow_old_region_for_gc();
-  }
-
-  if (hr != NULL) {
-    assert(hr->next() == NULL, "Single region should not have next");
-    assert(is_available(hr->hrm_index()), "Must be committed");
-  }
   return hr;
 }
 
@@ -466,6 +493,7 @@ bool HeterogeneousHeapRegionManager::is_in_dram(uint index) const {
 // Note: by doing this we are breaking the in-variant that total number of committed regions is equal to current heap size.
 // After full collection ends, we will re-establish this in-variant by freeing DRAM regions.
 void HeterogeneousHeapRegionManager::prepare_for_full_collection_start() {
+  _old_dram_budget = 0;
   _total_commited_before_full_gc = total_regions_committed() - _no_borrowed_regions;
   _no_borrowed_regions = 0;
   expand_nvdimm(num_committed_dram(), NULL);
@@ -521,3 +549,95 @@ HeapRegion* HeterogeneousHeapRegionManager::borrow_old_region_for_gc() {
 bool HeterogeneousHeapRegionManager::has_borrowed_regions() const {
   return _no_borrowed_regions > 0;
 }
+
+class G1SampleRegionTemperatureTask : public AbstractGangTask {
+  class G1SampleRegionTemperatureClosure : public HeapRegionClosure {
+    G1HotCardCache* _hot_card_cache;
+    jubyte* _region_temperature;
+    uint* _region_card_counts;
+    uint _num_old;
+    uint _num_hot;
+  public:
+    G1SampleRegionTemperatureClosure(jubyte* region_temperature, uint* region_card_counts) :
+      _hot_card_cache(G1CollectedHeap::heap()->g1_hot_card_cache()),
+      _region_temperature(region_temperature),
+      _region_card_counts(region_card_counts),
+      _num_old(0),
+      _num_hot(0) { }
+
+    bool do_heap_region(HeapRegion* hr) {
+      uint index = hr->hrm_index();
+      if (!hr->is_old()) {
+        _region_temperature[index] = 0;
+        _region_card_counts[index] = 0;
+        return false;
+      }
+      // The card counts are only cleared when the region is freed, so the refinements since the
+      // previous sample are the growth of their sum. A smaller sum means the region was reused.
+      size_t counts = _hot_card_cache->sum_card_counts(hr);
+      size_t refined = counts >= _region_card_counts[index] ? counts - _region_card_counts[index] : counts;
+      _region_card_counts[index] = (uint)counts;
+      size_t sample = MIN2(refined * 100 / HeapRegion::CardsPerRegion, (size_t)100);
+      _region_temperature[index] = (jubyte)((_region_temperature[index] + sample) / 2);
+      _num_old++;
+      if (_region_temperature[index] >= G1HeterogeneousHotRegionPercent) {
+        _num_hot++;
+      }
+      return false;
+    }
+
+    uint num_old() const { return _num_old; }
+    uint num_hot() const { return _num_hot; }
+  };
+
+  HeterogeneousHeapRegionManager* _manager;
+  jubyte* _region_temperature;
+  uint* _region_card_counts;
+  HeapRegionClaimer _hrclaimer;
+  volatile uint _num_old;
+  volatile uint _num_hot;
+
+public:
+  G1SampleRegionTemperatureTask(HeterogeneousHeapRegionManager* manager, jubyte* region_temperature,
+                                uint* region_card_counts, uint num_workers) :
+    AbstractGangTask("G1 Sample Region Temperature"),
+    _manager(manager),
+    _region_temperature(region_temperature),
+    _region_card_counts(region_card_counts),
+    _hrclaimer(num_workers),
+    _num_old(0),
+    _num_hot(0) { }
+
+  void work(uint worker_id) {
+    G1SampleRegionTemperatureClosure cl(_region_temperature, _region_card_counts);
+    _manager->par_iterate(&cl, &_hrclaimer, _hrclaimer.offset_for_worker(worker_id));
+    Atomic::add(cl.num_old(), &_num_old);
+    Atomic::add(cl.num_hot(), &_num_hot);
+  }
+
+  uint num_old() const { return _num_old; }
+  uint num_hot() const { return _num_hot; }
+};
+
+void HeterogeneousHeapRegionManager::sample_region_temperatures(WorkGang* workers) {
+  assert(SafepointSynchronize::is_at_safepoint(), "must be at a safepoint");
+  uint num_workers = workers->active_workers();
+  G1SampleRegionTemperatureTask task(this, _region_temperature, _region_card_counts, num_workers);
+  workers->run_task(&task, num_workers);
+  log_debug(gc, ergo, heap)("Sampled region temperatures: %u of %u old regions hot", task.num_hot(), task.num_old());
+}
+
+bool HeterogeneousHeapRegionManager::is_hot(uint index) const {
+  assert(index < max_length(), "index %u out of bounds", index);
+  return _region_temperature[index] >= G1HeterogeneousHotRegionPercent;
+}
+
+void HeterogeneousHeapRegionManager::set_allocate_old_in_dram(bool value, uint survivor_regions) {
+  uint free_dram = value ? free_list_dram_length() : 0;
+  _old_dram_budget = free_dram > survivor_regions ? free_dram - survivor_regions : 0;
+}
+
+void HeterogeneousHeapRegionManager::record_migrations(uint to_dram, uint to_nvdimm) {
+  _num_regions_migrated_to_dram += to_dram;
+  _num_regions_migrated_to_nvdimm += to_nvdimm;
+}
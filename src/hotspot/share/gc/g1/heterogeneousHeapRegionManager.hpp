@@ -37,6 +37,9 @@
 //      3a. If more dram regions are needed (young generation expansion), corresponding number of regions in nv-dimm are un-committed.
 //      3b. When old generation or humongous set grows, and new regions need to be committed to nv-dimm, corresponding number of regions
 //            are un-committed in dram.
+// With G1HeterogeneousHotOldPlacement, old regions are placed according to their temperature. The temperature of every old region
+// is sampled from the card counts at the end of marking. Pauses whose old collection set is mostly hot allocate old regions in
+// dram, so that evacuation migrates the live objects of hot regions from nv-dimm into dram, and of cold regions back into nv-dimm.
 class HeterogeneousHeapRegionManager : public HeapRegionManager {
   const uint _max_regions;
   uint _max_dram_regions;
@@ -45,6 +48,16 @@ class HeterogeneousHeapRegionManager : public HeapRegionManager {
   uint _total_commited_before_full_gc;
   uint _no_borrowed_regions;
 
+  // Per region temperature, the decaying average of the refinements between samples, in percent of the cards.
+  jubyte* _region_temperature;
+  // Per region sum of the card counts at the previous sample.
+  uint* _region_card_counts;
+  // Number of old regions that may still be allocated in dram during this pause.
+  uint _old_dram_budget;
+  // Number of old regions evacuated from nv-dimm into dram and vice versa.
+  size_t _num_regions_migrated_to_dram;
+  size_t _num_regions_migrated_to_nvdimm;
+
   uint total_regions_committed() const;
   uint num_committed_dram() const;
   uint num_committed_nvdimm() const;
@@ -76,6 +89,9 @@ class HeterogeneousHeapRegionManager : public HeapRegionManager {
   // Similar to find_contiguous() in base class, with [start, end] range
   uint find_contiguous(size_t start, size_t end, size_t num, bool empty_only);
 
+  // Allocates a free region from either dram or nv-dimm, committing a region there at the expense of the other if needed.
+  HeapRegion* allocate_free_region_in(bool from_nvdimm);
+
   // This function is called when there are no free nv-dimm regions.
   // It borrows a region from the set of unavailable regions in nv-dimm for GC purpose.
   HeapRegion* borrow_old_region_for_gc();
@@ -92,7 +108,9 @@ public:
   // Empty constructor, we'll initialize it with the initialize() method.
   HeterogeneousHeapRegionManager(uint num_regions) : _max_regions(num_regions), _max_dram_regions(0),
                                                      _max_nvdimm_regions(0), _start_index_of_nvdimm(0),
-                                                     _total_commited_before_full_gc(0), _no_borrowed_regions(0)
+                                                     _total_commited_before_full_gc(0), _no_borrowed_regions(0),
+                                                     _region_temperature(NULL), _region_card_counts(NULL), _old_dram_budget(0),
+                                                     _num_regions_migrated_to_dram(0), _num_regions_migrated_to_nvdimm(0)
   {}
 
   static HeterogeneousHeapRegionManager* manager();
@@ -119,7 +137,9 @@ public:
   void prepare_for_full_collection_start();
   void prepare_for_full_collection_end();
 
-  virtual HeapRegion* allocate_free_region(HeapRegionType type);
+  // Allocates a region from the dram or nv-dimm part depending on the type.
+  // The node index is ignored.
+  virtual HeapRegion* allocate_free_region(HeapRegionType type, uint node_index);
 
   // Return maximum number of regions that heap can expand to.
   uint max_expandable_length() const;
@@ -142,8 +162,27 @@ public:
   // Override. This fuction is called to shrink the heap, we shrink in dram first then in nv-dimm.
   uint shrink_by(uint num_regions_to_remove);
 
+  // Override. Concurrent uncommit is not supported, as it would have to keep
+  // the dram and nv-dimm region counts in balance outside of a safepoint.
+  uint uncommit_free_regions(uint num_regions_to_remove) { return 0; }
+
   bool has_borrowed_regions() const;
 
+  // Update the temperature of all old regions from the card counts. Must be called at a safepoint.
+  void sample_region_temperatures(WorkGang* workers);
+  bool is_hot(uint index) const;
+  bool is_in_dram(const HeapRegion* hr) const { return is_in_dram(hr->hrm_index()); }
+
+  // Direct old region allocations to dram or nv-dimm. Old regions only take free dram regions
+  // left after reserving survivor_regions for the survivors, and never commit dram at the expense
+  // of nv-dimm, so that they do not eat into the dram sized for the young generation.
+  void set_allocate_old_in_dram(bool value, uint survivor_regions);
+  bool allocate_old_in_dram() const { return _old_dram_budget > 0; }
+
+  void record_migrations(uint to_dram, uint to_nvdimm);
+  size_t num_regions_migrated_to_dram() const { return _num_regions_migrated_to_dram; }
+  size_t num_regions_migrated_to_nvdimm() const { return _num_regions_migrated_to_nvdimm; }
+
   void verify();
 };
 
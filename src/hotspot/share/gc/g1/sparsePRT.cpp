@@ -87,6 +87,25 @@ void SparsePRTEntry::copy_cards(SparsePRTEntry* e) const {
 
 float RSHashTable::TableOccupancyFactor = 0.5f;
 
+// The empty table can't hash any region, so it doesn't need any entries.
+// A single bucket, which is always empty, avoids special cases in lookup
+// and iteration.
+static int empty_buckets[1] = { RSHashTable::NullEntry };
+
+RSHashTable RSHashTable::empty_table;
+
+RSHashTable::RSHashTable() :
+  _num_entries(0),
+  _capacity(1),
+  _capacity_mask(0),
+  _occupied_entries(0),
+  _occupied_cards(0),
+  _entries(NULL),
+  _buckets(empty_buckets),
+  _free_region(0),
+  _free_list(NullEntry)
+{ }
+
 RSHashTable::RSHashTable(size_t capacity) :
   _num_entries(0),
   _capacity(capacity),
@@ -108,7 +127,7 @@ RSHashTable::~RSHashTable() {
     FREE_C_HEAP_ARRAY(SparsePRTEntry, _entries);
     _entries = NULL;
   }
-  if (_buckets != NULL) {
+  if (_buckets != NULL && _buckets != empty_buckets) {
     FREE_C_HEAP_ARRAY(int, _buckets);
     _buckets = NULL;
   }
@@ -288,18 +307,22 @@ size_t RSHashTable::mem_size() const {
 // ----------------------------------------------------------------------
 
 SparsePRT::SparsePRT() :
-  _table(new RSHashTable(InitialCapacity)) {
+  _table(&RSHashTable::empty_table) {
 }
 
 
 SparsePRT::~SparsePRT() {
-  delete _table;
+  if (_table != &RSHashTable::empty_table) {
+    delete _table;
+  }
 }
 
 
 size_t SparsePRT::mem_size() const {
-  // We ignore "_cur" here, because it either = _next, or else it is
-  // on the deleted list.
+  // The empty table is shared by all SparsePRTs.
+  if (_table == &RSHashTable::empty_table) {
+    return sizeof(SparsePRT);
+  }
   return sizeof(SparsePRT) + _table->mem_size();
 }
 
@@ -319,17 +342,19 @@ bool SparsePRT::delete_entry(RegionIdx_t region_id) {
 }
 
 void SparsePRT::clear() {
-  // If the entry table is not at initial capacity, just create a new one.
-  if (_table->capacity() != InitialCapacity) {
+  // Return the memory of any table; the next addition allocates a new one.
+  if (_table != &RSHashTable::empty_table) {
     delete _table;
-    _table = new RSHashTable(InitialCapacity);
-  } else {
-    _table->clear();
+    _table = &RSHashTable::empty_table;
   }
 }
 
 void SparsePRT::expand() {
   RSHashTable* last = _table;
+  if (last == &RSHashTable::empty_table) {
+    _table = new RSHashTable(InitialCapacity);
+    return;
+  }
   _table = new RSHashTable(last->capacity() * 2);
   for (size_t i = 0; i < last->num_entries(); i++) {
     SparsePRTEntry* e = last->entry((int)i);
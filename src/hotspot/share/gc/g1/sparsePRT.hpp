@@ -136,11 +136,15 @@ class RSHashTable : public CHeapObj<mtGC> {
   // deleted from any bucket lists.
   void free_entry(int fi);
 
+  // For the empty sentinel created at static initialization time
+  RSHashTable();
+
 public:
   RSHashTable(size_t capacity);
   ~RSHashTable();
 
   static const int NullEntry = -1;
+  static RSHashTable empty_table;
 
   bool should_expand() const { return _occupied_entries == _num_entries; }
 
@@ -168,6 +172,8 @@ public:
   size_t occupied_cards() const   { return _occupied_cards; }
   size_t mem_size() const;
   // The number of SparsePRTEntry instances available.
+  // The empty table has none, so that it is replaced by a real
+  // table on the first addition.
   size_t num_entries() const { return _num_entries; }
 
   SparsePRTEntry* entry(int i) const {
@@ -210,6 +216,10 @@ public:
 };
 
 // Concurrent access to a SparsePRT must be serialized by some external mutex.
+//
+// Most remembered sets are empty or very small, so a SparsePRT does not
+// allocate any table until the first card is added; until then, and again
+// after clearing, it refers to a shared, immutable empty table.
 
 class SparsePRTIter;
 
@@ -222,6 +232,8 @@ class SparsePRT {
     InitialCapacity = 16
   };
 
+  // Replaces the table by one of twice the capacity, or by one of
+  // InitialCapacity if the table is still the shared empty table.
   void expand();
 
 public:
@@ -246,7 +258,7 @@ public:
   // otherwise returns "false."
   bool delete_entry(RegionIdx_t region_ind);
 
-  // Clear the table, and reinitialize to initial capacity.
+  // Clear the table, and release its memory.
   void clear();
 
   bool contains_card(RegionIdx_t region_id, CardIdx_t card_index) const {
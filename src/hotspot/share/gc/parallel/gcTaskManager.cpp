@@ -28,6 +28,7 @@
 #include "gc/shared/gcId.hpp"
 #include "gc/shared/workerManager.hpp"
 #include "gc/shared/workerPolicy.hpp"
+#include "gc/shared/workgroup.hpp"
 #include "logging/log.hpp"
 #include "logging/logStream.hpp"
 #include "memory/allocation.hpp"
@@ -813,6 +814,16 @@ void GCTaskManager::execute_and_wait(GCTaskQueue* list) {
   WaitForBarrierGCTask::destroy(fin);
 }
 
+void GCTaskManager::run_task(AbstractGangTask* task, uint num_workers) {
+  assert(num_workers > 0 && num_workers <= active_workers(),
+         "Trying to run %u workers with %u active", num_workers, active_workers());
+  GCTaskQueue* q = GCTaskQueue::create();
+  for (uint i = 0; i < num_workers; i++) {
+    q->enqueue(new GangTaskGCTask(task, i));
+  }
+  execute_and_wait(q);
+}
+
 bool GCTaskManager::resource_flag(uint which) {
   assert(which < workers(), "index out of bounds");
   return _resource_flag[which];
@@ -905,6 +916,23 @@ void IdleGCTask::destruct() {
   // Nothing else to do.
 }
 
+//
+// GangTaskGCTask
+//
+
+GangTaskGCTask::GangTaskGCTask(AbstractGangTask* task, uint worker_id) :
+  GCTask(GCTask::Kind::ordinary_task, GCId::current_or_undefined()),
+  _task(task),
+  _worker_id(worker_id) { }
+
+char* GangTaskGCTask::name() {
+  return (char*)_task->name();
+}
+
+void GangTaskGCTask::do_it(GCTaskManager* manager, uint which) {
+  _task->work(_worker_id);
+}
+
 //
 // WaitForBarrierGCTask
 //
@@ -40,12 +40,14 @@ class SynchronizedGCTaskQueue;
 class GCTaskManager;
 // Some useful subclasses of GCTask.  You can also make up your own.
 class NoopGCTask;
+class GangTaskGCTask;
 class WaitForBarrierGCTask;
 class IdleGCTask;
 // A free list of Monitor*'s.
 class MonitorSupply;
 
 // Forward declarations of classes referenced in this file via pointer.
+class AbstractGangTask;
 class GCTaskThread;
 class Mutex;
 class Monitor;
@@ -442,6 +444,14 @@ public:
 
   //     Execute the task queue and wait for the completion.
   void execute_and_wait(GCTaskQueue* list);
+  //     Run the gang task with worker ids [0, num_workers) and wait for
+  //     the completion. Each worker id is run by a different thread, so
+  //     num_workers must not exceed active_workers(). Creates the tasks
+  //     in a ResourceArea and assumes an appropriate ResourceMark.
+  void run_task(AbstractGangTask* task, uint num_workers);
+  void run_task(AbstractGangTask* task) {
+    run_task(task, active_workers());
+  }
 
   void print_task_time_stamps();
   void print_threads_on(outputStream* st);
@@ -585,6 +595,20 @@ protected:
   void destruct();
 };
 
+// A task that runs one worker of an AbstractGangTask,
+// so that gang tasks can be executed by the GCTaskThreads.
+class GangTaskGCTask : public GCTask {
+private:
+  AbstractGangTask* const _task;
+  const uint              _worker_id;
+public:
+  GangTaskGCTask(AbstractGangTask* task, uint worker_id);
+
+  virtual char* name();
+  // Methods from GCTask.
+  void do_it(GCTaskManager* manager, uint which);
+};
+
 // A WaitForBarrierGCTask is a GCTask
 // with a method you can call to wait until
 // the BarrierGCTask is done.
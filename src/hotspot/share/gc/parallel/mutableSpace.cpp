@@ -23,9 +23,15 @@
  */
 
 #include "precompiled.hpp"
+#include "gc/parallel/gcTaskManager.hpp"
 #include "gc/parallel/mutableSpace.hpp"
+#include "gc/parallel/parallelScavengeHeap.hpp"
+#include "gc/shared/pretouchTask.hpp"
 #include "gc/shared/spaceDecorator.hpp"
+#include "logging/log.hpp"
 #include "memory/iterator.inline.hpp"
+#include "memory/resourceArea.hpp"
+#include "memory/universe.hpp"
 #include "oops/oop.inline.hpp"
 #include "runtime/atomic.hpp"
 #include "runtime/safepoint.hpp"
@@ -60,7 +66,25 @@ void MutableSpace::numa_setup_pages(MemRegion mr, bool clear_space) {
 }
 
 void MutableSpace::pretouch_pages(MemRegion mr) {
-  os::pretouch_memory(mr.start(), mr.end());
+  // Spaces also grow from scavenge workers and from mutators holding the
+  // ExpandHeap_lock. Only use the GC task threads while they are known to
+  // be idle: during heap initialization, or from the VM thread at a
+  // safepoint, which waits in run_task() for any task it has started.
+  GCTaskManager* manager = ParallelScavengeHeap::gc_task_manager();
+  if (manager != NULL && !mr.is_empty() &&
+      (!Universe::is_fully_initialized() ||
+       (Thread::current()->is_VM_thread() && SafepointSynchronize::is_at_safepoint()))) {
+    ResourceMark rm;
+    PretouchTask task("ParallelGC PreTouch", (char*)mr.start(), (char*)mr.end(), os::vm_page_size());
+    size_t num_chunks = MAX2((size_t)1, mr.byte_size() / PretouchTask::chunk_size());
+    uint num_workers = (uint)MIN2(num_chunks, (size_t)manager->active_workers());
+    log_debug(gc, heap)("Running %s with %u workers for " SIZE_FORMAT " work units pre-touching " SIZE_FORMAT "B.",
+                        task.name(), num_workers, num_chunks, mr.byte_size());
+    manager->run_task(&task, num_workers);
+  } else {
+    PretouchTask::pretouch("ParallelGC PreTouch", (char*)mr.start(), (char*)mr.end(),
+                           os::vm_page_size(), NULL);
+  }
 }
 
 void MutableSpace::initialize(MemRegion mr,
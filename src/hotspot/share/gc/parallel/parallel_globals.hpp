@@ -78,6 +78,13 @@
           "Delay in scheduling GC workers (in milliseconds)")               \
                                                                             \
   product(bool, PSChunkLargeArrays, true,                                   \
-          "Process large arrays in chunks")
+          "Process large arrays in chunks")                                 \
+                                                                            \
+  product(size_t, NUMAOldPromotionChunkSize, 1*M,                           \
+          "Size of the chunks of old space, bound to the NUMA node of the " \
+          "promoting GC thread, that old promotion LABs are taken from "    \
+          "when UseNUMA is enabled (0 means promote without node "          \
+          "preference)")                                                    \
+          range(0, 256*M)
 
 #endif // SHARE_GC_PARALLEL_PARALLEL_GLOBALS_HPP
@@ -27,7 +27,6 @@
 
 #include "gc/parallel/gcTaskManager.hpp"
 #include "gc/parallel/psParallelCompact.hpp"
-#include "gc/parallel/psTasks.hpp"
 
 
 // Tasks for parallel compaction of the old generation
@@ -31,11 +31,18 @@
 #include "gc/parallel/psMarkSweepDecorator.hpp"
 #include "gc/parallel/psOldGen.hpp"
 #include "gc/shared/cardTableBarrierSet.hpp"
+#include "gc/shared/collectedHeap.hpp"
 #include "gc/shared/gcLocker.hpp"
 #include "gc/shared/spaceDecorator.hpp"
 #include "logging/log.hpp"
+#include "memory/padded.inline.hpp"
 #include "oops/oop.inline.hpp"
+#include "runtime/atomic.hpp"
 #include "runtime/java.hpp"
+#include "runtime/mutexLocker.hpp"
+#include "runtime/orderAccess.hpp"
+#include "runtime/os.hpp"
+#include "runtime/thread.hpp"
 #include "utilities/align.hpp"
 
 inline const char* PSOldGen::select_name() {
@@ -46,7 +53,8 @@ PSOldGen::PSOldGen(ReservedSpace rs, size_t alignment,
                    size_t initial_size, size_t min_size, size_t max_size,
                    const char* perf_data_name, int level):
   _name(select_name()), _init_gen_size(initial_size), _min_gen_size(min_size),
-  _max_gen_size(max_size)
+  _max_gen_size(max_size), _promotion_chunks(NULL),
+  _promotion_chunk_lgrp_ids(NULL), _promotion_chunk_count(0)
 {
   initialize(rs, alignment, perf_data_name, level);
 }
@@ -55,7 +63,8 @@ PSOldGen::PSOldGen(size_t initial_size,
                    size_t min_size, size_t max_size,
                    const char* perf_data_name, int level):
   _name(select_name()), _init_gen_size(initial_size), _min_gen_size(min_size),
-  _max_gen_size(max_size)
+  _max_gen_size(max_size), _promotion_chunks(NULL),
+  _promotion_chunk_lgrp_ids(NULL), _promotion_chunk_count(0)
 {}
 
 void PSOldGen::initialize(ReservedSpace rs, size_t alignment,
@@ -157,6 +166,181 @@ void PSOldGen::initialize_work(const char* perf_data_name, int level) {
 
   // Update the start_array
   start_array()->set_covered_region(cmr);
+
+  initialize_promotion_chunks();
+}
+
+void PSOldGen::initialize_promotion_chunks() {
+  if (!UseNUMA || NUMAOldPromotionChunkSize == 0) {
+    return;
+  }
+
+  int lgrp_limit = (int)os::numa_get_groups_num();
+  int* lgrp_ids = NEW_C_HEAP_ARRAY(int, lgrp_limit, mtGC);
+  int lgrp_num = (int)os::numa_get_leaf_groups(lgrp_ids, lgrp_limit);
+  if (lgrp_num <= 1) {
+    // Every LAB would be local anyway.
+    FREE_C_HEAP_ARRAY(int, lgrp_ids);
+    return;
+  }
+
+  _promotion_chunk_lgrp_ids = lgrp_ids;
+  _promotion_chunk_count = lgrp_num;
+  _promotion_chunks = PaddedArray<PromotionChunkSlot, mtGC>::create_unfreeable(lgrp_num);
+  for (int i = 0; i < lgrp_num; i++) {
+    _promotion_chunks[i]._current = NULL;
+    _promotion_chunks[i]._closed = NULL;
+  }
+
+  log_debug(gc, heap)("Old promotion chunks: %d NUMA nodes, " SIZE_FORMAT "K chunks",
+                      lgrp_num, NUMAOldPromotionChunkSize / K);
+}
+
+// Allocation from a chunk is a CAS on the top, bounded by the immutable end.
+HeapWord* PSOldGen::PromotionChunk::par_allocate(size_t word_size) {
+  while (true) {
+    HeapWord* top = _top;
+    if (pointer_delta(_end, top) < word_size) {
+      return NULL;
+    }
+    HeapWord* new_top = top + word_size;
+    // Never leave a remainder that is too small to be filled.
+    size_t remainder = pointer_delta(_end, new_top);
+    if (remainder != 0 && remainder < CollectedHeap::min_fill_size()) {
+      return NULL;
+    }
+    if (Atomic::cmpxchg(new_top, &_top, top) == top) {
+      return top;
+    }
+  }
+}
+
+MemRegion PSOldGen::PromotionChunk::close() {
+  HeapWord* top;
+  do {
+    top = _top;
+    if (top == _end) {
+      return MemRegion();
+    }
+  } while (Atomic::cmpxchg(_end, &_top, top) != top);
+  return MemRegion(top, _end);
+}
+
+HeapWord* PSOldGen::cas_allocate_lab(size_t word_size) {
+  if (_promotion_chunks == NULL) {
+    return cas_allocate(word_size);
+  }
+
+  Thread* thr = Thread::current();
+  int lgrp_id = thr->lgrp_id();
+  if (lgrp_id == -1 || !os::numa_has_group_homing()) {
+    lgrp_id = os::numa_get_group_id();
+    thr->set_lgrp_id(lgrp_id);
+  }
+
+  for (int i = 0; i < _promotion_chunk_count; i++) {
+    if (_promotion_chunk_lgrp_ids[i] == lgrp_id) {
+      PromotionChunkSlot* slot = &_promotion_chunks[i];
+      PromotionChunk* chunk = OrderAccess::load_acquire(&slot->_current);
+      HeapWord* res = (chunk != NULL) ? chunk->par_allocate(word_size) : NULL;
+      return res != NULL ? res : refill_promotion_chunk(slot, chunk, lgrp_id, word_size);
+    }
+  }
+
+  // The thread runs on a node that was not known at startup.
+  return cas_allocate(word_size);
+}
+
+HeapWord* PSOldGen::refill_promotion_chunk(PromotionChunkSlot* slot, PromotionChunk* chunk,
+                                           int lgrp_id, size_t word_size) {
+  // The new chunk's space is allocated before taking the lock, as the
+  // allocation may need to expand the old gen under the ExpandHeap_lock.
+  // Chunks are therefore not installed in address order, which is fine as
+  // every chunk carries its own bounds.
+  size_t chunk_words = align_object_size(NUMAOldPromotionChunkSize / HeapWordSize);
+  if (chunk_words < word_size + CollectedHeap::min_fill_size()) {
+    // The LAB takes the whole chunk.
+    chunk_words = word_size;
+  }
+  HeapWord* chunk_start = cas_allocate(chunk_words);
+  if (chunk_start == NULL) {
+    // The old gen is too full for a chunk; a LAB may still fit.
+    return cas_allocate(word_size);
+  }
+
+  // Bind the pages that lie entirely within the chunk to the node.  Pages
+  // that were touched before keep their current placement.
+  size_t page_size = UseLargePages ? object_space()->alignment() : os::vm_page_size();
+  HeapWord* bind_start = align_up(chunk_start, page_size);
+  HeapWord* bind_end = align_down(chunk_start + chunk_words, page_size);
+  if (bind_end > bind_start) {
+    os::numa_make_local((char*)bind_start, pointer_delta(bind_end, bind_start, sizeof(char)), lgrp_id);
+  }
+
+  HeapWord* res = NULL;
+  {
+    MutexLockerEx ml(ParGCRareEvent_lock, Mutex::_no_safepoint_check_flag);
+
+    // Another thread may have refilled the slot in the meantime.
+    PromotionChunk* current = slot->_current;
+    if (current != chunk) {
+      res = current->par_allocate(word_size);
+    }
+    if (res == NULL) {
+      close_promotion_chunk(slot);
+
+      // The caller gets the first LAB of the chunk.
+      PromotionChunk* new_chunk = new PromotionChunk(chunk_start + word_size,
+                                                     chunk_start + chunk_words,
+                                                     slot->_closed);
+      OrderAccess::release_store(&slot->_current, new_chunk);
+      return chunk_start;
+    }
+  }
+
+  // Lost the race, the new chunk is not needed.
+  return_to_old_space(chunk_start, chunk_words);
+  return res;
+}
+
+// Closes the current chunk of the slot and moves it to the closed list.
+// Called with ParGCRareEvent_lock held, or at the end of the scavenge.
+void PSOldGen::close_promotion_chunk(PromotionChunkSlot* slot) {
+  PromotionChunk* chunk = slot->_current;
+  if (chunk == NULL) {
+    return;
+  }
+  MemRegion tail = chunk->close();
+  if (!tail.is_empty()) {
+    return_to_old_space(tail.start(), tail.word_size());
+  }
+  slot->_closed = chunk;
+}
+
+void PSOldGen::return_to_old_space(HeapWord* start, size_t word_size) {
+  // Give the space back if nothing was allocated above it, otherwise fill
+  // it so that the old space stays parsable.
+  if (!object_space()->cas_deallocate(start, word_size)) {
+    CollectedHeap::fill_with_object(start, word_size);
+    _start_array.allocate_block(start);
+  }
+}
+
+void PSOldGen::flush_promotion_chunks() {
+  assert(SafepointSynchronize::is_at_safepoint(), "Must only be called at safepoint");
+  for (int i = 0; i < _promotion_chunk_count; i++) {
+    PromotionChunkSlot* slot = &_promotion_chunks[i];
+    close_promotion_chunk(slot);
+    slot->_current = NULL;
+    // No worker can see the closed chunks any more.
+    PromotionChunk* chunk = slot->_closed;
+    while (chunk != NULL) {
+      PromotionChunk* next = chunk->next_closed();
+      delete chunk;
+      chunk = next;
+    }
+    slot->_closed = NULL;
+  }
 }
 
 void PSOldGen::initialize_performance_counters(const char* perf_data_name, int level) {
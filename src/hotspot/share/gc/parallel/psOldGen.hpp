@@ -30,6 +30,7 @@
 #include "gc/parallel/psGenerationCounters.hpp"
 #include "gc/parallel/psVirtualspace.hpp"
 #include "gc/parallel/spaceCounters.hpp"
+#include "memory/padded.hpp"
 #include "runtime/safepoint.hpp"
 
 class PSMarkSweepDecorator;
@@ -62,6 +63,50 @@ class PSOldGen : public CHeapObj<mtGC> {
   // Used when initializing the _name field.
   static inline const char* select_name();
 
+  // A chunk of old space bound to a NUMA node.  Old promotion LABs are
+  // carved from the chunk of the node of the promoting GC thread, so the
+  // promoted objects are local to the thread that is likely to scan them
+  // in the next scavenge.  The chunks are only in use during a scavenge.
+  //
+  // The end of a chunk never changes, so an allocation can never pair the
+  // top of one chunk with the end of another.  A refill closes the current
+  // chunk and publishes a new one; closed chunks are kept until the end of
+  // the scavenge, as workers may still be looking at them.
+  class PromotionChunk : public CHeapObj<mtGC> {
+    HeapWord* volatile _top;
+    HeapWord* const    _end;
+    PromotionChunk*    _next_closed;
+
+   public:
+    PromotionChunk(HeapWord* top, HeapWord* end, PromotionChunk* next_closed) :
+      _top(top), _end(end), _next_closed(next_closed) {}
+
+    HeapWord* par_allocate(size_t word_size);
+    // Stops all further allocation.  Returns the unused tail as a MemRegion,
+    // which is empty if the chunk was already full or closed.
+    MemRegion close();
+
+    PromotionChunk* next_closed() const { return _next_closed; }
+  };
+
+  // The current and the closed chunks of a NUMA node.
+  struct PromotionChunkSlot {
+    PromotionChunk* volatile _current;
+    PromotionChunk*          _closed;   // Protected by ParGCRareEvent_lock
+  };
+
+  // The promotion chunk slots and the NUMA group ids they are bound to, or
+  // NULL if promotion LABs are taken from the old space directly.
+  PaddedEnd<PromotionChunkSlot>* _promotion_chunks;
+  int*                           _promotion_chunk_lgrp_ids;
+  int                            _promotion_chunk_count;
+
+  void initialize_promotion_chunks();
+  HeapWord* refill_promotion_chunk(PromotionChunkSlot* slot, PromotionChunk* chunk,
+                                   int lgrp_id, size_t word_size);
+  void close_promotion_chunk(PromotionChunkSlot* slot);
+  void return_to_old_space(HeapWord* start, size_t word_size);
+
 #ifdef ASSERT
   void assert_block_in_covered_region(MemRegion new_memregion) {
     // Explictly capture current covered_region in a local
@@ -109,6 +154,14 @@ class PSOldGen : public CHeapObj<mtGC> {
     return (res == NULL) ? expand_and_cas_allocate(word_size) : res;
   }
 
+  // Allocate a promotion LAB, preferably from the promotion chunk of the
+  // NUMA node of the current thread.
+  HeapWord* cas_allocate_lab(size_t word_size);
+
+  // Retire the promotion chunks at the end of a scavenge, making the old
+  // space parsable again.
+  void flush_promotion_chunks();
+
   HeapWord* expand_and_allocate(size_t word_size);
   HeapWord* expand_and_cas_allocate(size_t word_size);
   void expand(size_t bytes);
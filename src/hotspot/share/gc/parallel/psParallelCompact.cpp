@@ -684,6 +684,60 @@ ParallelCompactData::summarize_split_space(size_t src_region,
   return source_next;
 }
 
+void ParallelCompactData::summarize_region(const SplitInfo& split_info,
+                                           size_t cur_region,
+                                           HeapWord* dest_addr,
+                                           size_t words)
+{
+  assert(words > 0, "only regions with data have destinations");
+
+  // Compute the destination_count for cur_region, and if necessary, update
+  // source_region for a destination region.  The source_region field is
+  // updated if cur_region is the first (left-most) region to be copied to a
+  // destination region.
+  //
+  // The destination_count calculation is a bit subtle.  A region that has
+  // data that compacts into itself does not count itself as a destination.
+  // This maintains the invariant that a zero count means the region is
+  // available and can be claimed and then filled.
+  uint destination_count = 0;
+  if (split_info.is_split(cur_region)) {
+    // The current region has been split:  the partial object will be copied
+    // to one destination space and the remaining data will be copied to
+    // another destination space.  Adjust the initial destination_count and,
+    // if necessary, set the source_region field if the partial object will
+    // cross a destination region boundary.
+    destination_count = split_info.destination_count();
+    if (destination_count == 2) {
+      size_t dest_idx = addr_to_region_idx(split_info.dest_region_addr());
+      _region_data[dest_idx].set_source_region(cur_region);
+    }
+  }
+
+  HeapWord* const last_addr = dest_addr + words - 1;
+  const size_t dest_region_1 = addr_to_region_idx(dest_addr);
+  const size_t dest_region_2 = addr_to_region_idx(last_addr);
+
+  // Initially assume that the destination regions will be the same and
+  // adjust the value below if necessary.  Under this assumption, if
+  // cur_region == dest_region_2, then cur_region will be compacted
+  // completely into itself.
+  destination_count += cur_region == dest_region_2 ? 0 : 1;
+  if (dest_region_1 != dest_region_2) {
+    // Destination regions differ; adjust destination_count.
+    destination_count += 1;
+    // Data from cur_region will be copied to the start of dest_region_2.
+    _region_data[dest_region_2].set_source_region(cur_region);
+  } else if (region_offset(dest_addr) == 0) {
+    // Data from cur_region will be copied to the start of the destination
+    // region.
+    _region_data[dest_region_1].set_source_region(cur_region);
+  }
+
+  _region_data[cur_region].set_destination_count(destination_count);
+  _region_data[cur_region].set_data_location(region_to_addr(cur_region));
+}
+
 bool ParallelCompactData::summarize(SplitInfo& split_info,
                                     HeapWord* source_beg, HeapWord* source_end,
                                     HeapWord** source_next,
@@ -717,51 +771,7 @@ bool ParallelCompactData::summarize(SplitInfo& split_info,
         return false;
       }
 
-      // Compute the destination_count for cur_region, and if necessary, update
-      // source_region for a destination region.  The source_region field is
-      // updated if cur_region is the first (left-most) region to be copied to a
-      // destination region.
-      //
-      // The destination_count calculation is a bit subtle.  A region that has
-      // data that compacts into itself does not count itself as a destination.
-      // This maintains the invariant that a zero count means the region is
-      // available and can be claimed and then filled.
-      uint destination_count = 0;
-      if (split_info.is_split(cur_region)) {
-        // The current region has been split:  the partial object will be copied
-        // to one destination space and the remaining data will be copied to
-        // another destination space.  Adjust the initial destination_count and,
-        // if necessary, set the source_region field if the partial object will
-        // cross a destination region boundary.
-        destination_count = split_info.destination_count();
-        if (destination_count == 2) {
-          size_t dest_idx = addr_to_region_idx(split_info.dest_region_addr());
-          _region_data[dest_idx].set_source_region(cur_region);
-        }
-      }
-
-      HeapWord* const last_addr = dest_addr + words - 1;
-      const size_t dest_region_1 = addr_to_region_idx(dest_addr);
-      const size_t dest_region_2 = addr_to_region_idx(last_addr);
-
-      // Initially assume that the destination regions will be the same and
-      // adjust the value below if necessary.  Under this assumption, if
-      // cur_region == dest_region_2, then cur_region will be compacted
-      // completely into itself.
-      destination_count += cur_region == dest_region_2 ? 0 : 1;
-      if (dest_region_1 != dest_region_2) {
-        // Destination regions differ; adjust destination_count.
-        destination_count += 1;
-        // Data from cur_region will be copied to the start of dest_region_2.
-        _region_data[dest_region_2].set_source_region(cur_region);
-      } else if (region_offset(dest_addr) == 0) {
-        // Data from cur_region will be copied to the start of the destination
-        // region.
-        _region_data[dest_region_1].set_source_region(cur_region);
-      }
-
-      _region_data[cur_region].set_destination_count(destination_count);
-      _region_data[cur_region].set_data_location(region_to_addr(cur_region));
+      summarize_region(split_info, cur_region, dest_addr, words);
       dest_addr += words;
     }
 
@@ -772,6 +782,34 @@ bool ParallelCompactData::summarize(SplitInfo& split_info,
   return true;
 }
 
+HeapWord* ParallelCompactData::summarize_regions(const SplitInfo& split_info,
+                                                 size_t beg_region,
+                                                 size_t end_region,
+                                                 HeapWord* dest_addr)
+{
+  for (size_t cur_region = beg_region; cur_region < end_region; ++cur_region) {
+    // The destination must be set even if the region has no data.
+    _region_data[cur_region].set_destination(dest_addr);
+
+    size_t words = _region_data[cur_region].data_size();
+    if (words > 0) {
+      summarize_region(split_info, cur_region, dest_addr, words);
+      dest_addr += words;
+    }
+  }
+  return dest_addr;
+}
+
+size_t ParallelCompactData::data_size_in_regions(size_t beg_region,
+                                                 size_t end_region) const
+{
+  size_t words = 0;
+  for (size_t cur_region = beg_region; cur_region < end_region; ++cur_region) {
+    words += _region_data[cur_region].data_size();
+  }
+  return words;
+}
+
 HeapWord* ParallelCompactData::calc_new_pointer(HeapWord* addr, ParCompactionManager* cm) {
   assert(addr != NULL, "Should detect NULL oop earlier");
   assert(ParallelScavengeHeap::heap()->is_in(addr), "not in heap");
@@ -1442,15 +1480,159 @@ PSParallelCompact::compute_dense_prefix(const SpaceId id,
   return sd.region_to_addr(best_cp);
 }
 
+// Summarizes a range of regions in chunks claimed by the workers.  The
+// destination of a region is the start of the target plus the data in all
+// regions to its left, i.e., an exclusive prefix sum of the region data
+// sizes.  The sum is computed in two passes:  the workers first count the
+// data in each chunk, the VM thread turns the chunk totals into chunk
+// destinations, and the workers then summarize each chunk starting at its
+// destination.  The dense prefix needs only one pass, since no data moves.
+class PCSummaryTask : public AbstractGangTask {
+ public:
+  // The number of regions in a chunk.  Ranges of at most this many regions
+  // are summarized by the VM thread.
+  static const size_t ChunkRegions = 1024;
+
+  enum Pass {
+    count_data,       // Count the data in each chunk
+    summarize_data,   // Summarize each chunk into its destination
+    dense_prefix      // Summarize each chunk so that no data moves
+  };
+
+ private:
+  ParallelCompactData& _sd;
+  const SplitInfo*     _split_info;
+  const size_t         _beg_region;
+  const size_t         _end_region;
+  const size_t         _chunk_count;
+  // The data in each chunk, replaced by the offset of its destination from
+  // the start of the target by prefix_sum().
+  size_t*              _chunk_data;
+  HeapWord* const      _target_beg;
+  Pass                 _pass;
+  volatile size_t      _claimed;
+
+ public:
+  PCSummaryTask(ParallelCompactData& sd, const SplitInfo* split_info,
+                size_t beg_region, size_t end_region, HeapWord* target_beg) :
+    AbstractGangTask("PCSummaryTask"),
+    _sd(sd),
+    _split_info(split_info),
+    _beg_region(beg_region),
+    _end_region(end_region),
+    _chunk_count((end_region - beg_region + ChunkRegions - 1) / ChunkRegions),
+    _chunk_data(NEW_C_HEAP_ARRAY(size_t, _chunk_count, mtGC)),
+    _target_beg(target_beg),
+    _pass(count_data),
+    _claimed(0) { }
+
+  ~PCSummaryTask() {
+    FREE_C_HEAP_ARRAY(size_t, _chunk_data);
+  }
+
+  void set_pass(Pass pass) {
+    _pass = pass;
+    _claimed = 0;
+  }
+
+  // Turn the chunk totals into destination offsets and return the total.
+  size_t prefix_sum() {
+    size_t total = 0;
+    for (size_t chunk = 0; chunk < _chunk_count; ++chunk) {
+      const size_t words = _chunk_data[chunk];
+      _chunk_data[chunk] = total;
+      total += words;
+    }
+    return total;
+  }
+
+  virtual void work(uint worker_id) {
+    for (size_t chunk = Atomic::add((size_t)1, &_claimed) - 1;
+         chunk < _chunk_count;
+         chunk = Atomic::add((size_t)1, &_claimed) - 1) {
+      const size_t beg = _beg_region + chunk * ChunkRegions;
+      const size_t end = MIN2(beg + ChunkRegions, _end_region);
+      switch (_pass) {
+        case count_data:
+          _chunk_data[chunk] = _sd.data_size_in_regions(beg, end);
+          break;
+        case summarize_data:
+          _sd.summarize_regions(*_split_info, beg, end,
+                                _target_beg + _chunk_data[chunk]);
+          break;
+        case dense_prefix:
+          _sd.summarize_dense_prefix(_sd.region_to_addr(beg),
+                                     _sd.region_to_addr(end));
+          break;
+        default:
+          ShouldNotReachHere();
+      }
+    }
+  }
+};
+
+void PSParallelCompact::summarize(SplitInfo& split_info,
+                                  HeapWord* source_beg, HeapWord* source_end,
+                                  HeapWord* target_beg, HeapWord* target_end,
+                                  HeapWord** target_next)
+{
+  ParallelCompactData& sd = summary_data();
+  const size_t beg_region = sd.addr_to_region_idx(source_beg);
+  const size_t end_region = sd.addr_to_region_idx(sd.region_align_up(source_end));
+
+  GCTaskManager* const manager = gc_task_manager();
+  if (manager->active_workers() == 1 ||
+      end_region - beg_region <= PCSummaryTask::ChunkRegions) {
+    bool result = sd.summarize(split_info, source_beg, source_end, NULL,
+                               target_beg, target_end, target_next);
+    assert(result, "source must fit into target");
+    return;
+  }
+
+  log_develop_trace(gc, compaction)(
+      "par summarize:  sb=" PTR_FORMAT " se=" PTR_FORMAT
+      " tb=" PTR_FORMAT " te=" PTR_FORMAT,
+      p2i(source_beg), p2i(source_end), p2i(target_beg), p2i(target_end));
+
+  PCSummaryTask task(sd, &split_info, beg_region, end_region, target_beg);
+  manager->run_task(&task);
+
+  const size_t total = task.prefix_sum();
+  assert(total <= pointer_delta(target_end, target_beg),
+         "source must fit into target");
+
+  task.set_pass(PCSummaryTask::summarize_data);
+  manager->run_task(&task);
+
+  *target_next = target_beg + total;
+}
+
+void PSParallelCompact::summarize_dense_prefix(HeapWord* beg, HeapWord* end)
+{
+  ParallelCompactData& sd = summary_data();
+  const size_t beg_region = sd.addr_to_region_idx(beg);
+  const size_t end_region = sd.addr_to_region_idx(end);
+
+  GCTaskManager* const manager = gc_task_manager();
+  if (manager->active_workers() == 1 ||
+      end_region - beg_region <= PCSummaryTask::ChunkRegions) {
+    sd.summarize_dense_prefix(beg, end);
+    return;
+  }
+
+  PCSummaryTask task(sd, NULL, beg_region, end_region, beg);
+  task.set_pass(PCSummaryTask::dense_prefix);
+  manager->run_task(&task);
+}
+
 void PSParallelCompact::summarize_spaces_quick()
 {
   for (unsigned int i = 0; i < last_space_id; ++i) {
     const MutableSpace* space = _space_info[i].space();
     HeapWord** nta = _space_info[i].new_top_addr();
-    bool result = _summary_data.summarize(_space_info[i].split_info(),
-                                          space->bottom(), space->top(), NULL,
-                                          space->bottom(), space->end(), nta);
-    assert(result, "space must fit into itself");
+    summarize(_space_info[i].split_info(),
+              space->bottom(), space->top(),
+              space->bottom(), space->end(), nta);
     _space_info[i].set_dense_prefix(space->bottom());
   }
 }
@@ -1555,11 +1737,11 @@ PSParallelCompact::summarize_space(SpaceId id, bool maximum_compaction)
       fill_dense_prefix_end(id);
 
       // Compute the destination of each Region, and thus each object.
-      _summary_data.summarize_dense_prefix(space->bottom(), dense_prefix_end);
-      _summary_data.summarize(_space_info[id].split_info(),
-                              dense_prefix_end, space->top(), NULL,
-                              dense_prefix_end, space->end(),
-                              _space_info[id].new_top_addr());
+      summarize_dense_prefix(space->bottom(), dense_prefix_end);
+      summarize(_space_info[id].split_info(),
+                dense_prefix_end, space->top(),
+                dense_prefix_end, space->end(),
+                _space_info[id].new_top_addr());
     }
   }
 
@@ -1661,12 +1843,10 @@ void PSParallelCompact::summary_phase(ParCompactionManager* cm,
                                   SpaceId(id), space->bottom(), space->top());)
     if (live > 0 && live <= available) {
       // All the live data will fit.
-      bool done = _summary_data.summarize(_space_info[id].split_info(),
-                                          space->bottom(), space->top(),
-                                          NULL,
-                                          *new_top_addr, dst_space_end,
-                                          new_top_addr);
-      assert(done, "space must fit into old gen");
+      summarize(_space_info[id].split_info(),
+                space->bottom(), space->top(),
+                *new_top_addr, dst_space_end,
+                new_top_addr);
 
       // Reset the new_top value for the space.
       _space_info[id].set_new_top(space->bottom());
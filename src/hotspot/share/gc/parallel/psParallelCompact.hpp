@@ -412,6 +412,17 @@ public:
                  HeapWord* target_beg, HeapWord* target_end,
                  HeapWord** target_next);
 
+  // Summarize the regions [beg_region, end_region) into the destination
+  // starting at dest_addr and return the end of the destination.  The data
+  // must fit into the destination; no split is done.  Disjoint ranges of
+  // regions may be summarized concurrently, see PSParallelCompact::summarize().
+  HeapWord* summarize_regions(const SplitInfo& split_info,
+                              size_t beg_region, size_t end_region,
+                              HeapWord* dest_addr);
+
+  // Return the amount of data in the regions [beg_region, end_region).
+  size_t data_size_in_regions(size_t beg_region, size_t end_region) const;
+
   void clear();
   void clear_range(size_t beg_region, size_t end_region);
   void clear_range(HeapWord* beg, HeapWord* end) {
@@ -467,6 +478,12 @@ private:
   bool initialize_region_data(size_t region_size);
   PSVirtualSpace* create_vspace(size_t count, size_t element_size);
 
+  // Set the destination_count of cur_region, and the source_region of the
+  // destination regions that start with data from cur_region, for the
+  // words of cur_region that are copied to dest_addr.
+  void summarize_region(const SplitInfo& split_info, size_t cur_region,
+                        HeapWord* dest_addr, size_t words);
+
 private:
   HeapWord*       _region_start;
 #ifdef  ASSERT
@@ -1037,6 +1054,15 @@ class PSParallelCompact : AllStatic {
   // non-empty.
   static void fill_dense_prefix_end(SpaceId id);
 
+  // Versions of ParallelCompactData::summarize() and summarize_dense_prefix()
+  // that split the regions into chunks processed by the heap's workers.  The
+  // source of summarize() must fit entirely into the target.
+  static void summarize(SplitInfo& split_info,
+                        HeapWord* source_beg, HeapWord* source_end,
+                        HeapWord* target_beg, HeapWord* target_end,
+                        HeapWord** target_next);
+  static void summarize_dense_prefix(HeapWord* beg, HeapWord* end);
+
   static void summarize_spaces_quick();
   static void summarize_space(SpaceId id, bool maximum_compaction);
   static void summary_phase(ParCompactionManager* cm, bool maximum_compaction);
@@ -126,6 +126,8 @@ bool PSPromotionManager::post_scavenge(YoungGCTracer& gc_tracer) {
     }
     manager->flush_labs();
   }
+  // The LABs above are carved from the promotion chunks.
+  ParallelScavengeHeap::heap()->old_gen()->flush_promotion_chunks();
   if (!promotion_failure_occurred) {
     // If there was no promotion failure, the preserved mark stacks
     // should be empty.
@@ -51,7 +51,6 @@ class ParCompactionManager;
 
 class PSPromotionManager {
   friend class PSScavenge;
-  friend class PSRefProcTaskExecutor;
  private:
   static PaddedEnd<PSPromotionManager>* _manager_array;
   static OopStarTaskQueueSet*           _stack_array_depth;
@@ -147,8 +146,6 @@ class PSPromotionManager {
                                     uint age, bool tenured,
                                     const PSPromotionLAB* lab);
 
- protected:
-  static OopStarTaskQueueSet* stack_array_depth()   { return _stack_array_depth; }
  public:
   // Static
   static void initialize();
@@ -161,6 +158,8 @@ class PSPromotionManager {
 
   static bool steal_depth(int queue_num, StarTask& t);
 
+  static OopStarTaskQueueSet* stack_array_depth()   { return _stack_array_depth; }
+
   PSPromotionManager();
 
   // Accessors
@@ -25,15 +25,65 @@
 #include "precompiled.hpp"
 #include "gc/shared/allocTracer.hpp"
 #include "jfr/jfrEvents.hpp"
+#include "jfr/support/jfrThreadId.hpp"
+#include "runtime/atomic.hpp"
 #include "runtime/handles.hpp"
+#include "runtime/orderAccess.hpp"
+#include "runtime/os.hpp"
+#include "runtime/thread.inline.hpp"
 #include "utilities/globalDefinitions.hpp"
 #include "utilities/macros.hpp"
 #if INCLUDE_JFR
 #include "jfr/support/jfrAllocationTracer.hpp"
+#include "jfr/support/jfrThreadLocal.hpp"
+#endif
+
+#if INCLUDE_JFR
+// Keeps ObjectAllocationSample events close to FlightRecorderAllocationSampleRate
+// per second by admitting a fixed number of samples in each short time window.
+class AllocationSampleThrottle : AllStatic {
+  static const jlong WINDOWS_PER_SECOND = 10;
+  static volatile jlong _window_end;
+  static volatile size_t _window_count;
+ public:
+  static bool accept() {
+    const jlong now = os::javaTimeNanos();
+    const jlong window_end = OrderAccess::load_acquire(&_window_end);
+    if (now >= window_end) {
+      const jlong next_window_end = now + NANOSECS_PER_SEC / WINDOWS_PER_SECOND;
+      if (Atomic::cmpxchg(next_window_end, &_window_end, window_end) == window_end) {
+        Atomic::store((size_t)0, &_window_count);
+      }
+    }
+    const size_t limit = MAX2<size_t>(FlightRecorderAllocationSampleRate / WINDOWS_PER_SECOND, 1);
+    return Atomic::add((size_t)1, &_window_count) <= limit;
+  }
+};
+
+volatile jlong AllocationSampleThrottle::_window_end = 0;
+volatile size_t AllocationSampleThrottle::_window_count = 0;
+
+// The weight is everything the thread allocated since its last accepted sample,
+// so allocations dropped by the throttle are still accounted for.
+static void send_allocation_sample(Klass* klass, Thread* thread) {
+  if (!EventObjectAllocationSample::is_enabled() || !AllocationSampleThrottle::accept()) {
+    return;
+  }
+  JfrThreadLocal* const tl = thread->jfr_thread_local();
+  const jlong allocated_bytes = thread->cooked_allocated_bytes();
+  EventObjectAllocationSample event;
+  if (event.should_commit()) {
+    event.set_objectClass(klass);
+    event.set_weight(allocated_bytes - tl->sampled_allocated_bytes());
+    event.commit();
+  }
+  tl->set_sampled_allocated_bytes(allocated_bytes);
+}
 #endif
 
 void AllocTracer::send_allocation_outside_tlab(Klass* klass, HeapWord* obj, size_t alloc_size, Thread* thread) {
   JFR_ONLY(JfrAllocationTracer tracer(obj, alloc_size, thread);)
+  JFR_ONLY(send_allocation_sample(klass, thread);)
   EventObjectAllocationOutsideTLAB event;
   if (event.should_commit()) {
     event.set_objectClass(klass);
@@ -44,6 +94,7 @@ void AllocTracer::send_allocation_outside_tlab(Klass* klass, HeapWord* obj, size
 
 void AllocTracer::send_allocation_in_new_tlab(Klass* klass, HeapWord* obj, size_t tlab_size, size_t alloc_size, Thread* thread) {
   JFR_ONLY(JfrAllocationTracer tracer(obj, alloc_size, thread);)
+  JFR_ONLY(send_allocation_sample(klass, thread);)
   EventObjectAllocationInNewTLAB event;
   if (event.should_commit()) {
     event.set_objectClass(klass);
@@ -53,6 +104,20 @@ void AllocTracer::send_allocation_in_new_tlab(Klass* klass, HeapWord* obj, size_
   }
 }
 
+void AllocTracer::send_tlab_waste_event(Thread* thread, size_t desired_size, unsigned refills,
+                                        size_t gc_waste, size_t slow_refill_waste, size_t fast_refill_waste) {
+  EventThreadLocalAllocationBufferWaste event;
+  if (event.should_commit()) {
+    event.set_thread(JFR_THREAD_ID(thread));
+    event.set_desiredSize(desired_size);
+    event.set_refills(refills);
+    event.set_gcWaste(gc_waste);
+    event.set_slowRefillWaste(slow_refill_waste);
+    event.set_fastRefillWaste(fast_refill_waste);
+    event.commit();
+  }
+}
+
 void AllocTracer::send_allocation_requiring_gc_event(size_t size, uint gcId) {
   EventAllocationRequiringGC event;
   if (event.should_commit()) {
@@ -506,6 +506,64 @@ void CardTable::verify_dirty_region(MemRegion mr) {
 }
 #endif
 
+// The card searches below compare whole words against clean_card_row,
+// which works because clean_card has all bits set, and AND four words
+// together in the main loop so that only one compare and branch is needed
+// per four words of cards.
+static const size_t CardsPerWord = BytesPerWord;
+static const size_t CardsPerStride = 4 * CardsPerWord;
+
+static inline bool clean_cards_row(const jbyte* cards) {
+  return *(const intptr_t*)cards == CardTable::clean_card_row_val();
+}
+
+static inline bool clean_cards_stride(const jbyte* cards) {
+  const intptr_t* words = (const intptr_t*)cards;
+  return (words[0] & words[1] & words[2] & words[3]) == CardTable::clean_card_row_val();
+}
+
+jbyte* CardTable::find_first_non_clean_card(jbyte* start, jbyte* end) {
+  jbyte* cur = start;
+  // Check the cards up to the first word boundary one at a time.
+  while (cur < end && !is_aligned(cur, CardsPerWord)) {
+    if (*cur != clean_card) {
+      return cur;
+    }
+    cur++;
+  }
+  while (pointer_delta(end, cur, sizeof(jbyte)) >= CardsPerStride && clean_cards_stride(cur)) {
+    cur += CardsPerStride;
+  }
+  while (pointer_delta(end, cur, sizeof(jbyte)) >= CardsPerWord && clean_cards_row(cur)) {
+    cur += CardsPerWord;
+  }
+  while (cur < end && *cur == clean_card) {
+    cur++;
+  }
+  return cur;
+}
+
+jbyte* CardTable::find_last_non_clean_card(jbyte* start, jbyte* end) {
+  jbyte* cur = end;
+  // Check the cards down to the last word boundary one at a time.
+  while (cur > start && !is_aligned(cur, CardsPerWord)) {
+    if (*(cur - 1) != clean_card) {
+      return cur - 1;
+    }
+    cur--;
+  }
+  while (pointer_delta(cur, start, sizeof(jbyte)) >= CardsPerStride && clean_cards_stride(cur - CardsPerStride)) {
+    cur -= CardsPerStride;
+  }
+  while (pointer_delta(cur, start, sizeof(jbyte)) >= CardsPerWord && clean_cards_row(cur - CardsPerWord)) {
+    cur -= CardsPerWord;
+  }
+  while (cur > start && *(cur - 1) == clean_card) {
+    cur--;
+  }
+  return cur - 1;
+}
+
 void CardTable::print_on(outputStream* st) const {
   st->print_cr("Card table byte_map: [" INTPTR_FORMAT "," INTPTR_FORMAT "] _byte_map_base: " INTPTR_FORMAT,
                p2i(_byte_map), p2i(_byte_map + _byte_map_size), p2i(_byte_map_base));
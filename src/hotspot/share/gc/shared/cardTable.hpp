@@ -143,6 +143,15 @@ public:
   // all of which must be covered.)
   void clear_MemRegion(MemRegion mr);
 
+  // Return the first card in [start, end) that is not clean, or end if all
+  // of them are clean.  Runs of clean cards are skipped several words at a
+  // time, which is what makes the search cheap on mostly clean tables.
+  static jbyte* find_first_non_clean_card(jbyte* start, jbyte* end);
+
+  // Return the last card in [start, end) that is not clean, or start - 1 if
+  // all of them are clean.  The backward counterpart of the above.
+  static jbyte* find_last_non_clean_card(jbyte* start, jbyte* end);
+
   // Return true if "p" is at the start of a card.
   bool is_card_aligned(HeapWord* p) {
     jbyte* pcard = byte_for(p);
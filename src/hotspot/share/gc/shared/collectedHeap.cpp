@@ -568,6 +568,10 @@ void CollectedHeap::unpin_object(JavaThread* thread, oop obj) {
   ShouldNotReachHere();
 }
 
+bool CollectedHeap::is_object_non_movable(oop obj) const {
+  return false;
+}
+
 void CollectedHeap::deduplicate_string(oop str) {
   // Do nothing, unless overridden in subclass.
 }
@@ -68,6 +68,15 @@ class GCMessage : public FormatBuffer<1024> {
 
 class CollectedHeap;
 
+// Iterates over all objects in the heap using several worker threads.
+// Every worker calls object_iterate with its own worker id; together the
+// workers visit each object exactly once.
+class ParallelObjectIterator : public CHeapObj<mtGC> {
+ public:
+  virtual ~ParallelObjectIterator() {}
+  virtual void object_iterate(ObjectClosure* cl, uint worker_id) = 0;
+};
+
 class GCHeapLog : public EventLogBase<GCMessage> {
  private:
   void log_heap(CollectedHeap* heap, bool before);
@@ -432,6 +441,13 @@ class CollectedHeap : public CHeapObj<mtInternal> {
   // over live objects.
   virtual void safe_object_iterate(ObjectClosure* cl) = 0;
 
+  // Returns an iterator that splits the heap among thread_num workers,
+  // or NULL if the collector does not support parallel object iteration.
+  // Must be called at a safepoint; the caller owns the returned iterator.
+  virtual ParallelObjectIterator* parallel_object_iterator(uint thread_num) {
+    return NULL;
+  }
+
   // NOTE! There is no requirement that a collector implement these
   // functions.
   //
@@ -565,6 +581,11 @@ class CollectedHeap : public CHeapObj<mtInternal> {
   virtual oop pin_object(JavaThread* thread, oop obj);
   virtual void unpin_object(JavaThread* thread, oop obj);
 
+  // Returns true if obj is never moved by the GC, e.g. because it lives
+  // in a region that is never evacuated. JNI critical sections on such
+  // an object need neither pinning nor the GCLocker.
+  virtual bool is_object_non_movable(oop obj) const;
+
   // Deduplicate the string, iff the GC supports string deduplication.
   virtual void deduplicate_string(oop str);
 
@@ -244,6 +244,26 @@ void G1NewTracer::report_adaptive_ihop_statistics(size_t threshold,
                                 prediction_active);
 }
 
+void G1NewTracer::report_pause_prediction(const char* prediction_model,
+                                          double predicted_pause_time_ms,
+                                          double pause_time_ms,
+                                          double predicted_update_rs_time_ms,
+                                          double update_rs_time_ms,
+                                          double predicted_scan_rs_time_ms,
+                                          double scan_rs_time_ms,
+                                          double predicted_object_copy_time_ms,
+                                          double object_copy_time_ms) {
+  send_pause_prediction(prediction_model,
+                        predicted_pause_time_ms,
+                        pause_time_ms,
+                        predicted_update_rs_time_ms,
+                        update_rs_time_ms,
+                        predicted_scan_rs_time_ms,
+                        scan_rs_time_ms,
+                        predicted_object_copy_time_ms,
+                        object_copy_time_ms);
+}
+
 void G1OldTracer::report_gc_start_impl(GCCause::Cause cause, const Ticks& timestamp) {
   _shared_gc_info.set_start_timestamp(timestamp);
 }
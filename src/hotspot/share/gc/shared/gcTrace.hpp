@@ -266,6 +266,15 @@ class G1NewTracer : public YoungGCTracer {
                                        double predicted_allocation_rate,
                                        double predicted_marking_length,
                                        bool prediction_active);
+  void report_pause_prediction(const char* prediction_model,
+                               double predicted_pause_time_ms,
+                               double pause_time_ms,
+                               double predicted_update_rs_time_ms,
+                               double update_rs_time_ms,
+                               double predicted_scan_rs_time_ms,
+                               double scan_rs_time_ms,
+                               double predicted_object_copy_time_ms,
+                               double object_copy_time_ms);
  private:
   void send_g1_young_gc_event();
   void send_evacuation_info_event(G1EvacuationInfo* info);
@@ -287,6 +296,15 @@ class G1NewTracer : public YoungGCTracer {
                                      double predicted_allocation_rate,
                                      double predicted_marking_length,
                                      bool prediction_active);
+  void send_pause_prediction(const char* prediction_model,
+                             double predicted_pause_time_ms,
+                             double pause_time_ms,
+                             double predicted_update_rs_time_ms,
+                             double update_rs_time_ms,
+                             double predicted_scan_rs_time_ms,
+                             double scan_rs_time_ms,
+                             double predicted_object_copy_time_ms,
+                             double object_copy_time_ms);
 };
 
 class G1FullGCTracer : public OldGCTracer {
@@ -309,6 +309,35 @@ void G1NewTracer::send_adaptive_ihop_statistics(size_t threshold,
   }
 }
 
+static s8 ms_to_nanos(double ms) {
+  return (s8)(ms * NANOSECS_PER_MILLISEC);
+}
+
+void G1NewTracer::send_pause_prediction(const char* prediction_model,
+                                        double predicted_pause_time_ms,
+                                        double pause_time_ms,
+                                        double predicted_update_rs_time_ms,
+                                        double update_rs_time_ms,
+                                        double predicted_scan_rs_time_ms,
+                                        double scan_rs_time_ms,
+                                        double predicted_object_copy_time_ms,
+                                        double object_copy_time_ms) {
+  EventG1PausePrediction evt;
+  if (evt.should_commit()) {
+    evt.set_gcId(GCId::current());
+    evt.set_predictionModel(prediction_model);
+    evt.set_predictedPauseTime(ms_to_nanos(predicted_pause_time_ms));
+    evt.set_pauseTime(ms_to_nanos(pause_time_ms));
+    evt.set_predictedUpdateRSTime(ms_to_nanos(predicted_update_rs_time_ms));
+    evt.set_updateRSTime(ms_to_nanos(update_rs_time_ms));
+    evt.set_predictedScanRSTime(ms_to_nanos(predicted_scan_rs_time_ms));
+    evt.set_scanRSTime(ms_to_nanos(scan_rs_time_ms));
+    evt.set_predictedObjectCopyTime(ms_to_nanos(predicted_object_copy_time_ms));
+    evt.set_objectCopyTime(ms_to_nanos(object_copy_time_ms));
+    evt.commit();
+  }
+}
+
 #endif // INCLUDE_G1GC
 
 static JfrStructVirtualSpace to_struct(const VirtualSpaceSummary& summary) {
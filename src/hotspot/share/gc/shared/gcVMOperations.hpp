@@ -129,6 +129,7 @@ class VM_GC_HeapInspection: public VM_GC_Operation {
   bool _print_help;
   bool _print_class_stats;
   const char* _columns;
+  uint _parallel_thread_num;
  public:
   VM_GC_HeapInspection(outputStream* out, bool request_full_gc) :
     VM_GC_Operation(0 /* total collections,      dummy, ignored */,
@@ -141,6 +142,7 @@ class VM_GC_HeapInspection: public VM_GC_Operation {
     _print_help = false;
     _print_class_stats = false;
     _columns = NULL;
+    _parallel_thread_num = 1;
   }
 
   ~VM_GC_HeapInspection() {}
@@ -151,6 +153,7 @@ class VM_GC_HeapInspection: public VM_GC_Operation {
   void set_print_help(bool value) {_print_help = value;}
   void set_print_class_stats(bool value) {_print_class_stats = value;}
   void set_columns(const char* value) {_columns = value;}
+  void set_parallel_thread_num(uint value) {_parallel_thread_num = value;}
  protected:
   bool collect();
 };
@@ -209,6 +209,12 @@
             "Use semaphore synchronization for the GC Threads, "            \
             "instead of synchronization based on mutexes")                  \
                                                                             \
+  experimental(uint, GCWorkerDispatchSpinLimit, 0,                          \
+          "Number of spin iterations GC worker threads and the "            \
+          "coordinator use to pick up a task start or completion signal "   \
+          "before blocking. Applies to semaphore synchronization only")     \
+          range(0, max_juint)                                               \
+                                                                            \
   product(bool, UseDynamicNumberOfGCThreads, true,                          \
           "Dynamically choose the number of threads up to a maximum of "    \
           "ParallelGCThreads parallel collectors will use for garbage "     \
@@ -680,7 +686,8 @@
           "Ignore calls to System.gc()")                                    \
                                                                             \
   product(bool, BindGCTaskThreadsToCPUs, false,                             \
-          "Bind GCTaskThreads to CPUs if possible")                         \
+          "Bind GCTaskThreads and parallel GC gang workers to CPUs if "     \
+          "possible")                                                       \
                                                                             \
   product(bool, UseGCTaskAffinity, false,                                   \
           "Use worker affinity when asking for GCTasks")                    \
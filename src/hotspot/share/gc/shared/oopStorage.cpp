@@ -120,7 +120,7 @@ OopStorage::ActiveArray::~ActiveArray() {
 
 OopStorage::ActiveArray* OopStorage::ActiveArray::create(size_t size, AllocFailType alloc_fail) {
   size_t size_in_bytes = blocks_offset() + sizeof(Block*) * size;
-  void* mem = NEW_C_HEAP_ARRAY3(char, size_in_bytes, mtGC, CURRENT_PC, alloc_fail);
+  void* mem = NEW_C_HEAP_ARRAY3(char, size_in_bytes, mtGC, SAMPLED_CURRENT_PC, alloc_fail);
   if (mem == NULL) return NULL;
   return new (mem) ActiveArray(size);
 }
@@ -314,6 +314,21 @@ oop* OopStorage::Block::allocate() {
   }
 }
 
+// Claims all the free entries of the block, returning the bitmask of
+// entries obtained.
+uintx OopStorage::Block::allocate_all() {
+  // Use CAS loop because release may change bitmask outside of lock.
+  uintx allocated = allocated_bitmask();
+  while (true) {
+    assert(!is_full_bitmask(allocated), "attempt to allocate from full block");
+    uintx fetched = Atomic::cmpxchg(~uintx(0), &_allocated_bitmask, allocated);
+    if (fetched == allocated) {
+      return ~allocated;         // CAS succeeded; return claimed entries.
+    }
+    allocated = fetched;         // CAS failed; retry with latest value.
+  }
+}
+
 OopStorage::Block* OopStorage::Block::new_block(const OopStorage* owner) {
   // _data must be first member: aligning block => aligning _data.
   STATIC_ASSERT(_data_pos == 0);
@@ -387,6 +402,12 @@ OopStorage::Block::block_for_ptr(const OopStorage* owner, const oop* ptr) {
 // removed from the _allocation_list so it won't be considered by future
 // allocations until some entries in it are released.
 //
+// allocate(oop**, size_t) is a bulk variant, for clients that cache entries.
+// It claims all the free entries of the first block in the _allocation_list
+// at once, so the block becomes full and is removed from the list.  Entries
+// beyond the number requested are released again, which records a deferred
+// update for the block since it is transitioning from full to not full.
+//
 // release() is performed lock-free. (Note: This means it can't notify the
 // service thread of pending cleanup work.  It must be lock-free because
 // it is called in all kinds of contexts where even quite low ranked locks
@@ -443,6 +464,47 @@ oop* OopStorage::allocate() {
   return result;
 }
 
+size_t OopStorage::allocate(oop** ptrs, size_t size) {
+  assert(size > 0, "precondition");
+  Block* block;
+  uintx taken;
+  {
+    MutexLockerEx ml(_allocation_mutex, Mutex::_no_safepoint_check_flag);
+    if (reduce_deferred_updates()) {
+      notify_needs_cleanup();
+    }
+    block = block_for_allocation();
+    if (block == NULL) return 0; // Block allocation failed.
+    if (block->is_empty()) {
+      // Transitioning from empty to not empty.
+      log_debug(oopstorage, blocks)("%s: block not empty " PTR_FORMAT, name(), p2i(block));
+    }
+    // Take all the remaining entries, which makes the block full.  Must be
+    // done while holding the lock, so that a deferred update can't re-add
+    // the block to the list between the unlink and the bitmask update.
+    taken = block->allocate_all();
+    assert(block->is_full(), "postcondition");
+    // Transitioning from not full to full.
+    log_debug(oopstorage, blocks)("%s: block full " PTR_FORMAT, name(), p2i(block));
+    _allocation_list.unlink(*block);
+  }
+  // Return entries, up to size.
+  size_t num_taken = 0;
+  for ( ; (taken != 0) && (num_taken < size); ++num_taken) {
+    unsigned index = count_trailing_zeros(taken);
+    taken ^= block->bitmask_for_index(index);
+    ptrs[num_taken] = block->get_pointer(index);
+  }
+  // Give back any entries that weren't requested.
+  if (taken != 0) {
+    block->release_entries(taken, this);
+  }
+  Atomic::add(num_taken, &_allocation_count);
+  log_trace(oopstorage, ref)("%s: bulk allocate " SIZE_FORMAT " entries",
+                             name(), num_taken);
+  return num_taken;
+}
+
 bool OopStorage::try_add_block() {
   assert_lock_strong(_allocation_mutex);
   Block* block;
@@ -104,6 +104,19 @@ public:
   // postcondition: *result == NULL.
   oop* allocate();
 
+  // Allocates multiple entries, returning them in the ptrs buffer.  Possibly
+  // faster than making repeated calls to allocate(), since all the free
+  // entries of a block are claimed with a single lock acquisition and
+  // bitmask update.  This is intended for clients that maintain a local
+  // (e.g. per-thread) cache of entries.  Always makes progress, returning
+  // at least one entry unless memory allocation failed, but may return
+  // fewer than size entries.  Returns the number of entries provided.
+  // Locks _allocation_mutex.
+  // precondition: size > 0.
+  // postcondition: result <= size.
+  // postcondition: *ptrs[i] == NULL, for i in [0,result).
+  size_t allocate(oop** ptrs, size_t size);
+
   // Deallocates ptr.  No locking.
   // precondition: ptr is a valid allocated entry.
   // precondition: *ptr == NULL.
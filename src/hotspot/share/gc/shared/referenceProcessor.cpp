@@ -33,11 +33,13 @@
 #include "gc/shared/referenceProcessor.inline.hpp"
 #include "gc/shared/referenceProcessorPhaseTimes.hpp"
 #include "logging/log.hpp"
+#include "logging/logStream.hpp"
 #include "memory/allocation.inline.hpp"
 #include "memory/resourceArea.hpp"
 #include "oops/access.inline.hpp"
 #include "oops/oop.inline.hpp"
 #include "runtime/java.hpp"
+#include "utilities/ticks.hpp"
 
 ReferencePolicy* ReferenceProcessor::_always_clear_soft_ref_policy = NULL;
 ReferencePolicy* ReferenceProcessor::_default_soft_ref_policy      = NULL;
@@ -1220,6 +1222,35 @@ void ReferenceProcessor::preclean_discovered_references(BoolObjectClosure* is_al
                                                         YieldClosure* yield,
                                                         GCTimer* gc_timer) {
   // These lists can be handled here in any order and, indeed, concurrently.
+  // Count the references removed from each kind of list, so the work done
+  // here, outside of the pause, can be reported separately.
+  size_t precleaned[REF_PHANTOM - REF_OTHER] = {};
+  Ticks start_time = Ticks::now();
+  preclean_discovered_references_work(is_alive, keep_alive, complete_gc,
+                                      yield, gc_timer, precleaned);
+  log_preclean_stats((Ticks::now() - start_time).seconds() * MILLIUNITS,
+                     precleaned);
+}
+
+void ReferenceProcessor::log_preclean_stats(double time_ms,
+                                            const size_t* precleaned) const {
+  LogTarget(Debug, gc, phases, ref) lt;
+  if (lt.is_enabled()) {
+    LogStream ls(lt);
+    ls.print_cr("Concurrent Preclean: %.1lfms", time_ms);
+    ls.print_cr("  SoftReference: " SIZE_FORMAT, precleaned[REF_SOFT - REF_SOFT]);
+    ls.print_cr("  WeakReference: " SIZE_FORMAT, precleaned[REF_WEAK - REF_SOFT]);
+    ls.print_cr("  FinalReference: " SIZE_FORMAT, precleaned[REF_FINAL - REF_SOFT]);
+    ls.print_cr("  PhantomReference: " SIZE_FORMAT, precleaned[REF_PHANTOM - REF_SOFT]);
+  }
+}
+
+void ReferenceProcessor::preclean_discovered_references_work(BoolObjectClosure* is_alive,
+                                                             OopClosure* keep_alive,
+                                                             VoidClosure* complete_gc,
+                                                             YieldClosure* yield,
+                                                             GCTimer* gc_timer,
+                                                             size_t* precleaned) {
 
   // Soft references
   {
@@ -1230,7 +1261,8 @@ void ReferenceProcessor::preclean_discovered_references(BoolObjectClosure* is_al
         return;
       }
       if (preclean_discovered_reflist(_discoveredSoftRefs[i], is_alive,
-                                      keep_alive, complete_gc, yield)) {
+                                      keep_alive, complete_gc, yield,
+                                      &precleaned[REF_SOFT - REF_SOFT])) {
         log_reflist("SoftRef abort: ", _discoveredSoftRefs, _max_num_queues);
         return;
       }
@@ -1247,7 +1279,8 @@ void ReferenceProcessor::preclean_discovered_references(BoolObjectClosure* is_al
         return;
       }
       if (preclean_discovered_reflist(_discoveredWeakRefs[i], is_alive,
-                                      keep_alive, complete_gc, yield)) {
+                                      keep_alive, complete_gc, yield,
+                                      &precleaned[REF_WEAK - REF_SOFT])) {
         log_reflist("WeakRef abort: ", _discoveredWeakRefs, _max_num_queues);
         return;
       }
@@ -1264,7 +1297,8 @@ void ReferenceProcessor::preclean_discovered_references(BoolObjectClosure* is_al
         return;
       }
       if (preclean_discovered_reflist(_discoveredFinalRefs[i], is_alive,
-                                      keep_alive, complete_gc, yield)) {
+                                      keep_alive, complete_gc, yield,
+                                      &precleaned[REF_FINAL - REF_SOFT])) {
         log_reflist("FinalRef abort: ", _discoveredFinalRefs, _max_num_queues);
         return;
       }
@@ -1281,7 +1315,8 @@ void ReferenceProcessor::preclean_discovered_references(BoolObjectClosure* is_al
         return;
       }
       if (preclean_discovered_reflist(_discoveredPhantomRefs[i], is_alive,
-                                      keep_alive, complete_gc, yield)) {
+                                      keep_alive, complete_gc, yield,
+                                      &precleaned[REF_PHANTOM - REF_SOFT])) {
         log_reflist("PhantomRef abort: ", _discoveredPhantomRefs, _max_num_queues);
         return;
       }
@@ -1302,10 +1337,12 @@ bool ReferenceProcessor::preclean_discovered_reflist(DiscoveredList&    refs_lis
                                                      BoolObjectClosure* is_alive,
                                                      OopClosure*        keep_alive,
                                                      VoidClosure*       complete_gc,
-                                                     YieldClosure*      yield) {
+                                                     YieldClosure*      yield,
+                                                     size_t*            removed) {
   DiscoveredListIterator iter(refs_list, keep_alive, is_alive);
   while (iter.has_next()) {
     if (yield->should_return_fine_grain()) {
+      *removed += iter.removed();
       return true;
     }
     iter.load_ptrs(DEBUG_ONLY(true /* allow_null_referent */));
@@ -1325,6 +1362,7 @@ bool ReferenceProcessor::preclean_discovered_reflist(DiscoveredList&    refs_lis
   }
   // Close the reachable set
   complete_gc->do_void();
+  *removed += iter.removed();
 
   if (iter.processed() > 0) {
     log_develop_trace(gc, ref)(" Dropped " SIZE_FORMAT " Refs out of " SIZE_FORMAT " Refs in discovered list " INTPTR_FORMAT,
@@ -338,15 +338,31 @@ private:
   // occupying the i / _num_queues slot.
   const char* list_name(uint i);
 
+  // Precleans all the discovered lists, accumulating the number of
+  // references removed from each kind of list into precleaned, indexed
+  // by reference type relative to REF_SOFT.
+  void preclean_discovered_references_work(BoolObjectClosure* is_alive,
+                                           OopClosure*        keep_alive,
+                                           VoidClosure*       complete_gc,
+                                           YieldClosure*      yield,
+                                           GCTimer*           gc_timer,
+                                           size_t*            precleaned);
+
+  // Logs the time and per reference type counts of a preclean, which
+  // runs outside the pause and is not part of ReferenceProcessorPhaseTimes.
+  void log_preclean_stats(double time_ms, const size_t* precleaned) const;
+
   // "Preclean" the given discovered reference list by removing references with
   // the attributes mentioned in preclean_discovered_references().
   // Supports both normal and fine grain yielding.
+  // Adds the number of references removed from the list to removed.
   // Returns whether the operation should be aborted.
   bool preclean_discovered_reflist(DiscoveredList&    refs_list,
                                    BoolObjectClosure* is_alive,
                                    OopClosure*        keep_alive,
                                    VoidClosure*       complete_gc,
-                                   YieldClosure*      yield);
+                                   YieldClosure*      yield,
+                                   size_t*            removed);
 
   // round-robin mod _num_queues (not: _not_ mod _max_num_queues)
   uint next_id() {
@@ -219,6 +219,7 @@ uintx                    StringDedupTable::_rehash_count = 0;
 
 StringDedupTable*        StringDedupTable::_resized_table = NULL;
 StringDedupTable*        StringDedupTable::_rehashed_table = NULL;
+StringDedupTable*        StringDedupTable::_prepared_table = NULL;
 volatile size_t          StringDedupTable::_claimed_index = 0;
 
 StringDedupTable::StringDedupTable(size_t size, jint hash_seed) :
@@ -400,7 +401,7 @@ bool StringDedupTable::is_rehashing() {
   return _rehashed_table != NULL;
 }
 
-StringDedupTable* StringDedupTable::prepare_resize() {
+size_t StringDedupTable::resize_target_size() {
   size_t size = _table->_size;
 
   // Check if the hashtable needs to be resized
@@ -426,6 +427,27 @@ StringDedupTable* StringDedupTable::prepare_resize() {
       size /= 4;
     }
   } else {
+    // Resize not needed
+    return 0;
+  }
+
+  return size;
+}
+
+StringDedupTable* StringDedupTable::take_prepared_table(size_t size, jint hash_seed) {
+  StringDedupTable* table = _prepared_table;
+  _prepared_table = NULL;
+  if (table != NULL && table->_size == size && table->_hash_seed == hash_seed) {
+    assert(table->_entries == 0, "Prepared table must be empty");
+    return table;
+  }
+  delete table;
+  return new StringDedupTable(size, hash_seed);
+}
+
+StringDedupTable* StringDedupTable::prepare_resize() {
+  size_t size = resize_target_size();
+  if (size == 0) {
     // Resize not needed
     return NULL;
   }
@@ -436,9 +458,49 @@ StringDedupTable* StringDedupTable::prepare_resize() {
   // Update max cache size
   _entry_cache->set_max_size(size * _max_cache_factor);
 
-  // Allocate the new table. The new table will be populated by workers
+  // Get the new table. The new table will be populated by workers
   // calling unlink_or_oops_do() and finally installed by finish_resize().
-  return new StringDedupTable(size, _table->_hash_seed);
+  return take_prepared_table(size, _table->_hash_seed);
+}
+
+void StringDedupTable::prepare_concurrent_resize() {
+  size_t size;
+  jint hash_seed;
+  StringDedupTable* stale = NULL;
+  {
+    // Joining the suspendible thread set excludes safepoints, where the
+    // table may be resized or rehashed and the prepared table taken.
+    SuspendibleThreadSetJoiner sts_join;
+    size = resize_target_size();
+    hash_seed = _table->_hash_seed;
+    if (_prepared_table != NULL &&
+        (_prepared_table->_size != size || _prepared_table->_hash_seed != hash_seed)) {
+      // No longer useful, e.g. the table has been resized or rehashed since.
+      stale = _prepared_table;
+      _prepared_table = NULL;
+    }
+  }
+  delete stale;
+
+  if (size == 0 || _prepared_table != NULL) {
+    // Resize not needed, or already prepared.
+    return;
+  }
+
+  // Allocate and clear the buckets outside of the suspendible thread set.
+  StringDedupTable* table = new StringDedupTable(size, hash_seed);
+  log_trace(gc, stringdedup)("Prepared table for resize, size: " SIZE_FORMAT, size);
+  {
+    SuspendibleThreadSetJoiner sts_join;
+    if (_table->_hash_seed == hash_seed &&
+        resize_target_size() == size &&
+        _prepared_table == NULL) {
+      _prepared_table = table;
+      table = NULL;
+    }
+  }
+  // Table is no longer wanted if a GC changed the table in between.
+  delete table;
 }
 
 void StringDedupTable::finish_resize(StringDedupTable* resized_table) {
@@ -153,6 +153,11 @@ private:
   static StringDedupTable*        _resized_table;
   static StringDedupTable*        _rehashed_table;
 
+  // An empty table allocated ahead of time by the deduplication thread,
+  // for use by the next resize. Only accessed by that thread while joined
+  // to the suspendible thread set, or at a safepoint.
+  static StringDedupTable*        _prepared_table;
+
   StringDedupTable(size_t size, jint hash_seed = 0);
   ~StringDedupTable();
 
@@ -215,6 +220,14 @@ private:
   static bool is_resizing();
   static bool is_rehashing();
 
+  // Returns the size the table should be resized to, or 0 if no resize
+  // is needed.
+  static size_t resize_target_size();
+
+  // Returns an empty hashtable with the given size and hash seed, using
+  // the prepared table if it matches.
+  static StringDedupTable* take_prepared_table(size_t size, jint hash_seed);
+
   // If a table resize is needed, returns a newly allocated empty
   // hashtable of the proper size.
   static StringDedupTable* prepare_resize();
@@ -247,6 +260,12 @@ public:
   // If the table entry cache has grown too large, delete overflowed entries.
   static void clean_entry_cache();
 
+  // If the table will need to be resized, allocate the new table now,
+  // so that the next GC doesn't have to allocate and clear it during
+  // the pause. Called by the deduplication thread while not joined to
+  // the suspendible thread set.
+  static void prepare_concurrent_resize();
+
   // GC support
   static void gc_prologue(bool resize_and_rehash_table);
   static void gc_epilogue();
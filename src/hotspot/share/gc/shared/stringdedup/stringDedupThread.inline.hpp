@@ -79,6 +79,7 @@ void StringDedupThreadImpl<S>::do_deduplication() {
     }
 
     StringDedupTable::clean_entry_cache();
+    StringDedupTable::prepare_concurrent_resize();
   }
 }
 
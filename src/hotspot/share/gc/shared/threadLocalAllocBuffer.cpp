@@ -23,6 +23,7 @@
  */
 
 #include "precompiled.hpp"
+#include "gc/shared/allocTracer.hpp"
 #include "gc/shared/collectedHeap.hpp"
 #include "gc/shared/threadLocalAllocBuffer.inline.hpp"
 #include "logging/log.hpp"
@@ -57,21 +58,31 @@ void ThreadLocalAllocBuffer::accumulate_and_reset_statistics(ThreadLocalAllocSta
 
   print_stats("gc");
 
+  // Update allocation history if a reasonable amount of eden was allocated.
+  // This is done even if the thread didn't refill since the last GC, so
+  // that the desired size of a thread whose allocation rate dropped decays,
+  // rather than staying large and wasting eden at every refill and GC.
+  bool update_allocation_history = used > 0.5 * capacity;
+
+  if (update_allocation_history) {
+    // Average the fraction of eden allocated in a tlab by this
+    // thread for use in the next resize operation.
+    // _gc_waste is not subtracted because it's included in
+    // "used".
+    // The result can be larger than 1.0 due to direct to old allocations.
+    // These allocations should ideally not be counted but since it is not possible
+    // to filter them out here we just cap the fraction to be at most 1.0.
+    double alloc_frac = MIN2(1.0, (double) allocated_since_last_gc / used);
+    _allocation_fraction.sample(alloc_frac);
+  }
+
   if (_number_of_refills > 0) {
-    // Update allocation history if a reasonable amount of eden was allocated.
-    bool update_allocation_history = used > 0.5 * capacity;
-
-    if (update_allocation_history) {
-      // Average the fraction of eden allocated in a tlab by this
-      // thread for use in the next resize operation.
-      // _gc_waste is not subtracted because it's included in
-      // "used".
-      // The result can be larger than 1.0 due to direct to old allocations.
-      // These allocations should ideally not be counted but since it is not possible
-      // to filter them out here we just cap the fraction to be at most 1.0.
-      double alloc_frac = MIN2(1.0, (double) allocated_since_last_gc / used);
-      _allocation_fraction.sample(alloc_frac);
-    }
+    AllocTracer::send_tlab_waste_event(thr,
+                                       desired_size() * HeapWordSize,
+                                       _number_of_refills,
+                                       _gc_waste * HeapWordSize,
+                                       _slow_refill_waste * HeapWordSize,
+                                       _fast_refill_waste * HeapWordSize);
 
     stats->update_fast_allocations(_number_of_refills,
                                    _allocated_size,
@@ -85,6 +85,15 @@ uint WeakProcessor::ergo_workers(uint max_workers) {
   return static_cast<uint>(nworkers);
 }
 
+uint WeakProcessor::ergo_storage_workers(const OopStorage* storage, uint max_workers) {
+  if (ReferencesPerThread == 0) {
+    return max_workers;
+  }
+  size_t nworkers = 1 + (storage->allocation_count() / ReferencesPerThread);
+  nworkers = MIN2(nworkers, static_cast<size_t>(max_workers));
+  return static_cast<uint>(nworkers);
+}
+
 void WeakProcessor::Task::initialize() {
   assert(_nworkers != 0, "must be");
   assert(_phase_times == NULL || _nworkers <= _phase_times->max_threads(),
@@ -97,11 +106,17 @@ void WeakProcessor::Task::initialize() {
 
   uint storage_count = WeakProcessorPhases::oop_storage_phase_count;
   _storage_states = NEW_C_HEAP_ARRAY(StorageState, storage_count, mtGC);
+  _storage_nworkers = NEW_C_HEAP_ARRAY(uint, storage_count, mtGC);
 
+  // Each storage is processed by only as many of the task's workers as
+  // its size warrants; the remaining workers skip that phase.  Within a
+  // phase the participating workers claim blocks through the ParState.
   StorageState* states = _storage_states;
   FOR_EACH_WEAK_PROCESSOR_OOP_STORAGE_PHASE(phase) {
     OopStorage* storage = WeakProcessorPhases::oop_storage(phase);
-    new (states++) StorageState(storage, _nworkers);
+    uint nworkers = ergo_storage_workers(storage, _nworkers);
+    _storage_nworkers[WeakProcessorPhases::oop_storage_index(phase)] = nworkers;
+    new (states++) StorageState(storage, nworkers);
   }
   StringTable::reset_dead_counter();
 }
@@ -110,7 +125,8 @@ WeakProcessor::Task::Task(uint nworkers) :
   _phase_times(NULL),
   _nworkers(nworkers),
   _serial_phases_done(WeakProcessorPhases::serial_phase_count),
-  _storage_states(NULL)
+  _storage_states(NULL),
+  _storage_nworkers(NULL)
 {
   initialize();
 }
@@ -119,7 +135,8 @@ WeakProcessor::Task::Task(WeakProcessorPhaseTimes* phase_times, uint nworkers) :
   _phase_times(phase_times),
   _nworkers(nworkers),
   _serial_phases_done(WeakProcessorPhases::serial_phase_count),
-  _storage_states(NULL)
+  _storage_states(NULL),
+  _storage_nworkers(NULL)
 {
   initialize();
 }
@@ -133,6 +150,9 @@ WeakProcessor::Task::~Task() {
     }
     FREE_C_HEAP_ARRAY(StorageState, _storage_states);
   }
+  if (_storage_nworkers != NULL) {
+    FREE_C_HEAP_ARRAY(uint, _storage_nworkers);
+  }
   StringTable::finish_dead_counter();
 }
 
@@ -70,6 +70,12 @@ public:
   class Task;
 
 private:
+  // Number of workers to use for the phase processing storage, bounded
+  // by max_workers.  Like ergo_workers(), but for a single OopStorage,
+  // so small storages don't have every worker wake up to find nothing
+  // left to claim.
+  static uint ergo_storage_workers(const OopStorage* storage, uint max_workers);
+
   class GangTask;
 };
 
@@ -80,6 +86,7 @@ class WeakProcessor::Task {
   uint _nworkers;
   SubTasksDone _serial_phases_done;
   StorageState* _storage_states;
+  uint* _storage_nworkers;
 
   void initialize();
 
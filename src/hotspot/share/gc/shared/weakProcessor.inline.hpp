@@ -105,9 +105,13 @@ void WeakProcessor::Task::work(uint worker_id,
         }
       }
     } else {
+      uint storage_index = WeakProcessorPhases::oop_storage_index(phase);
+      if (worker_id >= _storage_nworkers[storage_index]) {
+        // Storage is too small to be worth this worker's participation.
+        continue;
+      }
       CountingSkippedIsAliveClosure<IsAlive, KeepAlive> cl(is_alive, keep_alive);
       WeakProcessorPhaseTimeTracker pt(_phase_times, phase, worker_id);
-      uint storage_index = WeakProcessorPhases::oop_storage_index(phase);
       _storage_states[storage_index].oops_do(&cl);
       if (_phase_times != NULL) {
         _phase_times->record_worker_items(worker_id, phase, cl.num_dead(), cl.num_total());
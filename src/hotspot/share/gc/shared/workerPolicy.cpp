@@ -121,6 +121,11 @@ uint WorkerPolicy::calc_default_active_workers(uintx total_workers,
 
   new_active_workers = MIN2(max_active_workers, (uintx) total_workers);
 
+  // Follow the processors currently available to the VM, which can
+  // change at run time, e.g. with the CPU quota of a container.
+  new_active_workers = MAX2(min_workers,
+                            MIN2(new_active_workers, (uintx) os::active_processor_count()));
+
   // Increase GC workers instantly but decrease them more
   // slowly.
   if (new_active_workers < prev_active_workers) {
@@ -32,6 +32,7 @@
 #include "runtime/os.hpp"
 #include "runtime/semaphore.hpp"
 #include "runtime/thread.inline.hpp"
+#include "runtime/timer.hpp"
 
 // Definitions of WorkGang methods.
 
@@ -109,6 +110,11 @@ void AbstractWorkGang::threads_do(ThreadClosure* tc) const {
 //
 // Semaphores don't require the worker threads to re-claim the lock when they wake up.
 // This helps lowering the latency when starting and stopping the worker threads.
+//
+// With GCWorkerDispatchSpinLimit, threads spin for a bounded number of
+// iterations trying to acquire a semaphore before blocking on it. Back-to-back
+// tasks within a pause are then usually picked up by still spinning workers,
+// without a blocking wait and wakeup per task.
 class SemaphoreGangTaskDispatcher : public GangTaskDispatcher {
   // The task currently being dispatched to the GangWorkers.
   AbstractGangTask* _task;
@@ -116,6 +122,12 @@ class SemaphoreGangTaskDispatcher : public GangTaskDispatcher {
   volatile uint _started;
   volatile uint _not_finished;
 
+  // Elapsed counter value when the current task was dispatched, or 0 if
+  // start latencies are not being measured.
+  jlong _dispatch_counter;
+  // Largest delay between dispatch and a worker starting the current task.
+  volatile jlong _max_start_latency;
+
   // Semaphore used to start the GangWorkers.
   Semaphore* _start_semaphore;
   // Semaphore used to notify the coordinator that all workers are done.
@@ -126,6 +138,8 @@ public:
       _task(NULL),
       _started(0),
       _not_finished(0),
+      _dispatch_counter(0),
+      _max_start_latency(0),
       _start_semaphore(new Semaphore()),
       _end_semaphore(new Semaphore())
 { }
@@ -135,19 +149,52 @@ public:
     delete _end_semaphore;
   }
 
+  // Acquire semaphore, spinning for a bounded number of iterations
+  // before blocking.
+  static void spin_then_wait(Semaphore* semaphore) {
+    if (os::is_MP()) {
+      for (uint i = 0; i < GCWorkerDispatchSpinLimit; ++i) {
+        if (semaphore->trywait()) {
+          return;
+        }
+        SpinPause();
+      }
+    }
+    semaphore->wait();
+  }
+
+  void record_start_latency() {
+    jlong latency = os::elapsed_counter() - _dispatch_counter;
+    jlong cur = _max_start_latency;
+    while (latency > cur) {
+      jlong fetched = Atomic::cmpxchg(latency, &_max_start_latency, cur);
+      if (fetched == cur) break;
+      cur = fetched;
+    }
+  }
+
   void coordinator_execute_on_workers(AbstractGangTask* task, uint num_workers) {
     // No workers are allowed to read the state variables until they have been signaled.
     _task         = task;
     _not_finished = num_workers;
+    bool measure = log_is_enabled(Debug, gc, workgang);
+    _max_start_latency = 0;
+    _dispatch_counter  = measure ? os::elapsed_counter() : 0;
 
     // Dispatch 'num_workers' number of tasks.
     _start_semaphore->signal(num_workers);
 
     // Wait for the last worker to signal the coordinator.
-    _end_semaphore->wait();
+    spin_then_wait(_end_semaphore);
 
     // No workers are allowed to read the state variables after the coordinator has been signaled.
     assert(_not_finished == 0, "%d not finished workers?", _not_finished);
+    if (measure) {
+      log_debug(gc, workgang)("%s: %u workers, max start latency %.3fms, total %.3fms",
+                              task->name(), num_workers,
+                              TimeHelper::counter_to_millis(_max_start_latency),
+                              TimeHelper::counter_to_millis(os::elapsed_counter() - _dispatch_counter));
+    }
     _task    = NULL;
     _started = 0;
 
@@ -155,7 +202,11 @@ public:
 
   WorkData worker_wait_for_task() {
     // Wait for the coordinator to dispatch a task.
-    _start_semaphore->wait();
+    spin_then_wait(_start_semaphore);
+
+    if (_dispatch_counter != 0) {
+      record_start_latency();
+    }
 
     uint num_started = Atomic::add(1u, &_started);
 
@@ -300,6 +351,20 @@ void AbstractGangWorker::initialize() {
   assert(_gang != NULL, "No gang to run in");
   os::set_priority(this, NearMaxPriority);
   log_develop_trace(gc, workgang)("Running gang worker for gang %s id %u", gang()->name(), id());
+  if (BindGCTaskThreadsToCPUs && is_GC_task_thread()) {
+    // Worker i gets the processor the os hands out i-th, so that the
+    // workers that are active together are placed as the os prefers.
+    uint* distribution = NEW_C_HEAP_ARRAY(uint, id() + 1, mtGC);
+    if (os::distribute_processes(id() + 1, distribution)) {
+      log_trace(gc, task, thread)("Binding gang worker %s#%u to processor %u",
+                                  gang()->name(), id(), distribution[id()]);
+      if (!os::bind_to_processor(distribution[id()])) {
+        log_debug(gc, task, thread)("Couldn't bind gang worker %s#%u to processor %u",
+                                    gang()->name(), id(), distribution[id()]);
+      }
+    }
+    FREE_C_HEAP_ARRAY(uint, distribution);
+  }
   // The VM thread should not execute here because MutexLocker's are used
   // as (opposed to MutexLockerEx's).
   assert(!Thread::current()->is_VM_thread(), "VM thread should not be part"
@@ -80,6 +80,11 @@ void ShenandoahArguments::initialize() {
     FLAG_SET_DEFAULT(UseNUMAInterleaving, true);
   }
 
+  if (ShenandoahNUMARegionAffinity && !UseNUMA) {
+    warning("ShenandoahNUMARegionAffinity requires UseNUMA, disabling");
+    FLAG_SET_DEFAULT(ShenandoahNUMARegionAffinity, false);
+  }
+
   FLAG_SET_DEFAULT(ParallelGCThreads,
                    WorkerPolicy::parallel_worker_threads());
 
@@ -29,6 +29,7 @@
 #include "gc/shenandoah/shenandoahCollectorPolicy.hpp"
 #include "gc/shenandoah/shenandoahHeap.inline.hpp"
 #include "gc/shenandoah/shenandoahHeuristics.hpp"
+#include "gc/shenandoah/shenandoahPacer.hpp"
 #include "gc/shenandoah/shenandoahTraversalGC.hpp"
 #include "memory/iterator.inline.hpp"
 #include "runtime/interfaceSupport.inline.hpp"
@@ -373,4 +374,7 @@ void ShenandoahBarrierSet::on_thread_detach(JavaThread* thread) {
   if (gclab != NULL) {
     gclab->retire();
   }
+  if (ShenandoahPacing) {
+    _heap->pacer()->print_thread_delay(thread);
+  }
 }
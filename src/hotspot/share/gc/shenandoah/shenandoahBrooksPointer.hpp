@@ -41,6 +41,14 @@ class ShenandoahBrooksPointer {
    *     means *_offset and *_size calls are NOT interchangeable. The accesses
    *     to forwarding ptrs should always be via *_offset. Storage size
    *     calculations should always be via *_size.
+   *
+   *  c. The forwarding ptr costs one extra word for every object, which is
+   *     significant for heaps dominated by small objects. Dropping it requires
+   *     forwarding through the mark word instead, with barriers that resolve
+   *     the forwardee when references are loaded rather than when objects are
+   *     accessed. All users of this class, and the barrier expansion in the
+   *     interpreter, C1 and C2, assume the slot is always present and points
+   *     to self unless the object is evacuated.
    */
 
 public:
@@ -34,11 +34,62 @@ ShenandoahFreeSet::ShenandoahFreeSet(ShenandoahHeap* heap, size_t max_regions) :
   _heap(heap),
   _mutator_free_bitmap(max_regions, mtGC),
   _collector_free_bitmap(max_regions, mtGC),
-  _max(max_regions)
+  _max(max_regions),
+  _numa_max_node(-1),
+  _numa_beg(NULL),
+  _numa_end(NULL),
+  _numa_mutator_cursor(NULL),
+  _numa_collector_cursor(NULL)
 {
   clear_internal();
 }
 
+ShenandoahFreeSet::~ShenandoahFreeSet() {
+  FREE_C_HEAP_ARRAY(size_t, _numa_beg);
+  FREE_C_HEAP_ARRAY(size_t, _numa_end);
+  FREE_C_HEAP_ARRAY(size_t, _numa_mutator_cursor);
+  FREE_C_HEAP_ARRAY(size_t, _numa_collector_cursor);
+}
+
+void ShenandoahFreeSet::initialize_numa_stripes() {
+  assert(_numa_max_node < 0, "Should be initialized only once");
+
+  int max_node = -1;
+  for (size_t idx = 0; idx < _max; idx++) {
+    max_node = MAX2(max_node, _heap->get_region(idx)->numa_node());
+  }
+  if (max_node < 0) {
+    return;
+  }
+
+  size_t nodes = (size_t)max_node + 1;
+  _numa_beg = NEW_C_HEAP_ARRAY(size_t, nodes, mtGC);
+  _numa_end = NEW_C_HEAP_ARRAY(size_t, nodes, mtGC);
+  _numa_mutator_cursor = NEW_C_HEAP_ARRAY(size_t, nodes, mtGC);
+  _numa_collector_cursor = NEW_C_HEAP_ARRAY(size_t, nodes, mtGC);
+  for (size_t n = 0; n < nodes; n++) {
+    _numa_beg[n] = _max;
+    _numa_end[n] = 0;
+  }
+  for (size_t idx = 0; idx < _max; idx++) {
+    int node = _heap->get_region(idx)->numa_node();
+    if (node >= 0) {
+      assert(_numa_end[node] == 0 || _numa_end[node] == idx, "Stripes should be contiguous");
+      _numa_beg[node] = MIN2(_numa_beg[node], idx);
+      _numa_end[node] = idx + 1;
+    }
+  }
+  _numa_max_node = max_node;
+  reset_numa_cursors();
+}
+
+void ShenandoahFreeSet::reset_numa_cursors() {
+  for (int n = 0; n <= _numa_max_node; n++) {
+    _numa_mutator_cursor[n] = _numa_beg[n];
+    _numa_collector_cursor[n] = _numa_end[n];
+  }
+}
+
 void ShenandoahFreeSet::increase_used(size_t num_bytes) {
   assert_heaplock_owned_by_current_thread();
   _used += num_bytes;
@@ -59,7 +110,70 @@ bool ShenandoahFreeSet::is_collector_free(size_t idx) const {
   return _collector_free_bitmap.at(idx);
 }
 
+HeapWord* ShenandoahFreeSet::allocate_single_local(ShenandoahAllocRequest& req, bool& in_new_region) {
+  // Same as the fast paths in allocate_single(), but only considers the stripe
+  // of regions bound to the NUMA node of the allocating thread. The scan starts
+  // at the cursor of the node, and moves the cursor past the regions at the
+  // start of the scan that are no longer free, so that repeated allocations
+  // do not walk the retired regions of the stripe again.
+  const int node = os::numa_get_group_id();
+  if (node < 0 || node > _numa_max_node) {
+    return NULL;
+  }
+
+  switch (req.type()) {
+    case ShenandoahAllocRequest::_alloc_tlab:
+    case ShenandoahAllocRequest::_alloc_shared: {
+      _numa_mutator_cursor[node] = MAX2(_numa_mutator_cursor[node], _mutator_leftmost);
+      size_t end = MIN2(_numa_end[node], _mutator_rightmost + 1);
+      for (size_t idx = _numa_mutator_cursor[node]; idx < end; idx++) {
+        if (is_mutator_free(idx)) {
+          HeapWord* result = try_allocate_in(_heap->get_region(idx), req, in_new_region);
+          if (result != NULL) {
+            return result;
+          }
+        }
+        if (!is_mutator_free(idx) && _numa_mutator_cursor[node] == idx) {
+          _numa_mutator_cursor[node] = idx + 1;
+        }
+      }
+      break;
+    }
+    case ShenandoahAllocRequest::_alloc_gclab:
+    case ShenandoahAllocRequest::_alloc_shared_gc: {
+      _numa_collector_cursor[node] = MIN2(_numa_collector_cursor[node], _collector_rightmost + 1);
+      size_t beg = MAX2(_numa_beg[node], _collector_leftmost);
+      for (size_t c = _numa_collector_cursor[node]; c > beg; c--) {
+        size_t idx = c - 1;
+        if (is_collector_free(idx)) {
+          HeapWord* result = try_allocate_in(_heap->get_region(idx), req, in_new_region);
+          if (result != NULL) {
+            return result;
+          }
+        }
+        if (!is_collector_free(idx) && _numa_collector_cursor[node] == c) {
+          _numa_collector_cursor[node] = idx;
+        }
+      }
+      break;
+    }
+    default:
+      ShouldNotReachHere();
+  }
+
+  return NULL;
+}
+
 HeapWord* ShenandoahFreeSet::allocate_single(ShenandoahAllocRequest& req, bool& in_new_region) {
+  // With NUMA region affinity, try the regions local to the allocating thread first.
+  // This keeps mutator allocations and evacuations by GC workers on the same node.
+  if (ShenandoahNUMARegionAffinity) {
+    HeapWord* result = allocate_single_local(req, in_new_region);
+    if (result != NULL) {
+      return result;
+    }
+  }
+
   // Scan the bitmap looking for a first fit.
   //
   // Leftmost and rightmost bounds provide enough caching to walk bitmap efficiently. Normally,
@@ -385,6 +499,11 @@ void ShenandoahFreeSet::flip_to_gc(ShenandoahHeapRegion* r) {
   _collector_leftmost = MIN2(idx, _collector_leftmost);
   _collector_rightmost = MAX2(idx, _collector_rightmost);
 
+  int node = r->numa_node();
+  if (node >= 0 && node <= _numa_max_node) {
+    _numa_collector_cursor[node] = MAX2(idx + 1, _numa_collector_cursor[node]);
+  }
+
   _capacity -= alloc_capacity(r);
 
   if (touches_bounds(idx)) {
@@ -407,6 +526,7 @@ void ShenandoahFreeSet::clear_internal() {
   _collector_rightmost = 0;
   _capacity = 0;
   _used = 0;
+  reset_numa_cursors();
 }
 
 void ShenandoahFreeSet::rebuild() {
@@ -42,6 +42,17 @@ private:
   size_t _capacity;
   size_t _used;
 
+  // With NUMA region affinity, the regions of NUMA node n are the stripe
+  // [_numa_beg[n]; _numa_end[n]). There are no free regions of node n below
+  // the mutator cursor or at and above the collector cursor of the node.
+  // The cursors only move past regions that left the free set, and are
+  // reset when the free set is cleared.
+  int _numa_max_node;
+  size_t* _numa_beg;
+  size_t* _numa_end;
+  size_t* _numa_mutator_cursor;
+  size_t* _numa_collector_cursor;
+
   void assert_bounds() const NOT_DEBUG_RETURN;
   void assert_heaplock_owned_by_current_thread() const NOT_DEBUG_RETURN;
   void assert_heaplock_not_owned_by_current_thread() const NOT_DEBUG_RETURN;
@@ -51,10 +62,13 @@ private:
 
   HeapWord* try_allocate_in(ShenandoahHeapRegion* region, ShenandoahAllocRequest& req, bool& in_new_region);
   HeapWord* allocate_single(ShenandoahAllocRequest& req, bool& in_new_region);
+  HeapWord* allocate_single_local(ShenandoahAllocRequest& req, bool& in_new_region);
   HeapWord* allocate_contiguous(ShenandoahAllocRequest& req);
 
   void flip_to_gc(ShenandoahHeapRegion* r);
 
+  void reset_numa_cursors();
+
   void recompute_bounds();
   void adjust_bounds();
   bool touches_bounds(size_t num) const;
@@ -73,6 +87,11 @@ private:
 
 public:
   ShenandoahFreeSet(ShenandoahHeap* heap, size_t max_regions);
+  ~ShenandoahFreeSet();
+
+  // Record the NUMA stripes of the regions. Called once the regions are
+  // bound to their nodes, before the free set is first rebuilt.
+  void initialize_numa_stripes();
 
   void clear();
   void rebuild();
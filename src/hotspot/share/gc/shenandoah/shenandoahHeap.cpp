@@ -161,6 +161,22 @@ jint ShenandoahHeap::initialize() {
   size_t reg_size_words = ShenandoahHeapRegion::region_size_words();
   size_t reg_size_bytes = ShenandoahHeapRegion::region_size_bytes();
 
+  // Assign regions to NUMA nodes in contiguous stripes, and bind the initially
+  // committed regions before anything touches them. Regions committed later
+  // are bound when they are committed.
+  int* numa_nodes = NULL;
+  size_t numa_count = 0;
+  if (ShenandoahNUMARegionAffinity) {
+    numa_count = os::numa_get_groups_num();
+    numa_nodes = NEW_C_HEAP_ARRAY(int, numa_count, mtGC);
+    numa_count = os::numa_get_leaf_groups(numa_nodes, numa_count);
+    for (size_t i = 0; i < num_committed_regions; i++) {
+      os::numa_make_local(pgc_rs.base() + reg_size_bytes * i, reg_size_bytes,
+                          numa_nodes[i * numa_count / _num_regions]);
+    }
+    log_info(gc, init)("NUMA Region Affinity: " SIZE_FORMAT " nodes", numa_count);
+  }
+
   _regions = NEW_C_HEAP_ARRAY(ShenandoahHeapRegion*, _num_regions, mtGC);
   _free_set = new ShenandoahFreeSet(this, _num_regions);
 
@@ -246,6 +262,10 @@ jint ShenandoahHeap::initialize() {
                                                          i,
                                                          i < num_committed_regions);
 
+      if (numa_nodes != NULL) {
+        r->set_numa_node(numa_nodes[i * numa_count / _num_regions]);
+      }
+
       _marking_context->initialize_top_at_mark_start(r);
       _regions[i] = r;
       assert(!collection_set()->is_in(i), "New region should not be in collection set");
@@ -254,9 +274,14 @@ jint ShenandoahHeap::initialize() {
     // Initialize to complete
     _marking_context->mark_complete();
 
+    if (numa_nodes != NULL) {
+      _free_set->initialize_numa_stripes();
+    }
     _free_set->rebuild();
   }
 
+  FREE_C_HEAP_ARRAY(int, numa_nodes);
+
   if (ShenandoahAlwaysPreTouch) {
     assert (!AlwaysPreTouch, "Should have been overridden");
 
@@ -62,6 +62,8 @@ ShenandoahHeapRegion::ShenandoahHeapRegion(ShenandoahHeap* heap, HeapWord* start
   _new_top(NULL),
   _critical_pins(0),
   _empty_time(os::elapsedTime()),
+  _age(0),
+  _numa_node(-1),
   _state(committed ? _empty_committed : _empty_uncommitted),
   _tlab_allocs(0),
   _gclab_allocs(0),
@@ -493,6 +495,7 @@ void ShenandoahHeapRegion::recycle() {
   clear_live_data();
 
   reset_alloc_metadata();
+  _age = 0;
 
   _heap->marking_context()->reset_top_at_mark_start(this);
 
@@ -663,6 +666,9 @@ void ShenandoahHeapRegion::do_commit() {
   if (!os::commit_memory((char *) _reserved.start(), _reserved.byte_size(), false)) {
     report_java_out_of_memory("Unable to commit region");
   }
+  if (_numa_node >= 0) {
+    os::numa_make_local((char *) _reserved.start(), _reserved.byte_size(), _numa_node);
+  }
   if (!_heap->commit_bitmap_slice(this)) {
     report_java_out_of_memory("Unable to commit bitmaps for region");
   }
@@ -235,6 +235,8 @@ private:
   HeapWord* _new_top;
   size_t _critical_pins;
   double _empty_time;
+  uint _age;
+  int _numa_node;
 
   // Seldom updated fields
   RegionState _state;
@@ -258,6 +260,7 @@ public:
   ShenandoahHeapRegion(ShenandoahHeap* heap, HeapWord* start, size_t size_words, size_t index, bool committed);
 
   static const size_t MIN_NUM_REGIONS = 10;
+  static const uint MAX_AGE = 15;
 
   static void setup_sizes(size_t initial_heap_size, size_t max_heap_size);
 
@@ -418,6 +421,30 @@ public:
     return _seqnum_last_alloc_gc;
   }
 
+  // NUMA node the region memory is bound to, or -1 if not bound
+  int numa_node() const {
+    return _numa_node;
+  }
+
+  void set_numa_node(int node) {
+    _numa_node = node;
+  }
+
+  // Number of GC cycles the region has survived since it was last recycled
+  uint age() const {
+    return _age;
+  }
+
+  bool is_young() const {
+    return _age == 0;
+  }
+
+  void increment_age() {
+    if (_age < MAX_AGE) {
+      _age++;
+    }
+  }
+
 private:
   void do_commit();
   void do_uncommit();
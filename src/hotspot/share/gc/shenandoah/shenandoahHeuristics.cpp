@@ -137,6 +137,11 @@ void ShenandoahHeuristics::choose_collection_set(ShenandoahCollectionSet* collec
   size_t free = 0;
   size_t free_regions = 0;
 
+  size_t young_regions = 0;
+  size_t young_garbage = 0;
+  size_t old_regions = 0;
+  size_t old_garbage = 0;
+
   ShenandoahMarkingContext* const ctx = heap->complete_marking_context();
 
   for (size_t i = 0; i < num_regions; i++) {
@@ -145,6 +150,21 @@ void ShenandoahHeuristics::choose_collection_set(ShenandoahCollectionSet* collec
     size_t garbage = region->garbage();
     total_garbage += garbage;
 
+    if (region->is_regular() || region->is_humongous_start()) {
+      if (region->is_young()) {
+        young_regions++;
+        young_garbage += garbage;
+      } else {
+        old_regions++;
+        old_garbage += garbage;
+      }
+
+      // Regions that are not reclaimed in this cycle survive it
+      if (region->has_live()) {
+        region->increment_age();
+      }
+    }
+
     if (region->is_empty()) {
       free_regions++;
       free += ShenandoahHeapRegion::region_size_bytes();
@@ -203,6 +223,14 @@ void ShenandoahHeuristics::choose_collection_set(ShenandoahCollectionSet* collec
 
   log_info(gc, ergo)("Immediate Garbage: " SIZE_FORMAT "M (" SIZE_FORMAT "%% of total), " SIZE_FORMAT " regions",
                      immediate_garbage / M, immediate_percent, immediate_regions);
+
+  // Young regions were allocated since the previous cycle. Comparing their garbage
+  // with the garbage in older regions shows how much a young collection could save.
+  const size_t region_size = ShenandoahHeapRegion::region_size_bytes();
+  log_debug(gc, ergo)("Region Ages: Young " SIZE_FORMAT " regions (" SIZE_FORMAT "%% garbage), "
+                      "Old " SIZE_FORMAT " regions (" SIZE_FORMAT "%% garbage)",
+                      young_regions, young_regions == 0 ? 0 : (young_garbage * 100 / (young_regions * region_size)),
+                      old_regions, old_regions == 0 ? 0 : (old_garbage * 100 / (old_regions * region_size)));
 }
 
 void ShenandoahHeuristics::record_gc_start() {
@@ -26,6 +26,11 @@
 #include "gc/shenandoah/shenandoahFreeSet.hpp"
 #include "gc/shenandoah/shenandoahHeap.inline.hpp"
 #include "gc/shenandoah/shenandoahPacer.hpp"
+#include "gc/shenandoah/shenandoahThreadLocalData.hpp"
+#include "jfr/jfrEvents.hpp"
+#include "logging/log.hpp"
+#include "memory/resourceArea.hpp"
+#include "runtime/threadSMR.hpp"
 
 /*
  * In normal concurrent cycle, we have to pace the application to let GC finish.
@@ -220,11 +225,25 @@ intptr_t ShenandoahPacer::epoch() {
 void ShenandoahPacer::pace_for_alloc(size_t words) {
   assert(ShenandoahPacing, "Only be here when pacing is enabled");
 
+  Thread* const thread = Thread::current();
+  const intptr_t epoch = Atomic::load(&_epoch);
+  ShenandoahThreadLocalData::add_pacing_allocated(thread, epoch, words);
+
   // Fast path: try to allocate right away
   if (claim_for_alloc(words, false)) {
     return;
   }
 
+  // Threads that allocated little in this phase are not the ones outpacing
+  // the GC, let them pass and leave the delays to the allocation-heavy ones.
+  const size_t grace = ShenandoahPacingThreadGrace >> LogHeapWordSize;
+  if (grace > 0 && ShenandoahThreadLocalData::pacing_allocated(thread, epoch) <= grace) {
+    claim_for_alloc(words, true);
+    return;
+  }
+
+  EventShenandoahAllocationPacing event;
+
   size_t max = ShenandoahPacingMaxDelay;
   double start = os::elapsedTime();
 
@@ -242,7 +261,7 @@ void ShenandoahPacer::pace_for_alloc(size_t words) {
     }
     cur = MAX2<size_t>(1, cur);
 
-    os::sleep(Thread::current(), cur, true);
+    os::sleep(thread, cur, true);
 
     double end = os::elapsedTime();
     total = (size_t)((end - start) * 1000);
@@ -265,6 +284,25 @@ void ShenandoahPacer::pace_for_alloc(size_t words) {
       break;
     }
   }
+
+  ShenandoahThreadLocalData::add_pacing_delay(thread, total);
+
+  log_trace(gc, ergo)("Pacing delay: " SIZE_FORMAT " ms for " SIZE_FORMAT "K allocation, " SIZE_FORMAT " ms total for thread",
+                      total, (words * HeapWordSize) / K, ShenandoahThreadLocalData::pacing_delay(thread));
+
+  if (event.should_commit()) {
+    event.set_allocationSize(words * HeapWordSize);
+    event.set_totalDelay(ShenandoahThreadLocalData::pacing_delay(thread));
+    event.commit();
+  }
+}
+
+void ShenandoahPacer::print_thread_delay(Thread* thread) {
+  const size_t delay = ShenandoahThreadLocalData::pacing_delay(thread);
+  if (delay > 0) {
+    ResourceMark rm;
+    log_debug(gc, ergo)("Pacing delay for exiting thread %s: " SIZE_FORMAT " ms", thread->name(), delay);
+  }
 }
 
 void ShenandoahPacer::print_on(outputStream* out) const {
@@ -299,4 +337,15 @@ void ShenandoahPacer::print_on(outputStream* out) const {
   }
   out->print_cr("%23s: " SIZE_FORMAT_W(12) SIZE_FORMAT_W(12) " ms", "Total", total_count, total_sum);
   out->cr();
+
+  out->print_cr("Pacing delays of live threads:");
+  out->cr();
+
+  for (JavaThreadIteratorWithHandle jtiwh; JavaThread* t = jtiwh.next(); ) {
+    const size_t delay = ShenandoahThreadLocalData::pacing_delay(t);
+    if (delay > 0) {
+      out->print_cr("  " SIZE_FORMAT_W(12) " ms: %s", delay, t->name());
+    }
+  }
+  out->cr();
 }
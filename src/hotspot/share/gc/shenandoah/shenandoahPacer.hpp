@@ -85,6 +85,7 @@ public:
 
   intptr_t epoch();
 
+  void print_thread_delay(Thread* thread);
   void print_on(outputStream* out) const;
 
 private:
@@ -43,6 +43,9 @@ private:
   size_t _gclab_size;
   uint  _worker_id;
   bool _force_satb_flush;
+  intptr_t _pacing_epoch;
+  size_t _pacing_allocated;
+  size_t _pacing_delay;
 
   ShenandoahThreadLocalData() :
     _gc_state(0),
@@ -51,7 +54,10 @@ private:
     _gclab(NULL),
     _gclab_size(0),
     _worker_id(INVALID_WORKER_ID),
-    _force_satb_flush(false) {
+    _force_satb_flush(false),
+    _pacing_epoch(0),
+    _pacing_allocated(0),
+    _pacing_delay(0) {
   }
 
   ~ShenandoahThreadLocalData() {
@@ -138,6 +144,30 @@ public:
     data(thread)->_gclab_size = v;
   }
 
+  // Words allocated by the thread in the given pacing epoch
+  static size_t pacing_allocated(Thread* thread, intptr_t epoch) {
+    ShenandoahThreadLocalData* const d = data(thread);
+    return (d->_pacing_epoch == epoch) ? d->_pacing_allocated : 0;
+  }
+
+  static void add_pacing_allocated(Thread* thread, intptr_t epoch, size_t words) {
+    ShenandoahThreadLocalData* const d = data(thread);
+    if (d->_pacing_epoch != epoch) {
+      d->_pacing_epoch = epoch;
+      d->_pacing_allocated = 0;
+    }
+    d->_pacing_allocated += words;
+  }
+
+  // Total time the thread has been delayed by pacing, in milliseconds
+  static size_t pacing_delay(Thread* thread) {
+    return data(thread)->_pacing_delay;
+  }
+
+  static void add_pacing_delay(Thread* thread, size_t ms) {
+    data(thread)->_pacing_delay += ms;
+  }
+
 #ifdef ASSERT
   static void set_evac_allowed(Thread* thread, bool evac_allowed) {
     if (evac_allowed) {
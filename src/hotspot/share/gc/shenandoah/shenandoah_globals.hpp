@@ -202,6 +202,11 @@
   diagnostic(bool, ShenandoahElasticTLAB, true,                             \
           "Use Elastic TLABs with Shenandoah")                              \
                                                                             \
+  experimental(bool, ShenandoahNUMARegionAffinity, false,                   \
+          "Bind heap regions to NUMA nodes when they are committed, "       \
+          "and prefer allocating in regions on the node of the "            \
+          "allocating thread. Requires UseNUMA.")                           \
+                                                                            \
   diagnostic(bool, ShenandoahAllowMixedAllocs, true,                        \
           "Allow mixing mutator and collector allocations in a single "     \
           "region")                                                         \
@@ -255,6 +260,12 @@
           "Max delay for pacing application allocations. "                  \
           "Time is in milliseconds.")                                       \
                                                                             \
+  experimental(size_t, ShenandoahPacingThreadGrace, 0,                      \
+          "Amount of memory (in bytes) each thread can allocate in each "   \
+          "pacing phase before it can be delayed. Lets threads that "       \
+          "allocate little avoid the delays caused by allocation-heavy "    \
+          "threads. Zero disables the grace allowance.")                    \
+                                                                            \
   experimental(uintx, ShenandoahPacingIdleSlack, 2,                         \
           "Percent of heap counted as non-taxable allocations during idle. "\
           "Larger value makes the pacing milder during idle phases, "       \
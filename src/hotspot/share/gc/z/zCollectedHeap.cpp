@@ -49,6 +49,7 @@ ZCollectedHeap::ZCollectedHeap(ZCollectorPolicy* policy) :
     _director(new ZDirector()),
     _driver(new ZDriver()),
     _stat(new ZStat()),
+    _uncommitter(new ZUncommitter()),
     _runtime_workers() {}
 
 CollectedHeap::Name ZCollectedHeap::kind() const {
@@ -78,6 +79,7 @@ void ZCollectedHeap::stop() {
   _director->stop();
   _driver->stop();
   _stat->stop();
+  _uncommitter->stop();
 }
 
 CollectorPolicy* ZCollectedHeap::collector_policy() const {
@@ -278,6 +280,7 @@ void ZCollectedHeap::gc_threads_do(ThreadClosure* tc) const {
   tc->do_thread(_director);
   tc->do_thread(_driver);
   tc->do_thread(_stat);
+  tc->do_thread(_uncommitter);
   _heap.worker_threads_do(tc);
   _runtime_workers.threads_do(tc);
 }
@@ -338,6 +341,8 @@ void ZCollectedHeap::print_gc_threads_on(outputStream* st) const {
   st->cr();
   _stat->print_on(st);
   st->cr();
+  _uncommitter->print_on(st);
+  st->cr();
   _heap.print_worker_threads_on(st);
   _runtime_workers.print_threads_on(st);
 }
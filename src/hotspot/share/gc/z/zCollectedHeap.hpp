@@ -34,6 +34,7 @@
 #include "gc/z/zHeap.hpp"
 #include "gc/z/zRuntimeWorkers.hpp"
 #include "gc/z/zStat.hpp"
+#include "gc/z/zUncommitter.hpp"
 
 class ZCollectedHeap : public CollectedHeap {
   friend class VMStructs;
@@ -47,6 +48,7 @@ private:
   ZDirector*        _director;
   ZDriver*          _driver;
   ZStat*            _stat;
+  ZUncommitter*     _uncommitter;
   ZRuntimeWorkers   _runtime_workers;
 
   virtual HeapWord* allocate_new_tlab(size_t min_size,
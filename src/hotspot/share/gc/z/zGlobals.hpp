@@ -50,6 +50,9 @@ const size_t      ZPageSizeSmallShift           = ZPlatformPageSizeSmallShift;
 const size_t      ZPageSizeMediumShift          = ZPageSizeSmallShift + 4;
 const size_t      ZPageSizeMinShift             = ZPageSizeSmallShift;
 
+// Page age, saturating
+const uint8_t     ZPageAgeMax                   = 15;
+
 // Page sizes
 const size_t      ZPageSizeSmall                = (size_t)1 << ZPageSizeSmallShift;
 const size_t      ZPageSizeMedium               = (size_t)1 << ZPageSizeMediumShift;
@@ -252,6 +252,10 @@ void ZHeap::release_page(ZPage* page, bool reclaimed) {
   }
 }
 
+uint64_t ZHeap::uncommit(uint64_t delay) {
+  return _page_allocator.uncommit(delay);
+}
+
 void ZHeap::flip_views() {
   // For debugging only
   if (ZUnmapBadViews) {
@@ -423,6 +427,9 @@ void ZHeap::select_relocation_set() {
     if (page->is_marked()) {
       // Register live page
       selector.register_live_page(page);
+
+      // The page survived this cycle, unless it is relocated
+      page->inc_age();
     } else {
       // Register garbage page
       selector.register_garbage_page(page);
@@ -436,7 +443,7 @@ void ZHeap::select_relocation_set() {
   selector.select(&_relocation_set);
 
   // Update statistics
-  ZStatRelocation::set_at_select_relocation_set(selector.relocating());
+  ZStatRelocation::set_at_select_relocation_set(selector.relocating(), selector.cost());
   ZStatHeap::set_at_select_relocation_set(selector.live(),
                                           selector.garbage(),
                                           reclaimed());
@@ -506,11 +513,13 @@ uintptr_t ZHeap::forward_object(uintptr_t addr) {
 
 void ZHeap::relocate() {
   // Relocate relocation set
+  const Ticks start = Ticks::now();
   const bool success = _relocate.relocate(&_relocation_set);
+  const Tickspan duration = Ticks::now() - start;
 
   // Update statistics
   ZStatSample(ZSamplerHeapUsedAfterRelocation, used());
-  ZStatRelocation::set_at_relocate_end(success);
+  ZStatRelocation::set_at_relocate_end(success, duration);
   ZStatHeap::set_at_relocate_end(capacity(), allocated(), reclaimed(),
                                  used(), used_high(), used_low());
 }
@@ -122,11 +122,15 @@ public:
   bool retain_page(ZPage* page);
   void release_page(ZPage* page, bool reclaimed);
 
+  // Uncommitting
+  uint64_t uncommit(uint64_t delay);
+
   // Object allocation
   uintptr_t alloc_tlab(size_t size);
   uintptr_t alloc_object(size_t size);
   uintptr_t alloc_object_for_relocation(size_t size);
   void undo_alloc_object_for_relocation(uintptr_t addr, size_t size);
+  void install_page_for_relocation(ZPage* page);
   bool is_alloc_stalled() const;
   void check_out_of_memory();
 
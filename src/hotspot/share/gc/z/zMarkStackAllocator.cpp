@@ -25,9 +25,11 @@
 #include "gc/z/zLock.inline.hpp"
 #include "gc/z/zMarkStack.inline.hpp"
 #include "gc/z/zMarkStackAllocator.hpp"
+#include "gc/z/zNUMA.hpp"
 #include "logging/log.hpp"
 #include "runtime/atomic.hpp"
 #include "runtime/os.hpp"
+#include "utilities/align.hpp"
 #include "utilities/debug.hpp"
 
 uintptr_t ZMarkStackSpaceStart;
@@ -108,6 +110,10 @@ uintptr_t ZMarkStackSpace::expand_and_alloc_space(size_t size) {
   // Expand
   os::commit_memory_or_exit((char*)_end, expand_size, false /* executable */, "Mark stack space");
 
+  // Prefer memory on the NUMA node of the expanding thread,
+  // since that thread is about to start using it.
+  ZNUMA::memory_bind(_end, expand_size, ZNUMA::id());
+
   // Increment top before end to make sure another
   // thread can't steal out newly expanded space.
   addr = Atomic::add(size, &_top) - size;
@@ -143,10 +149,20 @@ bool ZMarkStackAllocator::is_initialized() const {
 }
 
 void ZMarkStackAllocator::prime_freelist() {
-  for (size_t size = 0; size < ZMarkStackSpaceExpandSize; size += ZMarkStackMagazineSize) {
-    const uintptr_t addr = _space.alloc(ZMarkStackMagazineSize);
-    ZMarkStackMagazine* const magazine = create_magazine_from_space(addr, ZMarkStackMagazineSize);
-    free_magazine(magazine);
+  // Split the initial space evenly between the NUMA nodes. Each part
+  // is bound to its node before it is touched, and its magazines are
+  // added to the free list of that node.
+  const uint32_t numa_count = ZNUMA::count();
+  const size_t numa_size = align_down(ZMarkStackSpaceExpandSize / numa_count, ZMarkStackMagazineSize);
+
+  for (uint32_t numa_id = 0; numa_id < numa_count; numa_id++) {
+    const uintptr_t start = _space.alloc(numa_size);
+    ZNUMA::memory_bind(start, numa_size, numa_id);
+
+    for (uintptr_t addr = start; addr < start + numa_size; addr += ZMarkStackMagazineSize) {
+      ZMarkStackMagazine* const magazine = create_magazine_from_space(addr, ZMarkStackMagazineSize);
+      _freelist.addr(numa_id)->push_atomic(magazine);
+    }
   }
 }
 
@@ -164,9 +180,29 @@ ZMarkStackMagazine* ZMarkStackAllocator::create_magazine_from_space(uintptr_t ad
   return magazine;
 }
 
+ZMarkStackMagazine* ZMarkStackAllocator::alloc_magazine_from_freelist(uint32_t numa_id) {
+  // Try the free list of the local NUMA node first
+  ZMarkStackMagazine* const magazine = _freelist.addr(numa_id)->pop_atomic();
+  if (magazine != NULL) {
+    return magazine;
+  }
+
+  // Try the free lists of the other NUMA nodes
+  const uint32_t numa_count = ZNUMA::count();
+  for (uint32_t i = 1; i < numa_count; i++) {
+    const uint32_t remote_numa_id = (numa_id + i) % numa_count;
+    ZMarkStackMagazine* const remote_magazine = _freelist.addr(remote_numa_id)->pop_atomic();
+    if (remote_magazine != NULL) {
+      return remote_magazine;
+    }
+  }
+
+  return NULL;
+}
+
 ZMarkStackMagazine* ZMarkStackAllocator::alloc_magazine() {
-  // Try allocating from the free list first
-  ZMarkStackMagazine* const magazine = _freelist.pop_atomic();
+  // Try allocating from the free lists first
+  ZMarkStackMagazine* const magazine = alloc_magazine_from_freelist(ZNUMA::id());
   if (magazine != NULL) {
     return magazine;
   }
@@ -181,5 +217,7 @@ ZMarkStackMagazine* ZMarkStackAllocator::alloc_magazine() {
 }
 
 void ZMarkStackAllocator::free_magazine(ZMarkStackMagazine* magazine) {
-  _freelist.push_atomic(magazine);
+  // Return to the free list of the local NUMA node, which
+  // is where the stacks in the magazine were last used.
+  _freelist.addr()->push_atomic(magazine);
 }
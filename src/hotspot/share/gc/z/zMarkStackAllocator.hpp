@@ -26,6 +26,7 @@
 
 #include "gc/z/zGlobals.hpp"
 #include "gc/z/zLock.hpp"
+#include "gc/z/zValue.hpp"
 #include "utilities/globalDefinitions.hpp"
 
 class ZMarkStackSpace {
@@ -50,11 +51,12 @@ public:
 
 class ZMarkStackAllocator {
 private:
-  ZMarkStackMagazineList _freelist ATTRIBUTE_ALIGNED(ZCacheLineSize);
-  ZMarkStackSpace        _space    ATTRIBUTE_ALIGNED(ZCacheLineSize);
+  ZPerNUMA<ZMarkStackMagazineList> _freelist;
+  ZMarkStackSpace                  _space ATTRIBUTE_ALIGNED(ZCacheLineSize);
 
   void prime_freelist();
   ZMarkStackMagazine* create_magazine_from_space(uintptr_t addr, size_t size);
+  ZMarkStackMagazine* alloc_magazine_from_freelist(uint32_t numa_id);
 
 public:
   ZMarkStackAllocator();
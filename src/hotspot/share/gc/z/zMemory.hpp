@@ -55,6 +55,7 @@ private:
 public:
   uintptr_t alloc_from_front(size_t size);
   uintptr_t alloc_from_back(size_t size);
+  uintptr_t alloc_from_back_at_most(size_t size, size_t* allocated);
   void free(uintptr_t start, size_t size);
 };
 
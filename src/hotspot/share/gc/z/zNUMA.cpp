@@ -49,6 +49,15 @@ void ZNUMA::memory_interleave(uintptr_t addr, size_t size) {
   os::numa_make_global((char*)addr, size);
 }
 
+void ZNUMA::memory_bind(uintptr_t addr, size_t size, uint32_t id) {
+  if (!_enabled) {
+    // NUMA support not enabled
+    return;
+  }
+
+  os::numa_make_local((char*)addr, size, (int)id);
+}
+
 const char* ZNUMA::to_string() {
   return _enabled ? "Enabled" : "Disabled";
 }
@@ -270,6 +270,16 @@ void ZObjectAllocator::undo_alloc_object_for_relocation(ZPage* page, uintptr_t a
   }
 }
 
+void ZObjectAllocator::install_page_for_relocation(ZPage* page) {
+  assert(ZThread::is_worker(), "Should be a worker thread");
+  assert(page->type() == ZPageTypeSmall, "Invalid page type");
+  assert(page->is_allocating(), "Invalid page state");
+
+  // The page was already accounted for when it was allocated, so
+  // just make it the current relocation target of this worker.
+  _worker_small_page.set(page);
+}
+
 size_t ZObjectAllocator::used() const {
   size_t total_used = 0;
 
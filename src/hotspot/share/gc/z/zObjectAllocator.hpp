@@ -68,6 +68,7 @@ public:
 
   uintptr_t alloc_object_for_relocation(size_t size);
   void undo_alloc_object_for_relocation(ZPage* page, uintptr_t addr, size_t size);
+  void install_page_for_relocation(ZPage* page);
 
   size_t used() const;
   size_t remaining() const;
@@ -34,24 +34,35 @@
 #include "gc/z/zThread.hpp"
 #include "gc/z/zUtils.inline.hpp"
 #include "logging/log.hpp"
+#include "runtime/atomic.hpp"
 #include "runtime/orderAccess.hpp"
+#include "runtime/os.hpp"
 #include "utilities/align.hpp"
 #include "utilities/debug.hpp"
 #include "utilities/globalDefinitions.hpp"
 
 static const ZStatCounter ZCounterRelocationContention("Contention", "Relocation Contention", ZStatUnitOpsPerSecond);
 
+// The in-place relocation state holds the number of threads currently
+// relocating objects in the page (in units of ZPageInPlaceRelocator),
+// and a bit telling if the page is being compacted in place.
+static const uint32_t ZPageInPlaceCompacting = 1;
+static const uint32_t ZPageInPlaceRelocator  = 2;
+
 ZPage::ZPage(uint8_t type, ZVirtualMemory vmem, ZPhysicalMemory pmem) :
     _type(type),
     _pinned(0),
     _numa_id((uint8_t)-1),
+    _age(0),
     _seqnum(0),
     _virtual(vmem),
     _top(start()),
     _livemap(object_max_count()),
     _refcount(0),
     _forwarding(),
-    _physical(pmem) {
+    _inplace(0),
+    _physical(pmem),
+    _last_used(0) {
   assert(!_physical.is_null(), "Should not be null");
   assert(!_virtual.is_null(), "Should not be null");
   assert((type == ZPageTypeSmall && size() == ZPageSizeSmall) ||
@@ -65,12 +76,14 @@ ZPage::~ZPage() {
   assert(is_detached(), "Should be detached");
 }
 
-void ZPage::reset() {
+void ZPage::reset(uint8_t age) {
   assert(!is_active(), "Should not be active");
   assert(!is_pinned(), "Should not be pinned");
   assert(!is_detached(), "Should not be detached");
+  assert(_inplace == 0, "Should not be relocating");
 
   _seqnum = ZGlobalSeqNum;
+  _age = age;
   _top = start();
   _livemap.reset();
 
@@ -131,17 +144,57 @@ uintptr_t ZPage::relocate_object_inner(uintptr_t from_index, uintptr_t from_offs
   return to_offset_final;
 }
 
+void ZPage::relocate_enter() {
+  for (;;) {
+    const uint32_t state = Atomic::load(&_inplace);
+    if (state & ZPageInPlaceCompacting) {
+      // Page is being compacted in place, wait for it to complete
+      os::naked_yield();
+      continue;
+    }
+
+    if (Atomic::cmpxchg(state + ZPageInPlaceRelocator, &_inplace, state) == state) {
+      // Success
+      return;
+    }
+  }
+}
+
+void ZPage::relocate_leave() {
+  Atomic::sub(ZPageInPlaceRelocator, &_inplace);
+}
+
 uintptr_t ZPage::relocate_object(uintptr_t from) {
   assert(ZHeap::heap()->is_relocating(from), "Should be relocating");
 
   const uintptr_t from_offset = ZAddress::offset(from);
   const uintptr_t from_index = (from_offset - start()) >> object_alignment_shift();
+
+  // Lookup address in forwarding table
+  const ZForwardingTableEntry entry = _forwarding.find(from_index);
+  if (entry.from_index() == from_index) {
+    // Already relocated, return new address
+    return ZAddress::good(entry.to_offset());
+  }
+
+  // The page can not be compacted in place while we are relocating,
+  // since that would move the object we are about to copy. Only small
+  // pages are ever compacted in place.
+  const bool in_place = ZRelocateInPlace && type() == ZPageTypeSmall;
+  if (in_place) {
+    relocate_enter();
+  }
+
   const uintptr_t to_offset = relocate_object_inner(from_index, from_offset);
   if (from_offset == to_offset) {
     // In-place forwarding, pin page
     set_pinned();
   }
 
+  if (in_place) {
+    relocate_leave();
+  }
+
   return ZAddress::good(to_offset);
 }
 
@@ -157,6 +210,67 @@ uintptr_t ZPage::forward_object(uintptr_t from) {
   return ZAddress::good(entry.to_offset());
 }
 
+void ZPage::relocate_in_place_start() {
+  assert(ZThread::is_worker(), "Should be a worker thread");
+  assert(is_pinned(), "Should be pinned");
+
+  // Block new relocations
+  Atomic::add(ZPageInPlaceCompacting, &_inplace);
+
+  // Wait for ongoing relocations to complete
+  while (Atomic::load(&_inplace) != ZPageInPlaceCompacting) {
+    os::naked_yield();
+  }
+}
+
+uintptr_t ZPage::relocate_object_in_place(uintptr_t from, uintptr_t top) {
+  assert(Atomic::load(&_inplace) == ZPageInPlaceCompacting, "Should be compacting");
+  assert(top <= ZAddress::offset(from), "Invalid top");
+
+  const uintptr_t from_offset = ZAddress::offset(from);
+  const uintptr_t from_index = (from_offset - start()) >> object_alignment_shift();
+  ZForwardingTableCursor cursor;
+
+  const ZForwardingTableEntry entry = _forwarding.find(from_index, &cursor);
+  if (entry.from_index() == from_index) {
+    if (entry.to_offset() != from_offset) {
+      // Already relocated to another page, the space is free
+      return top;
+    }
+
+    // Already forwarded in place, the object must stay
+    return from_offset + align_up(ZUtils::object_size(from), object_alignment());
+  }
+
+  // Slide object down to top. Objects are visited in address order, so
+  // the object can only overlap with itself and never with an object
+  // we have not visited yet.
+  const size_t size = ZUtils::object_size(from);
+  if (top != from_offset) {
+    ZUtils::object_copy_conjoint(from, ZAddress::good(top), size);
+  }
+
+  // Update forwarding table
+  const uintptr_t to_offset = _forwarding.insert(from_index, top, &cursor);
+  assert(to_offset == top, "Should not be contended");
+
+  return top + align_up(size, object_alignment());
+}
+
+void ZPage::relocate_in_place_end(uintptr_t top) {
+  assert(Atomic::load(&_inplace) == ZPageInPlaceCompacting, "Should be compacting");
+  assert(top >= start() && top <= end(), "Invalid top");
+
+  // The space above top is now free. Turn the page back into an
+  // allocating page so that it can be used as a relocation target.
+  _seqnum = ZGlobalSeqNum;
+  _top = top;
+
+  // Unblock relocations. All live objects in the page are now
+  // forwarded, so any waiting thread will find its forwarding.
+  Atomic::sub(ZPageInPlaceCompacting, &_inplace);
+}
+
 void ZPage::print_on(outputStream* out) const {
   out->print_cr(" %-6s  " PTR_FORMAT " " PTR_FORMAT " " PTR_FORMAT " %s%s%s%s%s%s",
                 type_to_string(), start(), top(), end(),
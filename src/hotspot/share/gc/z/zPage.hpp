@@ -40,6 +40,7 @@ private:
   const uint8_t        _type;             // Page type
   volatile uint8_t     _pinned;           // Pinned flag
   uint8_t              _numa_id;          // NUMA node affinity
+  uint8_t              _age;              // Number of GC cycles survived
   uint32_t             _seqnum;           // Allocation sequence number
   const ZVirtualMemory _virtual;          // Virtual start/end address
   volatile uintptr_t   _top;              // Virtual top address
@@ -48,12 +49,16 @@ private:
   // Hot when relocated and cached
   volatile uint32_t    _refcount;         // Page reference count
   ZForwardingTable     _forwarding;       // Forwarding table
+  volatile uint32_t    _inplace;          // In-place relocation state
   ZPhysicalMemory      _physical;         // Physical memory for page
+  uint64_t             _last_used;        // Last used time in seconds
   ZListNode<ZPage>     _node;             // Page list node
 
   const char* type_to_string() const;
   uint32_t object_max_count() const;
   uintptr_t relocate_object_inner(uintptr_t from_index, uintptr_t from_offset);
+  void relocate_enter();
+  void relocate_leave();
 
   bool is_object_marked(uintptr_t addr) const;
   bool is_object_strongly_marked(uintptr_t addr) const;
@@ -77,7 +82,14 @@ public:
   ZPhysicalMemory& physical_memory();
   const ZVirtualMemory& virtual_memory() const;
 
-  void reset();
+  void reset(uint8_t age);
+
+  uint8_t age() const;
+  bool is_young() const;
+  void inc_age();
+
+  uint64_t last_used() const;
+  void set_last_used();
 
   bool inc_refcount();
   bool dec_refcount();
@@ -111,6 +123,7 @@ public:
 
   void inc_live_atomic(uint32_t objects, size_t bytes);
   size_t live_bytes() const;
+  uint32_t live_objects() const;
 
   void object_iterate(ObjectClosure* cl);
 
@@ -123,6 +136,10 @@ public:
   uintptr_t relocate_object(uintptr_t from);
   uintptr_t forward_object(uintptr_t from);
 
+  void relocate_in_place_start();
+  uintptr_t relocate_object_in_place(uintptr_t from, uintptr_t top);
+  void relocate_in_place_end(uintptr_t top);
+
   void print_on(outputStream* out) const;
   void print() const;
 };
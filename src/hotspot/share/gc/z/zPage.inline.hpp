@@ -36,6 +36,7 @@
 #include "gc/z/zVirtualMemory.inline.hpp"
 #include "oops/oop.inline.hpp"
 #include "runtime/atomic.hpp"
+#include "runtime/os.hpp"
 #include "utilities/align.hpp"
 #include "utilities/debug.hpp"
 
@@ -207,6 +208,28 @@ inline void ZPage::set_pinned() {
   _pinned = 1;
 }
 
+inline uint8_t ZPage::age() const {
+  return _age;
+}
+
+inline bool ZPage::is_young() const {
+  return _age == 0;
+}
+
+inline void ZPage::inc_age() {
+  if (_age < ZPageAgeMax) {
+    _age++;
+  }
+}
+
+inline uint64_t ZPage::last_used() const {
+  return _last_used;
+}
+
+inline void ZPage::set_last_used() {
+  _last_used = (uint64_t)os::elapsedTime();
+}
+
 inline bool ZPage::is_forwarding() const {
   return !_forwarding.is_null();
 }
@@ -267,6 +290,11 @@ inline size_t ZPage::live_bytes() const {
   return _livemap.live_bytes();
 }
 
+inline uint32_t ZPage::live_objects() const {
+  assert(is_marked(), "Should be marked");
+  return _livemap.live_objects();
+}
+
 inline void ZPage::object_iterate(ObjectClosure* cl) {
   _livemap.iterate(cl, ZAddress::good(start()), object_alignment_shift());
 }
@@ -33,9 +33,13 @@
 #include "gc/z/zPreMappedMemory.inline.hpp"
 #include "gc/z/zStat.hpp"
 #include "gc/z/zTracer.inline.hpp"
+#include "logging/log.hpp"
+#include "runtime/globals.hpp"
 #include "runtime/init.hpp"
+#include "runtime/os.hpp"
 
 static const ZStatCounter       ZCounterAllocationRate("Memory", "Allocation Rate", ZStatUnitBytesPerSecond);
+static const ZStatCounter       ZCounterUncommit("Memory", "Uncommit", ZStatUnitBytesPerSecond);
 static const ZStatCriticalPhase ZCriticalPhaseAllocationStall("Allocation Stall");
 
 class ZPageAllocRequest : public StackObj {
@@ -88,6 +92,7 @@ ZPageAllocator::ZPageAllocator(size_t min_capacity, size_t max_capacity, size_t
     _virtual(),
     _physical(max_capacity, ZPageSizeMin),
     _cache(),
+    _min_capacity(min_capacity),
     _max_reserve(max_reserve),
     _pre_mapped(_virtual, _physical, try_ensure_unused_for_pre_mapped(min_capacity)),
     _used_high(0),
@@ -272,10 +277,35 @@ void ZPageAllocator::flush_detached_pages(ZList<ZPage>* list) {
   list->transfer(&_detached);
 }
 
-void ZPageAllocator::flush_cache(size_t size) {
+class ZPageCacheFlushForAllocationClosure : public ZPageCacheFlushClosure {
+public:
+  ZPageCacheFlushForAllocationClosure(size_t requested) :
+      ZPageCacheFlushClosure(requested) {}
+
+  virtual bool do_page(const ZPage* page) {
+    if (_flushed < _requested) {
+      // Flush page
+      _flushed += page->size();
+      return true;
+    }
+
+    // Don't flush page
+    return false;
+  }
+};
+
+void ZPageAllocator::flush_cache_for_allocation(size_t requested) {
   ZList<ZPage> list;
 
-  _cache.flush(&list, size);
+  // Flush pages
+  ZPageCacheFlushForAllocationClosure cl(requested);
+  const size_t available_before = _cache.available();
+  _cache.flush(&cl, &list);
+
+  log_info(gc, heap)("Page Cache Flushed: "
+                     SIZE_FORMAT "M requested, "
+                     SIZE_FORMAT "M(" SIZE_FORMAT "M->" SIZE_FORMAT "M) flushed",
+                     requested / M, cl.flushed() / M, available_before / M, _cache.available() / M);
 
   for (ZPage* page = list.remove_first(); page != NULL; page = list.remove_first()) {
     detach_page(page);
@@ -315,7 +345,7 @@ ZPage* ZPageAllocator::alloc_page_common_inner(uint8_t type, size_t size, ZAlloc
   const size_t unused = try_ensure_unused(size, flags.no_reserve());
   if (unused < size) {
     // Flush cache to free up more physical memory
-    flush_cache(size - unused);
+    flush_cache_for_allocation(size - unused);
   }
 
   // Create new page and allocate physical memory
@@ -405,7 +435,9 @@ ZPage* ZPageAllocator::alloc_page(uint8_t type, size_t size, ZAllocationFlags fl
   // Reset page. This updates the page's sequence number and must
   // be done after page allocation, which potentially blocked in
   // a safepoint where the global sequence number was updated.
-  page->reset();
+  // Pages allocated for relocation receive objects that have
+  // survived at least one GC cycle.
+  page->reset(flags.relocation() ? 1 : 0);
 
   // Update allocation statistics. Exclude worker threads to avoid
   // artificial inflation of the allocation rate due to relocation.
@@ -511,3 +543,96 @@ void ZPageAllocator::check_out_of_memory() {
     request->satisfy(NULL);
   }
 }
+
+class ZPageCacheFlushForUncommitClosure : public ZPageCacheFlushClosure {
+private:
+  const uint64_t _now;
+  const uint64_t _delay;
+  const size_t   _soft_excess;
+  uint64_t       _timeout;
+
+public:
+  ZPageCacheFlushForUncommitClosure(size_t requested, size_t soft_excess, uint64_t delay) :
+      ZPageCacheFlushClosure(requested),
+      _now((uint64_t)os::elapsedTime()),
+      _delay(delay),
+      _soft_excess(MIN2(soft_excess, requested)),
+      _timeout(delay) {}
+
+  virtual bool do_page(const ZPage* page) {
+    if (_flushed >= _requested) {
+      // Done
+      return false;
+    }
+
+    const uint64_t expires = page->last_used() + _delay;
+    if (expires > _now && _flushed >= _soft_excess) {
+      // Not expired, and not needed to get below the soft max heap
+      // size. Lower the timeout to when the page expires.
+      _timeout = MIN2(_timeout, expires - _now);
+      return false;
+    }
+
+    // Flush page
+    _flushed += page->size();
+    return true;
+  }
+
+  uint64_t timeout() const {
+    return _timeout;
+  }
+};
+
+uint64_t ZPageAllocator::uncommit(uint64_t delay) {
+  // Set the default timeout, when no pages are found in the
+  // cache or when uncommit is disabled, equal to the delay.
+  uint64_t timeout = delay;
+
+  if (!ZUncommit) {
+    // Disabled
+    return timeout;
+  }
+
+  size_t uncommitted = 0;
+
+  {
+    ZLocker<ZLock> locker(&_lock);
+
+    // Never uncommit below the min capacity
+    const size_t retain = MAX2(used(), _min_capacity);
+    const size_t release = capacity() > retain ? capacity() - retain : 0;
+    if (release == 0) {
+      // Nothing to uncommit
+      return timeout;
+    }
+
+    // Memory above the soft max heap size is uncommitted without delay
+    const size_t soft_max = MAX2(ZSoftMaxHeapSize, _min_capacity);
+    const size_t soft_excess = (ZSoftMaxHeapSize != 0 && capacity() > soft_max) ? capacity() - soft_max : 0;
+
+    // Flush pages that have been unused for longer than the delay. The
+    // cache is flushed least recently used first, so the flush stops
+    // at the first page that has not yet expired in each list.
+    ZList<ZPage> list;
+    ZPageCacheFlushForUncommitClosure cl(release, soft_excess, delay);
+    _cache.flush(&cl, &list);
+    timeout = cl.timeout();
+
+    for (ZPage* page = list.remove_first(); page != NULL; page = list.remove_first()) {
+      detach_page(page);
+    }
+
+    // Release unused physical memory back to the operating system
+    uncommitted = _physical.try_shrink_capacity(release, _min_capacity);
+  }
+
+  if (uncommitted > 0) {
+    log_info(gc, heap)("Uncommitted: " SIZE_FORMAT "M(%.0lf%%)",
+                       uncommitted / M, percent_of(uncommitted, max_capacity()));
+
+    // Update statistics
+    ZStatInc(ZCounterUncommit, uncommitted);
+  }
+
+  return timeout;
+}
@@ -43,6 +43,7 @@ private:
   ZVirtualMemoryManager    _virtual;
   ZPhysicalMemoryManager   _physical;
   ZPageCache               _cache;
+  const size_t             _min_capacity;
   const size_t             _max_reserve;
   ZPreMappedMemory         _pre_mapped;
   size_t                   _used_high;
@@ -66,7 +67,7 @@ private:
   void map_page(ZPage* page);
   void detach_page(ZPage* page);
   void flush_pre_mapped();
-  void flush_cache(size_t size);
+  void flush_cache_for_allocation(size_t requested);
 
   void check_out_of_memory_during_initialization();
 
@@ -103,6 +104,8 @@ public:
 
   void flush_detached_pages(ZList<ZPage>* list);
 
+  uint64_t uncommit(uint64_t delay);
+
   void flip_pre_mapped();
 
   bool is_alloc_stalled() const;
@@ -34,6 +34,14 @@ static const ZStatCounter ZCounterPageCacheHitL2("Memory", "Page Cache Hit L2",
 static const ZStatCounter ZCounterPageCacheMiss("Memory", "Page Cache Miss", ZStatUnitOpsPerSecond);
 static const ZStatCounter ZCounterPageCacheFlush("Memory", "Page Cache Flush", ZStatUnitBytesPerSecond);
 
+ZPageCacheFlushClosure::ZPageCacheFlushClosure(size_t requested) :
+    _requested(requested),
+    _flushed(0) {}
+
+size_t ZPageCacheFlushClosure::flushed() const {
+  return _flushed;
+}
+
 ZPageCache::ZPageCache() :
     _available(0),
     _small(),
@@ -122,6 +130,9 @@ void ZPageCache::free_page(ZPage* page) {
   assert(!page->is_pinned(), "Invalid page state");
   assert(!page->is_detached(), "Invalid page state");
 
+  // Record when the page was last used, for timed uncommit
+  page->set_last_used();
+
   const uint8_t type = page->type();
   if (type == ZPageTypeSmall) {
     _small.get(page->numa_id()).insert_first(page);
@@ -134,64 +145,52 @@ void ZPageCache::free_page(ZPage* page) {
   _available += page->size();
 }
 
-void ZPageCache::flush_list(ZList<ZPage>* from, size_t requested, ZList<ZPage>* to, size_t* flushed) {
-  while (*flushed < requested) {
+void ZPageCache::flush_list(ZPageCacheFlushClosure* cl, ZList<ZPage>* from, ZList<ZPage>* to) {
+  for (;;) {
     // Flush least recently used
-    ZPage* const page = from->remove_last();
-    if (page == NULL) {
+    ZPage* const page = from->last();
+    if (page == NULL || !cl->do_page(page)) {
       break;
     }
 
-    *flushed += page->size();
+    from->remove(page);
     to->insert_last(page);
   }
 }
 
-void ZPageCache::flush_per_numa_lists(ZPerNUMA<ZList<ZPage> >* from, size_t requested, ZList<ZPage>* to, size_t* flushed) {
+void ZPageCache::flush_per_numa_lists(ZPageCacheFlushClosure* cl, ZPerNUMA<ZList<ZPage> >* from, ZList<ZPage>* to) {
   const uint32_t numa_count = ZNUMA::count();
-  uint32_t numa_empty = 0;
+  uint32_t numa_done = 0;
   uint32_t numa_next = 0;
 
   // Flush lists round-robin
-  while (*flushed < requested) {
-    ZPage* const page = from->get(numa_next).remove_last();
-
+  while (numa_done < numa_count) {
+    ZList<ZPage>* numa_list = from->addr(numa_next);
     if (++numa_next == numa_count) {
       numa_next = 0;
     }
 
-    if (page == NULL) {
-      // List is empty
-      if (++numa_empty == numa_count) {
-        // All lists are empty
-        break;
-      }
-
-      // Try next list
+    ZPage* const page = numa_list->last();
+    if (page == NULL || !cl->do_page(page)) {
+      // List is done
+      numa_done++;
       continue;
     }
 
     // Flush page
-    numa_empty = 0;
-    *flushed += page->size();
+    numa_done = 0;
+    numa_list->remove(page);
     to->insert_last(page);
   }
 }
 
-void ZPageCache::flush(ZList<ZPage>* to, size_t requested) {
-  size_t flushed = 0;
-
+void ZPageCache::flush(ZPageCacheFlushClosure* cl, ZList<ZPage>* to) {
   // Prefer flushing large, then medium and last small pages
-  flush_list(&_large, requested, to, &flushed);
-  flush_list(&_medium, requested, to, &flushed);
-  flush_per_numa_lists(&_small, requested, to, &flushed);
-
-  ZStatInc(ZCounterPageCacheFlush, flushed);
+  flush_list(cl, &_large, to);
+  flush_list(cl, &_medium, to);
+  flush_per_numa_lists(cl, &_small, to);
 
-  log_info(gc, heap)("Page Cache Flushed: "
-                     SIZE_FORMAT "M requested, "
-                     SIZE_FORMAT "M(" SIZE_FORMAT "M->" SIZE_FORMAT "M) flushed",
-                     requested / M, flushed / M , _available / M, (_available - flushed) / M);
+  ZStatInc(ZCounterPageCacheFlush, cl->flushed());
 
-  _available -= flushed;
+  _available -= cl->flushed();
 }
@@ -132,6 +132,22 @@ void ZPhysicalMemoryManager::try_ensure_unused_capacity(size_t size) {
   }
 }
 
+size_t ZPhysicalMemoryManager::try_shrink_capacity(size_t size, size_t min_capacity) {
+  const size_t old_capacity = capacity();
+  const size_t target = old_capacity - MIN2(size, unused_capacity());
+  const size_t new_capacity = MAX2(target, MIN2(min_capacity, old_capacity));
+  if (new_capacity == old_capacity) {
+    // Nothing to shrink
+    return 0;
+  }
+
+  // Try to shrink. Only unused memory at the end of the
+  // backing storage can be returned to the operating system.
+  _capacity = _backing.try_shrink(old_capacity, new_capacity);
+
+  return old_capacity - _capacity;
+}
+
 void ZPhysicalMemoryManager::nmt_commit(ZPhysicalMemory pmem, uintptr_t offset) {
   const uintptr_t addr = _backing.nmt_address(offset);
   const size_t size = pmem.size();
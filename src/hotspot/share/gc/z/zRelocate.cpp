@@ -26,13 +26,17 @@
 #include "gc/z/zBarrier.inline.hpp"
 #include "gc/z/zHeap.hpp"
 #include "gc/z/zOopClosures.inline.hpp"
-#include "gc/z/zPage.hpp"
+#include "gc/z/zPage.inline.hpp"
 #include "gc/z/zRelocate.hpp"
 #include "gc/z/zRelocationSet.inline.hpp"
 #include "gc/z/zRootsIterator.hpp"
+#include "gc/z/zStat.hpp"
 #include "gc/z/zTask.hpp"
 #include "gc/z/zThreadLocalAllocBuffer.hpp"
 #include "gc/z/zWorkers.hpp"
+#include "logging/log.hpp"
+
+static const ZStatCounter ZCounterRelocationInPlace("Memory", "Relocation In-Place", ZStatUnitOpsPerSecond);
 
 ZRelocate::ZRelocate(ZWorkers* workers) :
     _workers(workers) {}
@@ -81,16 +85,65 @@ void ZRelocate::start() {
 class ZRelocateObjectClosure : public ObjectClosure {
 private:
   ZPage* const _page;
+  const bool   _in_place;
 
 public:
   ZRelocateObjectClosure(ZPage* page) :
-      _page(page) {}
+      _page(page),
+      _in_place(ZRelocateInPlace && page->type() == ZPageTypeSmall) {}
 
   virtual void do_object(oop o) {
+    if (_in_place && _page->is_pinned()) {
+      // Relocation failed, leave the remaining
+      // objects to be compacted in place
+      return;
+    }
+
     _page->relocate_object(ZOop::to_address(o));
   }
+
+  bool in_place() const {
+    return _in_place;
+  }
+};
+
+class ZRelocateInPlaceObjectClosure : public ObjectClosure {
+private:
+  ZPage* const _page;
+  uintptr_t    _top;
+
+public:
+  ZRelocateInPlaceObjectClosure(ZPage* page) :
+      _page(page),
+      _top(page->start()) {}
+
+  virtual void do_object(oop o) {
+    _top = _page->relocate_object_in_place(ZOop::to_address(o), _top);
+  }
+
+  uintptr_t top() const {
+    return _top;
+  }
 };
 
+void ZRelocate::relocate_in_place(ZPage* page) {
+  // Compact the objects which have not already been relocated to
+  // the bottom of the page, and use the space above them as the
+  // relocation target for the remaining pages handled by this worker.
+  page->relocate_in_place_start();
+
+  ZRelocateInPlaceObjectClosure cl(page);
+  page->object_iterate(&cl);
+
+  page->relocate_in_place_end(cl.top());
+
+  ZHeap::heap()->install_page_for_relocation(page);
+
+  ZStatInc(ZCounterRelocationInPlace);
+  log_debug(gc, reloc)("Relocated in-place, page: " PTR_FORMAT ", remaining: " SIZE_FORMAT "K",
+                       page->start(), page->remaining() / K);
+}
+
 bool ZRelocate::work(ZRelocationSetParallelIterator* iter) {
   bool success = true;
 
@@ -100,6 +153,11 @@ bool ZRelocate::work(ZRelocationSetParallelIterator* iter) {
     ZRelocateObjectClosure cl(page);
     page->object_iterate(&cl);
 
+    if (cl.in_place() && page->is_pinned()) {
+      // Relocation failed, compact page in place
+      relocate_in_place(page);
+    }
+
     if (ZVerifyForwarding) {
       page->verify_forwarding();
     }
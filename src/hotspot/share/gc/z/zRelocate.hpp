@@ -34,6 +34,7 @@ class ZRelocate {
 private:
   ZWorkers* const _workers;
 
+  void relocate_in_place(ZPage* page);
   bool work(ZRelocationSetParallelIterator* iter);
 
 public:
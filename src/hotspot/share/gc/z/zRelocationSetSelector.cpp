@@ -26,10 +26,20 @@
 #include "gc/z/zPage.inline.hpp"
 #include "gc/z/zRelocationSet.hpp"
 #include "gc/z/zRelocationSetSelector.hpp"
+#include "gc/z/zStat.hpp"
 #include "logging/log.hpp"
 #include "runtime/globals.hpp"
 #include "utilities/debug.hpp"
 
+// The cost of relocating a page is estimated as the number of live bytes
+// to copy, plus a fixed cost per live object for the forwarding table
+// insertion and the allocation, expressed in the same unit as bytes.
+static const size_t ZRelocationCostPerObject = 64;
+
+static size_t relocation_cost(const ZPage* page) {
+  return page->live_bytes() + (page->live_objects() * ZRelocationCostPerObject);
+}
+
 ZRelocationSetSelectorGroup::ZRelocationSetSelectorGroup(const char* name,
                                                          size_t page_size,
                                                          size_t object_size_limit) :
@@ -41,6 +51,7 @@ ZRelocationSetSelectorGroup::ZRelocationSetSelectorGroup(const char* name,
     _sorted_pages(NULL),
     _nselected(0),
     _relocating(0),
+    _cost(0),
     _fragmentation(0) {}
 
 ZRelocationSetSelectorGroup::~ZRelocationSetSelectorGroup() {
@@ -96,20 +107,34 @@ void ZRelocationSetSelectorGroup::semi_sort() {
   }
 }
 
-void ZRelocationSetSelectorGroup::select() {
+void ZRelocationSetSelectorGroup::select(size_t budget) {
   // Calculate the number of pages to relocate by successively including pages in
   // a candidate relocation set and calculate the maximum space requirement for
-  // their live objects.
+  // their live objects. Pages are visited in ascending order of live bytes, which
+  // is also the order of decreasing reclaimed space per unit of relocation cost,
+  // so when the relocation cost budget is exhausted no cheaper page remains.
   const size_t npages = _registered_pages.size();
   size_t selected_from = 0;
   size_t selected_to = 0;
+  size_t selected_from_size = 0;
+  size_t selected_cost = 0;
   size_t from_size = 0;
+  size_t from_cost = 0;
 
   semi_sort();
 
   for (size_t from = 1; from <= npages; from++) {
+    const ZPage* const page = _sorted_pages[from - 1];
+    if (from_cost + relocation_cost(page) > budget) {
+      // Relocation cost budget exhausted
+      log_trace(gc, reloc)("Candidate Relocation Set (%s Pages): Budget of " SIZE_FORMAT " exhausted",
+                           _name, budget);
+      break;
+    }
+
     // Add page to the candidate relocation set
-    from_size += _sorted_pages[from - 1]->live_bytes();
+    from_size += page->live_bytes();
+    from_cost += relocation_cost(page);
 
     // Calculate the maximum number of pages needed by the candidate relocation set.
     // By subtracting the object size limit from the pages size we get the maximum
@@ -127,6 +152,8 @@ void ZRelocationSetSelectorGroup::select() {
     if (diff_reclaimable > ZFragmentationLimit) {
       selected_from = from;
       selected_to = to;
+      selected_from_size = from_size;
+      selected_cost = from_cost;
     }
 
     log_trace(gc, reloc)("Candidate Relocation Set (%s Pages): "
@@ -138,14 +165,15 @@ void ZRelocationSetSelectorGroup::select() {
   _nselected = selected_from;
 
   // Update statistics
-  _relocating = from_size;
+  _relocating = selected_from_size;
+  _cost = selected_cost;
   for (size_t i = _nselected; i < npages; i++) {
     const ZPage* const page = _sorted_pages[i];
     _fragmentation += page->size() - page->live_bytes();
   }
 
-  log_debug(gc, reloc)("Relocation Set (%s Pages): " SIZE_FORMAT "->" SIZE_FORMAT ", " SIZE_FORMAT " skipped",
-                       _name, selected_from, selected_to, npages - _nselected);
+  log_debug(gc, reloc)("Relocation Set (%s Pages): " SIZE_FORMAT "->" SIZE_FORMAT ", " SIZE_FORMAT " skipped, "
+                       SIZE_FORMAT " cost", _name, selected_from, selected_to, npages - _nselected, _cost);
 }
 
 const ZPage* const* ZRelocationSetSelectorGroup::selected() const {
@@ -160,6 +188,10 @@ size_t ZRelocationSetSelectorGroup::relocating() const {
   return _relocating;
 }
 
+size_t ZRelocationSetSelectorGroup::cost() const {
+  return _cost;
+}
+
 size_t ZRelocationSetSelectorGroup::fragmentation() const {
   return _fragmentation;
 }
@@ -169,7 +201,9 @@ ZRelocationSetSelector::ZRelocationSetSelector() :
     _medium("Medium", ZPageSizeMedium, ZObjectSizeLimitMedium),
     _live(0),
     _garbage(0),
-    _fragmentation(0) {}
+    _fragmentation(0),
+    _young_live(0),
+    _young_garbage(0) {}
 
 void ZRelocationSetSelector::register_live_page(const ZPage* page) {
   const uint8_t type = page->type();
@@ -186,10 +220,31 @@ void ZRelocationSetSelector::register_live_page(const ZPage* page) {
 
   _live += live;
   _garbage += garbage;
+
+  if (page->is_young()) {
+    _young_live += live;
+    _young_garbage += garbage;
+  }
 }
 
 void ZRelocationSetSelector::register_garbage_page(const ZPage* page) {
   _garbage += page->size();
+
+  if (page->is_young()) {
+    _young_garbage += page->size();
+  }
+}
+
+size_t ZRelocationSetSelector::budget() const {
+  // Convert the relocation time budget into a relocation cost budget,
+  // using the relocation cost rate measured in previous cycles.
+  const double cost_rate = ZStatRelocation::cost_rate();
+  if (ZRelocationTimeBudget == 0 || cost_rate == 0) {
+    // No limit
+    return SIZE_MAX;
+  }
+
+  return (size_t)(cost_rate * ZRelocationTimeBudget / MILLIUNITS);
 }
 
 void ZRelocationSetSelector::select(ZRelocationSet* relocation_set) {
@@ -199,13 +254,24 @@ void ZRelocationSetSelector::select(ZRelocationSet* relocation_set) {
   // bytes in ascending order. Relocating pages in this order allows
   // us to start reclaiming memory more quickly.
 
-  // Select pages from each group
-  _medium.select();
-  _small.select();
+  // Select pages from each group, medium pages first
+  // since they are also relocated first.
+  const size_t budget = this->budget();
+  _medium.select(budget);
+  _small.select(budget - _medium.cost());
 
   // Populate relocation set
   relocation_set->populate(_medium.selected(), _medium.nselected(),
                            _small.selected(), _small.nselected());
+
+  // Young pages are pages allocated since the previous cycle. How much
+  // of their memory is garbage, compared to older pages, shows how well
+  // the heap would suit collecting young pages separately.
+  const size_t young = _young_live + _young_garbage;
+  const size_t old = (_live + _garbage) - young;
+  log_debug(gc, reloc)("Page Ages: Young " SIZE_FORMAT "M (%.0lf%% garbage), Old " SIZE_FORMAT "M (%.0lf%% garbage)",
+                       young / M, percent_of(_young_garbage, young),
+                       old / M, percent_of(_garbage - _young_garbage, old));
 }
 
 size_t ZRelocationSetSelector::live() const {
@@ -220,6 +286,10 @@ size_t ZRelocationSetSelector::relocating() const {
   return _small.relocating() + _medium.relocating();
 }
 
+size_t ZRelocationSetSelector::cost() const {
+  return _small.cost() + _medium.cost();
+}
+
 size_t ZRelocationSetSelector::fragmentation() const {
   return _fragmentation + _small.fragmentation() + _medium.fragmentation();
 }
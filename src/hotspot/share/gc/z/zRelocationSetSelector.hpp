@@ -41,6 +41,7 @@ private:
   const ZPage**        _sorted_pages;
   size_t               _nselected;
   size_t               _relocating;
+  size_t               _cost;
   size_t               _fragmentation;
 
   void semi_sort();
@@ -52,11 +53,12 @@ public:
   ~ZRelocationSetSelectorGroup();
 
   void register_live_page(const ZPage* page, size_t garbage);
-  void select();
+  void select(size_t budget);
 
   const ZPage* const* selected() const;
   size_t nselected() const;
   size_t relocating() const;
+  size_t cost() const;
   size_t fragmentation() const;
 };
 
@@ -67,6 +69,10 @@ private:
   size_t                      _live;
   size_t                      _garbage;
   size_t                      _fragmentation;
+  size_t                      _young_live;
+  size_t                      _young_garbage;
+
+  size_t budget() const;
 
 public:
   ZRelocationSetSelector();
@@ -78,6 +84,7 @@ public:
   size_t live() const;
   size_t garbage() const;
   size_t relocating() const;
+  size_t cost() const;
   size_t fragmentation() const;
 };
 
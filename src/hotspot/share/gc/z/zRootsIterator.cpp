@@ -38,6 +38,7 @@
 #include "gc/z/zRootsIterator.hpp"
 #include "gc/z/zStat.hpp"
 #include "gc/z/zThreadLocalData.hpp"
+#include "logging/log.hpp"
 #include "memory/resourceArea.hpp"
 #include "memory/universe.hpp"
 #include "prims/jvmtiExport.hpp"
@@ -156,15 +157,22 @@ public:
 class ZRootsIteratorThreadClosure : public ThreadClosure {
 private:
   ZRootsIteratorClosure* _cl;
+  size_t                 _nthreads;
 
 public:
   ZRootsIteratorThreadClosure(ZRootsIteratorClosure* cl) :
-      _cl(cl) {}
+      _cl(cl),
+      _nthreads(0) {}
 
   virtual void do_thread(Thread* thread) {
     ZRootsIteratorCodeBlobClosure code_cl(_cl);
     thread->oops_do(_cl, ClassUnloading ? &code_cl : NULL);
     _cl->do_thread(thread);
+    _nthreads++;
+  }
+
+  size_t nthreads() const {
+    return _nthreads;
   }
 };
 
@@ -176,7 +184,8 @@ ZRootsIterator::ZRootsIterator() :
     _jvmti_weak_export(this),
     _system_dictionary(this),
     _threads(this),
-    _code_cache(this) {
+    _code_cache(this),
+    _nthreads(0) {
   assert(SafepointSynchronize::is_at_safepoint(), "Should be at safepoint");
   ZStatTimer timer(ZSubPhasePauseRootsSetup);
   Threads::change_thread_claim_parity();
@@ -200,6 +209,10 @@ ZRootsIterator::~ZRootsIterator() {
 
   COMPILER2_PRESENT(DerivedPointerTable::update_pointers());
   Threads::assert_all_threads_claimed();
+
+  // Thread stacks are scanned in the pause, so the pause
+  // time grows with the number of threads visited here.
+  log_debug(gc, phases)("Pause Roots Threads: " SIZE_FORMAT " threads", _nthreads);
 }
 
 void ZRootsIterator::do_universe(ZRootsIteratorClosure* cl) {
@@ -238,6 +251,7 @@ void ZRootsIterator::do_threads(ZRootsIteratorClosure* cl) {
   ResourceMark rm;
   ZRootsIteratorThreadClosure thread_cl(cl);
   Threads::possibly_parallel_threads_do(true, &thread_cl);
+  Atomic::add(thread_cl.nthreads(), &_nthreads);
 }
 
 void ZRootsIterator::do_code_cache(ZRootsIteratorClosure* cl) {
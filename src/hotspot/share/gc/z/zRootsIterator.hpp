@@ -101,6 +101,7 @@ private:
   ZSerialOopsDo<ZRootsIterator, &ZRootsIterator::do_system_dictionary>   _system_dictionary;
   ZParallelOopsDo<ZRootsIterator, &ZRootsIterator::do_threads>           _threads;
   ZParallelOopsDo<ZRootsIterator, &ZRootsIterator::do_code_cache>        _code_cache;
+  volatile size_t                                                        _nthreads;
 
 public:
   ZRootsIterator();
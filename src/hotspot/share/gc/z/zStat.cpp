@@ -1101,14 +1101,33 @@ void ZStatMark::print() {
 // Stat relocation
 //
 size_t ZStatRelocation::_relocating;
+size_t ZStatRelocation::_cost;
 bool ZStatRelocation::_success;
+NumberSeq ZStatRelocation::_cost_rate(0.3 /* alpha */);
 
-void ZStatRelocation::set_at_select_relocation_set(size_t relocating) {
+void ZStatRelocation::set_at_select_relocation_set(size_t relocating, size_t cost) {
   _relocating = relocating;
+  _cost = cost;
 }
 
-void ZStatRelocation::set_at_relocate_end(bool success) {
+void ZStatRelocation::set_at_relocate_end(bool success, const Tickspan& duration) {
   _success = success;
+
+  // Only sample complete relocations of non-trivial relocation sets,
+  // since anything else says little about the relocation throughput.
+  const double seconds = duration.seconds();
+  if (success && _cost > 0 && seconds > 0) {
+    _cost_rate.add(_cost / seconds);
+  }
+}
+
+double ZStatRelocation::cost_rate() {
+  if (_cost_rate.num() == 0) {
+    // No samples yet
+    return 0;
+  }
+
+  return _cost_rate.davg();
 }
 
 void ZStatRelocation::print() {
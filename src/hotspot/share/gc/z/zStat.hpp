@@ -388,12 +388,16 @@ public:
 //
 class ZStatRelocation : public AllStatic {
 private:
-  static size_t _relocating;
-  static bool   _success;
+  static size_t    _relocating;
+  static size_t    _cost;
+  static bool      _success;
+  static NumberSeq _cost_rate; // Cost/s
 
 public:
-  static void set_at_select_relocation_set(size_t relocating);
-  static void set_at_relocate_end(bool success);
+  static void set_at_select_relocation_set(size_t relocating, size_t cost);
+  static void set_at_relocate_end(bool success, const Tickspan& duration);
+
+  static double cost_rate();
 
   static void print();
 };
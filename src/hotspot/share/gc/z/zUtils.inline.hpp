@@ -64,4 +64,8 @@ inline void ZUtils::object_copy(uintptr_t from, uintptr_t to, size_t size) {
   Copy::aligned_disjoint_words((HeapWord*)from, (HeapWord*)to, bytes_to_words(size));
 }
 
+inline void ZUtils::object_copy_conjoint(uintptr_t from, uintptr_t to, size_t size) {
+  Copy::aligned_conjoint_words((HeapWord*)from, (HeapWord*)to, bytes_to_words(size));
+}
+
 #endif // SHARE_GC_Z_ZUTILS_INLINE_HPP
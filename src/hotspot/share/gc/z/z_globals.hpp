@@ -49,6 +49,10 @@
   product(double, ZFragmentationLimit, 25.0,                                \
           "Maximum allowed heap fragmentation")                             \
                                                                             \
+  product(uintx, ZRelocationTimeBudget, 0,                                  \
+          "Maximum estimated time (in milliseconds) spent relocating "      \
+          "objects in each GC cycle (0 means no limit)")                    \
+                                                                            \
   product(bool, ZStallOnOutOfMemory, true,                                  \
           "Allow Java threads to stall and wait for GC to complete "        \
           "instead of immediately throwing an OutOfMemoryError")            \
@@ -57,6 +61,22 @@
           "Maximum number of bytes allocated for mark stacks")              \
           range(32*M, 1024*G)                                               \
                                                                             \
+  product(bool, ZUncommit, true,                                            \
+          "Uncommit unused memory")                                         \
+                                                                            \
+  product(uintx, ZUncommitDelay, 5 * 60,                                    \
+          "Uncommit memory if it has been unused for the specified "        \
+          "amount of time (in seconds)")                                    \
+                                                                            \
+  manageable(size_t, ZSoftMaxHeapSize, 0,                                   \
+          "Soft limit for the committed Java heap size. Unused memory "     \
+          "above this limit is uncommitted without delay (0 means no "      \
+          "limit)")                                                         \
+                                                                            \
+  product(bool, ZRelocateInPlace, false,                                    \
+          "Compact small pages in place when relocation runs out of "       \
+          "memory, instead of leaving them pinned")                         \
+                                                                            \
   product(uint, ZCollectionInterval, 0,                                     \
           "Force GC at a fixed time interval (in seconds)")                 \
                                                                             \
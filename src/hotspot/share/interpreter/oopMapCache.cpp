@@ -425,7 +425,10 @@ void InterpreterOopMap::resource_copy(OopMapCacheEntry* from) {
 inline unsigned int OopMapCache::hash_value_for(const methodHandle& method, int bci) const {
   // We use method->code_size() rather than method->identity_hash() below since
   // the mark may not be present if a pointer to the method is already reversed.
+  // Metadata does not move, so the Method* address separates methods of the
+  // same shape. It is masked to keep the probe index a positive int.
   return   ((unsigned int) bci)
+         ^ ((unsigned int) (((uintptr_t) method() >> LogBytesPerWord) & right_n_bits(28)))
          ^ ((unsigned int) method->max_locals()         << 2)
          ^ ((unsigned int) method->code_size()          << 4)
          ^ ((unsigned int) method->size_of_parameters() << 6);
@@ -433,7 +436,8 @@ inline unsigned int OopMapCache::hash_value_for(const methodHandle& method, int
 
 OopMapCacheEntry* volatile OopMapCache::_old_entries = NULL;
 
-OopMapCache::OopMapCache() {
+OopMapCache::OopMapCache(int method_count) :
+  _size(MIN2(MAX2((int)_min_size, method_count * 4), (int)_max_size)) {
   _array  = NEW_C_HEAP_ARRAY(OopMapCacheEntry*, _size, mtClass);
   for(int i = 0; i < _size; i++) _array[i] = NULL;
 }
@@ -59,6 +59,7 @@
 #include "runtime/vmThread.hpp"
 #include "services/classLoadingService.hpp"
 #include "services/management.hpp"
+#include "services/memJfrReporter.hpp"
 #include "services/threadService.hpp"
 #include "utilities/exceptions.hpp"
 #include "utilities/globalDefinitions.hpp"
@@ -446,6 +447,18 @@ TRACE_REQUEST_FUNC(PhysicalMemory) {
   event.commit();
 }
 
+TRACE_REQUEST_FUNC(NativeMemoryUsageTotal) {
+  NMT_ONLY(MemJFRReporter::send_total_event();)
+}
+
+TRACE_REQUEST_FUNC(NativeMemoryUsage) {
+  NMT_ONLY(MemJFRReporter::send_type_events();)
+}
+
+TRACE_REQUEST_FUNC(NativeMemoryMallocSite) {
+  NMT_ONLY(MemJFRReporter::send_malloc_site_events();)
+}
+
 TRACE_REQUEST_FUNC(JavaThreadStatistics) {
   EventJavaThreadStatistics event;
   event.set_activeCount(ThreadService::get_live_thread_count());
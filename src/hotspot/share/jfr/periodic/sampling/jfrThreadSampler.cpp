@@ -284,6 +284,8 @@ bool JfrThreadSampleClosure::sample_thread_in_native(JavaThread* thread, JfrStac
 
 static const uint MAX_NR_OF_JAVA_SAMPLES = 5;
 static const uint MAX_NR_OF_NATIVE_SAMPLES = 1;
+// Lower bound for a configured sampling period, in milliseconds.
+static const jlong MIN_SAMPLE_INTERVAL_MS = 1;
 
 void JfrThreadSampleClosure::commit_events(JfrSampleType type) {
   if (JAVA_SAMPLE == type) {
@@ -462,8 +464,8 @@ void JfrThreadSampler::run() {
       last_native_ms = last_java_ms;
     }
     _sample.signal();
-    jlong java_interval = _interval_java == 0 ? max_jlong : MAX2<jlong>(_interval_java, 10);
-    jlong native_interval = _interval_native == 0 ? max_jlong : MAX2<jlong>(_interval_native, 10);
+    jlong java_interval = _interval_java == 0 ? max_jlong : MAX2<jlong>(_interval_java, MIN_SAMPLE_INTERVAL_MS);
+    jlong native_interval = _interval_native == 0 ? max_jlong : MAX2<jlong>(_interval_native, MIN_SAMPLE_INTERVAL_MS);
 
     jlong now_ms = get_monotonic_ms();
 
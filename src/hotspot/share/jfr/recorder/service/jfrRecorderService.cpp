@@ -531,6 +531,19 @@ void JfrRecorderService::process_full_buffers() {
   }
 }
 
+// Make the events recorded so far visible in the current chunk file
+// without waiting for a rotation. Only buffers that can be written
+// concurrently are processed, so no safepoint is needed; events still
+// in the active thread local buffers remain there until they are retired.
+void JfrRecorderService::flush() {
+  if (_chunkwriter.is_valid()) {
+    assert(!JfrStream_lock->owned_by_self(), "invariant");
+    MutexLockerEx stream_lock(JfrStream_lock, Mutex::_no_safepoint_check_flag);
+    _storage.write();
+    _chunkwriter.flush();
+  }
+}
+
 void JfrRecorderService::scavenge() {
   _storage.scavenge();
 }
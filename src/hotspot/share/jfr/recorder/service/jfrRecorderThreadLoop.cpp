@@ -28,6 +28,7 @@
 #include "jfr/recorder/service/jfrRecorderService.hpp"
 #include "jfr/recorder/service/jfrRecorderThread.hpp"
 #include "logging/log.hpp"
+#include "runtime/globals.hpp"
 #include "runtime/mutexLocker.hpp"
 #include "runtime/thread.inline.hpp"
 
@@ -54,14 +55,18 @@ void recorderthread_entry(JavaThread* thread, Thread* unused) {
 
     // JFR MESSAGE LOOP PROCESSING - BEGIN
     while (!done) {
+      bool timed_out = false;
       if (post_box.is_empty()) {
-        JfrMsg_lock->wait(false);
+        timed_out = JfrMsg_lock->wait(false, FlightRecorderFlushInterval);
       }
       msgs = post_box.collect();
       JfrMsg_lock->unlock();
       if (PROCESS_FULL_BUFFERS) {
         service.process_full_buffers();
       }
+      if (timed_out && msgs == 0) {
+        service.flush();
+      }
       if (SCAVENGE) {
         service.scavenge();
       }
@@ -31,10 +31,12 @@
 #include "jfr/utilities/jfrTypes.hpp"
 #include "memory/allocation.inline.hpp"
 #include "runtime/mutexLocker.hpp"
+#include "runtime/orderAccess.hpp"
 #include "runtime/os.inline.hpp"
 #include "runtime/safepoint.hpp"
 #include "runtime/task.hpp"
 #include "runtime/vframe.inline.hpp"
+#include "utilities/globalCounter.inline.hpp"
 
 class vframeStreamSamples : public vframeStreamCommon {
  public:
@@ -122,35 +124,64 @@ bool JfrStackTraceRepository::initialize() {
   return JfrSerializer::register_serializer(TYPE_FRAMETYPE, false, true, new JfrFrameType());
 }
 
+// Unlinks all entries and waits for concurrent lock free readers in
+// add_trace to leave, after which the returned buckets can be deleted.
+// The caller releases the bucket array with FREE_C_HEAP_ARRAY.
+JfrStackTraceRepository::StackTrace** JfrStackTraceRepository::detach_entries() {
+  assert(JfrStacktrace_lock->owned_by_self(), "invariant");
+  StackTrace** const buckets = NEW_C_HEAP_ARRAY(StackTrace*, TABLE_SIZE, mtTracing);
+  memcpy(buckets, _table, sizeof(_table));
+  memset(_table, 0, sizeof(_table));
+  _entries = 0;
+  GlobalCounter::write_synchronize();
+  return buckets;
+}
+
 size_t JfrStackTraceRepository::clear() {
   MutexLockerEx lock(JfrStacktrace_lock, Mutex::_no_safepoint_check_flag);
   if (_entries == 0) {
     return 0;
   }
+  const size_t processed = _entries;
+  StackTrace** const buckets = detach_entries();
   for (u4 i = 0; i < TABLE_SIZE; ++i) {
-    JfrStackTraceRepository::StackTrace* stacktrace = _table[i];
+    JfrStackTraceRepository::StackTrace* stacktrace = buckets[i];
     while (stacktrace != NULL) {
       JfrStackTraceRepository::StackTrace* next = stacktrace->next();
       delete stacktrace;
       stacktrace = next;
     }
   }
-  memset(_table, 0, sizeof(_table));
-  const size_t processed = _entries;
-  _entries = 0;
+  FREE_C_HEAP_ARRAY(StackTrace*, buckets);
   return processed;
 }
 
+const JfrStackTraceRepository::StackTrace* JfrStackTraceRepository::lookup(const StackTrace* head, const JfrStackTrace& stacktrace) {
+  for (const StackTrace* entry = head; entry != NULL; entry = entry->next()) {
+    if (entry->equals(stacktrace)) {
+      return entry;
+    }
+  }
+  return NULL;
+}
+
 traceid JfrStackTraceRepository::add_trace(const JfrStackTrace& stacktrace) {
-  MutexLockerEx lock(JfrStacktrace_lock, Mutex::_no_safepoint_check_flag);
   const size_t index = stacktrace._hash % TABLE_SIZE;
-  const StackTrace* table_entry = _table[index];
-
-  while (table_entry != NULL) {
-    if (table_entry->equals(stacktrace)) {
+  {
+    // Most traces are already in the table, look for them without taking the lock.
+    // Entries are immutable once published and only freed after a write_synchronize().
+    GlobalCounter::CriticalSection cs(Thread::current());
+    const StackTrace* const table_entry = lookup(OrderAccess::load_acquire(&_table[index]), stacktrace);
+    if (table_entry != NULL) {
       return table_entry->id();
     }
-    table_entry = table_entry->next();
+  }
+
+  MutexLockerEx lock(JfrStacktrace_lock, Mutex::_no_safepoint_check_flag);
+  // Recheck, another thread may have added the trace since.
+  const StackTrace* const table_entry = lookup(_table[index], stacktrace);
+  if (table_entry != NULL) {
+    return table_entry->id();
   }
 
   if (!stacktrace.have_lineno()) {
@@ -158,7 +189,7 @@ traceid JfrStackTraceRepository::add_trace(const JfrStackTrace& stacktrace) {
   }
 
   traceid id = ++_next_id;
-  _table[index] = new StackTrace(id, stacktrace, _table[index]);
+  OrderAccess::release_store(&_table[index], new StackTrace(id, stacktrace, _table[index]));
   ++_entries;
   return id;
 }
@@ -241,8 +272,9 @@ size_t JfrStackTraceRepository::write_impl(JfrChunkWriter& sw, bool clear) {
   MutexLockerEx lock(JfrStacktrace_lock, Mutex::_no_safepoint_check_flag);
   assert(_entries > 0, "invariant");
   int count = 0;
+  StackTrace** const buckets = clear ? detach_entries() : _table;
   for (u4 i = 0; i < TABLE_SIZE; ++i) {
-    JfrStackTraceRepository::StackTrace* stacktrace = _table[i];
+    JfrStackTraceRepository::StackTrace* stacktrace = buckets[i];
     while (stacktrace != NULL) {
       JfrStackTraceRepository::StackTrace* next = stacktrace->next();
       if (stacktrace->should_write()) {
@@ -256,8 +288,7 @@ size_t JfrStackTraceRepository::write_impl(JfrChunkWriter& sw, bool clear) {
     }
   }
   if (clear) {
-    memset(_table, 0, sizeof(_table));
-    _entries = 0;
+    FREE_C_HEAP_ARRAY(StackTrace*, buckets);
   }
   return count;
 }
@@ -132,6 +132,8 @@ class JfrStackTraceRepository : public JfrCHeapObj {
   traceid record_for(JavaThread* thread, int skip, JfrStackFrame* frames, u4 max_frames);
   traceid record_for(JavaThread* thread, int skip, JfrStackFrame* frames, u4 max_frames, unsigned int* hash);
   traceid add_trace(const JfrStackTrace& stacktrace);
+  StackTrace** detach_entries();
+  static const StackTrace* lookup(const StackTrace* head, const JfrStackTrace& stacktrace);
   const StackTrace* resolve_entry(unsigned int hash, traceid id) const;
 
   static void write_metadata(JfrCheckpointWriter& cpw);
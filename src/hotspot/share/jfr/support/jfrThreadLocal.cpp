@@ -52,6 +52,7 @@ JfrThreadLocal::JfrThreadLocal() :
   _user_time(0),
   _cpu_time(0),
   _wallclock_time(os::javaTimeNanos()),
+  _sampled_allocated_bytes(0),
   _stack_trace_hash(0),
   _stackdepth(0),
   _entering_suspend_flag(0),
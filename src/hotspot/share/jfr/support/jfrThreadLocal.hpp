@@ -47,6 +47,7 @@ class JfrThreadLocal {
   jlong _user_time;
   jlong _cpu_time;
   jlong _wallclock_time;
+  jlong _sampled_allocated_bytes;
   unsigned int _stack_trace_hash;
   mutable u4 _stackdepth;
   volatile jint _entering_suspend_flag;
@@ -193,6 +194,14 @@ class JfrThreadLocal {
     _wallclock_time = wallclock_time;
   }
 
+  jlong sampled_allocated_bytes() const {
+    return _sampled_allocated_bytes;
+  }
+
+  void set_sampled_allocated_bytes(jlong allocated_bytes) {
+    _sampled_allocated_bytes = allocated_bytes;
+  }
+
   traceid trace_id() const {
     return _trace_id;
   }
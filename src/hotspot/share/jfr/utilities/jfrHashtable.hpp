@@ -77,7 +77,7 @@ class JfrBasicHashtable : public CHeapObj<mtTracing> {
  protected:
   JfrBasicHashtable(uintptr_t table_size, size_t entry_size) :
     _buckets(NULL), _table_size(table_size), _entry_size(entry_size), _number_of_entries(0) {
-    _buckets = NEW_C_HEAP_ARRAY2(Bucket, table_size, mtTracing, CURRENT_PC);
+    _buckets = NEW_C_HEAP_ARRAY2(Bucket, table_size, mtTracing, SAMPLED_CURRENT_PC);
     memset((void*)_buckets, 0, table_size * sizeof(Bucket));
   }
 
@@ -271,7 +271,7 @@ void HashTableHost<T, IdType, Entry, Callback, TABLE_SIZE>::clear_entries() {
 template <typename T, typename IdType, template <typename, typename> class Entry, typename Callback, size_t TABLE_SIZE>
 Entry<T, IdType>* HashTableHost<T, IdType, Entry, Callback, TABLE_SIZE>::new_entry(const T& data, uintptr_t hash) {
   assert(sizeof(HashEntry) == this->entry_size(), "invariant");
-  HashEntry* const entry = (HashEntry*) NEW_C_HEAP_ARRAY2(char, this->entry_size(), mtTracing, CURRENT_PC);
+  HashEntry* const entry = (HashEntry*) NEW_C_HEAP_ARRAY2(char, this->entry_size(), mtTracing, SAMPLED_CURRENT_PC);
   entry->init();
   entry->set_hash(hash);
   entry->set_value(data);
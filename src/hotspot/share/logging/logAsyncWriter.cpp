@@ -0,0 +1,190 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#include "precompiled.hpp"
+#include "jvm.h"
+#include "logging/log.hpp"
+#include "logging/logAsyncWriter.hpp"
+#include "logging/logConfiguration.hpp"
+#include "logging/logFileOutput.hpp"
+#include "runtime/globals.hpp"
+
+AsyncLogWriter* volatile AsyncLogWriter::_instance = NULL;
+
+AsyncLogMessage::AsyncLogMessage(LogFileOutput& output, const LogDecorations& decorations, const char* msg) :
+  _next(NULL), _output(output), _decorations(decorations), _message(os::strdup(msg, mtLogging)) {}
+
+AsyncLogMessage::~AsyncLogMessage() {
+  os::free(_message);
+}
+
+AsyncLogWriter::AsyncLogWriter() :
+  _lock(), _io_sem(1), _head(NULL), _tail(NULL), _buffered_bytes(0), _terminated(false) {
+  if (os::create_thread(this, os::os_thread)) {
+    os::start_thread(this);
+  }
+}
+
+void AsyncLogWriter::initialize() {
+  if (!LogConfiguration::is_async_mode()) {
+    return;
+  }
+  assert(_instance == NULL, "initialize only once");
+  AsyncLogWriter* const writer = new AsyncLogWriter();
+  if (writer->osthread() == NULL) {
+    log_warning(logging)("Failed to create the async log writer thread, logging synchronously.");
+    return;
+  }
+  OrderAccess::release_store(&_instance, writer);
+}
+
+bool AsyncLogWriter::enqueue_locked(LogFileOutput& output, const LogDecorations& decorations, const char* msg) {
+  AsyncLogMessage* const message = new AsyncLogMessage(output, decorations, msg);
+  if (message->_message == NULL) {
+    delete message;
+    return false;
+  }
+  _buffered_bytes += message->size();
+  if (_tail == NULL) {
+    _head = message;
+  } else {
+    _tail->_next = message;
+  }
+  _tail = message;
+  return true;
+}
+
+void AsyncLogWriter::enqueue_or_drop_locked(LogFileOutput& output, const LogDecorations& decorations, const char* msg) {
+  if (_buffered_bytes + sizeof(AsyncLogMessage) + strlen(msg) + 1 > AsyncLogBufferSize) {
+    output._async_dropped++;
+  } else {
+    if (output._async_dropped > 0) {
+      char notice[64];
+      jio_snprintf(notice, sizeof(notice), SIZE_FORMAT " messages dropped due to async logging",
+                   output._async_dropped);
+      if (enqueue_locked(output, decorations, notice)) {
+        output._async_dropped = 0;
+      }
+    }
+    if (!enqueue_locked(output, decorations, msg)) {
+      output._async_dropped++;
+    }
+  }
+}
+
+bool AsyncLogWriter::enqueue(LogFileOutput& output, const LogDecorations& decorations, const char* msg) {
+  _lock.lock();
+  if (_terminated) {
+    _lock.unlock();
+    return false;
+  }
+  enqueue_or_drop_locked(output, decorations, msg);
+  _lock.notify();
+  _lock.unlock();
+  return true;
+}
+
+bool AsyncLogWriter::enqueue(LogFileOutput& output, LogMessageBuffer::Iterator msg_iterator) {
+  _lock.lock();
+  if (_terminated) {
+    _lock.unlock();
+    return false;
+  }
+  // All lines of a LogMessage are enqueued at once, the writer keeps them in order.
+  for (; !msg_iterator.is_at_end(); msg_iterator++) {
+    enqueue_or_drop_locked(output, msg_iterator.decorations(), msg_iterator.message());
+  }
+  _lock.notify();
+  _lock.unlock();
+  return true;
+}
+
+AsyncLogMessage* AsyncLogWriter::detach_locked() {
+  AsyncLogMessage* const head = _head;
+  _head = _tail = NULL;
+  _buffered_bytes = 0;
+  return head;
+}
+
+void AsyncLogWriter::write_all(AsyncLogMessage* message) {
+  while (message != NULL) {
+    AsyncLogMessage* const next = message->_next;
+    message->_output.write_blocking(message->_decorations, message->_message);
+    delete message;
+    message = next;
+  }
+}
+
+void AsyncLogWriter::write() {
+  _io_sem.wait();
+  _lock.lock();
+  AsyncLogMessage* const batch = detach_locked();
+  _lock.unlock();
+  write_all(batch);
+  _io_sem.signal();
+}
+
+void AsyncLogWriter::run() {
+  while (true) {
+    _lock.lock();
+    while (_head == NULL) {
+      _lock.wait(0);
+    }
+    _lock.unlock();
+    write();
+  }
+}
+
+void AsyncLogWriter::flush() {
+  AsyncLogWriter* const writer = instance();
+  if (writer != NULL) {
+    writer->write();
+  }
+}
+
+void AsyncLogWriter::flush_on_error() {
+  AsyncLogWriter* const writer = instance();
+  if (writer == NULL || !writer->_io_sem.trywait()) {
+    return;
+  }
+  if (writer->_lock.try_lock()) {
+    AsyncLogMessage* const batch = writer->detach_locked();
+    writer->_lock.unlock();
+    write_all(batch);
+  }
+  writer->_io_sem.signal();
+}
+
+void AsyncLogWriter::terminate() {
+  AsyncLogWriter* const writer = instance();
+  if (writer != NULL) {
+    // Stop taking messages before the final drain, so that none is left
+    // behind by a thread that raced with us. The writer stays installed to
+    // let flush() wait for a batch it is still writing.
+    writer->_lock.lock();
+    writer->_terminated = true;
+    writer->_lock.unlock();
+    writer->write();
+  }
+}
@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#ifndef SHARE_LOGGING_LOGASYNCWRITER_HPP
+#define SHARE_LOGGING_LOGASYNCWRITER_HPP
+
+#include "logging/logDecorations.hpp"
+#include "logging/logMessageBuffer.hpp"
+#include "memory/allocation.hpp"
+#include "runtime/orderAccess.hpp"
+#include "runtime/os.hpp"
+#include "runtime/semaphore.hpp"
+#include "runtime/thread.hpp"
+
+class LogFileOutput;
+
+// A log message waiting to be written, with the decorations captured
+// when it was logged.
+class AsyncLogMessage : public CHeapObj<mtLogging> {
+  friend class AsyncLogWriter;
+ private:
+  AsyncLogMessage* _next;
+  LogFileOutput& _output;
+  const LogDecorations _decorations;
+  char* const _message;
+
+  AsyncLogMessage(LogFileOutput& output, const LogDecorations& decorations, const char* msg);
+  ~AsyncLogMessage();
+
+  size_t size() const { return sizeof(AsyncLogMessage) + strlen(_message) + 1; }
+};
+
+// With -Xlog:async, messages for file outputs are buffered and written by
+// this thread, so that the logging thread does not wait for the file I/O.
+//
+// The buffer is bounded by AsyncLogBufferSize. When it is full, messages are
+// dropped and counted per output, and the count is written to the output
+// ahead of its next message. The buffer lock is only held to link or unlink
+// messages, never during I/O. Pending messages are flushed when an output is
+// removed, at VM exit and when a fatal error is reported. Once terminated,
+// the writer takes no more messages and enqueue() returns false, telling the
+// caller to write synchronously.
+class AsyncLogWriter : public NonJavaThread {
+ private:
+  static AsyncLogWriter* volatile _instance;
+
+  os::PlatformMonitor _lock;       // Protects the buffer
+  Semaphore _io_sem;               // Held while writing a detached batch
+  AsyncLogMessage* _head;
+  AsyncLogMessage* _tail;
+  size_t _buffered_bytes;
+  bool _terminated;                // No more messages are taken
+
+  AsyncLogWriter();
+
+  bool enqueue_locked(LogFileOutput& output, const LogDecorations& decorations, const char* msg);
+  void enqueue_or_drop_locked(LogFileOutput& output, const LogDecorations& decorations, const char* msg);
+  AsyncLogMessage* detach_locked();
+  static void write_all(AsyncLogMessage* message);
+  void write();
+
+ public:
+  static void initialize();
+  static AsyncLogWriter* instance() { return OrderAccess::load_acquire(&_instance); }
+
+  // Writes all buffered messages on the calling thread. Waits for a batch the
+  // writer thread is writing, so no message for an output is in flight after
+  // the output has been removed from all tag sets and flushed.
+  static void flush();
+  // Like flush(), but gives up instead of blocking, for fatal error reporting.
+  static void flush_on_error();
+  // Turns async logging off and flushes, later messages are written synchronously.
+  static void terminate();
+
+  // Returns false if the message was not taken and must be written by the caller.
+  bool enqueue(LogFileOutput& output, const LogDecorations& decorations, const char* msg);
+  bool enqueue(LogFileOutput& output, LogMessageBuffer::Iterator msg_iterator);
+
+  virtual void run();
+  char* name() const { return (char*)"AsyncLog Thread"; }
+};
+
+#endif // SHARE_LOGGING_LOGASYNCWRITER_HPP
@@ -24,6 +24,7 @@
 #include "precompiled.hpp"
 #include "jvm.h"
 #include "logging/log.hpp"
+#include "logging/logAsyncWriter.hpp"
 #include "logging/logConfiguration.hpp"
 #include "logging/logDecorations.hpp"
 #include "logging/logDecorators.hpp"
@@ -45,6 +46,8 @@ size_t      LogConfiguration::_n_outputs = 0;
 LogConfiguration::UpdateListenerFunction* LogConfiguration::_listener_callbacks = NULL;
 size_t      LogConfiguration::_n_listener_callbacks = 0;
 
+bool        LogConfiguration::_async_mode = false;
+
 // LogFileOutput is the default type of output, its type prefix should be used if no type was specified
 static const char* implicit_output_prefix = LogFileOutput::Prefix;
 
@@ -111,6 +114,7 @@ void LogConfiguration::initialize(jlong vm_start_time) {
 }
 
 void LogConfiguration::finalize() {
+  AsyncLogWriter::terminate();
   for (size_t i = _n_outputs; i > 0; i--) {
     disable_output(i - 1);
   }
@@ -207,6 +211,8 @@ void LogConfiguration::delete_output(size_t idx) {
          "idx must be in range 1 < idx < _n_outputs, but idx = " SIZE_FORMAT
          " and _n_outputs = " SIZE_FORMAT, idx, _n_outputs);
   LogOutput* output = _outputs[idx];
+  // Write out what is still buffered for the output before it goes away
+  AsyncLogWriter::flush();
   // Swap places with the last output and shrink the array
   _outputs[idx] = _outputs[--_n_outputs];
   _outputs = REALLOC_C_HEAP_ARRAY(LogOutput*, _outputs, _n_outputs, mtLogging);
@@ -579,6 +585,11 @@ void LogConfiguration::print_command_line_help(outputStream* out) {
   out->print_cr(" -Xlog:disable -Xlog:safepoint=trace:safepointtrace.txt");
   out->print_cr("\t Turn off all logging, including warnings and errors,");
   out->print_cr("\t and then enable messages tagged with 'safepoint' up to 'trace' level to file 'safepointtrace.txt'.");
+  out->cr();
+
+  out->print_cr(" -Xlog:async -Xlog:gc=debug:file=gc.log");
+  out->print_cr("\t Write messages tagged with 'gc' up to 'debug' level to file 'gc.log' from a separate thread,");
+  out->print_cr("\t buffering up to AsyncLogBufferSize bytes and dropping messages when the buffer is full.");
 }
 
 void LogConfiguration::rotate_all_outputs() {
@@ -59,6 +59,8 @@ class LogConfiguration : public AllStatic {
   static UpdateListenerFunction*    _listener_callbacks;
   static size_t                     _n_listener_callbacks;
 
+  static bool                       _async_mode;
+
   // Create a new output. Returns NULL if failed.
   static LogOutput* new_output(const char* name, const char* options, outputStream* errstream);
 
@@ -123,6 +125,11 @@ class LogConfiguration : public AllStatic {
 
   // Rotates all LogOutput
   static void rotate_all_outputs();
+
+  // Write file outputs on a separate thread (-Xlog:async),
+  // must be selected before the VM starts the AsyncLogWriter.
+  static bool is_async_mode() { return _async_mode; }
+  static void set_async_mode(bool value) { _async_mode = value; }
 };
 
 #endif // SHARE_LOGGING_LOGCONFIGURATION_HPP
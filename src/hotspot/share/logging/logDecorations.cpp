@@ -37,6 +37,19 @@ LogDecorations::LogDecorations(LogLevelType level, const LogTagSet &tagset, cons
   create_decorations(decorators);
 }
 
+LogDecorations::LogDecorations(const LogDecorations& other)
+    : _level(other._level), _tagset(other._tagset), _millis(other._millis) {
+  memcpy(_decorations_buffer, other._decorations_buffer, sizeof(_decorations_buffer));
+  for (uint i = 0; i < LogDecorators::Count; i++) {
+    const char* const offset = other._decoration_offset[i];
+    if (offset >= other._decorations_buffer && offset < other._decorations_buffer + DecorationsBufferSize) {
+      _decoration_offset[i] = _decorations_buffer + (offset - other._decorations_buffer);
+    } else {
+      _decoration_offset[i] = NULL;
+    }
+  }
+}
+
 void LogDecorations::initialize(jlong vm_start_time) {
   char buffer[1024];
   if (os::get_host_name(buffer, sizeof(buffer))){
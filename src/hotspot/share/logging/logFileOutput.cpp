@@ -24,6 +24,7 @@
 #include "precompiled.hpp"
 #include "jvm.h"
 #include "logging/log.hpp"
+#include "logging/logAsyncWriter.hpp"
 #include "logging/logConfiguration.hpp"
 #include "logging/logFileOutput.hpp"
 #include "memory/allocation.inline.hpp"
@@ -46,7 +47,8 @@ LogFileOutput::LogFileOutput(const char* name)
     : LogFileStreamOutput(NULL), _name(os::strdup_check_oom(name, mtLogging)),
       _file_name(NULL), _archive_name(NULL), _current_file(0),
       _file_count(DefaultFileCount), _is_default_file_count(true), _archive_name_len(0),
-      _rotate_size(DefaultFileSize), _current_size(0), _rotation_semaphore(1) {
+      _rotate_size(DefaultFileSize), _current_size(0), _rotation_semaphore(1),
+      _async_dropped(0) {
   assert(strstr(name, Prefix) == name, "invalid output name '%s': missing prefix: %s", name, Prefix);
   _file_name = make_file_name(name + strlen(Prefix), _pid_str, _vm_start_time_str);
 }
@@ -284,7 +286,7 @@ bool LogFileOutput::initialize(const char* options, outputStream* errstream) {
   return true;
 }
 
-int LogFileOutput::write(const LogDecorations& decorations, const char* msg) {
+int LogFileOutput::write_blocking(const LogDecorations& decorations, const char* msg) {
   if (_stream == NULL) {
     // An error has occurred with this output, avoid writing to it.
     return 0;
@@ -302,12 +304,30 @@ int LogFileOutput::write(const LogDecorations& decorations, const char* msg) {
   return written;
 }
 
+int LogFileOutput::write(const LogDecorations& decorations, const char* msg) {
+  if (_stream == NULL) {
+    // An error has occurred with this output, avoid writing to it.
+    return 0;
+  }
+
+  AsyncLogWriter* const async_writer = AsyncLogWriter::instance();
+  if (async_writer != NULL && async_writer->enqueue(*this, decorations, msg)) {
+    return 0;
+  }
+  return write_blocking(decorations, msg);
+}
+
 int LogFileOutput::write(LogMessageBuffer::Iterator msg_iterator) {
   if (_stream == NULL) {
     // An error has occurred with this output, avoid writing to it.
     return 0;
   }
 
+  AsyncLogWriter* const async_writer = AsyncLogWriter::instance();
+  if (async_writer != NULL && async_writer->enqueue(*this, msg_iterator)) {
+    return 0;
+  }
+
   _rotation_semaphore.wait();
   int written = LogFileStreamOutput::write(msg_iterator);
   _current_size += written;
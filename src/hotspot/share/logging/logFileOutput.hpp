@@ -32,6 +32,7 @@ class LogDecorations;
 
 // The log file output, with support for file rotation based on a target size.
 class LogFileOutput : public LogFileStreamOutput {
+  friend class AsyncLogWriter;
  private:
   static const char* const FileOpenMode;
   static const char* const FileCountOptionKey;
@@ -63,6 +64,9 @@ class LogFileOutput : public LogFileStreamOutput {
   // Semaphore used for synchronizing file rotations and writes
   Semaphore _rotation_semaphore;
 
+  // Messages dropped because the async log buffer was full, guarded by the AsyncLogWriter
+  size_t _async_dropped;
+
   void archive();
   void rotate();
   bool parse_options(const char* options, outputStream* errstream);
@@ -85,6 +89,8 @@ class LogFileOutput : public LogFileStreamOutput {
   virtual bool initialize(const char* options, outputStream* errstream);
   virtual int write(const LogDecorations& decorations, const char* msg);
   virtual int write(LogMessageBuffer::Iterator msg_iterator);
+  // Write the message to the file on the calling thread, even with -Xlog:async.
+  int write_blocking(const LogDecorations& decorations, const char* msg);
   virtual void force_rotate();
   virtual void describe(outputStream* out);
 
@@ -31,6 +31,7 @@
 #include "runtime/atomic.hpp"
 #include "runtime/os.hpp"
 #include "runtime/task.hpp"
+#include "runtime/thread.hpp"
 #include "runtime/threadCritical.hpp"
 #include "services/memTracker.hpp"
 #include "utilities/ostream.hpp"
@@ -76,7 +77,7 @@ class ChunkPool: public CHeapObj<mtInternal> {
       _num_used++;
       p = get_first();
     }
-    if (p == NULL) p = os::malloc(bytes, mtChunk, CURRENT_PC);
+    if (p == NULL) p = os::malloc(bytes, mtChunk, SAMPLED_CURRENT_PC);
     if (p == NULL && alloc_failmode == AllocFailStrategy::EXIT_OOM) {
       vm_exit_out_of_memory(bytes, OOM_MALLOC_ERROR, "ChunkPool::allocate");
     }
@@ -131,6 +132,16 @@ class ChunkPool: public CHeapObj<mtInternal> {
   static ChunkPool* small_pool()  { assert(_small_pool  != NULL, "must be initialized"); return _small_pool;  }
   static ChunkPool* tiny_pool()   { assert(_tiny_pool   != NULL, "must be initialized"); return _tiny_pool;   }
 
+  // Pool for a ChunkCache::size_index()
+  static ChunkPool* pool_at(int index) {
+    switch (index) {
+     case 0:  return tiny_pool();
+     case 1:  return small_pool();
+     case 2:  return medium_pool();
+     default: assert(index == 3, "bad index"); return large_pool();
+    }
+  }
+
   static void initialize() {
     _large_pool  = new ChunkPool(Chunk::size        + Chunk::aligned_overhead_size());
     _medium_pool = new ChunkPool(Chunk::medium_size + Chunk::aligned_overhead_size());
@@ -176,6 +187,61 @@ class ChunkPoolCleaner : public PeriodicTask {
    }
 };
 
+//--------------------------------------------------------------------------------------
+// ChunkCache implementation
+
+ChunkCache::ChunkCache() : _in_use(0), _peak(0) {
+  for (int i = 0; i < num_sizes; i++) {
+    _first[i] = NULL;
+    _count[i] = 0;
+  }
+}
+
+ChunkCache::~ChunkCache() {
+  for (int i = 0; i < num_sizes; i++) {
+    Chunk* c = _first[i];
+    while (c != NULL) {
+      Chunk* next = c->next();
+      ChunkPool::pool_at(i)->free(c);
+      c = next;
+    }
+  }
+}
+
+int ChunkCache::size_index(size_t length) {
+  switch (length) {
+   case Chunk::tiny_size:   return 0;
+   case Chunk::init_size:   return 1;
+   case Chunk::medium_size: return 2;
+   case Chunk::size:        return 3;
+   default:                 return -1;
+  }
+}
+
+Chunk* ChunkCache::take(int index) {
+  Chunk* c = _first[index];
+  if (c != NULL) {
+    _first[index] = c->next();
+    _count[index]--;
+  }
+  return c;
+}
+
+bool ChunkCache::put(int index, Chunk* chunk) {
+  if (_count[index] >= max_cached) {
+    return false;
+  }
+  chunk->set_next(_first[index]);
+  _first[index] = chunk;
+  _count[index]++;
+  return true;
+}
+
+static ChunkCache* current_chunk_cache() {
+  Thread* thread = Thread::current_or_null();
+  return thread != NULL ? thread->chunk_cache() : NULL;
+}
+
 //--------------------------------------------------------------------------------------
 // Chunk implementation
 
@@ -186,23 +252,38 @@ void* Chunk::operator new (size_t requested_size, AllocFailType alloc_failmode,
   // expect requested_size but if sizeof(Chunk) doesn't match isn't proper size we must align it.
   assert(ARENA_ALIGN(requested_size) == aligned_overhead_size(), "Bad alignment");
   size_t bytes = ARENA_ALIGN(requested_size) + length;
-  switch (length) {
-   case Chunk::size:        return ChunkPool::large_pool()->allocate(bytes, alloc_failmode);
-   case Chunk::medium_size: return ChunkPool::medium_pool()->allocate(bytes, alloc_failmode);
-   case Chunk::init_size:   return ChunkPool::small_pool()->allocate(bytes, alloc_failmode);
-   case Chunk::tiny_size:   return ChunkPool::tiny_pool()->allocate(bytes, alloc_failmode);
-   default: {
-     void* p = os::malloc(bytes, mtChunk, CALLER_PC);
-     if (p == NULL && alloc_failmode == AllocFailStrategy::EXIT_OOM) {
-       vm_exit_out_of_memory(bytes, OOM_MALLOC_ERROR, "Chunk::new");
-     }
-     return p;
-   }
+  ChunkCache* cache = current_chunk_cache();
+  int index = ChunkCache::size_index(length);
+  void* p = NULL;
+  if (cache != NULL && index >= 0) {
+    p = cache->take(index);
+  }
+  if (p == NULL) {
+    if (index >= 0) {
+      p = ChunkPool::pool_at(index)->allocate(bytes, alloc_failmode);
+    } else {
+      p = os::malloc(bytes, mtChunk, SAMPLED_CALLER_PC);
+      if (p == NULL && alloc_failmode == AllocFailStrategy::EXIT_OOM) {
+        vm_exit_out_of_memory(bytes, OOM_MALLOC_ERROR, "Chunk::new");
+      }
+    }
+  }
+  if (cache != NULL && p != NULL) {
+    cache->record_allocate(length);
   }
+  return p;
 }
 
 void Chunk::operator delete(void* p) {
   Chunk* c = (Chunk*)p;
+  ChunkCache* cache = current_chunk_cache();
+  if (cache != NULL) {
+    cache->record_free(c->length());
+    int index = ChunkCache::size_index(c->length());
+    if (index >= 0 && cache->put(index, c)) {
+      return;
+    }
+  }
   switch (c->length()) {
    case Chunk::size:        ChunkPool::large_pool()->free(c); break;
    case Chunk::medium_size: ChunkPool::medium_pool()->free(c); break;
@@ -298,11 +379,11 @@ void* Arena::operator new (size_t size, const std::nothrow_t&  nothrow_constant)
 
   // dynamic memory type binding
 void* Arena::operator new(size_t size, MEMFLAGS flags) throw() {
-  return (void *) AllocateHeap(size, flags, CALLER_PC);
+  return (void *) AllocateHeap(size, flags, SAMPLED_CALLER_PC);
 }
 
 void* Arena::operator new(size_t size, const std::nothrow_t& nothrow_constant, MEMFLAGS flags) throw() {
-  return (void*)AllocateHeap(size, flags, CALLER_PC, AllocFailStrategy::RETURN_NULL);
+  return (void*)AllocateHeap(size, flags, SAMPLED_CALLER_PC, AllocFailStrategy::RETURN_NULL);
 }
 
 void Arena::operator delete(void* p) {
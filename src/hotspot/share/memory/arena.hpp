@@ -88,6 +88,52 @@ class Chunk: CHeapObj<mtChunk> {
   static void clean_chunk_pool();
 };
 
+//------------------------------ChunkCache-------------------------------------
+// Small per-thread cache of pool sized chunks. Threads that create and
+// destroy arenas at a high rate, like compiler threads, take and return
+// chunks here instead of going through the global ChunkPools and their
+// ThreadCritical lock. At most max_cached chunks of each pool size are
+// kept, the others go back to the pools.
+//
+// The cache also tracks the chunk bytes the thread has checked out, and
+// their high water mark since the last reset_peak().
+class ChunkCache : public CHeapObj<mtChunk> {
+ public:
+  enum {
+    num_sizes  = 4,             // tiny, init, medium and default chunk size
+    max_cached = 2              // per size
+  };
+
+ private:
+  Chunk* _first[num_sizes];
+  uint   _count[num_sizes];
+  size_t _in_use;               // Chunk bytes checked out by this thread
+  size_t _peak;                 // High water mark of _in_use
+
+ public:
+  ChunkCache();
+  ~ChunkCache();                // Returns the cached chunks to the pools
+
+  // Index of the cache slot for chunks of the given length, or -1 if
+  // chunks of that length are not pooled.
+  static int size_index(size_t length);
+
+  // Returns a cached chunk of the given slot, or NULL.
+  Chunk* take(int index);
+  // Returns false if the slot is full and the chunk was not cached.
+  bool put(int index, Chunk* chunk);
+
+  void record_allocate(size_t length) {
+    _in_use += length;
+    _peak = MAX2(_peak, _in_use);
+  }
+  // Chunks can be freed by another thread than the one that allocated them
+  void record_free(size_t length) { _in_use -= MIN2(_in_use, length); }
+
+  size_t peak() const { return _peak; }
+  void reset_peak()   { _peak = _in_use; }
+};
+
 //------------------------------Arena------------------------------------------
 // Fast allocation of memory
 class Arena : public CHeapObj<mtNone> {
@@ -212,6 +212,38 @@ void FileMapHeader::populate(FileMapInfo* mapinfo, size_t alignment) {
   _has_platform_or_app_classes = ClassLoaderExt::has_platform_or_app_classes();
   _shared_base_address = SharedBaseAddress;
   _allow_archiving_with_java_agent = AllowArchivingWithJavaAgent;
+  _module_options_crc = module_options_crc();
+}
+
+// The archived module graph (ArchivedModuleGraph) is resolved with the
+// module options of the dump time VM. Options that do not change which
+// modules are in the boot layer graph, such as the main module or
+// --add-exports, are not included.
+static bool is_module_graph_property(const char* key) {
+  static const char* const props[] = {
+    "jdk.module.path",
+    "jdk.module.upgrade.path",
+    "jdk.module.limitmods",
+    "jdk.module.addmods",
+  };
+  for (uint i = 0; i < ARRAY_SIZE(props); i++) {
+    size_t len = strlen(props[i]);
+    if (strncmp(key, props[i], len) == 0 && (key[len] == '\0' || key[len] == '.')) {
+      return true;
+    }
+  }
+  return false;
+}
+
+int FileMapHeader::module_options_crc() {
+  int crc = 0;
+  for (SystemProperty* p = Arguments::system_properties(); p != NULL; p = p->next()) {
+    if (is_module_graph_property(p->key()) && p->value() != NULL) {
+      crc = ClassLoader::crc32(crc, p->key(), (jint)strlen(p->key()));
+      crc = ClassLoader::crc32(crc, p->value(), (jint)strlen(p->value()));
+    }
+  }
+  return crc;
 }
 
 void SharedClassPathEntry::init(const char* name, bool is_modules_image, TRAPS) {
@@ -1388,6 +1420,14 @@ bool FileMapHeader::validate() {
             "for testing purposes only and should not be used in a production environment");
   }
 
+  if (_module_options_crc != module_options_crc()) {
+    // The rest of the archive is still usable, only the module graph
+    // has to be built from scratch.
+    log_info(cds)("Archived module graph is disabled because the module options are "
+                  "different from the dump time options");
+    HeapShared::disable_archived_module_graph();
+  }
+
   return true;
 }
 
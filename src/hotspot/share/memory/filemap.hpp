@@ -152,6 +152,7 @@ struct FileMapHeader : public CDSFileMapHeaderBase {
   bool   _has_platform_or_app_classes;  // Archive contains app classes
   size_t _shared_base_address;          // SharedBaseAddress used at dump time
   bool   _allow_archiving_with_java_agent; // setting of the AllowArchivingWithJavaAgent option
+  int    _module_options_crc;           // CRC of the boot layer module options used at dump time
 
   void set_has_platform_or_app_classes(bool v) {
     _has_platform_or_app_classes = v;
@@ -162,6 +163,7 @@ struct FileMapHeader : public CDSFileMapHeaderBase {
 
   bool validate();
   void populate(FileMapInfo* info, size_t alignment);
+  static int module_options_crc();
   int compute_crc();
 
   CDSFileMapRegion* space_at(int i) {
@@ -248,7 +248,11 @@ void CodeHeap::deallocate(void* p) {
             p2i(b), p2i(_memory.low_boundary()), p2i(_memory.high()));
   DEBUG_ONLY(memset((void *)b->allocated_space(), badCodeHeapFreeVal,
              segments_to_size(b->length()) - sizeof(HeapBlock)));
+  bool at_top = (segment_for(b) + b->length() == _next_segment);
   add_to_freelist(b);
+  if (at_top) {
+    release_freelist_tail();
+  }
   NOT_PRODUCT(verify());
 }
 
@@ -459,6 +463,44 @@ void CodeHeap::add_to_freelist(HeapBlock* a) {
   insert_after(prev, b);
 }
 
+/**
+ * Returns the last freelist entry to the unallocated part of the heap if it
+ * ends at _next_segment. Any free space at the top of the heap is then part of
+ * the contiguous unallocated capacity instead of fragmenting the freelist.
+ */
+void CodeHeap::release_freelist_tail() {
+  FreeBlock* prev = NULL;
+  FreeBlock* last = _freelist;
+  if (last == NULL) {
+    return;
+  }
+  while (last->link() != NULL) {
+    prev = last;
+    last = last->link();
+  }
+  size_t beg = segment_for(last);
+  if (beg + last->length() != _next_segment) {
+    return;
+  }
+  if (prev == NULL) {
+    _freelist = NULL;
+  } else {
+    prev->set_link(NULL);
+  }
+  _freelist_length--;
+  _freelist_segments -= last->length();
+  mark_segmap_as_free(beg, _next_segment);
+  _next_segment = beg;
+}
+
+size_t CodeHeap::largest_free_block() const {
+  size_t len = 0;
+  for (FreeBlock* b = _freelist; b != NULL; b = b->link()) {
+    len = MAX2(len, b->length());
+  }
+  return segments_to_size(len);
+}
+
 /**
  * Search freelist for an entry on the list with the best fit.
  * @return NULL, if no one was found
@@ -471,15 +513,19 @@ FreeBlock* CodeHeap::search_freelist(size_t length) {
   FreeBlock* prev = NULL;
   FreeBlock* cur = _freelist;
 
-  // Search for first block that fits
+  // Search for the smallest block that fits. Stop early on a block that
+  // would not leave a remainder worth keeping on the freelist.
   while(cur != NULL) {
-    if (cur->length() >= length) {
+    size_t cur_length = cur->length();
+    if (cur_length >= length && (found_block == NULL || cur_length < found_length)) {
       // Remember block, its previous element, and its length
       found_block = cur;
       found_prev  = prev;
-      found_length = found_block->length();
+      found_length = cur_length;
 
-      break;
+      if (cur_length - length < CodeCacheMinBlockLength) {
+        break;
+      }
     }
     // Next element in list
     prev = cur;
@@ -126,6 +126,7 @@ class CodeHeap : public CHeapObj<mtCode> {
   // Toplevel freelist management
   void add_to_freelist(HeapBlock* b);
   FreeBlock* search_freelist(size_t length);
+  void release_freelist_tail();
 
   // Iteration helpers
   void*      next_used(HeapBlock* b) const;
@@ -185,6 +186,7 @@ class CodeHeap : public CHeapObj<mtCode> {
 
   size_t allocated_in_freelist() const           { return _freelist_segments * CodeCacheSegmentSize; }
   int    freelist_length()       const           { return _freelist_length; } // number of elements in the freelist
+  size_t largest_free_block()    const;          // largest block in the freelist, in bytes
 
   // returns the first block or NULL
   virtual void* first() const                    { return next_used(first_block()); }
@@ -28,10 +28,13 @@
 #include "classfile/moduleEntry.hpp"
 #include "classfile/systemDictionary.hpp"
 #include "gc/shared/collectedHeap.hpp"
+#include "gc/shared/workgroup.hpp"
 #include "memory/heapInspection.hpp"
 #include "memory/resourceArea.hpp"
 #include "oops/oop.inline.hpp"
 #include "oops/reflectionAccessorImplKlassHelper.hpp"
+#include "runtime/atomic.hpp"
+#include "runtime/mutexLocker.hpp"
 #include "runtime/os.hpp"
 #include "utilities/globalDefinitions.hpp"
 #include "utilities/macros.hpp"
@@ -235,6 +238,42 @@ size_t KlassInfoTable::size_of_instances_in_words() const {
   return _size_of_instances_in_words;
 }
 
+// Return false if the entry could not be recorded on account
+// of running out of space required to create a new entry.
+bool KlassInfoTable::merge_entry(const KlassInfoEntry* cie) {
+  Klass*          k = cie->klass();
+  KlassInfoEntry* elt = lookup(k);
+  // elt may be NULL if it's a new klass for which we
+  // could not allocate space for a new entry in the hashtable.
+  if (elt != NULL) {
+    elt->set_count(elt->count() + cie->count());
+    elt->set_words(elt->words() + cie->words());
+    _size_of_instances_in_words += cie->words();
+    return true;
+  }
+  return false;
+}
+
+class KlassInfoTableMergeClosure : public KlassInfoClosure {
+ private:
+  KlassInfoTable* _dest;
+  size_t _missed_count;
+ public:
+  KlassInfoTableMergeClosure(KlassInfoTable* table) : _dest(table), _missed_count(0) {}
+  void do_cinfo(KlassInfoEntry* cie) {
+    if (!_dest->merge_entry(cie)) {
+      _missed_count += cie->count();
+    }
+  }
+  size_t missed_count() const { return _missed_count; }
+};
+
+size_t KlassInfoTable::merge(KlassInfoTable* table) {
+  KlassInfoTableMergeClosure closure(this);
+  table->iterate(&closure);
+  return closure.missed_count();
+}
+
 int KlassInfoHisto::sort_helper(KlassInfoEntry** e1, KlassInfoEntry** e2) {
   return (*e1)->compare(*e1,*e2);
 }
@@ -694,7 +733,7 @@ class RecordInstanceClosure : public ObjectClosure {
 
   void do_object(oop obj) {
     if (should_visit(obj)) {
-      if (!_cit->record_instance(obj)) {
+      if (_cit->allocation_failed() || !_cit->record_instance(obj)) {
         _missed_count++;
       }
     }
@@ -708,15 +747,74 @@ class RecordInstanceClosure : public ObjectClosure {
   }
 };
 
-size_t HeapInspection::populate_table(KlassInfoTable* cit, BoolObjectClosure *filter) {
+// Each worker fills a table of its own from the objects it visits and
+// merges it into the shared table at the end.
+class ParHeapInspectTask : public AbstractGangTask {
+ private:
+  ParallelObjectIterator* _poi;
+  KlassInfoTable* _shared_cit;
+  BoolObjectClosure* _filter;
+  size_t _missed_count;
+  Mutex _mutex;
+
+ public:
+  ParHeapInspectTask(ParallelObjectIterator* poi,
+                     KlassInfoTable* shared_cit,
+                     BoolObjectClosure* filter) :
+      AbstractGangTask("Iterating heap"),
+      _poi(poi),
+      _shared_cit(shared_cit),
+      _filter(filter),
+      _missed_count(0),
+      _mutex(Mutex::leaf, "Parallel heap iteration data merge lock", false,
+             Monitor::_safepoint_check_never) { }
+
+  size_t missed_count() const { return _missed_count; }
+
+  void work(uint worker_id) {
+    // if the table cannot be allocated, the objects this worker visits
+    // are counted as missed
+    KlassInfoTable cit(false);
+    RecordInstanceClosure ric(&cit, _filter);
+    _poi->object_iterate(&ric, worker_id);
+
+    size_t missed_count = ric.missed_count();
+    if (!cit.allocation_failed()) {
+      MutexLockerEx ml(&_mutex, Mutex::_no_safepoint_check_flag);
+      missed_count += _shared_cit->merge(&cit);
+    }
+    Atomic::add(missed_count, &_missed_count);
+  }
+};
+
+size_t HeapInspection::populate_table(KlassInfoTable* cit, BoolObjectClosure *filter, uint parallel_thread_num) {
   ResourceMark rm;
 
+  // Try parallel first.
+  if (parallel_thread_num != 1) {
+    CollectedHeap* heap = Universe::heap();
+    WorkGang* gang = heap->get_safepoint_workers();
+    if (gang != NULL) {
+      uint num_workers = gang->total_workers();
+      if (parallel_thread_num != 0) {
+        num_workers = MIN2(num_workers, parallel_thread_num);
+      }
+      ParallelObjectIterator* poi = num_workers > 1 ? heap->parallel_object_iterator(num_workers) : NULL;
+      if (poi != NULL) {
+        ParHeapInspectTask task(poi, cit, filter);
+        gang->run_task(&task, num_workers);
+        delete poi;
+        return task.missed_count();
+      }
+    }
+  }
+
   RecordInstanceClosure ric(cit, filter);
   Universe::heap()->object_iterate(&ric);
   return ric.missed_count();
 }
 
-void HeapInspection::heap_inspection(outputStream* st) {
+void HeapInspection::heap_inspection(outputStream* st, uint parallel_thread_num) {
   ResourceMark rm;
 
   if (_print_help) {
@@ -740,7 +838,7 @@ void HeapInspection::heap_inspection(outputStream* st) {
   KlassInfoTable cit(_print_class_stats);
   if (!cit.allocation_failed()) {
     // populate table with object allocation info
-    size_t missed_count = populate_table(&cit);
+    size_t missed_count = populate_table(&cit, NULL, parallel_thread_num);
     if (missed_count != 0) {
       st->print_cr("WARNING: Ran out of C-heap; undercounted " SIZE_FORMAT
                    " total instances in data below",
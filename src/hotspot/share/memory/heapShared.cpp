@@ -51,6 +51,7 @@
 bool HeapShared::_closed_archive_heap_region_mapped = false;
 bool HeapShared::_open_archive_heap_region_mapped = false;
 bool HeapShared::_archive_heap_region_fixed = false;
+bool HeapShared::_archived_module_graph_disabled = false;
 
 address   HeapShared::_narrow_oop_base;
 int       HeapShared::_narrow_oop_shift;
@@ -427,12 +428,23 @@ void HeapShared::serialize_subgraph_info_table_header(SerializeClosure* soc) {
   _run_time_subgraph_info_table.serialize_header(soc);
 }
 
+void HeapShared::disable_archived_module_graph() {
+  _archived_module_graph_disabled = true;
+}
+
 void HeapShared::initialize_from_archived_subgraph(Klass* k) {
   if (!open_archive_heap_region_mapped()) {
     return; // nothing to do
   }
   assert(!DumpSharedSpaces, "Should not be called with DumpSharedSpaces");
 
+  if (_archived_module_graph_disabled &&
+      k->name()->equals("jdk/internal/module/ArchivedModuleGraph")) {
+    // Leave the static fields NULL so that the module graph is rebuilt
+    log_info(cds, heap)("Archived module graph is not used");
+    return;
+  }
+
   unsigned int hash = primitive_hash<Klass*>(k);
   const ArchivedKlassSubGraphInfoRecord* record = _run_time_subgraph_info_table.lookup(k, hash, 0);
 
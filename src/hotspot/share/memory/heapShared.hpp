@@ -123,6 +123,7 @@ class HeapShared: AllStatic {
   static bool _closed_archive_heap_region_mapped;
   static bool _open_archive_heap_region_mapped;
   static bool _archive_heap_region_fixed;
+  static bool _archived_module_graph_disabled;
 
   static bool oop_equals(oop const& p1, oop const& p2) {
     return oopDesc::equals(p1, p2);
@@ -314,6 +315,8 @@ private:
     NOT_CDS_JAVA_HEAP_RETURN_(false);
   }
 
+  static void disable_archived_module_graph() NOT_CDS_JAVA_HEAP_RETURN;
+
   static void fixup_mapped_heap_regions() NOT_CDS_JAVA_HEAP_RETURN;
 
   inline static bool is_archived_object(oop p) NOT_CDS_JAVA_HEAP_RETURN_(false);
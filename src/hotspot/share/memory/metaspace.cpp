@@ -1085,6 +1085,9 @@ void Metaspace::allocate_metaspace_compressed_klass_ptrs(char* requested_addr, a
 
   // If we got here then the metaspace got allocated.
   MemTracker::record_virtual_memory_type((address)metaspace_rs.base(), mtClass);
+  os::trace_page_sizes("Compressed class space", compressed_class_space_size(),
+                       compressed_class_space_size(), _commit_alignment,
+                       metaspace_rs.base(), metaspace_rs.size());
 
 #if INCLUDE_CDS
   // Verify that we can use shared spaces.  Otherwise, turn off CDS.
@@ -1142,6 +1145,15 @@ void Metaspace::ergo_initialize() {
     // Using large pages when dumping the shared archive is currently not implemented.
     FLAG_SET_ERGO(bool, UseLargePagesInMetaspace, false);
   }
+#ifdef LINUX
+  // Transparent huge pages are committed on demand like small pages, so
+  // unlike pinned large pages they don't inflate the metaspace footprint
+  // up front. Use them like the Java heap and the code cache do.
+  if (UseLargePages && UseTransparentHugePages && !DumpSharedSpaces &&
+      FLAG_IS_DEFAULT(UseLargePagesInMetaspace)) {
+    FLAG_SET_ERGO(bool, UseLargePagesInMetaspace, true);
+  }
+#endif
 
   size_t page_size = os::vm_page_size();
   if (UseLargePages && UseLargePagesInMetaspace) {
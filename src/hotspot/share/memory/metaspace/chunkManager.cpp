@@ -34,6 +34,8 @@
 #include "memory/metaspace/occupancyMap.hpp"
 #include "memory/metaspace/virtualSpaceNode.hpp"
 #include "runtime/mutexLocker.hpp"
+#include "runtime/os.hpp"
+#include "utilities/align.hpp"
 #include "utilities/debug.hpp"
 #include "utilities/globalDefinitions.hpp"
 #include "utilities/ostream.hpp"
@@ -135,6 +137,9 @@ bool ChunkManager::attempt_to_coalesce_around_chunk(Metachunk* chunk, ChunkIndex
   ChunkList* const list = free_chunks(target_chunk_type);
   list->return_chunk_at_head(p_new_chunk);
 
+  // A freshly merged medium chunk is unlikely to be reused soon.
+  release_free_chunk_memory(p_new_chunk);
+
   // And adjust ChunkManager:: _free_chunks_count (_free_chunks_total
   // should not have changed, because the size of the space should be the same)
   _free_chunks_count -= num_chunks_removed;
@@ -569,6 +574,25 @@ Metachunk* ChunkManager::chunk_freelist_allocate(size_t word_size) {
   return chunk;
 }
 
+void ChunkManager::release_free_chunk_memory(Metachunk* chunk) {
+  assert_lock_strong(MetaspaceExpand_lock);
+  assert(chunk->is_tagged_free(), "Chunk should be free.");
+  // Large pages cannot be partially discarded.
+  if (!MetaspaceUncommitFreeChunks || UseLargePagesInMetaspace) {
+    return;
+  }
+  // Skip the header: it holds the freelist links and, for humongous chunks,
+  // the dictionary tree node data.
+  const size_t header_bytes = sizeof(TreeChunk<Metachunk, FreeList<Metachunk> >);
+  char* const start = align_up((char*)chunk + header_bytes, os::vm_page_size());
+  char* const end = align_down((char*)(chunk->bottom() + chunk->word_size()), os::vm_page_size());
+  if (start < end) {
+    os::free_memory(start, end - start, os::vm_page_size());
+    log_trace(gc, metaspace, freelist)("released " SIZE_FORMAT " bytes of free %s chunk at " PTR_FORMAT ".",
+        (size_t)(end - start), chunk_size_name(chunk->get_chunk_type()), p2i(chunk));
+  }
+}
+
 void ChunkManager::return_single_chunk(Metachunk* chunk) {
   const ChunkIndex index = chunk->get_chunk_type();
   assert_lock_strong(MetaspaceExpand_lock);
@@ -605,6 +629,12 @@ void ChunkManager::return_single_chunk(Metachunk* chunk) {
   // Chunk has been added; update counters.
   account_for_added_chunk(chunk);
 
+  // Medium and humongous chunks span several pages; do not keep their
+  // memory resident while they sit in the freelist.
+  if (index == MediumIndex || index == HumongousIndex) {
+    release_free_chunk_memory(chunk);
+  }
+
   // Attempt coalesce returned chunks with its neighboring chunks:
   // if this chunk is small or special, attempt to coalesce to a medium chunk.
   if (index == SmallIndex || index == SpecializedIndex) {
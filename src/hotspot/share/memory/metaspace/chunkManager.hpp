@@ -106,6 +106,12 @@ class ChunkManager : public CHeapObj<mtInternal> {
   // Returns number of chunks removed.
   int remove_chunks_in_area(MetaWord* p, size_t word_size);
 
+  // Helper for returning chunks: hand the physical pages backing the payload
+  // of a free chunk back to the operating system (see MetaspaceUncommitFreeChunks).
+  // The chunk header and the humongous dictionary tree node data are kept intact.
+  // Does not change the committed size of the containing VirtualSpaceNode.
+  void release_free_chunk_memory(Metachunk* chunk);
+
   // Helper for chunk splitting: given a target chunk size and a larger free chunk,
   // split up the larger chunk into n smaller chunks, at least one of which should be
   // the target chunk of target chunk size. The smaller chunks, including the target
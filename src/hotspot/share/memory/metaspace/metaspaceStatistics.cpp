@@ -89,6 +89,11 @@ void ChunkManagerStatistics::print_on(outputStream* st, size_t scale) const {
   st->cr();
   st->print("%19s: " UINTX_FORMAT_W(4) ", capacity=", "Total", totals.num());
   print_scaled_words(st, totals.cap(), scale);
+  // Free space in chunks too small to satisfy a medium chunk request,
+  // i.e. space that could not be handed out without further merging.
+  const size_t fragmented = _chunk_stats[SpecializedIndex].cap() + _chunk_stats[SmallIndex].cap();
+  st->print(", fragmented ");
+  print_percentage(st, totals.cap(), fragmented);
   st->cr();
 }
 
@@ -114,6 +114,11 @@ class arrayOopDesc : public oopDesc {
   static void set_length(HeapWord* mem, int length) {
     *(int*)(((char*)mem) + length_offset_in_bytes()) = length;
   }
+  // The GCs that scan large arrays in parallel chunks use the length field
+  // of the copy to claim the chunks, see PartialArrayTaskStepper.
+  int* length_addr() {
+    return (int*)(((intptr_t)this) + length_offset_in_bytes());
+  }
 
   // Should only be called with constants as argument
   // (will not constant fold otherwise)
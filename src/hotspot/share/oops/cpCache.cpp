@@ -24,6 +24,7 @@
 
 #include "precompiled.hpp"
 #include "classfile/resolutionErrors.hpp"
+#include "classfile/systemDictionaryShared.hpp"
 #include "interpreter/bytecodeStream.hpp"
 #include "interpreter/bytecodes.hpp"
 #include "interpreter/interpreter.hpp"
@@ -43,6 +44,7 @@
 #include "oops/oop.inline.hpp"
 #include "prims/methodHandles.hpp"
 #include "runtime/atomic.hpp"
+#include "runtime/fieldDescriptor.hpp"
 #include "runtime/handles.inline.hpp"
 #include "runtime/orderAccess.hpp"
 #include "utilities/macros.hpp"
@@ -75,6 +77,34 @@ void ConstantPoolCacheEntry::reinitialize(bool f2_used) {
   }
 }
 
+// A resolved instance field entry stays valid in the archive if the field
+// is declared by the pool holder or one of its super classes: those are
+// archived together and their field offsets are fixed at dump time.
+// Static field entries are never kept since resolving them initializes
+// the field holder. A super class field of a class from a custom loader is
+// only kept if the super class has the same loader, since resolving it
+// would otherwise check loader constraints that the archived entry skips.
+bool ConstantPoolCacheEntry::is_archivable_field(InstanceKlass* pool_holder) const {
+  if (!is_field_entry() || !is_resolved(Bytecodes::_getfield)) {
+    return false;
+  }
+  Klass* holder = f1_as_klass();
+  if (holder == NULL || !pool_holder->is_subclass_of(holder)) {
+    return false;
+  }
+  return holder == pool_holder ||
+         SystemDictionaryShared::is_builtin(pool_holder) ||
+         holder->class_loader_data() == pool_holder->class_loader_data();
+}
+
+void ConstantPoolCacheEntry::push_archived_field_holder(MetaspaceClosure* it) {
+  // Only archivable field entries are left resolved by remove_unshareable_info(),
+  // which is done before the archive is copied and relocated.
+  if (is_field_entry() && is_resolved(Bytecodes::_getfield)) {
+    it->push((Klass**)&_f1);
+  }
+}
+
 int ConstantPoolCacheEntry::make_flags(TosState state,
                                        int option_bits,
                                        int field_index_or_method_params) {
@@ -743,11 +773,40 @@ void ConstantPoolCache::walk_entries_for_initialization(bool check_only) {
       })
   } else {
     for (int i=0; i<length(); i++) {
-      entry_at(i)->reinitialize(f2_used[i]);
+      ConstantPoolCacheEntry* entry = entry_at(i);
+      if (!entry->is_archivable_field(ik)) {
+        entry->reinitialize(f2_used[i]);
+        preresolve_instance_field(entry);
+      }
     }
   }
 }
 
+// Resolve references to instance fields declared by the pool holder
+// itself, which always pass the access checks. Writes to final fields are
+// left unresolved so that they are still checked by the interpreter.
+void ConstantPoolCache::preresolve_instance_field(ConstantPoolCacheEntry* entry) {
+  ConstantPool* cp = constant_pool();
+  int cp_index = entry->constant_pool_index();
+  if (!cp->tag_at(cp_index).is_field()) {
+    return;
+  }
+  InstanceKlass* ik = cp->pool_holder();
+  if (cp->klass_name_at(cp->uncached_klass_ref_index_at(cp_index)) != ik->name()) {
+    return;
+  }
+  fieldDescriptor fd;
+  if (!ik->find_local_field(cp->uncached_name_ref_at(cp_index),
+                            cp->uncached_signature_ref_at(cp_index), &fd) ||
+      fd.is_static()) {
+    return;
+  }
+  Bytecodes::Code put_code = fd.is_final() ? (Bytecodes::Code)0 : Bytecodes::_putfield;
+  entry->set_field(Bytecodes::_getfield, put_code, ik, fd.index(), fd.offset(),
+                   as_TosState(fd.field_type()), fd.is_final(), fd.is_volatile(), ik);
+  log_trace(cds, resolve)("Pre-resolved field %s.%s", ik->external_name(), fd.name()->as_C_string());
+}
+
 void ConstantPoolCache::deallocate_contents(ClassLoaderData* data) {
   assert(!is_shared(), "shared caches are not deallocated");
   data->remove_handle(_resolved_references);
@@ -815,6 +874,11 @@ void ConstantPoolCache::metaspace_pointers_do(MetaspaceClosure* it) {
   log_trace(cds)("Iter(ConstantPoolCache): %p", this);
   it->push(&_constant_pool);
   it->push(&_reference_map);
+  if (DumpSharedSpaces) {
+    for (int i = 0; i < length(); i++) {
+      entry_at(i)->push_archived_field_holder(it);
+    }
+  }
 }
 
 // Printing
@@ -390,6 +390,8 @@ class ConstantPoolCacheEntry {
 
   void verify_just_initialized(bool f2_used);
   void reinitialize(bool f2_used);
+  bool is_archivable_field(InstanceKlass* pool_holder) const;
+  void push_archived_field_holder(MetaspaceClosure* it);
 };
 
 
@@ -456,6 +458,7 @@ class ConstantPoolCache: public MetaspaceObj {
   void verify_just_initialized();
  private:
   void walk_entries_for_initialization(bool check_only);
+  void preresolve_instance_field(ConstantPoolCacheEntry* entry);
   void set_length(int length)                    { _length = length; }
 
   static int header_size()                       { return sizeof(ConstantPoolCache) / wordSize; }
@@ -27,6 +27,7 @@
 #include "aot/aotLoader.hpp"
 #include "classfile/classFileParser.hpp"
 #include "classfile/classFileStream.hpp"
+#include "classfile/classListWriter.hpp"
 #include "classfile/classLoader.hpp"
 #include "classfile/classLoaderData.inline.hpp"
 #include "classfile/javaClasses.hpp"
@@ -561,7 +562,9 @@ void InstanceKlass::deallocate_contents(ClassLoaderData* loader_data) {
   set_transitive_interfaces(NULL);
   set_local_interfaces(NULL);
 
-  if (fields() != NULL && !fields()->is_shared()) {
+  if (fields() != NULL &&
+      fields() != Universe::the_empty_short_array() &&
+      !fields()->is_shared()) {
     MetadataFactory::free_array<jushort>(loader_data, fields());
   }
   set_fields(NULL, 0);
@@ -1362,7 +1365,7 @@ void InstanceKlass::mask_for(const methodHandle& method, int bci,
     MutexLocker x(OopMapCacheAlloc_lock);
     // Check if _oop_map_cache was allocated while we were waiting for this lock
     if ((oop_map_cache = _oop_map_cache) == NULL) {
-      oop_map_cache = new OopMapCache();
+      oop_map_cache = new OopMapCache(methods()->length());
       // Ensure _oop_map_cache is stable, since it is examined without a lock
       OrderAccess::release_store(&_oop_map_cache, oop_map_cache);
     }
@@ -2463,6 +2466,12 @@ void InstanceKlass::unload_class(InstanceKlass* ik) {
 
   Events::log_class_unloading(Thread::current(), ik);
 
+#if INCLUDE_CDS
+  if (DumpLoadedClassList != NULL) {
+    ClassListWriter::forget(ik);
+  }
+#endif
+
 #if INCLUDE_JFR
   assert(ik != NULL, "invariant");
   EventClassUnload event;
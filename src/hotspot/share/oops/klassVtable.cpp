@@ -1333,30 +1333,42 @@ class InterfaceVisiterClosure : public StackObj {
   virtual void doit(InstanceKlass* intf, int method_count) = 0;
 };
 
+// Number of methods of an interface that need an itable index
+static int itable_method_count(InstanceKlass* intf) {
+  int method_count = 0;
+  Array<Method*>* methods = intf->methods();
+  for (int i = methods->length(); --i >= 0; ) {
+    if (interface_method_needs_itable_index(methods->at(i))) {
+      method_count++;
+    }
+  }
+  return method_count;
+}
+
 // Visit all interfaces with at least one itable method
+// The itable stubs and InstanceKlass::method_at_itable() scan the offset table
+// linearly, so interfaces that declare itable methods are visited first. Interfaces
+// without methods only take part in the receiver type check and go at the end.
 void visit_all_interfaces(Array<InstanceKlass*>* transitive_intf, InterfaceVisiterClosure *blk) {
   // Handle array argument
-  for(int i = 0; i < transitive_intf->length(); i++) {
-    InstanceKlass* intf = transitive_intf->at(i);
-    assert(intf->is_interface(), "sanity check");
-
-    // Find no. of itable methods
-    int method_count = 0;
-    // method_count = klassItable::method_count_for_interface(intf);
-    Array<Method*>* methods = intf->methods();
-    if (methods->length() > 0) {
-      for (int i = methods->length(); --i >= 0; ) {
-        if (interface_method_needs_itable_index(methods->at(i))) {
-          method_count++;
-        }
+  for (int pass = 0; pass < 2; pass++) {
+    bool with_methods = (pass == 0);
+    for(int i = 0; i < transitive_intf->length(); i++) {
+      InstanceKlass* intf = transitive_intf->at(i);
+      assert(intf->is_interface(), "sanity check");
+
+      // Find no. of itable methods
+      int method_count = itable_method_count(intf);
+      if ((method_count > 0) != with_methods) {
+        continue;
       }
-    }
 
-    // Visit all interfaces which either have any methods or can participate in receiver type check.
-    // We do not bother to count methods in transitive interfaces, although that would allow us to skip
-    // this step in the rare case of a zero-method interface extending another zero-method interface.
-    if (method_count > 0 || intf->transitive_interfaces()->length() > 0) {
-      blk->doit(intf, method_count);
+      // Visit all interfaces which either have any methods or can participate in receiver type check.
+      // We do not bother to count methods in transitive interfaces, although that would allow us to skip
+      // this step in the rare case of a zero-method interface extending another zero-method interface.
+      if (method_count > 0 || intf->transitive_interfaces()->length() > 0) {
+        blk->doit(intf, method_count);
+      }
     }
   }
 }
@@ -1598,8 +1598,10 @@ void PhaseBlockLayout::merge_traces(bool fall_thru_only) {
       }
     } else if (e->state() == CFGEdge::open) {
       // Append traces, even without a fall-thru connection.
-      // But leave root entry at the beginning of the block list.
-      if (targ_trace != trace(_cfg.get_root_block())) {
+      // But leave root entry at the beginning of the block list,
+      // and keep cold traces apart so that they are sunk to the end.
+      if (targ_trace != trace(_cfg.get_root_block()) &&
+          !(BlockLayoutSplitColdCode && is_cold(targ_trace) && !is_cold(src_trace))) {
         e->set_state(CFGEdge::connected);
         src_trace->append(targ_trace);
         union_traces(src_trace, targ_trace);
@@ -1631,6 +1633,30 @@ void PhaseBlockLayout::reorder_traces(int count) {
   // Sort the new trace list by frequency
   qsort(new_traces + 1, new_count - 1, sizeof(new_traces[0]), trace_frequency_order);
 
+  if (BlockLayoutSplitColdCode) {
+    // Move the cold traces after all other traces but before the
+    // connector trace, keeping the frequency order within each group.
+    // The hot part of the method is then contiguous in the code.
+    Trace** cold_traces = NEW_ARENA_ARRAY(area, Trace *, new_count);
+    int hot_count = 1;
+    int cold_count = 0;
+    int end = new_count;
+    if (new_traces[end - 1]->first_block()->is_connector()) {
+      end--;
+    }
+    for (int i = 1; i < end; i++) {
+      Trace *tr = new_traces[i];
+      if (is_cold(tr)) {
+        cold_traces[cold_count++] = tr;
+      } else {
+        new_traces[hot_count++] = tr;
+      }
+    }
+    for (int i = 0; i < cold_count; i++) {
+      new_traces[hot_count + i] = cold_traces[i];
+    }
+  }
+
   // Patch up the successor blocks
   _cfg.clear_blocks();
   for (int i = 0; i < new_count; i++) {
@@ -1641,6 +1667,15 @@ void PhaseBlockLayout::reorder_traces(int count) {
   }
 }
 
+bool PhaseBlockLayout::is_cold(Trace* tr) {
+  for (Block *b = tr->first_block(); b != NULL; b = next[b->_pre_order]) {
+    if (b->is_connector() || !_cfg.is_uncommon(b)) {
+      return false;
+    }
+  }
+  return true;
+}
+
 // Order basic blocks based on frequency
 PhaseBlockLayout::PhaseBlockLayout(PhaseCFG &cfg)
 : Phase(BlockLayout)
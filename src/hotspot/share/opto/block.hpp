@@ -885,6 +885,9 @@ class PhaseBlockLayout : public Phase {
   void merge_traces(bool loose_connections);
   void reorder_traces(int count);
   void union_traces(Trace* from, Trace* to);
+
+  // True if all blocks of the trace are uncommon
+  bool is_cold(Trace* tr);
 };
 
 #endif // SHARE_OPTO_BLOCK_HPP
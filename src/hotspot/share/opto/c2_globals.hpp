@@ -339,6 +339,10 @@
   product(bool, SuperWordReductions, true,                                  \
           "Enable reductions support in superword.")                        \
                                                                             \
+  diagnostic(bool, SuperWordReductionsOutOfLoop, false,                     \
+          "Accumulate integral vector reductions lane-wise in the loop "    \
+          "and reduce the accumulator once after the loop")                 \
+                                                                            \
   product(bool, UseCMoveUnconditionally, false,                             \
           "Use CMove (scalar and vector) ignoring profitability test.")     \
                                                                             \
@@ -416,6 +420,11 @@
           "Set level of loop optimization for tier 1 compiles")             \
           range(5, 43)                                                      \
                                                                             \
+  product(intx, C2CompileTimeBudget, 0,                                     \
+          "Compilation time in milliseconds after which C2 uses a cheaper " \
+          "pipeline for the remaining phases (0 means no budget)")          \
+          range(0, max_jint)                                                \
+                                                                            \
   /* controls for heat-based inlining */                                    \
                                                                             \
   develop(intx, NodeCountInliningCutoff, 18000,                             \
@@ -542,6 +551,10 @@
           "Array size (number of elements) limit for scalar replacement")   \
           range(0, max_jint)                                                \
                                                                             \
+  diagnostic(bool, ReduceAllocationMerges, false,                           \
+          "Split field loads through Phis that merge only new objects "     \
+          "so that the merged allocations can be scalar replaced")          \
+                                                                            \
   product(bool, OptimizePtrCompare, true,                                   \
           "Use escape analysis to optimize pointers compare")               \
                                                                             \
@@ -583,6 +596,10 @@
   product(bool, BlockLayoutRotateLoops, true,                               \
           "Allow back branches to be fall throughs in the block layout")    \
                                                                             \
+  diagnostic(bool, BlockLayoutSplitColdCode, false,                         \
+          "Emit traces of uncommon blocks after all other code of the "     \
+          "method in the block layout")                                     \
+                                                                            \
   diagnostic(bool, InlineReflectionGetCallerClass, true,                    \
           "inline sun.reflect.Reflection.getCallerClass(), known to be "    \
           "part of base library DLL")                                       \
@@ -755,6 +772,13 @@
           "Loop with fewer iterations are not strip mined")                 \
           range(0, max_juint)                                               \
                                                                             \
+  experimental(uintx, LoopStripMiningTargetCost, 0,                         \
+          "If non-zero, choose the number of iterations of each strip "     \
+          "mined loop so that its body size (in nodes) times the number "   \
+          "of iterations between safepoint polls is about this value, "     \
+          "instead of using LoopStripMiningIter")                           \
+          range(0, max_juint)                                               \
+                                                                            \
   product(bool, UseProfiledLoopPredicate, true,                             \
           "move predicates out of loops based on profiling data")           \
 
@@ -466,6 +466,11 @@ bool C2Compiler::is_intrinsic_supported(const methodHandle& method, bool is_virt
   case vmIntrinsics::_dlog:
   case vmIntrinsics::_dlog10:
   case vmIntrinsics::_dpow:
+  case vmIntrinsics::_dsin_strict:
+  case vmIntrinsics::_dcos_strict:
+  case vmIntrinsics::_dtan_strict:
+  case vmIntrinsics::_dlog_strict:
+  case vmIntrinsics::_dlog10_strict:
   case vmIntrinsics::_min:
   case vmIntrinsics::_max:
   case vmIntrinsics::_arraycopy:
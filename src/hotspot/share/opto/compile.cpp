@@ -1124,6 +1124,8 @@ void Compile::Init(int aliaslevel) {
 
   set_do_freq_based_layout(_directive->BlockLayoutByFrequencyOption);
   _loop_opts_cnt = LoopOptsCount;
+  _start_time = os::javaTimeNanos();
+  _over_time_budget = false;
   set_do_inlining(Inline);
   set_max_inline_size(MaxInlineSize);
   set_freq_inline_size(FreqInlineSize);
@@ -2154,10 +2156,31 @@ void Compile::inline_incrementally(PhaseIterGVN& igvn) {
 }
 
 
+//------------------------------check_time_budget------------------------------
+// Called between phases.  Returns true, and switches the rest of the
+// compilation to the cheaper pipeline, if C2CompileTimeBudget is exceeded.
+bool Compile::check_time_budget(const char* phase) {
+  if (C2CompileTimeBudget == 0 || _over_time_budget) {
+    return _over_time_budget;
+  }
+  jlong elapsed_ms = (os::javaTimeNanos() - _start_time) / NANOSECS_PER_MILLISEC;
+  if (elapsed_ms < C2CompileTimeBudget) {
+    return false;
+  }
+  _over_time_budget = true;
+  _loop_opts_cnt = MIN2(_loop_opts_cnt, 1);
+  if (log() != NULL) {
+    log()->elem("time_budget_exceeded phase='%s' elapsed_ms='" JLONG_FORMAT "' budget_ms='" INTX_FORMAT "'",
+                phase, elapsed_ms, C2CompileTimeBudget);
+  }
+  return true;
+}
+
 bool Compile::optimize_loops(PhaseIterGVN& igvn, LoopOptsMode mode) {
   if(_loop_opts_cnt > 0) {
     debug_only( int cnt = 0; );
     while(major_progress() && (_loop_opts_cnt > 0)) {
+      check_time_budget("idealLoop");
       TracePhase tp("idealLoop", &timers[_t_idealLoop]);
       assert( cnt++ < 40, "infinite cycle in loop optimization" );
       PhaseIdealLoop::optimize(igvn, mode);
@@ -2277,6 +2300,8 @@ void Compile::Optimize() {
     igvn.optimize();
   }
 
+  check_time_budget("escapeAnalysis");
+
   // Perform escape analysis
   if (_do_escape_analysis && ConnectionGraph::has_candidates(this)) {
     if (has_loops()) {
@@ -2312,6 +2337,8 @@ void Compile::Optimize() {
   // Loop transforms on the ideal graph.  Range Check Elimination,
   // peeling, unrolling, etc.
 
+  check_time_budget("idealLoop");
+
   // Set loop opts counter
   if((_loop_opts_cnt > 0) && (has_loops() || has_split_ifs())) {
     {
@@ -2493,6 +2520,8 @@ void Compile::Code_Gen() {
     debug_only( cfg.verify(); )
   }
 
+  check_time_budget("regalloc");
+
   PhaseChaitin regalloc(unique(), cfg, matcher, false);
   _regalloc = &regalloc;
   {
@@ -3887,7 +3916,7 @@ void Compile::record_failure(const char* reason) {
 
 Compile::TracePhase::TracePhase(const char* name, elapsedTimer* accumulator)
   : TraceTime(name, accumulator, CITime, CITimeVerbose),
-    _phase_name(name), _dolog(CITimeVerbose)
+    _phase_name(name), _dolog(CITimeVerbose || C2CompileTimeBudget > 0)
 {
   if (_dolog) {
     C = Compile::current();
@@ -416,6 +416,8 @@ class Compile : public Phase {
   bool                  _has_method_handle_invokes; // True if this method has MethodHandle invokes.
   RTMState              _rtm_state;             // State of Restricted Transactional Memory usage
   int                   _loop_opts_cnt;         // loop opts round
+  jlong                 _start_time;            // os::javaTimeNanos() at start of compilation
+  bool                  _over_time_budget;      // C2CompileTimeBudget exceeded
 
   // Compilation environment.
   Arena                 _comp_arena;            // Arena with lifetime equivalent to Compile
@@ -729,6 +731,12 @@ class Compile : public Phase {
   bool              has_irreducible_loop() const { return _has_irreducible_loop; }
   void          set_has_irreducible_loop(bool z) { _has_irreducible_loop = z; }
 
+  // Compile-time budget (C2CompileTimeBudget).  Once it is exceeded the
+  // remaining phases use a cheaper pipeline: at most one more round of
+  // loop opts, no SuperWord and no conservative coalescing.
+  bool              over_time_budget() const { return _over_time_budget; }
+  bool              check_time_budget(const char* phase);
+
   // JSR 292
   bool              has_method_handle_invokes() const { return _has_method_handle_invokes;     }
   void          set_has_method_handle_invokes(bool z) {        _has_method_handle_invokes = z; }
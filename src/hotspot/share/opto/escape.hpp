@@ -454,6 +454,21 @@ private:
   // Adjust scalar_replaceable state after Connection Graph is built.
   void adjust_scalar_replaceable_state(JavaObjectNode* jobj);
 
+  // Mark an object as not scalar replaceable. With PrintEliminateAllocations
+  // the first reason found for each allocation is printed, which shows
+  // where the flow-insensitive analysis gives up on an object.
+  void set_not_scalar_replaceable(PointsToNode* ptn NOT_PRODUCT(COMMA const char* reason)) const {
+#ifndef PRODUCT
+    if (PrintEliminateAllocations && ptn->scalar_replaceable()) {
+      trace_not_scalar_replaceable(ptn, reason);
+    }
+#endif
+    ptn->set_scalar_replaceable(false);
+  }
+#ifndef PRODUCT
+  void trace_not_scalar_replaceable(PointsToNode* ptn, const char* reason) const;
+#endif
+
   // Optimize ideal graph.
   void optimize_ideal_graph(GrowableArray<Node*>& ptr_cmp_worklist,
                             GrowableArray<Node*>& storestore_worklist);
@@ -538,7 +538,12 @@ bool LibraryCallKit::try_to_inline(int predicate) {
   case vmIntrinsics::_dexp:
   case vmIntrinsics::_dlog:
   case vmIntrinsics::_dlog10:
-  case vmIntrinsics::_dpow:                     return inline_math_native(intrinsic_id());
+  case vmIntrinsics::_dpow:
+  case vmIntrinsics::_dsin_strict:
+  case vmIntrinsics::_dcos_strict:
+  case vmIntrinsics::_dtan_strict:
+  case vmIntrinsics::_dlog_strict:
+  case vmIntrinsics::_dlog10_strict:            return inline_math_native(intrinsic_id());
 
   case vmIntrinsics::_min:
   case vmIntrinsics::_max:                      return inline_min_max(intrinsic_id());
@@ -1875,6 +1880,20 @@ bool LibraryCallKit::inline_math_native(vmIntrinsics::ID id) {
       runtime_math(OptoRuntime::Math_DD_D_Type(), StubRoutines::dpow(),  "dpow") :
       runtime_math(OptoRuntime::Math_DD_D_Type(), FN_PTR(SharedRuntime::dpow),  "POW");
   }
+
+    // StrictMath natives: call the fdlibm copies in SharedRuntime directly
+    // instead of going through JNI. Never use the StubRoutines versions,
+    // they are not bit-for-bit identical to fdlibm.
+  case vmIntrinsics::_dsin_strict:
+    return runtime_math(OptoRuntime::Math_D_D_Type(), FN_PTR(SharedRuntime::dsin),   "SIN");
+  case vmIntrinsics::_dcos_strict:
+    return runtime_math(OptoRuntime::Math_D_D_Type(), FN_PTR(SharedRuntime::dcos),   "COS");
+  case vmIntrinsics::_dtan_strict:
+    return runtime_math(OptoRuntime::Math_D_D_Type(), FN_PTR(SharedRuntime::dtan),   "TAN");
+  case vmIntrinsics::_dlog_strict:
+    return runtime_math(OptoRuntime::Math_D_D_Type(), FN_PTR(SharedRuntime::dlog),   "LOG");
+  case vmIntrinsics::_dlog10_strict:
+    return runtime_math(OptoRuntime::Math_D_D_Type(), FN_PTR(SharedRuntime::dlog10), "LOG10");
 #undef FN_PTR
 
    // These intrinsics are not yet correctly implemented
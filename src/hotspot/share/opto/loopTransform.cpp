@@ -2276,6 +2276,9 @@ bool PhaseIdealLoop::is_scaled_iv(Node* exp, Node* iv, int* p_scale) {
 
 //-----------------------------is_scaled_iv_plus_offset------------------------------
 // Return true if exp is a simple induction variable expression: k1*iv + (invar + k2)
+// or such an expression scaled by a constant, (k1*iv + invar) * k3. The int
+// expression in the loop and k1*k3*iv + invar*k3 agree modulo 2^32, and the
+// range check predicates evaluate the latter without wrapping (see rc_predicate()).
 bool PhaseIdealLoop::is_scaled_iv_plus_offset(Node* exp, Node* iv, int* p_scale, Node** p_offset, int depth) {
   if (is_scaled_iv(exp, iv, p_scale)) {
     if (p_offset != NULL) {
@@ -2332,6 +2335,54 @@ bool PhaseIdealLoop::is_scaled_iv_plus_offset(Node* exp, Node* iv, int* p_scale,
       }
       return true;
     }
+    if (exp->in(2)->is_Con()) {
+      Node* offset2 = NULL;
+      if (depth < 2 &&
+          is_scaled_iv_plus_offset(exp->in(1), iv, p_scale,
+                                   p_offset != NULL ? &offset2 : NULL, depth+1)) {
+        if (p_offset != NULL) {
+          Node *ctrl_off2 = get_ctrl(offset2);
+          Node* offset = new SubINode(offset2, exp->in(2));
+          register_new_node(offset, ctrl_off2);
+          *p_offset = offset;
+        }
+        return true;
+      }
+    }
+  } else if (opc == Op_MulI || opc == Op_LShiftI) {
+    if (depth < 2 && exp->in(2)->is_Con()) {
+      jint con = exp->in(2)->get_int();
+      jlong factor;
+      if (opc == Op_MulI) {
+        factor = con;
+      } else {
+        if (con < 0 || con >= BitsPerInt - 1) {
+          return false;
+        }
+        factor = (jlong)1 << con;
+      }
+      int scale2 = 0;
+      Node* offset2 = NULL;
+      if (factor != 0 &&
+          is_scaled_iv_plus_offset(exp->in(1), iv, &scale2,
+                                   p_offset != NULL ? &offset2 : NULL, depth+1)) {
+        jlong scale = (jlong)scale2 * factor;
+        if (scale != (jlong)(jint)scale) {
+          return false; // scale does not fit in an int
+        }
+        if (p_scale != NULL) {
+          *p_scale = (int)scale;
+        }
+        if (p_offset != NULL) {
+          Node *ctrl_off2 = get_ctrl(offset2);
+          Node* offset = (opc == Op_MulI) ? (Node*)new MulINode(offset2, exp->in(2))
+                                          : (Node*)new LShiftINode(offset2, exp->in(2));
+          register_new_node(offset, ctrl_off2);
+          *p_offset = offset;
+        }
+        return true;
+      }
+    }
   }
   return false;
 }
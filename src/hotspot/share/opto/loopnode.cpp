@@ -1368,7 +1368,7 @@ void OuterStripMinedLoopNode::adjust_strip_mined_loop(PhaseIterGVN* igvn) {
   CountedLoopEndNode* inner_cle = inner_cl->loopexit();
 
   int stride = inner_cl->stride_con();
-  jlong scaled_iters_long = ((jlong)LoopStripMiningIter) * ABS(stride);
+  jlong scaled_iters_long = ((jlong)inner_cl->strip_mining_iter()) * ABS(stride);
   int scaled_iters = (int)scaled_iters_long;
   int short_scaled_iters = LoopStripMiningIterShortLoop* ABS(stride);
   const TypeInt* inner_iv_t = igvn->type(inner_iv_phi)->is_int();
@@ -3030,7 +3030,7 @@ void PhaseIdealLoop::build_and_optimize(LoopOptsMode mode) {
   }
 
   // Convert scalar to superword operations at the end of all loop opts.
-  if (UseSuperWord && C->has_loops() && !C->major_progress()) {
+  if (UseSuperWord && C->has_loops() && !C->major_progress() && !C->over_time_budget()) {
     // SuperWord transform
     SuperWord sw(this);
     for (LoopTreeIterator iter(_ltree_root); !iter.done(); iter.next()) {
@@ -3061,11 +3061,36 @@ void PhaseIdealLoop::build_and_optimize(LoopOptsMode mode) {
           }
         } else if (cl->is_main_loop()) {
           sw.transform_loop(lpt, true);
+          if (cl->is_vectorized_loop() && cl->is_reduction_loop()) {
+            move_unordered_reduction_out_of_loop(lpt);
+          }
         }
       }
     }
   }
 
+  // Size the strip mined loops from their final body size.
+  if (LoopStripMiningTargetCost > 0 && LoopStripMiningIter > 1 && C->has_loops() && !C->major_progress()) {
+    for (LoopTreeIterator iter(_ltree_root); !iter.done(); iter.next()) {
+      IdealLoopTree* lpt = iter.current();
+      if (lpt->is_counted() && lpt->_head->as_CountedLoop()->is_strip_mined()) {
+        CountedLoopNode* cl = lpt->_head->as_CountedLoop();
+        uint body_size = MAX2(lpt->_body.size(), 1u);
+        uint strip_iter = (uint)MAX2(LoopStripMiningTargetCost / body_size, (uintx)1);
+        cl->set_strip_mining_iter(strip_iter);
+        if (C->log() != NULL) {
+          C->log()->elem("strip_mining loop='%d' body_size='%u' iter='%u'", cl->_idx, body_size, strip_iter);
+        }
+#ifndef PRODUCT
+        if (TraceLoopOpts) {
+          tty->print("StripMiningIter %u body %u ", strip_iter, body_size);
+          lpt->dump_head();
+        }
+#endif
+      }
+    }
+  }
+
   // Cleanup any modified bits
   _igvn.optimize();
 
@@ -214,11 +214,16 @@ class CountedLoopNode : public LoopNode {
   // vector mapped unroll factor here
   int _slp_maximum_unroll_factor;
 
+  // Iterations of the strip mined inner loop between safepoint polls
+  // chosen from the body size (see LoopStripMiningTargetCost), or 0 to
+  // use LoopStripMiningIter.
+  uint _strip_mining_iter;
+
 public:
   CountedLoopNode( Node *entry, Node *backedge )
     : LoopNode(entry, backedge), _main_idx(0), _trip_count(max_juint),
       _unrolled_count_log2(0), _node_count_before_unroll(0),
-      _slp_maximum_unroll_factor(0) {
+      _slp_maximum_unroll_factor(0), _strip_mining_iter(0) {
     init_class_id(Class_CountedLoop);
     // Initialize _trip_count to the largest possible value.
     // Will be reset (lower) if the loop's trip count is known.
@@ -301,6 +306,8 @@ public:
   int  node_count_before_unroll()            { return _node_count_before_unroll; }
   void set_slp_max_unroll(int unroll_factor) { _slp_maximum_unroll_factor = unroll_factor; }
   int  slp_max_unroll() const                { return _slp_maximum_unroll_factor; }
+  void set_strip_mining_iter(uint iter)      { _strip_mining_iter = iter; }
+  uint strip_mining_iter() const             { return _strip_mining_iter != 0 ? _strip_mining_iter : (uint)LoopStripMiningIter; }
 
   virtual LoopNode* skip_strip_mined(int expect_skeleton = 1);
   OuterStripMinedLoopNode* outer_loop() const;
@@ -1206,6 +1213,10 @@ public:
   // Partially peel loop up through last_peel node.
   bool partial_peel( IdealLoopTree *loop, Node_List &old_new );
 
+  // Accumulate vectorized integral reductions in a vector Phi and reduce
+  // across lanes only once after the loop.
+  void move_unordered_reduction_out_of_loop(IdealLoopTree* loop);
+
   // Create a scheduled list of nodes control dependent on ctrl set.
   void scheduled_nodelist( IdealLoopTree *loop, VectorSet& ctrl, Node_List &sched );
   // Has a use in the vector set
@@ -1265,6 +1276,7 @@ public:
 
   // Attempt to use a conditional move instead of a phi/branch
   Node *conditional_move( Node *n );
+  bool vector_cmove_candidate(IfNode* iff, Node* region, IdealLoopTree* loop);
 
   // Reorganize offset computations to lower register pressure.
   // Mostly prevent loop-fallout uses of the pre-incremented trip counter
@@ -40,6 +40,7 @@
 #include "opto/opaquenode.hpp"
 #include "opto/rootnode.hpp"
 #include "opto/subnode.hpp"
+#include "opto/vectornode.hpp"
 #include "utilities/macros.hpp"
 #if INCLUDE_ZGC
 #include "gc/z/c2/zBarrierSetC2.hpp"
@@ -547,6 +548,41 @@ Node *PhaseIdealLoop::convert_add_to_muladd(Node* n) {
   return nn;
 }
 
+//------------------------------vector_cmove_candidate-------------------------
+// Return true if the diamond headed by 'iff' and merged at 'region' selects
+// between the two operands of a float or double compare and sits in the
+// body of an innermost counted loop, so that SuperWord can turn the CMOV
+// into a vector blend (see CMoveKit in superword.cpp).
+bool PhaseIdealLoop::vector_cmove_candidate(IfNode* iff, Node* region, IdealLoopTree* loop) {
+  if (!UseSuperWord || !UseVectorCmov) return false;
+  if (loop == _ltree_root || loop->_child != NULL) return false;
+  if (!loop->_head->is_CountedLoop()) return false;
+
+  Node* bol = iff->in(1);
+  if (!bol->is_Bool()) return false;
+  Node* cmp = bol->in(1);
+  int cmp_op = cmp->Opcode();
+  if (cmp_op != Op_CmpF && cmp_op != Op_CmpD) return false;
+  int cmovev_op = (cmp_op == Op_CmpF) ? Op_CMoveVF : Op_CMoveVD;
+  if (!Matcher::match_rule_supported(cmovev_op)) return false;
+  BasicType bt = (cmp_op == Op_CmpF) ? T_FLOAT : T_DOUBLE;
+
+  PhiNode* phi = NULL;
+  for (DUIterator_Fast imax, i = region->fast_outs(imax); i < imax; i++) {
+    Node* out = region->fast_out(i);
+    if (!out->is_Phi()) continue;
+    if (phi != NULL) return false; // Only a single blended value
+    phi = out->as_Phi();
+  }
+  if (phi == NULL || phi->type()->basic_type() != bt) return false;
+
+  // The vector blend compares its own inputs.
+  Node* in1 = phi->in(1);
+  Node* in2 = phi->in(2);
+  return (in1 == cmp->in(1) && in2 == cmp->in(2)) ||
+         (in1 == cmp->in(2) && in2 == cmp->in(1));
+}
+
 //------------------------------conditional_move-------------------------------
 // Attempt to replace a Phi with a conditional move.  We have some pretty
 // strict profitability requirements.  All Phis at the merge point must
@@ -578,6 +614,12 @@ Node *PhaseIdealLoop::conditional_move( Node *region ) {
   // Always convert to CMOVE if all results are used only outside this loop.
   bool used_inside_loop = (r_loop == _ltree_root);
 
+  // A float or double diamond in the body of an innermost counted loop
+  // that only selects between the two compared values may be vectorized
+  // by SuperWord into a CMoveVF/CMoveVD blend. Convert it regardless of
+  // the branch probability and the cost of a scalar float CMOV.
+  bool vector_cmove = vector_cmove_candidate(iff, region, r_loop);
+
   // Check profitability
   int cost = 0;
   int phis = 0;
@@ -590,7 +632,7 @@ Node *PhaseIdealLoop::conditional_move( Node *region ) {
     switch (bt) {
     case T_DOUBLE:
     case T_FLOAT:
-      if (C->use_cmove()) {
+      if (C->use_cmove() || vector_cmove) {
         continue; //TODO: maybe we want to add some cost
       }
       cost += Matcher::float_cmove_cost(); // Could be very expensive
@@ -673,7 +715,7 @@ Node *PhaseIdealLoop::conditional_move( Node *region ) {
   }
   // Check for highly predictable branch.  No point in CMOV'ing if
   // we are going to predict accurately all the time.
-  if (C->use_cmove() && (cmp_op == Op_CmpF || cmp_op == Op_CmpD)) {
+  if ((C->use_cmove() || vector_cmove) && (cmp_op == Op_CmpF || cmp_op == Op_CmpD)) {
     //keep going
   } else if (iff->_prob < infrequent_prob ||
       iff->_prob > (1.0f - infrequent_prob))
@@ -3486,3 +3528,149 @@ void PhaseIdealLoop::reorg_offsets(IdealLoopTree *loop) {
   }
 
 }
+
+//------------------------------move_unordered_reduction_out_of_loop-----------
+// After SuperWord a reduction loop folds every vector across its lanes on
+// every iteration:
+//
+//   phi = Phi(loop, init, rN)
+//   r1  = AddReductionVI(phi, v1)
+//   ...
+//   rN  = AddReductionVI(rN-1, vN)
+//
+// Integer addition and multiplication are associative, so the vectors can
+// instead be accumulated lane-wise in a vector Phi that starts from the
+// identity element, with a single reduction of the accumulator after the
+// loop:
+//
+//   vphi = Phi(loop, Replicate(identity), aN)
+//   a1   = AddVI(vphi, v1)
+//   ...
+//   aN   = AddVI(aN-1, vN)
+//   r    = AddReductionVI(init, aN)    // after the loop
+//
+// Floating point reductions must keep their strict order and are left alone.
+// Only done with -XX:+SuperWordReductionsOutOfLoop.
+void PhaseIdealLoop::move_unordered_reduction_out_of_loop(IdealLoopTree* loop) {
+  assert(loop->is_counted() && loop->_child == NULL, "sanity");
+  CountedLoopNode* cl = loop->_head->as_CountedLoop();
+  if (!SuperWordReductions || !SuperWordReductionsOutOfLoop ||
+      cl->loopexit_or_null() == NULL) {
+    return;
+  }
+  Node* exit_ctrl = cl->loopexit()->proj_out_or_null(false /* exit */);
+  if (exit_ctrl == NULL) {
+    return;
+  }
+
+  // Collect the Phis first: the transformation adds Phis to the loop head.
+  Node_List phis;
+  for (DUIterator_Fast imax, i = cl->fast_outs(imax); i < imax; i++) {
+    Node* phi = cl->fast_out(i);
+    if (phi->is_Phi() && phi->outcnt() == 1 && phi->req() == 3) {
+      phis.push(phi);
+    }
+  }
+
+  for (uint i = 0; i < phis.size(); i++) {
+    Node* phi = phis.at(i);
+    Node* first = phi->unique_out();
+    int ropc = first->Opcode();
+    int sopc;
+    BasicType bt;
+    switch (ropc) {
+    case Op_AddReductionVI: sopc = Op_AddI; bt = T_INT;  break;
+    case Op_AddReductionVL: sopc = Op_AddL; bt = T_LONG; break;
+    case Op_MulReductionVI: sopc = Op_MulI; bt = T_INT;  break;
+    case Op_MulReductionVL: sopc = Op_MulL; bt = T_LONG; break;
+    default: continue;
+    }
+    if (first->in(1) != phi) {
+      continue;
+    }
+    const TypeVect* vt = first->in(2)->bottom_type()->isa_vect();
+    if (vt == NULL || vt->element_basic_type() != bt ||
+        !VectorNode::implemented(sopc, vt->length(), bt)) {
+      continue;
+    }
+
+    // Walk the chain of reductions up to the one feeding the backedge.
+    // Every reduction but the last must only feed the next one, and the
+    // last one may only be used by the Phi and outside of the loop.
+    Node_List chain;
+    Node* last = first;
+    bool ok = true;
+    while (ok) {
+      if (get_loop(get_ctrl(last)) != loop ||
+          last->in(2)->bottom_type() != vt) {
+        ok = false;
+        break;
+      }
+      chain.push(last);
+      if (phi->in(LoopNode::LoopBackControl) == last) {
+        break;
+      }
+      if (last->outcnt() != 1) {
+        ok = false;
+        break;
+      }
+      Node* use = last->unique_out();
+      if (use->Opcode() != ropc || use->in(1) != last) {
+        ok = false;
+        break;
+      }
+      last = use;
+    }
+    if (!ok) {
+      continue;
+    }
+    for (DUIterator_Fast jmax, j = last->fast_outs(jmax); j < jmax && ok; j++) {
+      Node* use = last->fast_out(j);
+      if (use != phi && loop->is_member(get_loop(ctrl_or_self(use)))) {
+        ok = false;
+      }
+    }
+    if (!ok) {
+      continue;
+    }
+
+    // Identity element of the operation, replicated in all lanes.
+    Node* identity;
+    const Type* scalar_t;
+    if (bt == T_INT) {
+      identity = _igvn.intcon(sopc == Op_AddI ? 0 : 1);
+      scalar_t = TypeInt::INT;
+    } else {
+      identity = _igvn.longcon(sopc == Op_AddL ? 0 : 1);
+      scalar_t = TypeLong::LONG;
+    }
+    set_ctrl(identity, C->root());
+    Node* vinit = VectorNode::scalar2vector(identity, vt->length(), scalar_t);
+    register_new_node(vinit, cl->in(LoopNode::EntryControl));
+
+    Node* vphi = new PhiNode(cl, vt);
+    vphi->init_req(LoopNode::EntryControl, vinit);
+    register_new_node(vphi, cl);
+
+    Node* acc = vphi;
+    for (uint k = 0; k < chain.size(); k++) {
+      Node* red = chain.at(k);
+      acc = VectorNode::make(sopc, acc, red->in(2), vt->length(), bt);
+      register_new_node(acc, get_ctrl(red));
+    }
+    vphi->init_req(LoopNode::LoopBackControl, acc);
+
+    Node* init = phi->in(LoopNode::EntryControl);
+    Node* result = ReductionNode::make(sopc, NULL, init, acc, bt);
+    register_new_node(result, exit_ctrl);
+
+    // The scalar Phi and the in-loop reductions die with 'last'.
+    _igvn.replace_node(last, result);
+#ifndef PRODUCT
+    if (TraceLoopOpts) {
+      tty->print("MoveReductionOutOfLoop %s ", NodeClassNames[ropc]);
+      loop->dump_head();
+    }
+#endif
+  }
+}
@@ -1359,6 +1359,46 @@ static bool stable_phi(PhiNode* phi, PhaseGVN *phase) {
   }
   return true;
 }
+//------------------------------is_allocation_merge_load-----------------------
+// Loads from 'cond ? new A(x) : new A(y)' are split through the merging Phi
+// into loads from each allocation. Once every load is split the Phi dies
+// and the allocations can be scalar replaced.  Phis with other uses
+// (stores, calls, debug info at safepoints) are left alone since escape
+// analysis can not eliminate objects merged there.
+bool LoadNode::is_allocation_merge_load(PhaseGVN* phase) const {
+  if (!ReduceAllocationMerges || !EliminateAllocations) {
+    return false;
+  }
+  Node* address = in(MemNode::Address);
+  if (!address->is_AddP()) {
+    return false;
+  }
+  Node* base = address->in(AddPNode::Base);
+  if (!base->is_Phi() || base->in(0) == NULL ||
+      address->in(AddPNode::Address) != base ||
+      !address->in(AddPNode::Offset)->is_Con()) {
+    return false;
+  }
+  for (uint i = 1; i < base->req(); i++) {
+    Node* in = base->in(i);
+    if (in == NULL || in == base || AllocateNode::Ideal_allocation(in, phase) == NULL) {
+      return false;
+    }
+  }
+  for (DUIterator_Fast imax, i = base->fast_outs(imax); i < imax; i++) {
+    Node* adr = base->fast_out(i);
+    if (!adr->is_AddP() || adr->in(AddPNode::Address) != base) {
+      return false;
+    }
+    for (DUIterator_Fast jmax, j = adr->fast_outs(jmax); j < jmax; j++) {
+      if (!adr->fast_out(j)->is_Load()) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
 //------------------------------split_through_phi------------------------------
 // Split instance or boxed field load through Phi.
 Node *LoadNode::split_through_phi(PhaseGVN *phase) {
@@ -1368,7 +1408,8 @@ Node *LoadNode::split_through_phi(PhaseGVN *phase) {
 
   assert((t_oop != NULL) &&
          (t_oop->is_known_instance_field() ||
-          t_oop->is_ptr_to_boxed_value()), "invalide conditions");
+          t_oop->is_ptr_to_boxed_value() ||
+          is_allocation_merge_load(phase)), "invalide conditions");
 
   Compile* C = phase->C;
   intptr_t ignore = 0;
@@ -1377,9 +1418,11 @@ Node *LoadNode::split_through_phi(PhaseGVN *phase) {
   bool load_boxed_values = t_oop->is_ptr_to_boxed_value() && C->aggressive_unboxing() &&
                            (base != NULL) && (base == address->in(AddPNode::Base)) &&
                            phase->type(base)->higher_equal(TypePtr::NOTNULL);
+  bool load_merged_values = !t_oop->is_known_instance_field() && !load_boxed_values &&
+                            base_is_phi && is_allocation_merge_load(phase);
 
   if (!((mem->is_Phi() || base_is_phi) &&
-        (load_boxed_values || t_oop->is_known_instance_field()))) {
+        (load_boxed_values || load_merged_values || t_oop->is_known_instance_field()))) {
     return NULL; // memory is not Phi
   }
 
@@ -1457,8 +1500,8 @@ Node *LoadNode::split_through_phi(PhaseGVN *phase) {
   int this_index  = C->get_alias_index(t_oop);
   int this_offset = t_oop->offset();
   int this_iid    = t_oop->instance_id();
-  if (!t_oop->is_known_instance() && load_boxed_values) {
-    // Use _idx of address base for boxed values.
+  if (!t_oop->is_known_instance() && (load_boxed_values || load_merged_values)) {
+    // Use _idx of address base for boxed and merged values.
     this_iid = base->_idx;
   }
   PhaseIterGVN* igvn = phase->is_IterGVN();
@@ -1592,7 +1635,8 @@ Node *LoadNode::Ideal(PhaseGVN *phase, bool can_reshape) {
     const TypeOopPtr *t_oop = addr_t->isa_oopptr();
     if ((t_oop != NULL) &&
         (t_oop->is_known_instance_field() ||
-         t_oop->is_ptr_to_boxed_value())) {
+         t_oop->is_ptr_to_boxed_value() ||
+         is_allocation_merge_load(phase))) {
       PhaseIterGVN *igvn = phase->is_IterGVN();
       if (igvn != NULL && igvn->_worklist.member(opt_mem)) {
         // Delay this transformation until memory Phi is processed.
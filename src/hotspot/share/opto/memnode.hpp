@@ -227,6 +227,10 @@ public:
   // Split instance field load through Phi.
   Node* split_through_phi(PhaseGVN *phase);
 
+  // Return true if this load reads a field of a Phi which merges only
+  // newly allocated objects and which is used only by field loads.
+  bool is_allocation_merge_load(PhaseGVN* phase) const;
+
   // Recover original value from boxed values
   Node *eliminate_autobox(PhaseGVN *phase);
 
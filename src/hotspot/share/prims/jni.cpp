@@ -202,8 +202,12 @@ intptr_t jfieldIDWorkaround::encode_klass_hash(Klass* k, intptr_t offset) {
     Klass* field_klass = k;
     Klass* super_klass = field_klass->super();
     // With compressed oops the most super class with nonstatic fields would
-    // be the owner of fields embedded in the header.
-    while (InstanceKlass::cast(super_klass)->has_nonstatic_fields() &&
+    // be the owner of fields embedded in the header. A subclass field may
+    // also sit in the gap at the end of its super's fields, so stop at the
+    // class that declares the field.
+    fieldDescriptor fd;
+    while (!InstanceKlass::cast(field_klass)->find_local_field_from_offset(offset, false, &fd) &&
+           InstanceKlass::cast(super_klass)->has_nonstatic_fields() &&
            InstanceKlass::cast(super_klass)->contains_field_offset(offset)) {
       field_klass = super_klass;   // super contains the field also
       super_klass = field_klass->super();
@@ -3167,13 +3171,36 @@ static void unlock_gc_or_unpin_object(JavaThread* thread, jobject obj) {
   }
 }
 
+// Arrays the GC never moves, such as G1 humongous arrays, are accessed
+// without locking out the GC. An array cannot change between movable
+// and non-movable while it is reachable, so release makes the same choice.
+static oop lock_gc_or_pin_array(JavaThread* thread, jarray array) {
+  if (!Universe::heap()->supports_object_pinning()) {
+    const oop a = JNIHandles::resolve_non_null(array);
+    if (Universe::heap()->is_object_non_movable(a)) {
+      return a;
+    }
+  }
+  return lock_gc_or_pin_object(thread, array);
+}
+
+static void unlock_gc_or_unpin_array(JavaThread* thread, jarray array) {
+  if (!Universe::heap()->supports_object_pinning()) {
+    const oop a = JNIHandles::resolve_non_null(array);
+    if (Universe::heap()->is_object_non_movable(a)) {
+      return;
+    }
+  }
+  unlock_gc_or_unpin_object(thread, array);
+}
+
 JNI_ENTRY(void*, jni_GetPrimitiveArrayCritical(JNIEnv *env, jarray array, jboolean *isCopy))
   JNIWrapper("GetPrimitiveArrayCritical");
  HOTSPOT_JNI_GETPRIMITIVEARRAYCRITICAL_ENTRY(env, array, (uintptr_t *) isCopy);
   if (isCopy != NULL) {
     *isCopy = JNI_FALSE;
   }
-  oop a = lock_gc_or_pin_object(thread, array);
+  oop a = lock_gc_or_pin_array(thread, array);
   assert(a->is_array(), "just checking");
   BasicType type;
   if (a->is_objArray()) {
@@ -3190,7 +3217,7 @@ JNI_END
 JNI_ENTRY(void, jni_ReleasePrimitiveArrayCritical(JNIEnv *env, jarray array, void *carray, jint mode))
   JNIWrapper("ReleasePrimitiveArrayCritical");
   HOTSPOT_JNI_RELEASEPRIMITIVEARRAYCRITICAL_ENTRY(env, array, carray, mode);
-  unlock_gc_or_unpin_object(thread, array);
+  unlock_gc_or_unpin_array(thread, array);
 HOTSPOT_JNI_RELEASEPRIMITIVEARRAYCRITICAL_RETURN();
 JNI_END
 
@@ -1483,6 +1483,27 @@ void JvmtiExport::post_object_free(JvmtiEnv* env, jlong tag) {
   }
 }
 
+// posts the ObjectFree events that were deferred during a GC
+void JvmtiExport::post_object_free_events(JvmtiEnv* env, const GrowableArray<jlong>* tags) {
+  JavaThread* thread = JavaThread::current();
+  if (!env->is_enabled(JVMTI_EVENT_OBJECT_FREE)) {
+    return;
+  }
+
+  EVT_TRIG_TRACE(JVMTI_EVENT_OBJECT_FREE, ("[%s] Trg Object Free triggered for %d objects",
+                 JvmtiTrace::safe_get_thread_name(thread), tags->length()));
+  EVT_TRACE(JVMTI_EVENT_OBJECT_FREE, ("[%s] Evt Object Free sent",
+            JvmtiTrace::safe_get_thread_name(thread)));
+
+  JvmtiJavaThreadEventTransition jet(thread);
+  jvmtiEventObjectFree callback = env->callbacks()->ObjectFree;
+  if (callback != NULL) {
+    for (int i = 0; i < tags->length(); i++) {
+      (*callback)(env->jvmti_external(), tags->at(i));
+    }
+  }
+}
+
 void JvmtiExport::post_resource_exhausted(jint resource_exhausted_flags, const char* description) {
 
   JavaThread *thread  = JavaThread::current();
@@ -255,6 +255,31 @@ class JvmtiTagHashmap : public CHeapObj<mtInternal> {
     _resize_threshold = (int)(_load_factor * _size);
   }
 
+  // re-hash all entries in place - used after the GC has moved the
+  // tagged objects.
+  void rehash() {
+    JvmtiTagHashmapEntry* list = NULL;
+    for (int i=0; i<_size; i++) {
+      JvmtiTagHashmapEntry* entry = _table[i];
+      while (entry != NULL) {
+        JvmtiTagHashmapEntry* next = entry->next();
+        entry->set_next(list);
+        list = entry;
+        entry = next;
+      }
+      _table[i] = NULL;
+    }
+    while (list != NULL) {
+      JvmtiTagHashmapEntry* next = list->next();
+      oop key = list->object_peek();
+      assert(key != NULL, "jni weak reference cleared!!");
+      unsigned int h = hash(key);
+      list->set_next(_table[h]);
+      _table[h] = list;
+      list = next;
+    }
+  }
+
 
   // internal remove function - remove an entry at a given position in the
   // table.
@@ -442,8 +467,10 @@ void JvmtiTagHashmap::compute_next_trace_threshold() {
 JvmtiTagMap::JvmtiTagMap(JvmtiEnv* env) :
   _env(env),
   _lock(Mutex::nonleaf+2, "JvmtiTagMap._lock", false),
+  _needs_rehashing(false),
   _free_entries(NULL),
-  _free_entries_count(0)
+  _free_entries_count(0),
+  _freed_tags(NULL)
 {
   assert(JvmtiThreadState_lock->is_locked(), "sanity check");
   assert(((JvmtiEnvBase *)env)->tag_map() == NULL, "tag map already exists for environment");
@@ -484,6 +511,9 @@ JvmtiTagMap::~JvmtiTagMap() {
     entry = next;
   }
   _free_entries = NULL;
+
+  delete _freed_tags;
+  _freed_tags = NULL;
 }
 
 // create a hashmap entry
@@ -541,7 +571,20 @@ void JvmtiTagMap::entry_iterate(JvmtiTagHashmapEntryClosure* closure) {
 // returns true if the hashmaps are empty
 bool JvmtiTagMap::is_empty() {
   assert(SafepointSynchronize::is_at_safepoint() || is_locked(), "checking");
-  return hashmap()->entry_count() == 0;
+  return _hashmap->entry_count() == 0;
+}
+
+// the GC only updates the object references of the entries, so the
+// entries of moved objects are re-hashed before the hashmap is used again.
+// This is O(n) and runs with the tag map lock held, or in the safepoint
+// of a JVM TI heap walk when that is the next use.
+void JvmtiTagMap::check_hashmap() {
+  assert(SafepointSynchronize::is_at_safepoint() || is_locked(), "checking");
+  if (_needs_rehashing) {
+    log_debug(jvmti, objecttagging)("rehashing %d entries", _hashmap->entry_count());
+    _hashmap->rehash();
+    _needs_rehashing = false;
+  }
 }
 
 
@@ -735,7 +778,7 @@ void JvmtiTagMap::set_tag(jobject object, jlong tag) {
   oop o = JNIHandles::resolve_non_null(object);
 
   // see if the object is already tagged
-  JvmtiTagHashmap* hashmap = _hashmap;
+  JvmtiTagHashmap* hashmap = this->hashmap();
   JvmtiTagHashmapEntry* entry = hashmap->find(o);
 
   // if the object is not already tagged then we tag it
@@ -3321,11 +3364,55 @@ void JvmtiTagMap::weak_oops_do(BoolObjectClosure* is_alive, OopClosure* f) {
       JvmtiTagMap* tag_map = env->tag_map();
       if (tag_map != NULL && !tag_map->is_empty()) {
         tag_map->do_weak_oops(is_alive, f);
+        if (tag_map->_freed_tags != NULL && tag_map->_freed_tags->is_nonempty()) {
+          MonitorLockerEx ml(Service_lock, Mutex::_no_safepoint_check_flag);
+          _has_object_free_events = true;
+          ml.notify_all();
+        }
+      }
+    }
+  }
+}
+
+bool JvmtiTagMap::_has_object_free_events = false;
+
+bool JvmtiTagMap::has_object_free_events_and_reset() {
+  assert_lock_strong(Service_lock);
+  bool result = _has_object_free_events;
+  _has_object_free_events = false;
+  return result;
+}
+
+void JvmtiTagMap::flush_object_free_events() {
+  assert(Thread::current()->is_Java_thread(), "must be a JavaThread");
+  JvmtiEnvIterator it;
+  for (JvmtiEnv* env = it.first(); env != NULL; env = it.next(env)) {
+    GrowableArray<jlong>* tags = NULL;
+    {
+      // env_dispose deletes the tag map holding the JvmtiThreadState_lock
+      MutexLocker mu(JvmtiThreadState_lock);
+      JvmtiTagMap* tag_map = env->tag_map();
+      if (tag_map != NULL) {
+        tags = tag_map->take_freed_tags();
       }
     }
+    // post without the lock, the callbacks may call back into JVM TI
+    if (tags != NULL) {
+      JvmtiExport::post_object_free_events(env, tags);
+      delete tags;
+    }
   }
 }
 
+GrowableArray<jlong>* JvmtiTagMap::take_freed_tags() {
+  // the GC appends to _freed_tags at a safepoint, which cannot
+  // happen while we are in the VM holding the JvmtiThreadState_lock
+  assert_lock_strong(JvmtiThreadState_lock);
+  GrowableArray<jlong>* tags = _freed_tags;
+  _freed_tags = NULL;
+  return tags;
+}
+
 void JvmtiTagMap::do_weak_oops(BoolObjectClosure* is_alive, OopClosure* f) {
 
   // does this environment have the OBJECT_FREE event enabled
@@ -3335,7 +3422,10 @@ void JvmtiTagMap::do_weak_oops(BoolObjectClosure* is_alive, OopClosure* f) {
   int freed = 0;
   int moved = 0;
 
-  JvmtiTagHashmap* hashmap = this->hashmap();
+  // the GC still visits every entry, but entries of moved objects are
+  // no longer relinked here; the hashmap is re-hashed before its next
+  // use instead, see check_hashmap()
+  JvmtiTagHashmap* hashmap = _hashmap;
 
   // reenable sizing (if disabled)
   hashmap->set_resizing_enabled(true);
@@ -3350,8 +3440,6 @@ void JvmtiTagMap::do_weak_oops(BoolObjectClosure* is_alive, OopClosure* f) {
   JvmtiTagHashmapEntry** table = hashmap->table();
   int size = hashmap->size();
 
-  JvmtiTagHashmapEntry* delayed_add = NULL;
-
   for (int pos = 0; pos < size; ++pos) {
     JvmtiTagHashmapEntry* entry = table[pos];
     JvmtiTagHashmapEntry* prev = NULL;
@@ -3370,9 +3458,17 @@ void JvmtiTagMap::do_weak_oops(BoolObjectClosure* is_alive, OopClosure* f) {
         hashmap->remove(prev, pos, entry);
         destroy_entry(entry);
 
-        // post the event to the profiler
+        // post the event to the profiler, or keep it for the
+        // ServiceThread
         if (post_object_free) {
-          JvmtiExport::post_object_free(env(), tag);
+          if (JvmtiDeferObjectFreeEvents) {
+            if (_freed_tags == NULL) {
+              _freed_tags = new (ResourceObj::C_HEAP, mtInternal) GrowableArray<jlong>(16, true);
+            }
+            _freed_tags->append(tag);
+          } else {
+            JvmtiExport::post_object_free(env(), tag);
+          }
         }
 
         ++freed;
@@ -3380,42 +3476,21 @@ void JvmtiTagMap::do_weak_oops(BoolObjectClosure* is_alive, OopClosure* f) {
         f->do_oop(entry->object_addr());
         oop new_oop = entry->object_peek();
 
-        // if the object has moved then re-hash it and move its
-        // entry to its new location.
+        // if the object has moved to another bucket then the hashmap
+        // has to be re-hashed before its next use.
         unsigned int new_pos = JvmtiTagHashmap::hash(new_oop, size);
         if (new_pos != (unsigned int)pos) {
-          if (prev == NULL) {
-            table[pos] = next;
-          } else {
-            prev->set_next(next);
-          }
-          if (new_pos < (unsigned int)pos) {
-            entry->set_next(table[new_pos]);
-            table[new_pos] = entry;
-          } else {
-            // Delay adding this entry to it's new position as we'd end up
-            // hitting it again during this iteration.
-            entry->set_next(delayed_add);
-            delayed_add = entry;
-          }
           moved++;
-        } else {
-          // object didn't move
-          prev = entry;
         }
+        prev = entry;
       }
 
       entry = next;
     }
   }
 
-  // Re-add all the entries which were kept aside
-  while (delayed_add != NULL) {
-    JvmtiTagHashmapEntry* next = delayed_add->next();
-    unsigned int pos = JvmtiTagHashmap::hash(delayed_add->object_peek(), size);
-    delayed_add->set_next(table[pos]);
-    table[pos] = delayed_add;
-    delayed_add = next;
+  if (moved > 0) {
+    _needs_rehashing = true;
   }
 
   log_debug(jvmti, objecttagging)("(%d->%d, %d freed, %d total moves)",
@@ -32,6 +32,7 @@
 #include "jvmtifiles/jvmtiEnv.hpp"
 #include "memory/allocation.hpp"
 #include "memory/universe.hpp"
+#include "utilities/growableArray.hpp"
 
 // forward references
 class JvmtiTagHashmap;
@@ -48,10 +49,14 @@ class JvmtiTagMap :  public CHeapObj<mtInternal> {
   JvmtiEnv*             _env;                       // the jvmti environment
   Mutex                 _lock;                      // lock for this tag map
   JvmtiTagHashmap*      _hashmap;                   // the hashmap
+  bool                  _needs_rehashing;           // objects moved since last use
 
   JvmtiTagHashmapEntry* _free_entries;              // free list for this environment
   int _free_entries_count;                          // number of entries on the free list
 
+  GrowableArray<jlong>* _freed_tags;                // ObjectFree events not posted yet
+  static bool _has_object_free_events;              // protected by Service_lock
+
   // create a tag map
   JvmtiTagMap(JvmtiEnv* env);
 
@@ -61,6 +66,12 @@ class JvmtiTagMap :  public CHeapObj<mtInternal> {
 
   void do_weak_oops(BoolObjectClosure* is_alive, OopClosure* f);
 
+  // re-hash the hashmap if the GC moved tagged objects
+  void check_hashmap();
+
+  // take the tags of the ObjectFree events deferred by do_weak_oops
+  GrowableArray<jlong>* take_freed_tags();
+
   // iterate over all entries in this tag map
   void entry_iterate(JvmtiTagHashmapEntryClosure* closure);
 
@@ -69,7 +80,10 @@ class JvmtiTagMap :  public CHeapObj<mtInternal> {
   // indicates if this tag map is locked
   bool is_locked()                          { return lock()->is_locked(); }
 
-  JvmtiTagHashmap* hashmap() { return _hashmap; }
+  JvmtiTagHashmap* hashmap() {
+    check_hashmap();
+    return _hashmap;
+  }
 
   // create/destroy entries
   JvmtiTagHashmapEntry* create_entry(oop ref, jlong tag);
@@ -123,6 +137,11 @@ class JvmtiTagMap :  public CHeapObj<mtInternal> {
 
   static void weak_oops_do(
       BoolObjectClosure* is_alive, OopClosure* f) NOT_JVMTI_RETURN;
+
+  // ObjectFree events deferred with JvmtiDeferObjectFreeEvents, posted
+  // by the ServiceThread. The first must be called with Service_lock held.
+  static bool has_object_free_events_and_reset() NOT_JVMTI_RETURN_(false);
+  static void flush_object_free_events() NOT_JVMTI_RETURN;
 };
 
 #endif // SHARE_PRIMS_JVMTITAGMAP_HPP
@@ -393,25 +393,44 @@ UNSAFE_ENTRY(void, Unsafe_FreeMemory0(JNIEnv *env, jobject unsafe, jlong addr))
   os::free(p);
 } UNSAFE_END
 
-UNSAFE_ENTRY(void, Unsafe_SetMemory0(JNIEnv *env, jobject unsafe, jobject obj, jlong offset, jlong size, jbyte value)) {
+// Like copySwapMemory0 below, setMemory0 and copyMemory0 are leaves so that
+// large fills and copies of native memory do not hold off safepoints. They
+// only enter the VM when the memory is on the heap.
+UNSAFE_LEAF(void, Unsafe_SetMemory0(JNIEnv *env, jobject unsafe, jobject obj, jlong offset, jlong size, jbyte value)) {
   size_t sz = (size_t)size;
 
-  oop base = JNIHandles::resolve(obj);
-  void* p = index_oop_from_field_offset_long(base, offset);
+  if (obj == NULL) {
+    // Native memory
+    Copy::fill_to_memory_atomic((void*)offset, sz, value);
+  } else {
+    JVM_ENTRY_FROM_LEAF(env, void, Unsafe_SetMemory0) {
+      oop base = JNIHandles::resolve(obj);
+      void* p = index_oop_from_field_offset_long(base, offset);
 
-  Copy::fill_to_memory_atomic(p, sz, value);
+      Copy::fill_to_memory_atomic(p, sz, value);
+    } JVM_END
+  }
 } UNSAFE_END
 
-UNSAFE_ENTRY(void, Unsafe_CopyMemory0(JNIEnv *env, jobject unsafe, jobject srcObj, jlong srcOffset, jobject dstObj, jlong dstOffset, jlong size)) {
+UNSAFE_LEAF(void, Unsafe_CopyMemory0(JNIEnv *env, jobject unsafe, jobject srcObj, jlong srcOffset, jobject dstObj, jlong dstOffset, jlong size)) {
   size_t sz = (size_t)size;
 
-  oop srcp = JNIHandles::resolve(srcObj);
-  oop dstp = JNIHandles::resolve(dstObj);
+  if (srcObj == NULL && dstObj == NULL) {
+    // Both src & dst are in native memory
+    Copy::conjoint_memory_atomic((void*)srcOffset, (void*)dstOffset, sz);
+  } else {
+    // At least one of src/dst are on heap, transition to VM to access raw pointers
+
+    JVM_ENTRY_FROM_LEAF(env, void, Unsafe_CopyMemory0) {
+      oop srcp = JNIHandles::resolve(srcObj);
+      oop dstp = JNIHandles::resolve(dstObj);
 
-  void* src = index_oop_from_field_offset_long(srcp, srcOffset);
-  void* dst = index_oop_from_field_offset_long(dstp, dstOffset);
+      void* src = index_oop_from_field_offset_long(srcp, srcOffset);
+      void* dst = index_oop_from_field_offset_long(dstp, dstOffset);
 
-  Copy::conjoint_memory_atomic(src, dst, sz);
+      Copy::conjoint_memory_atomic(src, dst, sz);
+    } JVM_END
+  }
 } UNSAFE_END
 
 // This function is a leaf since if the source and destination are both in native memory
@@ -35,6 +35,7 @@
 #include "runtime/basicLock.hpp"
 #include "runtime/biasedLocking.hpp"
 #include "runtime/handles.inline.hpp"
+#include "runtime/handshake.hpp"
 #include "runtime/task.hpp"
 #include "runtime/threadSMR.hpp"
 #include "runtime/vframe.hpp"
@@ -585,6 +586,96 @@ public:
   }
 };
 
+// Revokes the bias of a single object during a handshake with the thread
+// the object is biased toward, instead of a global safepoint. Only the bias
+// owner can change the mark word of an object biased toward it with a valid
+// epoch, so with that thread stopped its stack can be walked and the mark
+// rewritten. Any other state is handled with a CAS, or left to the caller by
+// leaving handled() false.
+class RevokeOneBias : public ThreadClosure {
+private:
+  Handle _obj;
+  JavaThread* _requesting_thread;
+  JavaThread* _biased_locker;
+  BiasedLocking::Condition _status_code;
+  traceid _biased_locker_id;
+  bool _handled;
+
+public:
+  RevokeOneBias(Handle obj, JavaThread* requesting_thread, JavaThread* biased_locker)
+    : _obj(obj)
+    , _requesting_thread(requesting_thread)
+    , _biased_locker(biased_locker)
+    , _status_code(BiasedLocking::NOT_BIASED)
+    , _biased_locker_id(0)
+    , _handled(false) {}
+
+  void do_thread(Thread* target) {
+    assert(target == _biased_locker, "Wrong thread");
+
+    oop o = _obj();
+    markOop mark = o->mark();
+    _handled = true;
+
+    if (!mark->has_bias_pattern()) {
+      return;
+    }
+
+    markOop prototype = o->klass()->prototype_header();
+    if (!prototype->has_bias_pattern()) {
+      // This object has a stale bias from before the handshake was
+      // requested. If we fail this race, the object's bias has been
+      // revoked by another thread.
+      markOop biased_value = mark;
+      mark = o->cas_set_mark(markOopDesc::prototype()->set_age(mark->age()), mark);
+      assert(!o->mark()->has_bias_pattern(), "even if we raced, should still be revoked");
+      if (biased_value == mark) {
+        _status_code = BiasedLocking::BIAS_REVOKED;
+      }
+      return;
+    }
+
+    if (_biased_locker == mark->biased_locker()) {
+      if (mark->bias_epoch() == prototype->bias_epoch()) {
+        // Epoch is still valid, so the bias owner may currently be
+        // synchronized on this object. Walk its stack and fix up the mark.
+        log_info(biasedlocking)("Revoking bias with handshake:");
+        JavaThread* biased_locker = NULL;
+        _status_code = revoke_bias(o, false, false, _requesting_thread, &biased_locker);
+        _biased_locker->set_cached_monitor_info(NULL);
+        assert(!o->mark()->has_bias_pattern(), "invariant");
+        if (biased_locker != NULL) {
+          _biased_locker_id = JFR_THREAD_ID(biased_locker);
+        }
+        return;
+      }
+      // The epoch has expired, other threads may race to rebias the object
+      markOop biased_value = mark;
+      mark = o->cas_set_mark(markOopDesc::prototype()->set_age(mark->age()), mark);
+      if (mark == biased_value || !mark->has_bias_pattern()) {
+        assert(!o->mark()->has_bias_pattern(), "should be revoked");
+        _status_code = (biased_value == mark) ? BiasedLocking::BIAS_REVOKED : BiasedLocking::NOT_BIASED;
+        return;
+      }
+    }
+
+    // The object is now biased toward another thread
+    _handled = false;
+  }
+
+  bool handled() const {
+    return _handled;
+  }
+
+  BiasedLocking::Condition status_code() const {
+    return _status_code;
+  }
+
+  traceid biased_locker() const {
+    return _biased_locker_id;
+  }
+};
+
 template <typename E>
 static void set_safepoint_id(E* event) {
   assert(event != NULL, "invariant");
@@ -611,6 +702,16 @@ static void post_revocation_event(EventBiasedLockRevocation* event, Klass* k, VM
   event->commit();
 }
 
+static void post_revocation_event(EventBiasedLockRevocation* event, Klass* k, RevokeOneBias* revoke) {
+  assert(event != NULL, "invariant");
+  assert(k != NULL, "invariant");
+  assert(revoke != NULL, "invariant");
+  assert(event->should_commit(), "invariant");
+  event->set_lockClass(k);
+  event->set_previousOwner(revoke->biased_locker());
+  event->commit();
+}
+
 static void post_class_revocation_event(EventBiasedLockClassRevocation* event, Klass* k, bool disabled_bias) {
   assert(event != NULL, "invariant");
   assert(k != NULL, "invariant");
@@ -712,6 +813,18 @@ BiasedLocking::Condition BiasedLocking::revoke_and_rebias(Handle obj, bool attem
       return cond;
     } else {
       EventBiasedLockRevocation event;
+      JavaThread* biaser = mark->biased_locker();
+      if (ThreadLocalHandshakes && biaser != NULL && biaser != THREAD) {
+        RevokeOneBias revoke(obj, (JavaThread*) THREAD, biaser);
+        if (Handshake::execute(&revoke, biaser) && revoke.handled()) {
+          if (event.should_commit() && revoke.status_code() != NOT_BIASED) {
+            post_revocation_event(&event, k, &revoke);
+          }
+          return revoke.status_code();
+        }
+        // The bias owner has exited or the object was rebiased
+        // meanwhile, fall back to revoking at a safepoint.
+      }
       VM_RevokeBias revoke(&obj, (JavaThread*) THREAD);
       VMThread::execute(&revoke);
       if (event.should_commit() && revoke.status_code() != NOT_BIASED) {
@@ -745,6 +858,19 @@ void BiasedLocking::revoke(GrowableArray<Handle>* objs) {
 }
 
 
+void BiasedLocking::revoke_own_locks(GrowableArray<Handle>* objs, JavaThread* biaser) {
+  assert(!SafepointSynchronize::is_at_safepoint(), "must not be called while at safepoint");
+  for (int i = 0; i < objs->length(); i++) {
+    Handle obj = objs->at(i);
+    if (obj->mark()->has_bias_pattern()) {
+      RevokeOneBias revoke(obj, biaser, biaser);
+      revoke.do_thread(biaser);
+      guarantee(revoke.handled(), "locked object must be biased toward its owner");
+    }
+  }
+}
+
+
 void BiasedLocking::revoke_at_safepoint(Handle h_obj) {
   assert(SafepointSynchronize::is_at_safepoint(), "must only be called while at safepoint");
   oop obj = h_obj();
@@ -179,6 +179,9 @@ public:
   // These do not allow rebiasing; they are used by deoptimization to
   // ensure that monitors on the stack can be migrated
   static void revoke(GrowableArray<Handle>* objs);
+  // Revokes the biases of objects locked by biaser, which must either be
+  // the current thread or be stopped in a handshake
+  static void revoke_own_locks(GrowableArray<Handle>* objs, JavaThread* biaser);
   static void revoke_at_safepoint(Handle obj);
   static void revoke_at_safepoint(GrowableArray<Handle>* objs);
 
@@ -49,6 +49,7 @@
 #include "runtime/deoptimization.hpp"
 #include "runtime/frame.inline.hpp"
 #include "runtime/handles.inline.hpp"
+#include "runtime/handshake.hpp"
 #include "runtime/interfaceSupport.inline.hpp"
 #include "runtime/safepointVerifiers.hpp"
 #include "runtime/sharedRuntime.hpp"
@@ -57,6 +58,7 @@
 #include "runtime/thread.hpp"
 #include "runtime/threadSMR.hpp"
 #include "runtime/vframe.hpp"
+#include "runtime/vmThread.hpp"
 #include "runtime/vframeArray.hpp"
 #include "runtime/vframe_hp.hpp"
 #include "utilities/events.hpp"
@@ -785,6 +787,52 @@ int Deoptimization::deoptimize_dependents() {
   return 0;
 }
 
+class DeoptimizeMarkedClosure : public ThreadClosure {
+ public:
+  void do_thread(Thread* thread) {
+    ResourceMark rm;
+    DeoptimizationMarker dm;
+    ((JavaThread*)thread)->deoptimized_wrt_marked_nmethods();
+  }
+};
+
+void Deoptimization::deoptimize_all_marked() {
+  if (!HandshakeDeoptimization || SafepointSynchronize::is_at_safepoint() ||
+      !ThreadLocalHandshakes || NeedsDeoptSuspend) {
+    VM_Deoptimize op;
+    VMThread::execute(&op);
+    return;
+  }
+
+  // Collect the marked methods under the CodeCache_lock, but make them not
+  // entrant after releasing it since that takes the Patching_lock. The
+  // nmethodLocker keeps them from being flushed in between.
+  ResourceMark rm;
+  GrowableArray<CompiledMethod*> marked;
+  {
+    MutexLockerEx ml(CodeCache_lock, Mutex::_no_safepoint_check_flag);
+    CompiledMethodIterator iter(CompiledMethodIterator::only_alive_and_not_unloading);
+    while (iter.next()) {
+      CompiledMethod* cm = iter.method();
+      if (cm->is_marked_for_deoptimization() && !cm->is_not_entrant()) {
+        nmethodLocker::lock_nmethod(cm);
+        marked.append(cm);
+      }
+    }
+  }
+  for (int i = 0; i < marked.length(); i++) {
+    CompiledMethod* cm = marked.at(i);
+    cm->make_not_entrant();
+    nmethodLocker::unlock_nmethod(cm);
+  }
+
+  // Existing activations keep running until their frames are patched.
+  // This is safe since the classes whose loading invalidated them are not
+  // yet visible while the requesting thread holds the Compile_lock.
+  DeoptimizeMarkedClosure deopt;
+  Handshake::execute(&deopt);
+}
+
 Deoptimization::DeoptAction Deoptimization::_unloaded_action
   = Deoptimization::Action_reinterpret;
 
@@ -1280,8 +1328,13 @@ void Deoptimization::revoke_biases_of_monitors(JavaThread* thread, frame fr, Reg
 
   if (SafepointSynchronize::is_at_safepoint()) {
     BiasedLocking::revoke_at_safepoint(objects_to_revoke);
-  } else {
+  } else if (!HandshakeDeoptimization) {
     BiasedLocking::revoke(objects_to_revoke);
+  } else {
+    // Either the current thread deoptimizes its own frame or the target
+    // thread is stopped in a handshake; in both cases the monitors are
+    // owned by the target thread and can be revoked without a VM operation.
+    BiasedLocking::revoke_own_locks(objects_to_revoke, thread);
   }
 }
 
@@ -139,6 +139,12 @@ class Deoptimization : AllStatic {
   // corresponding activations are deoptimized.
   static int deoptimize_dependents();
 
+  // Makes all compiled methods marked for deoptimization not entrant and
+  // deoptimizes their activations. With HandshakeDeoptimization, uses a
+  // handshake with the Java threads when possible; otherwise, and by
+  // default, uses a VM_Deoptimize safepoint.
+  static void deoptimize_all_marked();
+
   // Deoptimizes a frame lazily. nmethod gets patched deopt happens on return to the frame
   static void deoptimize(JavaThread* thread, frame fr, RegisterMap *reg_map);
   static void deoptimize(JavaThread* thread, frame fr, RegisterMap *reg_map, DeoptReason reason);
@@ -264,6 +264,15 @@ define_pd_global(uint64_t,MaxRAM,                    1ULL*G);
   diagnostic(uint, HandshakeTimeout, 0,                                     \
           "If nonzero set a timeout in milliseconds for handshakes")        \
                                                                             \
+  experimental(bool, HandshakeDeoptimization, false,                        \
+          "Deoptimize the dependents of a newly loaded class with a "       \
+          "handshake instead of a safepoint")                               \
+                                                                            \
+  experimental(bool, UseSystemMemoryBarrier, false,                         \
+          "Drop the fence from thread state transitions and have the "      \
+          "safepoint and handshake initiator issue a process-wide memory "  \
+          "barrier (membarrier on Linux) instead")                          \
+                                                                            \
   experimental(bool, AlwaysSafeConstructors, false,                         \
           "Force safe construction, as if all fields are final.")           \
                                                                             \
@@ -648,6 +657,17 @@ define_pd_global(uint64_t,MaxRAM,                    1ULL*G);
           "directory) of the dump file (defaults to java_pid<pid>.hprof "   \
           "in the working directory)")                                      \
                                                                             \
+  manageable(bool, HeapDumpParallel, false,                                 \
+          "Dump the heap objects with the GC worker threads if the "        \
+          "collector supports it. Each worker writes a temporary part "     \
+          "file next to the dump file")                                     \
+                                                                            \
+  manageable(uintx, HeapDumpGzipLevel, 0,                                   \
+          "When HeapDumpOnOutOfMemoryError is on, the gzip compression "    \
+          "level of the dump file. 0 (the default) disables gzip "          \
+          "compression. Otherwise the level must be between 1 and 9.")      \
+          range(0, 9)                                                       \
+                                                                            \
   develop(bool, BreakAtWarning, false,                                      \
           "Execute breakpoint upon encountering VM warning")                \
                                                                             \
@@ -660,6 +680,12 @@ define_pd_global(uint64_t,MaxRAM,                    1ULL*G);
   diagnostic(bool, PrintNMTStatistics, false,                               \
           "Print native memory tracking summary data if it is on")          \
                                                                             \
+  product(uintx, NativeMemoryTrackingStackSampleInterval, 0,                \
+          "In detail mode, walk the call stack for about one in this many " \
+          "malloc calls and scale the per call site numbers accordingly. "  \
+          "0 or 1 walks the stack of every malloc call")                    \
+          range(0, max_jint)                                                \
+                                                                            \
   diagnostic(bool, LogCompilation, false,                                   \
           "Log compilation activity in detail to LogFile")                  \
                                                                             \
@@ -828,6 +854,13 @@ define_pd_global(uint64_t,MaxRAM,                    1ULL*G);
                 "The check is performed on GuaranteedSafepointInterval.")   \
                 range(0, 100)                                               \
                                                                             \
+  experimental(intx, MonitorDeflationInterval, 0,                           \
+                "Minimum time in ms between safepoints that deflate idle "  \
+                "monitors (0 deflates at every safepoint). Deflation is "   \
+                "not deferred when monitor usage is above "                 \
+                "MonitorUsedDeflationThreshold or a scavenge is forced")    \
+                range(0, max_jint)                                          \
+                                                                            \
   experimental(intx, hashCode, 5,                                           \
                "(Unstable) select hashCode generation algorithm")           \
                                                                             \
@@ -1058,6 +1091,11 @@ define_pd_global(uint64_t,MaxRAM,                    1ULL*G);
   diagnostic(bool, VerifyBeforeIteration, false,                            \
           "Verify memory system before JVMTI iteration")                    \
                                                                             \
+  product(bool, JvmtiDeferObjectFreeEvents, false,                          \
+          "Post the JVMTI ObjectFree events of a garbage collection in "    \
+          "batches from the service thread after the collection, instead "  \
+          "of one by one during the collection pause")                      \
+                                                                            \
   /* compiler interface */                                                  \
                                                                             \
   develop(bool, CIPrintCompilerName, false,                                 \
@@ -1158,6 +1196,11 @@ define_pd_global(uint64_t,MaxRAM,                    1ULL*G);
   diagnostic(bool, EnableThreadSMRStatistics, trueInDebug,                  \
              "Enable Thread SMR Statistics")                                \
                                                                             \
+  diagnostic(uintx, ThreadSMRFreeListBatchSize, 8,                          \
+             "Number of retired ThreadsLists to collect before scanning "   \
+             "the hazard pointers to free them")                            \
+             range(1, 1024)                                                 \
+                                                                            \
   product(bool, Inline, true,                                               \
           "Enable inlining")                                                \
                                                                             \
@@ -1266,6 +1309,11 @@ define_pd_global(uint64_t,MaxRAM,                    1ULL*G);
   product(bool, DisplayVMOutputToStdout, false,                             \
           "If DisplayVMOutput is true, display all VM output to stdout")    \
                                                                             \
+  product(size_t, AsyncLogBufferSize, 2*M,                                  \
+          "Memory budget (in bytes) for the buffer of -Xlog:async, "        \
+          "messages are dropped when it is full")                           \
+          range(100*K, 50*M)                                                \
+                                                                            \
   product(bool, UseHeavyMonitors, false,                                    \
           "use heavyweight instead of lightweight Java monitors")           \
                                                                             \
@@ -1565,6 +1613,13 @@ define_pd_global(uint64_t,MaxRAM,                    1ULL*G);
   product(intx, SafepointTimeoutDelay, 10000,                               \
           "Delay in milliseconds for option SafepointTimeout")              \
   LP64_ONLY(range(0, max_intx/MICROUNITS))                                  \
+  NOT_LP64(range(0, max_intx))                                              \
+                                                                            \
+  diagnostic(intx, SafepointStragglerSampleDelay, 0,                        \
+          "Sample the pc of threads that have not reached a safepoint "     \
+          "after this many milliseconds and report them with "              \
+          "-Xlog:safepoint and the SafepointStraggler event (0 is off)")    \
+  LP64_ONLY(range(0, max_intx/MICROUNITS))                                  \
   NOT_LP64(range(0, max_intx))                                              \
                                                                             \
   product(intx, NmethodSweepActivity, 10,                                   \
@@ -1758,6 +1813,10 @@ define_pd_global(uint64_t,MaxRAM,                    1ULL*G);
           range(0, 99)                                                      \
           constraint(MinMetaspaceFreeRatioConstraintFunc,AfterErgo)         \
                                                                             \
+  product(bool, MetaspaceUncommitFreeChunks, false,                         \
+          "Return the memory of free medium and humongous Metaspace "       \
+          "chunks to the operating system")                                 \
+                                                                            \
   product(size_t, MaxMetaspaceExpansion, ScaleForWordSize(4*M),             \
           "The maximum expansion of Metaspace without full GC (in bytes)")  \
           range(0, max_uintx)                                               \
@@ -1834,6 +1893,13 @@ define_pd_global(uint64_t,MaxRAM,                    1ULL*G);
           "Reserved code cache size (in bytes) - maximum code cache size")  \
           range(os::vm_page_size(), max_uintx)                              \
                                                                             \
+  product(size_t, CodeCacheLargePageSize, 0,                                \
+          "Explicit large page size (in bytes) to back the code cache "     \
+          "with, e.g. 2M or 1G. Needs UseLargePages and a configured "      \
+          "pool of such pages; 0 uses the default large page size. "        \
+          "Linux only")                                                     \
+          range(0, max_uintx)                                               \
+                                                                            \
   product_pd(uintx, NonProfiledCodeHeapSize,                                \
           "Size of code heap with non-profiled methods (in bytes)")         \
           range(0, max_uintx)                                               \
@@ -1923,6 +1989,10 @@ define_pd_global(uint64_t,MaxRAM,                    1ULL*G);
   product(ccstr, CompileCommandFile, NULL,                                  \
           "Read compiler commands from this file [.hotspot_compiler]")      \
                                                                             \
+  product(ccstr, CompilationWarmupFile, NULL,                               \
+          "Start profiling the methods listed in this file immediately "    \
+          "and record the methods compiled by C2 there at exit")            \
+                                                                            \
   diagnostic(ccstr, CompilerDirectivesFile, NULL,                           \
           "Read compiler directives from this file")                        \
                                                                             \
@@ -2206,6 +2276,13 @@ define_pd_global(uint64_t,MaxRAM,                    1ULL*G);
           "given timeout in milliseconds")                                  \
           range(0, max_intx)                                                \
                                                                             \
+  product(intx, TieredCompileQueueRescanInterval, 10,                       \
+          "Minimum time in milliseconds between full scans of a compile "   \
+          "queue that refresh task priorities and remove stale tasks. "     \
+          "In between, tasks are selected from a priority heap. "           \
+          "0 scans the whole queue on every selection")                     \
+          range(0, max_intx)                                                \
+                                                                            \
   product(intx, TieredStopAtLevel, 4,                                       \
           "Stop at given compilation level")                                \
           range(0, 4)                                                       \
@@ -2335,6 +2412,11 @@ define_pd_global(uint64_t,MaxRAM,                    1ULL*G);
   manageable(bool, PrintConcurrentLocks, false,                             \
           "Print java.util.concurrent locks in thread dump")                \
                                                                             \
+  manageable(bool, ThreadDumpWithHandshakes, false,                         \
+          "Capture the stack of each thread in a dump of all threads with " \
+          "a handshake with that thread instead of in one safepoint. The "  \
+          "stacks are then not taken at the same point in time")            \
+                                                                            \
   /* Shared spaces */                                                       \
                                                                             \
   product(bool, UseSharedSpaces, true,                                      \
@@ -2463,6 +2545,14 @@ define_pd_global(uint64_t,MaxRAM,                    1ULL*G);
           "Dump the names all loaded classes, that could be stored into "   \
           "the CDS archive, in the specified file")                         \
                                                                             \
+  experimental(ccstr, PreloadClassList, NULL,                               \
+          "Load and link the classes named in the specified class list "    \
+          "file on background threads at startup, ahead of first use")      \
+                                                                            \
+  experimental(uintx, PreloadClassListThreads, 2,                           \
+          "Number of threads used by PreloadClassList")                     \
+          range(1, 64)                                                      \
+                                                                            \
   product(ccstr, SharedClassListFile, NULL,                                 \
           "Override the default CDS class list")                            \
                                                                             \
@@ -2543,6 +2633,17 @@ define_pd_global(uint64_t,MaxRAM,                    1ULL*G);
   JFR_ONLY(product(ccstr, StartFlightRecording, NULL,                       \
           "Start flight recording with options"))                           \
                                                                             \
+  JFR_ONLY(product(uintx, FlightRecorderFlushInterval, 0,                   \
+          "Interval in milliseconds at which Flight Recorder writes its "   \
+          "global and full buffers to the current chunk, 0 disables "       \
+          "periodic flushing")                                              \
+          range(0, max_jint))                                               \
+                                                                            \
+  JFR_ONLY(product(uintx, FlightRecorderAllocationSampleRate, 150,          \
+          "Target number of ObjectAllocationSample events per second "      \
+          "when the event is enabled")                                      \
+          range(10, max_jint))                                              \
+                                                                            \
   experimental(bool, UseFastUnorderedTimeStamps, false,                     \
           "Use platform unstable time where supported for timestamps only")
 
@@ -36,7 +36,9 @@
 #include "runtime/thread.hpp"
 #include "runtime/vmThread.hpp"
 #include "utilities/formatBuffer.hpp"
+#include "utilities/growableArray.hpp"
 #include "utilities/preserveException.hpp"
+#include "utilities/systemMemoryBarrier.hpp"
 
 class HandshakeOperation: public StackObj {
 public:
@@ -78,6 +80,15 @@ class VM_Handshake: public VM_Operation {
     target->set_handshake_operation(_op);
   }
 
+  // With UseSystemMemoryBarrier the targets' thread state transitions
+  // don't fence; make the armed polls and the targets' states mutually
+  // visible before the VM thread examines those states.
+  static void serialize_thread_states() {
+    if (UseSystemMemoryBarrier) {
+      SystemMemoryBarrier::emit();
+    }
+  }
+
   // This method returns true for threads completed their operation
   // and true for threads canceled their operation.
   // A cancellation can happen if the thread is exiting.
@@ -125,6 +136,7 @@ class VM_HandshakeOneThread: public VM_Handshake {
     } else {
       return;
     }
+    serialize_thread_states();
 
     log_trace(handshake)("Thread signaled, begin processing by VMThtread");
     jlong start_time = os::elapsed_counter();
@@ -149,9 +161,14 @@ class VM_HandshakeOneThread: public VM_Handshake {
   bool thread_alive() const { return _thread_alive; }
 };
 
+// Handshakes all threads, or only the live threads in a target list. All
+// targets are armed at once so they run the operation concurrently.
 class VM_HandshakeAllThreads: public VM_Handshake {
+  GrowableArray<JavaThread*>* _targets; // NULL for all threads
+  int _number_of_threads_issued;
  public:
-  VM_HandshakeAllThreads(HandshakeThreadsOperation* op) : VM_Handshake(op) {}
+  VM_HandshakeAllThreads(HandshakeThreadsOperation* op, GrowableArray<JavaThread*>* targets = NULL) :
+    VM_Handshake(op), _targets(targets), _number_of_threads_issued(0) {}
 
   void doit() {
     DEBUG_ONLY(_op->check_state();)
@@ -160,14 +177,18 @@ class VM_HandshakeAllThreads: public VM_Handshake {
     JavaThreadIteratorWithHandle jtiwh;
     int number_of_threads_issued = 0;
     for (JavaThread *thr = jtiwh.next(); thr != NULL; thr = jtiwh.next()) {
-      set_handshake(thr);
-      number_of_threads_issued++;
+      if (_targets == NULL || _targets->contains(thr)) {
+        set_handshake(thr);
+        number_of_threads_issued++;
+      }
     }
+    _number_of_threads_issued = number_of_threads_issued;
 
     if (number_of_threads_issued < 1) {
       log_debug(handshake)("No threads to handshake.");
       return;
     }
+    serialize_thread_states();
 
     log_debug(handshake)("Threads signaled, begin processing blocked threads by VMThtread");
     const jlong start_time = os::elapsed_counter();
@@ -205,32 +226,40 @@ class VM_HandshakeAllThreads: public VM_Handshake {
   }
 
   VMOp_Type type() const { return VMOp_HandshakeAllThreads; }
+
+  int number_of_threads_issued() const { return _number_of_threads_issued; }
 };
 
 class VM_HandshakeFallbackOperation : public VM_Operation {
   ThreadClosure* _thread_cl;
   Thread* _target_thread;
+  GrowableArray<JavaThread*>* _targets;
   bool _all_threads;
   bool _thread_alive;
+  int _threads_done;
 public:
   VM_HandshakeFallbackOperation(ThreadClosure* cl) :
-      _thread_cl(cl), _target_thread(NULL), _all_threads(true), _thread_alive(true) {}
+      _thread_cl(cl), _target_thread(NULL), _targets(NULL), _all_threads(true), _thread_alive(true), _threads_done(0) {}
   VM_HandshakeFallbackOperation(ThreadClosure* cl, Thread* target) :
-      _thread_cl(cl), _target_thread(target), _all_threads(false), _thread_alive(false) {}
+      _thread_cl(cl), _target_thread(target), _targets(NULL), _all_threads(false), _thread_alive(false), _threads_done(0) {}
+  VM_HandshakeFallbackOperation(ThreadClosure* cl, GrowableArray<JavaThread*>* targets) :
+      _thread_cl(cl), _target_thread(NULL), _targets(targets), _all_threads(false), _thread_alive(false), _threads_done(0) {}
 
   void doit() {
     for (JavaThreadIteratorWithHandle jtiwh; JavaThread *t = jtiwh.next(); ) {
-      if (_all_threads || t == _target_thread) {
+      if (_all_threads || t == _target_thread || (_targets != NULL && _targets->contains(t))) {
         if (t == _target_thread) {
           _thread_alive = true;
         }
         _thread_cl->do_thread(t);
+        _threads_done++;
       }
     }
   }
 
   VMOp_Type type() const { return VMOp_HandshakeFallback; }
   bool thread_alive() const { return _thread_alive; }
+  int threads_done() const { return _threads_done; }
 };
 
 void HandshakeThreadsOperation::do_handshake(JavaThread* thread) {
@@ -272,6 +301,19 @@ bool Handshake::execute(ThreadClosure* thread_cl, JavaThread* target) {
   }
 }
 
+int Handshake::execute(ThreadClosure* thread_cl, GrowableArray<JavaThread*>* targets) {
+  if (ThreadLocalHandshakes) {
+    HandshakeThreadsOperation cto(thread_cl);
+    VM_HandshakeAllThreads handshake(&cto, targets);
+    VMThread::execute(&handshake);
+    return handshake.number_of_threads_issued();
+  } else {
+    VM_HandshakeFallbackOperation op(thread_cl, targets);
+    VMThread::execute(&op);
+    return op.threads_done();
+  }
+}
+
 HandshakeState::HandshakeState() : _operation(NULL), _semaphore(1), _thread_in_process_handshake(false) {}
 
 void HandshakeState::set_operation(JavaThread* target, HandshakeOperation* op) {
@@ -31,17 +31,20 @@
 
 class ThreadClosure;
 class JavaThread;
+template <class T> class GrowableArray;
 
 // A handshake operation is a callback that is executed for each JavaThread
 // while that thread is in a safepoint safe state. The callback is executed
 // either by the thread itself or by the VM thread while keeping the thread
 // in a blocked state. A handshake can be performed with a single
-// JavaThread as well.
+// JavaThread as well, or with a list of JavaThreads in a single operation.
 class Handshake : public AllStatic {
  public:
   // Execution of handshake operation
   static void execute(ThreadClosure* thread_cl);
   static bool execute(ThreadClosure* thread_cl, JavaThread* target);
+  // Returns the number of targets that were alive and ran the closure
+  static int execute(ThreadClosure* thread_cl, GrowableArray<JavaThread*>* targets);
 };
 
 class HandshakeOperation;
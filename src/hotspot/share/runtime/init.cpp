@@ -38,6 +38,7 @@
 #include "runtime/init.hpp"
 #include "runtime/safepoint.hpp"
 #include "runtime/sharedRuntime.hpp"
+#include "runtime/timerTrace.hpp"
 #include "services/memTracker.hpp"
 #include "utilities/macros.hpp"
 
@@ -106,12 +107,17 @@ jint init_globals() {
   bytecodes_init();
   classLoader_init1();
   compilationPolicy_init();
-  codeCache_init();
+  { TraceTime timer("Code cache initialization", TRACETIME_LOG(Info, startuptime));
+    codeCache_init();
+  }
   VM_Version_init();
   os_init_globals();
   stubRoutines_init1();
-  jint status = universe_init();  // dependent on codeCache_init and
-                                  // stubRoutines_init1 and metaspace_init.
+  jint status;
+  { TraceTime timer("Universe initialization", TRACETIME_LOG(Info, startuptime));
+    status = universe_init();  // dependent on codeCache_init and
+                               // stubRoutines_init1 and metaspace_init.
+  }
   if (status != JNI_OK)
     return status;
 
@@ -121,8 +127,12 @@ jint init_globals() {
   accessFlags_init();
   templateTable_init();
   InterfaceSupport_init();
-  SharedRuntime::generate_stubs();
-  universe2_init();  // dependent on codeCache_init and stubRoutines_init1
+  { TraceTime timer("SharedRuntime stubs generation", TRACETIME_LOG(Info, startuptime));
+    SharedRuntime::generate_stubs();
+  }
+  { TraceTime timer("Preloaded classes initialization", TRACETIME_LOG(Info, startuptime));
+    universe2_init();  // dependent on codeCache_init and stubRoutines_init1
+  }
   javaClasses_init();// must happen after vtable initialization, before referenceProcessor_init
   referenceProcessor_init();
   jni_handles_init();
@@ -135,13 +145,19 @@ jint init_globals() {
   compilerOracle_init();
   dependencyContext_init();
 
-  if (!compileBroker_init()) {
-    return JNI_EINVAL;
+  {
+    TraceTime timer("CompileBroker initialization", TRACETIME_LOG(Info, startuptime));
+    if (!compileBroker_init()) {
+      return JNI_EINVAL;
+    }
   }
   VMRegImpl::set_regName();
 
-  if (!universe_post_init()) {
-    return JNI_ERR;
+  {
+    TraceTime timer("Universe post initialization", TRACETIME_LOG(Info, startuptime));
+    if (!universe_post_init()) {
+      return JNI_ERR;
+    }
   }
   stubRoutines_init2(); // note: StubRoutines need 2-phase init
   MethodHandles::generate_adapters();
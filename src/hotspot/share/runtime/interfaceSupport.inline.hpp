@@ -78,8 +78,11 @@ class InterfaceSupport: AllStatic {
 
  private:
   static void serialize_thread_state_internal(JavaThread* thread, bool needs_exception_handler) {
-    // Make sure new state is seen by VM thread
-    OrderAccess::fence();
+    // Make sure new state is seen by VM thread.  With a system memory
+    // barrier, the VM thread issues it before reading thread states.
+    if (!UseSystemMemoryBarrier) {
+      OrderAccess::fence();
+    }
   }
 };
 
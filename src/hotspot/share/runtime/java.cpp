@@ -30,6 +30,7 @@
 #include "classfile/stringTable.hpp"
 #include "classfile/systemDictionary.hpp"
 #include "code/codeCache.hpp"
+#include "compiler/compilationWarmup.hpp"
 #include "compiler/compileBroker.hpp"
 #include "compiler/compilerOracle.hpp"
 #include "interpreter/bytecodeHistogram.hpp"
@@ -40,6 +41,7 @@
 #include "jvmci/jvmciRuntime.hpp"
 #endif
 #include "logging/log.hpp"
+#include "logging/logAsyncWriter.hpp"
 #include "logging/logStream.hpp"
 #include "memory/oopFactory.hpp"
 #include "memory/resourceArea.hpp"
@@ -509,6 +511,14 @@ void before_exit(JavaThread* thread) {
   print_statistics();
   Universe::heap()->print_tracing_info();
 
+  if (TieredCompilation) {
+    CompilationWarmup::dump_at_exit();
+  }
+
+  // Write out buffered log messages; the VM may exit without destroy_vm.
+  // Anything logged from here on is written synchronously.
+  AsyncLogWriter::terminate();
+
   { MutexLocker ml(BeforeExit_lock);
     _before_exit_status = BEFORE_EXIT_DONE;
     BeforeExit_lock->notify_all();
@@ -153,6 +153,9 @@ Mutex*   NMTQuery_lock                = NULL;
 #if INCLUDE_CDS && INCLUDE_JVMTI
 Mutex*   CDSClassFileStream_lock      = NULL;
 #endif
+#if INCLUDE_CDS
+Mutex*   ClassListFile_lock           = NULL;
+#endif
 
 #define MAX_NUM_MUTEX 128
 static Monitor * _mutex_array[MAX_NUM_MUTEX];
@@ -345,6 +348,9 @@ void mutex_init() {
 #if INCLUDE_CDS && INCLUDE_JVMTI
   def(CDSClassFileStream_lock      , PaddedMutex  , max_nonleaf, false, Monitor::_safepoint_check_always);
 #endif
+#if INCLUDE_CDS
+  def(ClassListFile_lock           , PaddedMutex  , leaf,        true,  Monitor::_safepoint_check_never);
+#endif
 }
 
 GCMutexLocker::GCMutexLocker(Monitor * mutex) {
@@ -136,6 +136,9 @@ extern Mutex*   NMTQuery_lock;                   // serialize NMT Dcmd queries
 #if INCLUDE_CDS && INCLUDE_JVMTI
 extern Mutex*   CDSClassFileStream_lock;         // FileMapInfo::open_stream_for_jvmti
 #endif
+#if INCLUDE_CDS
+extern Mutex*   ClassListFile_lock;              // ClassListWriter, writing the -XX:DumpLoadedClassList file
+#endif
 #if INCLUDE_JFR
 extern Mutex*   JfrStacktrace_lock;              // used to guard access to the JFR stacktrace table
 extern Monitor* JfrMsg_lock;                     // protects JFR messaging
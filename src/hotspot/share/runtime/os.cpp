@@ -658,7 +658,7 @@ static bool has_reached_max_malloc_test_peak(size_t alloc_size) {
 }
 
 void* os::malloc(size_t size, MEMFLAGS flags) {
-  return os::malloc(size, flags, CALLER_PC);
+  return os::malloc(size, flags, SAMPLED_CALLER_PC);
 }
 
 void* os::malloc(size_t size, MEMFLAGS memflags, const NativeCallStack& stack) {
@@ -716,7 +716,7 @@ void* os::malloc(size_t size, MEMFLAGS memflags, const NativeCallStack& stack) {
 }
 
 void* os::realloc(void *memblock, size_t size, MEMFLAGS flags) {
-  return os::realloc(memblock, size, flags, CALLER_PC);
+  return os::realloc(memblock, size, flags, SAMPLED_CALLER_PC);
 }
 
 void* os::realloc(void *memblock, size_t size, MEMFLAGS memflags, const NativeCallStack& stack) {
@@ -1761,6 +1761,9 @@ bool os::release_memory(char* addr, size_t bytes) {
 }
 
 void os::pretouch_memory(void* start, void* end, size_t page_size) {
+  if (start >= end || pd_pretouch_memory(start, end, page_size)) {
+    return;
+  }
   for (volatile char *p = (char*)start; p < (char*)end; p += page_size) {
     *p = 0;
   }
@@ -135,6 +135,9 @@ class os: AllStatic {
                                          bool executable, const char* mesg);
   static bool   pd_uncommit_memory(char* addr, size_t bytes);
   static bool   pd_release_memory(char* addr, size_t bytes);
+  // Returns false if the platform cannot populate the range itself and the
+  // pages have to be touched one by one.
+  static bool   pd_pretouch_memory(void* start, void* end, size_t page_size);
 
   static char*  pd_map_memory(int fd, const char* file_name, size_t file_offset,
                            char *addr, size_t bytes, bool read_only = false,
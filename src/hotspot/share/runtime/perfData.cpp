@@ -364,6 +364,28 @@ PerfDataList* PerfDataManager::constants() {
   return clone;
 }
 
+void PerfDataManager::print_on(outputStream* st) {
+  ResourceMark rm;
+  const int buffer_length = (int)PerfMaxStringConstLength + 1;
+  char* buffer = NEW_RESOURCE_ARRAY(char, buffer_length);
+
+  MutexLocker ml(PerfDataManager_lock);
+
+  if (_all == NULL)
+    return;
+
+  // The values are read with plain loads, the same way an external
+  // reader of the PerfData memory sees them.
+  for (int index = 0; index < _all->length(); index++) {
+    PerfData* p = _all->at(index);
+    if (!p->is_valid()) {
+      continue;
+    }
+    p->format(buffer, buffer_length);
+    st->print_cr("%s=%s", p->name(), buffer);
+  }
+}
+
 char* PerfDataManager::counter_name(const char* ns, const char* name) {
    assert(ns != NULL, "ns string required");
    assert(name != NULL, "name string required");
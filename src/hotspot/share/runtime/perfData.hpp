@@ -700,6 +700,9 @@ class PerfDataManager : AllStatic {
     // method to search for a instrumentation object by name
     static PerfData* find_by_name(const char* name);
 
+    // print the names and current values of all PerfData items
+    static void print_on(outputStream* st);
+
     // method to map a CounterNS enumeration to a namespace string
     static const char* ns_to_string(CounterNS ns) {
       return _name_spaces[ns];
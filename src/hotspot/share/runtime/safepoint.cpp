@@ -28,6 +28,7 @@
 #include "classfile/symbolTable.hpp"
 #include "classfile/systemDictionary.hpp"
 #include "code/codeCache.hpp"
+#include "code/debugInfoRec.hpp"
 #include "code/icBuffer.hpp"
 #include "code/nmethod.hpp"
 #include "code/pcDesc.hpp"
@@ -38,6 +39,7 @@
 #include "gc/shared/workgroup.hpp"
 #include "interpreter/interpreter.hpp"
 #include "jfr/jfrEvents.hpp"
+#include "jfr/support/jfrThreadId.hpp"
 #include "logging/log.hpp"
 #include "logging/logStream.hpp"
 #include "memory/resourceArea.hpp"
@@ -66,6 +68,7 @@
 #include "services/runtimeService.hpp"
 #include "utilities/events.hpp"
 #include "utilities/macros.hpp"
+#include "utilities/systemMemoryBarrier.hpp"
 #ifdef COMPILER1
 #include "c1/c1_globals.hpp"
 #endif
@@ -231,11 +234,22 @@ int SafepointSynchronize::synchronize_threads(jlong safepoint_limit_time, int no
 
   int iterations = 1; // The first iteration is above.
 
+  jlong straggler_sample_time = 0;
+  if (SafepointStragglerSampleDelay > 0) {
+    straggler_sample_time = SafepointTracing::start_of_safepoint() +
+                            (jlong)SafepointStragglerSampleDelay * (NANOUNITS / MILLIUNITS);
+  }
+
   while (still_running > 0) {
     // Check if this has taken too long:
     if (SafepointTimeout && safepoint_limit_time < os::javaTimeNanos()) {
       print_safepoint_timeout();
     }
+    // Sample the remaining threads once per safepoint
+    if (straggler_sample_time != 0 && straggler_sample_time < os::javaTimeNanos()) {
+      sample_stragglers(tss_head);
+      straggler_sample_time = 0;
+    }
     if (int(iterations) == -1) { // overflow - something is wrong.
       // We can only overflow here when we are using global
       // polling pages. We keep this guarantee in its original
@@ -330,6 +344,11 @@ void SafepointSynchronize::arm_safepoint() {
     }
   }
   OrderAccess::fence(); // storestore|storeload, global state -> local state
+  if (UseSystemMemoryBarrier) {
+    // Pairs with the fence omitted from the thread state transitions,
+    // must happen before any thread state is examined.
+    SystemMemoryBarrier::emit();
+  }
 
   if (SafepointMechanism::uses_global_page_poll()) {
     // Make interpreter safepoint aware
@@ -533,6 +552,38 @@ public:
   }
 };
 
+static const char* cleanup_task_names[SafepointSynchronize::SAFEPOINT_CLEANUP_NUM_TASKS] = {
+  "deflating global idle monitors",
+  "updating inline caches",
+  "compilation policy safepoint handler",
+  "rehashing symbol table",
+  "rehashing string table",
+  "purging class loader data graph"
+};
+
+// Times one cleanup task for the log, the SafepointCleanupTask event and
+// the per-task statistics in SafepointTracing.
+class SafepointCleanupTaskMark : public StackObj {
+private:
+  SafepointSynchronize::SafepointCleanupTasks _task;
+  uint64_t _safepoint_id;
+  EventSafepointCleanupTask _event;
+  TraceTime _timer;
+  jlong _start;
+public:
+  SafepointCleanupTaskMark(SafepointSynchronize::SafepointCleanupTasks task, uint64_t safepoint_id) :
+    _task(task),
+    _safepoint_id(safepoint_id),
+    _event(),
+    _timer(cleanup_task_names[task], TRACETIME_LOG(Info, safepoint, cleanup)),
+    _start(os::javaTimeNanos()) {}
+
+  ~SafepointCleanupTaskMark() {
+    SafepointTracing::cleanup_task(_task, os::javaTimeNanos() - _start);
+    post_safepoint_cleanup_task_event(_event, _safepoint_id, cleanup_task_names[_task]);
+  }
+};
+
 class ParallelSPCleanupTask : public AbstractGangTask {
 private:
   SubTasksDone _subtasks;
@@ -549,77 +600,48 @@ public:
 
   void work(uint worker_id) {
     uint64_t safepoint_id = SafepointSynchronize::safepoint_counter();
-    // All threads deflate monitors and mark nmethods (if necessary).
-    Threads::possibly_parallel_threads_do(true, &_cleanup_threads_cl);
 
+    // Claim the single-threaded tasks first so that an expensive one
+    // starts early, while the remaining workers share the per-thread
+    // work below.
     if (_subtasks.try_claim_task(SafepointSynchronize::SAFEPOINT_CLEANUP_DEFLATE_MONITORS)) {
-      const char* name = "deflating global idle monitors";
-      EventSafepointCleanupTask event;
-      TraceTime timer(name, TRACETIME_LOG(Info, safepoint, cleanup));
+      SafepointCleanupTaskMark mark(SafepointSynchronize::SAFEPOINT_CLEANUP_DEFLATE_MONITORS, safepoint_id);
       ObjectSynchronizer::deflate_idle_monitors(_counters);
-
-      post_safepoint_cleanup_task_event(event, safepoint_id, name);
     }
 
     if (_subtasks.try_claim_task(SafepointSynchronize::SAFEPOINT_CLEANUP_UPDATE_INLINE_CACHES)) {
-      const char* name = "updating inline caches";
-      EventSafepointCleanupTask event;
-      TraceTime timer(name, TRACETIME_LOG(Info, safepoint, cleanup));
+      SafepointCleanupTaskMark mark(SafepointSynchronize::SAFEPOINT_CLEANUP_UPDATE_INLINE_CACHES, safepoint_id);
       InlineCacheBuffer::update_inline_caches();
-
-      post_safepoint_cleanup_task_event(event, safepoint_id, name);
     }
 
     if (_subtasks.try_claim_task(SafepointSynchronize::SAFEPOINT_CLEANUP_COMPILATION_POLICY)) {
-      const char* name = "compilation policy safepoint handler";
-      EventSafepointCleanupTask event;
-      TraceTime timer(name, TRACETIME_LOG(Info, safepoint, cleanup));
+      SafepointCleanupTaskMark mark(SafepointSynchronize::SAFEPOINT_CLEANUP_COMPILATION_POLICY, safepoint_id);
       CompilationPolicy::policy()->do_safepoint_work();
-
-      post_safepoint_cleanup_task_event(event, safepoint_id, name);
     }
 
     if (_subtasks.try_claim_task(SafepointSynchronize::SAFEPOINT_CLEANUP_SYMBOL_TABLE_REHASH)) {
       if (SymbolTable::needs_rehashing()) {
-        const char* name = "rehashing symbol table";
-        EventSafepointCleanupTask event;
-        TraceTime timer(name, TRACETIME_LOG(Info, safepoint, cleanup));
+        SafepointCleanupTaskMark mark(SafepointSynchronize::SAFEPOINT_CLEANUP_SYMBOL_TABLE_REHASH, safepoint_id);
         SymbolTable::rehash_table();
-
-        post_safepoint_cleanup_task_event(event, safepoint_id, name);
       }
     }
 
     if (_subtasks.try_claim_task(SafepointSynchronize::SAFEPOINT_CLEANUP_STRING_TABLE_REHASH)) {
       if (StringTable::needs_rehashing()) {
-        const char* name = "rehashing string table";
-        EventSafepointCleanupTask event;
-        TraceTime timer(name, TRACETIME_LOG(Info, safepoint, cleanup));
+        SafepointCleanupTaskMark mark(SafepointSynchronize::SAFEPOINT_CLEANUP_STRING_TABLE_REHASH, safepoint_id);
         StringTable::rehash_table();
-
-        post_safepoint_cleanup_task_event(event, safepoint_id, name);
       }
     }
 
     if (_subtasks.try_claim_task(SafepointSynchronize::SAFEPOINT_CLEANUP_CLD_PURGE)) {
       // CMS delays purging the CLDG until the beginning of the next safepoint and to
       // make sure concurrent sweep is done
-      const char* name = "purging class loader data graph";
-      EventSafepointCleanupTask event;
-      TraceTime timer(name, TRACETIME_LOG(Info, safepoint, cleanup));
+      SafepointCleanupTaskMark mark(SafepointSynchronize::SAFEPOINT_CLEANUP_CLD_PURGE, safepoint_id);
       ClassLoaderDataGraph::purge_if_needed();
-
-      post_safepoint_cleanup_task_event(event, safepoint_id, name);
     }
 
-    if (_subtasks.try_claim_task(SafepointSynchronize::SAFEPOINT_CLEANUP_SYSTEM_DICTIONARY_RESIZE)) {
-      const char* name = "resizing system dictionaries";
-      EventSafepointCleanupTask event;
-      TraceTime timer(name, TRACETIME_LOG(Info, safepoint, cleanup));
-      ClassLoaderDataGraph::resize_if_needed();
-
-      post_safepoint_cleanup_task_event(event, safepoint_id, name);
-    }
+    // All threads deflate monitors and mark nmethods (if necessary).
+    Threads::possibly_parallel_threads_do(true, &_cleanup_threads_cl);
 
     _subtasks.all_tasks_completed(_num_workers);
   }
@@ -907,6 +929,82 @@ void SafepointSynchronize::print_safepoint_timeout() {
   }
 }
 
+// Fetches the pc of a thread while it is briefly suspended.
+class StragglerPcSampler : public os::SuspendedThreadTask {
+private:
+  address _pc;
+public:
+  StragglerPcSampler(JavaThread* thread) : os::SuspendedThreadTask(thread), _pc(NULL) {}
+
+  void do_task(const os::SuspendedThreadTaskContext& context) {
+    // Only read the context here, the thread may hold arbitrary locks
+    frame fr = os::fetch_frame_from_context(context.ucontext());
+    _pc = fr.pc();
+  }
+
+  address pc() const { return _pc; }
+};
+
+// Report the threads still running Java code after SafepointStragglerSampleDelay,
+// attributing their pc to an nmethod and the nearest bci so that loops without
+// safepoint polls can be located.
+void SafepointSynchronize::sample_stragglers(ThreadSafepointState* tss_head) {
+  ResourceMark rm;
+  for (ThreadSafepointState* cur_tss = tss_head; cur_tss != NULL; cur_tss = cur_tss->get_next()) {
+    JavaThread* thread = cur_tss->thread();
+    if (thread->thread_state() != _thread_in_Java) {
+      log_info(safepoint)("Safepoint straggler: thread \"%s\" in state %d",
+                          thread->get_thread_name(), thread->thread_state());
+      continue;
+    }
+
+    StragglerPcSampler sampler(thread);
+    sampler.run();
+    address pc = sampler.pc();
+    if (pc == NULL) {
+      continue;
+    }
+
+    Method* method = NULL;
+    int compile_id = -1;
+    int bci = InvocationEntryBci;
+    {
+      // Keep the sweeper from flushing the nmethod while it is inspected
+      MutexLockerEx ml(CodeCache_lock, Mutex::_no_safepoint_check_flag);
+      CodeBlob* cb = CodeCache::find_blob_unsafe(pc);
+      if (cb != NULL && cb->is_nmethod()) {
+        nmethod* nm = cb->as_nmethod();
+        method = nm->method();
+        compile_id = nm->compile_id();
+        PcDesc* pd = nm->pc_desc_near(pc);
+        if (pd != NULL) {
+          bci = pd->scope_decode_offset() == DebugInformationRecorder::serialized_null ?
+                InvocationEntryBci : nm->scope_desc_at(pd->real_pc(nm))->bci();
+        }
+        log_info(safepoint)("Safepoint straggler: thread \"%s\" pc " INTPTR_FORMAT
+                            " in nmethod %d %s at bci %d",
+                            thread->get_thread_name(), p2i(pc), compile_id,
+                            method->name_and_sig_as_C_string(), bci);
+      } else {
+        log_info(safepoint)("Safepoint straggler: thread \"%s\" pc " INTPTR_FORMAT " in %s",
+                            thread->get_thread_name(), p2i(pc),
+                            cb != NULL ? cb->name() : "unknown code");
+      }
+
+      EventSafepointStraggler event;
+      if (event.should_commit()) {
+        event.set_safepointId(safepoint_counter());
+        event.set_straggler(JFR_THREAD_ID(thread));
+        event.set_pc((u8)p2i(pc));
+        event.set_method(method);
+        event.set_compileId(compile_id);
+        event.set_bci(bci);
+        event.commit();
+      }
+    }
+  }
+}
+
 // -------------------------------------------------------------------------------------------------------
 // Implementation of ThreadSafepointState
 
@@ -1129,6 +1227,10 @@ VM_Operation::VMOp_Type SafepointTracing::_current_type;
 jlong     SafepointTracing::_max_sync_time = 0;
 jlong     SafepointTracing::_max_vmop_time = 0;
 uint64_t  SafepointTracing::_op_count[VM_Operation::VMOp_Terminating] = {0};
+jlong     SafepointTracing::_cleanup_task_last_ns[SafepointSynchronize::SAFEPOINT_CLEANUP_NUM_TASKS] = {0};
+jlong     SafepointTracing::_cleanup_task_max_ns[SafepointSynchronize::SAFEPOINT_CLEANUP_NUM_TASKS] = {0};
+jlong     SafepointTracing::_cleanup_task_total_ns[SafepointSynchronize::SAFEPOINT_CLEANUP_NUM_TASKS] = {0};
+uint64_t  SafepointTracing::_cleanup_task_count[SafepointSynchronize::SAFEPOINT_CLEANUP_NUM_TASKS] = {0};
 
 void SafepointTracing::init() {
   // Application start
@@ -1179,6 +1281,18 @@ void SafepointTracing::statistics_log() {
            (int64_t)(_last_safepoint_end_time_ns - _last_safepoint_begin_time_ns));
 
   ls.print_cr(INT32_FORMAT_W(16), _page_trap);
+
+  // Per-task breakdown of the cleanup phase of this safepoint
+  LogTarget(Debug, safepoint, stats) lt_debug;
+  if (lt_debug.is_enabled()) {
+    LogStream ls_debug(lt_debug);
+    for (int i = 0; i < SafepointSynchronize::SAFEPOINT_CLEANUP_NUM_TASKS; i++) {
+      if (_cleanup_task_last_ns[i] != 0) {
+        ls_debug.print_cr("  %-38s " INT64_FORMAT_W(10) " ns", cleanup_task_names[i],
+                          (int64_t)_cleanup_task_last_ns[i]);
+      }
+    }
+  }
 }
 
 // This method will be called when VM exits. This tries to summarize the sampling.
@@ -1194,6 +1308,15 @@ void SafepointTracing::statistics_exit_log() {
     }
   }
 
+  for (int i = 0; i < SafepointSynchronize::SAFEPOINT_CLEANUP_NUM_TASKS; i++) {
+    if (_cleanup_task_count[i] != 0) {
+      log_info(safepoint, stats)("Cleanup task %-38s count " UINT64_FORMAT_W(8)
+                                 " total " INT64_FORMAT_W(12) " ns max " INT64_FORMAT_W(10) " ns",
+                                 cleanup_task_names[i], _cleanup_task_count[i],
+                                 (int64_t)_cleanup_task_total_ns[i], (int64_t)_cleanup_task_max_ns[i]);
+    }
+  }
+
   log_info(safepoint, stats)("VM operations coalesced during safepoint " INT64_FORMAT,
                               VMThread::get_coalesced_count());
   log_info(safepoint, stats)("Maximum sync time  " INT64_FORMAT" ns",
@@ -1211,6 +1334,9 @@ void SafepointTracing::begin(VM_Operation::VMOp_Type type) {
   _last_safepoint_begin_time_ns = os::javaTimeNanos();
   _last_safepoint_sync_time_ns = 0;
   _last_safepoint_cleanup_time_ns = 0;
+  for (int i = 0; i < SafepointSynchronize::SAFEPOINT_CLEANUP_NUM_TASKS; i++) {
+    _cleanup_task_last_ns[i] = 0;
+  }
 
   _last_app_time_ns = _last_safepoint_begin_time_ns - _last_safepoint_end_time_ns;
   _last_safepoint_end_time_ns = 0;
@@ -1230,6 +1356,15 @@ void SafepointTracing::cleanup() {
   _last_safepoint_cleanup_time_ns = os::javaTimeNanos();
 }
 
+// Each task is claimed by a single worker per safepoint, so the
+// per-task slots are not updated concurrently.
+void SafepointTracing::cleanup_task(SafepointSynchronize::SafepointCleanupTasks task, jlong time_ns) {
+  _cleanup_task_last_ns[task] = time_ns;
+  _cleanup_task_total_ns[task] += time_ns;
+  _cleanup_task_max_ns[task] = MAX2(_cleanup_task_max_ns[task], time_ns);
+  _cleanup_task_count[task]++;
+}
+
 void SafepointTracing::end() {
   _last_safepoint_end_time_ns = os::javaTimeNanos();
 
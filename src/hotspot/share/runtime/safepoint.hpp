@@ -68,7 +68,6 @@ class SafepointSynchronize : AllStatic {
     SAFEPOINT_CLEANUP_SYMBOL_TABLE_REHASH,
     SAFEPOINT_CLEANUP_STRING_TABLE_REHASH,
     SAFEPOINT_CLEANUP_CLD_PURGE,
-    SAFEPOINT_CLEANUP_SYSTEM_DICTIONARY_RESIZE,
     // Leave this one last.
     SAFEPOINT_CLEANUP_NUM_TASKS
   };
@@ -107,6 +106,7 @@ class SafepointSynchronize : AllStatic {
 
   // For debug long safepoint
   static void print_safepoint_timeout();
+  static void sample_stragglers(ThreadSafepointState* tss_head);
 
   // Helper methods for safepoint procedure:
   static void arm_safepoint();
@@ -252,6 +252,12 @@ private:
   static jlong     _max_vmop_time;
   static uint64_t  _op_count[VM_Operation::VMOp_Terminating];
 
+  // Cleanup task timings: of the current safepoint, and accumulated
+  static jlong     _cleanup_task_last_ns[SafepointSynchronize::SAFEPOINT_CLEANUP_NUM_TASKS];
+  static jlong     _cleanup_task_max_ns[SafepointSynchronize::SAFEPOINT_CLEANUP_NUM_TASKS];
+  static jlong     _cleanup_task_total_ns[SafepointSynchronize::SAFEPOINT_CLEANUP_NUM_TASKS];
+  static uint64_t  _cleanup_task_count[SafepointSynchronize::SAFEPOINT_CLEANUP_NUM_TASKS];
+
   static void statistics_log();
 
 public:
@@ -260,6 +266,7 @@ public:
   static void begin(VM_Operation::VMOp_Type type);
   static void synchronized(int nof_threads, int nof_running, int traps);
   static void cleanup();
+  static void cleanup_task(SafepointSynchronize::SafepointCleanupTasks task, jlong time_ns);
   static void end();
 
   static void statistics_exit_log();
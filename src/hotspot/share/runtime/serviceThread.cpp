@@ -23,6 +23,8 @@
  */
 
 #include "precompiled.hpp"
+#include "classfile/classLoaderDataGraph.hpp"
+#include "classfile/dictionary.hpp"
 #include "classfile/protectionDomainCache.hpp"
 #include "classfile/stringTable.hpp"
 #include "classfile/symbolTable.hpp"
@@ -35,6 +37,7 @@
 #include "runtime/mutexLocker.hpp"
 #include "runtime/os.hpp"
 #include "prims/jvmtiImpl.hpp"
+#include "prims/jvmtiTagMap.hpp"
 #include "prims/resolvedMethodTable.hpp"
 #include "services/diagnosticArgument.hpp"
 #include "services/diagnosticFramework.hpp"
@@ -118,12 +121,14 @@ void ServiceThread::service_thread_entry(JavaThread* jt, TRAPS) {
   while (true) {
     bool sensors_changed = false;
     bool has_jvmti_events = false;
+    bool has_jvmti_object_free_events = false;
     bool has_gc_notification_event = false;
     bool has_dcmd_notification_event = false;
     bool stringtable_work = false;
     bool symboltable_work = false;
     bool resolved_method_table_work = false;
     bool protection_domain_table_work = false;
+    bool dictionary_resize_work = false;
     bool oopstorage_work = false;
     bool oopstorages_cleanup[oopstorage_count] = {}; // Zero (false) initialize.
     JvmtiDeferredEvent jvmti_event;
@@ -145,12 +150,14 @@ void ServiceThread::service_thread_entry(JavaThread* jt, TRAPS) {
       // arithmetic-or to combine results; we don't want short-circuiting.
       while (((sensors_changed = LowMemoryDetector::has_pending_requests()) |
               (has_jvmti_events = JvmtiDeferredEventQueue::has_events()) |
+              (has_jvmti_object_free_events = JvmtiTagMap::has_object_free_events_and_reset()) |
               (has_gc_notification_event = GCNotifier::has_event()) |
               (has_dcmd_notification_event = DCmdFactory::has_pending_jmx_notification()) |
               (stringtable_work = StringTable::has_work()) |
               (symboltable_work = SymbolTable::has_work()) |
               (resolved_method_table_work = ResolvedMethodTable::has_work()) |
               (protection_domain_table_work = SystemDictionary::pd_cache_table()->has_work()) |
+              (dictionary_resize_work = Dictionary::does_any_dictionary_needs_resizing()) |
               (oopstorage_work = needs_oopstorage_cleanup(oopstorages,
                                                           oopstorages_cleanup,
                                                           oopstorage_count)))
@@ -177,6 +184,10 @@ void ServiceThread::service_thread_entry(JavaThread* jt, TRAPS) {
       jvmti_event.post();
     }
 
+    if (has_jvmti_object_free_events) {
+      JvmtiTagMap::flush_object_free_events();
+    }
+
     if (sensors_changed) {
       LowMemoryDetector::process_sensor_changes(jt);
     }
@@ -197,6 +208,10 @@ void ServiceThread::service_thread_entry(JavaThread* jt, TRAPS) {
       SystemDictionary::pd_cache_table()->unlink();
     }
 
+    if (dictionary_resize_work) {
+      ClassLoaderDataGraph::resize_dictionaries(jt);
+    }
+
     if (oopstorage_work) {
       cleanup_oopstorages(oopstorages, oopstorages_cleanup, oopstorage_count);
     }
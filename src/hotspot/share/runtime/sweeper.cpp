@@ -158,6 +158,7 @@ int    NMethodSweeper::_hotness_counter_reset_val       = 0;
 
 long   NMethodSweeper::_total_nof_methods_reclaimed     = 0;   // Accumulated nof methods flushed
 long   NMethodSweeper::_total_nof_c2_methods_reclaimed  = 0;   // Accumulated nof methods flushed
+long   NMethodSweeper::_total_nof_methods_made_not_entrant = 0; // Accumulated nof cold methods made not-entrant
 size_t NMethodSweeper::_total_flushed_size              = 0;   // Total number of bytes flushed from the code cache
 Tickspan NMethodSweeper::_total_time_sweeping;                 // Accumulated time sweeping
 Tickspan NMethodSweeper::_total_time_this_sweep;               // Total time this sweep
@@ -487,7 +488,10 @@ static void post_sweep_event(EventSweepCodeCache* event,
                              s4 traversals,
                              int swept,
                              int flushed,
-                             int zombified) {
+                             int zombified,
+                             int not_entrant,
+                             size_t reclaimed,
+                             int max_cold_age) {
   assert(event != NULL, "invariant");
   assert(event->should_commit(), "invariant");
   event->set_starttime(start);
@@ -496,6 +500,9 @@ static void post_sweep_event(EventSweepCodeCache* event,
   event->set_sweptCount(swept);
   event->set_flushedCount(flushed);
   event->set_zombifiedCount(zombified);
+  event->set_notEntrantCount(not_entrant);
+  event->set_reclaimedSize(reclaimed);
+  event->set_maxColdAge(max_cold_age);
   event->commit();
 }
 
@@ -508,6 +515,8 @@ void NMethodSweeper::sweep_code_cache() {
   int flushed_count                = 0;
   int zombified_count              = 0;
   int flushed_c2_count     = 0;
+  int not_entrant_count            = 0;
+  int max_cold_age                 = 0;
 
   if (PrintMethodFlushing && Verbose) {
     tty->print_cr("### Sweep at %d out of %d", _seen, CodeCache::nmethod_count());
@@ -552,6 +561,12 @@ void NMethodSweeper::sweep_code_cache() {
               ++flushed_c2_count;
             }
             break;
+          case MadeNotEntrant:
+            state_after = "made not entrant";
+            ++not_entrant_count;
+            // The age is the number of sweeps since the method was last seen on stack
+            max_cold_age = MAX2(max_cold_age, hotness_counter_reset_val() - ((nmethod*)nm)->hotness_counter());
+            break;
           case MadeZombie:
             state_after = "made zombie";
             ++zombified_count;
@@ -583,12 +598,14 @@ void NMethodSweeper::sweep_code_cache() {
     _total_flushed_size += freed_memory;
     _total_nof_methods_reclaimed += flushed_count;
     _total_nof_c2_methods_reclaimed += flushed_c2_count;
+    _total_nof_methods_made_not_entrant += not_entrant_count;
     _peak_sweep_time = MAX2(_peak_sweep_time, _total_time_this_sweep);
   }
 
   EventSweepCodeCache event(UNTIMED);
   if (event.should_commit()) {
-    post_sweep_event(&event, sweep_start_counter, sweep_end_counter, (s4)_traversals, swept_count, flushed_count, zombified_count);
+    post_sweep_event(&event, sweep_start_counter, sweep_end_counter, (s4)_traversals, swept_count, flushed_count, zombified_count,
+                     not_entrant_count, freed_memory, max_cold_age);
   }
 
 #ifdef ASSERT
@@ -737,8 +754,8 @@ NMethodSweeper::MethodStateChange NMethodSweeper::process_compiled_method(Compil
       result = MadeZombie;
     }
   } else {
-    if (cm->is_nmethod()) {
-      possibly_flush((nmethod*)cm);
+    if (cm->is_nmethod() && possibly_flush((nmethod*)cm)) {
+      result = MadeNotEntrant;
     }
     // Clean inline caches that point to zombie/non-entrant/unloaded nmethods
     cm->cleanup_inline_caches(false);
@@ -748,7 +765,8 @@ NMethodSweeper::MethodStateChange NMethodSweeper::process_compiled_method(Compil
 }
 
 
-void NMethodSweeper::possibly_flush(nmethod* nm) {
+// Returns true if the nmethod was made not-entrant because it is cold.
+bool NMethodSweeper::possibly_flush(nmethod* nm) {
   if (UseCodeCacheFlushing) {
     if (!nm->is_locked_by_vm() && !nm->is_native_method() && !nm->is_not_installed() && !nm->is_unloading()) {
       bool make_not_entrant = false;
@@ -825,9 +843,11 @@ void NMethodSweeper::possibly_flush(nmethod* nm) {
           tty->print_cr("### Nmethod %d/" PTR_FORMAT "made not-entrant: hotness counter %d/%d threshold %f",
               nm->compile_id(), p2i(nm), nm->hotness_counter(), reset_val, threshold);
         }
+        return true;
       }
     }
   }
+  return false;
 }
 
 // Print out some state information about the current sweep and the
@@ -881,4 +901,5 @@ void NMethodSweeper::print(outputStream* out) {
   out->print_cr("  Total number of flushed methods: %ld (thereof %ld C2 methods)", _total_nof_methods_reclaimed,
                                                     _total_nof_c2_methods_reclaimed);
   out->print_cr("  Total size of flushed methods:   " SIZE_FORMAT " kB", _total_flushed_size/K);
+  out->print_cr("  Total number of cold methods made not entrant: %ld", _total_nof_methods_made_not_entrant);
 }
@@ -61,6 +61,7 @@ class NMethodSweeper : public AllStatic {
  private:
   enum MethodStateChange {
     None,
+    MadeNotEntrant,
     MadeZombie,
     Flushed
   };
@@ -80,6 +81,7 @@ class NMethodSweeper : public AllStatic {
   // Stat counters
   static long      _total_nof_methods_reclaimed;    // Accumulated nof methods flushed
   static long      _total_nof_c2_methods_reclaimed; // Accumulated nof C2-compiled methods flushed
+  static long      _total_nof_methods_made_not_entrant; // Accumulated nof cold methods made not-entrant
   static size_t    _total_flushed_size;             // Total size of flushed methods
   static int       _hotness_counter_reset_val;
 
@@ -122,7 +124,7 @@ class NMethodSweeper : public AllStatic {
   static int hotness_counter_reset_val();
   static void report_state_change(nmethod* nm);
   static void possibly_enable_sweeper();
-  static void possibly_flush(nmethod* nm);
+  static bool possibly_flush(nmethod* nm);
   static void print(outputStream* out);   // Printing/debugging
   static void print() { print(tty); }
 };
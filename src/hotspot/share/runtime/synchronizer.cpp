@@ -554,6 +554,7 @@ struct SharedGlobals {
 static SharedGlobals GVars;
 static int MonitorScavengeThreshold = 1000000;
 static volatile int ForceMonitorScavenge = 0; // Scavenge required and pending
+static jlong LastDeflationTime = 0;           // os::javaTimeNanos() of the last deflation
 
 static markOop ReadStableMark(oop obj) {
   markOop mark = obj->mark();
@@ -748,15 +749,21 @@ intptr_t ObjectSynchronizer::FastHashCode(Thread * Self, oop obj) {
     if (hash != 0) {                  // header contains hash code
       return hash;
     }
-    // WARNING:
-    //   The displaced header is strictly immutable.
-    // It can NOT be changed in ANY cases. So we have
-    // to inflate the header into heavyweight monitor
-    // even the current thread owns the lock. The reason
-    // is the BasicLock (stack slot) will be asynchronously
-    // read by other threads during the inflate() function.
-    // Any change to stack may not propagate to other threads
-    // correctly.
+    // The BasicLock (stack slot) may be read asynchronously by another
+    // thread inflating the monitor. That thread first CASes the mark
+    // word to INFLATING and only then loads the displaced header. So
+    // store the hash into the displaced header and re-check the mark
+    // word behind a full fence: if it still points at our BasicLock,
+    // any later inflation is guaranteed to see the hash. Otherwise
+    // the hash may or may not have been copied into the monitor and
+    // we resolve it below, against the inflated monitor header.
+    BasicLock* lock = mark->locker();
+    hash = get_next_hash(Self, obj);
+    lock->set_displaced_header(temp->copy_set_hash(hash));
+    OrderAccess::fence();
+    if (obj->mark() == mark) {
+      return hash;
+    }
   }
 
   // Inflate the monitor to set hash code
@@ -1596,16 +1603,34 @@ int ObjectSynchronizer::deflate_monitor_list(ObjectMonitor** listHeadp,
   return deflated_count;
 }
 
+// Deflation walks every in-use monitor, so with a large monitor population
+// it dominates the safepoint cleanup time. MonitorDeflationInterval lets
+// safepoints skip it unless enough time has passed or monitors are needed.
+static bool should_deflate_idle_monitors() {
+  if (MonitorDeflationInterval == 0 || ForceMonitorScavenge != 0) {
+    return true;
+  }
+  if (MonitorUsedDeflationThreshold > 0 && monitors_used_above_threshold()) {
+    return true;
+  }
+  jlong elapsed = os::javaTimeNanos() - LastDeflationTime;
+  return elapsed >= MonitorDeflationInterval * NANOSECS_PER_MILLISEC;
+}
+
 void ObjectSynchronizer::prepare_deflate_idle_monitors(DeflateMonitorCounters* counters) {
   counters->nInuse = 0;              // currently associated with objects
   counters->nInCirculation = 0;      // extant
   counters->nScavenged = 0;          // reclaimed (global and per-thread)
   counters->perThreadScavenged = 0;  // per-thread scavenge total
   counters->perThreadTimes = 0.0;    // per-thread scavenge times
+  counters->deflate = should_deflate_idle_monitors();
 }
 
 void ObjectSynchronizer::deflate_idle_monitors(DeflateMonitorCounters* counters) {
   assert(SafepointSynchronize::is_at_safepoint(), "must be at safepoint");
+  if (!counters->deflate) {
+    return;
+  }
   bool deflated = false;
 
   ObjectMonitor * freeHeadp = NULL;  // Local SLL of scavenged monitors
@@ -1659,6 +1684,14 @@ void ObjectSynchronizer::deflate_idle_monitors(DeflateMonitorCounters* counters)
 }
 
 void ObjectSynchronizer::finish_deflate_idle_monitors(DeflateMonitorCounters* counters) {
+  if (!counters->deflate) {
+    log_debug(monitorinflation)("deflation of idle monitors deferred");
+    GVars.stwRandom = os::random();
+    GVars.stwCycle++;
+    return;
+  }
+  LastDeflationTime = os::javaTimeNanos();
+
   // Report the cumulative time for deflating each thread's idle
   // monitors. Note: if the work is split among more than one
   // worker thread, then the reported time will likely be more
@@ -1696,6 +1729,9 @@ void ObjectSynchronizer::finish_deflate_idle_monitors(DeflateMonitorCounters* co
 
 void ObjectSynchronizer::deflate_thread_local_monitors(Thread* thread, DeflateMonitorCounters* counters) {
   assert(SafepointSynchronize::is_at_safepoint(), "must be at safepoint");
+  if (!counters->deflate) {
+    return;
+  }
 
   ObjectMonitor * freeHeadp = NULL;  // Local SLL of scavenged monitors
   ObjectMonitor * freeTailp = NULL;
@@ -40,6 +40,7 @@ struct DeflateMonitorCounters {
   int nScavenged;          // reclaimed (global and per-thread)
   int perThreadScavenged;  // per-thread scavenge total
   double perThreadTimes;   // per-thread scavenge times
+  bool deflate;            // deflate idle monitors at this safepoint
 };
 
 class ObjectSynchronizer : AllStatic {
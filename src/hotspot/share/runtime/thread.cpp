@@ -25,6 +25,7 @@
 #include "precompiled.hpp"
 #include "jvm.h"
 #include "classfile/classLoader.hpp"
+#include "classfile/classPreloader.hpp"
 #include "classfile/javaClasses.hpp"
 #include "classfile/moduleEntry.hpp"
 #include "classfile/systemDictionary.hpp"
@@ -43,9 +44,11 @@
 #include "jfr/jfrEvents.hpp"
 #include "jvmtifiles/jvmtiEnv.hpp"
 #include "logging/log.hpp"
+#include "logging/logAsyncWriter.hpp"
 #include "logging/logConfiguration.hpp"
 #include "logging/logStream.hpp"
 #include "memory/allocation.inline.hpp"
+#include "memory/arena.hpp"
 #include "memory/metaspaceShared.hpp"
 #include "memory/oopFactory.hpp"
 #include "memory/resourceArea.hpp"
@@ -115,6 +118,7 @@
 #include "utilities/macros.hpp"
 #include "utilities/preserveException.hpp"
 #include "utilities/singleWriterSynchronizer.hpp"
+#include "utilities/systemMemoryBarrier.hpp"
 #include "utilities/vmError.hpp"
 #if INCLUDE_JVMCI
 #include "jvmci/jvmciCompiler.hpp"
@@ -175,8 +179,8 @@ void* Thread::allocate(size_t size, bool throw_excpt, MEMFLAGS flags) {
   if (UseBiasedLocking) {
     const int alignment = markOopDesc::biased_lock_alignment;
     size_t aligned_size = size + (alignment - sizeof(intptr_t));
-    void* real_malloc_addr = throw_excpt? AllocateHeap(aligned_size, flags, CURRENT_PC)
-                                          : AllocateHeap(aligned_size, flags, CURRENT_PC,
+    void* real_malloc_addr = throw_excpt? AllocateHeap(aligned_size, flags, SAMPLED_CURRENT_PC)
+                                          : AllocateHeap(aligned_size, flags, SAMPLED_CURRENT_PC,
                                                          AllocFailStrategy::RETURN_NULL);
     void* aligned_addr     = align_up(real_malloc_addr, alignment);
     assert(((uintptr_t) aligned_addr + (uintptr_t) size) <=
@@ -190,8 +194,8 @@ void* Thread::allocate(size_t size, bool throw_excpt, MEMFLAGS flags) {
     ((Thread*) aligned_addr)->_real_malloc_address = real_malloc_addr;
     return aligned_addr;
   } else {
-    return throw_excpt? AllocateHeap(size, flags, CURRENT_PC)
-                       : AllocateHeap(size, flags, CURRENT_PC, AllocFailStrategy::RETURN_NULL);
+    return throw_excpt? AllocateHeap(size, flags, SAMPLED_CURRENT_PC)
+                       : AllocateHeap(size, flags, SAMPLED_CURRENT_PC, AllocFailStrategy::RETURN_NULL);
   }
 }
 
@@ -229,10 +233,11 @@ Thread::Thread() {
 
   // allocated data structures
   set_osthread(NULL);
+  _chunk_cache = NULL;
   set_resource_area(new (mtThread)ResourceArea());
   DEBUG_ONLY(_current_resource_mark = NULL;)
   set_handle_area(new (mtThread) HandleArea(NULL));
-  set_metadata_handles(new (ResourceObj::C_HEAP, mtClass) GrowableArray<Metadata*>(30, true));
+  set_metadata_handles(NULL);
   set_active_handles(NULL);
   set_free_handle_block(NULL);
   set_last_handle_mark(NULL);
@@ -462,7 +467,15 @@ Thread::~Thread() {
   ParkEvent::Release(_MuxEvent); _MuxEvent    = NULL;
 
   delete handle_area();
-  delete metadata_handles();
+  delete _metadata_handles;
+
+  // Return the cached chunks to the global pools, chunks freed after this
+  // go to the pools directly.
+  if (_chunk_cache != NULL) {
+    ChunkCache* cache = _chunk_cache;
+    _chunk_cache = NULL;
+    delete cache;
+  }
 
   // SR_handler uses this as a termination indicator -
   // needs to happen before os::free_thread()
@@ -659,6 +672,13 @@ bool JavaThread::is_ext_suspend_completed(bool called_by_wait, int delay,
     // copy. This closes the race where the thread state is seen as
     // _thread_in_native_trans in the if-thread_blocked check, but is
     // seen as _thread_blocked in if-thread_in_native_trans check.
+    //
+    // Pairs with is_suspend_after_native() in the target's transition
+    // from native; with UseSystemMemoryBarrier that transition doesn't
+    // fence, so make our suspend request and its state visible first.
+    if (UseSystemMemoryBarrier) {
+      SystemMemoryBarrier::emit();
+    }
     JavaThreadState save_state = thread_state();
 
     if (save_state == _thread_blocked && is_suspend_equivalent()) {
@@ -910,11 +930,15 @@ void Thread::oops_do(OopClosure* f, CodeBlobClosure* cf) {
   ObjectSynchronizer::thread_local_used_oops_do(this, f);
 }
 
+GrowableArray<Metadata*>* Thread::create_metadata_handles() {
+  return new (ResourceObj::C_HEAP, mtClass) GrowableArray<Metadata*>(30, true);
+}
+
 void Thread::metadata_handles_do(void f(Metadata*)) {
   // Only walk the Handles in Thread.
-  if (metadata_handles() != NULL) {
-    for (int i = 0; i< metadata_handles()->length(); i++) {
-      f(metadata_handles()->at(i));
+  if (_metadata_handles != NULL) {
+    for (int i = 0; i< _metadata_handles->length(); i++) {
+      f(_metadata_handles->at(i));
     }
   }
 }
@@ -1636,6 +1660,7 @@ void JavaThread::initialize() {
   _is_method_handle_return = 0;
   _jvmti_thread_state= NULL;
   _should_post_on_exceptions_flag = JNI_FALSE;
+  _profile_sample_seed = (juint)os::random();
   _interp_only_mode    = 0;
   _special_runtime_exit_condition = _no_async_condition;
   _pending_async_exception = NULL;
@@ -3408,6 +3433,10 @@ CompilerThread::CompilerThread(CompileQueue* queue,
   // Compiler uses resource area for compilation, let's bias it to mtCompiler
   resource_area()->bias_to(mtCompiler);
 
+  // Compilations create and destroy arenas at a high rate, keep some of
+  // their chunks in the thread instead of the global chunk pools
+  _chunk_cache = new ChunkCache();
+
 #ifndef PRODUCT
   _ideal_graph_printer = NULL;
 #endif
@@ -3741,6 +3770,16 @@ jint Threads::create_vm(JavaVMInitArgs* args, bool* canTryAgain) {
 
   SafepointMechanism::initialize();
 
+  // Must come before any native wrapper or the interpreter is generated,
+  // as those omit their fence when the system memory barrier is used.
+  if (UseSystemMemoryBarrier) {
+    if (!SystemMemoryBarrier::initialize()) {
+      vm_shutdown_during_initialization("Failed to initialize the requested system memory barrier synchronization.");
+      return JNI_EINVAL;
+    }
+    log_debug(os)("Using experimental system memory barrier synchronization");
+  }
+
   jint adjust_after_os_result = Arguments::adjust_after_os();
   if (adjust_after_os_result != JNI_OK) return adjust_after_os_result;
 
@@ -3800,7 +3839,10 @@ jint Threads::create_vm(JavaVMInitArgs* args, bool* canTryAgain) {
   ObjectMonitor::Initialize();
 
   // Initialize global modules
-  jint status = init_globals();
+  jint status;
+  { TraceTime timer("Initialize global modules", TRACETIME_LOG(Info, startuptime));
+    status = init_globals();
+  }
   if (status != JNI_OK) {
     main_thread->smr_delete();
     *canTryAgain = false; // don't let caller call JNI_CreateJavaVM again
@@ -3880,6 +3922,7 @@ jint Threads::create_vm(JavaVMInitArgs* args, bool* canTryAgain) {
   set_init_completed();
 
   LogConfiguration::post_initialize();
+  AsyncLogWriter::initialize();
   Metaspace::post_initialize();
 
   HOTSPOT_VM_INIT_END();
@@ -4003,6 +4046,10 @@ jint Threads::create_vm(JavaVMInitArgs* args, bool* canTryAgain) {
 
   BiasedLocking::init();
 
+  if (PreloadClassList != NULL && !DumpSharedSpaces) {
+    ClassPreloader::start(CHECK_JNI_ERR);
+  }
+
 #if INCLUDE_RTM_OPT
   RTMLockingCounters::init();
 #endif
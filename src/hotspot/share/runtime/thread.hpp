@@ -75,6 +75,7 @@ class CompileLog;
 class CompileTask;
 class CompileQueue;
 class CompilerCounters;
+class ChunkCache;
 
 class vframeArray;
 class vframe;
@@ -577,6 +578,9 @@ class Thread: public ThreadShadow {
   ResourceArea* resource_area() const            { return _resource_area; }
   void set_resource_area(ResourceArea* area)     { _resource_area = area; }
 
+  // Arena chunk cache, NULL unless the thread caches chunks
+  ChunkCache* chunk_cache() const                { return _chunk_cache; }
+
   OSThread* osthread() const                     { return _osthread;   }
   void set_osthread(OSThread* thread)            { _osthread = thread; }
 
@@ -590,7 +594,13 @@ class Thread: public ThreadShadow {
   HandleArea* handle_area() const                { return _handle_area; }
   void set_handle_area(HandleArea* area)         { _handle_area = area; }
 
-  GrowableArray<Metadata*>* metadata_handles() const          { return _metadata_handles; }
+  // Allocated on first use since many threads never create a metadata handle
+  GrowableArray<Metadata*>* metadata_handles() {
+    if (_metadata_handles == NULL) {
+      _metadata_handles = create_metadata_handles();
+    }
+    return _metadata_handles;
+  }
   void set_metadata_handles(GrowableArray<Metadata*>* handles){ _metadata_handles = handles; }
 
   // Thread-Local Allocation Buffer (TLAB) support
@@ -692,11 +702,15 @@ protected:
   // Thread local resource area for temporary allocation within the VM
   ResourceArea* _resource_area;
 
+  // Thread local cache of arena chunks, see ChunkCache
+  ChunkCache* _chunk_cache;
+
   DEBUG_ONLY(ResourceMark* _current_resource_mark;)
 
   // Thread local handle area for allocation of handles within the VM
   HandleArea* _handle_area;
   GrowableArray<Metadata*>* _metadata_handles;
+  static GrowableArray<Metadata*>* create_metadata_handles();
 
   // Support for stack overflow handling, get_thread, etc.
   address          _stack_base;
@@ -1795,6 +1809,7 @@ class JavaThread: public Thread {
   static ByteSize should_post_on_exceptions_flag_offset() {
     return byte_offset_of(JavaThread, _should_post_on_exceptions_flag);
   }
+  static ByteSize profile_sample_seed_offset()   { return byte_offset_of(JavaThread, _profile_sample_seed); }
 
   // Returns the jni environment for this thread
   JNIEnv* jni_environment()                      { return &_jni_environment; }
@@ -2036,7 +2051,11 @@ class JavaThread: public Thread {
   int   should_post_on_exceptions_flag()  { return _should_post_on_exceptions_flag; }
   void  set_should_post_on_exceptions_flag(int val)  { _should_post_on_exceptions_flag = val; }
 
+  // State of the random number generator used by C1 code for sampled
+  // profile updates (see C1ProfileSampleLog)
  private:
+  juint  _profile_sample_seed;
+
   ThreadStatistics *_thread_stat;
 
  public:
@@ -118,6 +118,15 @@ volatile uint         ThreadsSMRSupport::_tlh_time_max = 0;
 // isn't available everywhere (or is it?).
 volatile uint         ThreadsSMRSupport::_tlh_times = 0;
 
+// # of hazard ptr scans done by free_list().
+uint                  ThreadsSMRSupport::_free_list_scan_cnt = 0;
+
+// Cumulative time in nanos spent in hazard ptr scans done by free_list().
+uint64_t              ThreadsSMRSupport::_free_list_scan_times = 0;
+
+// Max time in nanos spent in one hazard ptr scan done by free_list().
+uint64_t              ThreadsSMRSupport::_free_list_scan_time_max = 0;
+
 ThreadsList*          ThreadsSMRSupport::_to_delete_list = NULL;
 
 // # of parallel ThreadsLists on the to-delete list.
@@ -129,6 +138,10 @@ uint                  ThreadsSMRSupport::_to_delete_list_cnt = 0;
 // Impl note: See _to_delete_list_cnt note.
 uint                  ThreadsSMRSupport::_to_delete_list_max = 0;
 
+// # of ThreadsLists added to the _to_delete_list since the last hazard
+// ptr scan. Not a statistic; the scan is batched on this count.
+uint                  ThreadsSMRSupport::_to_delete_list_unscanned = 0;
+
 
 // 'inline' functions first so the definitions are before first use:
 
@@ -795,6 +808,16 @@ void ThreadsSMRSupport::free_list(ThreadsList* threads) {
     }
   }
 
+  // Scanning the hazard ptrs is linear in the number of threads, so
+  // batch the scans when threads come and go at a high rate.
+  if (++_to_delete_list_unscanned < ThreadSMRFreeListBatchSize) {
+    log_debug(thread, smr)("tid=" UINTX_FORMAT ": ThreadsSMRSupport::free_list: threads=" INTPTR_FORMAT " is deferred.", os::current_thread_id(), p2i(threads));
+    return;
+  }
+  _to_delete_list_unscanned = 0;
+
+  jlong scan_start = EnableThreadSMRStatistics ? os::javaTimeNanos() : 0;
+
   // Hash table size should be first power of two higher than twice the length of the ThreadsList
   int hash_table_size = MIN2((int)get_java_thread_list()->length(), 32) << 1;
   hash_table_size--;
@@ -849,6 +872,15 @@ void ThreadsSMRSupport::free_list(ThreadsList* threads) {
   }
 
   delete scan_table;
+
+  if (EnableThreadSMRStatistics) {
+    uint64_t scan_time = (uint64_t)(os::javaTimeNanos() - scan_start);
+    _free_list_scan_cnt++;
+    _free_list_scan_times += scan_time;
+    if (scan_time > _free_list_scan_time_max) {
+      _free_list_scan_time_max = scan_time;
+    }
+  }
 }
 
 // Return true if the specified JavaThread is protected by a hazard
@@ -1146,6 +1178,15 @@ void ThreadsSMRSupport::print_info_on(outputStream* st) {
                _delete_lock_wait_cnt, _delete_lock_wait_max);
   st->print_cr("_to_delete_list_cnt=%u, _to_delete_list_max=%u",
                _to_delete_list_cnt, _to_delete_list_max);
+  if (_free_list_scan_cnt > 0) {
+    st->print_cr("_free_list_scan_cnt=%u"
+                 ", _free_list_scan_times=" UINT64_FORMAT
+                 ", avg_free_list_scan_time=%0.2f"
+                 ", _free_list_scan_time_max=" UINT64_FORMAT,
+                 _free_list_scan_cnt, _free_list_scan_times,
+                 ((double) _free_list_scan_times / _free_list_scan_cnt),
+                 _free_list_scan_time_max);
+  }
 }
 
 // Print ThreadsList elements (4 per line).
@@ -114,9 +114,13 @@ class ThreadsSMRSupport : AllStatic {
   static volatile uint         _tlh_cnt;
   static volatile uint         _tlh_time_max;
   static volatile uint         _tlh_times;
+  static uint                  _free_list_scan_cnt;
+  static uint64_t              _free_list_scan_times;
+  static uint64_t              _free_list_scan_time_max;
   static ThreadsList*          _to_delete_list;
   static uint                  _to_delete_list_cnt;
   static uint                  _to_delete_list_max;
+  static uint                  _to_delete_list_unscanned;
 
   static ThreadsList *acquire_stable_list_fast_path(Thread *self);
   static ThreadsList *acquire_stable_list_nested_path(Thread *self);
@@ -23,6 +23,7 @@
  */
 
 #include "precompiled.hpp"
+#include "compiler/compilationWarmup.hpp"
 #include "compiler/compileBroker.hpp"
 #include "compiler/compilerOracle.hpp"
 #include "memory/resourceArea.hpp"
@@ -285,57 +286,102 @@ void TieredThresholdPolicy::handle_counter_overflow(Method* method) {
   }
 }
 
-// Called with the queue locked and with at least one element
-CompileTask* TieredThresholdPolicy::select_task(CompileQueue* compile_queue) {
-  CompileTask *max_blocking_task = NULL;
-  CompileTask *max_task = NULL;
-  Method* max_method = NULL;
-  jlong t = os::javaTimeMillis();
-  // Iterate through the queue and find a method with a maximum rate.
-  for (CompileTask* task = compile_queue->first(); task != NULL;) {
-    CompileTask* next_task = task->next();
-    Method* method = task->method();
-    update_rate(t, method);
-    if (max_task == NULL) {
-      max_task = task;
-      max_method = method;
-    } else {
-      // If a method has been stale for some time, remove it from the queue.
-      // Blocking tasks and tasks submitted from whitebox API don't become stale
-      if (task->can_become_stale() && is_stale(t, TieredCompileTaskTimeout, method) && !is_old(method)) {
+void TieredThresholdPolicy::update_queue_key(CompileTask* task) {
+  Method* method = task->method();
+  task->set_queue_key((task->is_blocking() ? CompLevel_full_optimization + 1 : 0) + method->highest_comp_level(),
+                      weight(method));
+}
+
+CompileTask* TieredThresholdPolicy::select_task_from_heap(CompileQueue* compile_queue, jlong t) {
+  if (t - compile_queue->last_rescan() >= TieredCompileQueueRescanInterval) {
+    // Refresh the rates and keys of all tasks and drop the stale ones,
+    // the same way the list scan in select_task() does.
+    compile_queue->set_last_rescan(t);
+    bool first = true;
+    for (CompileTask* task = compile_queue->first(); task != NULL;) {
+      CompileTask* next_task = task->next();
+      Method* method = task->method();
+      update_rate(t, method);
+      if (!first && task->can_become_stale() && is_stale(t, TieredCompileTaskTimeout, method) && !is_old(method)) {
         if (PrintTieredEvents) {
           print_event(REMOVE_FROM_QUEUE, method, method, task->osr_bci(), (CompLevel)task->comp_level());
         }
         compile_queue->remove_and_mark_stale(task);
         method->clear_queued_for_compilation();
-        task = next_task;
-        continue;
+      } else {
+        update_queue_key(task);
       }
+      first = false;
+      task = next_task;
+    }
+    compile_queue->heap_rebuild();
+  } else {
+    // Tasks queued since the last selection are at the tail of the list.
+    for (CompileTask* task = compile_queue->last(); task != NULL && task->queue_index() == -1; task = task->prev()) {
+      update_rate(t, task->method());
+      update_queue_key(task);
+      compile_queue->heap_insert(task);
+    }
+  }
+  return compile_queue->heap_top();
+}
 
-      // Select a method with a higher rate
-      if (compare_methods(method, max_method)) {
+// Called with the queue locked and with at least one element
+CompileTask* TieredThresholdPolicy::select_task(CompileQueue* compile_queue) {
+  CompileTask *max_blocking_task = NULL;
+  CompileTask *max_task = NULL;
+  Method* max_method = NULL;
+  jlong t = os::javaTimeMillis();
+  if (compile_queue->uses_heap()) {
+    max_task = select_task_from_heap(compile_queue, t);
+    max_method = max_task != NULL ? max_task->method() : NULL;
+  } else {
+    // Iterate through the queue and find a method with a maximum rate.
+    for (CompileTask* task = compile_queue->first(); task != NULL;) {
+      CompileTask* next_task = task->next();
+      Method* method = task->method();
+      update_rate(t, method);
+      if (max_task == NULL) {
         max_task = task;
         max_method = method;
+      } else {
+        // If a method has been stale for some time, remove it from the queue.
+        // Blocking tasks and tasks submitted from whitebox API don't become stale
+        if (task->can_become_stale() && is_stale(t, TieredCompileTaskTimeout, method) && !is_old(method)) {
+          if (PrintTieredEvents) {
+            print_event(REMOVE_FROM_QUEUE, method, method, task->osr_bci(), (CompLevel)task->comp_level());
+          }
+          compile_queue->remove_and_mark_stale(task);
+          method->clear_queued_for_compilation();
+          task = next_task;
+          continue;
+        }
+
+        // Select a method with a higher rate
+        if (compare_methods(method, max_method)) {
+          max_task = task;
+          max_method = method;
+        }
       }
-    }
 
-    if (task->is_blocking()) {
-      if (max_blocking_task == NULL || compare_methods(method, max_blocking_task->method())) {
-        max_blocking_task = task;
+      if (task->is_blocking()) {
+        if (max_blocking_task == NULL || compare_methods(method, max_blocking_task->method())) {
+          max_blocking_task = task;
+        }
       }
-    }
 
-    task = next_task;
-  }
+      task = next_task;
+    }
 
-  if (max_blocking_task != NULL) {
-    // In blocking compilation mode, the CompileBroker will make
-    // compilations submitted by a JVMCI compiler thread non-blocking. These
-    // compilations should be scheduled after all blocking compilations
-    // to service non-compiler related compilations sooner and reduce the
-    // chance of such compilations timing out.
-    max_task = max_blocking_task;
-    max_method = max_task->method();
+    if (max_blocking_task != NULL) {
+      // In blocking compilation mode, the CompileBroker will make
+      // compilations submitted by a JVMCI compiler thread non-blocking. These
+      // compilations should be scheduled after all blocking compilations
+      // to service non-compiler related compilations sooner and reduce the
+      // chance of such compilations timing out.
+      max_task = max_blocking_task;
+      max_method = max_task->method();
+    }
   }
 
   if (max_task != NULL && max_task->comp_level() == CompLevel_full_profile &&
@@ -829,6 +875,12 @@ CompLevel TieredThresholdPolicy::call_event(Method* method, CompLevel cur_level,
   } else {
     next_level = MAX2(osr_level, next_level);
   }
+  // Methods that reached C2 in an earlier run go straight to profiling.
+  if (cur_level == CompLevel_none && next_level == CompLevel_none &&
+      CompilationWarmup::is_enabled() && CompilationWarmup::is_hot(method) &&
+      TieredStopAtLevel == CompLevel_full_optimization) {
+    next_level = CompLevel_full_profile;
+  }
 #if INCLUDE_JVMCI
   if (UseJVMCICompiler) {
     next_level = JVMCIRuntime::adjust_comp_level(method, false, next_level, thread);
@@ -197,6 +197,12 @@ class TieredThresholdPolicy : public CompilationPolicy {
   inline double weight(Method* method);
   // Apply heuristics and return true if x should be compiled before y
   inline bool compare_methods(Method* x, Method* y);
+  // Set the heap key of a task so that heap order matches compare_methods
+  // (blocking tasks first).
+  inline void update_queue_key(CompileTask* task);
+  // Select a task from the priority heap of the queue. The whole queue is
+  // only rescanned every TieredCompileQueueRescanInterval milliseconds.
+  CompileTask* select_task_from_heap(CompileQueue* compile_queue, jlong t);
   // Compute event rate for a given method. The rate is the number of event (invocations + backedges)
   // per millisecond.
   inline void update_rate(jlong t, Method* m);
@@ -540,6 +540,7 @@ void VMThread::loop() {
         }
 
         evaluate_operation(_cur_vm_operation);
+        int evaluated_count = 1;
         // now process all queued safepoint ops, iteratively draining
         // the queue until there are none left
         do {
@@ -554,6 +555,7 @@ void VMThread::loop() {
               evaluate_operation(_cur_vm_operation);
               _cur_vm_operation = next;
               _coalesced_count++;
+              evaluated_count++;
             } while (_cur_vm_operation != NULL);
           }
           // There is a chance that a thread enqueued a safepoint op
@@ -578,6 +580,8 @@ void VMThread::loop() {
 
         _vm_queue->set_drain_list(NULL);
 
+        log_debug(safepoint)("Evaluated %d VM operation(s) in this safepoint", evaluated_count);
+
         if (_timeout_task != NULL) {
           _timeout_task->disarm();
         }
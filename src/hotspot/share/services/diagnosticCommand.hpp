@@ -256,6 +256,25 @@ public:
   virtual void execute(DCmdSource source, TRAPS);
 };
 
+class PerfDataPrintDCmd : public DCmd {
+public:
+  PerfDataPrintDCmd(outputStream* output, bool heap) : DCmd(output, heap) { }
+  static const char* name() { return "PerfData.print"; }
+  static const char* description() {
+    return "Print the performance counters of the VM. Unlike PerfCounter.print, "
+           "this also works when the counters are not shared through a "
+           "hsperfdata file (-XX:+PerfDisableSharedMem).";
+  }
+  static const char* impact() { return "Low"; }
+  static const JavaPermission permission() {
+    JavaPermission p = {"java.lang.management.ManagementPermission",
+                        "monitor", NULL};
+    return p;
+  }
+  static int num_arguments() { return 0; }
+  virtual void execute(DCmdSource source, TRAPS);
+};
+
 class SystemGCDCmd : public DCmd {
 public:
   SystemGCDCmd(outputStream* output, bool heap) : DCmd(output, heap) { }
@@ -330,6 +349,7 @@ class HeapDumpDCmd : public DCmdWithParser {
 protected:
   DCmdArgument<char*> _filename;
   DCmdArgument<bool>  _all;
+  DCmdArgument<jlong> _gzip;
 public:
   HeapDumpDCmd(outputStream* output, bool heap);
   static const char* name() {
@@ -356,6 +376,7 @@ public:
 class ClassHistogramDCmd : public DCmdWithParser {
 protected:
   DCmdArgument<bool> _all;
+  DCmdArgument<jlong> _parallel_thread_num;
 public:
   ClassHistogramDCmd(outputStream* output, bool heap);
   static const char* name() {
@@ -620,6 +641,27 @@ public:
 };
 
 
+class HotMethodsDCmd : public DCmd {
+public:
+  HotMethodsDCmd(outputStream* output, bool heap) : DCmd(output, heap) {}
+  static const char* name() {
+    return "Compiler.hot_methods";
+  }
+  static const char* description() {
+    return "Print the methods with alive C2 code in CompilationWarmupFile format";
+  }
+  static const char* impact() {
+    return "Medium";
+  }
+  static const JavaPermission permission() {
+    JavaPermission p = {"java.lang.management.ManagementPermission",
+                        "monitor", NULL};
+    return p;
+  }
+  static int num_arguments() { return 0; }
+  virtual void execute(DCmdSource source, TRAPS);
+};
+
 class CodeCacheDCmd : public DCmd {
 public:
   CodeCacheDCmd(outputStream* output, bool heap) : DCmd(output, heap) {}
@@ -24,6 +24,7 @@
 
 #include "precompiled.hpp"
 #include "jvm.h"
+#include "classfile/classLoader.hpp"
 #include "classfile/classLoaderData.inline.hpp"
 #include "classfile/classLoaderDataGraph.hpp"
 #include "classfile/javaClasses.inline.hpp"
@@ -32,6 +33,7 @@
 #include "classfile/vmSymbols.hpp"
 #include "gc/shared/gcLocker.hpp"
 #include "gc/shared/gcVMOperations.hpp"
+#include "gc/shared/workgroup.hpp"
 #include "memory/allocation.inline.hpp"
 #include "memory/resourceArea.hpp"
 #include "memory/universe.hpp"
@@ -378,6 +380,12 @@ enum {
 
 // Supports I/O operations on a dump file
 
+// When a gzip level is given, the buffer is compressed as one gzip member
+// whenever it is flushed. As the file can then not be rewritten, the length
+// of a dump segment is fixed up while the segment is still in the buffer,
+// which grows if necessary. Arrays too large for that are written in a
+// segment of their own whose length is known up front.
+
 class DumpWriter : public StackObj {
  private:
   enum {
@@ -392,6 +400,12 @@ class DumpWriter : public StackObj {
   size_t _pos;
 
   jlong _dump_start;
+  bool _in_sized_dump_record;  // current segment has a precomputed length
+
+  int _gzip_level;             // 0 if not compressing
+  char* _gzip_buffer;          // compressed output
+  size_t _gzip_buffer_size;
+  julong _bytes_compressed;    // number of bytes passed to the compressor
 
   char* _error;   // error message when I/O fails
 
@@ -407,11 +421,33 @@ class DumpWriter : public StackObj {
 
   // all I/O go through this function
   void write_internal(void* s, size_t len);
+  void write_compressed(void* s, size_t len);
+
+  // true if the current segment length still has to be fixed up in the buffer
+  bool needs_fix_up() const {
+    return is_compressed() && dump_start() >= 0 && !_in_sized_dump_record;
+  }
+  void grow_buffer(size_t min_size);
 
  public:
-  DumpWriter(const char* path);
+  // largest segment and array record that are buffered when compressing
+  static const size_t max_buffered_segment_size = io_buffer_size / 2;
+  static const size_t max_buffered_array_size = io_buffer_size / 4;
+
+  DumpWriter(const char* path, int gzip_level = 0);
   ~DumpWriter();
 
+  bool is_compressed() const            { return _gzip_level > 0; }
+  int gzip_level() const                { return _gzip_level; }
+
+  // writes the length of the current segment into the buffer (compressed only)
+  void fix_up_dump_record_length_in_buffer(u4 len);
+
+  // starts a HPROF_HEAP_DUMP_SEGMENT record with a known length
+  void start_sized_dump_record(u4 len);
+  bool in_sized_dump_record() const     { return _in_sized_dump_record; }
+  void end_sized_dump_record()          { _in_sized_dump_record = false; }
+
   void close();
   bool is_open() const                  { return file_descriptor() >= 0; }
   void flush();
@@ -435,6 +471,10 @@ class DumpWriter : public StackObj {
   jlong current_offset();
   void seek_to_offset(jlong pos);
 
+  // appends the contents of a part file written by another writer, or
+  // records the error that writer encountered
+  void append_part(const char* part_path, const char* part_error);
+
   // writer functions
   void write_raw(void* s, size_t len);
   void write_u1(u1 x)                   { write_raw((void*)&x, 1); }
@@ -447,7 +487,7 @@ class DumpWriter : public StackObj {
   void write_id(u4 x);
 };
 
-DumpWriter::DumpWriter(const char* path) {
+DumpWriter::DumpWriter(const char* path, int gzip_level) {
   // try to allocate an I/O buffer of io_buffer_size. If there isn't
   // sufficient memory then reduce size until we can allocate something.
   _size = io_buffer_size;
@@ -462,6 +502,28 @@ DumpWriter::DumpWriter(const char* path) {
   _error = NULL;
   _bytes_written = 0L;
   _dump_start = (jlong)-1;
+  _in_sized_dump_record = false;
+  _gzip_level = gzip_level;
+  _gzip_buffer = NULL;
+  _gzip_buffer_size = 0;
+  _bytes_compressed = 0L;
+
+  if (is_compressed()) {
+    if (!ClassLoader::can_gzip()) {
+      _error = (char*)os::strdup("gzip compression is not supported by the zip library");
+      _fd = -1;
+      return;
+    }
+    // room for a deflated io_buffer_size block and the gzip wrapper
+    _gzip_buffer_size = io_buffer_size + io_buffer_size / 256 + 64;
+    _gzip_buffer = (char*)os::malloc(_gzip_buffer_size, mtInternal);
+    if (_gzip_buffer == NULL || _buffer == NULL) {
+      _error = (char*)os::strdup("out of memory for the compression buffers");
+      _fd = -1;
+      return;
+    }
+  }
+
   _fd = os::create_binary_file(path, false);    // don't replace existing file
 
   // if the open failed we record the error
@@ -476,6 +538,7 @@ DumpWriter::~DumpWriter() {
     close();
   }
   if (_buffer != NULL) os::free(_buffer);
+  if (_gzip_buffer != NULL) os::free(_gzip_buffer);
   if (_error != NULL) os::free(_error);
 }
 
@@ -497,7 +560,7 @@ void DumpWriter::set_dump_start(jlong pos) {
 julong DumpWriter::current_record_length() {
   if (is_open()) {
     // calculate the size of the dump record
-    julong dump_end = bytes_written() + bytes_unwritten();
+    julong dump_end = (is_compressed() ? _bytes_compressed : bytes_written()) + bytes_unwritten();
     assert(dump_end == (size_t)current_offset(), "checking");
     julong dump_len = dump_end - dump_start() - 4;
     return dump_len;
@@ -529,17 +592,62 @@ void DumpWriter::write_internal(void* s, size_t len) {
   }
 }
 
+// compress and write, in blocks the compression buffer can take
+void DumpWriter::write_compressed(void* s, size_t len) {
+  char* pos = (char*)s;
+  while (is_open() && len > 0) {
+    size_t block = MIN2(len, (size_t)io_buffer_size);
+    char* msg = NULL;
+    size_t n = ClassLoader::gzip(pos, block, _gzip_buffer, _gzip_buffer_size, _gzip_level, &msg);
+    if (n == 0) {
+      set_error(msg != NULL ? msg : "gzip compression failed");
+      os::close(file_descriptor());
+      set_file_descriptor(-1);
+      return;
+    }
+    write_internal(_gzip_buffer, n);
+    _bytes_compressed += block;
+    pos += block;
+    len -= block;
+  }
+}
+
+void DumpWriter::grow_buffer(size_t min_size) {
+  size_t new_size = MAX2(buffer_size() * 2, min_size);
+  char* new_buffer = (char*)os::realloc(_buffer, new_size, mtInternal);
+  if (new_buffer == NULL) {
+    set_error("out of memory for the dump buffer");
+    os::close(file_descriptor());
+    set_file_descriptor(-1);
+    return;
+  }
+  _buffer = new_buffer;
+  _size = new_size;
+}
+
 // write raw bytes
 void DumpWriter::write_raw(void* s, size_t len) {
   if (is_open()) {
-    // flush buffer to make room
+    // flush buffer to make room, unless a segment length still has
+    // to be fixed up in it
     if ((position() + len) >= buffer_size()) {
-      flush();
+      if (needs_fix_up()) {
+        grow_buffer(position() + len + 1);
+        if (!is_open()) {
+          return;
+        }
+      } else {
+        flush();
+      }
     }
 
     // buffer not available or too big to buffer it
     if ((buffer() == NULL) || (len >= buffer_size())) {
-      write_internal(s, len);
+      if (is_compressed()) {
+        write_compressed(s, len);
+      } else {
+        write_internal(s, len);
+      }
     } else {
       // Should optimize this for u1/u2/u4/u8 sizes.
       memcpy(buffer() + position(), s, len);
@@ -551,12 +659,36 @@ void DumpWriter::write_raw(void* s, size_t len) {
 // flush any buffered bytes to the file
 void DumpWriter::flush() {
   if (is_open() && position() > 0) {
-    write_internal(buffer(), position());
+    if (is_compressed()) {
+      write_compressed(buffer(), position());
+    } else {
+      write_internal(buffer(), position());
+    }
     set_position(0);
   }
 }
 
+void DumpWriter::fix_up_dump_record_length_in_buffer(u4 len) {
+  assert(needs_fix_up(), "no buffered segment");
+  assert((julong)dump_start() >= _bytes_compressed &&
+         (julong)dump_start() + sizeof(u4) <= _bytes_compressed + position(),
+         "segment length must still be buffered");
+  Bytes::put_Java_u4((address)(buffer() + (dump_start() - _bytes_compressed)), len);
+}
+
+void DumpWriter::start_sized_dump_record(u4 len) {
+  assert(dump_start() < 0, "previous segment not finished");
+  write_u1(HPROF_HEAP_DUMP_SEGMENT);
+  write_u4(0); // current ticks
+  write_u4(len);
+  _in_sized_dump_record = true;
+}
+
 jlong DumpWriter::current_offset() {
+  if (is_compressed()) {
+    // the offset in the uncompressed stream
+    return is_open() ? (jlong)(_bytes_compressed + position()) : (jlong)-1;
+  }
   if (is_open()) {
     // the offset is the file offset plus whatever we have buffered
     jlong offset = os::current_file_offset(file_descriptor());
@@ -580,6 +712,34 @@ void DumpWriter::seek_to_offset(jlong off) {
   }
 }
 
+void DumpWriter::append_part(const char* part_path, const char* part_error) {
+  if (part_error != NULL) {
+    if (_error == NULL) {
+      set_error(part_error);
+    }
+  } else if (is_open()) {
+    int fd = os::open(part_path, O_RDONLY, 0);
+    if (fd < 0) {
+      set_error(os::strerror(errno));
+    } else if (buffer() == NULL) {
+      set_error("no I/O buffer available");
+      os::close(fd);
+    } else {
+      // copy through our own buffer; the part file is written as is, so
+      // compressed parts are not compressed again
+      flush();
+      ssize_t n;
+      while (is_open() && (n = os::read(fd, buffer(), (unsigned int)buffer_size())) > 0) {
+        write_internal(buffer(), (size_t)n);
+      }
+      if (is_open() && n < 0) {
+        set_error(os::strerror(errno));
+      }
+      os::close(fd);
+    }
+  }
+}
+
 void DumpWriter::write_u2(u2 x) {
   u2 v;
   Bytes::put_Java_u2((address)&v, x);
@@ -684,6 +844,9 @@ class DumperSupport : AllStatic {
   // fixes up the length of the current dump record
   static void write_current_dump_record_length(DumpWriter* writer);
 
+  // starts a new dump segment if the current one exceeds the threshold
+  static void check_segment_length(DumpWriter* writer);
+
   // fixes up the current dump record and writes HPROF_HEAP_DUMP_END record
   static void end_of_dump(DumpWriter* writer);
 };
@@ -1099,8 +1262,17 @@ int DumperSupport::calculate_array_max_length(DumpWriter* writer, arrayOop array
 
   size_t length_in_bytes = (size_t)length * type_size;
 
+  // When compressing, large arrays get a segment of their own so that
+  // they do not have to be buffered.
+  assert(!writer->in_sized_dump_record(), "sized segment holds a single record");
+  bool sized_record = writer->is_compressed() &&
+                      (header_size + length_in_bytes) > DumpWriter::max_buffered_array_size;
+  if (sized_record) {
+    write_current_dump_record_length(writer);
+  }
+
   // Create a new record if the current record is non-empty and the array can't fit.
-  julong current_record_length = writer->current_record_length();
+  julong current_record_length = sized_record ? 0 : writer->current_record_length();
   if (current_record_length > 0 &&
       (current_record_length + header_size + length_in_bytes) > max_juint) {
     write_current_dump_record_length(writer);
@@ -1122,6 +1294,10 @@ int DumperSupport::calculate_array_max_length(DumpWriter* writer, arrayOop array
     warning("cannot dump array of type %s[] with length %d; truncating to length %d",
             type2name_tab[type], array->length(), length);
   }
+
+  if (sized_record) {
+    writer->start_sized_dump_record((u4)(header_size + length_in_bytes));
+  }
   return length;
 }
 
@@ -1395,18 +1571,15 @@ class VM_HeapDumper;
 
 class HeapObjectDumper : public ObjectClosure {
  private:
-  VM_HeapDumper* _dumper;
   DumpWriter* _writer;
 
-  VM_HeapDumper* dumper()               { return _dumper; }
   DumpWriter* writer()                  { return _writer; }
 
   // used to indicate that a record has been writen
   void mark_end_of_record();
 
  public:
-  HeapObjectDumper(VM_HeapDumper* dumper, DumpWriter* writer) {
-    _dumper = dumper;
+  HeapObjectDumper(DumpWriter* writer) {
     _writer = writer;
   }
 
@@ -1443,6 +1616,7 @@ class VM_HeapDumper : public VM_GC_Operation {
   static VM_HeapDumper* _global_dumper;
   static DumpWriter*    _global_writer;
   DumpWriter*           _local_writer;
+  const char*           _path;
   JavaThread*           _oome_thread;
   Method*               _oome_constructor;
   bool _gc_before_heap_dump;
@@ -1489,13 +1663,20 @@ class VM_HeapDumper : public VM_GC_Operation {
   // HPROF_TRACE and HPROF_FRAME records
   void dump_stack_traces();
 
+  // HPROF_GC_INSTANCE_DUMP, HPROF_GC_OBJ_ARRAY_DUMP and
+  // HPROF_GC_PRIM_ARRAY_DUMP records, using the safepoint workers of
+  // the heap if possible
+  void dump_heap_objects();
+  bool dump_heap_objects_in_parallel();
+
  public:
-  VM_HeapDumper(DumpWriter* writer, bool gc_before_heap_dump, bool oome) :
+  VM_HeapDumper(DumpWriter* writer, const char* path, bool gc_before_heap_dump, bool oome) :
     VM_GC_Operation(0 /* total collections,      dummy, ignored */,
                     GCCause::_heap_dump /* GC Cause */,
                     0 /* total full collections, dummy, ignored */,
                     gc_before_heap_dump) {
     _local_writer = writer;
+    _path = path;
     _gc_before_heap_dump = gc_before_heap_dump;
     _klass_map = new (ResourceObj::C_HEAP, mtInternal) GrowableArray<Klass*>(INITIAL_CLASS_COUNT, true);
     _stack_traces = NULL;
@@ -1551,6 +1732,12 @@ void DumperSupport::write_dump_header(DumpWriter* writer) {
 // fixes up the length of the current dump record
 void DumperSupport::write_current_dump_record_length(DumpWriter* writer) {
   if (writer->is_open()) {
+    if (writer->in_sized_dump_record()) {
+      // the length was written with the segment header
+      writer->end_sized_dump_record();
+      return;
+    }
+
     julong dump_end = writer->bytes_written() + writer->bytes_unwritten();
     julong dump_len = writer->current_record_length();
 
@@ -1559,6 +1746,13 @@ void DumperSupport::write_current_dump_record_length(DumpWriter* writer) {
       warning("record is too large");
     }
 
+    if (writer->is_compressed()) {
+      // the segment is still in the buffer
+      writer->fix_up_dump_record_length_in_buffer((u4)dump_len);
+      writer->set_dump_start((jlong)-1);
+      return;
+    }
+
     // seek to the dump start and fix-up the length
     assert(writer->dump_start() >= 0, "no dump start recorded");
     writer->seek_to_offset(writer->dump_start());
@@ -1577,17 +1771,29 @@ void DumperSupport::write_current_dump_record_length(DumpWriter* writer) {
 
 // used on a sub-record boundary to check if we need to start a
 // new segment.
-void VM_HeapDumper::check_segment_length() {
-  if (writer()->is_open()) {
-    julong dump_len = writer()->current_record_length();
+void DumperSupport::check_segment_length(DumpWriter* writer) {
+  if (writer->is_open()) {
+    if (writer->in_sized_dump_record()) {
+      // a sized segment holds a single array record
+      write_current_dump_record_length(writer);
+      write_dump_header(writer);
+      return;
+    }
+
+    julong dump_len = writer->current_record_length();
+    julong max_len = writer->is_compressed() ? DumpWriter::max_buffered_segment_size : 2UL*G;
 
-    if (dump_len > 2UL*G) {
-      DumperSupport::write_current_dump_record_length(writer());
-      DumperSupport::write_dump_header(writer());
+    if (dump_len > max_len) {
+      write_current_dump_record_length(writer);
+      write_dump_header(writer);
     }
   }
 }
 
+void VM_HeapDumper::check_segment_length() {
+  DumperSupport::check_segment_length(writer());
+}
+
 // fixes up the current dump record and writes HPROF_HEAP_DUMP_END record
 void DumperSupport::end_of_dump(DumpWriter* writer) {
   if (writer->is_open()) {
@@ -1601,7 +1807,7 @@ void DumperSupport::end_of_dump(DumpWriter* writer) {
 
 // marks sub-record boundary
 void HeapObjectDumper::mark_end_of_record() {
-  dumper()->check_segment_length();
+  DumperSupport::check_segment_length(writer());
 }
 
 // writes a HPROF_LOAD_CLASS record for the class (and each of its
@@ -1764,6 +1970,118 @@ void VM_HeapDumper::do_threads() {
   }
 }
 
+// Dumps the heap objects with the safepoint workers of the heap. Each
+// worker writes the objects it visits into its own part file as complete
+// HPROF_HEAP_DUMP_SEGMENT records; the part files are appended to the
+// dump afterwards.
+
+class ParallelHeapDumpTask : public AbstractGangTask {
+ private:
+  struct DumpPart {
+    bool  _created;
+    char* _error;
+  };
+
+  ParallelObjectIterator* _poi;
+  const char* _path;
+  int         _gzip_level;
+  uint        _num_parts;
+  DumpPart*   _parts;
+
+  void part_path(char* buf, size_t buflen, uint worker_id) const {
+    jio_snprintf(buf, buflen, "%s.p%u", _path, worker_id);
+  }
+
+ public:
+  ParallelHeapDumpTask(ParallelObjectIterator* poi, const char* path, int gzip_level, uint num_parts) :
+    AbstractGangTask("Parallel Heap Dump"),
+    _poi(poi),
+    _path(path),
+    _gzip_level(gzip_level),
+    _num_parts(num_parts) {
+    _parts = NEW_C_HEAP_ARRAY(DumpPart, num_parts, mtInternal);
+    for (uint i = 0; i < num_parts; i++) {
+      _parts[i]._created = false;
+      _parts[i]._error = NULL;
+    }
+  }
+
+  ~ParallelHeapDumpTask() {
+    for (uint i = 0; i < _num_parts; i++) {
+      if (_parts[i]._error != NULL) {
+        os::free(_parts[i]._error);
+      }
+    }
+    FREE_C_HEAP_ARRAY(DumpPart, _parts);
+  }
+
+  void work(uint worker_id) {
+    char path[JVM_MAXPATHLEN];
+    part_path(path, sizeof(path), worker_id);
+
+    // a worker that cannot create its part file leaves its regions to
+    // the other workers, but the dump is reported as incomplete
+    DumpWriter writer(path, _gzip_level);
+    if (writer.is_open()) {
+      _parts[worker_id]._created = true;
+      DumperSupport::write_dump_header(&writer);
+      HeapObjectDumper obj_dumper(&writer);
+      _poi->object_iterate(&obj_dumper, worker_id);
+      DumperSupport::write_current_dump_record_length(&writer);
+      writer.close();
+    }
+    if (writer.error() != NULL) {
+      _parts[worker_id]._error = os::strdup(writer.error());
+    }
+  }
+
+  // appends all part files to the given writer and removes them
+  void append_parts(DumpWriter* writer) {
+    char path[JVM_MAXPATHLEN];
+    for (uint i = 0; i < _num_parts; i++) {
+      part_path(path, sizeof(path), i);
+      writer->append_part(path, _parts[i]._error);
+      if (_parts[i]._created) {
+        remove(path);
+      }
+    }
+  }
+};
+
+bool VM_HeapDumper::dump_heap_objects_in_parallel() {
+  CollectedHeap* ch = Universe::heap();
+  WorkGang* gang = ch->get_safepoint_workers();
+  if (gang == NULL || gang->total_workers() < 2 || !writer()->is_open()) {
+    return false;
+  }
+
+  uint num_workers = gang->total_workers();
+  ParallelObjectIterator* poi = ch->parallel_object_iterator(num_workers);
+  if (poi == NULL) {
+    return false;
+  }
+
+  // the workers compress their own parts, which spreads the compression
+  // over the workers too
+  ParallelHeapDumpTask task(poi, _path, writer()->gzip_level(), num_workers);
+  gang->run_task(&task, num_workers);
+  delete poi;
+
+  // the part files consist of complete segments, so close the current
+  // segment before appending them and start a new one afterwards
+  DumperSupport::write_current_dump_record_length(writer());
+  task.append_parts(writer());
+  DumperSupport::write_dump_header(writer());
+  return true;
+}
+
+void VM_HeapDumper::dump_heap_objects() {
+  if (HeapDumpParallel && dump_heap_objects_in_parallel()) {
+    return;
+  }
+  HeapObjectDumper obj_dumper(writer());
+  Universe::heap()->safe_object_iterate(&obj_dumper);
+}
 
 // The VM operation that dumps the heap. The dump consists of the following
 // records:
@@ -1852,8 +2170,7 @@ void VM_HeapDumper::doit() {
   // segment is started.
   // The HPROF_GC_CLASS_DUMP and HPROF_GC_INSTANCE_DUMP are the vast bulk
   // of the heap dump.
-  HeapObjectDumper obj_dumper(this, writer());
-  Universe::heap()->safe_object_iterate(&obj_dumper);
+  dump_heap_objects();
 
   // HPROF_GC_ROOT_THREAD_OBJ + frames + jni locals
   do_threads();
@@ -1940,8 +2257,9 @@ void VM_HeapDumper::dump_stack_traces() {
 }
 
 // dump the heap to given path.
-int HeapDumper::dump(const char* path) {
+int HeapDumper::dump(const char* path, int compression) {
   assert(path != NULL && strlen(path) > 0, "path missing");
+  assert(compression >= 0 && compression <= 9, "invalid compression level");
 
   // print message in interactive case
   if (print_to_tty()) {
@@ -1950,7 +2268,7 @@ int HeapDumper::dump(const char* path) {
   }
 
   // create the dump writer. If the file can be opened then bail
-  DumpWriter writer(path);
+  DumpWriter writer(path, compression);
   if (!writer.is_open()) {
     set_error(writer.error());
     if (print_to_tty()) {
@@ -1961,7 +2279,7 @@ int HeapDumper::dump(const char* path) {
   }
 
   // generate the dump
-  VM_HeapDumper dumper(&writer, _gc_before_heap_dump, _oome);
+  VM_HeapDumper dumper(&writer, path, _gc_before_heap_dump, _oome);
   if (Thread::current()->is_VM_thread()) {
     assert(SafepointSynchronize::is_at_safepoint(), "Expected to be called at a safepoint");
     dumper.doit();
@@ -2042,7 +2360,7 @@ void HeapDumper::dump_heap(bool oome) {
   const int max_digit_chars = 20;
 
   const char* dump_file_name = "java_pid";
-  const char* dump_file_ext  = ".hprof";
+  const char* dump_file_ext  = HeapDumpGzipLevel > 0 ? ".hprof.gz" : ".hprof";
 
   // The dump file defaults to java_pid<pid>.hprof in the current working
   // directory. HeapDumpPath=<file> can be used to specify an alternative
@@ -2110,6 +2428,6 @@ void HeapDumper::dump_heap(bool oome) {
   HeapDumper dumper(false /* no GC before heap dump */,
                     true  /* send to tty */,
                     oome  /* pass along out-of-memory-error flag */);
-  dumper.dump(my_path);
+  dumper.dump(my_path, (int)HeapDumpGzipLevel);
   os::free(my_path);
 }
@@ -24,6 +24,7 @@
 #include "precompiled.hpp"
 
 #include "runtime/atomic.hpp"
+#include "runtime/os.hpp"
 #include "services/mallocSiteTable.hpp"
 #include "services/mallocTracker.hpp"
 #include "services/mallocTracker.inline.hpp"
@@ -71,7 +72,7 @@ void MallocHeader::release() const {
 
   MallocMemorySummary::record_free(size(), flags());
   MallocMemorySummary::record_free_malloc_header(sizeof(MallocHeader));
-  if (MemTracker::tracking_level() == NMT_detail) {
+  if (MemTracker::tracking_level() == NMT_detail && has_malloc_site()) {
     MallocSiteTable::deallocation_at(size(), _bucket_idx, _pos_idx);
   }
 }
@@ -90,9 +91,21 @@ bool MallocHeader::record_malloc_site(const NativeCallStack& stack, size_t size,
 }
 
 bool MallocHeader::get_stack(NativeCallStack& stack) const {
+  if (!has_malloc_site()) return false;
   return MallocSiteTable::access_stack(stack, _bucket_idx, _pos_idx);
 }
 
+volatile int MallocTracker::_stack_sample_countdown = 0;
+
+// The distance to the next sampled malloc call is geometrically distributed
+// with a mean of NativeMemoryTrackingStackSampleInterval, so allocation
+// patterns with a fixed period do not alias with the sampling.
+int MallocTracker::next_stack_sample_interval() {
+  double q = (os::random() + 1.0) / ((double)max_jint + 2.0);
+  double interval = -log(q) * NativeMemoryTrackingStackSampleInterval;
+  return (int)MIN2(MAX2(interval, 1.0), (double)max_jint);
+}
+
 bool MallocTracker::initialize(NMT_TrackingLevel level) {
   if (level >= NMT_summary) {
     MallocMemorySummary::initialize();
@@ -77,6 +77,12 @@ class MemoryCounter {
     }
   }
 
+  // Only used on private copies, e.g. to scale up sampled counters
+  inline void scale(size_t factor) {
+    _count *= factor;
+    _size *= factor;
+  }
+
   inline size_t count() const { return _count; }
   inline size_t size()  const { return _size;  }
   DEBUG_ONLY(inline size_t peak_count() const { return _peak_count; })
@@ -93,9 +99,10 @@ class MallocMemory {
  private:
   MemoryCounter _malloc;
   MemoryCounter _arena;
+  size_t        _arena_peak;    // High water mark of the arena size
 
  public:
-  MallocMemory() { }
+  MallocMemory() : _arena_peak(0) { }
 
   inline void record_malloc(size_t sz) {
     _malloc.allocate(sz);
@@ -115,12 +122,21 @@ class MallocMemory {
 
   inline void record_arena_size_change(long sz) {
     _arena.resize(sz);
+    if (sz > 0) {
+      // Racy, a concurrent growth can be missed, but the peak is always
+      // a size the arenas really had.
+      size_t size = _arena.size();
+      if (size > _arena_peak) {
+        _arena_peak = size;
+      }
+    }
   }
 
   inline size_t malloc_size()  const { return _malloc.size(); }
   inline size_t malloc_count() const { return _malloc.count();}
   inline size_t arena_size()   const { return _arena.size();  }
   inline size_t arena_count()  const { return _arena.count(); }
+  inline size_t arena_peak()   const { return _arena_peak;    }
 
   DEBUG_ONLY(inline const MemoryCounter& malloc_counter() const { return _malloc; })
   DEBUG_ONLY(inline const MemoryCounter& arena_counter()  const { return _arena;  })
@@ -259,6 +275,10 @@ class MallocHeader {
 #define MAX_BUCKET_LENGTH          right_n_bits(8)
 #endif  // _LP64
 
+  // Bucket index of a block whose call stack was not sampled, so it is
+  // accounted in the summary only
+  static const size_t no_site_bucket_idx = MAX_MALLOCSITE_TABLE_SIZE;
+
  public:
   MallocHeader(size_t size, MEMFLAGS flags, const NativeCallStack& stack, NMT_TrackingLevel level) {
     assert(sizeof(MallocHeader) == sizeof(void*) * 2,
@@ -273,7 +293,10 @@ class MallocHeader {
     if (level == NMT_detail) {
       size_t bucket_idx;
       size_t pos_idx;
-      if (record_malloc_site(stack, size, &bucket_idx, &pos_idx, flags)) {
+      if (NativeMemoryTrackingStackSampleInterval > 1 && stack.is_empty()) {
+        _bucket_idx = no_site_bucket_idx;
+        _pos_idx = 0;
+      } else if (record_malloc_site(stack, size, &bucket_idx, &pos_idx, flags)) {
         assert(bucket_idx <= MAX_MALLOCSITE_TABLE_SIZE, "Overflow bucket index");
         assert(pos_idx <= MAX_BUCKET_LENGTH, "Overflow bucket position index");
         _bucket_idx = bucket_idx;
@@ -287,6 +310,7 @@ class MallocHeader {
 
   inline size_t   size()  const { return _size; }
   inline MEMFLAGS flags() const { return (MEMFLAGS)_flags; }
+  inline bool has_malloc_site() const { return _bucket_idx != no_site_bucket_idx; }
   bool get_stack(NativeCallStack& stack) const;
 
   // Cleanup tracking information before the memory is released.
@@ -364,7 +388,28 @@ class MallocTracker : AllStatic {
   static inline void record_arena_size_change(int size, MEMFLAGS flags) {
     MallocMemorySummary::record_arena_size_change(size, flags);
   }
+
+  // Number of malloc calls each recorded malloc site stands for, 1 unless
+  // the call stacks are sampled
+  static inline size_t stack_sample_interval() {
+    return MAX2(NativeMemoryTrackingStackSampleInterval, (uintx)1);
+  }
+
+  // Returns true if the current malloc call should walk its call stack.
+  // The countdown is updated without synchronization, a lost update only
+  // perturbs an interval that is random anyway.
+  static inline bool sample_stack() {
+    if (NativeMemoryTrackingStackSampleInterval <= 1) return true;
+    if (--_stack_sample_countdown > 0) return false;
+    _stack_sample_countdown = next_stack_sample_interval();
+    return true;
+  }
+
  private:
+  static volatile int _stack_sample_countdown;
+
+  static int next_stack_sample_interval();
+
   static inline MallocHeader* malloc_header(void *memblock) {
     assert(memblock != NULL, "NULL pointer");
     MallocHeader* header = (MallocHeader*)((char*)memblock - sizeof(MallocHeader));
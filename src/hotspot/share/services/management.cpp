@@ -24,6 +24,7 @@
 
 #include "precompiled.hpp"
 #include "jmm.h"
+#include "classfile/javaClasses.hpp"
 #include "classfile/systemDictionary.hpp"
 #include "compiler/compileBroker.hpp"
 #include "memory/allocation.inline.hpp"
@@ -63,6 +64,7 @@
 #include "utilities/debug.hpp"
 #include "utilities/formatBuffer.hpp"
 #include "utilities/macros.hpp"
+#include "utilities/resourceHash.hpp"
 
 PerfVariable* Management::_begin_vm_creation_time = NULL;
 PerfVariable* Management::_end_vm_creation_time = NULL;
@@ -1171,6 +1173,12 @@ JVM_ENTRY(jobjectArray, jmm_DumpThreads(JNIEnv *env, jlongArray thread_ids, jboo
                    (locked_monitors ? true : false),      /* with locked monitors */
                    (locked_synchronizers ? true : false), /* with locked synchronizers */
                    CHECK_NULL);
+  } else if (ThreadDumpWithHandshakes && !locked_synchronizers) {
+    // obtain thread dump of all threads, one thread at a time. Finding the
+    // owned java.util.concurrent locks needs a heap walk at a safepoint.
+    ThreadService::dump_threads_with_handshakes(&dump_result,
+                                                maxDepth, /* stack depth */
+                                                (locked_monitors ? true : false) /* with locked monitors */);
   } else {
     // obtain thread dump of all threads
     VM_ThreadDump op(&dump_result,
@@ -2066,6 +2074,37 @@ jlong Management::ticks_to_ms(jlong ticks) {
 }
 #endif // INCLUDE_MANAGEMENT
 
+// Resolves each thread ID in ids_ah to its JavaThread in list, or to NULL
+// if the thread does not exist or has terminated. ThreadsList lookups by
+// thread ID are linear, so larger requests map the whole list once instead
+// of searching it for every ID.
+static void find_java_threads(ThreadsList* list, typeArrayHandle ids_ah, JavaThread** threads) {
+  typedef ResourceHashtable<jlong, JavaThread*, primitive_hash<jlong>,
+                            primitive_equals<jlong>, 1031> ThreadIdTable;
+  const int num_threads = ids_ah->length();
+  if (num_threads <= 8) {
+    for (int i = 0; i < num_threads; i++) {
+      threads[i] = list->find_JavaThread_from_java_tid(ids_ah->long_at(i));
+    }
+    return;
+  }
+
+  ThreadIdTable table;
+  for (uint i = 0; i < list->length(); i++) {
+    JavaThread* thread = list->thread_at(i);
+    oop tobj = thread->threadObj();
+    // Ignore the thread if it hasn't run yet, has exited
+    // or is starting to exit.
+    if (tobj != NULL && !thread->is_exiting()) {
+      table.put(java_lang_Thread::thread_id(tobj), thread);
+    }
+  }
+  for (int i = 0; i < num_threads; i++) {
+    JavaThread** thread = table.get(ids_ah->long_at(i));
+    threads[i] = thread != NULL ? *thread : NULL;
+  }
+}
+
 // Gets an array containing the amount of memory allocated on the Java
 // heap for a set of threads (in bytes).  Each element of the array is
 // the amount of memory allocated for the thread ID specified in the
@@ -2097,8 +2136,10 @@ JVM_ENTRY(void, jmm_GetThreadAllocatedMemory(JNIEnv *env, jlongArray ids,
   }
 
   ThreadsListHandle tlh;
+  JavaThread** threads = NEW_RESOURCE_ARRAY(JavaThread*, num_threads);
+  find_java_threads(tlh.list(), ids_ah, threads);
   for (int i = 0; i < num_threads; i++) {
-    JavaThread* java_thread = tlh.list()->find_JavaThread_from_java_tid(ids_ah->long_at(i));
+    JavaThread* java_thread = threads[i];
     if (java_thread != NULL) {
       sizeArray_h->long_at_put(i, java_thread->cooked_allocated_bytes());
     }
@@ -2168,8 +2209,10 @@ JVM_ENTRY(void, jmm_GetThreadCpuTimesWithKind(JNIEnv *env, jlongArray ids,
   }
 
   ThreadsListHandle tlh;
+  JavaThread** threads = NEW_RESOURCE_ARRAY(JavaThread*, num_threads);
+  find_java_threads(tlh.list(), ids_ah, threads);
   for (int i = 0; i < num_threads; i++) {
-    JavaThread* java_thread = tlh.list()->find_JavaThread_from_java_tid(ids_ah->long_at(i));
+    JavaThread* java_thread = threads[i];
     if (java_thread != NULL) {
       timeArray_h->long_at_put(i, os::thread_cpu_time((Thread*)java_thread,
                                                       user_sys_cpu_time != 0));
@@ -95,8 +95,12 @@ class MallocAllocationSiteWalker : public MallocSiteWalker {
   }
 
   bool do_malloc_site(const MallocSite* site) {
-    if (site->size() >= MemBaseline::SIZE_THRESHOLD) {
-      if (_malloc_sites.add(*site) != NULL) {
+    // With sampled call stacks, each recorded call stands for
+    // NativeMemoryTrackingStackSampleInterval calls
+    MallocSite scaled(*site);
+    scaled.data()->scale(MallocTracker::stack_sample_interval());
+    if (scaled.size() >= MemBaseline::SIZE_THRESHOLD) {
+      if (_malloc_sites.add(scaled) != NULL) {
         _count++;
         return true;
       } else {
@@ -0,0 +1,164 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#include "precompiled.hpp"
+#include "jfr/jfrEvents.hpp"
+#include "runtime/mutexLocker.hpp"
+#include "runtime/os.hpp"
+#include "services/mallocSiteTable.hpp"
+#include "services/mallocTracker.hpp"
+#include "services/memJfrReporter.hpp"
+#include "services/memTracker.hpp"
+#include "services/nmtCommon.hpp"
+#include "services/virtualMemoryTracker.hpp"
+
+// The part of a malloc site that is reported. It is copied during the walk,
+// the site itself may go away once the walk has released the table.
+struct MallocSiteSample {
+  address  pc;
+  size_t   size;
+  size_t   count;
+  MEMFLAGS flag;
+};
+
+// Keeps the malloc sites with the most outstanding bytes, largest first.
+class TopMallocSiteWalker : public MallocSiteWalker {
+ public:
+  static const int MAX_SITES = 10;
+
+ private:
+  MallocSiteSample _sites[MAX_SITES];
+  int _count;
+
+ public:
+  TopMallocSiteWalker() : _count(0) {}
+
+  bool do_malloc_site(const MallocSite* site) {
+    const size_t size = site->size();
+    if (size == 0 || (_count == MAX_SITES && _sites[_count - 1].size >= size)) {
+      return true;
+    }
+    int pos = _count < MAX_SITES ? _count++ : MAX_SITES - 1;
+    for (; pos > 0 && _sites[pos - 1].size < size; pos--) {
+      _sites[pos] = _sites[pos - 1];
+    }
+    _sites[pos].pc = site->call_stack()->get_frame(0);
+    _sites[pos].size = size;
+    _sites[pos].count = site->count();
+    _sites[pos].flag = site->flag();
+    return true;
+  }
+
+  int count() const { return _count; }
+  const MallocSiteSample& site_at(int i) const { return _sites[i]; }
+};
+
+static size_t reserved_total(const MallocMemory* malloc, const VirtualMemory* vm) {
+  return malloc->malloc_size() + malloc->arena_size() + vm->reserved();
+}
+
+static size_t committed_total(const MallocMemory* malloc, const VirtualMemory* vm) {
+  return malloc->malloc_size() + malloc->arena_size() + vm->committed();
+}
+
+void MemJFRReporter::send_total_event() {
+  if (MemTracker::tracking_level() < NMT_summary) {
+    return;
+  }
+  MallocMemorySnapshot malloc_snapshot;
+  VirtualMemorySnapshot vm_snapshot;
+  {
+    MutexLocker locker(MemTracker::query_lock());
+    MallocMemorySummary::snapshot(&malloc_snapshot);
+    VirtualMemorySummary::snapshot(&vm_snapshot);
+  }
+  EventNativeMemoryUsageTotal event;
+  event.set_reserved(malloc_snapshot.total() + vm_snapshot.total_reserved());
+  event.set_committed(malloc_snapshot.total() + vm_snapshot.total_committed());
+  event.commit();
+}
+
+void MemJFRReporter::send_type_events() {
+  if (MemTracker::tracking_level() < NMT_summary) {
+    return;
+  }
+  MallocMemorySnapshot malloc_snapshot;
+  VirtualMemorySnapshot vm_snapshot;
+  {
+    MutexLocker locker(MemTracker::query_lock());
+    MallocMemorySummary::snapshot(&malloc_snapshot);
+    VirtualMemorySummary::snapshot(&vm_snapshot);
+  }
+  for (int index = 0; index < mt_number_of_types; index ++) {
+    MEMFLAGS flag = NMTUtil::index_to_flag(index);
+    // Thread stacks are reported as part of the thread type, as in MemSummaryReporter
+    if (flag == mtThreadStack) continue;
+    const MallocMemory* malloc_memory = malloc_snapshot.by_type(flag);
+    const VirtualMemory* virtual_memory = vm_snapshot.by_type(flag);
+    size_t reserved = reserved_total(malloc_memory, virtual_memory);
+    size_t committed = committed_total(malloc_memory, virtual_memory);
+    if (flag == mtThread) {
+      const VirtualMemory* thread_stack_usage = vm_snapshot.by_type(mtThreadStack);
+      reserved += thread_stack_usage->reserved();
+      committed += thread_stack_usage->committed();
+    } else if (flag == mtNMT) {
+      reserved += malloc_snapshot.malloc_overhead()->size();
+      committed += malloc_snapshot.malloc_overhead()->size();
+    }
+    EventNativeMemoryUsage event;
+    event.set_type(NMTUtil::flag_to_name(flag));
+    event.set_reserved(reserved);
+    event.set_committed(committed);
+    event.commit();
+  }
+}
+
+void MemJFRReporter::send_malloc_site_events() {
+  if (MemTracker::tracking_level() != NMT_detail) {
+    return;
+  }
+  TopMallocSiteWalker walker;
+  {
+    MutexLocker locker(MemTracker::query_lock());
+    if (!MallocSiteTable::walk_malloc_site(&walker)) {
+      return;
+    }
+  }
+  for (int i = 0; i < walker.count(); i++) {
+    const MallocSiteSample& site = walker.site_at(i);
+    const address pc = site.pc;
+    char function[128];
+    int offset;
+    if (pc == NULL || !os::dll_address_to_function_name(pc, function, sizeof(function), &offset)) {
+      jio_snprintf(function, sizeof(function), PTR_FORMAT, p2i(pc));
+    }
+    EventNativeMemoryMallocSite event;
+    event.set_type(NMTUtil::flag_to_name(site.flag));
+    event.set_topFrame(function);
+    // Scaled up when only sampled call stacks were recorded
+    event.set_size(site.size * MallocTracker::stack_sample_interval());
+    event.set_count(site.count * MallocTracker::stack_sample_interval());
+    event.commit();
+  }
+}
@@ -79,10 +79,10 @@ void MemReporterBase::print_virtual_memory_line(size_t reserved, size_t committe
   output()->print_cr(" ");
 }
 
-void MemReporterBase::print_arena_line(size_t amount, size_t count) const {
+void MemReporterBase::print_arena_line(size_t amount, size_t count, size_t peak) const {
   const char* scale = current_scale();
-  output()->print_cr("%27s (arena=" SIZE_FORMAT "%s #" SIZE_FORMAT ")", " ",
-    amount_in_current_scale(amount), scale, count);
+  output()->print_cr("%27s (arena=" SIZE_FORMAT "%s #" SIZE_FORMAT ") (peak=" SIZE_FORMAT "%s)", " ",
+    amount_in_current_scale(amount), scale, count, amount_in_current_scale(peak), scale);
 }
 
 void MemReporterBase::print_virtual_memory_region(const char* type, address base, size_t size) const {
@@ -171,7 +171,8 @@ void MemSummaryReporter::report_summary_of_type(MEMFLAGS flag,
     }
 
     if (amount_in_current_scale(malloc_memory->arena_size()) > 0) {
-      print_arena_line(malloc_memory->arena_size(), malloc_memory->arena_count());
+      print_arena_line(malloc_memory->arena_size(), malloc_memory->arena_count(),
+                       malloc_memory->arena_peak());
     }
 
     if (flag == mtNMT &&
@@ -220,6 +221,10 @@ void MemDetailReporter::report_detail() {
   // Start detail report
   outputStream* out = output();
   out->print_cr("Details:\n");
+  if (MallocTracker::stack_sample_interval() > 1) {
+    out->print_cr("Malloc sites are estimated from the call stacks of about 1 in " SIZE_FORMAT
+                  " malloc calls\n", MallocTracker::stack_sample_interval());
+  }
 
   report_malloc_sites();
   report_virtual_memory_allocation_sites();
@@ -625,6 +630,10 @@ void MemSummaryDiffReporter::print_metaspace_diff(Metaspace::MetadataType type,
 
 void MemDetailDiffReporter::report_diff() {
   MemSummaryDiffReporter::report_diff();
+  if (MallocTracker::stack_sample_interval() > 1) {
+    output()->print_cr("Malloc sites are estimated from the call stacks of about 1 in " SIZE_FORMAT
+                       " malloc calls\n", MallocTracker::stack_sample_interval());
+  }
   diff_malloc_sites();
   diff_virtual_memory_sites();
 }
@@ -33,6 +33,8 @@
 
 #define CURRENT_PC   NativeCallStack::empty_stack()
 #define CALLER_PC    NativeCallStack::empty_stack()
+#define SAMPLED_CURRENT_PC NativeCallStack::empty_stack()
+#define SAMPLED_CALLER_PC  NativeCallStack::empty_stack()
 
 class Tracker : public StackObj {
  public:
@@ -90,6 +92,16 @@ extern volatile bool NMT_stack_walkable;
                     NativeCallStack(0, true) : NativeCallStack::empty_stack())
 #define CALLER_PC  ((MemTracker::tracking_level() == NMT_detail && NMT_stack_walkable) ?  \
                     NativeCallStack(1, true) : NativeCallStack::empty_stack())
+// Same as CURRENT_PC and CALLER_PC, but only walk the stack of the malloc
+// calls picked by NativeMemoryTrackingStackSampleInterval. Sampling is per
+// call, not per byte. Not for virtual memory tracking, which needs the
+// stack of every reservation.
+#define SAMPLED_CURRENT_PC ((MemTracker::tracking_level() == NMT_detail && NMT_stack_walkable && \
+                             MallocTracker::sample_stack()) ?                                   \
+                            NativeCallStack(0, true) : NativeCallStack::empty_stack())
+#define SAMPLED_CALLER_PC  ((MemTracker::tracking_level() == NMT_detail && NMT_stack_walkable && \
+                             MallocTracker::sample_stack()) ?                                   \
+                            NativeCallStack(1, true) : NativeCallStack::empty_stack())
 
 class MemBaseline;
 
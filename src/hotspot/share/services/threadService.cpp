@@ -33,6 +33,7 @@
 #include "oops/oop.inline.hpp"
 #include "runtime/atomic.hpp"
 #include "runtime/handles.inline.hpp"
+#include "runtime/handshake.hpp"
 #include "runtime/init.hpp"
 #include "runtime/objectMonitor.inline.hpp"
 #include "runtime/thread.inline.hpp"
@@ -295,6 +296,57 @@ void ThreadService::remove_thread_dump(ThreadDumpResult* dump) {
   assert(found, "The threaddump result to be removed must exist.");
 }
 
+// Takes the snapshot of one thread while handshaking with it. The closure
+// runs either in the thread itself or in the VM thread while the thread is
+// blocked, so several threads can run it at the same time.
+class ThreadSnapshotHandshakeClosure : public ThreadClosure {
+ private:
+  ThreadDumpResult* _result;
+  int               _max_depth;
+  bool              _with_locked_monitors;
+  Mutex*            _lock;  // protects the snapshot list of _result
+
+ public:
+  ThreadSnapshotHandshakeClosure(ThreadDumpResult* result, int max_depth,
+                                 bool with_locked_monitors, Mutex* lock) :
+    _result(result), _max_depth(max_depth),
+    _with_locked_monitors(with_locked_monitors), _lock(lock) { }
+
+  void do_thread(Thread* thread) {
+    JavaThread* jt = (JavaThread*)thread;
+    if (jt->is_exiting() || jt->is_hidden_from_external_view()) {
+      // skip terminating threads and hidden threads
+      return;
+    }
+    ResourceMark rm;
+    HandleMark hm;
+    ThreadSnapshot* snapshot;
+    {
+      MutexLockerEx ml(_lock, Mutex::_no_safepoint_check_flag);
+      snapshot = _result->add_thread_snapshot(jt);
+    }
+    snapshot->dump_stack_at_safepoint(_max_depth, _with_locked_monitors);
+  }
+};
+
+void ThreadService::dump_threads_with_handshakes(ThreadDumpResult* result, int max_depth,
+                                                 bool with_locked_monitors) {
+  ResourceMark rm;
+
+  // Protects the threads of the snapshots, as in VM_ThreadDump
+  result->set_t_list();
+  ThreadsList* t_list = result->t_list();
+
+  GrowableArray<JavaThread*>* targets = new GrowableArray<JavaThread*>(t_list->length());
+  for (uint i = 0; i < t_list->length(); i++) {
+    targets->append(t_list->thread_at(i));
+  }
+
+  Mutex lock(Mutex::leaf, "ThreadDump snapshot lock", true, Monitor::_safepoint_check_never);
+  ThreadSnapshotHandshakeClosure cl(result, max_depth, with_locked_monitors, &lock);
+  Handshake::execute(&cl, targets);
+}
+
 // Dump stack trace of threads specified in the given threads array.
 // Returns StackTraceElement[][] each element is the stack trace of a thread in
 // the corresponding entry in the given threads array
@@ -636,8 +688,16 @@ ThreadStackTrace::~ThreadStackTrace() {
   }
 }
 
+// The stack of a thread can be walked at a safepoint, or during a handshake
+// by the thread itself or by the VM thread on its behalf.
+static bool is_stack_stable(JavaThread* thread) {
+  return SafepointSynchronize::is_at_safepoint() ||
+         Thread::current() == thread ||
+         Thread::current()->is_VM_thread();
+}
+
 void ThreadStackTrace::dump_stack_at_safepoint(int maxDepth) {
-  assert(SafepointSynchronize::is_at_safepoint(), "all threads are stopped");
+  assert(is_stack_stable(_thread), "thread must be stopped");
 
   if (_thread->has_last_Java_frame()) {
     RegisterMap reg_map(_thread);
@@ -668,7 +728,7 @@ void ThreadStackTrace::dump_stack_at_safepoint(int maxDepth) {
 
 
 bool ThreadStackTrace::is_owned_monitor_on_stack(oop object) {
-  assert(SafepointSynchronize::is_at_safepoint(), "all threads are stopped");
+  assert(is_stack_stable(_thread), "thread must be stopped");
 
   bool found = false;
   int num_frames = get_stack_depth();
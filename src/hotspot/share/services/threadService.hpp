@@ -107,6 +107,11 @@ public:
   static Handle dump_stack_traces(GrowableArray<instanceHandle>* threads,
                                   int num_threads, TRAPS);
 
+  // Snapshot all live threads like VM_ThreadDump, but handshake each thread
+  // separately instead of stopping all threads at once.
+  static void dump_threads_with_handshakes(ThreadDumpResult* result, int max_depth,
+                                           bool with_locked_monitors);
+
   static void   reset_peak_thread_count();
   static void   reset_contention_count_stat(JavaThread* thread);
   static void   reset_contention_time_stat(JavaThread* thread);
@@ -46,6 +46,7 @@ void VirtualMemorySummary::snapshot(VirtualMemorySnapshot* s) {
 }
 
 SortedLinkedList<ReservedMemoryRegion, compare_reserved_region_base>* VirtualMemoryTracker::_reserved_regions;
+ReservedRegionIndex* VirtualMemoryTracker::_reserved_region_index;
 
 int compare_committed_region(const CommittedMemoryRegion& r1, const CommittedMemoryRegion& r2) {
   return r1.compare(r2);
@@ -55,6 +56,13 @@ int compare_reserved_region_base(const ReservedMemoryRegion& r1, const ReservedM
   return r1.compare(r2);
 }
 
+int compare_region_base_address(const address& a1, const address& a2) {
+  if (a1 == a2) {
+    return 0;
+  }
+  return a1 < a2 ? -1 : 1;
+}
+
 static bool is_mergeable_with(CommittedMemoryRegion* rgn, address addr, size_t size, const NativeCallStack& stack) {
   return rgn->adjacent_to(addr, size) && rgn->call_stack()->equals(stack);
 }
@@ -324,23 +332,72 @@ bool VirtualMemoryTracker::late_initialize(NMT_TrackingLevel level) {
   if (level >= NMT_summary) {
     _reserved_regions = new (std::nothrow, ResourceObj::C_HEAP, mtNMT)
       SortedLinkedList<ReservedMemoryRegion, compare_reserved_region_base>();
-    return (_reserved_regions != NULL);
+    _reserved_region_index = new (std::nothrow) ReservedRegionIndex();
+    return (_reserved_regions != NULL && _reserved_region_index != NULL);
   }
   return true;
 }
 
+LinkedListNode<ReservedMemoryRegion>* VirtualMemoryTracker::find_reserved_region(address addr, size_t size) {
+  // Reserved regions do not overlap, so the first one overlapping the range
+  // is either the last region based at or below addr, or the region after it.
+  ReservedRegionIndex::Node* below = _reserved_region_index->closest_leq(addr);
+  LinkedListNode<ReservedMemoryRegion>* node = (below != NULL ? below->value() : NULL);
+  if (node != NULL && node->peek()->overlap_region(addr, size)) {
+    return node;
+  }
+  node = (node != NULL ? node->next() : _reserved_regions->head());
+  if (node != NULL && node->peek()->overlap_region(addr, size)) {
+    return node;
+  }
+  return NULL;
+}
+
+LinkedListNode<ReservedMemoryRegion>* VirtualMemoryTracker::insert_reserved_region(const ReservedMemoryRegion& rgn) {
+  ReservedRegionIndex::Node* below = _reserved_region_index->closest_lt(rgn.base());
+  LinkedListNode<ReservedMemoryRegion>* prev = (below != NULL ? below->value() : NULL);
+  // Without a preceding region the sorted add stops at the head right away
+  LinkedListNode<ReservedMemoryRegion>* node = (prev != NULL ?
+    _reserved_regions->insert_after(rgn, prev) : _reserved_regions->add(rgn));
+  if (node != NULL && !_reserved_region_index->upsert(rgn.base(), node)) {
+    _reserved_regions->remove_after(prev);
+    return NULL;
+  }
+  return node;
+}
+
+void VirtualMemoryTracker::remove_reserved_region(LinkedListNode<ReservedMemoryRegion>* node) {
+  address base = node->peek()->base();
+  ReservedRegionIndex::Node* below = _reserved_region_index->closest_lt(base);
+  LinkedListNode<ReservedMemoryRegion>* prev = (below != NULL ? below->value() : NULL);
+  assert((prev != NULL ? prev->next() : _reserved_regions->head()) == node, "Index out of sync");
+  _reserved_region_index->remove(base);
+  _reserved_regions->remove_after(prev);
+}
+
+bool VirtualMemoryTracker::rebase_reserved_region(address old_base, LinkedListNode<ReservedMemoryRegion>* node) {
+  address new_base = node->peek()->base();
+  if (new_base == old_base) {
+    return true;
+  }
+  _reserved_region_index->remove(old_base);
+  return _reserved_region_index->upsert(new_base, node);
+}
+
 bool VirtualMemoryTracker::add_reserved_region(address base_addr, size_t size,
     const NativeCallStack& stack, MEMFLAGS flag) {
   assert(base_addr != NULL, "Invalid address");
   assert(size > 0, "Invalid size");
   assert(_reserved_regions != NULL, "Sanity check");
   ReservedMemoryRegion  rgn(base_addr, size, stack, flag);
-  ReservedMemoryRegion* reserved_rgn = _reserved_regions->find(rgn);
+  LinkedListNode<ReservedMemoryRegion>* node = find_reserved_region(base_addr, size);
 
-  if (reserved_rgn == NULL) {
+  if (node == NULL) {
     VirtualMemorySummary::record_reserved_memory(size, flag);
-    return _reserved_regions->add(rgn) != NULL;
+    return insert_reserved_region(rgn) != NULL;
   } else {
+    ReservedMemoryRegion* reserved_rgn = node->data();
+    address old_base = reserved_rgn->base();
     if (reserved_rgn->same_region(base_addr, size)) {
       reserved_rgn->set_call_stack(stack);
       reserved_rgn->set_flag(flag);
@@ -349,7 +406,7 @@ bool VirtualMemoryTracker::add_reserved_region(address base_addr, size_t size,
       VirtualMemorySummary::record_reserved_memory(size, flag);
       reserved_rgn->expand_region(base_addr, size);
       reserved_rgn->set_call_stack(stack);
-      return true;
+      return rebase_reserved_region(old_base, node);
     } else {
       // Overlapped reservation.
       // It can happen when the regions are thread stacks, as JNI
@@ -367,7 +424,7 @@ bool VirtualMemoryTracker::add_reserved_region(address base_addr, size_t size,
         VirtualMemorySummary::record_reserved_memory(rgn.size(), flag);
 
         *reserved_rgn = rgn;
-        return true;
+        return rebase_reserved_region(old_base, node);
       }
 
       // CDS mapping region.
@@ -395,9 +452,9 @@ void VirtualMemoryTracker::set_reserved_region_type(address addr, MEMFLAGS flag)
   assert(addr != NULL, "Invalid address");
   assert(_reserved_regions != NULL, "Sanity check");
 
-  ReservedMemoryRegion   rgn(addr, 1);
-  ReservedMemoryRegion*  reserved_rgn = _reserved_regions->find(rgn);
-  if (reserved_rgn != NULL) {
+  LinkedListNode<ReservedMemoryRegion>* node = find_reserved_region(addr, 1);
+  if (node != NULL) {
+    ReservedMemoryRegion* reserved_rgn = node->data();
     assert(reserved_rgn->contain_address(addr), "Containment");
     if (reserved_rgn->flag() != flag) {
       assert(reserved_rgn->flag() == mtNone, "Overwrite memory type");
@@ -412,10 +469,10 @@ bool VirtualMemoryTracker::add_committed_region(address addr, size_t size,
   assert(size > 0, "Invalid size");
   assert(_reserved_regions != NULL, "Sanity check");
 
-  ReservedMemoryRegion  rgn(addr, size);
-  ReservedMemoryRegion* reserved_rgn = _reserved_regions->find(rgn);
+  LinkedListNode<ReservedMemoryRegion>* node = find_reserved_region(addr, size);
 
-  assert(reserved_rgn != NULL, "No reserved region");
+  assert(node != NULL, "No reserved region");
+  ReservedMemoryRegion* reserved_rgn = node->data();
   assert(reserved_rgn->contain_region(addr, size), "Not completely contained");
   bool result = reserved_rgn->add_committed_region(addr, size, stack);
   return result;
@@ -426,9 +483,9 @@ bool VirtualMemoryTracker::remove_uncommitted_region(address addr, size_t size)
   assert(size > 0, "Invalid size");
   assert(_reserved_regions != NULL, "Sanity check");
 
-  ReservedMemoryRegion  rgn(addr, size);
-  ReservedMemoryRegion* reserved_rgn = _reserved_regions->find(rgn);
-  assert(reserved_rgn != NULL, "No reserved region");
+  LinkedListNode<ReservedMemoryRegion>* node = find_reserved_region(addr, size);
+  assert(node != NULL, "No reserved region");
+  ReservedMemoryRegion* reserved_rgn = node->data();
   assert(reserved_rgn->contain_region(addr, size), "Not completely contained");
   bool result = reserved_rgn->remove_uncommitted_region(addr, size);
   return result;
@@ -439,10 +496,10 @@ bool VirtualMemoryTracker::remove_released_region(address addr, size_t size) {
   assert(size > 0, "Invalid size");
   assert(_reserved_regions != NULL, "Sanity check");
 
-  ReservedMemoryRegion  rgn(addr, size);
-  ReservedMemoryRegion* reserved_rgn = _reserved_regions->find(rgn);
+  LinkedListNode<ReservedMemoryRegion>* node = find_reserved_region(addr, size);
 
-  assert(reserved_rgn != NULL, "No reserved region");
+  assert(node != NULL, "No reserved region");
+  ReservedMemoryRegion* reserved_rgn = node->data();
 
   // uncommit regions within the released region
   if (!reserved_rgn->remove_uncommitted_region(addr, size)) {
@@ -461,13 +518,15 @@ bool VirtualMemoryTracker::remove_released_region(address addr, size_t size) {
   VirtualMemorySummary::record_released_memory(size, reserved_rgn->flag());
 
   if (reserved_rgn->same_region(addr, size)) {
-    return _reserved_regions->remove(rgn);
+    remove_reserved_region(node);
+    return true;
   } else {
     assert(reserved_rgn->contain_region(addr, size), "Not completely contained");
     if (reserved_rgn->base() == addr ||
         reserved_rgn->end() == addr + size) {
-        reserved_rgn->exclude_region(addr, size);
-      return true;
+      address old_base = reserved_rgn->base();
+      reserved_rgn->exclude_region(addr, size);
+      return rebase_reserved_region(old_base, node);
     } else {
       address top = reserved_rgn->end();
       address high_base = addr + size;
@@ -476,7 +535,7 @@ bool VirtualMemoryTracker::remove_released_region(address addr, size_t size) {
 
       // use original region for lower region
       reserved_rgn->exclude_region(addr, top - addr);
-      LinkedListNode<ReservedMemoryRegion>* new_rgn = _reserved_regions->add(high_rgn);
+      LinkedListNode<ReservedMemoryRegion>* new_rgn = insert_reserved_region(high_rgn);
       if (new_rgn == NULL) {
         return false;
       } else {
@@ -590,6 +649,8 @@ bool VirtualMemoryTracker::transition(NMT_TrackingLevel from, NMT_TrackingLevel
     if (_reserved_regions != NULL) {
       delete _reserved_regions;
       _reserved_regions = NULL;
+      delete _reserved_region_index;
+      _reserved_region_index = NULL;
     }
   }
 
@@ -34,6 +34,7 @@
 #include "utilities/linkedlist.hpp"
 #include "utilities/nativeCallStack.hpp"
 #include "utilities/ostream.hpp"
+#include "utilities/treap.hpp"
 
 
 /*
@@ -381,6 +382,11 @@ class ReservedMemoryRegion : public VirtualMemoryRegion {
 };
 
 int compare_reserved_region_base(const ReservedMemoryRegion& r1, const ReservedMemoryRegion& r2);
+int compare_region_base_address(const address& a1, const address& a2);
+
+// Reserved region list nodes by region base address
+typedef Treap<address, LinkedListNode<ReservedMemoryRegion>*, compare_region_base_address, mtNMT>
+  ReservedRegionIndex;
 
 class VirtualMemoryWalker : public StackObj {
  public:
@@ -414,7 +420,16 @@ class VirtualMemoryTracker : AllStatic {
   static void snapshot_thread_stacks();
 
  private:
+  // Lookups and updates of _reserved_regions go through _reserved_region_index,
+  // so they take O(log n) instead of walking the list.
+  static LinkedListNode<ReservedMemoryRegion>* find_reserved_region(address addr, size_t size);
+  static LinkedListNode<ReservedMemoryRegion>* insert_reserved_region(const ReservedMemoryRegion& rgn);
+  static void remove_reserved_region(LinkedListNode<ReservedMemoryRegion>* node);
+  // Updates the index after the base of a reserved region changed
+  static bool rebase_reserved_region(address old_base, LinkedListNode<ReservedMemoryRegion>* node);
+
   static SortedLinkedList<ReservedMemoryRegion, compare_reserved_region_base>* _reserved_regions;
+  static ReservedRegionIndex* _reserved_region_index;
 };
 
 
@@ -29,6 +29,7 @@
 #include "utilities/bitMap.inline.hpp"
 #include "utilities/copy.hpp"
 #include "utilities/debug.hpp"
+#include "utilities/population_count.hpp"
 
 STATIC_ASSERT(sizeof(BitMap::bm_word_t) == BytesPerWord); // "Implementation assumption."
 
@@ -491,68 +492,74 @@ void BitMap::set_intersection(const BitMap& other) {
 
 bool BitMap::set_union_with_result(const BitMap& other) {
   assert(size() == other.size(), "must have same size");
-  bool changed = false;
+  // Accumulate the changed bits rather than a bool, which keeps the
+  // loop free of branches and lets the compiler vectorize it.
+  bm_word_t changed = 0;
   bm_word_t* dest_map = map();
   const bm_word_t* other_map = other.map();
   idx_t limit = word_index(size());
   for (idx_t index = 0; index < limit; ++index) {
     bm_word_t orig = dest_map[index];
     bm_word_t temp = orig | other_map[index];
-    changed = changed || (temp != orig);
+    changed |= temp ^ orig;
     dest_map[index] = temp;
   }
   idx_t rest = bit_in_word(size());
   if (rest > 0) {
     bm_word_t orig = dest_map[limit];
     bm_word_t temp = merge_tail_of_map(orig | other_map[limit], orig, rest);
-    changed = changed || (temp != orig);
+    changed |= temp ^ orig;
     dest_map[limit] = temp;
   }
-  return changed;
+  return changed != 0;
 }
 
 bool BitMap::set_difference_with_result(const BitMap& other) {
   assert(size() == other.size(), "must have same size");
-  bool changed = false;
+  // Accumulate the changed bits rather than a bool, which keeps the
+  // loop free of branches and lets the compiler vectorize it.
+  bm_word_t changed = 0;
   bm_word_t* dest_map = map();
   const bm_word_t* other_map = other.map();
   idx_t limit = word_index(size());
   for (idx_t index = 0; index < limit; ++index) {
     bm_word_t orig = dest_map[index];
     bm_word_t temp = orig & ~other_map[index];
-    changed = changed || (temp != orig);
+    changed |= temp ^ orig;
     dest_map[index] = temp;
   }
   idx_t rest = bit_in_word(size());
   if (rest > 0) {
     bm_word_t orig = dest_map[limit];
     bm_word_t temp = merge_tail_of_map(orig & ~other_map[limit], orig, rest);
-    changed = changed || (temp != orig);
+    changed |= temp ^ orig;
     dest_map[limit] = temp;
   }
-  return changed;
+  return changed != 0;
 }
 
 bool BitMap::set_intersection_with_result(const BitMap& other) {
   assert(size() == other.size(), "must have same size");
-  bool changed = false;
+  // Accumulate the changed bits rather than a bool, which keeps the
+  // loop free of branches and lets the compiler vectorize it.
+  bm_word_t changed = 0;
   bm_word_t* dest_map = map();
   const bm_word_t* other_map = other.map();
   idx_t limit = word_index(size());
   for (idx_t index = 0; index < limit; ++index) {
     bm_word_t orig = dest_map[index];
     bm_word_t temp = orig & other_map[index];
-    changed = changed || (temp != orig);
+    changed |= temp ^ orig;
     dest_map[index] = temp;
   }
   idx_t rest = bit_in_word(size());
   if (rest > 0) {
     bm_word_t orig = dest_map[limit];
     bm_word_t temp = merge_tail_of_map(orig & other_map[limit], orig, rest);
-    changed = changed || (temp != orig);
+    changed |= temp ^ orig;
     dest_map[limit] = temp;
   }
-  return changed;
+  return changed != 0;
 }
 
 void BitMap::set_from(const BitMap& other) {
@@ -631,52 +638,30 @@ bool BitMap::iterate(BitMapClosure* blk, idx_t leftOffset, idx_t rightOffset) {
   return true;
 }
 
-const BitMap::idx_t* BitMap::_pop_count_table = NULL;
-
-void BitMap::init_pop_count_table() {
-  if (_pop_count_table == NULL) {
-    BitMap::idx_t *table = NEW_C_HEAP_ARRAY(idx_t, 256, mtInternal);
-    for (uint i = 0; i < 256; i++) {
-      table[i] = num_set_bits(i);
-    }
-
-    if (!Atomic::replace_if_null(table, &_pop_count_table)) {
-      guarantee(_pop_count_table != NULL, "invariant");
-      FREE_C_HEAP_ARRAY(idx_t, table);
-    }
-  }
-}
-
-BitMap::idx_t BitMap::num_set_bits(bm_word_t w) {
-  idx_t bits = 0;
-
-  while (w != 0) {
-    while ((w & 1) == 0) {
-      w >>= 1;
-    }
-    bits++;
-    w >>= 1;
-  }
-  return bits;
-}
-
-BitMap::idx_t BitMap::num_set_bits_from_table(unsigned char c) {
-  assert(_pop_count_table != NULL, "precondition");
-  return _pop_count_table[c];
+// Bit-parallel population count of a map word, instead of a table
+// lookup per byte.
+static inline idx_t count_word_bits(bm_word_t w) {
+  idx_t count = population_count((uint32_t)w);
+  LP64_ONLY(count += population_count((uint32_t)(w >> 32));)
+  return count;
 }
 
 BitMap::idx_t BitMap::count_one_bits() const {
-  init_pop_count_table(); // If necessary.
-  idx_t sum = 0;
-  typedef unsigned char uchar;
-  for (idx_t i = 0; i < size_in_words(); i++) {
-    bm_word_t w = map()[i];
-    for (size_t j = 0; j < sizeof(bm_word_t); j++) {
-      sum += num_set_bits_from_table(uchar(w & 255));
-      w >>= 8;
-    }
-  }
-  return sum;
+  const bm_word_t* words = map();
+  idx_t limit = size_in_words();
+  // Independent partial sums, so the counts of consecutive words
+  // are not serialized on a single accumulator.
+  idx_t sum0 = 0;
+  idx_t sum1 = 0;
+  idx_t index = 0;
+  for (; index + 1 < limit; index += 2) {
+    sum0 += count_word_bits(words[index]);
+    sum1 += count_word_bits(words[index + 1]);
+  }
+  if (index < limit) {
+    sum0 += count_word_bits(words[index]);
+  }
+  return sum0 + sum1;
 }
 
 void BitMap::print_on_error(outputStream* st, const char* prefix) const {
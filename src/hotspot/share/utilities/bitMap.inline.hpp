@@ -189,6 +189,18 @@ inline BitMap::idx_t BitMap::get_next_bit_impl(idx_t l_index, idx_t r_index) con
       idx_t limit = aligned_right
         ? word_index(r_index)
         : (word_index(r_index - 1) + 1); // Align up, knowing r_index > 0.
+      // Sparse bitmaps, like most GC mark bitmaps, have long runs of
+      // uninteresting words.  Skip over them a block of words at a time,
+      // the independent loads and the or-reduction are cheaper than a
+      // compare and branch per word.  The word loop below then finds the
+      // interesting word in the block, or handles the last few words.
+      const idx_t block_words = 4;
+      while (index + block_words < limit) {
+        bm_word_t block = (map(index + 1) ^ flip) | (map(index + 2) ^ flip) |
+                          (map(index + 3) ^ flip) | (map(index + 4) ^ flip);
+        if (block != 0) break;
+        index += block_words;
+      }
       while (++index < limit) {
         cword = map(index) ^ flip;
         if (cword != 0) {
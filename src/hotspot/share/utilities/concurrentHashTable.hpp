@@ -369,6 +369,14 @@ class ConcurrentHashTable : public CHeapObj<F> {
                                  size_t stop_idx, EVALUATE_FUNC& eval_f,
                                  DELETE_FUNC& del_f, bool is_mt = false);
 
+  // Inserts values[start_idx] to values[stop_idx - 1] without looking for
+  // duplicates. Caller will have locked _resize_lock, so the table cannot be
+  // swapped and no critical section is needed. Returns the number of values
+  // inserted, values with a dead hash are skipped.
+  size_t do_bulk_insert_locked_for(Thread* thread, const VALUE* values,
+                                   size_t start_idx, size_t stop_idx,
+                                   bool is_mt = false);
+
   // Method to delete one items.
   template <typename LOOKUP_FUNC>
   void delete_in_bucket(Thread* thread, Bucket* bucket, LOOKUP_FUNC& lookup_f);
@@ -494,6 +502,7 @@ class ConcurrentHashTable : public CHeapObj<F> {
 
  public:
   class BulkDeleteTask;
+  class BulkInsertTask;
   class GrowTask;
 };
 
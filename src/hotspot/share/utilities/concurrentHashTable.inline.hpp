@@ -540,6 +540,44 @@ inline void ConcurrentHashTable<VALUE, CONFIG, F>::
   GlobalCounter::critical_section_end(thread, cs_context);
 }
 
+template <typename VALUE, typename CONFIG, MEMFLAGS F>
+inline size_t ConcurrentHashTable<VALUE, CONFIG, F>::
+  do_bulk_insert_locked_for(Thread* thread, const VALUE* values,
+                            size_t start_idx, size_t stop_idx, bool is_mt)
+{
+  // Here we have resize lock so table is SMR safe, and there is no new
+  // table. Can do this in parallel if we want.
+  assert((is_mt && _resize_lock_owner != NULL) ||
+         (!is_mt && _resize_lock_owner == thread), "Re-size lock not held");
+  InternalTable* table = get_table();
+  size_t inserted = 0;
+  for (size_t value_it = start_idx; value_it < stop_idx; value_it++) {
+    bool dead_hash = false;
+    uintx hash = CONFIG::get_hash(values[value_it], &dead_hash);
+    if (dead_hash) {
+      continue;
+    }
+    Bucket* bucket = get_bucket_in(table, hash);
+    assert(!bucket->have_redirect(), "No resize while we hold the lock");
+    Node* new_node = Node::create_node(values[value_it], NULL);
+    // Only other inserts and single deletes can race with us on the bucket.
+    while (true) {
+      Node* first = bucket->first();
+      new_node->set_next(first);
+      if (bucket->cas_first(new_node, first)) {
+        break;
+      }
+      if (bucket->is_locked()) {
+        os::naked_yield();
+      } else {
+        SpinPause();
+      }
+    }
+    inserted++;
+  }
+  return inserted;
+}
+
 template <typename VALUE, typename CONFIG, MEMFLAGS F>
 template <typename LOOKUP_FUNC>
 inline void ConcurrentHashTable<VALUE, CONFIG, F>::
@@ -28,8 +28,8 @@
 #include "utilities/globalDefinitions.hpp"
 #include "utilities/concurrentHashTable.inline.hpp"
 
-// This inline file contains BulkDeleteTask and GrowTasks which are both bucket
-// operations, which they are serialized with each other.
+// This inline file contains BulkDeleteTask, BulkInsertTask and GrowTasks which
+// all hold the resize lock, which they are serialized with each other.
 
 // Base class for pause and/or parallel bulk operations.
 template <typename VALUE, typename CONFIG, MEMFLAGS F>
@@ -160,6 +160,71 @@ class ConcurrentHashTable<VALUE, CONFIG, F>::BulkDeleteTask :
   }
 };
 
+// For doing parallel bulk insert of values known not to be in the table, e.g.
+// when populating a table at startup. The ranges claimed are ranges of the
+// values array instead of ranges of buckets.
+template <typename VALUE, typename CONFIG, MEMFLAGS F>
+class ConcurrentHashTable<VALUE, CONFIG, F>::BulkInsertTask :
+  public BucketsOperation
+{
+  const VALUE*    _values;
+  size_t          _num_values;
+  volatile size_t _num_inserted;
+
+ public:
+  BulkInsertTask(ConcurrentHashTable<VALUE, CONFIG, F>* cht,
+                 const VALUE* values, size_t num_values, bool is_mt = false)
+    : BucketsOperation(cht, is_mt), _values(values), _num_values(num_values),
+      _num_inserted(0) {
+  }
+  // Before start prepare must be called. Grows the table towards two values
+  // per bucket first, so that the inserts do not build long chains.
+  bool prepare(Thread* thread) {
+    if (_num_values > 1) {
+      size_t log2_size = MIN2((size_t)log2_intptr((uintptr_t)_num_values),
+                              BucketsOperation::_cht->_log2_size_limit);
+      while (BucketsOperation::_cht->internal_grow(thread, log2_size)) {
+        /* grow one step */
+      }
+    }
+    bool lock = BucketsOperation::_cht->try_resize_lock(thread);
+    if (!lock) {
+      return false;
+    }
+    this->thread_owns_resize_lock(thread);
+    size_t task_size = ((size_t)1) << this->_task_size_log2;
+    this->_stop_task = (_num_values + task_size - 1) / task_size;
+    return true;
+  }
+
+  // Inserts one range of the values. Returns true if there is more work.
+  bool do_task(Thread* thread) {
+    size_t start, stop;
+    assert(BucketsOperation::_cht->_resize_lock_owner != NULL,
+           "Should be locked");
+    if (!this->claim(&start, &stop)) {
+      return false;
+    }
+    size_t inserted = BucketsOperation::_cht->do_bulk_insert_locked_for(
+                        thread, _values, start, MIN2(stop, _num_values),
+                        BucketsOperation::_is_mt);
+    Atomic::add(inserted, &_num_inserted);
+    return true;
+  }
+
+  // Number of values inserted, values with a dead hash are not.
+  size_t num_inserted() const {
+    return OrderAccess::load_acquire(&_num_inserted);
+  }
+
+  // Must be called after ranges are done.
+  void done(Thread* thread) {
+    this->thread_owns_resize_lock(thread);
+    BucketsOperation::_cht->unlock_resize_lock(thread);
+    this->thread_do_not_own_resize_lock(thread);
+  }
+};
+
 template <typename VALUE, typename CONFIG, MEMFLAGS F>
 class ConcurrentHashTable<VALUE, CONFIG, F>::GrowTask :
   public BucketsOperation
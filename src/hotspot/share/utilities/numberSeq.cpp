@@ -186,6 +186,16 @@ double TruncatedSeq::last() const {
   return _sequence[last_index];
 }
 
+int TruncatedSeq::num_recent() const {
+  return MIN2(_num, _length);
+}
+
+double TruncatedSeq::recent(int i) const {
+  assert(i >= 0 && i < num_recent(), "index %d out of bounds", i);
+  unsigned index = (_next + _length - 1 - i) % _length;
+  return _sequence[index];
+}
+
 double TruncatedSeq::oldest() const {
   if (_num == 0)
     return 0.0;
@@ -125,6 +125,8 @@ public:
   virtual double last() const; // the last value added to the sequence
 
   double oldest() const; // the oldest valid value in the sequence
+  int num_recent() const; // the number of values buffered
+  double recent(int i) const; // the i-th most recent value, 0 being the last
   double predict_next() const; // prediction based on linear regression
 
   // Debugging/Printing
@@ -0,0 +1,53 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#ifndef SHARE_UTILITIES_SYSTEMMEMORYBARRIER_HPP
+#define SHARE_UTILITIES_SYSTEMMEMORYBARRIER_HPP
+
+#include "memory/allocation.hpp"
+#include "utilities/debug.hpp"
+
+// A system memory barrier makes every thread of the process that is
+// running on some CPU execute a full memory barrier.  With
+// UseSystemMemoryBarrier the thread state transitions around native
+// calls skip their fence, and the thread arming a safepoint or a
+// handshake emits a system memory barrier before it inspects the
+// thread states instead.
+
+class NoSystemMemoryBarrier : public AllStatic {
+ public:
+  static bool initialize() { return false; }
+  static void emit() { fatal("No system memory barrier available"); }
+};
+
+#if defined(LINUX)
+#include "systemMemoryBarrier_linux.hpp"
+typedef LinuxSystemMemoryBarrier SystemMemoryBarrierDefault;
+#else
+typedef NoSystemMemoryBarrier SystemMemoryBarrierDefault;
+#endif
+
+typedef SystemMemoryBarrierDefault SystemMemoryBarrier;
+
+#endif // SHARE_UTILITIES_SYSTEMMEMORYBARRIER_HPP
@@ -0,0 +1,216 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#ifndef SHARE_UTILITIES_TREAP_HPP
+#define SHARE_UTILITIES_TREAP_HPP
+
+#include "memory/allocation.hpp"
+#include "utilities/debug.hpp"
+#include "utilities/globalDefinitions.hpp"
+
+/*
+ * An ordered map from K to V, implemented as a treap: a binary search tree
+ * on the keys that is at the same time a max-heap on random node priorities.
+ * The random priorities keep the tree balanced in expectation, so lookups,
+ * insertions and removals take O(log n) expected time.
+ *
+ * COMPARE returns a negative value, zero or a positive value if its first
+ * argument is less than, equal to or greater than its second argument.
+ *
+ * The treap is not thread safe, callers have to provide the locking.
+ */
+template <class K, class V, int (*COMPARE)(const K&, const K&), MEMFLAGS F = mtInternal>
+class Treap : public CHeapObj<F> {
+ public:
+  class Node : public CHeapObj<F> {
+    friend class Treap;
+   private:
+    uint64_t _priority;
+    K        _key;
+    V        _value;
+    Node*    _left;
+    Node*    _right;
+
+    Node(const K& key, const V& value, uint64_t priority) :
+      _priority(priority), _key(key), _value(value), _left(NULL), _right(NULL) { }
+
+   public:
+    const K& key() const { return _key;   }
+    V&       value()     { return _value; }
+  };
+
+ private:
+  Node*    _root;
+  size_t   _count;
+  uint64_t _seed;
+
+  // lrand48 style generator, the priorities do not need to be any better
+  uint64_t next_priority() {
+    _seed = (0x5DEECE66DULL * _seed + 0xB) & right_n_bits(48);
+    return _seed >> 16;
+  }
+
+  // Splits the tree rooted at node into the nodes with keys less than key,
+  // and the others. With equal_goes_left, nodes equal to key go left.
+  static void split(Node* node, const K& key, bool equal_goes_left, Node** left, Node** right) {
+    if (node == NULL) {
+      *left = NULL;
+      *right = NULL;
+      return;
+    }
+    int cmp = COMPARE(node->_key, key);
+    if (cmp < 0 || (cmp == 0 && equal_goes_left)) {
+      split(node->_right, key, equal_goes_left, &node->_right, right);
+      *left = node;
+    } else {
+      split(node->_left, key, equal_goes_left, left, &node->_left);
+      *right = node;
+    }
+  }
+
+  // Merges two trees, where all keys in left are less than all keys in right
+  static Node* merge(Node* left, Node* right) {
+    if (left == NULL) return right;
+    if (right == NULL) return left;
+    if (left->_priority > right->_priority) {
+      left->_right = merge(left->_right, right);
+      return left;
+    } else {
+      right->_left = merge(left, right->_left);
+      return right;
+    }
+  }
+
+  static void delete_tree(Node* node) {
+    if (node != NULL) {
+      delete_tree(node->_left);
+      delete_tree(node->_right);
+      delete node;
+    }
+  }
+
+  template <class VISITOR>
+  static bool visit_in_order(Node* node, VISITOR* visitor) {
+    if (node == NULL) return true;
+    return visit_in_order(node->_left, visitor) &&
+           visitor->do_node(node) &&
+           visit_in_order(node->_right, visitor);
+  }
+
+  // Returns the node with the greatest key less than key, or less than
+  // or equal to key with inclusive.
+  Node* closest_below(const K& key, bool inclusive) const {
+    Node* candidate = NULL;
+    Node* node = _root;
+    while (node != NULL) {
+      int cmp = COMPARE(node->_key, key);
+      if (cmp < 0 || (cmp == 0 && inclusive)) {
+        candidate = node;
+        node = node->_right;
+      } else {
+        node = node->_left;
+      }
+    }
+    return candidate;
+  }
+
+ public:
+  Treap() : _root(NULL), _count(0), _seed(0x2545F491ULL) { }
+
+  ~Treap() {
+    delete_tree(_root);
+  }
+
+  size_t count() const   { return _count; }
+  bool is_empty() const  { return _root == NULL; }
+
+  Node* find(const K& key) const {
+    Node* node = _root;
+    while (node != NULL) {
+      int cmp = COMPARE(node->_key, key);
+      if (cmp == 0) {
+        return node;
+      }
+      node = cmp < 0 ? node->_right : node->_left;
+    }
+    return NULL;
+  }
+
+  // The node with the greatest key less than or equal to key, or NULL
+  Node* closest_leq(const K& key) const {
+    return closest_below(key, true);
+  }
+
+  // The node with the greatest key less than key, or NULL
+  Node* closest_lt(const K& key) const {
+    return closest_below(key, false);
+  }
+
+  // Inserts the mapping, or replaces the value if key is already mapped.
+  // Returns false if a node could not be allocated.
+  bool upsert(const K& key, const V& value) {
+    Node* node = find(key);
+    if (node != NULL) {
+      node->_value = value;
+      return true;
+    }
+    node = new (std::nothrow) Node(key, value, next_priority());
+    if (node == NULL) {
+      return false;
+    }
+    Node* left;
+    Node* right;
+    split(_root, key, false, &left, &right);
+    _root = merge(merge(left, node), right);
+    _count++;
+    return true;
+  }
+
+  // Returns false if key was not mapped
+  bool remove(const K& key) {
+    Node* left;
+    Node* rest;
+    Node* middle;
+    Node* right;
+    split(_root, key, false, &left, &rest);
+    split(rest, key, true, &middle, &right);
+    _root = merge(left, right);
+    if (middle == NULL) {
+      return false;
+    }
+    assert(middle->_left == NULL && middle->_right == NULL, "keys are unique");
+    delete middle;
+    _count--;
+    return true;
+  }
+
+  // Calls visitor->do_node(Node*) on each node in key order, until it
+  // returns false. Returns false if the walk was stopped.
+  template <class VISITOR>
+  bool visit_in_order(VISITOR* visitor) const {
+    return visit_in_order(_root, visitor);
+  }
+};
+
+#endif // SHARE_UTILITIES_TREAP_HPP
@@ -335,27 +335,31 @@ jint UTF8::get_supplementary_character(const unsigned char* str) {
                  + ((str[4] & 0x0f) << 6)  + (str[5] & 0x3f);
 }
 
+// Tells whether the 8 bytes at p are all in the range [1, 127].  The word
+// is checked at once: (w - 0x01..01) & ~w has the high bit set in a byte
+// that is zero, and w itself has it set in a byte that is >= 128.
+static inline bool is_ascii_word(const unsigned char* p) {
+  const uint64_t ones  = CONST64(0x0101010101010101);
+  const uint64_t highs = CONST64(0x8080808080808080);
+  uint64_t w;
+  memcpy(&w, p, sizeof(w));
+  return ((((w - ones) & ~w) | w) & highs) == 0;
+}
+
 bool UTF8::is_legal_utf8(const unsigned char* buffer, int length,
                          bool version_leq_47) {
   int i = 0;
-  int count = length >> 2;
-  for (int k=0; k<count; k++) {
-    unsigned char b0 = buffer[i];
-    unsigned char b1 = buffer[i+1];
-    unsigned char b2 = buffer[i+2];
-    unsigned char b3 = buffer[i+3];
-    // For an unsigned char v,
-    // (v | v - 1) is < 128 (highest bit 0) for 0 < v < 128;
-    // (v | v - 1) is >= 128 (highest bit 1) for v == 0 or v >= 128.
-    unsigned char res = b0 | b0 - 1 |
-                        b1 | b1 - 1 |
-                        b2 | b2 - 1 |
-                        b3 | b3 - 1;
-    if (res >= 128) break;
-    i += 4;
-  }
   for(; i < length; i++) {
     unsigned short c;
+    // Skip runs of plain ASCII characters a word at a time. This is
+    // retried after every non-ASCII character, so that mostly-ASCII
+    // strings do not fall back to the byte loop for their whole tail.
+    while ((i + (int)sizeof(uint64_t)) <= length && is_ascii_word(&buffer[i])) {
+      i += (int)sizeof(uint64_t);
+    }
+    if (i >= length) {
+      break;
+    }
     // no embedded zeros
     if (buffer[i] == 0) return false;
     if(buffer[i] < 128) {
@@ -79,6 +79,37 @@ Java_sun_nio_ch_EPoll_ctl(JNIEnv *env, jclass clazz, jint epfd,
     return (res == 0) ? 0 : errno;
 }
 
+/*
+ * Applies a batch of interest updates, so that a selector can queue its
+ * updates and apply them with one native call just before epoll_wait.
+ * The updates are consecutive (opcode, fd, events) triples of jints at
+ * address. The caller is expected to have coalesced the queue so that
+ * there is at most one update for each file descriptor.
+ *
+ * Returns count if all updates were applied. Otherwise the updates stop
+ * at the first one that failed, its index is returned and its events
+ * slot is overwritten with the errno value.
+ */
+JNIEXPORT jint JNICALL
+Java_sun_nio_ch_EPoll_ctlBatch(JNIEnv *env, jclass clazz, jint epfd,
+                               jlong address, jint count)
+{
+    jint *updates = jlong_to_ptr(address);
+    jint i;
+
+    for (i = 0; i < count; i++, updates += 3) {
+        struct epoll_event event;
+
+        event.events = updates[2];
+        event.data.fd = updates[1];
+        if (epoll_ctl(epfd, (int)updates[0], (int)updates[1], &event) != 0) {
+            updates[2] = errno;
+            return i;
+        }
+    }
+    return count;
+}
+
 JNIEXPORT jint JNICALL
 Java_sun_nio_ch_EPoll_wait(JNIEnv *env, jclass clazz, jint epfd,
                            jlong address, jint numfds, jint timeout)
@@ -163,8 +163,13 @@ void ImageDecompressor::decompress_resource(u1* compressed, u1* uncompressed,
         compressed_resource += 1;
         has_header = _header._magic == ResourceHeader::resource_header_magic;
         if (has_header) {
+            // The last decompressor of the stack produces the resource itself,
+            // let it write straight into the caller's buffer.
+            bool is_direct = _header._is_terminal == 1 &&
+                             _header._uncompressed_size == uncompressed_size;
             // decompressed_resource array contains the result of decompression
-            decompressed_resource = new u1[(size_t) _header._uncompressed_size];
+            decompressed_resource = is_direct ? uncompressed :
+                                    new u1[(size_t) _header._uncompressed_size];
             // Retrieve the decompressor name
             const char* decompressor_name = strings->get(_header._decompressor_name_offset);
             assert(decompressor_name && "image decompressor not found");
@@ -177,6 +182,9 @@ void ImageDecompressor::decompress_resource(u1* compressed, u1* uncompressed,
             if (compressed_resource_base != compressed) {
                 delete[] compressed_resource_base;
             }
+            if (is_direct) {
+                return;
+            }
             compressed_resource = decompressed_resource;
         }
     } while (has_header);
@@ -559,6 +559,9 @@ void ImageFileReader::get_resource(ImageLocation& location, u1* uncompressed_dat
         if (!memory_map_image) {
                 delete[] compressed_data;
         }
+    } else if (memory_map_image) {
+        // Copy bytes straight from the mapped image, no need for a read.
+        memcpy(uncompressed_data, get_data_address() + offset, (size_t)uncompressed_size);
     } else {
         // Read bytes from offset beyond the image index.
         bool is_read = read_at(uncompressed_data, uncompressed_size, _index_size + offset);
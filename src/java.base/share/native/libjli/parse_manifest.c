@@ -298,6 +298,7 @@ find_positions(int fd, Byte *eb, jlong* base_offset, jlong* censtart)
 
 #define BUFSIZE (3 * 65536 + CENHDR + SIGSIZ)
 #define MINREAD 1024
+#define MAXREAD 65536
 
 /*
  * Locate the manifest file with the zip/jar file.
@@ -325,6 +326,11 @@ find_positions(int fd, Byte *eb, jlong* base_offset, jlong* censtart)
  * In most cases, all that needs to be read are the first two entries in
  * a typical jar file (META-INF and META-INF/MANIFEST.MF). Keep this factoid
  * in mind when optimizing this code.
+ *
+ * So the first read is small, but each refill doubles the read size up
+ * to MAXREAD.  A jar whose manifest is placed late in a large Central
+ * Directory then costs a few dozen reads instead of thousands, which
+ * matters on network file systems.
  */
 static int
 find_file(int fd, zentry *entry, const char *file_name)
@@ -333,6 +339,7 @@ find_file(int fd, zentry *entry, const char *file_name)
     int     res;
     int     entry_size;
     int     read_size;
+    int     chunk_size = MINREAD;
 
     /*
      * The (imaginary) position within the file relative to which
@@ -392,7 +399,8 @@ find_file(int fd, zentry *entry, const char *file_name)
          */
         if (bytes < CENHDR) {
             p = memmove(bp, p, bytes);
-            if ((res = read(fd, bp + bytes, MINREAD)) <= 0) {
+            chunk_size = (chunk_size < MAXREAD) ? 2 * chunk_size : MAXREAD;
+            if ((res = read(fd, bp + bytes, chunk_size)) <= 0) {
                 free(buffer);
                 return (-1);
             }
@@ -402,8 +410,11 @@ find_file(int fd, zentry *entry, const char *file_name)
         if (bytes < entry_size + SIGSIZ) {
             if (p != bp)
                 p = memmove(bp, p, bytes);
+            chunk_size = (chunk_size < MAXREAD) ? 2 * chunk_size : MAXREAD;
             read_size = entry_size - bytes + SIGSIZ;
-            read_size = (read_size < MINREAD) ? MINREAD : read_size;
+            read_size = (read_size < chunk_size) ? chunk_size : read_size;
+            /* Never read past the end of the buffer. */
+            read_size = (read_size > BUFSIZE - bytes) ? BUFSIZE - bytes : read_size;
             if ((res = read(fd, bp + bytes,  read_size)) <= 0) {
                 free(buffer);
                 return (-1);
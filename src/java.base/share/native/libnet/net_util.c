@@ -74,6 +74,7 @@ DEF_JNI_OnLoad(JavaVM *vm, void *reserved)
     REUSEPORT_available = reuseport_supported();
     platformInit();
     parseExclusiveBindProperty(env);
+    parseLookupTimeoutProperty(env);
 
     return JNI_VERSION_1_2;
 }
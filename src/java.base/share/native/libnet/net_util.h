@@ -161,6 +161,8 @@ void platformInit();
 
 void parseExclusiveBindProperty(JNIEnv *env);
 
+void parseLookupTimeoutProperty(JNIEnv *env);
+
 JNIEXPORT jint JNICALL NET_GetPortFromSockaddr(SOCKETADDRESS *sa);
 
 JNIEXPORT jboolean JNICALL
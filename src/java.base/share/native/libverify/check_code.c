@@ -138,6 +138,9 @@ static void aix_free(void* p) {
 #define ALIGN_UP(n,align_grain) (((n) + ((align_grain) - 1)) & ~((align_grain)-1))
 #endif /* ALIGN_UP */
 #define UCALIGN(n) ((unsigned char *)ALIGN_UP((uintptr_t)(n),sizeof(int)))
+/* Methods share one code block. UCALIGN works on absolute addresses, so
+ * every method must start as aligned as a fresh malloc block would. */
+#define CODE_SLOT_SIZE(len) ALIGN_UP((size_t)(len) + 1, sizeof(jlong))
 
 #ifdef DEBUG
 
@@ -890,9 +893,6 @@ VerifyClassForMajorVersion(JNIEnv *env, jclass cb, char *buffer, jint len,
     GlobalContext = 0;
 #endif
 
-    if (context->exceptions)
-        free(context->exceptions);
-
     if (context->constant_types)
         free(context->constant_types);
 
@@ -951,6 +951,8 @@ read_all_code(context_type* context, jclass cb, int num_methods,
 {
     int* lengths;
     unsigned char** code;
+    unsigned char* all_code;
+    size_t total_length = 0;
     int i;
 
     lengths = malloc(sizeof(int) * num_methods);
@@ -965,9 +967,20 @@ read_all_code(context_type* context, jclass cb, int num_methods,
     for (i = 0; i < num_methods; ++i) {
         lengths[i] = JVM_GetMethodIxByteCodeLength(context->env, cb, i);
         if (lengths[i] > 0) {
-            code[i] = malloc(sizeof(unsigned char) * (lengths[i] + 1));
-            check_and_push(context, code[i], VM_MALLOC_BLK);
+            total_length += CODE_SLOT_SIZE(lengths[i]);
+        }
+    }
+
+    /* Keep the code of all methods in one block rather than one malloc
+     * per method. */
+    all_code = malloc(sizeof(unsigned char) * (total_length + 1));
+    check_and_push(context, all_code, VM_MALLOC_BLK);
+
+    for (i = 0; i < num_methods; ++i) {
+        if (lengths[i] > 0) {
+            code[i] = all_code;
             JVM_GetMethodIxByteCode(context->env, cb, i, code[i]);
+            all_code += CODE_SLOT_SIZE(lengths[i]);
         } else {
             code[i] = NULL;
         }
@@ -977,12 +990,7 @@ read_all_code(context_type* context, jclass cb, int num_methods,
 static void
 free_all_code(context_type* context, int num_methods, unsigned char** code)
 {
-  int i;
-  for (i = 0; i < num_methods; ++i) {
-      if (code[i] != NULL) {
-          pop_and_free(context);
-      }
-  }
+  pop_and_free(context); /* all_code */
   pop_and_free(context); /* code */
   pop_and_free(context); /* lengths */
 }
@@ -1104,10 +1112,7 @@ verify_method(context_type *context, jclass cb, int method_index,
 
     /* verify checked exceptions, if any */
     nexceptions = JVM_GetMethodIxExceptionsCount(env, cb, method_index);
-    context->exceptions = (unsigned short *)
-        malloc(sizeof(unsigned short) * nexceptions + 1);
-    if (context->exceptions == 0)
-        CCout_of_memory(context);
+    context->exceptions = NEW(unsigned short, nexceptions + 1);
     JVM_GetMethodIxExceptionIndexes(env, cb, method_index,
                                     context->exceptions);
     for (i = 0; i < nexceptions; i++) {
@@ -1115,7 +1120,6 @@ verify_method(context_type *context, jclass cb, int method_index,
         verify_constant_pool_type(context, (int)context->exceptions[i],
                                   1 << JVM_CONSTANT_Class);
     }
-    free(context->exceptions);
     context->exceptions = 0;
     context->code = 0;
     context->method_index = -1;
@@ -3252,7 +3256,9 @@ merge_stack(context_type *context, unsigned int from_inumber,
         stack_item_type *stack = this_idata->stack_info.stack;
         stack_item_type *old, *new;
         jboolean change = JNI_FALSE;
-        for (old = stack, new = new_stack; old != NULL;
+        /* Identical stacks can't add information. */
+        for (old = (stack == new_stack) ? NULL : stack, new = new_stack;
+                   old != NULL;
                    old = old->next, new = new->next) {
             if (!isAssignableTo(context, new->item, old->item)) {
                 change = JNI_TRUE;
@@ -3316,7 +3322,11 @@ merge_registers(context_type *context, unsigned int from_inumber,
             register_count = new_register_count;
             this_idata->changed = JNI_TRUE;
         }
-        for (i = 0; i < register_count; i++) {
+        /* Register sets are shared between instructions until one of them
+         * stores into a register, so this is often the very same set, and
+         * then nothing needs to be compared. */
+        for (i = (registers == new_registers) ? register_count : 0;
+             i < register_count; i++) {
             fullinfo_type prev_value = registers[i];
             if ((i < new_register_count)
                   ? (!isAssignableTo(context, new_registers[i], prev_value))
@@ -3567,14 +3577,20 @@ CCalloc(context_type *context, int size, jboolean zero)
         struct CCpool *current = context->CCcurrent;
         struct CCpool *new;
         if (size > CCSegSize) { /* we need to allocate a special block */
-            new = (struct CCpool *)malloc(sizeof(struct CCpool) +
-                                          (size - CCSegSize));
-            if (new == 0) {
-                CCout_of_memory(context);
+            new = current->next;
+            /* The heap is reinitialized for every method, so a special
+             * block left over from an earlier method is often big enough.
+             */
+            if (new == NULL || new->segSize < size) {
+                new = (struct CCpool *)malloc(sizeof(struct CCpool) +
+                                              (size - CCSegSize));
+                if (new == 0) {
+                    CCout_of_memory(context);
+                }
+                new->next = current->next;
+                new->segSize = size;
+                current->next = new;
             }
-            new->next = current->next;
-            new->segSize = size;
-            current->next = new;
         } else {
             new = current->next;
             if (new == NULL) {
@@ -571,6 +571,7 @@ readCEN(jzfile *zip, jint knownTotal)
     jlong endpos, end64pos, cenpos, cenlen, cenoff;
     /* Following are unsigned 16-bit */
     jint total, tablelen, i, j;
+    jint mask;
     unsigned char *cenbuf = NULL;
     unsigned char *cenend;
     unsigned char *cp;
@@ -682,7 +683,14 @@ readCEN(jzfile *zip, jint knownTotal)
      */
     total = (knownTotal != -1) ? knownTotal : total;
     entries  = zip->entries  = calloc(total, sizeof(entries[0]));
-    tablelen = zip->tablelen = ((total/2) | 1); // Odd -> fewer collisions
+    /* The table is open addressed with linear probing. Keep it a power
+     * of two and at most three quarters full, so that probe sequences
+     * stay short and a lookup touches only a few adjacent slots. */
+    for (tablelen = 1; tablelen < (jlong)total + total/3 + 1; tablelen <<= 1) {
+        if (tablelen > (INT_MAX >> 1)) goto Catch;
+    }
+    zip->tablelen = tablelen;
+    mask = tablelen - 1;
     table    = zip->table    = malloc(tablelen * sizeof(table[0]));
     /* According to ISO C it is perfectly legal for malloc to return zero
      * if called with a zero argument. We check this for 'entries' but not
@@ -729,9 +737,10 @@ readCEN(jzfile *zip, jint knownTotal)
         entries[i].cenpos = cenpos + (cp - cenbuf);
         entries[i].hash = hashN((char *)cp+CENHDR, nlen);
 
-        /* Add the entry to the hash table */
-        hsh = entries[i].hash % tablelen;
-        entries[i].next = table[hsh];
+        /* Add the entry to the first free slot of its probe sequence */
+        hsh = entries[i].hash & mask;
+        while (table[hsh] != ZIP_ENDCHAIN)
+            hsh = (hsh + 1) & mask;
         table[hsh] = i;
     }
     if (cp != cenend) {
@@ -1172,7 +1181,8 @@ jzentry *
 ZIP_GetEntry2(jzfile *zip, char *name, jint ulen, jboolean addSlash)
 {
     unsigned int hsh = hashN(name, ulen);
-    jint idx;
+    unsigned int mask;
+    unsigned int slot;
     jzentry *ze = 0;
 
     ZIP_Lock(zip);
@@ -1180,7 +1190,8 @@ ZIP_GetEntry2(jzfile *zip, char *name, jint ulen, jboolean addSlash)
         goto Finally;
     }
 
-    idx = zip->table[hsh % zip->tablelen];
+    mask = (unsigned int)zip->tablelen - 1;
+    slot = hsh & mask;
 
     /*
      * This while loop is an optimization where a double lookup
@@ -1201,11 +1212,12 @@ ZIP_GetEntry2(jzfile *zip, char *name, jint ulen, jboolean addSlash)
         ze = 0;
 
         /*
-         * Search down the target hash chain for a cell whose
-         * 32 bit hash matches the hashed name.
+         * Probe the table from the home slot of the hash until an
+         * empty slot, looking for a cell whose 32 bit hash matches
+         * the hashed name.
          */
-        while (idx != ZIP_ENDCHAIN) {
-            jzcell *zc = &zip->entries[idx];
+        while (zip->table[slot] != ZIP_ENDCHAIN) {
+            jzcell *zc = &zip->entries[zip->table[slot]];
 
             if (zc->hash == hsh) {
                 /*
@@ -1229,7 +1241,7 @@ ZIP_GetEntry2(jzfile *zip, char *name, jint ulen, jboolean addSlash)
                 }
                 ze = 0;
             }
-            idx = zc->next;
+            slot = (slot + 1) & mask;
         }
 
         /* Entry found, return it */
@@ -1251,7 +1263,7 @@ ZIP_GetEntry2(jzfile *zip, char *name, jint ulen, jboolean addSlash)
         name[ulen++] = '/';
         name[ulen] = '\0';
         hsh = hash_append(hsh, '/');
-        idx = zip->table[hsh % zip->tablelen];
+        slot = hsh & mask;
         addSlash = JNI_FALSE;
     }
 
@@ -1589,3 +1601,50 @@ ZIP_InflateFully(void *inBuf, jlong inLen, void *outBuf, jlong outLen, char **pm
     inflateEnd(&strm);
     return JNI_TRUE;
 }
+
+/*
+ * Compresses inBuf into outBuf as a single, complete gzip member. Members
+ * written one after another form a valid gzip file. Returns the number of
+ * bytes written to outBuf, or 0 if the data did not fit or an error
+ * occurred, in which case *pmsg points to an error message.
+ */
+JNIEXPORT jlong
+ZIP_GZip_Fully(void *inBuf, jlong inLen, void *outBuf, jlong outLen, jint level, char **pmsg)
+{
+    z_stream strm;
+    jlong result;
+    memset(&strm, 0, sizeof(z_stream));
+
+    *pmsg = 0; /* Reset error message */
+
+    /* windowBits of 16 + MAX_WBITS selects the gzip wrapper, 8 is the
+     * default memLevel of deflateInit */
+    if (deflateInit2(&strm, level, Z_DEFLATED, 16 + MAX_WBITS,
+                     8, Z_DEFAULT_STRATEGY) != Z_OK) {
+        *pmsg = strm.msg != NULL ? strm.msg : "ZIP_GZip_Fully: cannot initialize";
+        return 0;
+    }
+
+    strm.next_out = (Bytef *) outBuf;
+    strm.avail_out = (uInt)outLen;
+    strm.next_in = (Bytef *) inBuf;
+    strm.avail_in = (uInt)inLen;
+
+    switch (deflate(&strm, Z_FINISH)) {
+        case Z_STREAM_END:
+            result = (jlong)strm.total_out;
+            break;
+        case Z_OK:
+        case Z_BUF_ERROR:
+            *pmsg = "ZIP_GZip_Fully: output buffer too small";
+            result = 0;
+            break;
+        default:
+            *pmsg = "ZIP_GZip_Fully: internal error";
+            result = 0;
+            break;
+    }
+
+    deflateEnd(&strm);
+    return result;
+}
@@ -36,6 +36,69 @@
 #  pragma message("Assembler code may have bugs -- use at your own risk")
 #else
 
+/* Copies shorter than this are done byte by byte, where a memcpy call
+   costs more than it saves. */
+#define CHUNK_COPY_MIN 16
+
+local unsigned char FAR *copy_bytes OF((unsigned char FAR *out,
+                                        unsigned char FAR *from,
+                                        unsigned len));
+local unsigned char FAR *copy_match OF((unsigned char FAR *out,
+                                        unsigned dist, unsigned len));
+
+/*
+   Copy len bytes, len > 0, from the window to the output, which do not
+   overlap. Returns the new output position.
+ */
+local unsigned char FAR *copy_bytes(out, from, len)
+unsigned char FAR *out;
+unsigned char FAR *from;
+unsigned len;
+{
+    if (len < CHUNK_COPY_MIN) {
+        do {
+            *out++ = *from++;
+        } while (--len);
+        return out;
+    }
+    zmemcpy(out, from, len);
+    return out + len;
+}
+
+/*
+   Copy a match of len bytes, len > 2, that starts dist bytes back in the
+   output. When dist is less than len, the match repeats the last dist bytes
+   and a single copy would overlap its source. It is then copied in chunks
+   that do not overlap: each chunk doubles the repeated string in front of
+   out, so the next chunk can be twice as long. The result is the same as
+   copying byte by byte. Returns the new output position.
+ */
+local unsigned char FAR *copy_match(out, dist, len)
+unsigned char FAR *out;
+unsigned dist;
+unsigned len;
+{
+    unsigned char FAR *from;
+    unsigned chunk;
+
+    from = out - dist;
+    if (len < CHUNK_COPY_MIN) {
+        do {
+            *out++ = *from++;
+        } while (--len);
+        return out;
+    }
+    do {
+        chunk = (unsigned)(out - from);
+        if (chunk > len)
+            chunk = len;
+        zmemcpy(out, from, chunk);
+        out += chunk;
+        len -= chunk;
+    } while (len);
+    return out;
+}
+
 /*
    Decode literal, length, and distance codes and write out the resulting
    literal and match bytes until either not enough input or output is
@@ -225,9 +288,7 @@ unsigned start;         /* inflate()'s starting value for strm->avail_out */
                         from += wsize - op;
                         if (op < len) {         /* some from window */
                             len -= op;
-                            do {
-                                *out++ = *from++;
-                            } while (--op);
+                            out = copy_bytes(out, from, op);
                             from = out - dist;  /* rest from output */
                         }
                     }
@@ -236,16 +297,12 @@ unsigned start;         /* inflate()'s starting value for strm->avail_out */
                         op -= wnext;
                         if (op < len) {         /* some from end of window */
                             len -= op;
-                            do {
-                                *out++ = *from++;
-                            } while (--op);
+                            out = copy_bytes(out, from, op);
                             from = window;
                             if (wnext < len) {  /* some from start of window */
                                 op = wnext;
                                 len -= op;
-                                do {
-                                    *out++ = *from++;
-                                } while (--op);
+                                out = copy_bytes(out, from, op);
                                 from = out - dist;      /* rest from output */
                             }
                         }
@@ -254,9 +311,7 @@ unsigned start;         /* inflate()'s starting value for strm->avail_out */
                         from += wnext - op;
                         if (op < len) {         /* some from window */
                             len -= op;
-                            do {
-                                *out++ = *from++;
-                            } while (--op);
+                            out = copy_bytes(out, from, op);
                             from = out - dist;  /* rest from output */
                         }
                     }
@@ -273,18 +328,8 @@ unsigned start;         /* inflate()'s starting value for strm->avail_out */
                     }
                 }
                 else {
-                    from = out - dist;          /* copy direct from output */
-                    do {                        /* minimum length is three */
-                        *out++ = *from++;
-                        *out++ = *from++;
-                        *out++ = *from++;
-                        len -= 3;
-                    } while (len > 2);
-                    if (len) {
-                        *out++ = *from++;
-                        if (len > 1)
-                            *out++ = *from++;
-                    }
+                    /* copy direct from output, minimum length is three */
+                    out = copy_match(out, dist, len);
                 }
             }
             else if ((op & 64) == 0) {          /* 2nd level distance code */
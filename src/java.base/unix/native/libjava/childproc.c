@@ -31,6 +31,14 @@
 #include <unistd.h>
 #include <limits.h>
 
+#if defined(__linux__)
+#include <sys/syscall.h>
+#ifndef __NR_close_range
+/* close_range has the same number on all architectures we support */
+#define __NR_close_range 436
+#endif
+#endif
+
 #include "childproc.h"
 
 
@@ -83,6 +91,13 @@ closeDescriptors(void)
     struct dirent *dirp;
     int from_fd = FAIL_FILENO + 1;
 
+#if defined(__linux__)
+    /* Since Linux 5.9 all of them can be closed with one system call,
+     * however many descriptors the parent has open. */
+    if (syscall(__NR_close_range, from_fd, ~0U, 0) == 0)
+        return 1;
+#endif
+
     /* We're trying to close all file descriptors, but opendir() might
      * itself be implemented using a file descriptor, and we certainly
      * don't want to close that while it's in use.  We assume that if
@@ -125,7 +125,7 @@ Java_java_net_Inet4AddressImpl_lookupAllHostAddr(JNIEnv *env, jobject this,
     hints.ai_flags = AI_CANONNAME;
     hints.ai_family = AF_INET;
 
-    error = getaddrinfo(hostname, NULL, &hints, &res);
+    error = NET_GetAddrInfo(hostname, &hints, &res);
 
     if (error) {
 #if defined(MACOSX)
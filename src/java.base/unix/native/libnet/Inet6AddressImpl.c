@@ -245,7 +245,7 @@ Java_java_net_Inet6AddressImpl_lookupAllHostAddr(JNIEnv *env, jobject this,
     hints.ai_flags = AI_CANONNAME;
     hints.ai_family = AF_UNSPEC;
 
-    error = getaddrinfo(hostname, NULL, &hints, &res);
+    error = NET_GetAddrInfo(hostname, &hints, &res);
 
     if (error) {
 #if defined(MACOSX)
@@ -34,7 +34,10 @@
 #if defined(__linux__)
 #include <arpa/inet.h>
 #include <net/route.h>
+#include <pthread.h>
+#include <signal.h>
 #include <sys/utsname.h>
+#include <time.h>
 #endif
 
 #if defined(__solaris__)
@@ -755,6 +758,198 @@ void parseExclusiveBindProperty(JNIEnv *env) {
 #endif
 }
 
+/*
+ * Host name lookups are bounded by sun.net.inetaddr.lookupTimeout
+ * milliseconds, if that is set and the platform has asynchronous
+ * lookups. Otherwise they block until the resolver gives up.
+ */
+static int lookupTimeout = 0;
+
+#if defined(__linux__) && defined(GAI_NOWAIT)
+/* glibc has getaddrinfo_a in libanl before 2.34, look it up at runtime */
+typedef int getaddrinfo_a_func(int mode, struct gaicb *list[], int nitems,
+                               struct sigevent *sevp);
+typedef int gai_suspend_func(const struct gaicb * const list[], int nitems,
+                             const struct timespec *timeout);
+typedef int gai_cancel_func(struct gaicb *req);
+typedef int gai_error_func(struct gaicb *req);
+
+static getaddrinfo_a_func* my_getaddrinfo_a = NULL;
+static gai_suspend_func* my_gai_suspend = NULL;
+static gai_cancel_func* my_gai_cancel = NULL;
+static gai_error_func* my_gai_error = NULL;
+
+static int initAsyncLookup() {
+    void *handle = RTLD_DEFAULT;
+    if (dlsym(handle, "getaddrinfo_a") == NULL) {
+        handle = dlopen("libanl.so.1", RTLD_LAZY);
+        if (handle == NULL) {
+            return 0;
+        }
+    }
+    my_getaddrinfo_a = (getaddrinfo_a_func*)dlsym(handle, "getaddrinfo_a");
+    my_gai_suspend = (gai_suspend_func*)dlsym(handle, "gai_suspend");
+    my_gai_cancel = (gai_cancel_func*)dlsym(handle, "gai_cancel");
+    my_gai_error = (gai_error_func*)dlsym(handle, "gai_error");
+    return my_getaddrinfo_a != NULL && my_gai_suspend != NULL &&
+           my_gai_cancel != NULL && my_gai_error != NULL;
+}
+
+/* A lookup in flight, it has to stay allocated until the lookup is done */
+typedef struct asyncLookup {
+    struct gaicb cb;
+    struct addrinfo hints;
+    struct asyncLookup *next;
+    char hostname[1];
+} asyncLookup;
+
+/*
+ * Lookups that timed out and could not be cancelled. They are freed,
+ * with their results, by a later lookup once the resolver is done.
+ */
+static pthread_mutex_t abandonedLookupsLock = PTHREAD_MUTEX_INITIALIZER;
+static asyncLookup *abandonedLookups = NULL;
+
+static void freeLookup(asyncLookup *lookup) {
+    if (lookup->cb.ar_result != NULL) {
+        freeaddrinfo(lookup->cb.ar_result);
+    }
+    free(lookup);
+}
+
+static void abandonLookup(asyncLookup *lookup) {
+    pthread_mutex_lock(&abandonedLookupsLock);
+    lookup->next = abandonedLookups;
+    abandonedLookups = lookup;
+    pthread_mutex_unlock(&abandonedLookupsLock);
+}
+
+static void freeAbandonedLookups() {
+    asyncLookup **prev;
+    pthread_mutex_lock(&abandonedLookupsLock);
+    prev = &abandonedLookups;
+    while (*prev != NULL) {
+        asyncLookup *lookup = *prev;
+        if ((*my_gai_error)(&lookup->cb) != EAI_INPROGRESS) {
+            *prev = lookup->next;
+            freeLookup(lookup);
+        } else {
+            prev = &lookup->next;
+        }
+    }
+    pthread_mutex_unlock(&abandonedLookupsLock);
+}
+
+static int asyncGetAddrInfo(const char *hostname, const struct addrinfo *hints,
+                            struct addrinfo **res) {
+    struct gaicb *list[1];
+    struct timespec deadline;
+    int error;
+    asyncLookup *lookup;
+
+    freeAbandonedLookups();
+
+    lookup = (asyncLookup *)malloc(sizeof(asyncLookup) + strlen(hostname));
+    if (lookup == NULL) {
+        return EAI_MEMORY;
+    }
+    memset(lookup, 0, sizeof(asyncLookup));
+    strcpy(lookup->hostname, hostname);
+    lookup->hints = *hints;
+    lookup->cb.ar_name = lookup->hostname;
+    lookup->cb.ar_request = &lookup->hints;
+    list[0] = &lookup->cb;
+
+    error = (*my_getaddrinfo_a)(GAI_NOWAIT, list, 1, NULL);
+    if (error != 0) {
+        free(lookup);
+        return error;
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &deadline);
+    deadline.tv_sec += lookupTimeout / 1000;
+    deadline.tv_nsec += (lookupTimeout % 1000) * 1000000L;
+    if (deadline.tv_nsec >= 1000000000L) {
+        deadline.tv_sec++;
+        deadline.tv_nsec -= 1000000000L;
+    }
+    while ((error = (*my_gai_error)(&lookup->cb)) == EAI_INPROGRESS) {
+        struct timespec now, timeout;
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        timeout.tv_sec = deadline.tv_sec - now.tv_sec;
+        timeout.tv_nsec = deadline.tv_nsec - now.tv_nsec;
+        if (timeout.tv_nsec < 0) {
+            timeout.tv_sec--;
+            timeout.tv_nsec += 1000000000L;
+        }
+        if (timeout.tv_sec < 0) {
+            if ((*my_gai_cancel)(&lookup->cb) == EAI_NOTCANCELED) {
+                /* Still running in the resolver thread, a later
+                   lookup frees it and its result */
+                abandonLookup(lookup);
+                return EAI_AGAIN;
+            }
+            /* cancelled or done, gai_error tells which */
+            continue;
+        }
+        /* EAI_INTR and EAI_AGAIN go round again, with the time left */
+        (*my_gai_suspend)((const struct gaicb * const *)list, 1, &timeout);
+    }
+    if (error == 0) {
+        *res = lookup->cb.ar_result;
+        lookup->cb.ar_result = NULL;
+    } else if (error == EAI_CANCELED) {
+        error = EAI_AGAIN;
+    }
+    freeLookup(lookup);
+    return error;
+}
+#endif
+
+void parseLookupTimeoutProperty(JNIEnv *env) {
+#if defined(__linux__) && defined(GAI_NOWAIT)
+    jclass iCls;
+    jmethodID mid;
+    jstring s;
+    jint timeout;
+
+    iCls = (*env)->FindClass(env, "java/lang/Integer");
+    CHECK_NULL(iCls);
+    mid = (*env)->GetStaticMethodID(env, iCls, "getInteger",
+                "(Ljava/lang/String;I)Ljava/lang/Integer;");
+    CHECK_NULL(mid);
+    s = (*env)->NewStringUTF(env, "sun.net.inetaddr.lookupTimeout");
+    CHECK_NULL(s);
+    {
+        jobject value = (*env)->CallStaticObjectMethod(env, iCls, mid, s, 0);
+        jmethodID intValue;
+        if ((*env)->ExceptionCheck(env) || value == NULL) {
+            return;
+        }
+        intValue = (*env)->GetMethodID(env, iCls, "intValue", "()I");
+        CHECK_NULL(intValue);
+        timeout = (*env)->CallIntMethod(env, value, intValue);
+    }
+    if (timeout > 0 && initAsyncLookup()) {
+        lookupTimeout = timeout;
+    }
+#endif
+}
+
+/*
+ * getaddrinfo, bounded by the lookup timeout if there is one.
+ * On timeout EAI_AGAIN is returned.
+ */
+int NET_GetAddrInfo(const char *hostname, const struct addrinfo *hints,
+                    struct addrinfo **res) {
+#if defined(__linux__) && defined(GAI_NOWAIT)
+    if (lookupTimeout > 0) {
+        return asyncGetAddrInfo(hostname, hints, res);
+    }
+#endif
+    return getaddrinfo(hostname, NULL, hints, res);
+}
+
 JNIEXPORT jint JNICALL
 NET_EnableFastTcpLoopback(int fd) {
     return 0;
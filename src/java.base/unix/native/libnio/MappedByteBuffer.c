@@ -29,6 +29,7 @@
 #include "jlong.h"
 #include "java_nio_MappedByteBuffer.h"
 #include <assert.h>
+#include <errno.h>
 #include <sys/mman.h>
 #include <stddef.h>
 #include <stdlib.h>
@@ -44,6 +45,15 @@ typedef unsigned char mincore_vec_t;
 typedef char mincore_vec_t;
 #endif
 
+/* Access pattern hints for advise0, must match the constants
+ * in java.nio.MappedByteBuffer */
+#define ADVICE_NORMAL       0
+#define ADVICE_SEQUENTIAL   1
+#define ADVICE_RANDOM       2
+#define ADVICE_WILLNEED     3
+#define ADVICE_DONTNEED     4
+#define ADVICE_HUGEPAGE     5
+
 #ifdef _AIX
 static long calculate_number_of_pages_in_range(void* address, size_t len, size_t pagesize) {
     uintptr_t address_unaligned = (uintptr_t) address;
@@ -125,3 +135,58 @@ Java_java_nio_MappedByteBuffer_force0(JNIEnv *env, jobject obj, jobject fdo,
         JNU_ThrowIOExceptionWithLastError(env, "msync failed");
     }
 }
+
+
+/*
+ * Schedules the write back of a range without waiting for it. A later
+ * force0 of the range then only has to wait for what is still pending.
+ */
+JNIEXPORT void JNICALL
+Java_java_nio_MappedByteBuffer_forceAsync0(JNIEnv *env, jobject obj, jobject fdo,
+                                           jlong address, jlong len)
+{
+    void* a = (void *)jlong_to_ptr(address);
+    int result = msync(a, (size_t)len, MS_ASYNC);
+    if (result == -1) {
+        JNU_ThrowIOExceptionWithLastError(env, "msync failed");
+    }
+}
+
+
+/*
+ * Passes an access pattern hint for a page aligned range to the kernel.
+ * Hints the platform does not know are ignored, returns JNI_FALSE in
+ * that case.
+ */
+JNIEXPORT jboolean JNICALL
+Java_java_nio_MappedByteBuffer_advise0(JNIEnv *env, jobject obj, jlong address,
+                                       jlong len, jint advice)
+{
+    char *a = (char *)jlong_to_ptr(address);
+    int result;
+    int native_advice;
+
+    switch (advice) {
+    case ADVICE_NORMAL:     native_advice = MADV_NORMAL;     break;
+    case ADVICE_SEQUENTIAL: native_advice = MADV_SEQUENTIAL; break;
+    case ADVICE_RANDOM:     native_advice = MADV_RANDOM;     break;
+    case ADVICE_WILLNEED:   native_advice = MADV_WILLNEED;   break;
+    case ADVICE_DONTNEED:   native_advice = MADV_DONTNEED;   break;
+#ifdef MADV_HUGEPAGE
+    case ADVICE_HUGEPAGE:   native_advice = MADV_HUGEPAGE;   break;
+#endif
+    default:
+        return JNI_FALSE;
+    }
+
+    result = madvise((caddr_t)a, (size_t)len, native_advice);
+    if (result == -1) {
+        if (errno == EINVAL) {
+            /* e.g. huge pages are not enabled for this mapping */
+            return JNI_FALSE;
+        }
+        JNU_ThrowIOExceptionWithLastError(env, "madvise failed");
+        return JNI_FALSE;
+    }
+    return JNI_TRUE;
+}
@@ -117,3 +117,99 @@ Java_sun_nio_ch_DatagramDispatcher_writev0(JNIEnv *env, jclass clazz,
     }
     return convertLongReturnVal(env, (jlong)result, JNI_FALSE);
 }
+
+/*
+ * Datagrams moved per batched call, larger batches are truncated and
+ * reported as partial.
+ */
+#define MAX_BATCH 64
+
+/*
+ * Receives up to count datagrams into the buffers described by an array
+ * of iovecs at address, one buffer per datagram. Waits for the first
+ * datagram only. The iov_len of each filled buffer is set to the size
+ * of its datagram, and the number of datagrams is returned.
+ */
+JNIEXPORT jint JNICALL
+Java_sun_nio_ch_DatagramDispatcher_readBatch0(JNIEnv *env, jclass clazz,
+                              jobject fdo, jlong address, jint count)
+{
+    jint fd = fdval(env, fdo);
+    struct iovec *iov = (struct iovec *)jlong_to_ptr(address);
+    int result;
+    if (count > MAX_BATCH) {
+        count = MAX_BATCH;
+    }
+#if defined(__linux__) && defined(MSG_WAITFORONE)
+    {
+        struct mmsghdr msgs[MAX_BATCH];
+        int i;
+        memset(msgs, 0, sizeof(msgs[0]) * count);
+        for (i = 0; i < count; i++) {
+            msgs[i].msg_hdr.msg_iov = &iov[i];
+            msgs[i].msg_hdr.msg_iovlen = 1;
+        }
+        result = recvmmsg(fd, msgs, count, MSG_WAITFORONE, NULL);
+        for (i = 0; i < result; i++) {
+            iov[i].iov_len = msgs[i].msg_len;
+        }
+    }
+#else
+    /* Only the first datagram may wait, which one recv cannot express
+       without changing the blocking mode, so receive just one */
+    result = recv(fd, iov[0].iov_base, iov[0].iov_len, 0);
+    if (result >= 0) {
+        iov[0].iov_len = result;
+        result = 1;
+    }
+#endif
+    if (result < 0 && errno == ECONNREFUSED) {
+        JNU_ThrowByName(env, JNU_JAVANETPKG "PortUnreachableException", 0);
+        return -2;
+    }
+    return convertReturnVal(env, result, JNI_TRUE);
+}
+
+/*
+ * Sends the buffers described by an array of count iovecs at address,
+ * each one as a datagram of its own. Returns the number of datagrams
+ * sent, which is less than count if the socket buffer filled up.
+ */
+JNIEXPORT jint JNICALL
+Java_sun_nio_ch_DatagramDispatcher_writeBatch0(JNIEnv *env, jclass clazz,
+                              jobject fdo, jlong address, jint count)
+{
+    jint fd = fdval(env, fdo);
+    struct iovec *iov = (struct iovec *)jlong_to_ptr(address);
+    int result;
+    if (count > MAX_BATCH) {
+        count = MAX_BATCH;
+    }
+#if defined(__linux__) && defined(MSG_WAITFORONE)
+    {
+        struct mmsghdr msgs[MAX_BATCH];
+        int i;
+        memset(msgs, 0, sizeof(msgs[0]) * count);
+        for (i = 0; i < count; i++) {
+            msgs[i].msg_hdr.msg_iov = &iov[i];
+            msgs[i].msg_hdr.msg_iovlen = 1;
+        }
+        result = sendmmsg(fd, msgs, count, 0);
+    }
+#else
+    {
+        int i;
+        for (i = 0; i < count; i++) {
+            if (send(fd, iov[i].iov_base, iov[i].iov_len, 0) < 0) {
+                break;
+            }
+        }
+        result = (i > 0) ? i : -1;
+    }
+#endif
+    if (result < 0 && errno == ECONNREFUSED) {
+        JNU_ThrowByName(env, JNU_JAVANETPKG "PortUnreachableException", 0);
+        return -2;
+    }
+    return convertReturnVal(env, result, JNI_FALSE);
+}
@@ -31,6 +31,11 @@
 
 #if defined(__linux__) || defined(__solaris__)
 #include <sys/sendfile.h>
+#endif
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <stdlib.h>
 #elif defined(_AIX)
 #include <sys/socket.h>
 #elif defined(_ALLBSD_SOURCE)
@@ -50,6 +55,71 @@
 
 static jfieldID chan_fd;        /* jobject 'fd' in sun.nio.ch.FileChannelImpl */
 
+#if defined(__linux__)
+/* Number of bytes moved through the splice pipe at a time, the default
+   capacity of a pipe */
+#define SPLICE_CHUNK (64 * 1024)
+
+static pthread_key_t splice_pipe_key;
+static pthread_once_t splice_pipe_once = PTHREAD_ONCE_INIT;
+static int splice_pipe_key_ok = 0;
+
+static void
+splice_pipe_destroy(void *p)
+{
+    int *fds = (int *)p;
+    close(fds[0]);
+    close(fds[1]);
+    free(fds);
+}
+
+static void
+splice_pipe_init(void)
+{
+    splice_pipe_key_ok = (pthread_key_create(&splice_pipe_key, splice_pipe_destroy) == 0);
+}
+
+/*
+ * Returns the calling thread's splice pipe, creating it on first use,
+ * or NULL if no pipe is available. The pipe is closed when the thread
+ * terminates.
+ */
+static int *
+splice_pipe(void)
+{
+    int *fds;
+    pthread_once(&splice_pipe_once, splice_pipe_init);
+    if (!splice_pipe_key_ok)
+        return NULL;
+    fds = (int *)pthread_getspecific(splice_pipe_key);
+    if (fds == NULL) {
+        fds = (int *)malloc(2 * sizeof(int));
+        if (fds == NULL)
+            return NULL;
+        if (pipe(fds) != 0) {
+            free(fds);
+            return NULL;
+        }
+        if (pthread_setspecific(splice_pipe_key, fds) != 0) {
+            splice_pipe_destroy(fds);
+            return NULL;
+        }
+    }
+    return fds;
+}
+
+/*
+ * Discards a pipe that could not be drained, the next transfer on this
+ * thread gets a fresh one.
+ */
+static void
+splice_pipe_reset(int *fds)
+{
+    pthread_setspecific(splice_pipe_key, NULL);
+    splice_pipe_destroy(fds);
+}
+#endif
+
 JNIEXPORT jlong JNICALL
 Java_sun_nio_ch_FileChannelImpl_initIDs(JNIEnv *env, jclass clazz)
 {
@@ -245,3 +315,61 @@ Java_sun_nio_ch_FileChannelImpl_transferTo0(JNIEnv *env, jobject this,
 #endif
 }
 
+/*
+ * Moves up to count bytes from the current position of srcFDO, typically
+ * a socket, to position in the file dstFDO without copying them through
+ * user space. The bytes are spliced into a per-thread pipe and from there
+ * into the file. At most one pipe full is moved per call, so just like a
+ * read this only waits for the first bytes to arrive.
+ */
+JNIEXPORT jlong JNICALL
+Java_sun_nio_ch_FileChannelImpl_transferFrom0(JNIEnv *env, jobject this,
+                                              jobject srcFDO, jobject dstFDO,
+                                              jlong position, jlong count)
+{
+#if defined(__linux__)
+    jint srcFD = fdval(env, srcFDO);
+    jint dstFD = fdval(env, dstFDO);
+    loff_t offset = (loff_t)position;
+    size_t len = (count > SPLICE_CHUNK) ? SPLICE_CHUNK : (size_t)count;
+    jlong total = 0;
+    ssize_t n;
+    int *fds;
+
+    if ((fds = splice_pipe()) == NULL)
+        return IOS_UNSUPPORTED_CASE;
+
+    n = splice(srcFD, NULL, fds[1], NULL, len, SPLICE_F_MOVE);
+    if (n < 0) {
+        if (errno == EAGAIN)
+            return IOS_UNAVAILABLE;
+        if (errno == EINVAL)
+            return IOS_UNSUPPORTED_CASE;
+        if (errno == EINTR)
+            return IOS_INTERRUPTED;
+        JNU_ThrowIOExceptionWithLastError(env, "Transfer failed");
+        return IOS_THROWN;
+    }
+    if (n == 0)
+        return IOS_EOF;
+
+    /* The pipe has to be drained completely, the bytes are already gone
+       from the source. */
+    while (total < n) {
+        ssize_t m = splice(fds[0], NULL, dstFD, &offset, (size_t)(n - total),
+                           SPLICE_F_MOVE);
+        if (m < 0) {
+            if (errno == EINTR)
+                continue;
+            splice_pipe_reset(fds);
+            JNU_ThrowIOExceptionWithLastError(env, "Transfer failed");
+            return IOS_THROWN;
+        }
+        total += m;
+    }
+    return total;
+#else
+    return IOS_UNSUPPORTED_CASE;
+#endif
+}
+
@@ -62,6 +62,48 @@
 static int preCloseFD = -1;     /* File descriptor to which we dup other fd's
                                    before closing them for real */
 
+#if !defined(__linux__)
+/*
+ * Positional vectored I/O is not available everywhere, emulate it with
+ * one pread/pwrite per buffer, stopping at the first short transfer.
+ */
+static ssize_t
+preadv64(int fd, const struct iovec *iov, int iovcnt, off64_t offset)
+{
+    ssize_t total = 0;
+    int i;
+    for (i = 0; i < iovcnt; i++) {
+        ssize_t n = pread64(fd, iov[i].iov_base, iov[i].iov_len, offset + total);
+        if (n < 0) {
+            return (total > 0) ? total : n;
+        }
+        total += n;
+        if ((size_t)n < iov[i].iov_len) {
+            break;
+        }
+    }
+    return total;
+}
+
+static ssize_t
+pwritev64(int fd, const struct iovec *iov, int iovcnt, off64_t offset)
+{
+    ssize_t total = 0;
+    int i;
+    for (i = 0; i < iovcnt; i++) {
+        ssize_t n = pwrite64(fd, iov[i].iov_base, iov[i].iov_len, offset + total);
+        if (n < 0) {
+            return (total > 0) ? total : n;
+        }
+        total += n;
+        if ((size_t)n < iov[i].iov_len) {
+            break;
+        }
+    }
+    return total;
+}
+#endif
+
 
 JNIEXPORT void JNICALL
 Java_sun_nio_ch_FileDispatcherImpl_init(JNIEnv *env, jclass cl)
@@ -104,6 +146,15 @@ Java_sun_nio_ch_FileDispatcherImpl_readv0(JNIEnv *env, jclass clazz,
     return convertLongReturnVal(env, readv(fd, iov, len), JNI_TRUE);
 }
 
+JNIEXPORT jlong JNICALL
+Java_sun_nio_ch_FileDispatcherImpl_preadv0(JNIEnv *env, jclass clazz,
+                              jobject fdo, jlong address, jint len, jlong offset)
+{
+    jint fd = fdval(env, fdo);
+    struct iovec *iov = (struct iovec *)jlong_to_ptr(address);
+    return convertLongReturnVal(env, preadv64(fd, iov, len, offset), JNI_TRUE);
+}
+
 JNIEXPORT jint JNICALL
 Java_sun_nio_ch_FileDispatcherImpl_write0(JNIEnv *env, jclass clazz,
                               jobject fdo, jlong address, jint len)
@@ -133,6 +184,15 @@ Java_sun_nio_ch_FileDispatcherImpl_writev0(JNIEnv *env, jclass clazz,
     return convertLongReturnVal(env, writev(fd, iov, len), JNI_FALSE);
 }
 
+JNIEXPORT jlong JNICALL
+Java_sun_nio_ch_FileDispatcherImpl_pwritev0(JNIEnv *env, jclass clazz,
+                              jobject fdo, jlong address, jint len, jlong offset)
+{
+    jint fd = fdval(env, fdo);
+    struct iovec *iov = (struct iovec *)jlong_to_ptr(address);
+    return convertLongReturnVal(env, pwritev64(fd, iov, len, offset), JNI_FALSE);
+}
+
 static jlong
 handle(JNIEnv *env, jlong rv, char *msg)
 {
@@ -128,6 +128,7 @@ DllMain(HINSTANCE hinst, DWORD reason, LPVOID reserved)
 
 void platformInit() {}
 void parseExclusiveBindProperty(JNIEnv *env) {}
+void parseLookupTimeoutProperty(JNIEnv *env) {}
 
 /*
  * Since winsock doesn't have the equivalent of strerror(errno)
@@ -23,8 +23,62 @@
  * questions.
  */
 
+#include <stdlib.h>
+
 #include "GraphicsPrimitiveMgr.h"
 
+#if defined(__SSE2__) || defined(_M_X64)
+
+extern MaskFillFunc IntArgbPreSrcOverMaskFill;
+extern MaskFillFunc sse2_IntArgbPreSrcOverMaskFill;
+extern BlitFunc IntArgbToIntArgbPreConvert;
+extern BlitFunc sse2_IntArgbToIntArgbPreConvert;
+
+typedef struct {
+    AnyFunc *func_c;
+    AnyFunc *func_sse2;
+} AnyFunc_pair;
+
+static AnyFunc_pair sse2_func_pair_array[] = {
+    { (AnyFunc *) IntArgbPreSrcOverMaskFill,
+      (AnyFunc *) sse2_IntArgbPreSrcOverMaskFill },
+    { (AnyFunc *) IntArgbToIntArgbPreConvert,
+      (AnyFunc *) sse2_IntArgbToIntArgbPreConvert },
+};
+
+#define NUM_SSE2_FUNCS sizeof(sse2_func_pair_array)/sizeof(AnyFunc_pair)
+
+static int initialized;
+static int usesse2 = JNI_TRUE;
+
+/*
+ * This function returns a pointer to the SSE2 version of the
+ * indicated C function if there is one, the SSE2 loops produce
+ * exactly the same pixels. They can be turned off by setting the
+ * environment variable J2D_USE_SSE2_LOOPS to false.
+ */
+AnyFunc *MapAccelFunction(AnyFunc *c_func) {
+    size_t i;
+
+    if (!initialized) {
+        char *sse2_env = getenv("J2D_USE_SSE2_LOOPS");
+        if (sse2_env != NULL && (*sse2_env == 'f' || *sse2_env == 'F')) {
+            usesse2 = JNI_FALSE;
+        }
+        initialized = 1;
+    }
+    if (usesse2) {
+        for (i = 0; i < NUM_SSE2_FUNCS; i++) {
+            if (sse2_func_pair_array[i].func_c == c_func) {
+                return sse2_func_pair_array[i].func_sse2;
+            }
+        }
+    }
+    return c_func;
+}
+
+#else
+
 /*
  * This is a dummy function that satisfies the MapAccelFunction
  * contract by simply returning a pointer to the indicated
@@ -35,3 +89,5 @@
 AnyFunc *MapAccelFunction(AnyFunc *c_func) {
     return c_func;
 }
+
+#endif
@@ -0,0 +1,208 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+#if defined(__SSE2__) || defined(_M_X64)
+
+#include <string.h>
+#include <emmintrin.h>
+
+#include "GraphicsPrimitiveMgr.h"
+#include "AlphaMath.h"
+
+/*
+ * SSE2 versions of the hottest IntArgbPre loops. They compute exactly
+ * the same pixels as the loops generated by the macros in AlphaMacros.h
+ * and LoopMacros.h, and are substituted for them by MapAccelFunction.
+ *
+ * The pixel components are unpacked into 16 bit lanes, two pixels per
+ * register. MUL8(a, b) is computed without the multiplication table as
+ * (t + (t >> 8)) >> 8 with t = a * b + 128, which gives the same value
+ * as mul8table[a][b] for all a and b in [0, 255].
+ */
+
+static __m128i
+mul8_epi16(__m128i a, __m128i b)
+{
+    __m128i t = _mm_add_epi16(_mm_mullo_epi16(a, b), _mm_set1_epi16(128));
+    return _mm_srli_epi16(_mm_add_epi16(t, _mm_srli_epi16(t, 8)), 8);
+}
+
+/* Broadcasts the alpha lane of each of the two pixels to its four lanes */
+static __m128i
+alpha_epi16(__m128i p)
+{
+    return _mm_shufflehi_epi16(_mm_shufflelo_epi16(p, 0xff), 0xff);
+}
+
+/*
+ * Blends two premultiplied source pixels over two premultiplied
+ * destination pixels, res = src + MUL8(0xff - srcA, dst).
+ */
+static __m128i
+srcover_epi16(__m128i s, __m128i d)
+{
+    __m128i dstF = _mm_sub_epi16(_mm_set1_epi16(0xff), alpha_epi16(s));
+    return _mm_add_epi16(s, mul8_epi16(dstF, d));
+}
+
+/*
+ * Same as IntArgbPreSrcOverMaskFill. With premultiplied destination
+ * pixels the SrcOver equations need no special cases: a coverage of 0
+ * leaves the pixel as it is, and a result alpha of 0xff ignores it.
+ */
+void
+sse2_IntArgbPreSrcOverMaskFill(void *rasBase,
+                               jubyte *pMask, jint maskOff, jint maskScan,
+                               jint width, jint height,
+                               jint fgColor,
+                               SurfaceDataRasInfo *pRasInfo,
+                               NativePrimitive *pPrim,
+                               CompositeInfo *pCompInfo)
+{
+    jint srcA = ((juint) fgColor) >> 24;
+    jint srcR = (fgColor >> 16) & 0xff;
+    jint srcG = (fgColor >>  8) & 0xff;
+    jint srcB = (fgColor      ) & 0xff;
+    jint rasScan = pRasInfo->scanStride;
+    __m128i zero = _mm_setzero_si128();
+    __m128i src;
+
+    if (srcA != 0xff) {
+        if (srcA == 0) {
+            return;
+        }
+        srcR = MUL8(srcA, srcR);
+        srcG = MUL8(srcA, srcG);
+        srcB = MUL8(srcA, srcB);
+    }
+    src = _mm_unpacklo_epi8(_mm_set1_epi32((srcA << 24) | (srcR << 16) |
+                                           (srcG <<  8) | srcB), zero);
+
+    if (pMask) {
+        pMask += maskOff;
+    }
+    do {
+        juint *pRas = (juint *) rasBase;
+        jint x = 0;
+
+        if (pMask) {
+            for (; x + 4 <= width; x += 4) {
+                jint m;
+                __m128i mask, d, lo, hi;
+                memcpy(&m, pMask + x, sizeof(m));
+                if (m == 0) {
+                    continue;
+                }
+                mask = _mm_unpacklo_epi8(_mm_cvtsi32_si128(m), zero);
+                mask = _mm_unpacklo_epi16(mask, mask);
+                d = _mm_loadu_si128((__m128i *) (pRas + x));
+                lo = srcover_epi16(mul8_epi16(_mm_unpacklo_epi32(mask, mask), src),
+                                   _mm_unpacklo_epi8(d, zero));
+                hi = srcover_epi16(mul8_epi16(_mm_unpackhi_epi32(mask, mask), src),
+                                   _mm_unpackhi_epi8(d, zero));
+                _mm_storeu_si128((__m128i *) (pRas + x), _mm_packus_epi16(lo, hi));
+            }
+            for (; x < width; x++) {
+                jint pathA = pMask[x];
+                if (pathA > 0) {
+                    juint dst = pRas[x];
+                    jint resA = MUL8(pathA, srcA);
+                    jint dstF = 0xff - resA;
+                    pRas[x] = ((resA + MUL8(dstF, dst >> 24)) << 24) |
+                        ((MUL8(pathA, srcR) + MUL8(dstF, (dst >> 16) & 0xff)) << 16) |
+                        ((MUL8(pathA, srcG) + MUL8(dstF, (dst >>  8) & 0xff)) <<  8) |
+                        ((MUL8(pathA, srcB) + MUL8(dstF, (dst      ) & 0xff))      );
+                }
+            }
+            pMask += maskScan;
+        } else {
+            for (; x + 4 <= width; x += 4) {
+                __m128i d = _mm_loadu_si128((__m128i *) (pRas + x));
+                __m128i lo = srcover_epi16(src, _mm_unpacklo_epi8(d, zero));
+                __m128i hi = srcover_epi16(src, _mm_unpackhi_epi8(d, zero));
+                _mm_storeu_si128((__m128i *) (pRas + x), _mm_packus_epi16(lo, hi));
+            }
+            for (; x < width; x++) {
+                juint dst = pRas[x];
+                jint dstF = 0xff - srcA;
+                pRas[x] = ((srcA + MUL8(dstF, dst >> 24)) << 24) |
+                    ((srcR + MUL8(dstF, (dst >> 16) & 0xff)) << 16) |
+                    ((srcG + MUL8(dstF, (dst >>  8) & 0xff)) <<  8) |
+                    ((srcB + MUL8(dstF, (dst      ) & 0xff))      );
+            }
+        }
+        rasBase = PtrAddBytes(rasBase, rasScan);
+    } while (--height > 0);
+}
+
+/*
+ * Same as IntArgbToIntArgbPreConvert, each color component is
+ * multiplied by the alpha of its pixel and the alpha stays as it is.
+ */
+void
+sse2_IntArgbToIntArgbPreConvert(void *srcBase, void *dstBase,
+                                juint width, juint height,
+                                SurfaceDataRasInfo *pSrcInfo,
+                                SurfaceDataRasInfo *pDstInfo,
+                                NativePrimitive *pPrim,
+                                CompositeInfo *pCompInfo)
+{
+    jint srcScan = pSrcInfo->scanStride;
+    jint dstScan = pDstInfo->scanStride;
+    __m128i zero = _mm_setzero_si128();
+    /* Multiplier for the alpha lanes, MUL8(0xff, a) == a */
+    __m128i alphaLanes = _mm_set_epi16(0xff, 0, 0, 0, 0xff, 0, 0, 0);
+
+    do {
+        juint *pSrc = (juint *) srcBase;
+        juint *pDst = (juint *) dstBase;
+        juint x = 0;
+
+        for (; x + 4 <= width; x += 4) {
+            __m128i s = _mm_loadu_si128((__m128i *) (pSrc + x));
+            __m128i lo = _mm_unpacklo_epi8(s, zero);
+            __m128i hi = _mm_unpackhi_epi8(s, zero);
+            lo = mul8_epi16(_mm_or_si128(alpha_epi16(lo), alphaLanes), lo);
+            hi = mul8_epi16(_mm_or_si128(alpha_epi16(hi), alphaLanes), hi);
+            _mm_storeu_si128((__m128i *) (pDst + x), _mm_packus_epi16(lo, hi));
+        }
+        for (; x < width; x++) {
+            juint argb = pSrc[x];
+            jint a = argb >> 24;
+            if (a == 0xff) {
+                pDst[x] = argb;
+            } else {
+                pDst[x] = (a << 24) |
+                    (MUL8(a, (argb >> 16) & 0xff) << 16) |
+                    (MUL8(a, (argb >>  8) & 0xff) <<  8) |
+                    (MUL8(a, (argb      ) & 0xff)      );
+            }
+        }
+        srcBase = PtrAddBytes(srcBase, srcScan);
+        dstBase = PtrAddBytes(dstBase, dstScan);
+    } while (--height > 0);
+}
+
+#endif /* __SSE2__ || _M_X64 */
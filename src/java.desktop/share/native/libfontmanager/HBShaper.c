@@ -25,12 +25,19 @@
 
 #include <jni_util.h>
 #include <stdlib.h>
+#include <string.h>
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
 #include "hb.h"
 #include "hb-jdk.h"
 #include "hb-ot.h"
 #ifdef MACOSX
 #include "hb-coretext.h"
 #endif
+#include "fontscaler.h"
 #include "scriptMapping.h"
 
 static jclass gvdClass = 0;
@@ -166,6 +173,349 @@ jboolean storeGVData(JNIEnv* env,
     return JNI_TRUE;
 }
 
+/**************** Shaping result cache *****************/
+
+/* Applications often lay out the same short strings (labels, headers)
+ * over and over. The glyphs and positions hb_shape produces for a run
+ * only depend on the font, the strike's rendering parameters, the script,
+ * the layout flags and the run text with its surrounding context, so they
+ * are cached under that key. The cache is bounded by SHAPE_CACHE_BUDGET
+ * bytes and evicts the least recently used results.
+ *
+ * Only file fonts, which have a native scaler and layout tables, are cached;
+ * their entries are dropped by freeShapeCacheEntries when the scaler goes
+ * away.
+ */
+
+#define SHAPE_CACHE_BUDGET   (1024 * 1024)
+#define SHAPE_CACHE_MAX_RUN  256
+#define SHAPE_CACHE_BUCKETS  1024  /* power of two */
+/* hb_buffer_add_utf16 keeps up to 5 code points of context on each side;
+ * in UTF-16 that is at most 10 chars. */
+#define SHAPE_CACHE_CONTEXT  10
+
+typedef struct ShapeCacheKey {
+    jlong  pScaler;
+    jlong  layoutTables;
+    jlong  pNativeFont;
+    jdouble devTx[4];
+    jfloat matrix[4];
+    jfloat ptSize;
+    jint   aaHint;
+    jint   fmHint;
+    jint   style;
+    jint   script;
+    jint   flags;
+    jint   textLen;        /* run plus context */
+    jint   runStart;       /* start of the run within the text */
+    jint   runLen;
+} ShapeCacheKey;
+
+typedef struct ShapeCacheEntry {
+    ShapeCacheKey           key;
+    unsigned int            hash;
+    struct ShapeCacheEntry* hashNext;
+    struct ShapeCacheEntry* lruPrev;   /* towards most recently used */
+    struct ShapeCacheEntry* lruNext;   /* towards least recently used */
+    size_t                  size;
+    int                     glyphCount;
+    /* clusters are relative to the start of the run */
+    hb_glyph_info_t*        glyphInfo;
+    hb_glyph_position_t*    glyphPos;
+    jchar*                  text;
+} ShapeCacheEntry;
+
+static ShapeCacheEntry* shapeCacheTable[SHAPE_CACHE_BUCKETS];
+static ShapeCacheEntry* shapeCacheHead;
+static ShapeCacheEntry* shapeCacheTail;
+static size_t shapeCacheBytes;
+static jlong shapeCacheHits;
+static jlong shapeCacheMisses;
+
+#ifdef _WIN32
+static SRWLOCK shapeCacheLock = SRWLOCK_INIT;
+#define SHAPE_CACHE_LOCK()   AcquireSRWLockExclusive(&shapeCacheLock)
+#define SHAPE_CACHE_UNLOCK() ReleaseSRWLockExclusive(&shapeCacheLock)
+#else
+static pthread_mutex_t shapeCacheLock = PTHREAD_MUTEX_INITIALIZER;
+#define SHAPE_CACHE_LOCK()   pthread_mutex_lock(&shapeCacheLock)
+#define SHAPE_CACHE_UNLOCK() pthread_mutex_unlock(&shapeCacheLock)
+#endif
+
+/* The strike's rendering parameters affect the advances harfbuzz gets
+ * back from the strike, so they are part of the key. If the fields can
+ * not be found the cache is disabled. */
+static int shapeCacheIDsInited = 0;   /* 1 ready, -1 disabled */
+static jfieldID strikeDescFID = 0;
+static jfieldID descDevTxFID = 0;
+static jfieldID descStyleFID = 0;
+static jfieldID descAAHintFID = 0;
+static jfieldID descFMHintFID = 0;
+static jfieldID atM00FID = 0, atM10FID = 0, atM01FID = 0, atM11FID = 0;
+
+static int initShapeCacheIDs(JNIEnv *env) {
+    jclass strikeClass, descClass, atClass;
+
+    if (shapeCacheIDsInited != 0) {
+        return shapeCacheIDsInited > 0;
+    }
+    shapeCacheIDsInited = -1;
+    if ((strikeClass = (*env)->FindClass(env, "sun/font/FontStrike")) == NULL ||
+        (descClass = (*env)->FindClass(env, "sun/font/FontStrikeDesc")) == NULL ||
+        (atClass = (*env)->FindClass(env, "java/awt/geom/AffineTransform")) == NULL ||
+        (strikeDescFID = (*env)->GetFieldID(env, strikeClass, "desc",
+                                            "Lsun/font/FontStrikeDesc;")) == NULL ||
+        (descDevTxFID = (*env)->GetFieldID(env, descClass, "devTx",
+                                           "Ljava/awt/geom/AffineTransform;")) == NULL ||
+        (descStyleFID = (*env)->GetFieldID(env, descClass, "style", "I")) == NULL ||
+        (descAAHintFID = (*env)->GetFieldID(env, descClass, "aaHint", "I")) == NULL ||
+        (descFMHintFID = (*env)->GetFieldID(env, descClass, "fmHint", "I")) == NULL ||
+        (atM00FID = (*env)->GetFieldID(env, atClass, "m00", "D")) == NULL ||
+        (atM10FID = (*env)->GetFieldID(env, atClass, "m10", "D")) == NULL ||
+        (atM01FID = (*env)->GetFieldID(env, atClass, "m01", "D")) == NULL ||
+        (atM11FID = (*env)->GetFieldID(env, atClass, "m11", "D")) == NULL) {
+        (*env)->ExceptionClear(env);
+        return 0;
+    }
+    shapeCacheIDsInited = 1;
+    return 1;
+}
+
+/* Fills in the key, or returns 0 if this run is not cacheable. */
+static int initShapeCacheKey(JNIEnv *env, ShapeCacheKey* key,
+                             jobject fontStrike, jfloat ptSize,
+                             jfloat* matrix, jlong pScaler, jlong pNativeFont,
+                             jlong layoutTables, jint script, jint flags,
+                             jint offset, jint limit, jsize len) {
+    jobject desc, devTx;
+    int start, end;
+
+    if (pScaler == 0 || layoutTables == 0 ||
+        limit - offset > SHAPE_CACHE_MAX_RUN || !initShapeCacheIDs(env)) {
+        return 0;
+    }
+    /* zeroed so that padding does not matter to the hash */
+    memset(key, 0, sizeof(ShapeCacheKey));
+    desc = (*env)->GetObjectField(env, fontStrike, strikeDescFID);
+    if (desc == NULL) {
+        return 0;
+    }
+    key->style  = (*env)->GetIntField(env, desc, descStyleFID);
+    key->aaHint = (*env)->GetIntField(env, desc, descAAHintFID);
+    key->fmHint = (*env)->GetIntField(env, desc, descFMHintFID);
+    devTx = (*env)->GetObjectField(env, desc, descDevTxFID);
+    if (devTx != NULL) {
+        key->devTx[0] = (*env)->GetDoubleField(env, devTx, atM00FID);
+        key->devTx[1] = (*env)->GetDoubleField(env, devTx, atM10FID);
+        key->devTx[2] = (*env)->GetDoubleField(env, devTx, atM01FID);
+        key->devTx[3] = (*env)->GetDoubleField(env, devTx, atM11FID);
+        (*env)->DeleteLocalRef(env, devTx);
+    } else {
+        key->devTx[0] = key->devTx[3] = 1.0;
+    }
+    (*env)->DeleteLocalRef(env, desc);
+
+    start = offset > SHAPE_CACHE_CONTEXT ? offset - SHAPE_CACHE_CONTEXT : 0;
+    end = len - limit > SHAPE_CACHE_CONTEXT ? limit + SHAPE_CACHE_CONTEXT : len;
+    key->pScaler      = pScaler;
+    key->layoutTables = layoutTables;
+    key->pNativeFont  = pNativeFont;
+    memcpy(key->matrix, matrix, sizeof(key->matrix));
+    key->ptSize   = ptSize;
+    key->script   = script;
+    key->flags    = flags;
+    key->textLen  = end - start;
+    key->runStart = offset - start;
+    key->runLen   = limit - offset;
+    return 1;
+}
+
+static unsigned int shapeCacheHash(const ShapeCacheKey* key, const jchar* text) {
+    const unsigned char* p = (const unsigned char*) key;
+    unsigned int h = 2166136261u;  /* FNV-1a */
+    size_t i;
+    for (i = 0; i < sizeof(ShapeCacheKey); i++) {
+        h = (h ^ p[i]) * 16777619u;
+    }
+    for (i = 0; i < (size_t) key->textLen; i++) {
+        h = (h ^ text[i]) * 16777619u;
+    }
+    return h;
+}
+
+static int shapeCacheMatches(const ShapeCacheEntry* e, unsigned int hash,
+                             const ShapeCacheKey* key, const jchar* text) {
+    return e->hash == hash &&
+           memcmp(&e->key, key, sizeof(ShapeCacheKey)) == 0 &&
+           memcmp(e->text, text, key->textLen * sizeof(jchar)) == 0;
+}
+
+static void shapeCacheUnlinkLRU(ShapeCacheEntry* e) {
+    if (e->lruPrev != NULL) {
+        e->lruPrev->lruNext = e->lruNext;
+    } else {
+        shapeCacheHead = e->lruNext;
+    }
+    if (e->lruNext != NULL) {
+        e->lruNext->lruPrev = e->lruPrev;
+    } else {
+        shapeCacheTail = e->lruPrev;
+    }
+    e->lruPrev = e->lruNext = NULL;
+}
+
+static void shapeCachePushLRU(ShapeCacheEntry* e) {
+    e->lruPrev = NULL;
+    e->lruNext = shapeCacheHead;
+    if (shapeCacheHead != NULL) {
+        shapeCacheHead->lruPrev = e;
+    } else {
+        shapeCacheTail = e;
+    }
+    shapeCacheHead = e;
+}
+
+static void shapeCacheRemove(ShapeCacheEntry* e) {
+    ShapeCacheEntry** link = &shapeCacheTable[e->hash & (SHAPE_CACHE_BUCKETS - 1)];
+    while (*link != e) {
+        link = &(*link)->hashNext;
+    }
+    *link = e->hashNext;
+    shapeCacheUnlinkLRU(e);
+    shapeCacheBytes -= e->size;
+    free(e);
+}
+
+/* On a hit returns a malloc'ed copy of the glyph infos, followed by the
+ * glyph positions, and stores the glyph count. Returns NULL on a miss. */
+static hb_glyph_info_t* shapeCacheLookup(const ShapeCacheKey* key,
+                                         const jchar* text, int* glyphCount) {
+    unsigned int hash = shapeCacheHash(key, text);
+    hb_glyph_info_t* result = NULL;
+    ShapeCacheEntry* e;
+
+    SHAPE_CACHE_LOCK();
+    for (e = shapeCacheTable[hash & (SHAPE_CACHE_BUCKETS - 1)];
+         e != NULL; e = e->hashNext) {
+        if (shapeCacheMatches(e, hash, key, text)) {
+            break;
+        }
+    }
+    if (e != NULL) {
+        size_t n = e->glyphCount;
+        result = (hb_glyph_info_t*)
+            malloc(n * (sizeof(hb_glyph_info_t) + sizeof(hb_glyph_position_t)) + 1);
+        if (result != NULL) {
+            memcpy(result, e->glyphInfo, n * sizeof(hb_glyph_info_t));
+            memcpy(result + n, e->glyphPos, n * sizeof(hb_glyph_position_t));
+            *glyphCount = e->glyphCount;
+            if (e != shapeCacheHead) {
+                shapeCacheUnlinkLRU(e);
+                shapeCachePushLRU(e);
+            }
+            shapeCacheHits++;
+        }
+    } else {
+        shapeCacheMisses++;
+    }
+    SHAPE_CACHE_UNLOCK();
+    return result;
+}
+
+/* Caches a shaping result; clusters in glyphInfo are relative to offset. */
+static void shapeCacheInsert(const ShapeCacheKey* key, const jchar* text,
+                             int offset, int glyphCount,
+                             const hb_glyph_info_t* glyphInfo,
+                             const hb_glyph_position_t* glyphPos) {
+    size_t size = sizeof(ShapeCacheEntry) +
+                  glyphCount * (sizeof(hb_glyph_info_t) +
+                                sizeof(hb_glyph_position_t)) +
+                  key->textLen * sizeof(jchar);
+    unsigned int hash = shapeCacheHash(key, text);
+    ShapeCacheEntry* e;
+    ShapeCacheEntry* old;
+    int i;
+
+    e = (ShapeCacheEntry*) malloc(size);
+    if (e == NULL) {
+        return;
+    }
+    e->key = *key;
+    e->hash = hash;
+    e->size = size;
+    e->glyphCount = glyphCount;
+    e->glyphInfo = (hb_glyph_info_t*) (e + 1);
+    e->glyphPos = (hb_glyph_position_t*) (e->glyphInfo + glyphCount);
+    e->text = (jchar*) (e->glyphPos + glyphCount);
+    memcpy(e->glyphInfo, glyphInfo, glyphCount * sizeof(hb_glyph_info_t));
+    memcpy(e->glyphPos, glyphPos, glyphCount * sizeof(hb_glyph_position_t));
+    memcpy(e->text, text, key->textLen * sizeof(jchar));
+    for (i = 0; i < glyphCount; i++) {
+        e->glyphInfo[i].cluster -= offset;
+    }
+
+    SHAPE_CACHE_LOCK();
+    /* another thread may have shaped the same run meanwhile */
+    for (old = shapeCacheTable[hash & (SHAPE_CACHE_BUCKETS - 1)];
+         old != NULL; old = old->hashNext) {
+        if (shapeCacheMatches(old, hash, key, text)) {
+            break;
+        }
+    }
+    if (old == NULL) {
+        while (shapeCacheTail != NULL &&
+               shapeCacheBytes + size > SHAPE_CACHE_BUDGET) {
+            shapeCacheRemove(shapeCacheTail);
+        }
+        e->hashNext = shapeCacheTable[hash & (SHAPE_CACHE_BUCKETS - 1)];
+        shapeCacheTable[hash & (SHAPE_CACHE_BUCKETS - 1)] = e;
+        shapeCachePushLRU(e);
+        shapeCacheBytes += size;
+        e = NULL;
+    }
+    SHAPE_CACHE_UNLOCK();
+    free(e);
+}
+
+/* Drops the cached results of a font whose scaler is being freed. */
+void freeShapeCacheEntries(TTLayoutTableCache* layoutTables) {
+    ShapeCacheEntry* e;
+    ShapeCacheEntry* next;
+
+    if (layoutTables == NULL) {
+        return;
+    }
+    SHAPE_CACHE_LOCK();
+    for (e = shapeCacheHead; e != NULL; e = next) {
+        next = e->lruNext;
+        if (e->key.layoutTables == ptr_to_jlong(layoutTables)) {
+            shapeCacheRemove(e);
+        }
+    }
+    SHAPE_CACHE_UNLOCK();
+}
+
+/*
+ * Class:     sun_font_SunLayoutEngine
+ * Method:    getShapeCacheStats
+ * Signature: ([J)V
+ *
+ * Stores the number of cache hits, misses, cached bytes and the
+ * byte budget into stats.
+ */
+JNIEXPORT void JNICALL Java_sun_font_SunLayoutEngine_getShapeCacheStats
+    (JNIEnv *env, jclass cls, jlongArray stats) {
+    jlong values[4];
+
+    SHAPE_CACHE_LOCK();
+    values[0] = shapeCacheHits;
+    values[1] = shapeCacheMisses;
+    values[2] = (jlong) shapeCacheBytes;
+    SHAPE_CACHE_UNLOCK();
+    values[3] = SHAPE_CACHE_BUDGET;
+    (*env)->SetLongArrayRegion(env, stats, 0, 4, values);
+}
+
 static float euclidianDistance(float a, float b)
 {
     float root;
@@ -269,8 +619,39 @@ JNIEXPORT jboolean JNICALL Java_sun_font_SunLayoutEngine_shape
      char* liga = (flags & TYPO_LIGA) ? "liga" : "-liga";
      jboolean ret;
      unsigned int buflen;
+     ShapeCacheKey cacheKey;
+     int cacheable;
+     jfloat mat[4];
+     JDKFontInfo *jdkFontInfo;
+
+     len = (*env)->GetArrayLength(env, text);
+     (*env)->GetFloatArrayRegion(env, matrix, 0, 4, mat);
+     cacheable = initShapeCacheKey(env, &cacheKey, fontStrike, ptSize, mat,
+                                   pScaler, pNativeFont, layoutTables,
+                                   script, flags, offset, limit, len);
+     if (cacheable) {
+         jchar runText[SHAPE_CACHE_MAX_RUN + 2 * SHAPE_CACHE_CONTEXT];
+         (*env)->GetCharArrayRegion(env, text, offset - cacheKey.runStart,
+                                    cacheKey.textLen, runText);
+         if ((*env)->ExceptionCheck(env)) {
+             return JNI_FALSE;
+         }
+         glyphInfo = shapeCacheLookup(&cacheKey, runText, &glyphCount);
+         if (glyphInfo != NULL) {
+             float devScale = 1.0f;
+             if (!aat && (getenv("HB_NODEVTX") != NULL)) {
+                 devScale = euclidianDistance(mat[0], mat[1]) / ptSize;
+             }
+             ret = storeGVData(env, gvdata, slot, baseIndex, 0, startPt,
+                               limit - offset, glyphCount, glyphInfo,
+                               (hb_glyph_position_t*) (glyphInfo + glyphCount),
+                               devScale);
+             free(glyphInfo);
+             return ret;
+         }
+     }
 
-     JDKFontInfo *jdkFontInfo =
+     jdkFontInfo =
          createJDKFontInfo(env, font2D, fontStrike, ptSize,
                            pScaler, pNativeFont, layoutTables, matrix, aat);
      if (!jdkFontInfo) {
@@ -300,8 +681,6 @@ JNIEXPORT jboolean JNICALL Java_sun_font_SunLayoutEngine_shape
          free((void*)jdkFontInfo);
          return JNI_FALSE;
      }
-     len = (*env)->GetArrayLength(env, text);
-
      hb_buffer_add_utf16(buffer, chars, len, offset, limit-offset);
 
      features = calloc(2, sizeof(hb_feature_t));
@@ -315,6 +694,11 @@ JNIEXPORT jboolean JNICALL Java_sun_font_SunLayoutEngine_shape
      glyphInfo = hb_buffer_get_glyph_infos(buffer, 0);
      glyphPos = hb_buffer_get_glyph_positions(buffer, &buflen);
 
+     if (cacheable) {
+         shapeCacheInsert(&cacheKey, chars + offset - cacheKey.runStart,
+                          offset, glyphCount, glyphInfo, glyphPos);
+     }
+
      ret = storeGVData(env, gvdata, slot, baseIndex, offset, startPt,
                        limit - offset, glyphCount, glyphInfo, glyphPos,
                        jdkFontInfo->devScale);
@@ -49,4 +49,7 @@ typedef struct {
 #define TEXT_FM_OFF 1
 #define TEXT_FM_ON  2
 
+/* Drops the cached shaping results of a font (see HBShaper.c) */
+void freeShapeCacheEntries(TTLayoutTableCache* layoutTables);
+
 #endif
@@ -30,7 +30,13 @@
 #include "sun_font_FreetypeFontScaler.h"
 
 #include<stdlib.h>
+#include <string.h>
 #include <math.h>
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
 #include "ft2build.h"
 #include FT_FREETYPE_H
 #include FT_GLYPH_H
@@ -84,6 +90,214 @@ typedef struct FTScalerContext {
     int        ptsz;          /* size in points */
 } FTScalerContext;
 
+/**************** Shared glyph image cache *****************/
+
+/* Rasterized glyph images are shared by all strikes of a font that have
+   the same size, transform and rendering modes, so a glyph is not
+   rasterized again each time a strike object is recreated. The Java side
+   owns (and frees) every GlyphInfo it gets back, so a hit hands out a
+   private copy of the cached image. The cache is bounded by
+   GLYPH_CACHE_BUDGET bytes and evicts the least recently used images. */
+
+#define GLYPH_CACHE_BUDGET    (4 * 1024 * 1024)
+#define GLYPH_CACHE_MAX_IMAGE (GLYPH_CACHE_BUDGET / 64)
+#define GLYPH_CACHE_BUCKETS   4096  /* power of two */
+
+typedef struct GlyphCacheKey {
+    FTScalerInfo* scalerInfo;
+    FT_Matrix     transform;
+    int           ptsz;
+    jint          aaType;
+    jint          fmType;
+    jboolean      useSbits;
+    jboolean      doBold;
+    jboolean      doItalize;
+    jint          glyphCode;
+} GlyphCacheKey;
+
+typedef struct GlyphCacheEntry {
+    GlyphCacheKey           key;
+    struct GlyphCacheEntry* hashNext;
+    struct GlyphCacheEntry* lruPrev;   /* towards most recently used */
+    struct GlyphCacheEntry* lruNext;   /* towards least recently used */
+    size_t                  size;      /* GlyphInfo plus image bytes */
+    GlyphInfo*              glyph;     /* image follows the GlyphInfo */
+} GlyphCacheEntry;
+
+static GlyphCacheEntry* glyphCacheTable[GLYPH_CACHE_BUCKETS];
+static GlyphCacheEntry* glyphCacheHead;   /* most recently used */
+static GlyphCacheEntry* glyphCacheTail;   /* least recently used */
+static size_t glyphCacheBytes;
+
+#ifdef _WIN32
+static CRITICAL_SECTION glyphCacheLock;
+#define GLYPH_CACHE_LOCK()   EnterCriticalSection(&glyphCacheLock)
+#define GLYPH_CACHE_UNLOCK() LeaveCriticalSection(&glyphCacheLock)
+#else
+static pthread_mutex_t glyphCacheLock = PTHREAD_MUTEX_INITIALIZER;
+#define GLYPH_CACHE_LOCK()   pthread_mutex_lock(&glyphCacheLock)
+#define GLYPH_CACHE_UNLOCK() pthread_mutex_unlock(&glyphCacheLock)
+#endif
+
+static void initGlyphCacheKey(GlyphCacheKey* key, FTScalerInfo* scalerInfo,
+                              FTScalerContext* context, jint glyphCode) {
+    /* zeroed so that padding does not matter to the hash */
+    memset(key, 0, sizeof(GlyphCacheKey));
+    key->scalerInfo = scalerInfo;
+    key->transform  = context->transform;
+    key->ptsz       = context->ptsz;
+    key->aaType     = context->aaType;
+    key->fmType     = context->fmType;
+    key->useSbits   = context->useSbits;
+    key->doBold     = context->doBold;
+    key->doItalize  = context->doItalize;
+    key->glyphCode  = glyphCode;
+}
+
+static unsigned int glyphCacheHash(const GlyphCacheKey* key) {
+    const unsigned char* p = (const unsigned char*) key;
+    unsigned int h = 2166136261u;  /* FNV-1a */
+    size_t i;
+    for (i = 0; i < sizeof(GlyphCacheKey); i++) {
+        h = (h ^ p[i]) * 16777619u;
+    }
+    return h & (GLYPH_CACHE_BUCKETS - 1);
+}
+
+static void glyphCacheUnlinkLRU(GlyphCacheEntry* e) {
+    if (e->lruPrev != NULL) {
+        e->lruPrev->lruNext = e->lruNext;
+    } else {
+        glyphCacheHead = e->lruNext;
+    }
+    if (e->lruNext != NULL) {
+        e->lruNext->lruPrev = e->lruPrev;
+    } else {
+        glyphCacheTail = e->lruPrev;
+    }
+    e->lruPrev = e->lruNext = NULL;
+}
+
+static void glyphCachePushLRU(GlyphCacheEntry* e) {
+    e->lruPrev = NULL;
+    e->lruNext = glyphCacheHead;
+    if (glyphCacheHead != NULL) {
+        glyphCacheHead->lruPrev = e;
+    } else {
+        glyphCacheTail = e;
+    }
+    glyphCacheHead = e;
+}
+
+/* Unlinks e from the table and the LRU list and frees it. */
+static void glyphCacheRemove(GlyphCacheEntry* e) {
+    GlyphCacheEntry** link = &glyphCacheTable[glyphCacheHash(&e->key)];
+    while (*link != e) {
+        link = &(*link)->hashNext;
+    }
+    *link = e->hashNext;
+    glyphCacheUnlinkLRU(e);
+    glyphCacheBytes -= e->size;
+    free(e->glyph);
+    free(e);
+}
+
+static GlyphInfo* copyGlyphInfo(const GlyphInfo* src, size_t size) {
+    GlyphInfo* dst = (GlyphInfo*) malloc(size);
+    if (dst != NULL) {
+        memcpy(dst, src, size);
+        dst->cellInfo = NULL;
+        dst->managed  = UNMANAGED_GLYPH;
+        dst->image = (src->image == NULL) ? NULL :
+            (UInt8*) dst + sizeof(GlyphInfo);
+    }
+    return dst;
+}
+
+/* Returns a private copy of the cached image, or NULL on a miss. */
+static GlyphInfo* glyphCacheLookup(const GlyphCacheKey* key) {
+    GlyphInfo* result = NULL;
+    GlyphCacheEntry* e;
+
+    GLYPH_CACHE_LOCK();
+    for (e = glyphCacheTable[glyphCacheHash(key)]; e != NULL; e = e->hashNext) {
+        if (memcmp(&e->key, key, sizeof(GlyphCacheKey)) == 0) {
+            if (e != glyphCacheHead) {
+                glyphCacheUnlinkLRU(e);
+                glyphCachePushLRU(e);
+            }
+            result = copyGlyphInfo(e->glyph, e->size);
+            break;
+        }
+    }
+    GLYPH_CACHE_UNLOCK();
+    return result;
+}
+
+/* Caches a copy of glyphInfo, whose image is imageSize bytes. */
+static void glyphCacheInsert(const GlyphCacheKey* key,
+                             const GlyphInfo* glyphInfo, size_t imageSize) {
+    size_t size = sizeof(GlyphInfo) + imageSize;
+    GlyphCacheEntry* e;
+    GlyphCacheEntry* old;
+    unsigned int bucket;
+
+    if (imageSize > GLYPH_CACHE_MAX_IMAGE) {
+        return;
+    }
+    e = (GlyphCacheEntry*) malloc(sizeof(GlyphCacheEntry));
+    if (e == NULL) {
+        return;
+    }
+    e->glyph = copyGlyphInfo(glyphInfo, size);
+    if (e->glyph == NULL) {
+        free(e);
+        return;
+    }
+    e->key = *key;
+    e->size = size;
+    bucket = glyphCacheHash(key);
+
+    GLYPH_CACHE_LOCK();
+    /* another thread may have rasterized the same glyph meanwhile */
+    for (old = glyphCacheTable[bucket]; old != NULL; old = old->hashNext) {
+        if (memcmp(&old->key, key, sizeof(GlyphCacheKey)) == 0) {
+            break;
+        }
+    }
+    if (old == NULL) {
+        while (glyphCacheTail != NULL &&
+               glyphCacheBytes + size > GLYPH_CACHE_BUDGET) {
+            glyphCacheRemove(glyphCacheTail);
+        }
+        e->hashNext = glyphCacheTable[bucket];
+        glyphCacheTable[bucket] = e;
+        glyphCachePushLRU(e);
+        glyphCacheBytes += size;
+    }
+    GLYPH_CACHE_UNLOCK();
+
+    if (old != NULL) {
+        free(e->glyph);
+        free(e);
+    }
+}
+
+/* Drops all images of a scaler, before its face goes away. */
+static void glyphCacheRemoveScaler(FTScalerInfo* scalerInfo) {
+    GlyphCacheEntry* e;
+    GlyphCacheEntry* next;
+
+    GLYPH_CACHE_LOCK();
+    for (e = glyphCacheHead; e != NULL; e = next) {
+        next = e->lruNext;
+        if (e->key.scalerInfo == scalerInfo) {
+            glyphCacheRemove(e);
+        }
+    }
+    GLYPH_CACHE_UNLOCK();
+}
+
 #ifdef DEBUG
 /* These are referenced in the freetype sources if DEBUG macro is defined.
    To simplify work with debuging version of freetype we define
@@ -101,6 +315,9 @@ Java_sun_font_FreetypeFontScaler_initIDs(
         JNIEnv *env, jobject scaler, jclass FFSClass) {
     invalidateScalerMID =
         (*env)->GetMethodID(env, FFSClass, "invalidateScaler", "()V");
+#ifdef _WIN32
+    InitializeCriticalSection(&glyphCacheLock);
+#endif
 }
 
 static void freeNativeResources(JNIEnv *env, FTScalerInfo* scalerInfo) {
@@ -108,6 +325,9 @@ static void freeNativeResources(JNIEnv *env, FTScalerInfo* scalerInfo) {
     if (scalerInfo == NULL)
         return;
 
+    glyphCacheRemoveScaler(scalerInfo);
+    freeShapeCacheEntries(scalerInfo->layoutTables);
+
     // FT_Done_Face always closes the stream, but only frees the memory
     // of the data structure if it was internally allocated by FT.
     // We hold on to a pointer to the stream structure if we provide it
@@ -696,6 +916,7 @@ Java_sun_font_FreetypeFontScaler_getGlyphImageNative(
     GlyphInfo *glyphInfo;
     int renderFlags = FT_LOAD_DEFAULT, target;
     FT_GlyphSlot ftglyph;
+    GlyphCacheKey cacheKey;
 
     FTScalerContext* context =
         (FTScalerContext*) jlong_to_ptr(pScalerContext);
@@ -706,6 +927,12 @@ Java_sun_font_FreetypeFontScaler_getGlyphImageNative(
         return ptr_to_jlong(getNullGlyphImage());
     }
 
+    initGlyphCacheKey(&cacheKey, scalerInfo, context, glyphCode);
+    glyphInfo = glyphCacheLookup(&cacheKey);
+    if (glyphInfo != NULL) {
+        return ptr_to_jlong(glyphInfo);
+    }
+
     error = setupFTContext(env, font2D, scalerInfo, context);
     if (error) {
         invalidateJavaScaler(env, scaler, scalerInfo);
@@ -849,10 +1076,12 @@ Java_sun_font_FreetypeFontScaler_getGlyphImageNative(
             glyphInfo->rowBytes *=3;
         } else {
             free(glyphInfo);
-            glyphInfo = getNullGlyphImage();
+            return ptr_to_jlong(getNullGlyphImage());
         }
     }
 
+    glyphCacheInsert(&cacheKey, glyphInfo, imageSize);
+
     return ptr_to_jlong(glyphInfo);
 }
 
@@ -16,6 +16,12 @@
 #include "jinclude.h"
 #include "jpeglib.h"
 
+#if defined(SSE2_KERNELS_SUPPORTED) && RGB_PIXELSIZE == 3 && \
+    RGB_RED == 0 && RGB_GREEN == 1 && RGB_BLUE == 2
+#define YCC_RGB_SSE2
+#include <emmintrin.h>
+#endif
+
 
 /* Private subobject */
 
@@ -109,6 +115,90 @@ build_ycc_rgb_table (j_decompress_ptr cinfo)
 }
 
 
+#ifdef YCC_RGB_SSE2
+
+/*
+ * SSE2 version of the YCbCr->RGB inner loop, 8 pixels at a time.
+ * The 16.16 constants that do not fit in 16 bits are split into an integral
+ * part, applied exactly, and a 16-bit remainder, so the results are the same
+ * as with the tables:
+ *      1.40200 * x = x + 0.40200 * x
+ *      1.77200 * x = 2 * x - 0.22800 * x
+ *      -0.34414 * cb - 0.71414 * cr = -cr - 0.34414 * cb + 0.28586 * cr
+ * Each pixel is stored as 4 bytes, the 4th of which is overwritten by the
+ * next pixel, so the last pixel of the row is always left to the caller.
+ * Returns the number of pixels converted.
+ */
+
+LOCAL(JDIMENSION)
+ycc_rgb_convert_sse2 (JSAMPROW inptr0, JSAMPROW inptr1, JSAMPROW inptr2,
+                      JSAMPROW outptr, JDIMENSION num_cols)
+{
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i center = _mm_set1_epi16(CENTERJSAMPLE);
+  const __m128i two = _mm_set1_epi16(2);
+  /* multiplier, rounding pairs for _mm_madd_epi16 with (x, 2) */
+  const __m128i k_r = _mm_set1_epi32(
+      (int) ((ONE_HALF / 2) << 16 | ((FIX(1.40200) - FIX(1)) & 0xFFFF)));
+  const __m128i k_b = _mm_set1_epi32(
+      (int) ((ONE_HALF / 2) << 16 | ((FIX(1.77200) - FIX(2)) & 0xFFFF)));
+  /* pairs for (cb, cr) */
+  const __m128i k_g = _mm_set1_epi32(
+      (int) ((FIX(1) - FIX(0.71414)) << 16 | ((- FIX(0.34414)) & 0xFFFF)));
+  const __m128i half = _mm_set1_epi32(ONE_HALF);
+  JDIMENSION col;
+
+  for (col = 0; col + 8 < num_cols; col += 8) {
+    __m128i y, cb, cr, lo, hi, r, g, b, rg, bz, px;
+    int i;
+
+    y  = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *) (inptr0 + col)), zero);
+    cb = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *) (inptr1 + col)), zero);
+    cr = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *) (inptr2 + col)), zero);
+    cb = _mm_sub_epi16(cb, center);
+    cr = _mm_sub_epi16(cr, center);
+
+    lo = _mm_srai_epi32(_mm_madd_epi16(_mm_unpacklo_epi16(cr, two), k_r), SCALEBITS);
+    hi = _mm_srai_epi32(_mm_madd_epi16(_mm_unpackhi_epi16(cr, two), k_r), SCALEBITS);
+    r = _mm_add_epi16(_mm_add_epi16(y, cr), _mm_packs_epi32(lo, hi));
+
+    lo = _mm_srai_epi32(_mm_madd_epi16(_mm_unpacklo_epi16(cb, two), k_b), SCALEBITS);
+    hi = _mm_srai_epi32(_mm_madd_epi16(_mm_unpackhi_epi16(cb, two), k_b), SCALEBITS);
+    b = _mm_add_epi16(_mm_add_epi16(y, _mm_add_epi16(cb, cb)), _mm_packs_epi32(lo, hi));
+
+    lo = _mm_add_epi32(_mm_madd_epi16(_mm_unpacklo_epi16(cb, cr), k_g), half);
+    hi = _mm_add_epi32(_mm_madd_epi16(_mm_unpackhi_epi16(cb, cr), k_g), half);
+    lo = _mm_srai_epi32(lo, SCALEBITS);
+    hi = _mm_srai_epi32(hi, SCALEBITS);
+    g = _mm_add_epi16(_mm_sub_epi16(y, cr), _mm_packs_epi32(lo, hi));
+
+    /* range limit to 0..MAXJSAMPLE and interleave to R,G,B,pad */
+    r = _mm_packus_epi16(r, zero);
+    g = _mm_packus_epi16(g, zero);
+    b = _mm_packus_epi16(b, zero);
+    rg = _mm_unpacklo_epi8(r, g);
+    bz = _mm_unpacklo_epi8(b, zero);
+    px = _mm_unpacklo_epi16(rg, bz);
+    for (i = 0; i < 4; i++) {
+      int v = _mm_cvtsi128_si32(px);
+      MEMCOPY(outptr, &v, 4);
+      outptr += RGB_PIXELSIZE;
+      px = _mm_srli_si128(px, 4);
+    }
+    px = _mm_unpackhi_epi16(rg, bz);
+    for (i = 0; i < 4; i++) {
+      int v = _mm_cvtsi128_si32(px);
+      MEMCOPY(outptr, &v, 4);
+      outptr += RGB_PIXELSIZE;
+      px = _mm_srli_si128(px, 4);
+    }
+  }
+  return col;
+}
+
+#endif /* YCC_RGB_SSE2 */
+
+
 /*
  * Convert some rows of samples to the output colorspace.
  *
@@ -145,7 +235,13 @@ ycc_rgb_convert (j_decompress_ptr cinfo,
     inptr2 = input_buf[2][input_row];
     input_row++;
     outptr = *output_buf++;
-    for (col = 0; col < num_cols; col++) {
+#ifdef YCC_RGB_SSE2
+    col = ycc_rgb_convert_sse2(inptr0, inptr1, inptr2, outptr, num_cols);
+    outptr += col * RGB_PIXELSIZE;
+#else
+    col = 0;
+#endif
+    for (; col < num_cols; col++) {
       y  = GETJSAMPLE(inptr0[col]);
       cb = GETJSAMPLE(inptr1[col]);
       cr = GETJSAMPLE(inptr2[col]);
@@ -26,6 +26,10 @@
 #include "jinclude.h"
 #include "jpeglib.h"
 
+#ifdef SSE2_KERNELS_SUPPORTED
+#include <emmintrin.h>
+#endif
+
 
 /* Pointer to routine to upsample a single component */
 typedef JMETHOD(void, upsample1_ptr,
@@ -337,6 +341,53 @@ h2v1_fancy_upsample (j_decompress_ptr cinfo, jpeg_component_info * compptr,
 }
 
 
+#ifdef SSE2_KERNELS_SUPPORTED
+
+/*
+ * SSE2 version of the general case loop of h2v2_fancy_upsample, 8 input
+ * columns at a time.  Starts at input column 1 and stops while column
+ * colctr + 8 can still be read, leaving the remaining columns to the caller.
+ * Returns the first input column not done.
+ */
+
+LOCAL(JDIMENSION)
+h2v2_fancy_upsample_sse2 (JSAMPROW inptr0, JSAMPROW inptr1, JSAMPROW outptr,
+                          JDIMENSION width)
+{
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i three = _mm_set1_epi16(3);
+  const __m128i eight = _mm_set1_epi16(8);
+  const __m128i seven = _mm_set1_epi16(7);
+  JDIMENSION colctr;
+
+#define COLSUM(col) \
+  _mm_add_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8( \
+      _mm_loadl_epi64((const __m128i *) (inptr0 + (col))), zero), three), \
+    _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *) (inptr1 + (col))), zero))
+
+  for (colctr = 1; colctr + 8 < width; colctr += 8) {
+    __m128i lastcolsum = COLSUM(colctr - 1);
+    __m128i thiscolsum = _mm_mullo_epi16(COLSUM(colctr), three);
+    __m128i nextcolsum = COLSUM(colctr + 1);
+    __m128i even, odd;
+
+    even = _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(thiscolsum, lastcolsum),
+                                        eight), 4);
+    odd = _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(thiscolsum, nextcolsum),
+                                       seven), 4);
+    /* even and odd are 0..255, pack and interleave them */
+    even = _mm_packus_epi16(even, zero);
+    odd = _mm_packus_epi16(odd, zero);
+    _mm_storeu_si128((__m128i *) (outptr + colctr * 2),
+                     _mm_unpacklo_epi8(even, odd));
+  }
+#undef COLSUM
+  return colctr;
+}
+
+#endif /* SSE2_KERNELS_SUPPORTED */
+
+
 /*
  * Fancy processing for the common case of 2:1 horizontal and 2:1 vertical.
  * Again a triangle filter; see comments for h2v1 case, above.
@@ -377,7 +428,22 @@ h2v2_fancy_upsample (j_decompress_ptr cinfo, jpeg_component_info * compptr,
       *outptr++ = (JSAMPLE) ((thiscolsum * 3 + nextcolsum + 7) >> 4);
       lastcolsum = thiscolsum; thiscolsum = nextcolsum;
 
-      for (colctr = compptr->downsampled_width - 2; colctr > 0; colctr--) {
+      colctr = compptr->downsampled_width - 2;
+#ifdef SSE2_KERNELS_SUPPORTED
+      if (compptr->downsampled_width > 9) {
+        JDIMENSION done = h2v2_fancy_upsample_sse2(inptr0 - 2, inptr1 - 2,
+                                                   outptr - 2,
+                                                   compptr->downsampled_width);
+        /* resume the scalar loop at input column done */
+        inptr0 += done - 1;
+        inptr1 += done - 1;
+        outptr += (done - 1) * 2;
+        lastcolsum = GETJSAMPLE(inptr0[-2]) * 3 + GETJSAMPLE(inptr1[-2]);
+        thiscolsum = GETJSAMPLE(inptr0[-1]) * 3 + GETJSAMPLE(inptr1[-1]);
+        colctr -= done - 1;
+      }
+#endif
+      for (; colctr > 0; colctr--) {
         /* General case: 3/4 * nearer pixel + 1/4 * further pixel in each */
         /* dimension, thus 9/16, 3/16, 3/16, 1/16 overall */
         nextcolsum = GETJSAMPLE(*inptr0++) * 3 + GETJSAMPLE(*inptr1++);
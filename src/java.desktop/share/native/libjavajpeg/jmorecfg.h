@@ -375,4 +375,18 @@ typedef int boolean;
 #endif
 #endif
 
+
+/* Define SSE2_KERNELS_SUPPORTED to use SSE2 versions of the hottest
+ * decompression inner loops (YCbCr->RGB conversion, h2v2 fancy upsampling)
+ * when the compiler targets SSE2.  They produce exactly the same samples as
+ * the portable code.  Define NO_SSE2_KERNELS to use the portable code only.
+ */
+
+#if BITS_IN_JSAMPLE == 8 && !defined(NO_SSE2_KERNELS)
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SSE2_KERNELS_SUPPORTED
+#endif
+#endif
+
 #endif /* JPEG_INTERNAL_OPTIONS */
@@ -26,11 +26,16 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <memory.h>
+#ifndef _WIN32
+#include <pthread.h>
+#include <unistd.h>
+#endif
 #include "sun_java2d_cmm_lcms_LCMS.h"
 #include "jni_util.h"
 #include "Trace.h"
 #include "Disposer.h"
 #include <lcms2.h>
+#include <lcms2_plugin.h>
 #include "jlong.h"
 
 
@@ -89,6 +94,20 @@ cmsInt32Number TransportValue32(cmsInt32Number Value)
 
 #define ERR_MSG_SIZE 256
 
+/* Number of transforms kept in the transform cache */
+#define XFORM_CACHE_SIZE 16
+
+/* Longest profile sequence a cached transform may be built from */
+#define XFORM_CACHE_MAX_PROFILES 8
+
+/* Rasters with fewer pixels are always converted on the calling thread */
+#define XFORM_MT_MIN_PIXELS (1 << 18)
+
+/* Fewest rows a conversion thread gets */
+#define XFORM_MT_MIN_ROWS 16
+
+#define XFORM_MT_MAX_THREADS 8
+
 #ifdef _MSC_VER
 # ifndef snprintf
 #       define snprintf  _snprintf
@@ -118,6 +137,190 @@ static jfieldID IL_imageAtOnce_fID;
 
 JavaVM *javaVM;
 
+#ifndef _WIN32
+/*
+ * On the conversion threads of transformInStripes, points to the buffer
+ * where the error handler keeps the first lcms error of the stripe. The
+ * error is thrown on the calling thread once the stripes are done.
+ */
+static pthread_key_t stripeErrorKey;
+static cmsBool stripeErrorKeyCreated = FALSE;
+#endif
+
+/*
+ * Transform cache.
+ *
+ * Applications often create the same transform (same profiles, formats
+ * and intent) over and over, e.g. one per ColorConvertOp.filter call.
+ * Transforms are therefore shared: every transform created from a short
+ * enough profile sequence is tracked by a SharedTransform, which counts
+ * the LCMSTransform objects using it plus one reference while the cache
+ * holds it. The cache keeps the XFORM_CACHE_SIZE most recently used
+ * transforms. A cached transform is dropped from the cache when one of its
+ * profiles is changed or freed; it is deleted once its last user goes away.
+ *
+ * cmsDoTransform does not modify the transform, so sharing one between
+ * threads is safe.
+ */
+typedef struct SharedTransform_s {
+    struct SharedTransform_s *next;    /* in most recently used order */
+    cmsHTRANSFORM sTrans;
+    int refs;
+    cmsBool cached;
+    /* key */
+    cmsHPROFILE profiles[XFORM_CACHE_MAX_PROFILES];
+    int nProfiles;
+    cmsUInt32Number inFormatter;
+    cmsUInt32Number outFormatter;
+    cmsUInt32Number renderType;
+} SharedTransform;
+
+static SharedTransform* sharedTransforms = NULL;
+static int cachedTransforms = 0;
+static void* xformCacheMutex = NULL;
+
+static cmsBool lockXFormCache() {
+    return xformCacheMutex != NULL && _cmsLockMutex(NULL, xformCacheMutex);
+}
+
+static void unlockXFormCache() {
+    _cmsUnlockMutex(NULL, xformCacheMutex);
+}
+
+/* Drops a reference, the lock must be held.
+ * Returns the transform if it has to be deleted. */
+static cmsHTRANSFORM releaseSharedTransform(SharedTransform** link) {
+    SharedTransform* st = *link;
+    cmsHTRANSFORM sTrans = NULL;
+
+    if (--st->refs == 0) {
+        *link = st->next;
+        sTrans = st->sTrans;
+        free(st);
+    }
+    return sTrans;
+}
+
+/* Removes transforms built from pf from the cache */
+static void uncacheTransforms(cmsHPROFILE pf) {
+    SharedTransform** link;
+    cmsHTRANSFORM toDelete[XFORM_CACHE_SIZE];
+    int i, n = 0;
+
+    if (!lockXFormCache()) {
+        return;
+    }
+    link = &sharedTransforms;
+    while (*link != NULL) {
+        SharedTransform* st = *link;
+        cmsBool uses = FALSE;
+        if (st->cached) {
+            for (i = 0; i < st->nProfiles; i++) {
+                if (st->profiles[i] == pf) {
+                    uses = TRUE;
+                    break;
+                }
+            }
+        }
+        if (uses) {
+            cmsHTRANSFORM sTrans;
+            st->cached = FALSE;
+            cachedTransforms--;
+            sTrans = releaseSharedTransform(link);
+            if (sTrans != NULL) {
+                toDelete[n++] = sTrans;
+                continue;   /* *link is the next one already */
+            }
+        }
+        link = &st->next;
+    }
+    unlockXFormCache();
+
+    for (i = 0; i < n; i++) {
+        cmsDeleteTransform(toDelete[i]);
+    }
+}
+
+/* Returns a new reference to a cached transform, or NULL */
+static cmsHTRANSFORM getCachedTransform(cmsHPROFILE* iccArray, int n,
+                                        cmsUInt32Number inFormatter,
+                                        cmsUInt32Number outFormatter,
+                                        cmsUInt32Number renderType) {
+    SharedTransform** link;
+    cmsHTRANSFORM sTrans = NULL;
+
+    if (!lockXFormCache()) {
+        return NULL;
+    }
+    for (link = &sharedTransforms; *link != NULL; link = &(*link)->next) {
+        SharedTransform* st = *link;
+        if (st->cached && st->nProfiles == n &&
+            st->inFormatter == inFormatter &&
+            st->outFormatter == outFormatter &&
+            st->renderType == renderType &&
+            memcmp(st->profiles, iccArray, n * sizeof(cmsHPROFILE)) == 0)
+        {
+            st->refs++;
+            sTrans = st->sTrans;
+            /* move to front */
+            *link = st->next;
+            st->next = sharedTransforms;
+            sharedTransforms = st;
+            break;
+        }
+    }
+    unlockXFormCache();
+    return sTrans;
+}
+
+/* Puts a newly created transform, owned by the caller, into the cache */
+static void cacheTransform(cmsHTRANSFORM sTrans,
+                           cmsHPROFILE* iccArray, int n,
+                           cmsUInt32Number inFormatter,
+                           cmsUInt32Number outFormatter,
+                           cmsUInt32Number renderType) {
+    SharedTransform* st;
+    cmsHTRANSFORM evicted = NULL;
+
+    st = (SharedTransform*) malloc(sizeof(SharedTransform));
+    if (st == NULL) {
+        return;
+    }
+    st->sTrans = sTrans;
+    st->refs = 2;   /* the caller and the cache */
+    st->cached = TRUE;
+    memcpy(st->profiles, iccArray, n * sizeof(cmsHPROFILE));
+    st->nProfiles = n;
+    st->inFormatter = inFormatter;
+    st->outFormatter = outFormatter;
+    st->renderType = renderType;
+
+    if (!lockXFormCache()) {
+        free(st);
+        return;
+    }
+    st->next = sharedTransforms;
+    sharedTransforms = st;
+    if (++cachedTransforms > XFORM_CACHE_SIZE) {
+        /* evict the least recently used cached transform */
+        SharedTransform** link;
+        SharedTransform** lru = NULL;
+        for (link = &sharedTransforms; *link != NULL; link = &(*link)->next) {
+            if ((*link)->cached) {
+                lru = link;
+            }
+        }
+        (*lru)->cached = FALSE;
+        cachedTransforms--;
+        evicted = releaseSharedTransform(lru);
+    }
+    unlockXFormCache();
+
+    if (evicted != NULL) {
+        cmsDeleteTransform(evicted);
+    }
+}
+
 void errorHandler(cmsContext ContextID, cmsUInt32Number errorCode,
                   const char *errorText) {
     JNIEnv *env;
@@ -130,6 +333,18 @@ void errorHandler(cmsContext ContextID, cmsUInt32Number errorCode,
     }
     errMsg[count] = 0;
 
+#ifndef _WIN32
+    if (stripeErrorKeyCreated) {
+        char* stripeErrMsg = (char*) pthread_getspecific(stripeErrorKey);
+        if (stripeErrMsg != NULL) {
+            if (stripeErrMsg[0] == 0) {
+                memcpy(stripeErrMsg, errMsg, count + 1);
+            }
+            return;
+        }
+    }
+#endif
+
     (*javaVM)->AttachCurrentThread(javaVM, (void**)&env, NULL);
     JNU_ThrowByName(env, "java/awt/color/CMMException", errMsg);
 }
@@ -137,6 +352,10 @@ void errorHandler(cmsContext ContextID, cmsUInt32Number errorCode,
 JNIEXPORT jint JNICALL DEF_JNI_OnLoad(JavaVM *jvm, void *reserved) {
     javaVM = jvm;
 
+    xformCacheMutex = _cmsCreateMutex(NULL);
+#ifndef _WIN32
+    stripeErrorKeyCreated = pthread_key_create(&stripeErrorKey, NULL) == 0;
+#endif
     cmsSetLogErrorHandler(errorHandler);
     return JNI_VERSION_1_6;
 }
@@ -146,6 +365,7 @@ void LCMS_freeProfile(JNIEnv *env, jlong ptr) {
 
     if (p != NULL) {
         if (p->pf != NULL) {
+            uncacheTransforms(p->pf);
             cmsCloseProfile(p->pf);
         }
         free(p);
@@ -155,8 +375,21 @@ void LCMS_freeProfile(JNIEnv *env, jlong ptr) {
 void LCMS_freeTransform(JNIEnv *env, jlong ID)
 {
     cmsHTRANSFORM sTrans = jlong_to_ptr(ID);
+    SharedTransform** link;
+
     /* Passed ID is always valid native ref so there is no check for zero */
-    cmsDeleteTransform(sTrans);
+    if (lockXFormCache()) {
+        for (link = &sharedTransforms; *link != NULL; link = &(*link)->next) {
+            if ((*link)->sTrans == sTrans) {
+                sTrans = releaseSharedTransform(link);
+                break;
+            }
+        }
+        unlockXFormCache();
+    }
+    if (sTrans != NULL) {
+        cmsDeleteTransform(sTrans);
+    }
 }
 
 /*
@@ -223,8 +456,18 @@ JNIEXPORT jlong JNICALL Java_sun_java2d_cmm_lcms_LCMS_createNativeTransform
         }
     }
 
-    sTrans = cmsCreateMultiprofileTransform(iccArray, j,
-        inFormatter, outFormatter, renderType, 0);
+    if (j <= XFORM_CACHE_MAX_PROFILES) {
+        sTrans = getCachedTransform(iccArray, j,
+                                    inFormatter, outFormatter, renderType);
+    }
+    if (sTrans == NULL) {
+        sTrans = cmsCreateMultiprofileTransform(iccArray, j,
+            inFormatter, outFormatter, renderType, 0);
+        if (sTrans != NULL && j <= XFORM_CACHE_MAX_PROFILES) {
+            cacheTransform(sTrans, iccArray, j,
+                           inFormatter, outFormatter, renderType);
+        }
+    }
 
     (*env)->ReleaseLongArrayElements(env, profileIDs, ids, 0);
 
@@ -514,9 +757,13 @@ JNIEXPORT void JNICALL Java_sun_java2d_cmm_lcms_LCMS_setTagDataNative
 
     if (!status) {
         JNU_ThrowIllegalArgumentException(env, "Can not write tag data.");
-    } else if (pfReplace != NULL) {
-        cmsCloseProfile(sProf->pf);
-        sProf->pf = pfReplace;
+    } else {
+        /* cached transforms no longer match the profile */
+        uncacheTransforms(sProf->pf);
+        if (pfReplace != NULL) {
+            cmsCloseProfile(sProf->pf);
+            sProf->pf = pfReplace;
+        }
     }
 }
 
@@ -562,6 +809,103 @@ void releaseILData (JNIEnv *env, void* pData, jint dataType,
     }
 }
 
+#ifndef _WIN32
+
+typedef struct {
+    cmsHTRANSFORM sTrans;
+    char* inputRow;
+    char* outputRow;
+    int srcNextRowOffset;
+    int dstNextRowOffset;
+    int width;
+    int height;
+    char errMsg[ERR_MSG_SIZE];  /* first error on a conversion thread */
+} XFormStripe;
+
+static void doTransformStripe(XFormStripe* s) {
+    int i;
+
+    for (i = 0; i < s->height; i++) {
+        cmsDoTransform(s->sTrans, s->inputRow, s->outputRow, s->width);
+        s->inputRow += s->srcNextRowOffset;
+        s->outputRow += s->dstNextRowOffset;
+    }
+}
+
+static void* transformStripeThread(void* arg) {
+    XFormStripe* s = (XFormStripe*) arg;
+
+    /* Errors are kept in the stripe instead of being thrown here */
+    pthread_setspecific(stripeErrorKey, s->errMsg);
+    doTransformStripe(s);
+    return NULL;
+}
+
+/*
+ * Converts a large raster in row stripes on several threads, the calling
+ * thread taking the first stripe. Returns FALSE if the raster is too small
+ * to be worth it, in which case nothing has been done. An lcms error on
+ * another thread is thrown as a CMMException on the calling thread.
+ */
+static cmsBool transformInStripes(JNIEnv* env, XFormStripe* whole) {
+    XFormStripe stripes[XFORM_MT_MAX_THREADS];
+    pthread_t threads[XFORM_MT_MAX_THREADS];
+    cmsBool started[XFORM_MT_MAX_THREADS];
+    long ncpu;
+    int n, i, row;
+
+    if (!stripeErrorKeyCreated ||
+        (long) whole->width * whole->height < XFORM_MT_MIN_PIXELS) {
+        return FALSE;
+    }
+    ncpu = sysconf(_SC_NPROCESSORS_ONLN);
+    n = whole->height / XFORM_MT_MIN_ROWS;
+    if (n > ncpu) {
+        n = (int) ncpu;
+    }
+    if (n > XFORM_MT_MAX_THREADS) {
+        n = XFORM_MT_MAX_THREADS;
+    }
+    if (n < 2) {
+        return FALSE;
+    }
+
+    row = 0;
+    for (i = 0; i < n; i++) {
+        int rows = (whole->height - row) / (n - i);
+        stripes[i] = *whole;
+        stripes[i].inputRow += (size_t) row * whole->srcNextRowOffset;
+        stripes[i].outputRow += (size_t) row * whole->dstNextRowOffset;
+        stripes[i].height = rows;
+        stripes[i].errMsg[0] = 0;
+        row += rows;
+    }
+    for (i = 1; i < n; i++) {
+        started[i] = pthread_create(&threads[i], NULL, transformStripeThread,
+                                    &stripes[i]) == 0;
+    }
+    doTransformStripe(&stripes[0]);
+    for (i = 1; i < n; i++) {
+        if (started[i]) {
+            pthread_join(threads[i], NULL);
+        } else {
+            doTransformStripe(&stripes[i]);
+        }
+    }
+    for (i = 1; i < n; i++) {
+        if (stripes[i].errMsg[0] != 0) {
+            if (!(*env)->ExceptionCheck(env)) {
+                JNU_ThrowByName(env, "java/awt/color/CMMException",
+                                stripes[i].errMsg);
+            }
+            break;
+        }
+    }
+    return TRUE;
+}
+
+#endif /* !_WIN32 */
+
 /*
  * Class:     sun_java2d_cmm_lcms_LCMS
  * Method:    colorConvert
@@ -620,6 +964,24 @@ JNIEXPORT void JNICALL Java_sun_java2d_cmm_lcms_LCMS_colorConvert
     inputRow = (char*)inputBuffer + srcOffset;
     outputRow = (char*)outputBuffer + dstOffset;
 
+#ifndef _WIN32
+    {
+        XFormStripe whole;
+        whole.sTrans = sTrans;
+        whole.inputRow = inputRow;
+        whole.outputRow = outputRow;
+        whole.srcNextRowOffset = srcNextRowOffset;
+        whole.dstNextRowOffset = dstNextRowOffset;
+        whole.width = width;
+        whole.height = height;
+        if (transformInStripes(env, &whole)) {
+            releaseILData(env, inputBuffer, srcDType, srcData);
+            releaseILData(env, outputBuffer, dstDType, dstData);
+            return;
+        }
+    }
+#endif
+
     if (srcAtOnce && dstAtOnce) {
         cmsDoTransform(sTrans, inputRow, outputRow, width * height);
     } else {
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2003, 2018, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2003, 2019, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -75,10 +75,142 @@
 #include "mlib_ImageCheck.h"
 #include "mlib_ImageAffine.h"
 
+#ifndef _WIN32
+#include <pthread.h>
+#include <stdlib.h>
+#include <unistd.h>
+#endif /* _WIN32 */
+
 
 /***************************************************************/
 #define BUFF_SIZE  600
 
+/***************************************************************/
+/*
+ * Large images are transformed in bands of rows on several threads.
+ * Every destination row only depends on the source image, so the
+ * result does not depend on the number of bands.
+ */
+#define MT_MAX_THREADS  16
+#define MT_MIN_PIXELS   (1 << 20)   /* smallest image worth splitting */
+#define MT_MIN_ROWS     64          /* smallest band */
+
+#ifndef _WIN32
+
+typedef struct {
+  type_affine_fun   fun;
+  mlib_affine_param param;
+  mlib_status       res;
+} mlib_affine_band;
+
+static mlib_s32 mlib_affine_threads = -1;
+
+/*
+ * The number of threads to use for one transform, the number of
+ * online processors by default, at most MT_MAX_THREADS. It can be
+ * lowered with the MLIB_IMAGE_THREADS environment variable, and
+ * MLIB_IMAGE_THREADS=1 keeps everything on the calling thread.
+ */
+static mlib_s32 mlib_AffineMaxThreads(void)
+{
+  if (mlib_affine_threads < 0) {
+    const char *env = getenv("MLIB_IMAGE_THREADS");
+    long n = (env != NULL) ? strtol(env, NULL, 10) : sysconf(_SC_NPROCESSORS_ONLN);
+
+    if (n < 1)
+      n = 1;
+    if (n > MT_MAX_THREADS)
+      n = MT_MAX_THREADS;
+    mlib_affine_threads = (mlib_s32) n;
+  }
+
+  return mlib_affine_threads;
+}
+
+/*
+ * libmlib_image is not linked with -lpthread. Where the pthread
+ * functions live in a separate library (glibc before 2.34), they are
+ * referenced weakly and the bands run on the calling thread unless
+ * the process has loaded libpthread anyway, as the JDK launcher does.
+ */
+#ifdef __linux__
+#pragma weak pthread_create
+#pragma weak pthread_join
+#define MLIB_HAVE_THREADS() (pthread_create != NULL && pthread_join != NULL)
+#else
+#define MLIB_HAVE_THREADS() 1
+#endif /* __linux__ */
+
+static void *mlib_AffineBandThread(void *arg)
+{
+  mlib_affine_band *band = (mlib_affine_band *) arg;
+
+  band->res = band->fun(&band->param);
+  return NULL;
+}
+
+#endif /* _WIN32 */
+
+/***************************************************************/
+/*
+ * Calls fun for the rows param->yStart to param->yFinish, split in
+ * bands that run concurrently if the image is large enough.
+ */
+static mlib_status mlib_AffineRunBands(type_affine_fun   fun,
+                                       mlib_affine_param *param)
+{
+#ifndef _WIN32
+  mlib_affine_band bands[MT_MAX_THREADS];
+  pthread_t threads[MT_MAX_THREADS];
+  mlib_s32 started[MT_MAX_THREADS];
+  mlib_s32 rows = param->yFinish - param->yStart + 1;
+  mlib_s32 nbands, band_rows, y, i;
+  mlib_status res = MLIB_SUCCESS;
+
+  if (rows <= 0 || (mlib_d64) rows * param->max_xsize < MT_MIN_PIXELS ||
+      !MLIB_HAVE_THREADS())
+    return fun(param);
+
+  nbands = mlib_AffineMaxThreads();
+  if (nbands > rows / MT_MIN_ROWS)
+    nbands = rows / MT_MIN_ROWS;
+  if (nbands <= 1)
+    return fun(param);
+
+  band_rows = (rows + nbands - 1) / nbands;
+  for (i = 0, y = param->yStart; i < nbands; i++, y += band_rows) {
+    bands[i].fun = fun;
+    bands[i].param = *param;
+    bands[i].param.yStart = y;
+    bands[i].param.yFinish = (y + band_rows - 1 < param->yFinish) ? y + band_rows - 1 : param->yFinish;
+    bands[i].param.dstData = param->dstData + (mlib_s64) (y - param->yStart) * param->dstYStride;
+    bands[i].res = MLIB_SUCCESS;
+  }
+
+  /* The calling thread does the first band, and any band that did
+   * not get a thread of its own. */
+  for (i = 1; i < nbands; i++) {
+    started[i] = (pthread_create(&threads[i], NULL, mlib_AffineBandThread, &bands[i]) == 0);
+  }
+  mlib_AffineBandThread(&bands[0]);
+  for (i = 1; i < nbands; i++) {
+    if (started[i])
+      pthread_join(threads[i], NULL);
+    else
+      mlib_AffineBandThread(&bands[i]);
+  }
+
+  for (i = 0; i < nbands; i++) {
+    if (bands[i].res != MLIB_SUCCESS)
+      res = bands[i].res;
+  }
+
+  return res;
+#else
+  return fun(param);
+#endif /* _WIN32 */
+}
+
 /***************************************************************/
 const type_affine_fun mlib_AffineFunArr_nn[] = {
   mlib_ImageAffine_u8_1ch_nn,  mlib_ImageAffine_u8_2ch_nn,
@@ -222,18 +354,18 @@ mlib_status mlib_ImageAffine_alltypes(mlib_image       *dst,
           t_ind++;
         }
 
-        res = mlib_AffineFunArr_nn[4 * t_ind + (nchan - 1)] (param);
+        res = mlib_AffineRunBands(mlib_AffineFunArr_nn[4 * t_ind + (nchan - 1)], param);
         break;
 
       case MLIB_BILINEAR:
 
-        res = mlib_AffineFunArr_bl[4 * t_ind + (nchan - 1)] (param);
+        res = mlib_AffineRunBands(mlib_AffineFunArr_bl[4 * t_ind + (nchan - 1)], param);
         break;
 
       case MLIB_BICUBIC:
       case MLIB_BICUBIC2:
 
-        res = mlib_AffineFunArr_bc[4 * t_ind + (nchan - 1)] (param);
+        res = mlib_AffineRunBands(mlib_AffineFunArr_bc[4 * t_ind + (nchan - 1)], param);
         break;
     }
 
@@ -127,29 +127,22 @@ JNIEXPORT jint JNICALL Java_sun_security_pkcs11_wrapper_PKCS11_C_1DigestSingle
     if (ckAssertReturnValueOK(env, rv) != CK_ASSERT_OK) { return 0; }
 
     if (jInLen <= MAX_STACK_BUFFER_LEN) {
-        bufP = BUF;
+        (*env)->GetByteArrayRegion(env, jIn, jInOfs, jInLen, (jbyte *)BUF);
+        if ((*env)->ExceptionCheck(env)) { return 0; }
+        rv = (*ckpFunctions->C_Digest)(ckSessionHandle, BUF, jInLen, DIGESTBUF, &ckDigestLength);
     } else {
-        /* always use single part op, even for large data */
-        bufP = (CK_BYTE_PTR) malloc((size_t)jInLen);
-        if (bufP == NULL) {
-            throwOutOfMemoryError(env, 0);
-            return 0;
-        }
+        /* always use single part op, even for large data, and digest
+         * the array in place rather than a heap copy of it */
+        bufP = (*env)->GetPrimitiveArrayCritical(env, jIn, NULL);
+        if (bufP == NULL) { return 0; }
+        rv = (*ckpFunctions->C_Digest)(ckSessionHandle, bufP + jInOfs, jInLen, DIGESTBUF, &ckDigestLength);
+        (*env)->ReleasePrimitiveArrayCritical(env, jIn, bufP, JNI_ABORT);
     }
 
-    (*env)->GetByteArrayRegion(env, jIn, jInOfs, jInLen, (jbyte *)bufP);
-    if ((*env)->ExceptionCheck(env)) {
-        if (bufP != BUF) { free(bufP); }
-        return 0;
-    }
-
-    rv = (*ckpFunctions->C_Digest)(ckSessionHandle, bufP, jInLen, DIGESTBUF, &ckDigestLength);
     if (ckAssertReturnValueOK(env, rv) == CK_ASSERT_OK) {
         (*env)->SetByteArrayRegion(env, jDigest, jDigestOfs, ckDigestLength, (jbyte *)DIGESTBUF);
     }
 
-    if (bufP != BUF) { free(bufP); }
-
     return ckDigestLength;
 }
 #endif
@@ -171,7 +164,6 @@ JNIEXPORT void JNICALL Java_sun_security_pkcs11_wrapper_PKCS11_C_1DigestUpdate
     CK_RV rv;
     CK_BYTE_PTR bufP;
     CK_BYTE BUF[MAX_STACK_BUFFER_LEN];
-    jsize bufLen;
 
     CK_FUNCTION_LIST_PTR ckpFunctions = getFunctionList(env, obj);
     if (ckpFunctions == NULL) { return; }
@@ -184,37 +176,22 @@ JNIEXPORT void JNICALL Java_sun_security_pkcs11_wrapper_PKCS11_C_1DigestUpdate
         return;
     }
 
-    if (jInLen <= MAX_STACK_BUFFER_LEN) {
-        bufLen = MAX_STACK_BUFFER_LEN;
-        bufP = BUF;
-    } else {
-        bufLen = min(MAX_HEAP_BUFFER_LEN, jInLen);
-        bufP = (CK_BYTE_PTR) malloc((size_t)bufLen);
-        if (bufP == NULL) {
-            throwOutOfMemoryError(env, 0);
-            return;
-        }
+    if (jInLen > MAX_STACK_BUFFER_LEN) {
+        /* hand large parts to the token in place instead of copying them
+         * through a heap buffer chunk by chunk */
+        bufP = (*env)->GetPrimitiveArrayCritical(env, jIn, NULL);
+        if (bufP == NULL) { return; }
+        rv = (*ckpFunctions->C_DigestUpdate)(ckSessionHandle, bufP + jInOfs, jInLen);
+        (*env)->ReleasePrimitiveArrayCritical(env, jIn, bufP, JNI_ABORT);
+        ckAssertReturnValueOK(env, rv);
+        return;
     }
 
-    while (jInLen > 0) {
-        jsize chunkLen = min(bufLen, jInLen);
-        (*env)->GetByteArrayRegion(env, jIn, jInOfs, chunkLen, (jbyte *)bufP);
-        if ((*env)->ExceptionCheck(env)) {
-            if (bufP != BUF) { free(bufP); }
-            return;
-        }
-        rv = (*ckpFunctions->C_DigestUpdate)(ckSessionHandle, bufP, chunkLen);
-        if (ckAssertReturnValueOK(env, rv) != CK_ASSERT_OK) {
-            if (bufP != BUF) { free(bufP); }
-            return;
-        }
-        jInOfs += chunkLen;
-        jInLen -= chunkLen;
-    }
+    (*env)->GetByteArrayRegion(env, jIn, jInOfs, jInLen, (jbyte *)BUF);
+    if ((*env)->ExceptionCheck(env)) { return; }
 
-    if (bufP != BUF) {
-        free(bufP);
-    }
+    rv = (*ckpFunctions->C_DigestUpdate)(ckSessionHandle, BUF, jInLen);
+    ckAssertReturnValueOK(env, rv);
 }
 #endif
 
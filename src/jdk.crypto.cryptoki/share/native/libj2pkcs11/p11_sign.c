@@ -108,9 +108,10 @@ JNIEXPORT jbyteArray JNICALL Java_sun_security_pkcs11_wrapper_PKCS11_C_1Sign
 {
     CK_SESSION_HANDLE ckSessionHandle;
     CK_BYTE_PTR ckpData = NULL_PTR;
-    CK_BYTE_PTR ckpSignature;
-    CK_ULONG ckDataLength;
-    CK_ULONG ckSignatureLength = 0;
+    CK_BYTE BUF[MAX_STACK_BUFFER_LEN];
+    CK_BYTE_PTR ckpSignature = BUF;
+    CK_ULONG ckDataLength = 0;
+    CK_ULONG ckSignatureLength = MAX_STACK_BUFFER_LEN;
     jbyteArray jSignature = NULL;
     CK_RV rv;
 
@@ -118,27 +119,32 @@ JNIEXPORT jbyteArray JNICALL Java_sun_security_pkcs11_wrapper_PKCS11_C_1Sign
     if (ckpFunctions == NULL) { return NULL; }
 
     ckSessionHandle = jLongToCKULong(jSessionHandle);
-    jByteArrayToCKByteArray(env, jData, &ckpData, &ckDataLength);
-    if ((*env)->ExceptionCheck(env)) { return NULL; }
+
+    /* sign the array in place, and try a stack buffer for the signature
+     * first to save the round trip to the token that asks for its length */
+    if (jData != NULL) {
+        ckDataLength = (*env)->GetArrayLength(env, jData);
+        ckpData = (*env)->GetPrimitiveArrayCritical(env, jData, NULL);
+        if (ckpData == NULL) { return NULL; }
+    }
 
     /* START standard code */
 
-    /* first determine the length of the signature */
-    rv = (*ckpFunctions->C_Sign)(ckSessionHandle, ckpData, ckDataLength, NULL_PTR, &ckSignatureLength);
-    if (ckAssertReturnValueOK(env, rv) != CK_ASSERT_OK) {
-        free(ckpData);
-        return NULL;
+    rv = (*ckpFunctions->C_Sign)(ckSessionHandle, ckpData, ckDataLength, ckpSignature, &ckSignatureLength);
+    if (rv == CKR_BUFFER_TOO_SMALL) {
+        ckpSignature = (CK_BYTE_PTR) malloc(ckSignatureLength * sizeof(CK_BYTE));
+        if (ckpSignature != NULL) {
+            rv = (*ckpFunctions->C_Sign)(ckSessionHandle, ckpData, ckDataLength, ckpSignature, &ckSignatureLength);
+        }
     }
 
-    ckpSignature = (CK_BYTE_PTR) malloc(ckSignatureLength * sizeof(CK_BYTE));
+    if (ckpData != NULL_PTR) {
+        (*env)->ReleasePrimitiveArrayCritical(env, jData, ckpData, JNI_ABORT);
+    }
     if (ckpSignature == NULL) {
-        free(ckpData);
         throwOutOfMemoryError(env, 0);
         return NULL;
     }
-
-    /* now get the signature */
-    rv = (*ckpFunctions->C_Sign)(ckSessionHandle, ckpData, ckDataLength, ckpSignature, &ckSignatureLength);
  /* END standard code */
 
 
@@ -167,8 +173,7 @@ JNIEXPORT jbyteArray JNICALL Java_sun_security_pkcs11_wrapper_PKCS11_C_1Sign
     if (ckAssertReturnValueOK(env, rv) == CK_ASSERT_OK) {
         jSignature = ckByteArrayToJByteArray(env, ckpSignature, ckSignatureLength);
     }
-    free(ckpData);
-    free(ckpSignature);
+    if (ckpSignature != BUF) { free(ckpSignature); }
 
     return jSignature ;
 }
@@ -191,7 +196,6 @@ JNIEXPORT void JNICALL Java_sun_security_pkcs11_wrapper_PKCS11_C_1SignUpdate
     CK_RV rv;
     CK_BYTE_PTR bufP;
     CK_BYTE BUF[MAX_STACK_BUFFER_LEN];
-    jsize bufLen;
 
     CK_FUNCTION_LIST_PTR ckpFunctions = getFunctionList(env, obj);
     if (ckpFunctions == NULL) { return; }
@@ -204,37 +208,22 @@ JNIEXPORT void JNICALL Java_sun_security_pkcs11_wrapper_PKCS11_C_1SignUpdate
         return;
     }
 
-    if (jInLen <= MAX_STACK_BUFFER_LEN) {
-        bufLen = MAX_STACK_BUFFER_LEN;
-        bufP = BUF;
-    } else {
-        bufLen = min(MAX_HEAP_BUFFER_LEN, jInLen);
-        bufP = (CK_BYTE_PTR) malloc((size_t)bufLen);
-        if (bufP == NULL) {
-            throwOutOfMemoryError(env, 0);
-            return;
-        }
+    if (jInLen > MAX_STACK_BUFFER_LEN) {
+        /* hand large parts to the token in place instead of copying them
+         * through a heap buffer chunk by chunk */
+        bufP = (*env)->GetPrimitiveArrayCritical(env, jIn, NULL);
+        if (bufP == NULL) { return; }
+        rv = (*ckpFunctions->C_SignUpdate)(ckSessionHandle, bufP + jInOfs, jInLen);
+        (*env)->ReleasePrimitiveArrayCritical(env, jIn, bufP, JNI_ABORT);
+        ckAssertReturnValueOK(env, rv);
+        return;
     }
 
-    while (jInLen > 0) {
-        jsize chunkLen = min(bufLen, jInLen);
-        (*env)->GetByteArrayRegion(env, jIn, jInOfs, chunkLen, (jbyte *)bufP);
-        if ((*env)->ExceptionCheck(env)) {
-            if (bufP != BUF) { free(bufP); }
-            return;
-        }
-        rv = (*ckpFunctions->C_SignUpdate)(ckSessionHandle, bufP, chunkLen);
-        if (ckAssertReturnValueOK(env, rv) != CK_ASSERT_OK) {
-            if (bufP != BUF) {
-                free(bufP);
-            }
-            return;
-        }
-        jInOfs += chunkLen;
-        jInLen -= chunkLen;
-    }
+    (*env)->GetByteArrayRegion(env, jIn, jInOfs, jInLen, (jbyte *)BUF);
+    if ((*env)->ExceptionCheck(env)) { return; }
 
-    if (bufP != BUF) { free(bufP); }
+    rv = (*ckpFunctions->C_SignUpdate)(ckSessionHandle, BUF, jInLen);
+    ckAssertReturnValueOK(env, rv);
 }
 #endif
 
@@ -445,28 +434,44 @@ JNIEXPORT void JNICALL Java_sun_security_pkcs11_wrapper_PKCS11_C_1Verify
     CK_SESSION_HANDLE ckSessionHandle;
     CK_BYTE_PTR ckpData = NULL_PTR;
     CK_BYTE_PTR ckpSignature = NULL_PTR;
-    CK_ULONG ckDataLength;
-    CK_ULONG ckSignatureLength;
+    CK_ULONG ckDataLength = 0;
+    CK_ULONG ckSignatureLength = 0;
     CK_RV rv;
 
     CK_FUNCTION_LIST_PTR ckpFunctions = getFunctionList(env, obj);
     if (ckpFunctions == NULL) { return; }
 
     ckSessionHandle = jLongToCKULong(jSessionHandle);
-    jByteArrayToCKByteArray(env, jData, &ckpData, &ckDataLength);
-    if ((*env)->ExceptionCheck(env)) { return; }
 
-    jByteArrayToCKByteArray(env, jSignature, &ckpSignature, &ckSignatureLength);
-    if ((*env)->ExceptionCheck(env)) {
-        free(ckpData);
-        return;
+    /* verify the arrays in place instead of copying them */
+    if (jData != NULL) {
+        ckDataLength = (*env)->GetArrayLength(env, jData);
+    }
+    if (jSignature != NULL) {
+        ckSignatureLength = (*env)->GetArrayLength(env, jSignature);
+        ckpSignature = (*env)->GetPrimitiveArrayCritical(env, jSignature, NULL);
+        if (ckpSignature == NULL) { return; }
+    }
+    if (jData != NULL) {
+        ckpData = (*env)->GetPrimitiveArrayCritical(env, jData, NULL);
+        if (ckpData == NULL) {
+            // Make sure to release ckpSignature
+            if (ckpSignature != NULL_PTR) {
+                (*env)->ReleasePrimitiveArrayCritical(env, jSignature, ckpSignature, JNI_ABORT);
+            }
+            return;
+        }
     }
 
     /* verify the signature */
     rv = (*ckpFunctions->C_Verify)(ckSessionHandle, ckpData, ckDataLength, ckpSignature, ckSignatureLength);
 
-    free(ckpData);
-    free(ckpSignature);
+    if (ckpData != NULL_PTR) {
+        (*env)->ReleasePrimitiveArrayCritical(env, jData, ckpData, JNI_ABORT);
+    }
+    if (ckpSignature != NULL_PTR) {
+        (*env)->ReleasePrimitiveArrayCritical(env, jSignature, ckpSignature, JNI_ABORT);
+    }
 
     if (ckAssertReturnValueOK(env, rv) != CK_ASSERT_OK) { return; }
 }
@@ -489,7 +494,6 @@ JNIEXPORT void JNICALL Java_sun_security_pkcs11_wrapper_PKCS11_C_1VerifyUpdate
     CK_RV rv;
     CK_BYTE_PTR bufP;
     CK_BYTE BUF[MAX_STACK_BUFFER_LEN];
-    jsize bufLen;
 
     CK_FUNCTION_LIST_PTR ckpFunctions = getFunctionList(env, obj);
     if (ckpFunctions == NULL) { return; }
@@ -502,36 +506,22 @@ JNIEXPORT void JNICALL Java_sun_security_pkcs11_wrapper_PKCS11_C_1VerifyUpdate
         return;
     }
 
-    if (jInLen <= MAX_STACK_BUFFER_LEN) {
-        bufLen = MAX_STACK_BUFFER_LEN;
-        bufP = BUF;
-    } else {
-        bufLen = min(MAX_HEAP_BUFFER_LEN, jInLen);
-        bufP = (CK_BYTE_PTR) malloc((size_t)bufLen);
-        if (bufP == NULL) {
-            throwOutOfMemoryError(env, 0);
-            return;
-        }
+    if (jInLen > MAX_STACK_BUFFER_LEN) {
+        /* hand large parts to the token in place instead of copying them
+         * through a heap buffer chunk by chunk */
+        bufP = (*env)->GetPrimitiveArrayCritical(env, jIn, NULL);
+        if (bufP == NULL) { return; }
+        rv = (*ckpFunctions->C_VerifyUpdate)(ckSessionHandle, bufP + jInOfs, jInLen);
+        (*env)->ReleasePrimitiveArrayCritical(env, jIn, bufP, JNI_ABORT);
+        ckAssertReturnValueOK(env, rv);
+        return;
     }
 
-    while (jInLen > 0) {
-        jsize chunkLen = min(bufLen, jInLen);
-        (*env)->GetByteArrayRegion(env, jIn, jInOfs, chunkLen, (jbyte *)bufP);
-        if ((*env)->ExceptionCheck(env)) {
-            if (bufP != BUF) { free(bufP); }
-            return;
-        }
-
-        rv = (*ckpFunctions->C_VerifyUpdate)(ckSessionHandle, bufP, chunkLen);
-        if (ckAssertReturnValueOK(env, rv) != CK_ASSERT_OK) {
-            if (bufP != BUF) { free(bufP); }
-            return;
-        }
-        jInOfs += chunkLen;
-        jInLen -= chunkLen;
-    }
+    (*env)->GetByteArrayRegion(env, jIn, jInOfs, jInLen, (jbyte *)BUF);
+    if ((*env)->ExceptionCheck(env)) { return; }
 
-    if (bufP != BUF) { free(bufP); }
+    rv = (*ckpFunctions->C_VerifyUpdate)(ckSessionHandle, BUF, jInLen);
+    ckAssertReturnValueOK(env, rv);
 }
 #endif
 
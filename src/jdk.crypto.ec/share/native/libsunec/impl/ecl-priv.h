@@ -52,6 +52,13 @@
 #define ECL_THIRTY_TWO_BIT
 #endif
 
+/* Fixed size constant time point multiplication for P-256 and P-384
+ * needs 64-bit digits and a 128-bit product type. */
+#if defined(ECL_SIXTY_FOUR_BIT) && defined(__SIZEOF_INT128__) && \
+    !defined(ECL_NO_FIXED)
+#define ECL_USE_FIXED
+#endif
+
 #define ECL_CURVE_DIGITS(curve_size_in_bits) \
         (((curve_size_in_bits)+(sizeof(mp_digit)*8-1))/(sizeof(mp_digit)*8))
 #define ECL_BITS (sizeof(mp_digit)*8)
@@ -290,6 +297,10 @@ mp_err ec_group_set_gf2m163(ECGroup *group, ECCurveName name);
 mp_err ec_group_set_gf2m193(ECGroup *group, ECCurveName name);
 mp_err ec_group_set_gf2m233(ECGroup *group, ECCurveName name);
 
+#ifdef ECL_USE_FIXED
+mp_err ec_group_set_fixed(ECGroup *group, ECCurveName name);
+#endif
+
 /* Optimized floating-point arithmetic */
 #ifdef ECL_USE_FP
 mp_err ec_group_set_secp160r1_fp(ECGroup *group);
@@ -338,6 +338,11 @@ ecgroup_fromNameAndHex(const ECCurveName name,
                 goto CLEANUP;
         }
 
+#ifdef ECL_USE_FIXED
+        /* constant time point multiplication for P-256 and P-384 */
+        MP_CHECKOK(ec_group_set_fixed(group, name));
+#endif
+
         /* set name, if any */
         if ((group != NULL) && (params->text != NULL)) {
 #ifdef _KERNEL
@@ -0,0 +1,743 @@
+/*
+ * Copyright (c) 2020, Oracle and/or its affiliates. All rights reserved.
+ * Use is subject to license terms.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/* *********************************************************************
+ *
+ * Fixed size, constant time point multiplication for the NIST P-256 and
+ * P-384 curves.
+ *
+ * Field elements are kept as arrays of 64-bit limbs in Montgomery form
+ * (R = 2^256 and 2^384) and multiplied with a word by word Montgomery
+ * reduction.  Points are kept in projective coordinates and added with
+ * the complete formulas for a = -3 of Renes, Costello and Batina,
+ * "Complete addition formulas for prime order elliptic curves", which
+ * have no exceptional cases, so the point at infinity and doublings do
+ * not need any branches.
+ *
+ * Scalars are recoded into signed windows.  Every window does the same
+ * sequence of field operations and reads the whole precomputed table,
+ * so neither the running time nor the memory access pattern depends on
+ * the scalar.  Multiples of the P-256 generator come from a precomputed
+ * table (ecp_fixed_tab.h), which removes all doublings.
+ *
+ *********************************************************************** */
+
+#include "ecp.h"
+#include "mpi.h"
+#include "mplogic.h"
+#include "mpi-priv.h"
+#ifndef _KERNEL
+#include <stdlib.h>
+#include <string.h>
+#endif
+
+#ifdef ECL_USE_FIXED
+
+typedef unsigned __int128 ecf_dword;
+
+#define ECF_MAX_LIMBS 6
+
+/* Window width of the variable base and the generator multiplication */
+#define ECF_WINDOW          5
+#define ECF_BASE_WINDOW     4
+
+typedef struct {
+        int limbs;
+        mp_digit p[ECF_MAX_LIMBS];      /* field prime */
+        mp_digit n0;                    /* -p^-1 mod 2^64 */
+        mp_digit rr[ECF_MAX_LIMBS];     /* R^2 mod p */
+        mp_digit one[ECF_MAX_LIMBS];    /* R mod p, i.e. 1 in Montgomery form */
+        mp_digit b[ECF_MAX_LIMBS];      /* curve coefficient b * R mod p */
+        mp_digit pm2[ECF_MAX_LIMBS];    /* p - 2, the inversion exponent */
+        const mp_digit (*base)[8][8];   /* generator table, or NULL */
+} ecf_curve;
+
+typedef struct {
+        mp_digit x[ECF_MAX_LIMBS];
+        mp_digit y[ECF_MAX_LIMBS];
+        mp_digit z[ECF_MAX_LIMBS];
+} ecf_point;
+
+#include "ecp_fixed_tab.h"
+
+static const ecf_curve ecf_nistp256 = {
+        4,
+        { 0xffffffffffffffffULL, 0x00000000ffffffffULL, 0x0000000000000000ULL,
+          0xffffffff00000001ULL },
+        0x0000000000000001ULL,
+        { 0x0000000000000003ULL, 0xfffffffbffffffffULL, 0xfffffffffffffffeULL,
+          0x00000004fffffffdULL },
+        { 0x0000000000000001ULL, 0xffffffff00000000ULL, 0xffffffffffffffffULL,
+          0x00000000fffffffeULL },
+        { 0xd89cdf6229c4bddfULL, 0xacf005cd78843090ULL, 0xe5a220abf7212ed6ULL,
+          0xdc30061d04874834ULL },
+        { 0xfffffffffffffffdULL, 0x00000000ffffffffULL, 0x0000000000000000ULL,
+          0xffffffff00000001ULL },
+        ecp_fixed_p256_base
+};
+
+static const ecf_curve ecf_nistp384 = {
+        6,
+        { 0x00000000ffffffffULL, 0xffffffff00000000ULL, 0xfffffffffffffffeULL,
+          0xffffffffffffffffULL, 0xffffffffffffffffULL, 0xffffffffffffffffULL },
+        0x0000000100000001ULL,
+        { 0xfffffffe00000001ULL, 0x0000000200000000ULL, 0xfffffffe00000000ULL,
+          0x0000000200000000ULL, 0x0000000000000001ULL, 0x0000000000000000ULL },
+        { 0xffffffff00000001ULL, 0x00000000ffffffffULL, 0x0000000000000001ULL,
+          0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL },
+        { 0x081188719d412dccULL, 0xf729add87a4c32ecULL, 0x77f2209b1920022eULL,
+          0xe3374bee94938ae2ULL, 0xb62b21f41f022094ULL, 0xcd08114b604fbff9ULL },
+        { 0x00000000fffffffdULL, 0xffffffff00000000ULL, 0xfffffffffffffffeULL,
+          0xffffffffffffffffULL, 0xffffffffffffffffULL, 0xffffffffffffffffULL },
+        NULL
+};
+
+/* All ones if a == b, zero otherwise, without branches. */
+static mp_digit
+ecf_eq_mask(mp_digit a, mp_digit b)
+{
+        mp_digit x = a ^ b;
+        return ((x | (0 - x)) >> (MP_DIGIT_BIT - 1)) - 1;
+}
+
+/* r = a if mask is all ones, r unchanged if mask is zero. */
+static void
+ecf_select(mp_digit *r, const mp_digit *a, mp_digit mask, int n)
+{
+        int i;
+        for (i = 0; i < n; i++) {
+                r[i] ^= mask & (r[i] ^ a[i]);
+        }
+}
+
+/* r = a - p if that does not borrow, r = a otherwise; carry is the bit
+ * above a.  r can be a. */
+static void
+ecf_reduce_once(const ecf_curve *c, mp_digit *r, const mp_digit *a,
+                                mp_digit carry)
+{
+        mp_digit t[ECF_MAX_LIMBS];
+        mp_digit borrow = 0, mask;
+        int i, n = c->limbs;
+
+        for (i = 0; i < n; i++) {
+                ecf_dword d = (ecf_dword)a[i] - c->p[i] - borrow;
+                t[i] = (mp_digit)d;
+                borrow = (mp_digit)(d >> 64) & 1;
+        }
+        /* keep a if it was less than p, i.e. the subtraction borrowed
+         * beyond the carry bit */
+        mask = 0 - (borrow & (carry ^ 1));
+        for (i = 0; i < n; i++) {
+                r[i] = (a[i] & mask) | (t[i] & ~mask);
+        }
+}
+
+static void
+ecf_add(const ecf_curve *c, mp_digit *r, const mp_digit *a, const mp_digit *b)
+{
+        mp_digit t[ECF_MAX_LIMBS] = { 0 };
+        mp_digit carry = 0;
+        int i, n = c->limbs;
+
+        for (i = 0; i < n; i++) {
+                ecf_dword s = (ecf_dword)a[i] + b[i] + carry;
+                t[i] = (mp_digit)s;
+                carry = (mp_digit)(s >> 64);
+        }
+        ecf_reduce_once(c, r, t, carry);
+}
+
+static void
+ecf_sub(const ecf_curve *c, mp_digit *r, const mp_digit *a, const mp_digit *b)
+{
+        mp_digit t[ECF_MAX_LIMBS];
+        mp_digit borrow = 0, carry = 0, mask;
+        int i, n = c->limbs;
+
+        for (i = 0; i < n; i++) {
+                ecf_dword d = (ecf_dword)a[i] - b[i] - borrow;
+                t[i] = (mp_digit)d;
+                borrow = (mp_digit)(d >> 64) & 1;
+        }
+        /* add p back if the subtraction borrowed */
+        mask = 0 - borrow;
+        for (i = 0; i < n; i++) {
+                ecf_dword s = (ecf_dword)t[i] + (c->p[i] & mask) + carry;
+                r[i] = (mp_digit)s;
+                carry = (mp_digit)(s >> 64);
+        }
+}
+
+/* Montgomery multiplication r = a * b / R mod p, for a < R and b < p.
+ * r can be a or b. */
+static void
+ecf_mul(const ecf_curve *c, mp_digit *r, const mp_digit *a, const mp_digit *b)
+{
+        mp_digit t[ECF_MAX_LIMBS + 2] = { 0 };
+        int i, j, n = c->limbs;
+
+        for (i = 0; i < n; i++) {
+                mp_digit carry = 0, m;
+                ecf_dword w;
+
+                for (j = 0; j < n; j++) {
+                        w = (ecf_dword)a[j] * b[i] + t[j] + carry;
+                        t[j] = (mp_digit)w;
+                        carry = (mp_digit)(w >> 64);
+                }
+                w = (ecf_dword)t[n] + carry;
+                t[n] = (mp_digit)w;
+                t[n + 1] = (mp_digit)(w >> 64);
+
+                m = t[0] * c->n0;
+                w = (ecf_dword)m * c->p[0] + t[0];
+                carry = (mp_digit)(w >> 64);
+                for (j = 1; j < n; j++) {
+                        w = (ecf_dword)m * c->p[j] + t[j] + carry;
+                        t[j - 1] = (mp_digit)w;
+                        carry = (mp_digit)(w >> 64);
+                }
+                w = (ecf_dword)t[n] + carry;
+                t[n - 1] = (mp_digit)w;
+                t[n] = t[n + 1] + (mp_digit)(w >> 64);
+        }
+        ecf_reduce_once(c, r, t, t[n]);
+}
+
+static void
+ecf_sqr(const ecf_curve *c, mp_digit *r, const mp_digit *a)
+{
+        ecf_mul(c, r, a, a);
+}
+
+/* r = a^-1 in Montgomery form, as a^(p-2).  The exponent is public, so
+ * the square and multiply sequence does not depend on a.  The inverse
+ * of 0 comes out as 0. */
+static void
+ecf_inv(const ecf_curve *c, mp_digit *r, const mp_digit *a)
+{
+        mp_digit t[ECF_MAX_LIMBS];
+        int i, n = c->limbs;
+
+        memcpy(t, c->one, sizeof(t));
+        for (i = n * MP_DIGIT_BIT - 1; i >= 0; i--) {
+                ecf_sqr(c, t, t);
+                if ((c->pm2[i / MP_DIGIT_BIT] >> (i % MP_DIGIT_BIT)) & 1) {
+                        ecf_mul(c, t, t, a);
+                }
+        }
+        memcpy(r, t, sizeof(t));
+}
+
+/* r = p1 + p2, Algorithm 4 of Renes, Costello and Batina.  r can be p1
+ * or p2. */
+static void
+ecf_pt_add(const ecf_curve *c, ecf_point *r, const ecf_point *p1,
+                   const ecf_point *p2)
+{
+        mp_digit t0[ECF_MAX_LIMBS], t1[ECF_MAX_LIMBS], t2[ECF_MAX_LIMBS];
+        mp_digit t3[ECF_MAX_LIMBS], t4[ECF_MAX_LIMBS];
+        mp_digit x3[ECF_MAX_LIMBS], y3[ECF_MAX_LIMBS], z3[ECF_MAX_LIMBS];
+
+        ecf_mul(c, t0, p1->x, p2->x);
+        ecf_mul(c, t1, p1->y, p2->y);
+        ecf_mul(c, t2, p1->z, p2->z);
+        ecf_add(c, t3, p1->x, p1->y);
+        ecf_add(c, t4, p2->x, p2->y);
+        ecf_mul(c, t3, t3, t4);
+        ecf_add(c, t4, t0, t1);
+        ecf_sub(c, t3, t3, t4);
+        ecf_add(c, t4, p1->y, p1->z);
+        ecf_add(c, x3, p2->y, p2->z);
+        ecf_mul(c, t4, t4, x3);
+        ecf_add(c, x3, t1, t2);
+        ecf_sub(c, t4, t4, x3);
+        ecf_add(c, x3, p1->x, p1->z);
+        ecf_add(c, y3, p2->x, p2->z);
+        ecf_mul(c, x3, x3, y3);
+        ecf_add(c, y3, t0, t2);
+        ecf_sub(c, y3, x3, y3);
+        ecf_mul(c, z3, c->b, t2);
+        ecf_sub(c, x3, y3, z3);
+        ecf_add(c, z3, x3, x3);
+        ecf_add(c, x3, x3, z3);
+        ecf_sub(c, z3, t1, x3);
+        ecf_add(c, x3, t1, x3);
+        ecf_mul(c, y3, c->b, y3);
+        ecf_add(c, t1, t2, t2);
+        ecf_add(c, t2, t1, t2);
+        ecf_sub(c, y3, y3, t2);
+        ecf_sub(c, y3, y3, t0);
+        ecf_add(c, t1, y3, y3);
+        ecf_add(c, y3, t1, y3);
+        ecf_add(c, t1, t0, t0);
+        ecf_add(c, t0, t1, t0);
+        ecf_sub(c, t0, t0, t2);
+        ecf_mul(c, t1, t4, y3);
+        ecf_mul(c, t2, t0, y3);
+        ecf_mul(c, y3, x3, z3);
+        ecf_add(c, y3, y3, t2);
+        ecf_mul(c, x3, t3, x3);
+        ecf_sub(c, x3, x3, t1);
+        ecf_mul(c, z3, t4, z3);
+        ecf_mul(c, t1, t3, t0);
+        ecf_add(c, z3, z3, t1);
+
+        memcpy(r->x, x3, sizeof(x3));
+        memcpy(r->y, y3, sizeof(y3));
+        memcpy(r->z, z3, sizeof(z3));
+}
+
+/* r = 2 * p, Algorithm 6 of Renes, Costello and Batina.  r can be p. */
+static void
+ecf_pt_dbl(const ecf_curve *c, ecf_point *r, const ecf_point *p)
+{
+        mp_digit t0[ECF_MAX_LIMBS], t1[ECF_MAX_LIMBS], t2[ECF_MAX_LIMBS];
+        mp_digit t3[ECF_MAX_LIMBS];
+        mp_digit x3[ECF_MAX_LIMBS], y3[ECF_MAX_LIMBS], z3[ECF_MAX_LIMBS];
+
+        ecf_sqr(c, t0, p->x);
+        ecf_sqr(c, t1, p->y);
+        ecf_sqr(c, t2, p->z);
+        ecf_mul(c, t3, p->x, p->y);
+        ecf_add(c, t3, t3, t3);
+        ecf_mul(c, z3, p->x, p->z);
+        ecf_add(c, z3, z3, z3);
+        ecf_mul(c, y3, c->b, t2);
+        ecf_sub(c, y3, y3, z3);
+        ecf_add(c, x3, y3, y3);
+        ecf_add(c, y3, x3, y3);
+        ecf_sub(c, x3, t1, y3);
+        ecf_add(c, y3, t1, y3);
+        ecf_mul(c, y3, x3, y3);
+        ecf_mul(c, x3, x3, t3);
+        ecf_add(c, t3, t2, t2);
+        ecf_add(c, t2, t2, t3);
+        ecf_mul(c, z3, c->b, z3);
+        ecf_sub(c, z3, z3, t2);
+        ecf_sub(c, z3, z3, t0);
+        ecf_add(c, t3, z3, z3);
+        ecf_add(c, z3, z3, t3);
+        ecf_add(c, t3, t0, t0);
+        ecf_add(c, t0, t3, t0);
+        ecf_sub(c, t0, t0, t2);
+        ecf_mul(c, t0, t0, z3);
+        ecf_add(c, y3, y3, t0);
+        ecf_mul(c, t0, p->y, p->z);
+        ecf_add(c, t0, t0, t0);
+        ecf_mul(c, z3, t0, z3);
+        ecf_sub(c, x3, x3, z3);
+        ecf_mul(c, z3, t0, t1);
+        ecf_add(c, z3, z3, z3);
+        ecf_add(c, z3, z3, z3);
+
+        memcpy(r->x, x3, sizeof(x3));
+        memcpy(r->y, y3, sizeof(y3));
+        memcpy(r->z, z3, sizeof(z3));
+}
+
+/* Negates the y coordinate of p if nmask is all ones. */
+static void
+ecf_pt_cond_neg(const ecf_curve *c, ecf_point *p, mp_digit nmask)
+{
+        mp_digit zero[ECF_MAX_LIMBS] = { 0 };
+        mp_digit ny[ECF_MAX_LIMBS];
+
+        ecf_sub(c, ny, zero, p->y);
+        ecf_select(p->y, ny, nmask, c->limbs);
+}
+
+/* Returns the w+1 bits of k starting at bit pos-1, bits outside of k
+ * being 0.  pos is public, only the value read depends on the scalar. */
+static unsigned int
+ecf_window(const mp_digit *k, int limbs, int pos, int w)
+{
+        unsigned int mask = (1U << (w + 1)) - 1;
+        int start = pos - 1;
+        int idx, sh;
+        mp_digit v;
+
+        if (start < 0) {
+                return (unsigned int)(k[0] << 1) & mask;
+        }
+        idx = start / MP_DIGIT_BIT;
+        sh = start % MP_DIGIT_BIT;
+        if (idx >= limbs) {
+                return 0;
+        }
+        v = k[idx] >> sh;
+        if (sh + w + 1 > MP_DIGIT_BIT && idx + 1 < limbs) {
+                v |= k[idx + 1] << (MP_DIGIT_BIT - sh);
+        }
+        return (unsigned int)v & mask;
+}
+
+/* Recodes a w+1 bit window into a digit in [0, 2^w] and a sign, such
+ * that the digits sum up to the scalar. */
+static void
+ecf_recode(unsigned int in, int w, unsigned int *digit, unsigned int *sign)
+{
+        unsigned int s, d;
+
+        s = ~((in >> w) - 1);
+        d = (1U << (w + 1)) - in - 1;
+        d = (d & s) | (in & ~s);
+        d = (d >> 1) + (d & 1);
+        *sign = s & 1;
+        *digit = d;
+}
+
+/* Copies the scalar into k, zero padded.  The scalar is at most the
+ * group order and has at most limbs digits. */
+static mp_err
+ecf_scalar(const ecf_curve *c, const mp_int *n, mp_digit *k)
+{
+        int i;
+
+        if (MP_USED(n) > c->limbs) {
+                return MP_BADARG;
+        }
+        for (i = 0; i < c->limbs; i++) {
+                k[i] = i < (int)MP_USED(n) ? MP_DIGIT(n, i) : 0;
+        }
+        return MP_OKAY;
+}
+
+/* Converts a field element, field-encoded with meth or plain if meth is
+ * NULL, into Montgomery form. */
+static mp_err
+ecf_from_mp(const ecf_curve *c, const mp_int *a, mp_digit *r,
+                        const GFMethod *meth)
+{
+        mp_err res = MP_OKAY;
+        mp_int t;
+        const mp_int *v = a;
+        int i;
+
+        MP_DIGITS(&t) = 0;
+        if (meth != NULL && meth->field_dec) {
+                MP_CHECKOK(mp_init(&t, FLAG(a)));
+                MP_CHECKOK(meth->field_dec(a, &t, meth));
+                v = &t;
+        }
+        if (MP_SIGN(v) != MP_ZPOS || MP_USED(v) > c->limbs) {
+                res = MP_BADARG;
+                goto CLEANUP;
+        }
+        for (i = 0; i < c->limbs; i++) {
+                r[i] = i < (int)MP_USED(v) ? MP_DIGIT(v, i) : 0;
+        }
+        ecf_mul(c, r, r, c->rr);
+
+  CLEANUP:
+        mp_clear(&t);
+        return res;
+}
+
+/* Converts a field element from Montgomery form into an mp_int,
+ * field-encoded with meth or plain if meth is NULL. */
+static mp_err
+ecf_to_mp(const ecf_curve *c, const mp_digit *a, mp_int *r,
+                  const GFMethod *meth)
+{
+        mp_err res = MP_OKAY;
+        mp_digit plain[ECF_MAX_LIMBS];
+        mp_digit unit[ECF_MAX_LIMBS] = { 1 };
+        int i;
+
+        ecf_mul(c, plain, a, unit);
+        MP_CHECKOK(s_mp_pad(r, c->limbs));
+        for (i = 0; i < c->limbs; i++) {
+                MP_DIGIT(r, i) = plain[i];
+        }
+        MP_SIGN(r) = MP_ZPOS;
+        MP_USED(r) = c->limbs;
+        s_mp_clamp(r);
+        if (meth != NULL && meth->field_enc) {
+                MP_CHECKOK(meth->field_enc(r, r, meth));
+        }
+
+  CLEANUP:
+        return res;
+}
+
+/* Converts projective p to field-encoded affine coordinates.  The point
+ * at infinity comes out as (0, 0), as elsewhere in this library. */
+static mp_err
+ecf_pt_to_mp(const ecf_curve *c, const ecf_point *p, mp_int *rx, mp_int *ry,
+                         const GFMethod *meth)
+{
+        mp_err res = MP_OKAY;
+        mp_digit zinv[ECF_MAX_LIMBS], x[ECF_MAX_LIMBS], y[ECF_MAX_LIMBS];
+
+        ecf_inv(c, zinv, p->z);
+        ecf_mul(c, x, p->x, zinv);
+        ecf_mul(c, y, p->y, zinv);
+        MP_CHECKOK(ecf_to_mp(c, x, rx, meth));
+        MP_CHECKOK(ecf_to_mp(c, y, ry, meth));
+
+  CLEANUP:
+        return res;
+}
+
+/* Loads field-encoded affine (px, py) as a projective point. */
+static mp_err
+ecf_pt_from_mp(const ecf_curve *c, const mp_int *px, const mp_int *py,
+                           ecf_point *p, const GFMethod *meth)
+{
+        mp_err res = MP_OKAY;
+
+        memset(p, 0, sizeof(*p));
+        if (mp_cmp_z(px) == 0 && mp_cmp_z(py) == 0) {
+                /* point at infinity, (0 : 1 : 0) */
+                memcpy(p->y, c->one, sizeof(p->y));
+                return MP_OKAY;
+        }
+        MP_CHECKOK(ecf_from_mp(c, px, p->x, meth));
+        MP_CHECKOK(ecf_from_mp(c, py, p->y, meth));
+        memcpy(p->z, c->one, sizeof(p->z));
+
+  CLEANUP:
+        return res;
+}
+
+/* Clears secret intermediate values, through a volatile pointer so the
+ * stores are not optimized away. */
+static void
+ecf_wipe(void *v, size_t len)
+{
+        volatile unsigned char *p = (volatile unsigned char *)v;
+        while (len--) {
+                *p++ = 0;
+        }
+}
+
+/* r = k * p with a signed fixed window.  All windows do the same work. */
+static void
+ecf_pt_mul(const ecf_curve *c, ecf_point *r, const mp_digit *k,
+                   const ecf_point *p)
+{
+        ecf_point table[1 << (ECF_WINDOW - 1)];
+        ecf_point t;
+        int tsize = 1 << (ECF_WINDOW - 1);
+        int bits = c->limbs * MP_DIGIT_BIT;
+        int nwin = (bits + ECF_WINDOW) / ECF_WINDOW;
+        int i, j, w;
+
+        /* table[i] = (i + 1) * p */
+        table[0] = *p;
+        ecf_pt_dbl(c, &table[1], p);
+        for (i = 2; i < tsize; i++) {
+                ecf_pt_add(c, &table[i], &table[i - 1], p);
+        }
+
+        memset(r, 0, sizeof(*r));
+        memcpy(r->y, c->one, sizeof(r->y));
+
+        for (w = nwin - 1; w >= 0; w--) {
+                unsigned int digit, sign;
+
+                for (i = 0; i < ECF_WINDOW; i++) {
+                        ecf_pt_dbl(c, r, r);
+                }
+                ecf_recode(ecf_window(k, c->limbs, w * ECF_WINDOW, ECF_WINDOW),
+                                   ECF_WINDOW, &digit, &sign);
+
+                /* t = digit * p, infinity for digit 0 */
+                memset(&t, 0, sizeof(t));
+                memcpy(t.y, c->one, sizeof(t.y));
+                for (j = 0; j < tsize; j++) {
+                        mp_digit mask = ecf_eq_mask(digit, j + 1);
+                        ecf_select(t.x, table[j].x, mask, c->limbs);
+                        ecf_select(t.y, table[j].y, mask, c->limbs);
+                        ecf_select(t.z, table[j].z, mask, c->limbs);
+                }
+                ecf_pt_cond_neg(c, &t, 0 - (mp_digit)sign);
+                ecf_pt_add(c, r, r, &t);
+        }
+
+        ecf_wipe(table, sizeof(table));
+        ecf_wipe(&t, sizeof(t));
+}
+
+/* r = k * G from the precomputed table of the curve, one addition per
+ * window and no doublings. */
+static void
+ecf_base_mul(const ecf_curve *c, ecf_point *r, const mp_digit *k)
+{
+        ecf_point t;
+        int bits = c->limbs * MP_DIGIT_BIT;
+        int nwin = (bits + ECF_BASE_WINDOW) / ECF_BASE_WINDOW;
+        int i, j;
+
+        memset(r, 0, sizeof(*r));
+        memcpy(r->y, c->one, sizeof(r->y));
+
+        for (i = 0; i < nwin; i++) {
+                unsigned int digit, sign;
+                mp_digit nonzero;
+
+                ecf_recode(ecf_window(k, c->limbs, i * ECF_BASE_WINDOW,
+                                                          ECF_BASE_WINDOW),
+                                   ECF_BASE_WINDOW, &digit, &sign);
+
+                /* t = digit * 16^i * G, infinity for digit 0 */
+                memset(&t, 0, sizeof(t));
+                for (j = 0; j < 8; j++) {
+                        mp_digit mask = ecf_eq_mask(digit, j + 1);
+                        ecf_select(t.x, &c->base[i][j][0], mask, c->limbs);
+                        ecf_select(t.y, &c->base[i][j][4], mask, c->limbs);
+                }
+                nonzero = ~ecf_eq_mask(digit, 0);
+                ecf_select(t.z, c->one, nonzero, c->limbs);
+                ecf_select(t.y, c->one, ~nonzero, c->limbs);
+                ecf_pt_cond_neg(c, &t, 0 - (mp_digit)sign);
+                ecf_pt_add(c, r, r, &t);
+        }
+
+        ecf_wipe(&t, sizeof(t));
+}
+
+static void
+ecf_base_point_mul_any(const ecf_curve *c, ecf_point *r, const mp_digit *k,
+                                           const ecf_point *g)
+{
+        if (c->base != NULL) {
+                ecf_base_mul(c, r, k);
+        } else {
+                ecf_pt_mul(c, r, k, g);
+        }
+}
+
+/* Computes R = nP where R is (rx, ry) and P is (px, py).  The inputs and
+ * outputs are field-encoded. */
+static mp_err
+ec_GFp_pt_mul_fixed(const mp_int *n, const mp_int *px, const mp_int *py,
+                                        mp_int *rx, mp_int *ry, const ECGroup *group,
+                                        int timing)
+{
+        mp_err res = MP_OKAY;
+        const ecf_curve *c = (const ecf_curve *)group->extra1;
+        mp_digit k[ECF_MAX_LIMBS];
+        ecf_point p, r;
+
+        MP_CHECKOK(ecf_scalar(c, n, k));
+        MP_CHECKOK(ecf_pt_from_mp(c, px, py, &p, group->meth));
+        ecf_pt_mul(c, &r, k, &p);
+        MP_CHECKOK(ecf_pt_to_mp(c, &r, rx, ry, group->meth));
+
+  CLEANUP:
+        ecf_wipe(k, sizeof(k));
+        return res;
+}
+
+/* Computes R = nG where R is (rx, ry) and G is the base point.  The
+ * outputs are field-encoded. */
+static mp_err
+ec_GFp_base_point_mul_fixed(const mp_int *n, mp_int *rx, mp_int *ry,
+                                                        const ECGroup *group)
+{
+        mp_err res = MP_OKAY;
+        const ecf_curve *c = (const ecf_curve *)group->extra1;
+        mp_digit k[ECF_MAX_LIMBS];
+        ecf_point g, r;
+
+        MP_CHECKOK(ecf_scalar(c, n, k));
+        if (c->base == NULL) {
+                MP_CHECKOK(ecf_pt_from_mp(c, &group->genx, &group->geny, &g,
+                                                                  group->meth));
+        }
+        ecf_base_point_mul_any(c, &r, k, &g);
+        MP_CHECKOK(ecf_pt_to_mp(c, &r, rx, ry, group->meth));
+
+  CLEANUP:
+        ecf_wipe(k, sizeof(k));
+        return res;
+}
+
+/* Computes R = k1 * G + k2 * P.  Allows k1 = NULL or { k2, P } = NULL.
+ * The inputs and outputs are NOT field-encoded, as for ECPoints_mul. */
+static mp_err
+ec_GFp_pts_mul_fixed(const mp_int *k1, const mp_int *k2, const mp_int *px,
+                                         const mp_int *py, mp_int *rx, mp_int *ry,
+                                         const ECGroup *group, int timing)
+{
+        mp_err res = MP_OKAY;
+        const ecf_curve *c;
+        mp_digit k[ECF_MAX_LIMBS];
+        ecf_point g, p, r1, r2;
+
+        ARGCHK(group != NULL, MP_BADARG);
+        ARGCHK(!((k1 == NULL)
+                         && ((k2 == NULL) || (px == NULL)
+                                 || (py == NULL))), MP_BADARG);
+
+        if (k1 == NULL || k2 == NULL || px == NULL || py == NULL) {
+                return ec_pts_mul_basic(k1, k2, px, py, rx, ry, group, timing);
+        }
+
+        c = (const ecf_curve *)group->extra1;
+        MP_CHECKOK(ecf_scalar(c, k1, k));
+        if (c->base == NULL) {
+                MP_CHECKOK(ecf_pt_from_mp(c, &group->genx, &group->geny, &g,
+                                                                  group->meth));
+        }
+        ecf_base_point_mul_any(c, &r1, k, &g);
+
+        MP_CHECKOK(ecf_scalar(c, k2, k));
+        MP_CHECKOK(ecf_pt_from_mp(c, px, py, &p, NULL));
+        ecf_pt_mul(c, &r2, k, &p);
+
+        ecf_pt_add(c, &r1, &r1, &r2);
+        MP_CHECKOK(ecf_pt_to_mp(c, &r1, rx, ry, NULL));
+
+  CLEANUP:
+        ecf_wipe(k, sizeof(k));
+        return res;
+}
+
+/* Switches the point multiplications of the P-256 and P-384 groups to
+ * the fixed size implementation.  The field arithmetic of the group is
+ * left alone; it is still used for point validation and affine
+ * additions. */
+mp_err
+ec_group_set_fixed(ECGroup *group, ECCurveName name)
+{
+        const ecf_curve *c;
+
+        if (name == ECCurve_NIST_P256) {
+                c = &ecf_nistp256;
+        } else if (name == ECCurve_NIST_P384) {
+                c = &ecf_nistp384;
+        } else {
+                return MP_OKAY;
+        }
+        group->extra1 = (void *)c;
+        group->point_mul = &ec_GFp_pt_mul_fixed;
+        group->base_point_mul = &ec_GFp_base_point_mul_fixed;
+        group->points_mul = &ec_GFp_pts_mul_fixed;
+        return MP_OKAY;
+}
+
+#endif /* ECL_USE_FIXED */
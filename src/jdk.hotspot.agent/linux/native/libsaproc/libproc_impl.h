@@ -56,6 +56,10 @@ typedef struct map_info {
    off_t            offset;   // file offset of this mapping
    uintptr_t        vaddr;    // starting virtual address
    size_t           memsz;    // size of the mapping
+   const char*      contents; // file contents mmap'ed on first read, or NULL
+   void*            mmap_addr;// start of the mmap'ed pages
+   size_t           mmap_len; // length of the mmap'ed pages
+   bool             mmap_failed; // mmap was tried and failed, use pread
    struct map_info* next;
 } map_info;
 
@@ -88,6 +92,7 @@ struct core_data {
    // part of the class sharing workaround
    map_info*          class_share_maps;// class share maps in a linked list
    map_info**         map_array; // sorted (by vaddr) array of map_info pointers
+   map_info*          last_map;  // map_array entry of the last lookup
 };
 
 struct ps_prochandle {
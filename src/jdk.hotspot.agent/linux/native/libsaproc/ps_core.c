@@ -30,6 +30,8 @@
 #include <stddef.h>
 #include <elf.h>
 #include <link.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 #include "libproc_impl.h"
 #include "proc_service.h"
 #include "salibelf.h"
@@ -73,12 +75,19 @@ static void close_files(struct ps_prochandle* ph) {
   }
 }
 
+static void free_map_info(map_info* map) {
+  if (map->mmap_addr != NULL) {
+    munmap(map->mmap_addr, map->mmap_len);
+  }
+  free(map);
+}
+
 // clean all map_info stuff
 static void destroy_map_info(struct ps_prochandle* ph) {
   map_info* map = ph->core->maps;
   while (map) {
     map_info* next = map->next;
-    free(map);
+    free_map_info(map);
     map = next;
   }
 
@@ -90,7 +99,7 @@ static void destroy_map_info(struct ps_prochandle* ph) {
   map = ph->core->class_share_maps;
   while (map) {
     map_info* next = map->next;
-    free(map);
+    free_map_info(map);
     map = next;
   }
 }
@@ -155,6 +164,12 @@ static map_info* core_lookup(struct ps_prochandle *ph, uintptr_t addr) {
   int mid, lo = 0, hi = ph->core->num_maps - 1;
   map_info *mp;
 
+  // heap walks read one map after the other, try the last hit first
+  mp = ph->core->last_map;
+  if (mp != NULL && addr >= mp->vaddr && addr < mp->vaddr + mp->memsz) {
+    return (mp);
+  }
+
   while (hi - lo > 1) {
     mid = (lo + hi) / 2;
     if (addr >= ph->core->map_array[mid]->vaddr) {
@@ -171,6 +186,7 @@ static map_info* core_lookup(struct ps_prochandle *ph, uintptr_t addr) {
   }
 
   if (addr >= mp->vaddr && addr < mp->vaddr + mp->memsz) {
+    ph->core->last_map = mp;
     return (mp);
   }
 
@@ -427,11 +443,39 @@ static bool sort_map_array(struct ps_prochandle* ph) {
 #define MIN(x, y) (((x) < (y))? (x): (y))
 #endif
 
+// Returns the file contents of a map, mmap'ing them on first use so
+// that reads become memory copies rather than a pread call each. Returns
+// NULL if the contents can not be mapped, callers then use pread.
+static const char* map_contents(map_info* mp, int page_size) {
+   if (mp->contents == NULL && !mp->mmap_failed) {
+      off_t start = mp->offset & ~((off_t)page_size - 1);
+      size_t len = mp->memsz + (size_t)(mp->offset - start);
+      struct stat st;
+      void* addr = MAP_FAILED;
+
+      // touching pages past the end of a truncated core would SIGBUS
+      if (mp->memsz > 0 && fstat(mp->fd, &st) == 0 &&
+          mp->offset + (off_t)mp->memsz <= st.st_size) {
+         addr = mmap(NULL, len, PROT_READ, MAP_PRIVATE, mp->fd, start);
+      }
+      if (addr == MAP_FAILED) {
+         print_debug("can't mmap map_info at 0x%lx, using pread\n", mp->vaddr);
+         mp->mmap_failed = true;
+      } else {
+         mp->mmap_addr = addr;
+         mp->mmap_len  = len;
+         mp->contents  = (const char*)addr + (mp->offset - start);
+      }
+   }
+   return mp->contents;
+}
+
 static bool core_read_data(struct ps_prochandle* ph, uintptr_t addr, char *buf, size_t size) {
    ssize_t resid = size;
    int page_size=sysconf(_SC_PAGE_SIZE);
    while (resid != 0) {
       map_info *mp = core_lookup(ph, addr);
+      const char* contents;
       uintptr_t mapoff;
       ssize_t len, rem;
       off_t off;
@@ -446,7 +490,10 @@ static bool core_read_data(struct ps_prochandle* ph, uintptr_t addr, char *buf,
       len = MIN(resid, mp->memsz - mapoff);
       off = mp->offset + mapoff;
 
-      if ((len = pread(fd, buf, len, off)) <= 0) {
+      contents = map_contents(mp, page_size);
+      if (contents != NULL) {
+         memcpy(buf, contents + mapoff, len);
+      } else if ((len = pread(fd, buf, len, off)) <= 0) {
          break;
       }
 
@@ -51,6 +51,10 @@ typedef struct symtab {
   size_t num_symbols;
   struct elf_symbol *symbols;
   struct hsearch_data *hash_table;
+  // named symbols sorted by offset, built on the first nearest_symbol call
+  struct elf_symbol **sorted;
+  size_t num_sorted;
+  uintptr_t max_size;
 } symtab_t;
 
 
@@ -536,6 +540,7 @@ void destroy_symtab(struct symtab* symtab) {
   if (!symtab) return;
   if (symtab->strs) free(symtab->strs);
   if (symtab->symbols) free(symtab->symbols);
+  if (symtab->sorted) free(symtab->sorted);
   if (symtab->hash_table) {
      hdestroy_r(symtab->hash_table);
      free(symtab->hash_table);
@@ -568,10 +573,75 @@ quit:
   return (uintptr_t) NULL;
 }
 
+// callback for sorting symbols by offset, symbols at the same offset
+// keep their symbol table order
+static int sym_cmp_offset(const void *lhsp, const void *rhsp) {
+  const struct elf_symbol *lhs = *((const struct elf_symbol **)lhsp);
+  const struct elf_symbol *rhs = *((const struct elf_symbol **)rhsp);
+
+  if (lhs->offset != rhs->offset) {
+    return (lhs->offset < rhs->offset) ? -1 : 1;
+  }
+  return (lhs < rhs) ? -1 : (lhs > rhs) ? 1 : 0;
+}
+
+static bool sort_symbols(struct symtab* symtab) {
+  size_t n, count = 0;
+
+  symtab->sorted = (struct elf_symbol **)malloc(symtab->num_symbols * sizeof(struct elf_symbol *));
+  if (symtab->sorted == NULL) {
+    return false;
+  }
+  for (n = 0; n < symtab->num_symbols; n++) {
+    struct elf_symbol* sym = &(symtab->symbols[n]);
+    if (sym->name != NULL && sym->size > 0) {
+      symtab->sorted[count++] = sym;
+      if (sym->size > symtab->max_size) {
+        symtab->max_size = sym->size;
+      }
+    }
+  }
+  qsort(symtab->sorted, count, sizeof(struct elf_symbol *), sym_cmp_offset);
+  symtab->num_sorted = count;
+  return true;
+}
+
 const char* nearest_symbol(struct symtab* symtab, uintptr_t offset,
                            uintptr_t* poffset) {
   int n = 0;
   if (!symtab) return NULL;
+
+  // binary search for the last symbol starting at or below offset, then
+  // look back over the symbols that are close enough to still cover it.
+  // Like the linear scan, return the covering symbol that comes first in
+  // the symbol table.
+  if (symtab->num_symbols > 0 &&
+      (symtab->sorted != NULL || sort_symbols(symtab))) {
+    struct elf_symbol* found = NULL;
+    size_t lo = 0, hi = symtab->num_sorted;
+    while (lo < hi) {
+      size_t mid = lo + (hi - lo) / 2;
+      if (symtab->sorted[mid]->offset <= offset) {
+        lo = mid + 1;
+      } else {
+        hi = mid;
+      }
+    }
+    while (lo > 0) {
+      struct elf_symbol* sym = symtab->sorted[--lo];
+      if (offset - sym->offset >= symtab->max_size) {
+        break;
+      }
+      if (offset < sym->offset + sym->size &&
+          (found == NULL || sym < found)) {
+        found = sym;
+      }
+    }
+    if (found == NULL) return NULL;
+    if (poffset) *poffset = (offset - found->offset);
+    return found->name;
+  }
+
   for (; n < symtab->num_symbols; n++) {
      struct elf_symbol* sym = &(symtab->symbols[n]);
      if (sym->name != NULL &&
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 1998, 2016, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 1998, 2020, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -27,6 +27,7 @@
 #include "ReferenceTypeImpl.h"
 #include "inStream.h"
 #include "outStream.h"
+#include "classTrack.h"
 
 
 static jboolean
@@ -35,13 +36,16 @@ signature(PacketInputStream *in, PacketOutputStream *out)
     char *signature = NULL;
     jclass clazz;
     jvmtiError error;
+    JNIEnv *env;
 
-    clazz = inStream_readClassRef(getEnv(), in);
+    env = getEnv();
+
+    clazz = inStream_readClassRef(env, in);
     if (inStream_error(in)) {
         return JNI_TRUE;
     }
 
-    error = classSignature(clazz, &signature, NULL);
+    error = classTrack_classInfo(env, clazz, NULL, &signature, NULL);
     if (error != JVMTI_ERROR_NONE) {
         outStream_setError(out, map2jdwpError(error));
         return JNI_TRUE;
@@ -61,12 +65,15 @@ signatureWithGeneric(PacketInputStream *in, PacketOutputStream *out)
     char *genericSignature = NULL;
     jclass clazz;
     jvmtiError error;
+    JNIEnv *env;
 
-    clazz = inStream_readClassRef(getEnv(), in);
+    env = getEnv();
+
+    clazz = inStream_readClassRef(env, in);
     if (inStream_error(in)) {
         return JNI_TRUE;
     }
-    error = classSignature(clazz, &signature, &genericSignature);
+    error = classTrack_classInfo(env, clazz, NULL, &signature, &genericSignature);
     if (error != JVMTI_ERROR_NONE) {
         outStream_setError(out, map2jdwpError(error));
         return JNI_TRUE;
@@ -152,82 +159,25 @@ modifiers(PacketInputStream *in, PacketOutputStream *out)
     return JNI_TRUE;
 }
 
-static void
-writeMethodInfo(PacketOutputStream *out, jclass clazz, jmethodID method,
-                int outputGenerics)
-{
-    char *name = NULL;
-    char *signature = NULL;
-    char *genericSignature = NULL;
-    jint modifiers;
-    jvmtiError error;
-    jboolean isSynthetic;
-
-    error = isMethodSynthetic(method, &isSynthetic);
-    if (error != JVMTI_ERROR_NONE) {
-        outStream_setError(out, map2jdwpError(error));
-        return;
-    }
-
-    error = methodModifiers(method, &modifiers);
-    if (error != JVMTI_ERROR_NONE) {
-        outStream_setError(out, map2jdwpError(error));
-        return;
-    }
-
-    error = methodSignature(method, &name, &signature, &genericSignature);
-    if (error != JVMTI_ERROR_NONE) {
-        outStream_setError(out, map2jdwpError(error));
-        return;
-    }
-
-    if (isSynthetic) {
-        modifiers |= MOD_SYNTHETIC;
-    }
-    (void)outStream_writeMethodID(out, method);
-    (void)outStream_writeString(out, name);
-    (void)outStream_writeString(out, signature);
-    if (outputGenerics == 1) {
-        writeGenericSignature(out, genericSignature);
-    }
-    (void)outStream_writeInt(out, modifiers);
-    jvmtiDeallocate(name);
-    jvmtiDeallocate(signature);
-    if (genericSignature != NULL) {
-      jvmtiDeallocate(genericSignature);
-    }
-}
-
 static jboolean
 methods1(PacketInputStream *in, PacketOutputStream *out,
          int outputGenerics)
 {
-    int i;
     jclass clazz;
-    jint methodCount = 0;
-    jmethodID *methods = NULL;
     jvmtiError error;
+    JNIEnv *env;
 
-    clazz = inStream_readClassRef(getEnv(), in);
+    env = getEnv();
+
+    clazz = inStream_readClassRef(env, in);
     if (inStream_error(in)) {
         return JNI_TRUE;
     }
 
-    error = JVMTI_FUNC_PTR(gdata->jvmti,GetClassMethods)
-                (gdata->jvmti, clazz, &methodCount, &methods);
+    /* The method table is cached per class by classTrack */
+    error = classTrack_writeMethods(env, out, clazz, outputGenerics);
     if (error != JVMTI_ERROR_NONE) {
         outStream_setError(out, map2jdwpError(error));
-        return JNI_TRUE;
-    }
-
-    (void)outStream_writeInt(out, methodCount);
-    for (i = 0; (i < methodCount) && !outStream_error(out); i++) {
-        writeMethodInfo(out, clazz, methods[i], outputGenerics);
-    }
-
-    /* Free methods array */
-    if ( methods != NULL ) {
-        jvmtiDeallocate(methods);
     }
     return JNI_TRUE;
 }
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 1998, 2018, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 1998, 2020, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -33,6 +33,7 @@
 #include "threadControl.h"
 #include "SDE.h"
 #include "FrameID.h"
+#include "classTrack.h"
 
 static char *versionName = "Java Debug Wire Protocol (Reference Implementation)";
 static int majorVersion = 11;  /* JDWP major version */
@@ -246,11 +247,17 @@ allClasses1(PacketInputStream *in, PacketOutputStream *out, int outputGenerics)
 
         jint classCount;
         jclass *theClasses;
+        /* Status of the prepared classes, by index in theClasses */
+        jint *statuses = NULL;
         jvmtiError error;
 
         error = allLoadedClasses(&theClasses, &classCount);
         if ( error != JVMTI_ERROR_NONE ) {
             outStream_setError(out, map2jdwpError(error));
+        } else if ( classCount > 0 &&
+                    (statuses = jvmtiAllocate(classCount * (int)sizeof(jint))) == NULL ) {
+            jvmtiDeallocate(theClasses);
+            outStream_setError(out, JDWP_ERROR(OUT_OF_MEMORY));
         } else {
             /* Count classes in theClasses which are prepared */
             int prepCount = 0;
@@ -270,6 +277,7 @@ allClasses1(PacketInputStream *in, PacketOutputStream *out, int outputGenerics)
                      * are prepared) to the beginning of the array.
                      */
                     theClasses[i] = theClasses[prepCount];
+                    statuses[prepCount] = status;
                     theClasses[prepCount++] = clazz;
                 }
             }
@@ -283,11 +291,13 @@ allClasses1(PacketInputStream *in, PacketOutputStream *out, int outputGenerics)
                 char *signature = NULL;
                 char *genericSignature = NULL;
                 jclass clazz = theClasses[writtenCount];
-                jint status = classStatus(clazz);
-                jbyte tag = referenceTypeTag(clazz);
+                jint status = statuses[writtenCount];
+                jbyte tag;
                 jvmtiError error;
 
-                error = classSignature(clazz, &signature, &genericSignature);
+                /* Signatures and tags of tracked classes are cached */
+                error = classTrack_classInfo(env, clazz, &tag, &signature,
+                                             outputGenerics == 1 ? &genericSignature : NULL);
                 if (error != JVMTI_ERROR_NONE) {
                     outStream_setError(out, map2jdwpError(error));
                     break;
@@ -311,6 +321,9 @@ allClasses1(PacketInputStream *in, PacketOutputStream *out, int outputGenerics)
                     break;
                 }
             }
+            if (statuses != NULL) {
+                jvmtiDeallocate(statuses);
+            }
             jvmtiDeallocate(theClasses);
         }
 
@@ -480,9 +493,10 @@ redefineClasses(PacketInputStream *in, PacketOutputStream *out)
         if (error != JVMTI_ERROR_NONE) {
             outStream_setError(out, map2jdwpError(error));
         } else {
-            /* zap our BP info */
+            /* zap our BP info and the cached class metadata */
             for ( i = 0 ; i < classCount; i++ ) {
                 eventHandler_freeClassBreakpoints(classDefs[i].klass);
+                classTrack_redefinedClass(env, classDefs[i].klass);
             }
         }
     }
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2001, 2005, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2001, 2020, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -39,18 +39,43 @@
  * set by transferring all classes in the current set into
  * a new table, any that remain in the old table have been
  * unloaded.
+ *
+ * Since the table knows about every prepared class anyway, it
+ * also caches the class metadata the front end asks for over
+ * and over (signatures, type tags and the method tables), so
+ * that commands like AllClasses and Methods do not need a
+ * handful of JVMTI calls for every class and method.  Cached
+ * method tables are dropped when a class is redefined and
+ * everything is dropped when a class is unloaded.
+ *
+ * The table is used by the event handler and by the command
+ * threads, so it is protected by classTrackLock.
  */
 
 #include "util.h"
 #include "bag.h"
+#include "outStream.h"
 #include "classTrack.h"
 
 /* ClassTrack hash table slot count */
-#define CT_HASH_SLOT_COUNT 263    /* Prime which eauals 4k+3 for some k */
+#define CT_HASH_SLOT_COUNT 4099   /* Prime which eauals 4k+3 for some k */
+
+typedef struct MethodInfo {
+    jmethodID method;
+    char *name;
+    char *signature;
+    char *genericSignature;  /* NULL if none */
+    jint modifiers;          /* includes MOD_SYNTHETIC */
+} MethodInfo;
 
 typedef struct KlassNode {
     jclass klass;            /* weak global reference */
+    jint hashCode;           /* identity hash code of klass */
     char *signature;         /* class signature */
+    char *genericSignature;  /* generic class signature, NULL if none */
+    jbyte tag;               /* JDWP type tag, 0 until computed */
+    jint methodCount;        /* -1 until the methods are cached */
+    MethodInfo *methods;     /* cached method table */
     struct KlassNode *next;  /* next node in this slot */
 } KlassNode;
 
@@ -60,23 +85,63 @@ typedef struct KlassNode {
  */
 static KlassNode **table;
 
+static jrawMonitorID classTrackLock;
+
 /*
- * Return slot in hash table to use for this class.
+ * Return slot in hash table to use for this hash code.
  */
 static jint
-hashKlass(jclass klass)
+hashSlot(jint hashCode)
 {
-    jint hashCode = objectHashCode(klass);
     return abs(hashCode) % CT_HASH_SLOT_COUNT;
 }
 
+/*
+ * Find the node of klass, or NULL if klass is not in the table.
+ * Must be called with classTrackLock held.
+ */
+static KlassNode *
+findNode(JNIEnv *env, jclass klass, jint hashCode)
+{
+    KlassNode *node;
+
+    if (table == NULL) {
+        return NULL;
+    }
+    for (node = table[hashSlot(hashCode)]; node != NULL; node = node->next) {
+        if (node->hashCode == hashCode && isSameObject(env, klass, node->klass)) {
+            return node;
+        }
+    }
+    return NULL;
+}
+
+static void
+freeMethods(MethodInfo *methods, jint methodCount)
+{
+    jint i;
+
+    if (methods == NULL) {
+        return;
+    }
+    for (i = 0; i < methodCount; i++) {
+        jvmtiDeallocate(methods[i].name);
+        jvmtiDeallocate(methods[i].signature);
+        if (methods[i].genericSignature != NULL) {
+            jvmtiDeallocate(methods[i].genericSignature);
+        }
+    }
+    jvmtiDeallocate(methods);
+}
+
 /*
  * Transfer a node (which represents klass) from the current
  * table to the new table.
  */
 static void
 transferClass(JNIEnv *env, jclass klass, KlassNode **newTable) {
-    jint slot = hashKlass(klass);
+    jint hashCode = objectHashCode(klass);
+    jint slot = hashSlot(hashCode);
     KlassNode **head = &table[slot];
     KlassNode **newHead = &newTable[slot];
     KlassNode **nodePtr;
@@ -84,7 +149,7 @@ transferClass(JNIEnv *env, jclass klass, KlassNode **newTable) {
 
     /* Search the node list of the current table for klass */
     for (nodePtr = head; node = *nodePtr, node != NULL; nodePtr = &(node->next)) {
-        if (isSameObject(env, klass, node->klass)) {
+        if (node->hashCode == hashCode && isSameObject(env, klass, node->klass)) {
             /* Match found transfer node */
 
             /* unlink from old list */
@@ -111,7 +176,7 @@ transferClass(JNIEnv *env, jclass klass, KlassNode **newTable) {
 }
 
 /*
- * Delete a hash table of classes.
+ * Delete a hash table of classes and the metadata cached for them.
  * The signatures of classes in the table are returned.
  */
 static struct bag *
@@ -138,8 +203,12 @@ deleteTable(JNIEnv *env, KlassNode *oldTable[])
             }
             *sigSpot = node->signature;
 
-            /* Free weak ref and the node itself */
+            /* Free weak ref, cached metadata and the node itself */
             JNI_FUNC_PTR(env,DeleteWeakGlobalRef)(env, node->klass);
+            if (node->genericSignature != NULL) {
+                jvmtiDeallocate(node->genericSignature);
+            }
+            freeMethods(node->methods, node->methodCount);
             next = node->next;
             jvmtiDeallocate(node);
 
@@ -171,6 +240,8 @@ classTrack_processUnloads(JNIEnv *env)
 
         (void)memset(newTable, 0, CT_HASH_SLOT_COUNT * sizeof(KlassNode *));
 
+        debugMonitorEnter(classTrackLock);
+
         WITH_LOCAL_REFS(env, 1) {
 
             jint classCount;
@@ -198,6 +269,7 @@ classTrack_processUnloads(JNIEnv *env)
 
         } END_WITH_LOCAL_REFS(env)
 
+        debugMonitorExit(classTrackLock);
     }
 
     return unloadedSignatures;
@@ -210,39 +282,275 @@ classTrack_processUnloads(JNIEnv *env)
 void
 classTrack_addPreparedClass(JNIEnv *env, jclass klass)
 {
-    jint slot = hashKlass(klass);
-    KlassNode **head = &table[slot];
+    jint hashCode = objectHashCode(klass);
+    KlassNode **head;
     KlassNode *node;
     jvmtiError error;
 
-    if (gdata->assertOn) {
-        /* Check this is not a duplicate */
-        for (node = *head; node != NULL; node = node->next) {
-            if (isSameObject(env, klass, node->klass)) {
-                JDI_ASSERT_FAILED("Attempting to insert duplicate class");
-                break;
-            }
-        }
-    }
-
     node = jvmtiAllocate(sizeof(KlassNode));
     if (node == NULL) {
         EXIT_ERROR(AGENT_ERROR_OUT_OF_MEMORY,"KlassNode");
     }
-    error = classSignature(klass, &(node->signature), NULL);
+    (void)memset(node, 0, sizeof(KlassNode));
+    node->hashCode = hashCode;
+    node->methodCount = -1;
+    error = classSignature(klass, &(node->signature), &(node->genericSignature));
     if (error != JVMTI_ERROR_NONE) {
         jvmtiDeallocate(node);
         EXIT_ERROR(error,"signature");
     }
     if ((node->klass = JNI_FUNC_PTR(env,NewWeakGlobalRef)(env, klass)) == NULL) {
         jvmtiDeallocate(node->signature);
+        if (node->genericSignature != NULL) {
+            jvmtiDeallocate(node->genericSignature);
+        }
         jvmtiDeallocate(node);
         EXIT_ERROR(AGENT_ERROR_NULL_POINTER,"NewWeakGlobalRef");
     }
 
+    debugMonitorEnter(classTrackLock);
+
+    if (gdata->assertOn) {
+        /* Check this is not a duplicate */
+        if (findNode(env, klass, hashCode) != NULL) {
+            JDI_ASSERT_FAILED("Attempting to insert duplicate class");
+        }
+    }
+
     /* Insert the new node */
+    head = &table[hashSlot(hashCode)];
     node->next = *head;
     *head = node;
+
+    debugMonitorExit(classTrackLock);
+}
+
+static char *
+copyString(const char *string)
+{
+    char *copy;
+
+    if (string == NULL) {
+        return NULL;
+    }
+    copy = jvmtiAllocate((int)strlen(string)+1);
+    if (copy != NULL) {
+        (void)strcpy(copy, string);
+    }
+    return copy;
+}
+
+/*
+ * Get the type tag, signature and generic signature of a class,
+ * from the cache if the class is tracked.  The signatures are
+ * returned like classSignature() does and must be deallocated by
+ * the caller.  ptag and pgeneric_signature may be NULL.
+ */
+jvmtiError
+classTrack_classInfo(JNIEnv *env, jclass klass, jbyte *ptag,
+                     char **psignature, char **pgeneric_signature)
+{
+    jint hashCode = objectHashCode(klass);
+    KlassNode *node;
+    jboolean found = JNI_FALSE;
+    jvmtiError error = JVMTI_ERROR_NONE;
+
+    *psignature = NULL;
+    if (pgeneric_signature != NULL) {
+        *pgeneric_signature = NULL;
+    }
+
+    debugMonitorEnter(classTrackLock);
+    node = findNode(env, klass, hashCode);
+    if (node != NULL) {
+        found = JNI_TRUE;
+        if (ptag != NULL) {
+            if (node->tag == 0) {
+                node->tag = referenceTypeTag(klass);
+            }
+            *ptag = node->tag;
+        }
+        *psignature = copyString(node->signature);
+        if (*psignature == NULL) {
+            error = AGENT_ERROR_OUT_OF_MEMORY;
+        } else if (pgeneric_signature != NULL && node->genericSignature != NULL) {
+            *pgeneric_signature = copyString(node->genericSignature);
+            if (*pgeneric_signature == NULL) {
+                jvmtiDeallocate(*psignature);
+                *psignature = NULL;
+                error = AGENT_ERROR_OUT_OF_MEMORY;
+            }
+        }
+    }
+    debugMonitorExit(classTrackLock);
+
+    if (!found) {
+        if (ptag != NULL) {
+            *ptag = referenceTypeTag(klass);
+        }
+        error = classSignature(klass, psignature, pgeneric_signature);
+    }
+    return error;
+}
+
+/*
+ * Fetch the method table of a class from the VM.
+ */
+static jvmtiError
+loadMethods(jclass klass, MethodInfo **pmethods, jint *pcount)
+{
+    jmethodID *methodIDs = NULL;
+    MethodInfo *methods;
+    jint methodCount = 0;
+    jvmtiError error;
+    jint i;
+
+    *pmethods = NULL;
+    *pcount = 0;
+
+    error = JVMTI_FUNC_PTR(gdata->jvmti,GetClassMethods)
+                (gdata->jvmti, klass, &methodCount, &methodIDs);
+    if (error != JVMTI_ERROR_NONE) {
+        return error;
+    }
+
+    methods = jvmtiAllocate(methodCount * (int)sizeof(MethodInfo));
+    if (methods == NULL && methodCount > 0) {
+        jvmtiDeallocate(methodIDs);
+        return AGENT_ERROR_OUT_OF_MEMORY;
+    }
+
+    for (i = 0; i < methodCount; i++) {
+        MethodInfo *info = &methods[i];
+        jboolean isSynthetic;
+
+        info->method = methodIDs[i];
+        error = isMethodSynthetic(info->method, &isSynthetic);
+        if (error == JVMTI_ERROR_NONE) {
+            error = methodModifiers(info->method, &info->modifiers);
+        }
+        if (error == JVMTI_ERROR_NONE) {
+            error = methodSignature(info->method, &info->name,
+                                    &info->signature, &info->genericSignature);
+        }
+        if (error != JVMTI_ERROR_NONE) {
+            freeMethods(methods, i);
+            jvmtiDeallocate(methodIDs);
+            return error;
+        }
+        if (isSynthetic) {
+            info->modifiers |= MOD_SYNTHETIC;
+        }
+    }
+
+    if (methodIDs != NULL) {
+        jvmtiDeallocate(methodIDs);
+    }
+    *pmethods = methods;
+    *pcount = methodCount;
+    return JVMTI_ERROR_NONE;
+}
+
+static void
+writeMethods(PacketOutputStream *out, MethodInfo *methods, jint methodCount,
+             int outputGenerics)
+{
+    jint i;
+
+    (void)outStream_writeInt(out, methodCount);
+    for (i = 0; (i < methodCount) && !outStream_error(out); i++) {
+        MethodInfo *info = &methods[i];
+
+        (void)outStream_writeMethodID(out, info->method);
+        (void)outStream_writeString(out, info->name);
+        (void)outStream_writeString(out, info->signature);
+        if (outputGenerics == 1) {
+            writeGenericSignature(out, info->genericSignature);
+        }
+        (void)outStream_writeInt(out, info->modifiers);
+    }
+}
+
+/*
+ * Write the reply of the ReferenceType.Methods and MethodsWithGeneric
+ * commands for klass.  The method table is cached if klass is tracked.
+ */
+jvmtiError
+classTrack_writeMethods(JNIEnv *env, PacketOutputStream *out, jclass klass,
+                        int outputGenerics)
+{
+    jint hashCode = objectHashCode(klass);
+    KlassNode *node;
+    MethodInfo *methods;
+    jint methodCount;
+    jboolean cached = JNI_FALSE;
+    jvmtiError error;
+
+    debugMonitorEnter(classTrackLock);
+    node = findNode(env, klass, hashCode);
+    if (node != NULL && node->methodCount >= 0) {
+        writeMethods(out, node->methods, node->methodCount, outputGenerics);
+        cached = JNI_TRUE;
+    }
+    debugMonitorExit(classTrackLock);
+
+    if (cached) {
+        return JVMTI_ERROR_NONE;
+    }
+
+    /* Not cached yet, the JVMTI calls are made without holding the lock */
+    error = loadMethods(klass, &methods, &methodCount);
+    if (error != JVMTI_ERROR_NONE) {
+        return error;
+    }
+
+    debugMonitorEnter(classTrackLock);
+    node = findNode(env, klass, hashCode);
+    if (node != NULL && node->methodCount < 0) {
+        node->methods = methods;
+        node->methodCount = methodCount;
+        cached = JNI_TRUE;
+    }
+    writeMethods(out, methods, methodCount, outputGenerics);
+    debugMonitorExit(classTrackLock);
+
+    if (!cached) {
+        freeMethods(methods, methodCount);
+    }
+    return JVMTI_ERROR_NONE;
+}
+
+/*
+ * Called after klass has been redefined, drops the metadata
+ * which might have changed.
+ */
+void
+classTrack_redefinedClass(JNIEnv *env, jclass klass)
+{
+    jint hashCode = objectHashCode(klass);
+    char *genericSignature = NULL;
+    KlassNode *node;
+
+    if (classSignature(klass, NULL, &genericSignature) != JVMTI_ERROR_NONE) {
+        genericSignature = NULL;
+    }
+
+    debugMonitorEnter(classTrackLock);
+    node = findNode(env, klass, hashCode);
+    if (node != NULL) {
+        char *oldGenericSignature = node->genericSignature;
+
+        node->genericSignature = genericSignature;
+        genericSignature = oldGenericSignature;
+        freeMethods(node->methods, node->methodCount);
+        node->methods = NULL;
+        node->methodCount = -1;
+    }
+    debugMonitorExit(classTrackLock);
+
+    if (genericSignature != NULL) {
+        jvmtiDeallocate(genericSignature);
+    }
 }
 
 /*
@@ -251,6 +559,8 @@ classTrack_addPreparedClass(JNIEnv *env, jclass klass)
 void
 classTrack_initialize(JNIEnv *env)
 {
+    classTrackLock = debugMonitorCreate("JDWP Class Track Lock");
+
     WITH_LOCAL_REFS(env, 1) {
 
         jint classCount;
@@ -39,6 +39,30 @@ classTrack_processUnloads(JNIEnv *env);
 void
 classTrack_addPreparedClass(JNIEnv *env, jclass klass);
 
+/*
+ * Get the type tag, signature and generic signature of a class.
+ * Answered from the class table if the class is tracked.
+ */
+jvmtiError
+classTrack_classInfo(JNIEnv *env, jclass klass, jbyte *ptag,
+                     char **psignature, char **pgeneric_signature);
+
+/*
+ * Write the method table of a class to out, caching it in the
+ * class table if the class is tracked.
+ */
+struct PacketOutputStream;
+
+jvmtiError
+classTrack_writeMethods(JNIEnv *env, struct PacketOutputStream *out, jclass klass,
+                        int outputGenerics);
+
+/*
+ * Drop the cached metadata of a redefined class.
+ */
+void
+classTrack_redefinedClass(JNIEnv *env, jclass klass);
+
 /*
  * Initialize class tracking.
  */
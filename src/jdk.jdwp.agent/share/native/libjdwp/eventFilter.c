@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2001, 2013, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2001, 2020, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -122,6 +122,11 @@ typedef struct Filter_ {
 
 typedef struct EventFilters_ {
     jint filterCount;
+    /* Index of a LocationOnly filter whose method and location can be
+     * checked before all other filters, -1 if none.  Set when the node
+     * is installed.
+     */
+    jint quickLocation;
     Filter filters[MAX_FILTERS];
 } EventFilters;
 
@@ -162,6 +167,7 @@ eventFilterRestricted_alloc(jint filterCount)
         (void)memset(node, 0, size);
 
         FILTER_COUNT(node) = filterCount;
+        EVENT_FILTERS(node)->quickLocation = -1;
 
         /* Initialize all modifiers
          */
@@ -369,10 +375,15 @@ eventInstance(EventInfo *evinfo)
  *
  * If shouldDelete is returned true, a count filter has expired
  * and the corresponding node should be deleted.
+ *
+ * The class name of the event is only needed by the class pattern
+ * filters, so it is fetched on first use and returned in *pclassname,
+ * which the caller must free.  Events in debug threads have to be
+ * suppressed by the caller.
  */
 jboolean
 eventFilterRestricted_passesFilter(JNIEnv *env,
-                                   char *classname,
+                                   char **pclassname,
                                    EventInfo *evinfo,
                                    HandlerNode *node,
                                    jboolean *shouldDelete)
@@ -389,13 +400,17 @@ eventFilterRestricted_passesFilter(JNIEnv *env,
     method = evinfo->method;
 
     /*
-     * Suppress most events if they happen in debug threads
+     * Most breakpoint handlers are for other locations, reject those
+     * without going through the filters.
      */
-    if ((evinfo->ei != EI_CLASS_PREPARE) &&
-        (evinfo->ei != EI_GC_FINISH) &&
-        (evinfo->ei != EI_CLASS_LOAD) &&
-        threadControl_isDebugThread(thread)) {
-        return JNI_FALSE;
+    if (EVENT_FILTERS(node)->quickLocation >= 0) {
+        LocationFilter *location =
+            &FILTER(node, EVENT_FILTERS(node)->quickLocation).u.LocationOnly;
+
+        if (evinfo->method != location->method ||
+            evinfo->location != location->location) {
+            return JNI_FALSE;
+        }
     }
 
     for (i = 0; i < FILTER_COUNT(node); ++i, ++filter) {
@@ -492,7 +507,10 @@ eventFilterRestricted_passesFilter(JNIEnv *env,
                 break;
 
         case JDWP_REQUEST_MODIFIER(ClassMatch): {
-            if (!patternStringMatch(classname,
+            if (*pclassname == NULL) {
+                *pclassname = getClassname(clazz);
+            }
+            if (!patternStringMatch(*pclassname,
                        filter->u.ClassMatch.classPattern)) {
                 return JNI_FALSE;
             }
@@ -500,7 +518,10 @@ eventFilterRestricted_passesFilter(JNIEnv *env,
         }
 
         case JDWP_REQUEST_MODIFIER(ClassExclude): {
-            if (patternStringMatch(classname,
+            if (*pclassname == NULL) {
+                *pclassname = getClassname(clazz);
+            }
+            if (patternStringMatch(*pclassname,
                       filter->u.ClassExclude.classPattern)) {
                 return JNI_FALSE;
             }
@@ -1341,6 +1362,24 @@ disableEvents(HandlerNode *node)
 jvmtiError
 eventFilterRestricted_install(HandlerNode *node)
 {
+    Filter *filter = FILTERS_ARRAY(node);
+    int i;
+
+    /*
+     * A LocationOnly filter can be checked up front as long as no
+     * filter with side effects (Count, Step) comes before it.
+     */
+    for (i = 0; i < FILTER_COUNT(node); ++i, ++filter) {
+        if (filter->modifier == JDWP_REQUEST_MODIFIER(LocationOnly)) {
+            EVENT_FILTERS(node)->quickLocation = i;
+            break;
+        }
+        if (filter->modifier == JDWP_REQUEST_MODIFIER(Count) ||
+            filter->modifier == JDWP_REQUEST_MODIFIER(Step)) {
+            break;
+        }
+    }
+
     return enableEvents(node);
 }
 
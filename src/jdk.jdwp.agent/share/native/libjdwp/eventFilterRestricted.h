@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2001, 2005, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2001, 2020, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -38,7 +38,7 @@ jvmtiError eventFilterRestricted_install(HandlerNode *node);
 jvmtiError eventFilterRestricted_deinstall(HandlerNode *node);
 
 jboolean eventFilterRestricted_passesFilter(JNIEnv *env,
-                                            char *classname,
+                                            char **pclassname,
                                             EventInfo *evinfo,
                                             HandlerNode *node,
                                             jboolean *shouldDelete);
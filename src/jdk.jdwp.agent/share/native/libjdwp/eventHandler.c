@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 1998, 2017, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 1998, 2020, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -71,6 +71,13 @@
 static HandlerID requestIdCounter;
 static jbyte currentSessionID;
 
+/* Events which had handlers, by whether the filters let them through
+ * to at least one handler.  Protected by handlerLock, logged with
+ * LOG_MISC and cleared when a debugger session ends.
+ */
+static jlong filteredEventCount[EI_max+1];
+static jlong deliveredEventCount[EI_max+1];
+
 /* Counter of active callbacks and flag for vm_death */
 static int      active_callbacks   = 0;
 static jboolean vm_death_callback_active = JNI_FALSE;
@@ -636,6 +643,8 @@ event_callback(JNIEnv *env, EventInfo *evinfo)
     {
         HandlerNode *node;
         char        *classname;
+        jboolean     hasHandlers;
+        jboolean     delivered;
 
         /* We must keep track of all classes prepared to know what's unloaded */
         if (evinfo->ei == EI_CLASS_PREPARE) {
@@ -643,14 +652,30 @@ event_callback(JNIEnv *env, EventInfo *evinfo)
         }
 
         node = getHandlerChain(evinfo->ei)->first;
-        classname = getClassname(evinfo->clazz);
+        /* Only fetched if a class pattern filter needs it */
+        classname = NULL;
+        hasHandlers = (node != NULL);
+        delivered = JNI_FALSE;
+
+        /*
+         * Suppress most events if they happen in debug threads.  This
+         * does not depend on the handler, so it is checked once here
+         * rather than by the filters of every handler.
+         */
+        if (node != NULL &&
+            (evinfo->ei != EI_CLASS_PREPARE) &&
+            (evinfo->ei != EI_GC_FINISH) &&
+            (evinfo->ei != EI_CLASS_LOAD) &&
+            threadControl_isDebugThread(thread)) {
+            node = NULL;
+        }
 
         while (node != NULL) {
             /* save next so handlers can remove themselves */
             HandlerNode *next = NEXT(node);
             jboolean shouldDelete;
 
-            if (eventFilterRestricted_passesFilter(env, classname,
+            if (eventFilterRestricted_passesFilter(env, &classname,
                                                    evinfo, node,
                                                    &shouldDelete)) {
                 HandlerFunction func;
@@ -660,6 +685,7 @@ event_callback(JNIEnv *env, EventInfo *evinfo)
                     EXIT_ERROR(AGENT_ERROR_INTERNAL,"handler function NULL");
                 }
                 (*func)(env, evinfo, node, eventBag);
+                delivered = JNI_TRUE;
             }
             if (shouldDelete) {
                 /* We can safely free the node now that we are done
@@ -670,6 +696,14 @@ event_callback(JNIEnv *env, EventInfo *evinfo)
             node = next;
         }
         jvmtiDeallocate(classname);
+
+        if (hasHandlers) {
+            if (delivered) {
+                deliveredEventCount[evinfo->ei]++;
+            } else {
+                filteredEventCount[evinfo->ei]++;
+            }
+        }
     }
     debugMonitorExit(handlerLock);
 
@@ -1562,6 +1596,18 @@ eventHandler_reset(jbyte sessionID)
         (void)freeHandlerChain(getHandlerChain(i));
     }
 
+    /* report how much of the event traffic the filters removed */
+    for (i = EI_min; i <= EI_max; i++) {
+        if (filteredEventCount[i] != 0 || deliveredEventCount[i] != 0) {
+            LOG_MISC(("Events of kind %d: %lld filtered, %lld delivered",
+                      (int)eventIndex2jdwp(i),
+                      (long long)filteredEventCount[i],
+                      (long long)deliveredEventCount[i]));
+        }
+        filteredEventCount[i] = 0;
+        deliveredEventCount[i] = 0;
+    }
+
     requestIdCounter = 1;
     currentSessionID = sessionID;
 
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 1998, 2005, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 1998, 2020, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -427,6 +427,29 @@ handleExceptionCatchEvent(JNIEnv *env, EventInfo *evinfo,
     stepControl_unlock();
 }
 
+static jint
+skippedMethodSlot(jmethodID method)
+{
+    return (jint)(((size_t)(void *)method >> 3) % STEP_SKIP_CACHE_SIZE);
+}
+
+/*
+ * Returns true if the step was already found not to stop in method,
+ * which spares the class name lookup and filter matching on every
+ * entry of a hot method.
+ */
+static jboolean
+isSkippedMethod(StepRequest *step, jmethodID method)
+{
+    return step->skippedMethods[skippedMethodSlot(method)] == method;
+}
+
+static void
+rememberSkippedMethod(StepRequest *step, jmethodID method)
+{
+    step->skippedMethods[skippedMethodSlot(method)] = method;
+}
+
 static void
 handleMethodEnterEvent(JNIEnv *env, EventInfo *evinfo,
                        HandlerNode *node,
@@ -444,7 +467,7 @@ handleMethodEnterEvent(JNIEnv *env, EventInfo *evinfo,
         EXIT_ERROR(AGENT_ERROR_INVALID_THREAD, "getting step request");
     }
 
-    if (step->pending) {
+    if (step->pending && !isSkippedMethod(step, evinfo->method)) {
         jclass    clazz;
         jmethodID method;
         char     *classname;
@@ -474,6 +497,8 @@ handleMethodEnterEvent(JNIEnv *env, EventInfo *evinfo,
                 (void)eventHandler_free(step->methodEnterHandlerNode);
                 step->methodEnterHandlerNode = NULL;
             }
+        } else {
+            rememberSkippedMethod(step, method);
         }
         jvmtiDeallocate(classname);
         classname = NULL;
@@ -575,10 +600,19 @@ stepControl_handleStep(JNIEnv *env, jthread thread,
         LOG_STEP(("stepControl_handleStep: completed, fromDepth>currentDepth(%d>%d)", fromDepth, currentDepth));
     } else if (fromDepth < currentDepth) {
         /* We have dropped into a called method. */
+        jboolean stopHere = JNI_FALSE;
+
         if (   step->depth == JDWP_STEP_DEPTH(INTO)
-            && (!eventFilter_predictFiltering(step->stepHandlerNode, clazz,
+            && !isSkippedMethod(step, method) ) {
+            stopHere =
+                   (!eventFilter_predictFiltering(step->stepHandlerNode, clazz,
                                           (classname = getClassname(clazz))))
-            && hasLineNumbers(method) ) {
+                && hasLineNumbers(method);
+            if (!stopHere) {
+                rememberSkippedMethod(step, method);
+            }
+        }
+        if (stopHere) {
 
             /* Stepped into a method with lines, so we're done */
             completed = JNI_TRUE;
@@ -819,6 +853,7 @@ stepControl_beginStep(JNIEnv *env, jthread thread, jint size, jint depth,
             step->framePopHandlerNode = NULL;
             step->methodEnterHandlerNode = NULL;
             step->stepHandlerNode = node;
+            (void)memset(step->skippedMethods, 0, sizeof(step->skippedMethods));
             error = initState(env, thread, step);
             if (error == JVMTI_ERROR_NONE) {
                 initEvents(thread, step);
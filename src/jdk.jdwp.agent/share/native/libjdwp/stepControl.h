@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 1998, 2005, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 1998, 2020, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -29,6 +29,9 @@
 #include "eventFilter.h"
 #include "eventHandler.h"
 
+/* Size of the per request cache of methods the step does not stop in */
+#define STEP_SKIP_CACHE_SIZE 16
+
 typedef struct {
     /* Parameters */
     jint granularity;
@@ -48,6 +51,12 @@ typedef struct {
     HandlerNode *catchHandlerNode;
     HandlerNode *framePopHandlerNode;
     HandlerNode *methodEnterHandlerNode;
+
+    /* Methods entered by a step into which were found to be filtered
+     * out or without line numbers, so the step does not stop there.
+     * Only depends on the request, cleared when it is (re)started.
+     */
+    jmethodID skippedMethods[STEP_SKIP_CACHE_SIZE];
 } StepRequest;
 
 
@@ -46,9 +46,14 @@
 
 #include "zip.h"
 
+#ifdef JAR_PARALLEL_DEFLATE
+#include <pthread.h>
+#include <unistd.h>
+#endif
+
 #ifdef NO_ZLIB
 
-inline bool jar::deflate_bytes(bytes& head, bytes& tail) {
+bool jar::deflate_bytes(bytes& head, bytes& tail, fillbytes& out) {
   return false;
 }
 inline uint jar::get_crc32(uint c, uchar *ptr, uint len) { return 0; }
@@ -365,6 +370,11 @@ void jar::addJarEntry(const char* fname,
 
   bool deflate = (deflate_hint && len > 0);
 
+#ifdef JAR_PARALLEL_DEFLATE
+  if (queue_entry(fname, deflate, modtime, head, tail))
+    return;
+#endif
+
   if (deflate) {
     if (deflate_bytes(head, tail) == false) {
       PRINTCR((2, "Reverting to store fn=%s\t%d -> %d\n",
@@ -386,8 +396,255 @@ void jar::addJarEntry(const char* fname,
   }
 }
 
+#ifdef JAR_PARALLEL_DEFLATE
+
+// Entries are written in the order they were added, but the deflation of
+// an entry can run on a worker thread while the unpacker goes on with the
+// next ones.  An entry waits in a queue (with a copy of its data) until it
+// and all entries before it are done.
+enum {
+  DEFLATE_ASYNC_MIN   = 4096,      // smaller entries do not start the pool
+  QUEUED_BYTES_MAX    = 32 << 20,  // beyond that, wait for the writer
+  DEFLATER_THREADS_MAX = 8
+};
+
+enum { ENTRY_QUEUED, ENTRY_RUNNING, ENTRY_DONE };
+
+struct jar_entry {
+  jar_entry* next;
+  char*      fname;
+  bool       deflate;
+  bool       deflated_ok;
+  int        modtime;
+  int        state;
+  const char* error;     // set by a worker, reported by write_entry
+  uint       crc;
+  bytes      data;
+  fillbytes  deflated;
+};
+
+struct deflater_pool {
+  pthread_mutex_t lock;
+  pthread_cond_t  work_cv;     // a queued entry or shutdown
+  pthread_cond_t  done_cv;     // an entry is done
+  jar_entry*      head;        // oldest entry, written first
+  jar_entry*      tail;
+  jar_entry*      next_work;   // oldest entry still to be deflated
+  size_t          queued_bytes;
+  bool            shutdown;
+  int             nthreads;
+  pthread_t       threads[DEFLATER_THREADS_MAX];
+  jar*            owner;
+};
+
+static void* deflater_thread(void* arg) {
+  deflater_pool* pool = (deflater_pool*) arg;
+  pthread_mutex_lock(&pool->lock);
+  for (;;) {
+    while (pool->next_work == null && !pool->shutdown)
+      pthread_cond_wait(&pool->work_cv, &pool->lock);
+    jar_entry* e = pool->next_work;
+    if (e == null)
+      break;  // shut down and nothing left
+    e->state = ENTRY_RUNNING;
+    jar_entry* n = e->next;
+    while (n != null && n->state != ENTRY_QUEUED)
+      n = n->next;
+    pool->next_work = n;
+    pthread_mutex_unlock(&pool->lock);
+
+    bytes none;
+    none.set(null, 0);
+    e->crc = jar::get_crc32(jar::get_crc32(0, Z_NULL, 0),
+                            (uchar*) e->data.ptr, (uint) e->data.len);
+    // The output buffer is allocated up front, so that deflate_bytes
+    // does not have to grow it: an allocation failure must not reach
+    // unpack_abort on this thread, it is reported by the owner instead.
+    size_t cap = add_size(e->data.len, e->data.len / 2);
+    byte* out = (cap >= PSIZE_MAX) ? null : (byte*) ::malloc(cap + 1);
+    e->deflated.init();
+    if (out == null) {
+      e->error = ERROR_ENOMEM;
+    } else {
+      e->deflated.b.set(out, 0);
+      e->deflated.allocated = cap;
+      e->deflated_ok = pool->owner->deflate_bytes(e->data, none, e->deflated);
+    }
+
+    pthread_mutex_lock(&pool->lock);
+    e->state = ENTRY_DONE;
+    pthread_cond_broadcast(&pool->done_cv);
+  }
+  pthread_mutex_unlock(&pool->lock);
+  return null;
+}
+
+static deflater_pool* start_deflater_pool(jar* owner) {
+  long ncpu = sysconf(_SC_NPROCESSORS_ONLN);
+  // leave one processor to the unpacker
+  int nthreads = (ncpu > DEFLATER_THREADS_MAX) ? DEFLATER_THREADS_MAX : (int) ncpu - 1;
+  if (nthreads < 1)
+    return null;
+  deflater_pool* pool = (deflater_pool*) calloc(1, sizeof(deflater_pool));
+  if (pool == null)
+    return null;
+  pool->owner = owner;
+  pthread_mutex_init(&pool->lock, null);
+  pthread_cond_init(&pool->work_cv, null);
+  pthread_cond_init(&pool->done_cv, null);
+  for (int i = 0; i < nthreads; i++) {
+    if (pthread_create(&pool->threads[pool->nthreads], null,
+                       deflater_thread, pool) == 0)
+      pool->nthreads++;
+  }
+  if (pool->nthreads == 0) {
+    pthread_cond_destroy(&pool->done_cv);
+    pthread_cond_destroy(&pool->work_cv);
+    pthread_mutex_destroy(&pool->lock);
+    ::free(pool);
+    return null;
+  }
+  return pool;
+}
+
+// Queues the entry unless it can be written right away.
+// Returns false if the caller has to write it.
+bool jar::queue_entry(const char* fname, bool deflate, int modtime,
+                      bytes& head, bytes& tail) {
+  size_t len = head.len + tail.len;
+  if (pool == null) {
+    if (no_pool || !deflate || len < DEFLATE_ASYNC_MIN)
+      return false;
+    pool = start_deflater_pool(this);
+    if (pool == null) {
+      no_pool = true;
+      return false;
+    }
+  }
+  write_queued_entries(false);
+  if (pool->head == null && (!deflate || len < DEFLATE_ASYNC_MIN))
+    return false;  // nothing to wait for
+
+  jar_entry* e = (jar_entry*) calloc(1, sizeof(jar_entry));
+  char* name = strdup(fname);
+  byte* data = (byte*) ::malloc(len + 1);
+  if (e == null || name == null || data == null) {
+    ::free(e);
+    ::free(name);
+    ::free(data);
+    write_queued_entries(true);
+    return false;
+  }
+  memcpy(data, head.ptr, head.len);
+  memcpy(data + head.len, tail.ptr, tail.len);
+  e->fname = name;
+  e->data.set(data, len);
+  e->deflate = deflate;
+  e->modtime = modtime;
+  if (deflate) {
+    e->state = ENTRY_QUEUED;
+  } else {
+    e->crc = get_crc32(get_crc32(0, Z_NULL, 0), (uchar*) data, (uint) len);
+    e->state = ENTRY_DONE;
+  }
+
+  pthread_mutex_lock(&pool->lock);
+  if (pool->tail == null)
+    pool->head = e;
+  else
+    pool->tail->next = e;
+  pool->tail = e;
+  pool->queued_bytes += len;
+  if (deflate) {
+    if (pool->next_work == null)
+      pool->next_work = e;
+    pthread_cond_signal(&pool->work_cv);
+  }
+  pthread_mutex_unlock(&pool->lock);
+
+  write_queued_entries(false);
+  return true;
+}
+
+void jar::write_entry(jar_entry* e) {
+  if (e->error != null) {
+    abort(e->error);
+    return;
+  }
+  int len = (int) e->data.len;
+  bool deflate = e->deflate && e->deflated_ok;
+  if (e->deflate && !e->deflated_ok) {
+    PRINTCR((2, "Reverting to store fn=%s\t%d -> %d\n",
+            e->fname, len, e->deflated.size()));
+  }
+  int clen = (int)((deflate) ? e->deflated.size() : len);
+  add_to_jar_directory(e->fname, !deflate, e->modtime, len, clen, e->crc);
+  write_jar_header(    e->fname, !deflate, e->modtime, len, clen, e->crc);
+
+  if (deflate) {
+    write_data(e->deflated.b);
+    // Write deflated information in extra header
+    write_jar_extra(len, clen, e->crc);
+  } else {
+    write_data(e->data);
+  }
+}
+
+// Writes the entries at the head of the queue which are done.  With all,
+// or while too much data is queued, waits for the entries not yet done.
+void jar::write_queued_entries(bool all) {
+  if (pool == null)
+    return;
+  for (;;) {
+    pthread_mutex_lock(&pool->lock);
+    jar_entry* e = pool->head;
+    while (e != null && e->state != ENTRY_DONE &&
+           (all || pool->queued_bytes > QUEUED_BYTES_MAX)) {
+      pthread_cond_wait(&pool->done_cv, &pool->lock);
+    }
+    if (e == null || e->state != ENTRY_DONE) {
+      pthread_mutex_unlock(&pool->lock);
+      return;
+    }
+    pool->head = e->next;
+    if (pool->head == null)
+      pool->tail = null;
+    pool->queued_bytes -= e->data.len;
+    pthread_mutex_unlock(&pool->lock);
+
+    write_entry(e);
+    e->deflated.free();
+    ::free(e->data.ptr);
+    ::free(e->fname);
+    ::free(e);
+  }
+}
+
+// Writes all queued entries and stops the worker threads.
+void jar::stop_pool() {
+  if (pool == null)
+    return;
+  write_queued_entries(true);
+  pthread_mutex_lock(&pool->lock);
+  pool->shutdown = true;
+  pthread_cond_broadcast(&pool->work_cv);
+  pthread_mutex_unlock(&pool->lock);
+  for (int i = 0; i < pool->nthreads; i++)
+    pthread_join(pool->threads[i], null);
+  pthread_cond_destroy(&pool->done_cv);
+  pthread_cond_destroy(&pool->work_cv);
+  pthread_mutex_destroy(&pool->lock);
+  ::free(pool);
+  pool = null;
+}
+
+#endif // JAR_PARALLEL_DEFLATE
+
 // Add a ZIP entry for a directory name no data
 void jar::addDirectoryToJarFile(const char* dir_name) {
+#ifdef JAR_PARALLEL_DEFLATE
+  write_queued_entries(true);
+#endif
   bool store = true;
   add_to_jar_directory((const char*)dir_name, store, default_modtime, 0, 0, 0);
   write_jar_header(    (const char*)dir_name, store, default_modtime, 0, 0, 0);
@@ -396,6 +653,9 @@ void jar::addDirectoryToJarFile(const char* dir_name) {
 // Write out the central directory and close the jar file.
 void jar::closeJarFile(bool central) {
   if (jarfp) {
+#ifdef JAR_PARALLEL_DEFLATE
+    stop_pool();
+#endif
     fflush(jarfp);
     if (central) write_central_directory();
     fflush(jarfp);
@@ -455,7 +715,7 @@ uLong jar::get_dostime(int modtime) {
    length, the caller should verify if true and clen less than the
    input data
 */
-bool jar::deflate_bytes(bytes& head, bytes& tail) {
+bool jar::deflate_bytes(bytes& head, bytes& tail, fillbytes& deflated) {
   int len = (int)(head.len + tail.len);
 
   z_stream zs;
@@ -29,6 +29,15 @@
 
 struct unpacker;
 
+// The standalone unpacker deflates jar entries on worker threads while
+// the main thread goes on unpacking; see jar::addJarEntry.
+#if !defined(UNPACK_JNI) && !defined(NO_ZLIB) && !defined(_MSC_VER)
+#define JAR_PARALLEL_DEFLATE
+#endif
+
+struct jar_entry;
+struct deflater_pool;
+
 struct jar {
   // JAR file writer
   FILE*       jarfp;
@@ -46,6 +55,11 @@ struct jar {
   uint        output_file_offset;
   fillbytes   deflated;  // temporary buffer
 
+#ifdef JAR_PARALLEL_DEFLATE
+  deflater_pool* pool;   // null until the first deflated entry
+  bool        no_pool;   // set if worker threads are not available
+#endif
+
   // pointer to outer unpacker, for error checks etc.
   unpacker* u;
 
@@ -60,6 +74,9 @@ struct jar {
   void init(unpacker* u_);
 
   void free() {
+#ifdef JAR_PARALLEL_DEFLATE
+    stop_pool();
+#endif
     central_directory.free();
     deflated.free();
   }
@@ -81,8 +98,19 @@ struct jar {
   uLong dostime(int y, int n, int d, int h, int m, int s);
   uLong get_dostime(int modtime);
 
+#ifdef JAR_PARALLEL_DEFLATE
+  bool queue_entry(const char* fname, bool deflate, int modtime,
+                   bytes& head, bytes& tail);
+  void write_entry(jar_entry* e);
+  void write_queued_entries(bool all);
+  void stop_pool();
+#endif
+
   // The definitions of these depend on the NO_ZLIB option:
-  bool deflate_bytes(bytes& head, bytes& tail);
+  bool deflate_bytes(bytes& head, bytes& tail) {
+    return deflate_bytes(head, tail, deflated);
+  }
+  bool deflate_bytes(bytes& head, bytes& tail, fillbytes& out);
   static uint get_crc32(uint c, unsigned char *ptr, uint len);
 
   // error handling
@@ -45,6 +45,13 @@
 #define THREAD_SELF ((THRTYPE)pthread_self())
 #endif
 
+#ifndef WIN32
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define USE_MMAP_INPUT
+#endif
+
 #include "jni.h"
 #include "defines.h"
 #include "bytes.h"
@@ -118,6 +125,77 @@ static jlong read_input_via_stdio(unpacker* u,
   return numread;
 }
 
+#ifdef USE_MMAP_INPUT
+// Large uncompressed pack files are mapped and unpacked in place, instead
+// of being copied segment by segment into a buffer as large as the segment.
+enum { MMAP_INPUT_MIN = 1 << 20 };
+
+static int peek_magic(byte* p) {
+  return ((p[0] & 0xFF) << 24) | ((p[1] & 0xFF) << 16) |
+         ((p[2] & 0xFF) << 8)  |  (p[3] & 0xFF);
+}
+
+// Returns the mapped file, or null if the file is not worth mapping.
+static byte* map_input_file(FILE* fp, size_t* lenp, size_t* maplenp) {
+  struct stat st;
+  int fd = fileno(fp);
+  if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode) ||
+      st.st_size < MMAP_INPUT_MIN || (julong) st.st_size > PSIZE_MAX - C_SLOP)
+    return null;
+  size_t len = (size_t) st.st_size;
+  // The value decoders may look up to C_SLOP bytes past the end of the
+  // input, so the file is mapped over a zero filled region that long.
+  size_t maplen = len + C_SLOP;
+  void* region = mmap(null, maplen, PROT_READ | PROT_WRITE,
+                      MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (region == MAP_FAILED)
+    return null;
+  if (mmap(region, len, PROT_READ | PROT_WRITE,
+           MAP_PRIVATE | MAP_FIXED, fd, 0) == MAP_FAILED) {
+    munmap(region, maplen);
+    return null;
+  }
+  byte* base = (byte*) region;
+  if ((peek_magic(base) & GZIP_MAGIC_MASK) == GZIP_MAGIC) {
+    // must go through the gzip input filter
+    munmap(region, maplen);
+    return null;
+  }
+  madvise(region, len, MADV_SEQUENTIAL);
+  *lenp = len;
+  *maplenp = maplen;
+  return base;
+}
+
+// Unpacks all segments of a mapped pack file.
+static void unpack_mapped_input(unpacker* u, byte* base, size_t len) {
+  size_t offset = 0;
+  u->read_input_fn = null;  // the mapping is all the input there is
+  u->start(base, len);
+  for (;;) {
+    if (u->aborting())  break;
+    for (unpacker::file* filep; (filep = u->get_next_file()) != null; ) {
+      if (u->aborting())  break;
+      u->write_file_to_jar(filep);
+    }
+    if (u->aborting())  break;
+    if (base[offset] == 'P' && base[offset+1] == 'K')
+      break;   // copied as a JAR, which is always the last segment
+
+    // Another segment may follow.
+    offset += u->input_consumed();
+    if (offset == len)
+      break;   // all done
+    if (len - offset < 4 || peek_magic(base + offset) != (int)JAVA_PACKAGE_MAGIC) {
+      u->abort("garbage after end of pack archive");
+      break;
+    }
+    u->reset();
+    u->start(base + offset, len - offset);
+  }
+}
+#endif
+
 enum { EOF_MAGIC = 0, BAD_MAGIC = -1 };
 static int read_magic(unpacker* u, char peek[], int peeklen) {
   assert(peeklen == 4);  // magic numbers are always 4 bytes
@@ -398,48 +476,58 @@ int unpacker::run(int argc, char **argv) {
   char peek[4];
   int magic;
 
-  // check for GZIP input
-  magic = read_magic(&u, peek, (int)sizeof(peek));
-  if ((magic & GZIP_MAGIC_MASK) == GZIP_MAGIC) {
-    // Oops; must slap an input filter on this data.
-    setup_gzin(&u);
-    u.gzin->start(magic);
-    u.gzin->gzcrc = 0;
-    u.gzin->gzlen = 0;
-    if (!u.aborting()) {
-      u.start();
+#ifdef USE_MMAP_INPUT
+  size_t mapped_len = 0, mapped_region_len = 0;
+  byte* mapped = (u.infileptr == null) ? null :
+    map_input_file(u.infileptr, &mapped_len, &mapped_region_len);
+  if (mapped != null) {
+    unpack_mapped_input(&u, mapped, mapped_len);
+  } else
+#endif
+  {
+    // check for GZIP input
+    magic = read_magic(&u, peek, (int)sizeof(peek));
+    if ((magic & GZIP_MAGIC_MASK) == GZIP_MAGIC) {
+      // Oops; must slap an input filter on this data.
+      setup_gzin(&u);
+      u.gzin->start(magic);
+      u.gzin->gzcrc = 0;
+      u.gzin->gzlen = 0;
+      if (!u.aborting()) {
+        u.start();
+      }
+    } else {
+      u.start(peek, sizeof(peek));
     }
-  } else {
-    u.start(peek, sizeof(peek));
-  }
 
-  // Note:  The checks to u.aborting() are necessary to gracefully
-  // terminate processing when the first segment throws an error.
+    // Note:  The checks to u.aborting() are necessary to gracefully
+    // terminate processing when the first segment throws an error.
 
-  for (;;) {
-    if (u.aborting())  break;
+    for (;;) {
+      if (u.aborting())  break;
 
-    // Each trip through this loop unpacks one segment
-    // and then resets the unpacker.
-    for (unpacker::file* filep; (filep = u.get_next_file()) != null; ) {
+      // Each trip through this loop unpacks one segment
+      // and then resets the unpacker.
+      for (unpacker::file* filep; (filep = u.get_next_file()) != null; ) {
+        if (u.aborting())  break;
+        u.write_file_to_jar(filep);
+      }
       if (u.aborting())  break;
-      u.write_file_to_jar(filep);
-    }
-    if (u.aborting())  break;
 
-    // Peek ahead for more data.
-    magic = read_magic(&u, peek, (int)sizeof(peek));
-    if (magic != (int)JAVA_PACKAGE_MAGIC) {
-      if (magic != EOF_MAGIC)
-        u.abort("garbage after end of pack archive");
-      break;   // all done
-    }
+      // Peek ahead for more data.
+      magic = read_magic(&u, peek, (int)sizeof(peek));
+      if (magic != (int)JAVA_PACKAGE_MAGIC) {
+        if (magic != EOF_MAGIC)
+          u.abort("garbage after end of pack archive");
+        break;   // all done
+      }
 
-    // Release all storage from parsing the old segment.
-    u.reset();
+      // Release all storage from parsing the old segment.
+      u.reset();
 
-    // Restart, beginning with the peek-ahead.
-    u.start(peek, sizeof(peek));
+      // Restart, beginning with the peek-ahead.
+      u.start(peek, sizeof(peek));
+    }
   }
 
   int status = 0;
@@ -465,5 +553,11 @@ int unpacker::run(int argc, char **argv) {
   u.free();  // tidy up malloc blocks
   set_current_unpacker(null);  // clean up global pointer
 
+#ifdef USE_MMAP_INPUT
+  if (mapped != null) {
+    munmap(mapped, mapped_region_len);
+  }
+#endif
+
   return status;
 }
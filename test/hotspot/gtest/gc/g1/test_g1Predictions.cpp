@@ -96,3 +96,33 @@ TEST_VM(G1Predictions, average_stdev_predictions) {
   double p4 = predictor.get_new_prediction(&s);
   ASSERT_GT(p4, p3) << "Fourth prediction must be greater than third";
 }
+
+// The change point predictor must agree with the decaying average predictor
+// for stable sequences.
+TEST_VM(G1Predictions, change_point_stable_predictions) {
+  G1Predictions decaying(0.5);
+  G1Predictions change_point(0.5, new G1ChangePointPredictor());
+  TruncatedSeq s;
+
+  for (int i = 0; i < 20; i++) {
+    s.add(i % 2 == 0 ? 1.0 : 1.02);
+    ASSERT_NEAR(decaying.get_new_prediction(&s), change_point.get_new_prediction(&s), epsilon);
+  }
+}
+
+// After a sudden shift of the samples the change point predictor must adapt
+// to the new level immediately.
+TEST_VM(G1Predictions, change_point_shift_predictions) {
+  G1Predictions decaying(0.0);
+  G1Predictions change_point(0.0, new G1ChangePointPredictor());
+  TruncatedSeq s;
+
+  for (int i = 0; i < 10; i++) {
+    s.add(1.0);
+  }
+  for (int i = 0; i < G1ChangePointPredictor::RecentSamples; i++) {
+    s.add(10.0);
+  }
+  ASSERT_NEAR(change_point.get_new_prediction(&s), 10.0, epsilon);
+  ASSERT_LT(decaying.get_new_prediction(&s), 10.0 - 1.0) << "Decaying average must lag behind";
+}
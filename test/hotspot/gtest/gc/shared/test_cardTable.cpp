@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#include "precompiled.hpp"
+#include "gc/shared/cardTable.hpp"
+#include "utilities/globalDefinitions.hpp"
+#include "unittest.hpp"
+
+#include <string.h>
+
+// Enough cards for several strides of the word-wise search.
+static const size_t card_count = 16 * BytesPerWord;
+
+static jbyte* expected_first(jbyte* start, jbyte* end) {
+  for (jbyte* cur = start; cur < end; cur++) {
+    if (*cur != CardTable::clean_card_val()) {
+      return cur;
+    }
+  }
+  return end;
+}
+
+static jbyte* expected_last(jbyte* start, jbyte* end) {
+  for (jbyte* cur = end; cur > start; cur--) {
+    if (*(cur - 1) != CardTable::clean_card_val()) {
+      return cur - 1;
+    }
+  }
+  return start - 1;
+}
+
+static void check_all_ranges(jbyte* cards) {
+  for (size_t start = 0; start <= card_count; start++) {
+    for (size_t end = start; end <= card_count; end++) {
+      ASSERT_EQ(expected_first(cards + start, cards + end),
+                CardTable::find_first_non_clean_card(cards + start, cards + end))
+        << "start: " << start << " end: " << end;
+      ASSERT_EQ(expected_last(cards + start, cards + end),
+                CardTable::find_last_non_clean_card(cards + start, cards + end))
+        << "start: " << start << " end: " << end;
+    }
+  }
+}
+
+TEST(gc, card_table_find_non_clean_card) {
+  // Word aligned, with a word of padding on each side so that the searches
+  // never read outside the array.
+  intptr_t storage[card_count / BytesPerWord + 2];
+  jbyte* cards = (jbyte*)&storage[1];
+
+  memset(storage, CardTable::clean_card_val(), sizeof(storage));
+  check_all_ranges(cards);
+
+  // A single dirty card at every position.
+  for (size_t i = 0; i < card_count; i++) {
+    memset(storage, CardTable::clean_card_val(), sizeof(storage));
+    cards[i] = CardTable::dirty_card_val();
+    check_all_ranges(cards);
+  }
+
+  // Two dirty cards far apart.
+  memset(storage, CardTable::clean_card_val(), sizeof(storage));
+  cards[3] = CardTable::dirty_card_val();
+  cards[card_count - 5] = CardTable::dirty_card_val();
+  check_all_ranges(cards);
+}
@@ -399,6 +399,66 @@ TEST_VM_F(OopStorageTest, allocate_many) {
   }
 }
 
+TEST_VM_F(OopStorageTest, bulk_allocation) {
+  static const size_t max_entries = 1000;
+  static const size_t zero = 0;
+  oop* entries[max_entries] = {};
+
+  AllocationList& allocation_list = TestAccess::allocation_list(_storage);
+
+  EXPECT_EQ(0u, empty_block_count(_storage));
+  size_t allocated = _storage.allocate(entries, max_entries);
+  ASSERT_NE(allocated, zero);
+  // ASSERT_LE would ODR-use the passed-in arguments, so use a local.
+  size_t expected = max_entries;
+  ASSERT_LE(allocated, expected);
+  ASSERT_EQ(allocated, _storage.allocation_count());
+  ASSERT_EQ(allocated, total_allocation_count(_storage));
+  for (size_t i = 0; i < allocated; ++i) {
+    EXPECT_TRUE(entries[i] != NULL);
+    EXPECT_EQ(OopStorage::ALLOCATED_ENTRY, _storage.allocation_status(entries[i]));
+  }
+  for (size_t i = allocated; i < max_entries; ++i) {
+    EXPECT_TRUE(entries[i] == NULL);
+  }
+  // A new block was completely claimed, so it is no longer available
+  // for allocation.
+  EXPECT_TRUE(is_list_empty(allocation_list));
+
+  _storage.release(entries, allocated);
+  EXPECT_TRUE(process_deferred_updates(_storage));
+  EXPECT_EQ(0u, _storage.allocation_count());
+  EXPECT_EQ(0u, total_allocation_count(_storage));
+  EXPECT_EQ(1u, list_length(allocation_list));
+}
+
+TEST_VM_F(OopStorageTest, bulk_allocation_partial) {
+  static const size_t count = 3;
+  oop* entries[count] = {};
+
+  AllocationList& allocation_list = TestAccess::allocation_list(_storage);
+
+  // Requesting fewer entries than a block holds gives back the excess.
+  size_t allocated = _storage.allocate(entries, count);
+  ASSERT_EQ(count, allocated);
+  EXPECT_EQ(count, _storage.allocation_count());
+  EXPECT_EQ(count, total_allocation_count(_storage));
+  EXPECT_TRUE(process_deferred_updates(_storage));
+  EXPECT_EQ(1u, list_length(allocation_list));
+
+  // Subsequent single allocation uses the same block.
+  oop* ptr = _storage.allocate();
+  ASSERT_TRUE(ptr != NULL);
+  EXPECT_EQ(1u, _storage.block_count());
+  EXPECT_EQ(count + 1, total_allocation_count(_storage));
+
+  release_entry(_storage, ptr);
+  _storage.release(entries, count);
+  process_deferred_updates(_storage);
+  EXPECT_EQ(0u, _storage.allocation_count());
+  EXPECT_EQ(1u, empty_block_count(_storage));
+}
+
 TEST_VM_F(OopStorageTestWithAllocation, random_release) {
   static const size_t step = 11;
   ASSERT_NE(0u, _max_entries % step); // max_entries and step are mutually prime
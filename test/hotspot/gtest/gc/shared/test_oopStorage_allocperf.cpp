@@ -0,0 +1,183 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#include "precompiled.hpp"
+#include "gc/shared/oopStorage.inline.hpp"
+#include "gc/shared/workgroup.hpp"
+#include "memory/allocation.inline.hpp"
+#include "runtime/atomic.hpp"
+#include "runtime/mutex.hpp"
+#include "runtime/os.hpp"
+#include "utilities/debug.hpp"
+#include "utilities/globalDefinitions.hpp"
+#include "utilities/ostream.hpp"
+#include "utilities/ticks.hpp"
+
+#include "unittest.hpp"
+
+// This "test" doesn't really verify much.  Rather, it's mostly a
+// microbenchmark for OopStorage allocation and release.  Several threads
+// concurrently allocate and release entries from a shared storage object,
+// either one entry at a time, or through a small per-thread cache refilled
+// with bulk allocation, and the elapsed times are logged.
+
+const uint _max_workers = 10;
+static uint _num_workers = 0;
+const size_t _entries_per_worker = 100000;
+const size_t _cache_size = 32;
+
+class OopStorageAllocPerf : public ::testing::Test {
+public:
+  OopStorageAllocPerf();
+
+  WorkGang* workers() const;
+
+  class Task;
+
+  void run_test(uint nthreads, bool use_bulk);
+
+  static WorkGang* _workers;
+
+  static const int _active_rank = Mutex::leaf - 1;
+  static const int _allocate_rank = Mutex::leaf;
+
+  Mutex _allocate_mutex;
+  Mutex _active_mutex;
+  OopStorage _storage;
+};
+
+WorkGang* OopStorageAllocPerf::_workers = NULL;
+
+WorkGang* OopStorageAllocPerf::workers() const {
+  if (_workers == NULL) {
+    WorkGang* wg = new WorkGang("OopStorageAllocPerf workers",
+                                _num_workers,
+                                false,
+                                false);
+    wg->initialize_workers();
+    wg->update_active_workers(_num_workers);
+    _workers = wg;
+  }
+  return _workers;
+}
+
+OopStorageAllocPerf::OopStorageAllocPerf() :
+  _allocate_mutex(_allocate_rank,
+                  "test_OopStorage_allocperf_allocate",
+                  false,
+                  Mutex::_safepoint_check_never),
+  _active_mutex(_active_rank,
+                "test_OopStorage_allocperf_active",
+                false,
+                Mutex::_safepoint_check_never),
+  _storage("Test Storage", &_allocate_mutex, &_active_mutex)
+{
+  _num_workers = MIN2(_max_workers, (uint)os::processor_count());
+}
+
+class OopStorageAllocPerf::Task : public AbstractGangTask {
+  OopStorage* _storage;
+  bool _use_bulk;
+  volatile size_t _failures;
+
+  // Allocate an entry, using the cache if bulk allocation is enabled.
+  oop* allocate(oop** cache, size_t* cached) {
+    if (!_use_bulk) {
+      return _storage->allocate();
+    } else if (*cached == 0) {
+      *cached = _storage->allocate(cache, _cache_size);
+      if (*cached == 0) return NULL;
+    }
+    return cache[--*cached];
+  }
+
+public:
+  Task(OopStorage* storage, bool use_bulk) :
+    AbstractGangTask("OopStorageAllocPerf::Task"),
+    _storage(storage),
+    _use_bulk(use_bulk),
+    _failures(0)
+  {}
+
+  virtual void work(uint worker_id) {
+    oop* cache[_cache_size];
+    size_t cached = 0;
+    // Keep a small working set alive, to exercise the full/not full
+    // transitions as well as the empty ones.
+    const size_t live_count = 8;
+    oop* live[live_count] = {};
+    for (size_t i = 0; i < _entries_per_worker; ++i) {
+      oop* entry = allocate(cache, &cached);
+      if (entry == NULL) {
+        Atomic::inc(&_failures);
+        break;
+      }
+      size_t slot = i % live_count;
+      if (live[slot] != NULL) {
+        _storage->release(live[slot]);
+      }
+      live[slot] = entry;
+    }
+    for (size_t i = 0; i < live_count; ++i) {
+      if (live[i] != NULL) {
+        _storage->release(live[i]);
+      }
+    }
+    if (cached > 0) {
+      _storage->release(cache, cached);
+    }
+  }
+
+  size_t failures() const { return _failures; }
+};
+
+void OopStorageAllocPerf::run_test(uint nthreads, bool use_bulk) {
+  if (nthreads <= _num_workers) {
+    SCOPED_TRACE(err_msg("Running test with %u threads", nthreads).buffer());
+    Task task(&_storage, use_bulk);
+    Ticks start_time = Ticks::now();
+    workers()->run_task(&task, nthreads);
+    Tickspan duration = Ticks::now() - start_time;
+    tty->print_cr("Run %s test with %u threads: " JLONG_FORMAT,
+                  use_bulk ? "bulk" : "single", nthreads, duration.value());
+    EXPECT_EQ(0u, task.failures());
+    EXPECT_EQ(0u, _storage.allocation_count());
+  }
+}
+
+TEST_VM_F(OopStorageAllocPerf, single) {
+  run_test(1, false);
+  run_test(2, false);
+  run_test(4, false);
+  run_test(8, false);
+  run_test(10, false);
+}
+
+TEST_VM_F(OopStorageAllocPerf, bulk) {
+  run_test(1, true);
+  run_test(2, true);
+  run_test(4, true);
+  run_test(8, true);
+  run_test(10, true);
+}
@@ -0,0 +1,153 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#include "precompiled.hpp"
+#include "gc/shared/taskqueue.inline.hpp"
+#include "gc/shared/workgroup.hpp"
+#include "memory/allocation.inline.hpp"
+#include "runtime/atomic.hpp"
+#include "runtime/os.hpp"
+#include "utilities/globalDefinitions.hpp"
+#include "utilities/ostream.hpp"
+#include "utilities/quickSort.hpp"
+#include "utilities/ticks.hpp"
+
+#include "unittest.hpp"
+
+// This "test" doesn't really verify much.  Rather, it's mostly a
+// microbenchmark for GenericTaskQueue.  The owner push/pop_local path is
+// timed on a single thread, and the pop_global path by several threads
+// stealing from one filled queue.  Each run is repeated, and the minimum,
+// median and maximum elapsed times are logged.
+
+typedef GenericTaskQueue<int, mtGC> TestTaskQueue;
+typedef GenericTaskQueueSet<TestTaskQueue, mtGC> TestTaskQueueSet;
+
+const uint _max_workers = 8;
+const uint _repetitions = 11;
+// A queue holds at most TASKQUEUE_SIZE - 2 elements, 1 << 14 on 32-bit.
+const int _num_tasks = MIN2(1 << 16, TASKQUEUE_SIZE - 2);
+
+static int compare_ticks(const jlong& a, const jlong& b) {
+  return a < b ? -1 : (a > b ? 1 : 0);
+}
+
+static void print_times(const char* name, uint nthreads, jlong* times, uint count) {
+  QuickSort::sort(times, count, compare_ticks, false);
+  tty->print_cr("Run %s test with %u threads: min " JLONG_FORMAT
+                " median " JLONG_FORMAT " max " JLONG_FORMAT,
+                name, nthreads, times[0], times[count / 2], times[count - 1]);
+}
+
+TEST_VM(TaskQueuePerf, push_pop_local) {
+  TestTaskQueue queue;
+  queue.initialize();
+  jlong times[_repetitions];
+
+  for (uint r = 0; r < _repetitions; r++) {
+    jlong sum = 0;
+    Ticks start_time = Ticks::now();
+    for (int i = 0; i < _num_tasks; i++) {
+      ASSERT_TRUE(queue.push(i));
+    }
+    int t;
+    while (queue.pop_local(t)) {
+      sum += t;
+    }
+    times[r] = (Ticks::now() - start_time).value();
+    ASSERT_EQ((jlong)(_num_tasks - 1) * (_num_tasks / 2), sum);
+  }
+  print_times("push_pop_local", 1, times, _repetitions);
+}
+
+class TaskQueuePerfStealTask : public AbstractGangTask {
+  TestTaskQueueSet* _queues;
+  volatile int _processed;
+
+public:
+  TaskQueuePerfStealTask(TestTaskQueueSet* queues) :
+    AbstractGangTask("TaskQueuePerfStealTask"),
+    _queues(queues),
+    _processed(0)
+  {}
+
+  virtual void work(uint worker_id) {
+    int count = 0;
+    int t;
+    // The owner of queue 0 drains it locally, everybody steals from it
+    // until no queue has any tasks left.
+    if (worker_id == 0) {
+      while (_queues->queue(0)->pop_local(t)) {
+        count++;
+      }
+    }
+    while (true) {
+      if (_queues->steal(worker_id, t)) {
+        count++;
+      } else if (!_queues->peek()) {
+        break;
+      }
+    }
+    Atomic::add(count, &_processed);
+  }
+
+  int processed() const { return _processed; }
+};
+
+TEST_VM(TaskQueuePerf, steal) {
+  const uint num_workers = MIN2(_max_workers, (uint)os::processor_count());
+  if (num_workers < 2) {
+    return;
+  }
+
+  WorkGang workers("TaskQueuePerf workers", num_workers, false, false);
+  workers.initialize_workers();
+  workers.update_active_workers(num_workers);
+
+  TestTaskQueueSet queues(num_workers);
+  for (uint i = 0; i < num_workers; i++) {
+    TestTaskQueue* queue = new TestTaskQueue();
+    queue->initialize();
+    queues.register_queue(i, queue);
+  }
+
+  for (uint nthreads = 2; nthreads <= num_workers; nthreads *= 2) {
+    jlong times[_repetitions];
+    for (uint r = 0; r < _repetitions; r++) {
+      for (int i = 0; i < _num_tasks; i++) {
+        ASSERT_TRUE(queues.queue(0)->push(i));
+      }
+      TaskQueuePerfStealTask task(&queues);
+      Ticks start_time = Ticks::now();
+      workers.run_task(&task, nthreads);
+      times[r] = (Ticks::now() - start_time).value();
+      ASSERT_EQ(_num_tasks, task.processed());
+    }
+    print_times("steal", nthreads, times, _repetitions);
+  }
+
+  for (uint i = 0; i < num_workers; i++) {
+    delete queues.queue(i);
+  }
+}
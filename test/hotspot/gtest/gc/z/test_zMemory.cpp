@@ -0,0 +1,57 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#include "precompiled.hpp"
+#include "gc/z/zMemory.inline.hpp"
+#include "unittest.hpp"
+
+TEST(ZMemoryManager, alloc_from_back_at_most) {
+  const size_t GranuleSize = 2 * M;
+
+  ZMemoryManager manager;
+  manager.free(0, 10 * GranuleSize);
+
+  // Larger than requested, shrink the last area
+  size_t allocated = 0;
+  uintptr_t start = manager.alloc_from_back_at_most(4 * GranuleSize, &allocated);
+  EXPECT_EQ(start, 6 * GranuleSize);
+  EXPECT_EQ(allocated, 4 * GranuleSize);
+
+  // Smaller than requested, remove the last area
+  start = manager.alloc_from_back_at_most(8 * GranuleSize, &allocated);
+  EXPECT_EQ(start, 0u);
+  EXPECT_EQ(allocated, 6 * GranuleSize);
+
+  // Empty
+  start = manager.alloc_from_back_at_most(1 * GranuleSize, &allocated);
+  EXPECT_EQ(start, UINTPTR_MAX);
+  EXPECT_EQ(allocated, 0u);
+
+  // Only the last area is considered
+  manager.free(0, 2 * GranuleSize);
+  manager.free(4 * GranuleSize, 1 * GranuleSize);
+  start = manager.alloc_from_back_at_most(3 * GranuleSize, &allocated);
+  EXPECT_EQ(start, 4 * GranuleSize);
+  EXPECT_EQ(allocated, 1 * GranuleSize);
+}
@@ -224,3 +224,27 @@ TEST(LogDecorations, identifiers) {
     EXPECT_EQ(ids[i].expected, strtol(reported, NULL, 10));
   }
 }
+
+TEST_VM(LogDecorations, copy) {
+  LogDecorators decorators;
+  ASSERT_TRUE(decorators.parse("uptime,level,tags,tid"));
+  void* const storage = os::malloc(sizeof(LogDecorations), mtLogging);
+  LogDecorations* const original = ::new (storage) LogDecorations(LogLevel::Debug, tagset, decorators);
+  LogDecorations copy(*original);
+
+  const LogDecorators::Decorator used[] = {
+    LogDecorators::uptime_decorator,
+    LogDecorators::level_decorator,
+    LogDecorators::tags_decorator,
+    LogDecorators::tid_decorator
+  };
+  for (size_t i = 0; i < ARRAY_SIZE(used); i++) {
+    EXPECT_STREQ(original->decoration(used[i]), copy.decoration(used[i]));
+  }
+
+  // The copy must not refer to the buffer of the original
+  memset(storage, 0, sizeof(LogDecorations));
+  EXPECT_STREQ("logging,safepoint", copy.decoration(LogDecorators::tags_decorator));
+  EXPECT_STREQ("debug", copy.decoration(LogDecorators::level_decorator));
+  os::free(storage);
+}
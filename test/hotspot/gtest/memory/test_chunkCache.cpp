@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+#include "precompiled.hpp"
+#include "memory/arena.hpp"
+#include "unittest.hpp"
+
+TEST(ChunkCache, size_index) {
+  EXPECT_EQ(0, ChunkCache::size_index(Chunk::tiny_size));
+  EXPECT_EQ(1, ChunkCache::size_index(Chunk::init_size));
+  EXPECT_EQ(2, ChunkCache::size_index(Chunk::medium_size));
+  EXPECT_EQ(3, ChunkCache::size_index(Chunk::size));
+  EXPECT_EQ(-1, ChunkCache::size_index(Chunk::size + 1));
+}
+
+TEST_VM(ChunkCache, take_put) {
+  ChunkCache* cache = new ChunkCache();
+  int index = ChunkCache::size_index(Chunk::tiny_size);
+  ASSERT_TRUE(cache->take(index) == NULL);
+
+  Chunk* chunks[ChunkCache::max_cached + 1];
+  for (int i = 0; i <= ChunkCache::max_cached; i++) {
+    chunks[i] = new (AllocFailStrategy::EXIT_OOM, Chunk::tiny_size) Chunk(Chunk::tiny_size);
+  }
+  for (int i = 0; i < ChunkCache::max_cached; i++) {
+    ASSERT_TRUE(cache->put(index, chunks[i]));
+  }
+  // The slot is full, the last chunk is not retained
+  ASSERT_FALSE(cache->put(index, chunks[ChunkCache::max_cached]));
+  delete chunks[ChunkCache::max_cached];
+
+  // Last in, first out
+  Chunk* c = cache->take(index);
+  ASSERT_EQ(chunks[ChunkCache::max_cached - 1], c);
+  ASSERT_TRUE(cache->put(index, c));
+
+  // The cached chunks go back to the pool
+  delete cache;
+}
+
+TEST(ChunkCache, peak) {
+  ChunkCache cache;
+  cache.record_allocate(100);
+  cache.record_allocate(200);
+  cache.record_free(100);
+  EXPECT_EQ(300u, cache.peak());
+  cache.reset_peak();
+  EXPECT_EQ(200u, cache.peak());
+  // Frees of chunks taken by another thread do not underflow
+  cache.record_free(1000);
+  cache.record_allocate(50);
+  EXPECT_EQ(200u, cache.peak());
+}
@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+#include "precompiled.hpp"
+
+// Included early because the NMT flags don't include it.
+#include "utilities/macros.hpp"
+
+#if INCLUDE_NMT
+
+#include "runtime/flags/flagSetting.hpp"
+#include "runtime/globals.hpp"
+#include "services/mallocTracker.hpp"
+#include "services/memTracker.hpp"
+#include "unittest.hpp"
+
+TEST_VM(NMT, malloc_stack_sampling_off) {
+  FLAG_GUARD(NativeMemoryTrackingStackSampleInterval);
+
+  for (uintx interval = 0; interval <= 1; interval++) {
+    NativeMemoryTrackingStackSampleInterval = interval;
+    EXPECT_EQ((size_t)1, MallocTracker::stack_sample_interval());
+    for (int i = 0; i < 1000; i++) {
+      ASSERT_TRUE(MallocTracker::sample_stack());
+    }
+  }
+}
+
+TEST_VM(NMT, malloc_stack_sampling_rate) {
+  FLAG_GUARD(NativeMemoryTrackingStackSampleInterval);
+  NativeMemoryTrackingStackSampleInterval = 100;
+  EXPECT_EQ((size_t)100, MallocTracker::stack_sample_interval());
+
+  // Sampling is per malloc call, so about one call in a hundred walks
+  // its stack. The bounds are loose to keep the test stable.
+  const int calls = 100000;
+  int sampled = 0;
+  for (int i = 0; i < calls; i++) {
+    if (MallocTracker::sample_stack()) {
+      sampled++;
+    }
+  }
+  EXPECT_GT(sampled, calls / 200);
+  EXPECT_LT(sampled, calls / 50);
+}
+
+TEST_VM(NMT, sampled_current_pc_skips_unsampled_calls) {
+  FLAG_GUARD(NativeMemoryTrackingStackSampleInterval);
+  NativeMemoryTrackingStackSampleInterval = max_jint;
+
+  // Consume the pending sample, the next one is then very far away.
+  while (!MallocTracker::sample_stack()) {}
+  EXPECT_TRUE(SAMPLED_CURRENT_PC.is_empty());
+  EXPECT_TRUE(SAMPLED_CALLER_PC.is_empty());
+
+  NativeMemoryTrackingStackSampleInterval = 1;
+  if (MemTracker::tracking_level() == NMT_detail && NMT_stack_walkable) {
+    EXPECT_FALSE(SAMPLED_CURRENT_PC.is_empty());
+  } else {
+    EXPECT_TRUE(SAMPLED_CURRENT_PC.is_empty());
+  }
+}
+
+#endif // INCLUDE_NMT
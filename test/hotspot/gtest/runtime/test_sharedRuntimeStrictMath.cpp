@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+#include "precompiled.hpp"
+#include "runtime/sharedRuntime.hpp"
+#include "utilities/globalDefinitions.hpp"
+#include "unittest.hpp"
+
+// C2 calls the SharedRuntime copies of the fdlibm routines in place of the
+// StrictMath natives, so they must produce exactly the bits libfdlibm does.
+// The expected values were computed with the libfdlibm sources in
+// java.base, and cover the reduction paths for small, medium and huge
+// arguments as well as subnormal, tiny and huge log arguments.
+
+typedef jdouble (*StrictMathFunction)(jdouble x);
+
+struct StrictMathCase {
+  StrictMathFunction _function;
+  const char* _name;
+  julong _argument;
+  julong _expected;
+};
+
+static const StrictMathCase strict_math_cases[] = {
+  { SharedRuntime::dsin,   "sin",   UCONST64(0x3fe0000000000000), UCONST64(0x3fdeaee8744b05f0) },
+  { SharedRuntime::dsin,   "sin",   UCONST64(0x3ff0000000000000), UCONST64(0x3feaed548f090cee) },
+  { SharedRuntime::dsin,   "sin",   UCONST64(0x4000000000000000), UCONST64(0x3fed18f6ead1b446) },
+  { SharedRuntime::dsin,   "sin",   UCONST64(0x400921fb54442d18), UCONST64(0x3ca1a62633145c07) },
+  { SharedRuntime::dsin,   "sin",   UCONST64(0x4024000000000000), UCONST64(0xbfe1689ef5f34f52) },
+  { SharedRuntime::dsin,   "sin",   UCONST64(0x412e848000000000), UCONST64(0xbfd6664b2568d867) },
+  { SharedRuntime::dsin,   "sin",   UCONST64(0x4480f0cf064dd592), UCONST64(0xbfeb453ab76bf397) },
+  { SharedRuntime::dsin,   "sin",   UCONST64(0xbfe921fb54442d18), UCONST64(0xbfe6a09e667f3bcc) },
+  { SharedRuntime::dsin,   "sin",   UCONST64(0x3ff921fb54442d18), UCONST64(0x3ff0000000000000) },
+  { SharedRuntime::dsin,   "sin",   UCONST64(0x405edd2f1a9fbe77), UCONST64(0xbfe9b9dadc41aeb6) },
+  { SharedRuntime::dcos,   "cos",   UCONST64(0x3fe0000000000000), UCONST64(0x3fec1528065b7d50) },
+  { SharedRuntime::dcos,   "cos",   UCONST64(0x3ff0000000000000), UCONST64(0x3fe14a280fb5068c) },
+  { SharedRuntime::dcos,   "cos",   UCONST64(0x4000000000000000), UCONST64(0xbfdaa22657537205) },
+  { SharedRuntime::dcos,   "cos",   UCONST64(0x400921fb54442d18), UCONST64(0xbff0000000000000) },
+  { SharedRuntime::dcos,   "cos",   UCONST64(0x4024000000000000), UCONST64(0xbfead9ac890c6b1f) },
+  { SharedRuntime::dcos,   "cos",   UCONST64(0x412e848000000000), UCONST64(0x3fedf9df9906d32c) },
+  { SharedRuntime::dcos,   "cos",   UCONST64(0x4480f0cf064dd592), UCONST64(0x3fe0be2cef01c8f4) },
+  { SharedRuntime::dcos,   "cos",   UCONST64(0xbfe921fb54442d18), UCONST64(0x3fe6a09e667f3bcd) },
+  { SharedRuntime::dcos,   "cos",   UCONST64(0x3ff921fb54442d18), UCONST64(0x3c91a62633145c07) },
+  { SharedRuntime::dcos,   "cos",   UCONST64(0x405edd2f1a9fbe77), UCONST64(0xbfe307e5980a1558) },
+  { SharedRuntime::dtan,   "tan",   UCONST64(0x3fe0000000000000), UCONST64(0x3fe17b4f5bf3474a) },
+  { SharedRuntime::dtan,   "tan",   UCONST64(0x3ff0000000000000), UCONST64(0x3ff8eb245cbee3a6) },
+  { SharedRuntime::dtan,   "tan",   UCONST64(0x4000000000000000), UCONST64(0xc0017af62e0950f8) },
+  { SharedRuntime::dtan,   "tan",   UCONST64(0x400921fb54442d18), UCONST64(0xbca1a62633145c07) },
+  { SharedRuntime::dtan,   "tan",   UCONST64(0x4024000000000000), UCONST64(0x3fe4bf5f34be3782) },
+  { SharedRuntime::dtan,   "tan",   UCONST64(0x412e848000000000), UCONST64(0xbfd7e9768ab734c0) },
+  { SharedRuntime::dtan,   "tan",   UCONST64(0x4480f0cf064dd592), UCONST64(0xbffa0f79c1b6b258) },
+  { SharedRuntime::dtan,   "tan",   UCONST64(0xbfe921fb54442d18), UCONST64(0xbfefffffffffffff) },
+  { SharedRuntime::dtan,   "tan",   UCONST64(0x3ff921fb54442d18), UCONST64(0x434d02967c31cdb5) },
+  { SharedRuntime::dtan,   "tan",   UCONST64(0x405edd2f1a9fbe77), UCONST64(0x3ff5a0fe5da94891) },
+  { SharedRuntime::dlog,   "log",   UCONST64(0x3fe0000000000000), UCONST64(0xbfe62e42fefa39ef) },
+  { SharedRuntime::dlog,   "log",   UCONST64(0x3ff0000000000000), UCONST64(0x0000000000000000) },
+  { SharedRuntime::dlog,   "log",   UCONST64(0x4000000000000000), UCONST64(0x3fe62e42fefa39ef) },
+  { SharedRuntime::dlog,   "log",   UCONST64(0x4024000000000000), UCONST64(0x40026bb1bbb55516) },
+  { SharedRuntime::dlog,   "log",   UCONST64(0x01a56e1fc2f8f359), UCONST64(0xc085963447f87fb5) },
+  { SharedRuntime::dlog,   "log",   UCONST64(0x7e37e43c8800759c), UCONST64(0x4085963447f87fb5) },
+  { SharedRuntime::dlog,   "log",   UCONST64(0x4008000000000000), UCONST64(0x3ff193ea7aad030a) },
+  { SharedRuntime::dlog,   "log",   UCONST64(0x405edd2f1a9fbe77), UCONST64(0x401343774f3e2362) },
+  { SharedRuntime::dlog,   "log",   UCONST64(0x3feffffde7210be9), UCONST64(0xbeb0c6f82d74d230) },
+  { SharedRuntime::dlog,   "log",   UCONST64(0x0000000000000001), UCONST64(0xc0874385446d71c3) },
+  { SharedRuntime::dlog10, "log10", UCONST64(0x3fe0000000000000), UCONST64(0xbfd34413509f79ff) },
+  { SharedRuntime::dlog10, "log10", UCONST64(0x3ff0000000000000), UCONST64(0x0000000000000000) },
+  { SharedRuntime::dlog10, "log10", UCONST64(0x4000000000000000), UCONST64(0x3fd34413509f79ff) },
+  { SharedRuntime::dlog10, "log10", UCONST64(0x4024000000000000), UCONST64(0x3ff0000000000000) },
+  { SharedRuntime::dlog10, "log10", UCONST64(0x01a56e1fc2f8f359), UCONST64(0xc072c00000000000) },
+  { SharedRuntime::dlog10, "log10", UCONST64(0x7e37e43c8800759c), UCONST64(0x4072c00000000000) },
+  { SharedRuntime::dlog10, "log10", UCONST64(0x4008000000000000), UCONST64(0x3fde8927964fd5fd) },
+  { SharedRuntime::dlog10, "log10", UCONST64(0x405edd2f1a9fbe77), UCONST64(0x4000bb6abfc968ef) },
+  { SharedRuntime::dlog10, "log10", UCONST64(0x3feffffde7210be9), UCONST64(0xbe9d25204937a8c5) },
+  { SharedRuntime::dlog10, "log10", UCONST64(0x0000000000000001), UCONST64(0xc07434e6420f4374) },
+};
+
+TEST_VM(SharedRuntime, strict_math_matches_fdlibm) {
+  for (size_t i = 0; i < ARRAY_SIZE(strict_math_cases); i++) {
+    const StrictMathCase& c = strict_math_cases[i];
+    jdouble result = c._function(jdouble_cast((jlong)c._argument));
+    EXPECT_EQ(c._expected, (julong)jlong_cast(result))
+      << c._name << "(" << jdouble_cast((jlong)c._argument) << ") differs from fdlibm";
+  }
+}
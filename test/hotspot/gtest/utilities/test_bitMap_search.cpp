@@ -256,3 +256,34 @@ TEST(BitMap, search) {
     }
   }
 }
+
+// Searches that cross many words, with the bits placed at every word
+// offset from the start so all positions within a block of words that
+// is skipped at once are covered.
+TEST(BitMap, search_sparse) {
+  const idx_t sparse_size = 64 * BitsPerWord;
+  CHeapBitMap test_ones(sparse_size);
+  CHeapBitMap test_zeros(sparse_size);
+  test_zeros.set_range(0, sparse_size);
+
+  for (idx_t start_word = 0; start_word < 6; ++start_word) {
+    idx_t start = start_word * BitsPerWord + 3;
+    for (idx_t bit = start + 1; bit < sparse_size; bit += 7) {
+      test_ones.set_bit(bit);
+      test_zeros.clear_bit(bit);
+
+      EXPECT_EQ(bit, test_ones.get_next_one_offset(start));
+      EXPECT_EQ(bit, test_zeros.get_next_zero_offset(start));
+      EXPECT_EQ(bit, test_ones.get_next_one_offset_aligned_right(start, sparse_size));
+      // Bound just before and at the bit
+      EXPECT_EQ(bit, test_ones.get_next_one_offset(start, bit));
+      EXPECT_EQ(bit, test_ones.get_next_one_offset(start, bit + 1));
+      EXPECT_EQ(bit, test_zeros.get_next_zero_offset(start, bit));
+
+      test_ones.clear_bit(bit);
+      test_zeros.set_bit(bit);
+    }
+  }
+  EXPECT_EQ(sparse_size, test_ones.get_next_one_offset(0));
+  EXPECT_EQ(sparse_size, test_zeros.get_next_zero_offset(0));
+}
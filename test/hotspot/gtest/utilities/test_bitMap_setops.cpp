@@ -112,6 +112,25 @@ public:
   }
 };
 
+//////////////////////////////////////////////////////////////////////////////
+// idx_t count_one_bits() const;
+
+TEST(BitMap, count_one_bits) {
+  // Odd word counts too, as the words are counted in pairs.
+  for (idx_t words = 1; words <= 5; ++words) {
+    idx_t bits = words * BitsPerWord;
+    BitMapMemory mx(bits);
+    EXPECT_EQ(0u, mx.make_view(bits, zero_bits).count_one_bits());
+    EXPECT_EQ(bits, mx.make_view(bits, one_bits).count_one_bits());
+    EXPECT_EQ(bits / 2, mx.make_view(bits, even_bits).count_one_bits());
+
+    BitMapView x = mx.make_view(bits, zero_bits);
+    x.set_bit(0);
+    x.set_bit(bits - 1);
+    EXPECT_EQ(2u, x.count_one_bits());
+  }
+}
+
 //////////////////////////////////////////////////////////////////////////////
 // bool is_same(const BitMap& bits);
 
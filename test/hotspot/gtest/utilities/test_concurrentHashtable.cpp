@@ -376,6 +376,35 @@ static void cht_task_grow(Thread* thr) {
   delete cht;
 }
 
+static void cht_bulk_insert_task(Thread* thr) {
+  const size_t num_values = 5000;
+  uintptr_t* values = NEW_C_HEAP_ARRAY(uintptr_t, num_values, mtInternal);
+  for (size_t i = 0; i < num_values; i++) {
+    values[i] = (uintptr_t)(i + 1) * 0x10;
+  }
+  SimpleTestTable* cht = new SimpleTestTable(SIZE_32, 16);
+  uintptr_t val = 0x1;
+  SimpleTestLookup stl(val);
+  EXPECT_TRUE(cht->insert(thr, stl, val)) << "Insert unique value failed.";
+
+  SimpleTestTable::BulkInsertTask bit(cht, values, num_values);
+  EXPECT_TRUE(bit.prepare(thr)) << "Uncontended prepare must work.";
+  EXPECT_TRUE(cht->get_size_log2(thr) > SIZE_32) << "Prepare should have grown the table.";
+  while(bit.do_task(thr)) { /* insert */ }
+  bit.done(thr);
+  EXPECT_EQ(bit.num_inserted(), num_values) << "All values should be inserted.";
+
+  EXPECT_TRUE(cht_get_copy(cht, thr, stl) == val) << "Getting an old value should work.";
+  for (size_t i = 0; i < num_values; i++) {
+    cht_find(thr, cht, values[i]);
+  }
+  SimpleTestLookup dup(values[7]);
+  EXPECT_FALSE(cht->insert(thr, dup, values[7])) << "Insert duplicate value should have failed.";
+
+  delete cht;
+  FREE_C_HEAP_ARRAY(uintptr_t, values);
+}
+
 TEST_VM(ConcurrentHashTable, basic_insert) {
   nomt_test_doer(cht_insert);
 }
@@ -412,6 +441,10 @@ TEST_VM(ConcurrentHashTable, task_grow) {
   nomt_test_doer(cht_task_grow);
 }
 
+TEST_VM(ConcurrentHashTable, task_bulk_insert) {
+  nomt_test_doer(cht_bulk_insert_task);
+}
+
 //#############################################################################################
 
 class TestInterface;
@@ -1029,3 +1062,74 @@ public:
 TEST_VM(ConcurrentHashTable, concurrent_mt_bulk_delete) {
   mt_test_doer<Driver_BD_Thread>();
 }
+
+//#############################################################################################
+
+class MT_BI_Thread : public JavaTestThread {
+  TestTable::BulkInsertTask* _bi;
+  public:
+  MT_BI_Thread(Semaphore* post, TestTable::BulkInsertTask* bi)
+    : JavaTestThread(post), _bi(bi){}
+  virtual ~MT_BI_Thread() {}
+  void main_run() {
+    while(_bi->do_task(this));
+  }
+};
+
+class Driver_BI_Thread : public JavaTestThread {
+public:
+  size_t _found;
+  Driver_BI_Thread(Semaphore* post) : JavaTestThread(post), _found(0) {
+  };
+  virtual ~Driver_BI_Thread(){}
+
+  void main_run() {
+    Semaphore done(0);
+    const uintptr_t num_values = 99999;
+    uintptr_t* values = NEW_C_HEAP_ARRAY(uintptr_t, num_values, mtInternal);
+    for (uintptr_t v = 0; v < num_values; v++) {
+      values[v] = v + 1;
+    }
+    TestTable* cht = new TestTable(8, 18, 2);
+    TestTable::BulkInsertTask bit(cht, values, num_values, true /* mt */ );
+    EXPECT_TRUE(bit.prepare(this)) << "Uncontended prepare must work.";
+
+    MT_BI_Thread* tt[4];
+    for (int i = 0; i < 4; i++) {
+      tt[i] = new MT_BI_Thread(&done, &bit);
+      tt[i]->doit();
+    }
+
+    // Readers are not blocked by the inserts.
+    for (uintptr_t v = 1; v <= num_values; v++) {
+      TestLookup tl(v);
+      cht_get_copy(cht, this, tl);
+    }
+
+    for (int i = 0; i < 4; i++) {
+      done.wait();
+    }
+
+    bit.done(this);
+    EXPECT_EQ(bit.num_inserted(), (size_t)num_values) << "All values should be inserted.";
+
+    for (uintptr_t v = 1; v <= num_values; v++) {
+      TestLookup tl(v);
+      EXPECT_EQ(cht_get_copy(cht, this, tl), v) << "Getting an inserted value should work.";
+    }
+    cht->do_scan(this, *this);
+    EXPECT_EQ(_found, (size_t)num_values) << "Every value should be in the table once.";
+
+    delete cht;
+    FREE_C_HEAP_ARRAY(uintptr_t, values);
+  }
+
+  bool operator()(uintptr_t* val) {
+    _found++;
+    return true;
+  }
+};
+
+TEST_VM(ConcurrentHashTable, concurrent_mt_bulk_insert) {
+  mt_test_doer<Driver_BI_Thread>();
+}
@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+#include "precompiled.hpp"
+#include "unittest.hpp"
+#include "utilities/treap.hpp"
+
+static int compare_int(const int& i1, const int& i2) {
+  return i1 - i2;
+}
+
+typedef Treap<int, int, compare_int, mtTest> IntTreap;
+
+class CheckOrderVisitor {
+ public:
+  int  _last;
+  int  _visited;
+  bool _ordered;
+
+  CheckOrderVisitor() : _last(0), _visited(0), _ordered(true) { }
+
+  bool do_node(IntTreap::Node* node) {
+    if (_visited > 0 && node->key() <= _last) {
+      _ordered = false;
+    }
+    _last = node->key();
+    _visited++;
+    return true;
+  }
+};
+
+TEST(Treap, insert_find_remove) {
+  IntTreap treap;
+  ASSERT_TRUE(treap.is_empty());
+
+  for (int i = 0; i < 1000; i++) {
+    // Insert in a scrambled order
+    int key = (i * 7) % 1000;
+    ASSERT_TRUE(treap.upsert(key, key * 2));
+  }
+  ASSERT_EQ(1000u, treap.count());
+
+  for (int key = 0; key < 1000; key++) {
+    IntTreap::Node* node = treap.find(key);
+    ASSERT_TRUE(node != NULL) << "Key " << key << " should be present";
+    ASSERT_EQ(key * 2, node->value());
+  }
+  ASSERT_TRUE(treap.find(1000) == NULL);
+
+  // Updating an existing key does not add a node
+  ASSERT_TRUE(treap.upsert(5, 42));
+  ASSERT_EQ(1000u, treap.count());
+  ASSERT_EQ(42, treap.find(5)->value());
+
+  for (int key = 0; key < 1000; key += 2) {
+    ASSERT_TRUE(treap.remove(key));
+  }
+  ASSERT_FALSE(treap.remove(0));
+  ASSERT_EQ(500u, treap.count());
+  for (int key = 0; key < 1000; key++) {
+    ASSERT_EQ(key % 2 == 1, treap.find(key) != NULL) << "Key " << key;
+  }
+
+  CheckOrderVisitor visitor;
+  ASSERT_TRUE(treap.visit_in_order(&visitor));
+  ASSERT_TRUE(visitor._ordered);
+  ASSERT_EQ(500, visitor._visited);
+}
+
+TEST(Treap, closest) {
+  IntTreap treap;
+  ASSERT_TRUE(treap.closest_leq(10) == NULL);
+
+  for (int key = 10; key <= 100; key += 10) {
+    ASSERT_TRUE(treap.upsert(key, key));
+  }
+
+  ASSERT_TRUE(treap.closest_leq(9) == NULL);
+  ASSERT_TRUE(treap.closest_lt(10) == NULL);
+  ASSERT_EQ(10, treap.closest_leq(10)->key());
+  ASSERT_EQ(10, treap.closest_lt(11)->key());
+  ASSERT_EQ(50, treap.closest_leq(55)->key());
+  ASSERT_EQ(40, treap.closest_lt(50)->key());
+  ASSERT_EQ(50, treap.closest_leq(50)->key());
+  ASSERT_EQ(100, treap.closest_leq(1000)->key());
+}
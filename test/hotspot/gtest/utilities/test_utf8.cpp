@@ -48,3 +48,39 @@ TEST(utf8, length) {
   UNICODE::as_utf8(str, 19, res, INT_MAX);
   ASSERT_EQ(strlen(res), (size_t) 3 * 19) << "string should end here";
 }
+
+static bool is_legal_utf8(const char* str) {
+  return UTF8::is_legal_utf8((const unsigned char*)str, (int)strlen(str), false);
+}
+
+TEST(utf8, is_legal_utf8) {
+  // Plain ASCII of lengths around the word size
+  ASSERT_TRUE(is_legal_utf8(""));
+  ASSERT_TRUE(is_legal_utf8("java"));
+  ASSERT_TRUE(is_legal_utf8("java/lan"));
+  ASSERT_TRUE(is_legal_utf8("java/lang/Object"));
+  ASSERT_TRUE(is_legal_utf8("Ljava/lang/invoke/MethodHandle;"));
+
+  // Legal two and three byte sequences before, inside and after whole words
+  ASSERT_TRUE(is_legal_utf8("\xc3\xa9java/lang/Object"));
+  ASSERT_TRUE(is_legal_utf8("java/lang\xc3\xa9/Object"));
+  ASSERT_TRUE(is_legal_utf8("java/lang/Object\xe2\x82\xac"));
+  ASSERT_TRUE(is_legal_utf8("java/lang/\xe2\x82\xac/java/lang/Object"));
+
+  // Illegal bytes and truncated sequences anywhere in the string
+  ASSERT_FALSE(is_legal_utf8("java/lang/\x80" "bject"));
+  ASSERT_FALSE(is_legal_utf8("java/lang/Objec\xff"));
+  ASSERT_FALSE(is_legal_utf8("\xc3java/lang/Object"));
+  ASSERT_FALSE(is_legal_utf8("java/lang/Object/java/lang/\xe2\x82"));
+
+  // Embedded zeros are not allowed, including inside a whole ASCII word
+  const unsigned char zero_in_word[] = { 'j', 'a', 'v', 'a', 0, 'l', 'a', 'n', 'g', '/' };
+  ASSERT_FALSE(UTF8::is_legal_utf8(zero_in_word, (int)sizeof(zero_in_word), false));
+  const unsigned char zero_at_end[] = { 'j', 'a', 'v', 'a', '/', 'l', 'a', 'n', 'g', 0 };
+  ASSERT_FALSE(UTF8::is_legal_utf8(zero_at_end, (int)sizeof(zero_at_end), false));
+
+  // Overlong two byte forms are only accepted for old class file versions
+  const unsigned char overlong[] = { 'j', 'a', 'v', 'a', '/', 'l', 'a', 'n', 'g', 0xc1, 0x81 };
+  ASSERT_FALSE(UTF8::is_legal_utf8(overlong, (int)sizeof(overlong), false));
+  ASSERT_TRUE(UTF8::is_legal_utf8(overlong, (int)sizeof(overlong), true));
+}
@@ -0,0 +1,251 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/**
+ * @test
+ * @summary The non-temporal stores of the forward arraycopy stubs must
+ *          copy overlapping, unaligned and odd length ranges correctly.
+ * @requires os.arch == "x86_64" | os.arch == "amd64"
+ *
+ * @run main/othervm -Xbatch -XX:ArrayCopyNonTemporalThreshold=8
+ *      -XX:CompileCommand=exclude,compiler.arraycopy.TestNonTemporalArrayCopy::ref*
+ *      compiler.arraycopy.TestNonTemporalArrayCopy
+ * @run main/othervm -Xbatch -XX:ArrayCopyNonTemporalThreshold=64
+ *      -XX:CompileCommand=exclude,compiler.arraycopy.TestNonTemporalArrayCopy::ref*
+ *      compiler.arraycopy.TestNonTemporalArrayCopy
+ * @run main/othervm -Xbatch -XX:ArrayCopyNonTemporalThreshold=72
+ *      -XX:+UseUnalignedLoadStores
+ *      -XX:CompileCommand=exclude,compiler.arraycopy.TestNonTemporalArrayCopy::ref*
+ *      compiler.arraycopy.TestNonTemporalArrayCopy
+ * @run main/othervm -Xbatch -XX:ArrayCopyNonTemporalThreshold=64
+ *      -XX:-UseUnalignedLoadStores -XX:UseAVX=0
+ *      -XX:CompileCommand=exclude,compiler.arraycopy.TestNonTemporalArrayCopy::ref*
+ *      compiler.arraycopy.TestNonTemporalArrayCopy
+ * @run main/othervm -Xbatch -XX:ArrayCopyNonTemporalThreshold=0
+ *      -XX:CompileCommand=exclude,compiler.arraycopy.TestNonTemporalArrayCopy::ref*
+ *      compiler.arraycopy.TestNonTemporalArrayCopy
+ */
+
+package compiler.arraycopy;
+
+import java.util.Arrays;
+
+public class TestNonTemporalArrayCopy {
+    // Long enough for many 32 byte iterations above the thresholds, with
+    // every tail length of the qword and the element loops.
+    static final int MAX_LEN = 300;
+    static final int MAX_OFFSET = 9;
+    static final int SIZE = MAX_LEN + MAX_OFFSET;
+    static final int WARMUP = 20_000;
+
+    // The copies under test, compiled during the warmup so that they call
+    // the arraycopy stubs.
+    static void copy(byte[] src, int srcPos, byte[] dst, int dstPos, int len) {
+        System.arraycopy(src, srcPos, dst, dstPos, len);
+    }
+
+    static void copy(short[] src, int srcPos, short[] dst, int dstPos, int len) {
+        System.arraycopy(src, srcPos, dst, dstPos, len);
+    }
+
+    static void copy(int[] src, int srcPos, int[] dst, int dstPos, int len) {
+        System.arraycopy(src, srcPos, dst, dstPos, len);
+    }
+
+    static void copy(long[] src, int srcPos, long[] dst, int dstPos, int len) {
+        System.arraycopy(src, srcPos, dst, dstPos, len);
+    }
+
+    static void copy(Object[] src, int srcPos, Object[] dst, int dstPos, int len) {
+        System.arraycopy(src, srcPos, dst, dstPos, len);
+    }
+
+    // Reference copies, run in the interpreter only. They read from a
+    // snapshot of the source, which gives the System.arraycopy result for
+    // overlapping ranges too.
+    static void refCopy(byte[] src, int srcPos, byte[] dst, int dstPos, int len) {
+        byte[] snapshot = new byte[len];
+        for (int i = 0; i < len; i++) snapshot[i] = src[srcPos + i];
+        for (int i = 0; i < len; i++) dst[dstPos + i] = snapshot[i];
+    }
+
+    static void refCopy(short[] src, int srcPos, short[] dst, int dstPos, int len) {
+        short[] snapshot = new short[len];
+        for (int i = 0; i < len; i++) snapshot[i] = src[srcPos + i];
+        for (int i = 0; i < len; i++) dst[dstPos + i] = snapshot[i];
+    }
+
+    static void refCopy(int[] src, int srcPos, int[] dst, int dstPos, int len) {
+        int[] snapshot = new int[len];
+        for (int i = 0; i < len; i++) snapshot[i] = src[srcPos + i];
+        for (int i = 0; i < len; i++) dst[dstPos + i] = snapshot[i];
+    }
+
+    static void refCopy(long[] src, int srcPos, long[] dst, int dstPos, int len) {
+        long[] snapshot = new long[len];
+        for (int i = 0; i < len; i++) snapshot[i] = src[srcPos + i];
+        for (int i = 0; i < len; i++) dst[dstPos + i] = snapshot[i];
+    }
+
+    static void refCopy(Object[] src, int srcPos, Object[] dst, int dstPos, int len) {
+        Object[] snapshot = new Object[len];
+        for (int i = 0; i < len; i++) snapshot[i] = src[srcPos + i];
+        for (int i = 0; i < len; i++) dst[dstPos + i] = snapshot[i];
+    }
+
+    static void check(boolean equal, String type, String kind, int srcPos, int dstPos, int len) {
+        if (!equal) {
+            throw new RuntimeException(type + " " + kind + " copy of " + len + " elements from " +
+                                       srcPos + " to " + dstPos + " is wrong");
+        }
+    }
+
+    // Copies between two arrays and within one array. The conjoint stubs
+    // copy forward when the destination is below the source.
+    static void testBytes(byte[] src, int srcPos, int dstPos, int len) {
+        byte[] dst = new byte[SIZE];
+        byte[] exp = new byte[SIZE];
+        copy(src, srcPos, dst, dstPos, len);
+        refCopy(src, srcPos, exp, dstPos, len);
+        check(Arrays.equals(dst, exp), "byte", "disjoint", srcPos, dstPos, len);
+
+        dst = src.clone();
+        exp = src.clone();
+        copy(dst, srcPos, dst, dstPos, len);
+        refCopy(exp, srcPos, exp, dstPos, len);
+        check(Arrays.equals(dst, exp), "byte", "overlapping", srcPos, dstPos, len);
+    }
+
+    static void testShorts(short[] src, int srcPos, int dstPos, int len) {
+        short[] dst = new short[SIZE];
+        short[] exp = new short[SIZE];
+        copy(src, srcPos, dst, dstPos, len);
+        refCopy(src, srcPos, exp, dstPos, len);
+        check(Arrays.equals(dst, exp), "short", "disjoint", srcPos, dstPos, len);
+
+        dst = src.clone();
+        exp = src.clone();
+        copy(dst, srcPos, dst, dstPos, len);
+        refCopy(exp, srcPos, exp, dstPos, len);
+        check(Arrays.equals(dst, exp), "short", "overlapping", srcPos, dstPos, len);
+    }
+
+    static void testInts(int[] src, int srcPos, int dstPos, int len) {
+        int[] dst = new int[SIZE];
+        int[] exp = new int[SIZE];
+        copy(src, srcPos, dst, dstPos, len);
+        refCopy(src, srcPos, exp, dstPos, len);
+        check(Arrays.equals(dst, exp), "int", "disjoint", srcPos, dstPos, len);
+
+        dst = src.clone();
+        exp = src.clone();
+        copy(dst, srcPos, dst, dstPos, len);
+        refCopy(exp, srcPos, exp, dstPos, len);
+        check(Arrays.equals(dst, exp), "int", "overlapping", srcPos, dstPos, len);
+    }
+
+    static void testLongs(long[] src, int srcPos, int dstPos, int len) {
+        long[] dst = new long[SIZE];
+        long[] exp = new long[SIZE];
+        copy(src, srcPos, dst, dstPos, len);
+        refCopy(src, srcPos, exp, dstPos, len);
+        check(Arrays.equals(dst, exp), "long", "disjoint", srcPos, dstPos, len);
+
+        dst = src.clone();
+        exp = src.clone();
+        copy(dst, srcPos, dst, dstPos, len);
+        refCopy(exp, srcPos, exp, dstPos, len);
+        check(Arrays.equals(dst, exp), "long", "overlapping", srcPos, dstPos, len);
+    }
+
+    // Arrays.equals(Object[], Object[]) would compare the values
+    static boolean sameRefs(Object[] a, Object[] b) {
+        for (int i = 0; i < a.length; i++) {
+            if (a[i] != b[i]) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    static void testObjects(Object[] src, int srcPos, int dstPos, int len) {
+        Object[] dst = new Object[SIZE];
+        Object[] exp = new Object[SIZE];
+        copy(src, srcPos, dst, dstPos, len);
+        refCopy(src, srcPos, exp, dstPos, len);
+        check(sameRefs(dst, exp), "Object", "disjoint", srcPos, dstPos, len);
+
+        dst = src.clone();
+        exp = src.clone();
+        copy(dst, srcPos, dst, dstPos, len);
+        refCopy(exp, srcPos, exp, dstPos, len);
+        check(sameRefs(dst, exp), "Object", "overlapping", srcPos, dstPos, len);
+    }
+
+    public static void main(String[] args) {
+        byte[] bytes = new byte[SIZE];
+        short[] shorts = new short[SIZE];
+        int[] ints = new int[SIZE];
+        long[] longs = new long[SIZE];
+        Object[] objects = new Object[SIZE];
+        for (int i = 0; i < SIZE; i++) {
+            bytes[i] = (byte) (i * 7 + 1);
+            shorts[i] = (short) (i * 7 + 1);
+            ints[i] = i * 7 + 1;
+            longs[i] = i * 0x9E3779B97F4A7C15L;
+            objects[i] = new Object();
+        }
+
+        byte[] scratch = new byte[SIZE];
+        for (int i = 0; i < WARMUP; i++) {
+            copy(bytes, 1, scratch, 0, 16);
+            copy(shorts, 1, new short[16], 0, 16);
+            copy(ints, 1, new int[16], 0, 16);
+            copy(longs, 1, new long[16], 0, 16);
+            copy(objects, 1, new Object[16], 0, 16);
+        }
+
+        for (int len = 0; len <= MAX_LEN; len++) {
+            for (int srcPos = 0; srcPos < MAX_OFFSET; srcPos++) {
+                for (int dstPos = 0; dstPos < MAX_OFFSET; dstPos++) {
+                    testBytes(bytes, srcPos, dstPos, len);
+                    testShorts(shorts, srcPos, dstPos, len);
+                    testInts(ints, srcPos, dstPos, len);
+                    testLongs(longs, srcPos, dstPos, len);
+                    testObjects(objects, srcPos, dstPos, len);
+                }
+            }
+        }
+
+        // Above the default threshold of 8M as well
+        byte[] src = new byte[(16 << 20) + 13];
+        for (int i = 0; i < src.length; i++) src[i] = (byte) (i * 7 + 1);
+        byte[] dst = new byte[src.length];
+        copy(src, 5, dst, 3, src.length - 10);
+        for (int i = 0; i < src.length - 10; i++) {
+            if (dst[3 + i] != src[5 + i]) {
+                throw new RuntimeException("Large byte copy is wrong at " + i);
+            }
+        }
+    }
+}
@@ -0,0 +1,144 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/**
+ * @test
+ * @summary Methods with cold uncommon trap and exception paths must compute
+ *          the same results when the cold traces are moved to the end of
+ *          the block layout.
+ * @requires vm.compiler2.enabled
+ *
+ * @run main/othervm -Xbatch -XX:-TieredCompilation
+ *      -XX:+UnlockDiagnosticVMOptions -XX:+BlockLayoutSplitColdCode
+ *      -XX:CompileCommand=dontinline,compiler.codegen.TestBlockLayoutSplitColdCode::test*
+ *      compiler.codegen.TestBlockLayoutSplitColdCode
+ * @run main/othervm -Xbatch -XX:-TieredCompilation
+ *      -XX:+UnlockDiagnosticVMOptions -XX:+BlockLayoutSplitColdCode
+ *      -XX:-BlockLayoutByFrequency
+ *      compiler.codegen.TestBlockLayoutSplitColdCode
+ * @run main/othervm -Xbatch -XX:-TieredCompilation
+ *      -XX:+UnlockDiagnosticVMOptions -XX:+BlockLayoutSplitColdCode
+ *      -XX:-BlockLayoutRotateLoops
+ *      compiler.codegen.TestBlockLayoutSplitColdCode
+ */
+
+package compiler.codegen;
+
+public class TestBlockLayoutSplitColdCode {
+    static volatile boolean cold;
+    static int[] array = new int[16];
+
+    // Cold branches in the middle of a hot loop.
+    static int testLoop(int n) {
+        int sum = 0;
+        for (int i = 0; i < n; i++) {
+            if (cold) {
+                sum -= i * 3;
+            } else {
+                sum += i;
+            }
+            if (i == Integer.MAX_VALUE - 1) {
+                sum ^= 0x5a5a;
+            }
+        }
+        return sum;
+    }
+
+    // Cold exception paths, caught and uncaught.
+    static int testException(int i) {
+        try {
+            return array[i] + i;
+        } catch (ArrayIndexOutOfBoundsException e) {
+            return -i;
+        }
+    }
+
+    static int testThrow(int i) {
+        if (i < 0) {
+            throw new IllegalArgumentException("negative " + i);
+        }
+        return i * 2;
+    }
+
+    // A switch whose rarely taken cases become cold traces.
+    static int testSwitch(int i) {
+        switch (i & 7) {
+            case 0:  return i + 1;
+            case 1:  return i - 1;
+            case 7:  return cold ? i * 7 : i * 5;
+            default: return i;
+        }
+    }
+
+    static int expectedLoop(int n, boolean c) {
+        int sum = 0;
+        for (int i = 0; i < n; i++) {
+            sum += c ? -i * 3 : i;
+        }
+        return sum;
+    }
+
+    static int expectedSwitch(int i, boolean c) {
+        switch (i & 7) {
+            case 0:  return i + 1;
+            case 1:  return i - 1;
+            case 7:  return c ? i * 7 : i * 5;
+            default: return i;
+        }
+    }
+
+    static void check(String name, int x, int res, int expected) {
+        if (res != expected) {
+            throw new RuntimeException(name + "(" + x + ") = " + res + ", expected " + expected);
+        }
+    }
+
+    static void run(int iterations) {
+        for (int i = 0; i < iterations; i++) {
+            int x = i % 100;
+            check("testLoop", x, testLoop(x), expectedLoop(x, cold));
+            check("testException", x & 15, testException(x & 15), x & 15);
+            check("testThrow", x, testThrow(x), x * 2);
+            check("testSwitch", x, testSwitch(x), expectedSwitch(x, cold));
+        }
+    }
+
+    public static void main(String[] args) {
+        run(20_000);
+
+        // Take the cold paths from compiled code.
+        cold = true;
+        run(100);
+        for (int x = 16; x < 100; x++) {
+            check("testException", x, testException(x), -x);
+        }
+        for (int x = 1; x < 100; x++) {
+            try {
+                testThrow(-x);
+                throw new RuntimeException("testThrow(" + -x + ") did not throw");
+            } catch (IllegalArgumentException e) {
+                // expected
+            }
+        }
+    }
+}
@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/**
+ * @test
+ * @summary Subclass fields placed in the gap at the end of the superclass
+ *          fields must be seen by the compiler, with and without EA.
+ * @requires vm.compiler2.enabled
+ *
+ * @run main/othervm -Xcomp -XX:-TieredCompilation -XX:+DoEscapeAnalysis
+ *      -XX:CompileCommand=compileonly,compiler.escapeAnalysis.TestFieldsInSuperclassGap::test*
+ *      compiler.escapeAnalysis.TestFieldsInSuperclassGap
+ * @run main/othervm -Xcomp -XX:-TieredCompilation -XX:-DoEscapeAnalysis
+ *      -XX:CompileCommand=compileonly,compiler.escapeAnalysis.TestFieldsInSuperclassGap::test*
+ *      compiler.escapeAnalysis.TestFieldsInSuperclassGap
+ * @run main/othervm -Xbatch -XX:-TieredCompilation -XX:+DoEscapeAnalysis
+ *      -XX:-UseCompressedOops -XX:-UseCompressedClassPointers
+ *      compiler.escapeAnalysis.TestFieldsInSuperclassGap
+ */
+
+package compiler.escapeAnalysis;
+
+public class TestFieldsInSuperclassGap {
+    static class Super {
+        byte a;
+    }
+
+    // All fields fit in the gap after Super.a, so Sub has the same
+    // nonstatic field size as Super.
+    static class Sub extends Super {
+        short s;
+        byte b;
+    }
+
+    static Sub escaped;
+    static volatile boolean deopt;
+
+    // Scalar replaced allocation.
+    static int testScalarReplaced(int x) {
+        Sub o = new Sub();
+        o.a = (byte)x;
+        o.s = (short)(x + 1);
+        o.b = (byte)(x + 2);
+        return o.a + o.s + o.b;
+    }
+
+    // Scalar replaced allocation that is reallocated on deoptimization.
+    static int testRealloc(int x) {
+        Sub o = new Sub();
+        o.a = (byte)x;
+        o.s = (short)(x + 1);
+        o.b = (byte)(x + 2);
+        if (deopt) {
+            escaped = o;
+        }
+        return o.a + o.s + o.b;
+    }
+
+    // Escaping allocation, fields read back through memory.
+    static int testEscaped(int x) {
+        Sub o = new Sub();
+        o.a = (byte)x;
+        o.s = (short)(x + 1);
+        o.b = (byte)(x + 2);
+        escaped = o;
+        Super sup = escaped;
+        Sub sub = escaped;
+        return sup.a + sub.s + sub.b;
+    }
+
+    static int expected(int x) {
+        return (byte)x + (short)(x + 1) + (byte)(x + 2);
+    }
+
+    static void check(String name, int x, int res) {
+        if (res != expected(x)) {
+            throw new RuntimeException(name + "(" + x + ") = " + res + ", expected " + expected(x));
+        }
+    }
+
+    public static void main(String[] args) {
+        for (int i = 0; i < 20_000; i++) {
+            int x = i % 100;
+            check("testScalarReplaced", x, testScalarReplaced(x));
+            check("testRealloc", x, testRealloc(x));
+            check("testEscaped", x, testEscaped(x));
+        }
+        deopt = true;
+        for (int x = 0; x < 100; x++) {
+            check("testRealloc", x, testRealloc(x));
+            Sub o = escaped;
+            if (o.a != (byte)x || o.s != (short)(x + 1) || o.b != (byte)(x + 2)) {
+                throw new RuntimeException("reallocated object has wrong fields for " + x);
+            }
+        }
+    }
+}
@@ -0,0 +1,133 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/**
+ * @test
+ * @summary Field loads split through Phis that merge new allocations must
+ *          read the fields of the allocation taken on each path.
+ * @requires vm.compiler2.enabled
+ *
+ * @run main/othervm -Xbatch -XX:-TieredCompilation
+ *      -XX:+UnlockDiagnosticVMOptions -XX:+ReduceAllocationMerges
+ *      -XX:CompileCommand=dontinline,compiler.escapeAnalysis.TestReduceAllocationMerges::test*
+ *      compiler.escapeAnalysis.TestReduceAllocationMerges
+ * @run main/othervm -Xbatch -XX:-TieredCompilation
+ *      -XX:+UnlockDiagnosticVMOptions -XX:+ReduceAllocationMerges
+ *      -XX:-EliminateAllocations
+ *      compiler.escapeAnalysis.TestReduceAllocationMerges
+ * @run main/othervm -Xcomp -XX:-TieredCompilation
+ *      -XX:+UnlockDiagnosticVMOptions -XX:+ReduceAllocationMerges
+ *      -XX:CompileCommand=compileonly,compiler.escapeAnalysis.TestReduceAllocationMerges::test*
+ *      compiler.escapeAnalysis.TestReduceAllocationMerges
+ */
+
+package compiler.escapeAnalysis;
+
+public class TestReduceAllocationMerges {
+    static class Point {
+        int x;
+        int y;
+
+        Point(int x, int y) {
+            this.x = x;
+            this.y = y;
+        }
+    }
+
+    static Point escaped;
+    static volatile boolean deopt;
+
+    // The merge is only used by field loads.
+    static int testLoadsOnly(boolean cond, int a, int b) {
+        Point p = cond ? new Point(a, b) : new Point(b, a);
+        return p.x * 31 + p.y;
+    }
+
+    // A merge of three allocations.
+    static int testThreeWay(int sel, int a) {
+        Point p;
+        if (sel == 0) {
+            p = new Point(a, 1);
+        } else if (sel == 1) {
+            p = new Point(2, a);
+        } else {
+            p = new Point(a, a);
+        }
+        return p.x - p.y;
+    }
+
+    // The merge also escapes on a rarely taken path.
+    static int testEscapes(boolean cond, int a, int b) {
+        Point p = cond ? new Point(a, b) : new Point(b, a);
+        if (deopt) {
+            escaped = p;
+        }
+        return p.x * 31 + p.y;
+    }
+
+    // The merge is stored to, which must be seen by the later load.
+    static int testStore(boolean cond, int a, int b) {
+        Point p = cond ? new Point(a, b) : new Point(b, a);
+        p.x = a + b;
+        return p.x * 31 + p.y;
+    }
+
+    static int expectedLoadsOnly(boolean cond, int a, int b) {
+        return cond ? a * 31 + b : b * 31 + a;
+    }
+
+    static int expectedThreeWay(int sel, int a) {
+        return sel == 0 ? a - 1 : (sel == 1 ? 2 - a : 0);
+    }
+
+    static int expectedStore(boolean cond, int a, int b) {
+        return (a + b) * 31 + (cond ? b : a);
+    }
+
+    static void check(String name, int x, int res, int expected) {
+        if (res != expected) {
+            throw new RuntimeException(name + "(" + x + ") = " + res + ", expected " + expected);
+        }
+    }
+
+    public static void main(String[] args) {
+        for (int i = 0; i < 20_000; i++) {
+            boolean cond = (i & 1) == 0;
+            int a = i % 100;
+            int b = i % 7;
+            check("testLoadsOnly", i, testLoadsOnly(cond, a, b), expectedLoadsOnly(cond, a, b));
+            check("testThreeWay", i, testThreeWay(i % 3, a), expectedThreeWay(i % 3, a));
+            check("testEscapes", i, testEscapes(cond, a, b), expectedLoadsOnly(cond, a, b));
+            check("testStore", i, testStore(cond, a, b), expectedStore(cond, a, b));
+        }
+        deopt = true;
+        for (int i = 0; i < 100; i++) {
+            boolean cond = (i & 1) == 0;
+            check("testEscapes", i, testEscapes(cond, i, 3), expectedLoadsOnly(cond, i, 3));
+            Point p = escaped;
+            if (p.x != (cond ? i : 3) || p.y != (cond ? 3 : i)) {
+                throw new RuntimeException("escaped point has wrong fields for " + i);
+            }
+        }
+    }
+}
@@ -0,0 +1,129 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/**
+ * @test
+ * @summary java.util.zip.Adler32 must match a reference implementation for
+ *          all buffer alignments and lengths, with and without the intrinsic.
+ * @requires os.arch == "amd64" | os.arch == "x86_64" | os.arch == "aarch64"
+ *
+ * @run main/othervm -Xbatch -XX:-TieredCompilation
+ *      -XX:+UnlockDiagnosticVMOptions -XX:+UseAdler32Intrinsics
+ *      compiler.intrinsics.zip.TestAdler32
+ * @run main/othervm -Xbatch -XX:-TieredCompilation
+ *      -XX:+UnlockDiagnosticVMOptions -XX:-UseAdler32Intrinsics
+ *      compiler.intrinsics.zip.TestAdler32
+ * @run main/othervm -Xint compiler.intrinsics.zip.TestAdler32
+ */
+
+package compiler.intrinsics.zip;
+
+import java.nio.ByteBuffer;
+import java.util.Arrays;
+import java.util.Random;
+import java.util.zip.Adler32;
+
+public class TestAdler32 {
+    static final int BASE = 65521;
+    // Covers the 16 byte blocks, the 5552 byte reduction chunks and the tails.
+    static final int[] LENGTHS = { 0, 1, 2, 15, 16, 17, 31, 32, 33, 63, 64, 65,
+                                   255, 256, 257, 5551, 5552, 5553, 5568,
+                                   11104, 11105, 65536, 100_000 };
+    // Covers every alignment of the buffer start to the 16 byte blocks.
+    static final int OFFSETS = 17;
+
+    static long reference(long adler, byte[] b, int off, int len) {
+        long s1 = adler & 0xffff;
+        long s2 = adler >>> 16;
+        for (int i = off; i < off + len; i++) {
+            s1 = (s1 + (b[i] & 0xff)) % BASE;
+            s2 = (s2 + s1) % BASE;
+        }
+        return (s2 << 16) | s1;
+    }
+
+    static void check(String what, int off, int len, long got, long expected) {
+        if (got != expected) {
+            throw new RuntimeException(what + " off=" + off + " len=" + len +
+                                       ": got " + Long.toHexString(got) +
+                                       ", expected " + Long.toHexString(expected));
+        }
+    }
+
+    static long[][] expected(byte[] data) {
+        long[][] result = new long[LENGTHS.length][OFFSETS];
+        for (int l = 0; l < LENGTHS.length; l++) {
+            for (int off = 0; off < OFFSETS; off++) {
+                result[l][off] = reference(1, data, off, LENGTHS[l]);
+            }
+        }
+        return result;
+    }
+
+    static void test(byte[] data, long[][] expectedValues, ByteBuffer direct) {
+        for (int l = 0; l < LENGTHS.length; l++) {
+            int len = LENGTHS[l];
+            for (int off = 0; off < OFFSETS; off++) {
+                long expected = expectedValues[l][off];
+
+                Adler32 a = new Adler32();
+                a.update(data, off, len);
+                check("array", off, len, a.getValue(), expected);
+
+                Adler32 d = new Adler32();
+                direct.clear().position(off).limit(off + len);
+                d.update(direct);
+                check("direct buffer", off, len, d.getValue(), expected);
+
+                // Continue from a non-initial value, split at an odd point.
+                Adler32 s = new Adler32();
+                int first = len / 3;
+                s.update(data, off, first);
+                s.update(data, off + first, len - first);
+                check("split", off, len, s.getValue(), expected);
+            }
+        }
+    }
+
+    public static void main(String[] args) {
+        int max = LENGTHS[LENGTHS.length - 1] + OFFSETS;
+        byte[] random = new byte[max];
+        new Random(42).nextBytes(random);
+        // All bytes 0xff give the largest sums and would show lane overflows.
+        byte[] ones = new byte[max];
+        Arrays.fill(ones, (byte)0xff);
+
+        long[][] expectedRandom = expected(random);
+        long[][] expectedOnes = expected(ones);
+
+        ByteBuffer direct = ByteBuffer.allocateDirect(max);
+        for (int iter = 0; iter < 20; iter++) {
+            direct.clear();
+            direct.put(random);
+            test(random, expectedRandom, direct);
+            direct.clear();
+            direct.put(ones);
+            test(ones, expectedOnes, direct);
+        }
+    }
+}
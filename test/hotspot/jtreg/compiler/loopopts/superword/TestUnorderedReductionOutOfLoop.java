@@ -0,0 +1,182 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/**
+ * @test
+ * @summary Integral add and mul reductions moved out of vectorized loops
+ *          must compute the same results as the interpreter.
+ * @requires vm.compiler2.enabled
+ *
+ * @run main/othervm -Xbatch -XX:-TieredCompilation
+ *      -XX:+UnlockDiagnosticVMOptions -XX:+SuperWordReductionsOutOfLoop
+ *      -XX:CompileCommand=exclude,compiler.loopopts.superword.TestUnorderedReductionOutOfLoop::ref*
+ *      compiler.loopopts.superword.TestUnorderedReductionOutOfLoop
+ * @run main/othervm -Xbatch -XX:-TieredCompilation
+ *      -XX:+UnlockDiagnosticVMOptions -XX:+SuperWordReductionsOutOfLoop
+ *      -XX:LoopUnrollLimit=250 -XX:LoopMaxUnroll=16
+ *      -XX:CompileCommand=exclude,compiler.loopopts.superword.TestUnorderedReductionOutOfLoop::ref*
+ *      compiler.loopopts.superword.TestUnorderedReductionOutOfLoop
+ * @run main/othervm -Xbatch -XX:-TieredCompilation
+ *      -XX:+UnlockDiagnosticVMOptions -XX:-SuperWordReductionsOutOfLoop
+ *      -XX:CompileCommand=exclude,compiler.loopopts.superword.TestUnorderedReductionOutOfLoop::ref*
+ *      compiler.loopopts.superword.TestUnorderedReductionOutOfLoop
+ */
+
+package compiler.loopopts.superword;
+
+import java.util.Random;
+
+public class TestUnorderedReductionOutOfLoop {
+    // The test* methods are compiled; the ref* methods are excluded from
+    // compilation and always run in the interpreter.
+
+    static int testAddI(int[] a, int[] b, int init) {
+        int sum = init;
+        for (int i = 0; i < a.length; i++) {
+            sum += a[i] * b[i];
+        }
+        return sum * 31 + a.length;  // the reduction is used after the loop
+    }
+
+    static int refAddI(int[] a, int[] b, int init) {
+        int sum = init;
+        for (int i = 0; i < a.length; i++) {
+            sum += a[i] * b[i];
+        }
+        return sum * 31 + a.length;
+    }
+
+    static int testMulI(int[] a, int init) {
+        int prod = init;
+        for (int i = 0; i < a.length; i++) {
+            prod *= a[i];
+        }
+        return prod ^ 0x5555;
+    }
+
+    static int refMulI(int[] a, int init) {
+        int prod = init;
+        for (int i = 0; i < a.length; i++) {
+            prod *= a[i];
+        }
+        return prod ^ 0x5555;
+    }
+
+    static long testAddL(long[] a, long[] b, long init) {
+        long sum = init;
+        for (int i = 0; i < a.length; i++) {
+            sum += a[i] + b[i];
+        }
+        return sum * 31 + a.length;
+    }
+
+    static long refAddL(long[] a, long[] b, long init) {
+        long sum = init;
+        for (int i = 0; i < a.length; i++) {
+            sum += a[i] + b[i];
+        }
+        return sum * 31 + a.length;
+    }
+
+    static long testMulL(long[] a, long init) {
+        long prod = init;
+        for (int i = 0; i < a.length; i++) {
+            prod *= a[i];
+        }
+        return prod ^ 0x5555L;
+    }
+
+    static long refMulL(long[] a, long init) {
+        long prod = init;
+        for (int i = 0; i < a.length; i++) {
+            prod *= a[i];
+        }
+        return prod ^ 0x5555L;
+    }
+
+    // Two reductions in the same loop, both used after it.
+    static int testTwoI(int[] a) {
+        int sum = 0;
+        int prod = 1;
+        for (int i = 0; i < a.length; i++) {
+            sum += a[i];
+            prod *= a[i];
+        }
+        return sum - prod;
+    }
+
+    static int refTwoI(int[] a) {
+        int sum = 0;
+        int prod = 1;
+        for (int i = 0; i < a.length; i++) {
+            sum += a[i];
+            prod *= a[i];
+        }
+        return sum - prod;
+    }
+
+    static void check(String what, int len, long expected, long actual) {
+        if (expected != actual) {
+            throw new RuntimeException(what + " length " + len + ": expected " +
+                                       expected + " but got " + actual);
+        }
+    }
+
+    public static void main(String[] args) {
+        Random r = new Random(42);
+        // Lengths around and between the vector and unroll sizes exercise
+        // the pre, main and post loops.
+        int[] lengths = { 0, 1, 3, 7, 8, 15, 16, 17, 31, 63, 64, 65, 127, 1000, 1023 };
+        for (int iter = 0; iter < 20_000; iter++) {
+            int len = lengths[iter % lengths.length];
+            int[] ia = new int[len];
+            int[] ib = new int[len];
+            long[] la = new long[len];
+            long[] lb = new long[len];
+            for (int i = 0; i < len; i++) {
+                ia[i] = r.nextInt();
+                ib[i] = r.nextInt();
+                la[i] = r.nextLong();
+                lb[i] = r.nextLong();
+            }
+            // Products of random values quickly become 0, so also use
+            // small odd factors to keep the products interesting.
+            int[] im = new int[len];
+            long[] lm = new long[len];
+            for (int i = 0; i < len; i++) {
+                im[i] = 2 * r.nextInt(8) + 1;
+                lm[i] = 2 * r.nextInt(8) + 1;
+            }
+            int iinit = r.nextInt();
+            long linit = r.nextLong();
+
+            check("addI", len, refAddI(ia, ib, iinit), testAddI(ia, ib, iinit));
+            check("mulI", len, refMulI(im, iinit), testMulI(im, iinit));
+            check("mulI random", len, refMulI(ia, iinit), testMulI(ia, iinit));
+            check("addL", len, refAddL(la, lb, linit), testAddL(la, lb, linit));
+            check("mulL", len, refMulL(lm, linit), testMulL(lm, linit));
+            check("mulL random", len, refMulL(la, linit), testMulL(la, linit));
+            check("twoI", len, refTwoI(im), testTwoI(im));
+        }
+    }
+}
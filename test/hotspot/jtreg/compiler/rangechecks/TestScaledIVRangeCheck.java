@@ -0,0 +1,182 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/**
+ * @test
+ * @summary Range check elimination and loop predication must keep the
+ *          bounds checks of scaled, shifted and offset induction variable
+ *          indices, including when the index expression overflows.
+ * @requires vm.compiler2.enabled
+ *
+ * @run main/othervm -Xbatch -XX:-TieredCompilation
+ *      -XX:CompileCommand=exclude,compiler.rangechecks.TestScaledIVRangeCheck::ref*
+ *      compiler.rangechecks.TestScaledIVRangeCheck
+ * @run main/othervm -Xbatch -XX:-TieredCompilation -XX:-UseLoopPredicate
+ *      -XX:CompileCommand=exclude,compiler.rangechecks.TestScaledIVRangeCheck::ref*
+ *      compiler.rangechecks.TestScaledIVRangeCheck
+ * @run main/othervm -Xbatch -XX:-TieredCompilation -XX:-RangeCheckElimination
+ *      -XX:CompileCommand=exclude,compiler.rangechecks.TestScaledIVRangeCheck::ref*
+ *      compiler.rangechecks.TestScaledIVRangeCheck
+ */
+
+package compiler.rangechecks;
+
+import java.util.Arrays;
+import java.util.Random;
+
+public class TestScaledIVRangeCheck {
+    // The test* methods are compiled; the ref* methods are excluded from
+    // compilation, so they always run in the interpreter. Each method
+    // stores the iteration number, so the stores done before an
+    // exception can be compared as well.
+
+    // (j + off) * k
+    static void testMul(int[] a, int from, int to, int off) {
+        for (int j = from; j < to; j++) {
+            a[(j + off) * 3] = j;
+        }
+    }
+
+    static void refMul(int[] a, int from, int to, int off) {
+        for (int j = from; j < to; j++) {
+            a[(j + off) * 3] = j;
+        }
+    }
+
+    // (j + off) << s
+    static void testShift(int[] a, int from, int to, int off) {
+        for (int j = from; j < to; j++) {
+            a[(j + off) << 2] = j;
+        }
+    }
+
+    static void refShift(int[] a, int from, int to, int off) {
+        for (int j = from; j < to; j++) {
+            a[(j + off) << 2] = j;
+        }
+    }
+
+    // j + inv - k
+    static void testSub(int[] a, int from, int to, int inv) {
+        for (int j = from; j < to; j++) {
+            a[j + inv - 5] = j;
+        }
+    }
+
+    static void refSub(int[] a, int from, int to, int inv) {
+        for (int j = from; j < to; j++) {
+            a[j + inv - 5] = j;
+        }
+    }
+
+    // (2 * j + off) * k, a scaled iv inside the scaled expression
+    static void testMul2(int[] a, int from, int to, int off) {
+        for (int j = from; j < to; j++) {
+            a[(2 * j + off) * 3] = j;
+        }
+    }
+
+    static void refMul2(int[] a, int from, int to, int off) {
+        for (int j = from; j < to; j++) {
+            a[(2 * j + off) * 3] = j;
+        }
+    }
+
+    interface Kernel {
+        void run(int[] a, int from, int to, int off);
+    }
+
+    static final int LENGTH = 1000;
+
+    static boolean run(Kernel k, int[] a, int from, int to, int off) {
+        try {
+            k.run(a, from, to, off);
+            return false;
+        } catch (ArrayIndexOutOfBoundsException e) {
+            return true;
+        }
+    }
+
+    static void check(String what, Kernel test, Kernel ref, int from, int to, int off) {
+        int[] expected = new int[LENGTH];
+        int[] actual = new int[LENGTH];
+        boolean expectedThrow = run(ref, expected, from, to, off);
+        boolean actualThrow = run(test, actual, from, to, off);
+        if (expectedThrow != actualThrow) {
+            throw new RuntimeException(what + "(" + from + ", " + to + ", " + off + "): " +
+                                       (expectedThrow ? "expected" : "unexpected") +
+                                       " ArrayIndexOutOfBoundsException");
+        }
+        if (!Arrays.equals(expected, actual)) {
+            throw new RuntimeException(what + "(" + from + ", " + to + ", " + off +
+                                       "): wrong array contents");
+        }
+    }
+
+    static void checkAll(int from, int to, int off) {
+        check("mul", TestScaledIVRangeCheck::testMul, TestScaledIVRangeCheck::refMul, from, to, off);
+        check("shift", TestScaledIVRangeCheck::testShift, TestScaledIVRangeCheck::refShift, from, to, off);
+        check("sub", TestScaledIVRangeCheck::testSub, TestScaledIVRangeCheck::refSub, from, to, off);
+        check("mul2", TestScaledIVRangeCheck::testMul2, TestScaledIVRangeCheck::refMul2, from, to, off);
+    }
+
+    public static void main(String[] args) {
+        // Warm up with in-bounds indices, so the range checks get hoisted.
+        for (int i = 0; i < 20_000; i++) {
+            checkAll(0, 80, 10 + (i % 20));
+        }
+
+        // Out of bounds above and below the array.
+        checkAll(0, 400, 10);
+        checkAll(0, 80, 300);
+        checkAll(0, 80, -1);
+        checkAll(-20, 80, 10);
+        checkAll(0, 80, 4);
+
+        // The index overflows: it wraps to negative values, or wraps
+        // around into the array, part way through the loop.
+        checkAll(0, 80, Integer.MAX_VALUE / 3 - 40);
+        checkAll(0, 80, Integer.MAX_VALUE / 4 - 40);
+        checkAll(0, 80, Integer.MAX_VALUE / 6 - 40);
+        checkAll(0, 80, Integer.MAX_VALUE - 40);
+        checkAll(0, 80, Integer.MIN_VALUE + 2);
+        checkAll(0, 80, (int) (0x1_0000_0000L / 3) - 20);
+        checkAll(0, 80, (1 << 30) - 20);
+        checkAll(Integer.MAX_VALUE - 100, Integer.MAX_VALUE, 0);
+        checkAll(Integer.MIN_VALUE, Integer.MIN_VALUE + 100, 0);
+
+        // Random bounds and offsets, biased towards the array bounds.
+        Random r = new Random(123);
+        for (int i = 0; i < 20_000; i++) {
+            int from = r.nextInt(200) - 100;
+            int to = from + r.nextInt(400);
+            int off;
+            switch (r.nextInt(3)) {
+                case 0:  off = r.nextInt(700) - 200; break;
+                case 1:  off = Integer.MAX_VALUE / (2 + r.nextInt(5)) - r.nextInt(400); break;
+                default: off = r.nextInt(); break;
+            }
+            checkAll(from, to, off);
+        }
+    }
+}
@@ -0,0 +1,139 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/**
+ * @test
+ * @summary Loading a class that invalidates compiled code must deoptimize
+ *          frames that hold biased locks without losing the locks, with
+ *          and without handshake based deoptimization.
+ * @requires vm.compMode != "Xint"
+ *
+ * @run main/othervm -XX:+UnlockExperimentalVMOptions -XX:+HandshakeDeoptimization
+ *      -XX:+UseBiasedLocking -XX:BiasedLockingStartupDelay=0
+ *      compiler.uncommontrap.TestHandshakeDeoptimization
+ * @run main/othervm -XX:+UnlockExperimentalVMOptions -XX:+HandshakeDeoptimization
+ *      -XX:+UseBiasedLocking -XX:BiasedLockingStartupDelay=0 -XX:-TieredCompilation
+ *      compiler.uncommontrap.TestHandshakeDeoptimization
+ * @run main/othervm -XX:+UnlockExperimentalVMOptions -XX:+HandshakeDeoptimization
+ *      -XX:-UseBiasedLocking
+ *      compiler.uncommontrap.TestHandshakeDeoptimization
+ * @run main/othervm -XX:+UseBiasedLocking -XX:BiasedLockingStartupDelay=0
+ *      compiler.uncommontrap.TestHandshakeDeoptimization
+ */
+
+package compiler.uncommontrap;
+
+import java.util.concurrent.CountDownLatch;
+
+public class TestHandshakeDeoptimization {
+    // Each hierarchy has a single loaded subclass when the workers are
+    // compiled, so calls through the base class are devirtualized with a
+    // class hierarchy dependency. Loading the second subclass invalidates
+    // the compiled workers while they run.
+    static abstract class Base1 { abstract int value(); }
+    static class Single1 extends Base1 { int value() { return 1; } }
+    static class Other1 extends Base1 { int value() { return 2; } }
+
+    static abstract class Base2 { abstract int value(); }
+    static class Single2 extends Base2 { int value() { return 1; } }
+    static class Other2 extends Base2 { int value() { return 2; } }
+
+    static abstract class Base3 { abstract int value(); }
+    static class Single3 extends Base3 { int value() { return 1; } }
+    static class Other3 extends Base3 { int value() { return 2; } }
+
+    static final int THREADS = 4;
+    static final int ROUNDS = 20_000;
+    static final int INNER = 100;
+
+    static volatile int phase;
+
+    static class Worker extends Thread {
+        final Object lock = new Object();  // biased toward this thread
+        final Base1 b1 = new Single1();
+        final Base2 b2 = new Single2();
+        final Base3 b3 = new Single3();
+        final CountDownLatch warm;
+        long sum;
+        long expected;
+        int rounds;
+
+        Worker(CountDownLatch warm) {
+            this.warm = warm;
+        }
+
+        // The lock is held across the devirtualized calls, so the frame that
+        // is deoptimized owns a biased monitor.
+        long work() {
+            long s = 0;
+            synchronized (lock) {
+                for (int i = 0; i < INNER; i++) {
+                    s += b1.value() + b2.value() + b3.value();
+                }
+            }
+            return s;
+        }
+
+        public void run() {
+            while (phase < 4) {
+                sum += work();
+                expected += 3 * INNER;
+                if (++rounds == ROUNDS) {
+                    warm.countDown();
+                }
+            }
+        }
+    }
+
+    public static void main(String[] args) throws Exception {
+        CountDownLatch warm = new CountDownLatch(THREADS);
+        Worker[] workers = new Worker[THREADS];
+        for (int i = 0; i < THREADS; i++) {
+            workers[i] = new Worker(warm);
+            workers[i].start();
+        }
+        warm.await();
+
+        // Load the other subclasses one at a time while the workers run.
+        String[] others = { "Other1", "Other2", "Other3" };
+        for (String other : others) {
+            Class.forName(TestHandshakeDeoptimization.class.getName() + "$" + other)
+                 .getDeclaredConstructor().newInstance();
+            phase++;
+            Thread.sleep(200);
+        }
+        phase++;
+
+        for (Worker w : workers) {
+            w.join();
+            if (w.sum != w.expected) {
+                throw new RuntimeException("Wrong sum " + w.sum + ", expected " + w.expected);
+            }
+            // The lock must have been released by the deoptimized frames,
+            // otherwise this would hang.
+            synchronized (w.lock) {
+                w.sum = 0;
+            }
+        }
+    }
+}
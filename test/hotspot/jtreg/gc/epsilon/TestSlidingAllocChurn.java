@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+package gc.epsilon;
+
+/**
+ * @test TestSlidingAllocChurn
+ * @requires vm.gc.Epsilon & !vm.graal.enabled
+ * @summary Allocating many times the maximum heap size must run sliding
+ *          collections instead of failing, and keep the live set intact.
+ * @run main/othervm -XX:+UnlockExperimentalVMOptions -XX:+UseEpsilonGC
+ *      -XX:+EpsilonSlidingGC -Xmx64m -Xlog:gc
+ *      gc.epsilon.TestSlidingAllocChurn
+ * @run main/othervm -XX:+UnlockExperimentalVMOptions -XX:+UseEpsilonGC
+ *      -XX:+EpsilonSlidingGC -Xmx64m -XX:-UseTLAB
+ *      gc.epsilon.TestSlidingAllocChurn
+ * @run main/othervm -XX:+UnlockExperimentalVMOptions -XX:+UseEpsilonGC
+ *      -XX:+EpsilonSlidingGC -Xmx64m -XX:-UseCompressedOops
+ *      gc.epsilon.TestSlidingAllocChurn
+ */
+
+public class TestSlidingAllocChurn {
+    // Allocates 16 times -Xmx in total, while keeping about a quarter of
+    // the heap live in slots that are overwritten at random.
+    static final long TOTAL = 16L * 64 * 1024 * 1024;
+    static final int SLOTS = 4096;
+    static final int MAX_LEN = 1024;
+
+    static Object[] live = new Object[SLOTS];
+    static volatile Object sink;
+
+    static int[] make(int seed, int len) {
+        int[] a = new int[len];
+        for (int i = 0; i < len; i++) {
+            a[i] = seed * 31 + i;
+        }
+        return a;
+    }
+
+    static void check(Object o) {
+        if (o == null) {
+            return;
+        }
+        int[] a = (int[]) o;
+        int seed = a[0] / 31;
+        for (int i = 0; i < a.length; i++) {
+            if (a[i] != seed * 31 + i) {
+                throw new RuntimeException("Live array with seed " + seed + " has been corrupted at " + i);
+            }
+        }
+    }
+
+    public static void main(String[] args) {
+        long allocated = 0;
+        int seed = 0;
+        long rnd = 42;
+        while (allocated < TOTAL) {
+            rnd = rnd * 6364136223846793005L + 1442695040888963407L;
+            int len = 1 + (int) ((rnd >>> 33) % MAX_LEN);
+            int[] a = make(seed++ & 0xFFFFF, len);
+            allocated += 16 + 4L * len;
+            if ((rnd & 0xF) == 0) {
+                int slot = (int) ((rnd >>> 40) % SLOTS);
+                check(live[slot]);
+                live[slot] = a;
+            } else {
+                sink = a;
+            }
+        }
+        for (Object o : live) {
+            check(o);
+        }
+    }
+}
@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+package gc.epsilon;
+
+/**
+ * @test TestSlidingDerivedPointers
+ * @requires vm.gc.Epsilon & vm.compiler2.enabled & !vm.graal.enabled
+ * @summary Sliding collections must update the derived pointers of
+ *          compiled frames that stop at a safepoint inside array loops.
+ * @run main/othervm -XX:+UnlockExperimentalVMOptions -XX:+UseEpsilonGC
+ *      -XX:+EpsilonSlidingGC -Xmx64m -XX:-TieredCompilation -Xbatch
+ *      gc.epsilon.TestSlidingDerivedPointers
+ * @run main/othervm -XX:+UnlockExperimentalVMOptions -XX:+UseEpsilonGC
+ *      -XX:+EpsilonSlidingGC -Xmx64m -XX:-TieredCompilation -Xbatch
+ *      -XX:-UseCompressedOops
+ *      gc.epsilon.TestSlidingDerivedPointers
+ * @run main/othervm -XX:+UnlockExperimentalVMOptions -XX:+UseEpsilonGC
+ *      -XX:+EpsilonSlidingGC -Xmx64m -XX:-TieredCompilation -Xbatch
+ *      -XX:LoopUnrollLimit=0
+ *      gc.epsilon.TestSlidingDerivedPointers
+ */
+
+public class TestSlidingDerivedPointers {
+    static final int LEN = 4096;
+    static final int ITERS = 20_000;
+
+    static volatile Object sink;
+
+    // C2 keeps the element address of a[i] in a register derived from a,
+    // and the allocation in the loop is a safepoint where the array may
+    // move.
+    static long updateInts(int[] a, int delta) {
+        long sum = 0;
+        for (int i = 0; i < a.length; i++) {
+            sum += a[i];
+            if ((i & 63) == 0) {
+                sink = new byte[1024];
+            }
+            a[i] += delta;
+        }
+        return sum;
+    }
+
+    static long updateRefs(Integer[] a, Integer[] values) {
+        long sum = 0;
+        for (int i = 0; i < a.length; i++) {
+            sum += a[i];
+            if ((i & 63) == 0) {
+                sink = new Object[128];
+            }
+            a[i] = values[(a[i] + 1) & 255];
+        }
+        return sum;
+    }
+
+    public static void main(String[] args) {
+        int[] ints = new int[LEN];
+        Integer[] values = new Integer[256];
+        for (int i = 0; i < values.length; i++) {
+            values[i] = i;
+        }
+        Integer[] refs = new Integer[LEN];
+        for (int i = 0; i < LEN; i++) {
+            ints[i] = i;
+            refs[i] = values[i & 255];
+        }
+
+        for (int iter = 0; iter < ITERS; iter++) {
+            // Every element was i + iter before this pass
+            long expected = (long) LEN * (LEN - 1) / 2 + (long) LEN * iter;
+            long sum = updateInts(ints, 1);
+            if (sum != expected) {
+                throw new RuntimeException("Int sum " + sum + " != " + expected + " in iteration " + iter);
+            }
+
+            // Every element was (i + iter) & 255 before this pass
+            expected = 0;
+            for (int i = 0; i < LEN; i++) {
+                expected += (i + iter) & 255;
+            }
+            sum = updateRefs(refs, values);
+            if (sum != expected) {
+                throw new RuntimeException("Ref sum " + sum + " != " + expected + " in iteration " + iter);
+            }
+        }
+    }
+}
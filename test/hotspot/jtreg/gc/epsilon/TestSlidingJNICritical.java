@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+package gc.epsilon;
+
+/**
+ * @test TestSlidingJNICritical
+ * @requires vm.gc.Epsilon & !vm.graal.enabled
+ * @summary Sliding collections requested while a JNI critical region is
+ *          active must be skipped or deferred, and must not move the
+ *          pinned arrays.
+ * @run main/othervm/native -XX:+UnlockExperimentalVMOptions -XX:+UseEpsilonGC
+ *      -XX:+EpsilonSlidingGC -Xmx64m -Xlog:gc
+ *      gc.epsilon.TestSlidingJNICritical
+ * @run main/othervm/native -XX:+UnlockExperimentalVMOptions -XX:+UseEpsilonGC
+ *      -XX:+EpsilonSlidingGC -Xmx64m -Xcomp
+ *      gc.epsilon.TestSlidingJNICritical
+ */
+
+import java.util.Arrays;
+
+public class TestSlidingJNICritical {
+    static {
+        System.loadLibrary("TestSlidingJNICritical");
+    }
+
+    static final int NUM_RUNS = 20_000;
+    static final int ARRAY_SIZE = 10_000;
+
+    static volatile boolean done;
+    static volatile Object sink;
+
+    // Copies a to b with both arrays held critical, and returns the sum
+    // of b read back from the pinned memory.
+    static native long copyAtoB(int[] a, int[] b);
+
+    public static void main(String[] args) throws Exception {
+        // Only this thread allocates. System.gc() from the other thread
+        // hits the critical regions without ever starving an allocation.
+        Thread gc = new Thread(() -> {
+            while (!done) {
+                System.gc();
+            }
+        });
+        gc.start();
+
+        int[] a = new int[ARRAY_SIZE];
+        int[] b = new int[ARRAY_SIZE];
+        try {
+            for (int i = 0; i < NUM_RUNS; i++) {
+                long expected = 0;
+                for (int j = 0; j < ARRAY_SIZE; j++) {
+                    a[j] = i * 31 + j;
+                    expected += a[j];
+                }
+                // Garbage in front of the arrays, so that they have to slide
+                sink = new int[ARRAY_SIZE];
+                if (copyAtoB(a, b) != expected) {
+                    throw new RuntimeException("Pinned array has been moved or corrupted");
+                }
+                if (!Arrays.equals(a, b)) {
+                    throw new RuntimeException("Arrays are not equal");
+                }
+                if ((i & 0xFF) == 0) {
+                    // Move on to fresh arrays at the top of the heap
+                    a = new int[ARRAY_SIZE];
+                    b = new int[ARRAY_SIZE];
+                }
+            }
+        } finally {
+            done = true;
+            gc.join();
+        }
+    }
+}
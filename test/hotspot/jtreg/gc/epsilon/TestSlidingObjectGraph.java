@@ -0,0 +1,152 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+package gc.epsilon;
+
+/**
+ * @test TestSlidingObjectGraph
+ * @requires vm.gc.Epsilon & !vm.graal.enabled
+ * @summary An object graph must keep its shape, contents, identity hash
+ *          codes and locks across sliding collections run by System.gc().
+ * @run main/othervm -XX:+UnlockExperimentalVMOptions -XX:+UseEpsilonGC
+ *      -XX:+EpsilonSlidingGC -Xmx128m -Xlog:gc
+ *      gc.epsilon.TestSlidingObjectGraph
+ * @run main/othervm -XX:+UnlockExperimentalVMOptions -XX:+UseEpsilonGC
+ *      -XX:+EpsilonSlidingGC -Xmx128m -XX:-UseCompressedOops
+ *      gc.epsilon.TestSlidingObjectGraph
+ * @run main/othervm -XX:+UnlockExperimentalVMOptions -XX:+UseEpsilonGC
+ *      -XX:+EpsilonSlidingGC -Xmx128m -XX:+UseBiasedLocking
+ *      -XX:BiasedLockingStartupDelay=0
+ *      gc.epsilon.TestSlidingObjectGraph
+ */
+
+import java.lang.ref.WeakReference;
+
+public class TestSlidingObjectGraph {
+    static class Node {
+        final int id;
+        final String name;
+        final long[] payload;
+        Node left;
+        Node right;
+        Node back;
+
+        Node(int id) {
+            this.id = id;
+            this.name = "node" + id;
+            this.payload = new long[id % 7];
+            for (int i = 0; i < payload.length; i++) {
+                payload[i] = id * 0x9E3779B97F4A7C15L + i;
+            }
+        }
+
+        void verify(int expected) {
+            if (id != expected || !name.equals("node" + expected) || payload.length != expected % 7) {
+                throw new RuntimeException("Node " + expected + " has been corrupted");
+            }
+            for (int i = 0; i < payload.length; i++) {
+                if (payload[i] != expected * 0x9E3779B97F4A7C15L + i) {
+                    throw new RuntimeException("Payload of node " + expected + " has been corrupted");
+                }
+            }
+        }
+    }
+
+    static final int NODES = 100_000;
+    static volatile Object sink;
+
+    // Builds a complete binary tree in heap order, with every node also
+    // pointing back to a node further down, so that the graph has cycles.
+    static Node[] build() {
+        Node[] nodes = new Node[NODES];
+        for (int i = 0; i < NODES; i++) {
+            nodes[i] = new Node(i);
+            // Interleave garbage so that the live nodes have to slide
+            sink = new byte[i % 97];
+        }
+        for (int i = 0; i < NODES; i++) {
+            if (2 * i + 1 < NODES) nodes[i].left = nodes[2 * i + 1];
+            if (2 * i + 2 < NODES) nodes[i].right = nodes[2 * i + 2];
+            nodes[i].back = nodes[(int) ((i * 7919L) % NODES)];
+        }
+        return nodes;
+    }
+
+    // Walks the tree in heap order from the root only, then checks the
+    // back references and the identity hashes that were taken.
+    static void verify(Node root, int[] hashes) {
+        Node[] seen = new Node[NODES];
+        seen[0] = root;
+        for (int i = 0; i < NODES; i++) {
+            Node n = seen[i];
+            if (n == null) {
+                throw new RuntimeException("Node " + i + " is not reachable");
+            }
+            n.verify(i);
+            if (2 * i + 1 < NODES) seen[2 * i + 1] = n.left;
+            if (2 * i + 2 < NODES) seen[2 * i + 2] = n.right;
+        }
+        for (int i = 0; i < NODES; i++) {
+            if (seen[i].back != seen[(int) ((i * 7919L) % NODES)]) {
+                throw new RuntimeException("Back reference of node " + i + " is wrong");
+            }
+            if (i % 3 == 0 && System.identityHashCode(seen[i]) != hashes[i]) {
+                throw new RuntimeException("Identity hash of node " + i + " has changed");
+            }
+        }
+    }
+
+    public static void main(String[] args) throws Exception {
+        Node[] nodes = build();
+        Node root = nodes[0];
+        // Only every third node gets a hash, the others keep a plain
+        // mark word
+        int[] hashes = new int[NODES];
+        for (int i = 0; i < NODES; i += 3) {
+            hashes[i] = System.identityHashCode(nodes[i]);
+        }
+        WeakReference<Node> weak = new WeakReference<>(nodes[NODES - 1]);
+        Node locked = nodes[NODES / 2];
+        Node lockedHashed = nodes[NODES / 2 + 1];
+        nodes = null;
+
+        for (int round = 0; round < 5; round++) {
+            synchronized (locked) {
+                synchronized (lockedHashed) {
+                    System.gc();
+                    if (!Thread.holdsLock(locked) || !Thread.holdsLock(lockedHashed)) {
+                        throw new RuntimeException("Lock has been lost");
+                    }
+                }
+            }
+            verify(root, hashes);
+            // Weak references are treated as strong
+            if (weak.get() == null) {
+                throw new RuntimeException("Weak referent has been cleared");
+            }
+            for (int i = 0; i < 10_000; i++) {
+                sink = new Object[i % 31];
+            }
+        }
+    }
+}
@@ -0,0 +1,41 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+#include <jni.h>
+#include <string.h>
+
+JNIEXPORT jlong JNICALL
+Java_gc_epsilon_TestSlidingJNICritical_copyAtoB(JNIEnv *env, jclass unused, jintArray a, jintArray b) {
+  jint len = (*env)->GetArrayLength(env, a);
+  jint* aa = (*env)->GetPrimitiveArrayCritical(env, a, 0);
+  jint* bb = (*env)->GetPrimitiveArrayCritical(env, b, 0);
+  jlong sum = 0;
+  jint i;
+  memcpy(bb, aa, len * sizeof(jint));
+  for (i = 0; i < len; i++) {
+    sum += bb[i];
+  }
+  (*env)->ReleasePrimitiveArrayCritical(env, b, bb, 0);
+  (*env)->ReleasePrimitiveArrayCritical(env, a, aa, 0);
+  return sum;
+}
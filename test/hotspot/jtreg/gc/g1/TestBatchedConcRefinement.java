@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+package gc.g1;
+
+/**
+ * @test TestBatchedConcRefinement
+ * @requires vm.gc.G1
+ * @summary Old to young references must survive young and mixed GCs when
+ *          concurrent refinement sorts and deduplicates the dirty cards.
+ * @run main/othervm -XX:+UseG1GC -XX:+UnlockExperimentalVMOptions
+ *      -XX:+G1BatchedConcRefinement -XX:G1UpdateBufferSize=64
+ *      -XX:G1ConcRefinementThreads=2 -Xmx64m -Xlog:gc
+ *      gc.g1.TestBatchedConcRefinement
+ * @run main/othervm -XX:+UseG1GC -XX:+UnlockExperimentalVMOptions
+ *      -XX:+G1BatchedConcRefinement -XX:G1UpdateBufferSize=64
+ *      -XX:+UnlockDiagnosticVMOptions -XX:+VerifyAfterGC -Xmx64m
+ *      gc.g1.TestBatchedConcRefinement
+ */
+
+public class TestBatchedConcRefinement {
+    static class Node {
+        final int id;
+        final long check;
+        Node next;
+
+        Node(int id) {
+            this.id = id;
+            this.check = id * 0x9E3779B97F4A7C15L;
+        }
+
+        void verify(int expected) {
+            if (id != expected || check != id * 0x9E3779B97F4A7C15L) {
+                throw new RuntimeException("Node " + expected + " has been corrupted");
+            }
+        }
+    }
+
+    static final int OLD = 200_000;
+
+    public static void main(String[] args) {
+        // Tenure the holders, so that later stores into them dirty cards.
+        Node[] holders = new Node[OLD];
+        for (int i = 0; i < OLD; i++) {
+            holders[i] = new Node(i);
+        }
+        System.gc();
+
+        for (int round = 0; round < 30; round++) {
+            // Stores to adjacent holders dirty runs of cards, and storing
+            // twice into the same holder dirties the same card again.
+            for (int i = round % 2; i < OLD; i += 2) {
+                holders[i].next = new Node(i + round);
+                holders[i].next = new Node(i + round + 1);
+            }
+            // Churn to trigger young GCs while the cards are refined.
+            for (int i = 0; i < 100_000; i++) {
+                Object garbage = new byte[64];
+            }
+            for (int i = round % 2; i < OLD; i += 2) {
+                holders[i].verify(i);
+                holders[i].next.verify(i + round + 1);
+            }
+        }
+    }
+}
@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+package gc.g1;
+
+/*
+ * @test TestEagerReclaimHumongousObjArrays
+ * @summary Eager reclaim of humongous object arrays must keep every array
+ *          and every element that is still reachable.
+ * @requires vm.gc.G1
+ * @run main/othervm -XX:+UseG1GC -Xmx256m -Xmn32m -XX:G1HeapRegionSize=1m
+ *      -XX:+UnlockExperimentalVMOptions -XX:+G1EagerReclaimHumongousObjArrays
+ *      -XX:+UnlockDiagnosticVMOptions -XX:+VerifyAfterGC
+ *      gc.g1.TestEagerReclaimHumongousObjArrays
+ * @run main/othervm -XX:+UseG1GC -Xmx256m -Xmn32m -XX:G1HeapRegionSize=1m
+ *      -XX:+UnlockExperimentalVMOptions -XX:+G1EagerReclaimHumongousObjArrays
+ *      -XX:InitiatingHeapOccupancyPercent=0
+ *      gc.g1.TestEagerReclaimHumongousObjArrays
+ */
+
+public class TestEagerReclaimHumongousObjArrays {
+    // larger than half a region
+    static final int ARRAY_LENGTH = 256 * 1024;
+    static final int ROUNDS = 200;
+
+    static class Box {
+        final int value;
+        Object ref;
+        Box(int value) { this.value = value; }
+    }
+
+    static Object[] newArray(int seed) {
+        Object[] array = new Object[ARRAY_LENGTH];
+        for (int i = 0; i < array.length; i += 1024) {
+            array[i] = new Box(seed + i);
+        }
+        return array;
+    }
+
+    static void check(Object[] array, int seed) {
+        for (int i = 0; i < array.length; i += 1024) {
+            Box box = (Box)array[i];
+            if (box == null || box.value != seed + i) {
+                throw new RuntimeException("lost element " + i + " of array " + seed);
+            }
+        }
+    }
+
+    static Object sink;
+
+    public static void main(String[] args) {
+        // Live humongous arrays, reachable only from another humongous
+        // array or from a young object.
+        Object[] root = new Object[ARRAY_LENGTH];
+        Box holder = new Box(-1);
+
+        for (int round = 0; round < ROUNDS; round++) {
+            // Garbage humongous arrays, candidates for eager reclaim.
+            for (int i = 0; i < 4; i++) {
+                sink = newArray(round);
+            }
+            root[round] = newArray(round * 10);
+            holder.ref = newArray(round * 100);
+            // Young garbage to trigger young GCs.
+            for (int i = 0; i < 1000; i++) {
+                sink = new byte[1024];
+            }
+            check((Object[])root[round], round * 10);
+            check((Object[])holder.ref, round * 100);
+            if (round > 0) {
+                // Drop an older array again, it becomes a candidate too.
+                root[round - 1] = null;
+            }
+        }
+        check((Object[])root[ROUNDS - 1], (ROUNDS - 1) * 10);
+    }
+}
@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+package gc.z;
+
+/**
+ * @test TestRelocateInPlace
+ * @requires vm.gc.Z & !vm.graal.enabled
+ * @summary Objects must keep their contents when ZGC compacts pages in place
+ *          because relocation ran out of memory.
+ * @run main/othervm -XX:+UnlockExperimentalVMOptions -XX:+UseZGC
+ *      -XX:+ZRelocateInPlace -Xmx32m -Xlog:gc gc.z.TestRelocateInPlace
+ * @run main/othervm -XX:+UnlockExperimentalVMOptions -XX:+UseZGC
+ *      -XX:+ZRelocateInPlace -XX:+UnlockDiagnosticVMOptions
+ *      -XX:+ZVerifyForwarding -Xmx32m -Xlog:gc
+ *      gc.z.TestRelocateInPlace
+ */
+
+public class TestRelocateInPlace {
+    static class Node {
+        final int id;
+        final long check;
+
+        Node(int id) {
+            this.id = id;
+            this.check = id * 0x9E3779B97F4A7C15L;
+        }
+
+        void verify() {
+            if (check != id * 0x9E3779B97F4A7C15L) {
+                throw new RuntimeException("Node " + id + " has been corrupted");
+            }
+        }
+    }
+
+    // Keeps a large part of the heap live, so that the garbage of each page is
+    // small and the relocation of sparse pages can run out of free pages.
+    static final int LIVE = 400_000;
+
+    public static void main(String[] args) {
+        Node[] live = new Node[LIVE];
+        for (int i = 0; i < LIVE; i++) {
+            live[i] = new Node(i);
+        }
+
+        int id = LIVE;
+        for (int round = 0; round < 20; round++) {
+            // Replace every third node, leaving some garbage on every page.
+            for (int i = round % 3; i < LIVE; i += 3) {
+                live[i] = new Node(id++);
+            }
+            System.gc();
+
+            for (int i = 0; i < LIVE; i++) {
+                live[i].verify();
+            }
+        }
+    }
+}
@@ -0,0 +1,46 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/*
+ * @test
+ * @summary The old verifier must find the operands of tableswitch and
+ *          lookupswitch in methods other than the first of a class.
+ * @compile OldSwitch.jasm
+ * @run main/othervm -Xverify:all OldSwitchTest
+ */
+
+public class OldSwitchTest {
+    public static void main(String[] args) throws Exception {
+        // Loading the class runs the old verifier over all its methods.
+        Class<?> c = Class.forName("OldSwitch");
+        for (int i = -1; i < 4; i++) {
+            int t = (Integer) c.getMethod("table", int.class).invoke(null, i);
+            int l = (Integer) c.getMethod("lookup", int.class).invoke(null, i);
+            int expected = (i == 0 || i == 1 || i == 2) ? i + 10 : -1;
+            if (t != expected || l != expected) {
+                throw new RuntimeException("switch on " + i + ": table " + t +
+                                           ", lookup " + l + ", expected " + expected);
+            }
+        }
+    }
+}